@@ -0,0 +1,265 @@
+//! Network Compression Benchmarks
+//!
+//! Measures compression throughput and ratio per message type for each codec
+//! the network layer offers:
+//! - LZ4: run-length fast path
+//! - Zstd: persistent-context Zstd
+//! - Zstd + dictionary: per-topic dictionary for small repetitive messages
+//! - Zstd + delta: XOR against the previous message for slowly changing maps
+//!
+//! Criterion reports MB/s over the uncompressed bytes; the ratio table printed
+//! before the runs gives compressed/original size for the same inputs. The
+//! printed `CodecProfile` lines can be passed to
+//! `TopicCompressor::set_profile` so `Auto` starts from measured data.
+//!
+//! Run with: cargo bench --bench compression
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use std::time::{Duration, Instant};
+
+use horus_core::communication::network::{
+    CodecEstimate, CodecProfile, CompressionConfig, TopicCompressor,
+};
+use horus_library::messages::{
+    diagnostics::DiagnosticReport,
+    geometry::{Point3, Pose2D},
+    navigation::OccupancyGrid,
+    perception::PointCloud,
+    sensor::Odometry,
+    vision::CompressedImage,
+};
+
+/// Messages per stream; streams are replayed in order
+const STREAM_LEN: usize = 64;
+
+/// Small deterministic PRNG so every run compresses the same bytes
+struct XorShift(u64);
+
+impl XorShift {
+    fn next(&mut self) -> u64 {
+        self.0 ^= self.0 << 13;
+        self.0 ^= self.0 >> 7;
+        self.0 ^= self.0 << 17;
+        self.0
+    }
+
+    fn unit(&mut self) -> f64 {
+        (self.next() >> 11) as f64 / (1u64 << 53) as f64
+    }
+}
+
+fn encode<T: serde::Serialize>(msg: &T) -> Vec<u8> {
+    bincode::serialize(msg).unwrap()
+}
+
+/// VGA JPEG-sized payload: mostly entropy-coded bytes with marker structure
+fn compressed_image_stream() -> Vec<Vec<u8>> {
+    let mut rng = XorShift(0x1234_5678);
+    (0..STREAM_LEN)
+        .map(|_| {
+            let mut data: Vec<u8> = (0..40_000).map(|_| rng.next() as u8).collect();
+            for chunk in data.chunks_mut(512) {
+                chunk[..4].copy_from_slice(&[0xFF, 0xD0, 0x00, 0x00]);
+            }
+            let mut img = CompressedImage::new("jpeg", data);
+            img.width = 640;
+            img.height = 480;
+            encode(&img)
+        })
+        .collect()
+}
+
+/// 16-beam lidar sweep over a smooth surface with range noise
+fn pointcloud_stream() -> Vec<Vec<u8>> {
+    let mut rng = XorShift(0x9E37_79B9);
+    (0..STREAM_LEN)
+        .map(|frame| {
+            let points: Vec<Point3> = (0..16 * 900)
+                .map(|i| {
+                    let ring = (i / 900) as f64;
+                    let azimuth = (i % 900) as f64 * std::f64::consts::TAU / 900.0;
+                    let range =
+                        8.0 + (azimuth * 3.0 + frame as f64 * 0.01).sin() + rng.unit() * 0.02;
+                    Point3::new(
+                        range * azimuth.cos(),
+                        range * azimuth.sin(),
+                        (ring - 8.0) * 0.035 * range,
+                    )
+                })
+                .collect();
+            encode(&PointCloud::xyz(&points))
+        })
+        .collect()
+}
+
+/// 400x400 map where a handful of cells change between updates
+fn occupancy_grid_stream() -> Vec<Vec<u8>> {
+    let mut rng = XorShift(0xC0FF_EE00);
+    let mut grid = OccupancyGrid::new(400, 400, 0.05, Pose2D::origin());
+    for y in 0..400 {
+        for x in 0..400 {
+            let value = if x % 97 == 0 || y % 89 == 0 {
+                100
+            } else if (x as i32 - 200).pow(2) + (y as i32 - 200).pow(2) < 150 * 150 {
+                0
+            } else {
+                -1
+            };
+            grid.set_occupancy(x, y, value);
+        }
+    }
+    (0..STREAM_LEN)
+        .map(|_| {
+            for _ in 0..20 {
+                let x = (rng.next() % 400) as u32;
+                let y = (rng.next() % 400) as u32;
+                grid.set_occupancy(x, y, if rng.next() % 2 == 0 { 0 } else { 100 });
+            }
+            grid.timestamp += 100_000_000;
+            encode(&grid)
+        })
+        .collect()
+}
+
+fn odometry_stream() -> Vec<Vec<u8>> {
+    let mut rng = XorShift(0xABCD_EF01);
+    (0..STREAM_LEN * 8)
+        .map(|i| {
+            let mut odom = Odometry::new();
+            odom.set_frames("odom", "base_link");
+            odom.pose.x = i as f64 * 0.01 + rng.unit() * 1e-3;
+            odom.pose.y = (i as f64 * 0.01).sin();
+            odom.pose.theta = i as f64 * 0.001;
+            odom.twist.linear[0] = 0.5 + rng.unit() * 0.01;
+            odom.twist.angular[2] = 0.1;
+            odom.pose_covariance[0] = 0.01;
+            odom.pose_covariance[7] = 0.01;
+            odom.pose_covariance[35] = 0.05;
+            encode(&odom)
+        })
+        .collect()
+}
+
+fn diagnostics_stream() -> Vec<Vec<u8>> {
+    let mut rng = XorShift(0x5EED_5EED);
+    (0..STREAM_LEN * 8)
+        .map(|i| {
+            let mut report = DiagnosticReport::new("motor_controller");
+            report.add_float("temperature", 41.0 + rng.unit()).unwrap();
+            report.add_float("current", 2.5 + rng.unit() * 0.1).unwrap();
+            report.add_int("errors", 0).unwrap();
+            report.add_int("uptime", i as i64).unwrap();
+            report.add_string("state", "running").unwrap();
+            encode(&report)
+        })
+        .collect()
+}
+
+/// Codec variants benchmarked for every message type
+fn codecs() -> Vec<(&'static str, CompressionConfig)> {
+    vec![
+        ("lz4", CompressionConfig::lz4()),
+        ("zstd", CompressionConfig::zstd()),
+        ("zstd_dict", CompressionConfig::small_messages(256)),
+        ("zstd_delta", CompressionConfig::delta(30)),
+    ]
+}
+
+/// Compress a full stream once, returning (compressed bytes, original bytes, time)
+fn measure(config: &CompressionConfig, stream: &[Vec<u8>]) -> (usize, usize, Duration) {
+    let mut tx = TopicCompressor::new(config.clone());
+    let max = stream.iter().map(Vec::len).max().unwrap_or(0);
+    let mut frame = vec![0u8; TopicCompressor::max_frame_size(max)];
+
+    // Warm up contexts and let the dictionary train
+    for msg in stream {
+        tx.compress_into(msg, &mut frame).unwrap();
+    }
+
+    let mut compressed = 0;
+    let original: usize = stream.iter().map(Vec::len).sum();
+    let start = Instant::now();
+    for msg in stream {
+        compressed += tx.compress_into(msg, &mut frame).unwrap();
+    }
+    (compressed, original, start.elapsed())
+}
+
+fn message_types() -> Vec<(&'static str, Vec<Vec<u8>>)> {
+    vec![
+        ("compressed_image", compressed_image_stream()),
+        ("pointcloud", pointcloud_stream()),
+        ("occupancy_grid", occupancy_grid_stream()),
+        ("odometry", odometry_stream()),
+        ("diagnostics", diagnostics_stream()),
+    ]
+}
+
+/// Print ratio vs throughput per message type and the resulting Auto profile
+fn report_ratios() {
+    println!(
+        "\n{:<18} {:<12} {:>10} {:>10}",
+        "message", "codec", "ratio", "MB/s"
+    );
+    for (name, stream) in message_types() {
+        let mut profile = CodecProfile::default();
+        for (codec, config) in codecs() {
+            let (compressed, original, elapsed) = measure(&config, &stream);
+            let ratio = compressed as f64 / original as f64;
+            let speed = original as f64 / elapsed.as_secs_f64().max(1e-9);
+            println!(
+                "{:<18} {:<12} {:>10.3} {:>10.1}",
+                name,
+                codec,
+                ratio,
+                speed / 1e6
+            );
+
+            let estimate = CodecEstimate {
+                ratio,
+                bytes_per_sec: speed,
+            };
+            match codec {
+                "lz4" => profile.lz4 = estimate,
+                "zstd" => profile.zstd = estimate,
+                _ => {}
+            }
+        }
+        println!("{:<18} profile: {:?}", name, profile);
+    }
+    println!();
+}
+
+fn bench_compression(c: &mut Criterion) {
+    report_ratios();
+
+    for (name, stream) in message_types() {
+        let mut group = c.benchmark_group(format!("compression_{}", name));
+        group.measurement_time(Duration::from_secs(3));
+        let bytes: usize = stream.iter().map(Vec::len).sum();
+        group.throughput(Throughput::Bytes((bytes / stream.len()) as u64));
+
+        for (codec, config) in codecs() {
+            group.bench_with_input(BenchmarkId::new(codec, name), &stream, |b, stream| {
+                let mut tx = TopicCompressor::new(config.clone());
+                let max = stream.iter().map(Vec::len).max().unwrap_or(0);
+                let mut frame = vec![0u8; TopicCompressor::max_frame_size(max)];
+                for msg in stream {
+                    tx.compress_into(msg, &mut frame).unwrap();
+                }
+
+                let mut i = 0;
+                b.iter(|| {
+                    let msg = &stream[i % stream.len()];
+                    i += 1;
+                    black_box(tx.compress_into(black_box(msg), &mut frame).unwrap())
+                });
+            });
+        }
+
+        group.finish();
+    }
+}
+
+criterion_group!(benches, bench_compression);
+criterion_main!(benches);
@@ -0,0 +1,117 @@
+//! Grid Planning Benchmarks
+//!
+//! Measures planning on a 2000×2000 warehouse map (shelf rows with aisles):
+//! - astar: full search corner to corner, search state reused between runs
+//! - dstar_lite: repair after a few cells change near the path, vs the
+//!   same change forcing a full A* replan
+//! - integrate_scan: a 360-beam LaserScan folded into the occupancy grid
+//!
+//! Run with: cargo bench --bench grid_planning
+
+use criterion::{black_box, criterion_group, criterion_main, Criterion};
+use std::time::Duration;
+
+use horus_library::algorithms::astar::AStar;
+use horus_library::algorithms::dstar_lite::DStarLite;
+use horus_library::algorithms::occupancy_grid::OccupancyGrid;
+use horus_library::LaserScan;
+
+const SIZE: usize = 2000;
+
+/// Shelf blocks 8 cells deep with 6-cell aisles and a cross aisle every 200 cells
+fn warehouse() -> Vec<(i32, i32)> {
+    let mut cells = Vec::new();
+    for y in 50..SIZE - 50 {
+        if y % 200 < 8 {
+            continue;
+        }
+        for x in 50..SIZE - 50 {
+            if x % 14 < 8 {
+                cells.push((x as i32, y as i32));
+            }
+        }
+    }
+    cells
+}
+
+/// Cells toggled between replans: a pallet dropped into an aisle
+fn pallet() -> impl Iterator<Item = (i32, i32)> {
+    (1000..1004).flat_map(|y| (1010..1014).map(move |x| (x, y)))
+}
+
+fn bench_astar(c: &mut Criterion) {
+    let mut group = c.benchmark_group("grid_planning");
+    group.sample_size(10);
+    group.measurement_time(Duration::from_secs(10));
+
+    let shelves = warehouse();
+
+    let mut astar = AStar::new(SIZE, SIZE);
+    for &(x, y) in &shelves {
+        astar.set_obstacle(x, y);
+    }
+    astar.set_start(10, 10);
+    astar.set_goal(SIZE as i32 - 10, SIZE as i32 - 10);
+    let mut path = Vec::new();
+    group.bench_function("astar_full", |b| {
+        b.iter(|| black_box(astar.plan_into(&mut path)))
+    });
+
+    let mut blocked = false;
+    group.bench_function("astar_replan_after_change", |b| {
+        b.iter(|| {
+            blocked = !blocked;
+            for (x, y) in pallet() {
+                if blocked {
+                    astar.set_obstacle(x, y);
+                } else {
+                    astar.clear_obstacle(x, y);
+                }
+            }
+            black_box(astar.plan_into(&mut path))
+        })
+    });
+
+    let mut dstar = DStarLite::new(SIZE, SIZE);
+    for &(x, y) in &shelves {
+        dstar.set_obstacle(x, y);
+    }
+    dstar.set_start(10, 10);
+    dstar.set_goal(SIZE as i32 - 10, SIZE as i32 - 10);
+    dstar.plan_into(&mut path);
+    let mut blocked = false;
+    group.bench_function("dstar_lite_replan_after_change", |b| {
+        b.iter(|| {
+            blocked = !blocked;
+            for (x, y) in pallet() {
+                if blocked {
+                    dstar.set_obstacle(x, y);
+                } else {
+                    dstar.clear_obstacle(x, y);
+                }
+            }
+            black_box(dstar.plan_into(&mut path))
+        })
+    });
+
+    group.finish();
+}
+
+fn bench_integrate_scan(c: &mut Criterion) {
+    let mut grid = OccupancyGrid::new(400, 400, 0.05);
+    grid.set_origin(-10.0, -10.0);
+
+    let mut scan = LaserScan::new();
+    for (i, range) in scan.ranges.iter_mut().enumerate() {
+        *range = 4.0 + (i as f32 * 0.1).sin() * 2.0;
+    }
+
+    c.bench_function("integrate_scan_360", |b| {
+        b.iter(|| {
+            grid.integrate_scan(black_box((0.3, -0.2, 0.1)), black_box(&scan));
+        })
+    });
+}
+
+criterion_group!(benches, bench_astar, bench_integrate_scan);
+criterion_main!(benches);
@@ -0,0 +1,165 @@
+//! Image Preprocessing Benchmarks
+//!
+//! Measures each stage of the inference input pipeline on a 1280×720 camera
+//! frame scaled to a 224×224 and a 640×640 model input:
+//! - resize: nearest and bilinear gather + color swizzle (u8 out)
+//! - normalize: u8 → f32 scale/bias pass per kernel (scalar vs SIMD)
+//! - fused: resize + convert + normalize + HWC→NCHW into a reused tensor
+//! - legacy: the previous per-pixel loops (resize, normalize, transpose
+//!   as separate passes with fresh allocations) as a baseline
+//!
+//! Run with: cargo bench --bench image_preprocess
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use std::time::Duration;
+
+use horus_library::algorithms::image_preprocess::{
+    Kernel, PixelFormat, PreprocessConfig, Preprocessor, ResizeFilter,
+};
+
+const SRC_W: usize = 1280;
+const SRC_H: usize = 720;
+const MEAN: [f32; 3] = [0.485, 0.456, 0.406];
+const STD: [f32; 3] = [0.229, 0.224, 0.225];
+
+fn frame() -> Vec<u8> {
+    (0..SRC_W * SRC_H * 3)
+        .map(|i| ((i * 31) ^ (i >> 7)) as u8)
+        .collect()
+}
+
+/// Previous ONNXInferenceNode pipeline, kept for comparison
+fn legacy_preprocess(data: &[u8], dst_w: usize, dst_h: usize) -> Vec<f32> {
+    let mut resized = vec![0.0f32; dst_h * dst_w * 3];
+    let x_ratio = SRC_W as f32 / dst_w as f32;
+    let y_ratio = SRC_H as f32 / dst_h as f32;
+    for y in 0..dst_h {
+        for x in 0..dst_w {
+            let src_x = (x as f32 * x_ratio) as usize;
+            let src_y = (y as f32 * y_ratio) as usize;
+            for c in 0..3 {
+                resized[(y * dst_w + x) * 3 + c] =
+                    data[(src_y * SRC_W + src_x) * 3 + c] as f32 / 255.0;
+            }
+        }
+    }
+    for y in 0..dst_h {
+        for x in 0..dst_w {
+            for c in 0..3 {
+                let idx = y * dst_w * 3 + x * 3 + c;
+                resized[idx] = (resized[idx] - MEAN[c]) / STD[c];
+            }
+        }
+    }
+    let mut nchw = vec![0.0f32; 3 * dst_h * dst_w];
+    for c in 0..3 {
+        for y in 0..dst_h {
+            for x in 0..dst_w {
+                nchw[c * dst_h * dst_w + y * dst_w + x] = resized[y * dst_w * 3 + x * 3 + c];
+            }
+        }
+    }
+    nchw
+}
+
+fn kernels() -> Vec<(&'static str, Kernel)> {
+    let mut kernels = vec![("scalar", Kernel::Scalar)];
+    let best = Kernel::detect();
+    if best != Kernel::Scalar {
+        kernels.push(("simd", best));
+    }
+    kernels
+}
+
+fn bench_resize(c: &mut Criterion) {
+    let src = frame();
+    let mut group = c.benchmark_group("preprocess_resize");
+    group.measurement_time(Duration::from_secs(3));
+
+    for (w, h) in [(224, 224), (640, 640)] {
+        group.throughput(Throughput::Elements((w * h) as u64));
+        for (name, filter) in [
+            ("nearest", ResizeFilter::Nearest),
+            ("bilinear", ResizeFilter::Bilinear),
+        ] {
+            let mut config = PreprocessConfig::imagenet(w, h);
+            config.filter = filter;
+            let mut pre = Preprocessor::new(config);
+            let mut out = vec![0u8; w * h * 3];
+            group.bench_function(BenchmarkId::new(name, format!("{}x{}", w, h)), |b| {
+                b.iter(|| {
+                    pre.resize_into(
+                        black_box(&src),
+                        SRC_W,
+                        SRC_H,
+                        0,
+                        PixelFormat::Rgb8,
+                        &mut out,
+                    )
+                    .unwrap()
+                })
+            });
+        }
+    }
+    group.finish();
+}
+
+fn bench_normalize(c: &mut Criterion) {
+    let plane: Vec<u8> = frame()[..SRC_W * SRC_H].to_vec();
+    let mut out = vec![0.0f32; plane.len()];
+    let mut group = c.benchmark_group("preprocess_normalize");
+    group.measurement_time(Duration::from_secs(3));
+    group.throughput(Throughput::Bytes(plane.len() as u64));
+
+    for (name, kernel) in kernels() {
+        group.bench_function(BenchmarkId::new(name, "1280x720"), |b| {
+            b.iter(|| {
+                kernel.affine(
+                    black_box(&plane),
+                    &mut out,
+                    1.0 / (255.0 * STD[0]),
+                    -MEAN[0] / STD[0],
+                )
+            })
+        });
+    }
+    group.finish();
+}
+
+fn bench_fused(c: &mut Criterion) {
+    let src = frame();
+    let mut group = c.benchmark_group("preprocess_fused");
+    group.measurement_time(Duration::from_secs(3));
+
+    for (w, h) in [(224, 224), (640, 640)] {
+        let size = format!("{}x{}", w, h);
+        group.throughput(Throughput::Elements((w * h) as u64));
+
+        group.bench_function(BenchmarkId::new("legacy", &size), |b| {
+            b.iter(|| black_box(legacy_preprocess(black_box(&src), w, h)))
+        });
+
+        for (name, kernel) in kernels() {
+            let mut pre = Preprocessor::new(PreprocessConfig::imagenet(w, h));
+            pre.set_kernel(kernel).unwrap();
+            let mut tensor = vec![0.0f32; pre.output_len()];
+            group.bench_function(BenchmarkId::new(name, &size), |b| {
+                b.iter(|| {
+                    pre.run(
+                        black_box(&src),
+                        SRC_W,
+                        SRC_H,
+                        0,
+                        PixelFormat::Rgb8,
+                        &mut tensor,
+                    )
+                    .unwrap()
+                })
+            });
+        }
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_resize, bench_normalize, bench_fused);
+criterion_main!(benches);
@@ -36,9 +36,6 @@ use std::fs;
 use std::process::{Child, Command};
 use std::time::{Duration, SystemTime};
 
-#[cfg(target_arch = "x86_64")]
-use std::arch::x86_64::_rdtsc;
-
 const ITERATIONS: usize = 50_000; // Increased for better statistics (was 10,000)
 const WARMUP: usize = 5_000; // Increased warmup (was 1,000)
 const NUM_RUNS: usize = 10; // More runs for better statistics (was 5)
@@ -107,8 +104,8 @@ struct IpcStats {
 #[inline(always)]
 fn rdtsc() -> u64 {
     #[cfg(target_arch = "x86_64")]
-    unsafe {
-        _rdtsc()
+    {
+        horus_benchmarks::timing::cycles()
     }
 
     #[cfg(not(target_arch = "x86_64"))]
@@ -131,24 +128,7 @@ fn rdtsc() -> u64 {
 
 /// Calibrate rdtsc overhead (back-to-back calls)
 fn calibrate_rdtsc() -> u64 {
-    let mut min_cost = u64::MAX;
-
-    // Warmup
-    for _ in 0..100 {
-        let _ = rdtsc();
-    }
-
-    // Measure minimum overhead
-    for _ in 0..1000 {
-        let start = rdtsc();
-        let end = rdtsc();
-        let cost = end.wrapping_sub(start);
-        if cost > 0 && cost < min_cost {
-            min_cost = cost;
-        }
-    }
-
-    min_cost
+    horus_benchmarks::timing::calibrate_overhead()
 }
 
 /// Verify TSC synchronization across cores (CRITICAL for cross-core benchmarks)
@@ -0,0 +1,904 @@
+// Benchmark binary - allow clippy warnings
+#![allow(clippy::all)]
+#![allow(dead_code)]
+
+//! # HORUS Regression Benchmark Suite
+//!
+//! Broad, fast-to-run performance coverage for gating upgrades, built on the
+//! RDTSC timing from `ipc_benchmark` (`horus_benchmarks::timing`):
+//!
+//! - `throughput` - Hub + blob pool throughput from 64 B to 8 MB payloads
+//! - `fanout`     - delivered msg/s for several publisher/subscriber counts
+//! - `network`    - one-way latency of every network backend and the router
+//! - `hframe`     - `HFrameCore::resolve_at` cost versus tree depth
+//! - `scheduler`  - per-node scheduler overhead at 10/100/1000 nodes
+//! - `logging`    - Hub send+recv cost with and without a logging context
+//!
+//! Results are written as JSON and compared against a stored baseline; the
+//! process exits with status 2 when any case regressed.
+//!
+//! ## Usage
+//!
+//! ```bash
+//! cargo build --release --bin regression_suite
+//! ./target/release/regression_suite --save-baseline     # on the known-good build
+//! ./target/release/regression_suite                     # on the candidate build
+//! ./target/release/regression_suite --quick --only network
+//! ```
+//!
+//! Options: `--baseline <path>`, `--output <path>`, `--threshold <pct>`,
+//! `--quick`, `--only <group>`, `--save-baseline`, `--log-stdout`.
+//! Network cases that can't run here (no multicast route, router not
+//! started) are recorded as skipped rather than failed.
+
+use colored::Colorize;
+use horus::prelude::{Hub, LogSummary, Node, NodeInfo, Scheduler};
+use horus_benchmarks::regression::{compare, CaseResult, Comparison, SuiteReport, Verdict};
+use horus_benchmarks::timing::{cycles, CycleClock};
+use horus_core::communication::network::{Endpoint, NetworkBackend};
+use horus_core::memory::ShmBlobPool;
+use horus_core::scheduling::config::{ExecutionMode, SchedulerConfig};
+use horus_library::hframe::{HFrame, Transform};
+use horus_library::messages::cmd_vel::CmdVel;
+use horus_library::messages::vision::{ImageEncoding, ImageHandle};
+use serde::{Deserialize, Serialize};
+use std::net::{IpAddr, Ipv4Addr, TcpStream, UdpSocket};
+use std::path::PathBuf;
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
+
+const DEFAULT_BASELINE: &str = "benchmarks/results/regression_baseline.json";
+const DEFAULT_OUTPUT: &str = "benchmarks/results/regression_latest.json";
+const DEFAULT_THRESHOLD_PCT: f64 = 10.0;
+
+const GROUPS: &[&str] = &[
+    "throughput",
+    "fanout",
+    "network",
+    "hframe",
+    "scheduler",
+    "logging",
+];
+
+/// Payload sizes for the throughput group
+const THROUGHPUT_SIZES: &[(&str, usize)] = &[
+    ("64B", 64),
+    ("1KiB", 1024),
+    ("16KiB", 16 * 1024),
+    ("256KiB", 256 * 1024),
+    ("1MiB", 1024 * 1024),
+    ("8MiB", 8 * 1024 * 1024),
+];
+
+/// (publishers, subscribers) for the fan-out group
+const FANOUT_SHAPES: &[(usize, usize)] = &[(1, 1), (1, 4), (1, 8), (4, 1), (4, 4)];
+
+/// Payload sizes for network backends (single datagram)
+const NETWORK_SIZES: &[(&str, usize)] = &[("64B", 64), ("1KiB", 1024)];
+
+const HFRAME_DEPTHS: &[usize] = &[1, 4, 16, 64];
+
+const SCHEDULER_NODE_COUNTS: &[usize] = &[10, 100, 1000];
+
+struct Options {
+    baseline: PathBuf,
+    output: PathBuf,
+    threshold_pct: f64,
+    quick: bool,
+    only: Option<String>,
+    save_baseline: bool,
+    log_stdout: bool,
+}
+
+impl Options {
+    fn parse() -> Result<Self, String> {
+        let mut opts = Options {
+            baseline: PathBuf::from(DEFAULT_BASELINE),
+            output: PathBuf::from(DEFAULT_OUTPUT),
+            threshold_pct: DEFAULT_THRESHOLD_PCT,
+            quick: false,
+            only: None,
+            save_baseline: false,
+            log_stdout: false,
+        };
+        let mut args = std::env::args().skip(1);
+        while let Some(arg) = args.next() {
+            let mut value = |name: &str| args.next().ok_or(format!("{} needs a value", name));
+            match arg.as_str() {
+                "--baseline" => opts.baseline = PathBuf::from(value("--baseline")?),
+                "--output" => opts.output = PathBuf::from(value("--output")?),
+                "--threshold" => {
+                    opts.threshold_pct = value("--threshold")?
+                        .parse()
+                        .map_err(|_| "--threshold expects a percentage".to_string())?
+                }
+                "--only" => {
+                    let group = value("--only")?;
+                    if !GROUPS.contains(&group.as_str()) {
+                        return Err(format!("Unknown group '{}' (one of {:?})", group, GROUPS));
+                    }
+                    opts.only = Some(group);
+                }
+                "--quick" => opts.quick = true,
+                "--save-baseline" => opts.save_baseline = true,
+                "--log-stdout" => opts.log_stdout = true,
+                _ => return Err(format!("Unknown argument '{}'", arg)),
+            }
+        }
+        Ok(opts)
+    }
+
+    fn runs(&self, group: &str) -> bool {
+        self.only.as_deref().map_or(true, |only| only == group)
+    }
+
+    /// Full-run count, or a tenth of it with --quick
+    fn scaled(&self, full: usize) -> usize {
+        if self.quick {
+            (full / 10).max(1)
+        } else {
+            full
+        }
+    }
+
+    fn window(&self) -> Duration {
+        if self.quick {
+            Duration::from_millis(100)
+        } else {
+            Duration::from_millis(500)
+        }
+    }
+}
+
+/// Topic name unique to this process and call
+fn unique_topic(prefix: &str) -> String {
+    static NEXT: AtomicUsize = AtomicUsize::new(0);
+    format!(
+        "regress_{}_{}_{}",
+        prefix,
+        std::process::id(),
+        NEXT.fetch_add(1, Ordering::Relaxed)
+    )
+}
+
+// ============================================================================
+// THROUGHPUT VERSUS MESSAGE SIZE
+// ============================================================================
+
+/// Write a payload into a blob slot, send its handle, receive and read it back
+///
+/// Same-thread round trips: the number reflects the copy-in + publish +
+/// resolve + read cost per byte without cross-core scheduling noise.
+fn bench_throughput(opts: &Options, clock: &CycleClock, cases: &mut Vec<CaseResult>) {
+    for &(label, size) in THROUGHPUT_SIZES {
+        let id = format!("throughput/shm_blob/{}", label);
+        let topic = unique_topic("tput");
+        let setup = ShmBlobPool::for_topic(&topic, size, 16, 8).and_then(|pool| {
+            Hub::<ImageHandle>::new_with_capacity(&topic, 8).map(|hub| (pool, hub))
+        });
+        let (pool, hub) = match setup {
+            Ok(setup) => setup,
+            Err(e) => {
+                cases.push(CaseResult::skipped(id, e.to_string()));
+                continue;
+            }
+        };
+
+        let source: Vec<u8> = (0..size).map(|i| i as u8).collect();
+        // ~64 MB per window, between 64 and 100k messages (a tenth with --quick)
+        let per_window = opts.scaled((64 * 1024 * 1024 / size).clamp(64, 100_000));
+        let mut rates = Vec::new();
+
+        for window in 0..6 {
+            let start = cycles();
+            let mut delivered = 0usize;
+            for _ in 0..per_window {
+                let Ok(mut blob) = pool.loan(size) else {
+                    continue;
+                };
+                blob.as_mut_slice().copy_from_slice(&source);
+                let msg = ImageHandle::new(size as u32, 1, ImageEncoding::Mono8, blob.publish());
+                if hub.send(msg, &mut None).is_err() {
+                    continue;
+                }
+                if let Some(sample) = hub.recv_blob(&pool, &mut None) {
+                    // Touch every cache line the way a consumer would
+                    let data = sample.data();
+                    let mut acc = 0u8;
+                    for i in (0..data.len()).step_by(64) {
+                        acc ^= data[i];
+                    }
+                    std::hint::black_box(acc);
+                    delivered += data.len();
+                }
+            }
+            let secs = clock.to_ns(cycles().wrapping_sub(start)) / 1e9;
+            // First window is warmup
+            if window > 0 && secs > 0.0 {
+                rates.push(delivered as f64 / secs / 1e6);
+            }
+        }
+        cases.push(CaseResult::throughput(id, "MB/s", &mut rates));
+    }
+}
+
+// ============================================================================
+// FAN-OUT SCALING
+// ============================================================================
+
+/// Delivered messages per second with P publishers and S subscribers
+fn bench_fanout(opts: &Options, cases: &mut Vec<CaseResult>) {
+    for &(publishers, subscribers) in FANOUT_SHAPES {
+        let id = format!("fanout/pub{}_sub{}", publishers, subscribers);
+        let topic = unique_topic("fanout");
+        let mut rates = Vec::new();
+
+        for _ in 0..4 {
+            match fanout_window(&topic, publishers, subscribers, opts.window()) {
+                Ok(rate) => rates.push(rate),
+                Err(e) => {
+                    rates.clear();
+                    cases.push(CaseResult::skipped(id.clone(), e));
+                    break;
+                }
+            }
+        }
+        if !rates.is_empty() {
+            // First window is warmup
+            rates.remove(0);
+            cases.push(CaseResult::throughput(id, "msg/s", &mut rates));
+        }
+    }
+}
+
+fn fanout_window(
+    topic: &str,
+    publishers: usize,
+    subscribers: usize,
+    window: Duration,
+) -> Result<f64, String> {
+    let stop = Arc::new(AtomicBool::new(false));
+    let received = Arc::new(AtomicU64::new(0));
+
+    // Hubs are created up front so no subscriber misses the start
+    let sub_hubs = (0..subscribers)
+        .map(|_| Hub::<CmdVel>::new(topic).map_err(|e| e.to_string()))
+        .collect::<Result<Vec<_>, _>>()?;
+    let pub_hubs = (0..publishers)
+        .map(|_| Hub::<CmdVel>::new(topic).map_err(|e| e.to_string()))
+        .collect::<Result<Vec<_>, _>>()?;
+
+    let mut threads = Vec::new();
+    for hub in sub_hubs {
+        let stop = stop.clone();
+        let received = received.clone();
+        threads.push(std::thread::spawn(move || {
+            let mut count = 0u64;
+            while !stop.load(Ordering::Relaxed) {
+                if hub.recv(&mut None).is_some() {
+                    count += 1;
+                } else {
+                    std::hint::spin_loop();
+                }
+            }
+            received.fetch_add(count, Ordering::Relaxed);
+        }));
+    }
+    for hub in pub_hubs {
+        let stop = stop.clone();
+        threads.push(std::thread::spawn(move || {
+            let msg = CmdVel::new(1.0, 0.5);
+            while !stop.load(Ordering::Relaxed) {
+                let _ = hub.send(msg, &mut None);
+            }
+        }));
+    }
+
+    let start = Instant::now();
+    std::thread::sleep(window);
+    stop.store(true, Ordering::Relaxed);
+    let elapsed = start.elapsed().as_secs_f64();
+    for t in threads {
+        t.join()
+            .map_err(|_| "fan-out worker panicked".to_string())?;
+    }
+    Ok(received.load(Ordering::Relaxed) as f64 / elapsed)
+}
+
+// ============================================================================
+// NETWORK BACKENDS
+// ============================================================================
+
+/// Serialized payload for network backends
+#[derive(Clone, Debug, Serialize, Deserialize)]
+struct NetPayload {
+    seq: u64,
+    #[serde(with = "serde_bytes")]
+    data: Vec<u8>,
+}
+
+impl LogSummary for NetPayload {
+    fn log_summary(&self) -> String {
+        format!("NetPayload(#{}, {} bytes)", self.seq, self.data.len())
+    }
+}
+
+/// Where a backend's messages are picked up
+enum NetReceiver {
+    Hub(Hub<NetPayload>),
+    /// Direct UDP sends to a fixed address; listen there with a plain socket
+    Socket(UdpSocket, Vec<u8>),
+}
+
+/// What sends a backend's messages
+enum NetPublisher {
+    Hub(Hub<NetPayload>),
+    /// A backend the Hub endpoint syntax can't select on its own
+    Backend(NetworkBackend<NetPayload>),
+}
+
+impl NetPublisher {
+    fn send(&self, msg: &NetPayload) -> bool {
+        match self {
+            NetPublisher::Hub(hub) => hub.send(msg.clone(), &mut None).is_ok(),
+            NetPublisher::Backend(backend) => backend.send(msg).is_ok(),
+        }
+    }
+}
+
+impl NetReceiver {
+    fn try_recv(&mut self) -> bool {
+        match self {
+            NetReceiver::Hub(hub) => hub.recv(&mut None).is_some(),
+            NetReceiver::Socket(socket, buf) => socket.recv_from(buf).is_ok(),
+        }
+    }
+}
+
+fn bench_network(opts: &Options, clock: &CycleClock, cases: &mut Vec<CaseResult>) {
+    let backends: &[&str] = &[
+        "unix_socket",
+        "udp_direct",
+        "batch_udp",
+        "multicast",
+        "router",
+    ];
+    for &backend in backends {
+        for &(label, size) in NETWORK_SIZES {
+            let id = format!("network/{}/{}", backend, label);
+            let case = match net_endpoints(backend) {
+                Ok((publisher, receiver)) => {
+                    net_latency(&id, publisher, receiver, size, opts.scaled(5_000), clock)
+                }
+                Err(reason) => CaseResult::skipped(id, reason),
+            };
+            if let Some(ref reason) = case.skipped {
+                println!("  {} {} skipped: {}", "→".bright_cyan(), case.id, reason);
+            }
+            cases.push(case);
+        }
+    }
+}
+
+fn net_endpoints(backend: &str) -> Result<(NetPublisher, NetReceiver), String> {
+    let topic = unique_topic("net");
+    let hub = |endpoint: &str| {
+        Hub::<NetPayload>::new(endpoint)
+            .map(NetPublisher::Hub)
+            .map_err(|e| e.to_string())
+    };
+    let receiver_hub = |endpoint: &str| {
+        Hub::<NetPayload>::new(endpoint)
+            .map(NetReceiver::Hub)
+            .map_err(|e| e.to_string())
+    };
+    let listen = |ip: IpAddr| -> Result<(UdpSocket, u16), String> {
+        let socket = UdpSocket::bind((ip, 0)).map_err(|e| e.to_string())?;
+        socket
+            .set_read_timeout(Some(Duration::from_millis(100)))
+            .map_err(|e| e.to_string())?;
+        let port = socket.local_addr().map_err(|e| e.to_string())?.port();
+        Ok((socket, port))
+    };
+    match backend {
+        "unix_socket" => {
+            let endpoint = format!("{}@localhost", topic);
+            let receiver = receiver_hub(&endpoint)?;
+            Ok((hub(&endpoint)?, receiver))
+        }
+        "udp_direct" => {
+            let (socket, port) = listen(Ipv4Addr::LOCALHOST.into())?;
+            let publisher = hub(&format!("{}@127.0.0.1:{}", topic, port))?;
+            Ok((publisher, NetReceiver::Socket(socket, vec![0u8; 65536])))
+        }
+        "batch_udp" => {
+            // Smart transport only picks batch UDP for LAN peers, so target
+            // this host's own private address rather than loopback
+            let ip = lan_address().ok_or("no private IPv4 address on this host")?;
+            let (socket, port) = listen(ip.into())?;
+            let publisher = NetworkBackend::<NetPayload>::new(Endpoint::Direct {
+                topic,
+                host: ip.into(),
+                port,
+            })
+            .map_err(|e| e.to_string())?;
+            if publisher.transport_type() != "batch_udp" {
+                return Err(format!(
+                    "transport selection chose {}",
+                    publisher.transport_type()
+                ));
+            }
+            Ok((
+                NetPublisher::Backend(publisher),
+                NetReceiver::Socket(socket, vec![0u8; 65536]),
+            ))
+        }
+        "multicast" => {
+            let endpoint = format!("{}@*", topic);
+            let receiver = receiver_hub(&endpoint)?;
+            Ok((hub(&endpoint)?, receiver))
+        }
+        "router" => {
+            let addr = "127.0.0.1:7777".parse().unwrap();
+            TcpStream::connect_timeout(&addr, Duration::from_millis(200))
+                .map_err(|_| "horus_router is not running on 127.0.0.1:7777".to_string())?;
+            let endpoint = format!("{}@router", topic);
+            let receiver = receiver_hub(&endpoint)?;
+            Ok((hub(&endpoint)?, receiver))
+        }
+        _ => Err(format!("unknown backend '{}'", backend)),
+    }
+}
+
+/// This host's address on a private or link-local IPv4 network, if any
+///
+/// Connecting a UDP socket only picks the outgoing route; nothing is sent.
+fn lan_address() -> Option<Ipv4Addr> {
+    let probe = UdpSocket::bind("0.0.0.0:0").ok()?;
+    probe.connect("10.255.255.255:9").ok()?;
+    match probe.local_addr().ok()?.ip() {
+        IpAddr::V4(ip) if ip.is_private() || ip.is_link_local() => Some(ip),
+        _ => None,
+    }
+}
+
+/// One-way latency: send, then poll the receiver until the message arrives
+fn net_latency(
+    id: &str,
+    publisher: NetPublisher,
+    mut receiver: NetReceiver,
+    size: usize,
+    iterations: usize,
+    clock: &CycleClock,
+) -> CaseResult {
+    let timeout = Duration::from_millis(100);
+    let mut msg = NetPayload {
+        seq: 0,
+        data: vec![0xA5; size],
+    };
+    let mut samples = Vec::with_capacity(iterations);
+    let mut lost = 0usize;
+
+    // Some backends need a moment to connect or join
+    std::thread::sleep(Duration::from_millis(50));
+
+    for i in 0..iterations + iterations / 10 {
+        msg.seq = i as u64;
+        let start = cycles();
+        if !publisher.send(&msg) {
+            return CaseResult::skipped(id, "send failed");
+        }
+        let deadline = Instant::now() + timeout;
+        let mut arrived = false;
+        while Instant::now() < deadline {
+            if receiver.try_recv() {
+                arrived = true;
+                break;
+            }
+            std::hint::spin_loop();
+        }
+        let ns = clock.to_ns(cycles().wrapping_sub(start));
+
+        if !arrived {
+            lost += 1;
+            if samples.is_empty() && lost >= 5 {
+                return CaseResult::skipped(id, "no messages delivered on this host");
+            }
+            continue;
+        }
+        // The first tenth is warmup
+        if i >= iterations / 10 {
+            samples.push(ns);
+        }
+    }
+    if lost > 0 {
+        println!(
+            "  {} {}: {} of {} messages lost",
+            "!".yellow(),
+            id,
+            lost,
+            iterations + iterations / 10
+        );
+    }
+    CaseResult::latency(id, &mut samples)
+}
+
+// ============================================================================
+// HFRAME TRANSFORM RESOLUTION
+// ============================================================================
+
+/// `resolve_at` from the leaf of a chain of `depth` frames to the root,
+/// interpolating between two history samples
+fn bench_hframe(opts: &Options, clock: &CycleClock, cases: &mut Vec<CaseResult>) {
+    const BATCH: usize = 1000;
+
+    for &depth in HFRAME_DEPTHS {
+        let id = format!("hframe/resolve_at/depth{}", depth);
+        let hf = HFrame::new();
+        let mut leaf = None;
+        let mut setup = || -> Result<(), String> {
+            let root = hf
+                .register_frame("world", None)
+                .map_err(|e| e.to_string())?;
+            let mut parent = "world".to_string();
+            for level in 1..=depth {
+                let name = format!("frame_{}", level);
+                let frame = hf
+                    .register_frame(&name, Some(&parent))
+                    .map_err(|e| e.to_string())?;
+                hf.update_transform_by_id(
+                    frame,
+                    &Transform::from_translation([0.1, 0.0, 0.0]),
+                    1000,
+                );
+                hf.update_transform_by_id(
+                    frame,
+                    &Transform::from_translation([0.2, 0.0, 0.0]),
+                    2000,
+                );
+                leaf = Some((frame, root));
+                parent = name;
+            }
+            Ok(())
+        };
+        if let Err(e) = setup() {
+            cases.push(CaseResult::skipped(id, e));
+            continue;
+        }
+        let (leaf, root) = leaf.unwrap();
+
+        let mut samples = Vec::new();
+        for batch in 0..opts.scaled(200) + 10 {
+            let start = cycles();
+            for _ in 0..BATCH {
+                std::hint::black_box(hf.core.resolve_at(leaf, root, std::hint::black_box(1500)));
+            }
+            let ns = clock.to_ns(cycles().wrapping_sub(start)) / BATCH as f64;
+            if batch >= 10 {
+                samples.push(ns);
+            }
+        }
+        cases.push(CaseResult::latency(id, &mut samples));
+    }
+}
+
+// ============================================================================
+// SCHEDULER OVERHEAD
+// ============================================================================
+
+/// Start/end stamps of one scheduler tick, shared by the first and last node
+#[derive(Default)]
+struct TickProbe {
+    start: AtomicU64,
+    cycle_ns: Mutex<Vec<f64>>,
+}
+
+/// Node that does nothing, so what's measured is the scheduler itself
+struct NoopNode {
+    name: &'static str,
+    probe: Option<(Arc<TickProbe>, bool)>,
+    clock: CycleClock,
+}
+
+impl Node for NoopNode {
+    fn name(&self) -> &'static str {
+        self.name
+    }
+
+    fn tick(&mut self, _ctx: Option<&mut NodeInfo>) {
+        match self.probe {
+            Some((ref probe, true)) => probe.start.store(cycles(), Ordering::Relaxed),
+            Some((ref probe, false)) => {
+                let start = probe.start.load(Ordering::Relaxed);
+                let ns = self.clock.to_ns(cycles().wrapping_sub(start));
+                probe.cycle_ns.lock().unwrap().push(ns);
+            }
+            None => {}
+        }
+    }
+}
+
+/// Per-node overhead: first-to-last node span of a tick divided by node count
+fn bench_scheduler(opts: &Options, clock: &CycleClock, cases: &mut Vec<CaseResult>) {
+    for &count in SCHEDULER_NODE_COUNTS {
+        let id = format!("scheduler/per_node/{}", count);
+        let probe = Arc::new(TickProbe::default());
+
+        let mut config = SchedulerConfig::standard();
+        config.execution = ExecutionMode::Sequential;
+        config.timing.global_rate_hz = 1000.0;
+        let mut scheduler = Scheduler::new()
+            .with_config(config)
+            .disable_learning()
+            .with_name("regression_suite");
+
+        for i in 0..count {
+            // Node names are &'static str; a few KB leaked per run is fine here
+            let name: &'static str = Box::leak(format!("noop_{:04}", i).into_boxed_str());
+            let probe = match i {
+                0 => Some((probe.clone(), true)),
+                i if i == count - 1 => Some((probe.clone(), false)),
+                _ => None,
+            };
+            scheduler.add(
+                Box::new(NoopNode {
+                    name,
+                    probe,
+                    clock: *clock,
+                }),
+                i as u32,
+                Some(false),
+            );
+        }
+
+        let duration = if opts.quick {
+            Duration::from_millis(500)
+        } else {
+            Duration::from_secs(3)
+        };
+        if let Err(e) = scheduler.run_for(duration) {
+            cases.push(CaseResult::skipped(id, e.to_string()));
+            continue;
+        }
+
+        let mut samples: Vec<f64> = std::mem::take(&mut *probe.cycle_ns.lock().unwrap())
+            .into_iter()
+            // Skip the first ticks (node init, page faults)
+            .skip(10)
+            .map(|ns| ns / (count - 1).max(1) as f64)
+            .collect();
+        if samples.is_empty() {
+            cases.push(CaseResult::skipped(id, "scheduler produced no ticks"));
+        } else {
+            cases.push(CaseResult::latency(id, &mut samples));
+        }
+    }
+}
+
+// ============================================================================
+// LOGGING COST
+// ============================================================================
+
+/// Hub send + recv of a CmdVel with no context, a context that only writes
+/// the binary log ring, and (opt-in, it floods the terminal) stdout logging
+fn bench_logging(opts: &Options, clock: &CycleClock, cases: &mut Vec<CaseResult>) {
+    const BATCH: usize = 100;
+
+    let mut modes: Vec<(&str, Option<bool>)> = vec![("off", None), ("ring", Some(false))];
+    if opts.log_stdout {
+        modes.push(("stdout", Some(true)));
+    }
+
+    for (label, logging) in modes {
+        let id = format!("logging/{}", label);
+        let topic = unique_topic("logging");
+        let hub = match Hub::<CmdVel>::new(&topic) {
+            Ok(hub) => hub,
+            Err(e) => {
+                cases.push(CaseResult::skipped(id, e.to_string()));
+                continue;
+            }
+        };
+        let mut info =
+            logging.map(|enabled| NodeInfo::new("regression_logging".to_string(), enabled));
+        let batches = if logging == Some(true) {
+            20
+        } else {
+            opts.scaled(500)
+        };
+
+        let mut samples = Vec::new();
+        for batch in 0..batches + 5 {
+            let start = cycles();
+            for _ in 0..BATCH {
+                let mut ctx = info.as_mut();
+                let _ = hub.send(CmdVel::new(1.0, 0.5), &mut ctx);
+                std::hint::black_box(hub.recv(&mut ctx));
+            }
+            let ns = clock.to_ns(cycles().wrapping_sub(start)) / BATCH as f64;
+            if batch >= 5 {
+                samples.push(ns);
+            }
+        }
+        cases.push(CaseResult::latency(id, &mut samples));
+    }
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+fn print_cases(cases: &[CaseResult]) {
+    println!(
+        "\n{:<40} {:>14} {:>8} {:>12} {:>8}",
+        "Case", "Value", "Unit", "P99", "Noise"
+    );
+    println!("{}", "─".repeat(86));
+    for case in cases {
+        if let Some(ref reason) = case.skipped {
+            println!("{:<40} {:>14}  ({})", case.id, "skipped".dimmed(), reason);
+            continue;
+        }
+        let p99 = case
+            .p99
+            .map(|p| format!("{:.1}", p))
+            .unwrap_or_else(|| "-".to_string());
+        println!(
+            "{:<40} {:>14.1} {:>8} {:>12} {:>7.1}%",
+            case.id,
+            case.value,
+            case.unit,
+            p99,
+            case.noise * 100.0
+        );
+    }
+}
+
+fn print_comparison(comparisons: &[Comparison]) {
+    println!("\n{}", "═".repeat(86).bright_cyan());
+    println!("{}", "  BASELINE COMPARISON".bright_cyan().bold());
+    println!("{}", "═".repeat(86).bright_cyan());
+    println!(
+        "{:<40} {:>14} {:>14} {:>8}  {}",
+        "Case", "Baseline", "Current", "Worse", "Verdict"
+    );
+    println!("{}", "─".repeat(86));
+    let fmt = |v: Option<f64>| {
+        v.map(|v| format!("{:.1}", v))
+            .unwrap_or_else(|| "-".to_string())
+    };
+    for c in comparisons {
+        let verdict = match c.verdict {
+            Verdict::Regressed => "REGRESSED".red().bold(),
+            Verdict::Improved => "improved".green(),
+            Verdict::Unchanged => "ok".normal(),
+            Verdict::New => "new".bright_cyan(),
+            Verdict::NotRun => "not run".yellow(),
+        };
+        println!(
+            "{:<40} {:>14} {:>14} {:>7.1}%  {}",
+            c.id,
+            fmt(c.baseline),
+            fmt(c.current),
+            c.worse_by_pct,
+            verdict
+        );
+    }
+}
+
+fn main() {
+    let opts = match Options::parse() {
+        Ok(opts) => opts,
+        Err(e) => {
+            eprintln!("{} {}", "Error:".red().bold(), e);
+            std::process::exit(1);
+        }
+    };
+
+    println!("\n{}", "═".repeat(86).bright_cyan().bold());
+    println!(
+        "{}",
+        "  HORUS REGRESSION BENCHMARK SUITE".bright_cyan().bold()
+    );
+    println!("{}", "═".repeat(86).bright_cyan().bold());
+
+    let clock = CycleClock::get();
+    println!(
+        "  Counter: {:.3} ticks/ns, read overhead {} ticks{}",
+        clock.ticks_per_ns,
+        clock.overhead,
+        if opts.quick { " (quick mode)" } else { "" }
+    );
+
+    let mut cases = Vec::new();
+    if opts.runs("throughput") {
+        println!("\n{}", "Throughput versus message size...".bright_yellow());
+        bench_throughput(&opts, &clock, &mut cases);
+    }
+    if opts.runs("fanout") {
+        println!("{}", "Fan-out scaling...".bright_yellow());
+        bench_fanout(&opts, &mut cases);
+    }
+    if opts.runs("network") {
+        println!("{}", "Network backends...".bright_yellow());
+        bench_network(&opts, &clock, &mut cases);
+    }
+    if opts.runs("hframe") {
+        println!("{}", "HFrame resolve_at depth scaling...".bright_yellow());
+        bench_hframe(&opts, &clock, &mut cases);
+    }
+    if opts.runs("scheduler") {
+        println!("{}", "Scheduler overhead per node...".bright_yellow());
+        bench_scheduler(&opts, &clock, &mut cases);
+    }
+    if opts.runs("logging") {
+        println!("{}", "Logging cost...".bright_yellow());
+        bench_logging(&opts, &clock, &mut cases);
+    }
+
+    let report = SuiteReport::new(cases);
+    print_cases(&report.cases);
+
+    if let Err(e) = report.save(&opts.output) {
+        eprintln!("{} {}", "Error:".red().bold(), e);
+        std::process::exit(1);
+    }
+    println!("\n  Results saved to {}", opts.output.display());
+
+    if opts.save_baseline {
+        if let Err(e) = report.save(&opts.baseline) {
+            eprintln!("{} {}", "Error:".red().bold(), e);
+            std::process::exit(1);
+        }
+        println!("  Baseline saved to {}", opts.baseline.display());
+        return;
+    }
+
+    let baseline = match SuiteReport::load(&opts.baseline) {
+        Ok(baseline) => baseline,
+        Err(_) => {
+            println!(
+                "  No baseline at {} (run with --save-baseline to create one)",
+                opts.baseline.display()
+            );
+            return;
+        }
+    };
+    if baseline.platform.cpu_model != report.platform.cpu_model {
+        println!(
+            "  {} Baseline was recorded on '{}', this run is on '{}'",
+            "!".yellow(),
+            baseline.platform.cpu_model,
+            report.platform.cpu_model
+        );
+    }
+
+    let comparisons = compare(&baseline, &report, opts.threshold_pct);
+    print_comparison(&comparisons);
+
+    let comparison_path = opts.output.with_extension("comparison.json");
+    match serde_json::to_string_pretty(&comparisons) {
+        Ok(json) => {
+            if let Err(e) = std::fs::write(&comparison_path, json) {
+                eprintln!("  Failed to write {}: {}", comparison_path.display(), e);
+            }
+        }
+        Err(e) => eprintln!("  Failed to serialize comparison: {}", e),
+    }
+
+    let regressed = comparisons
+        .iter()
+        .filter(|c| c.verdict == Verdict::Regressed)
+        .count();
+    if regressed > 0 {
+        println!(
+            "\n  {} {} case(s) regressed beyond {:.0}%",
+            "✗".red().bold(),
+            regressed,
+            opts.threshold_pct
+        );
+        std::process::exit(2);
+    }
+    println!("\n  {} No regressions", "✓".green().bold());
+}
@@ -13,6 +13,9 @@
 #![allow(unused_variables)]
 #![allow(unused_mut)]
 
+pub mod regression;
+pub mod timing;
+
 use serde::{Deserialize, Serialize};
 use std::time::Duration;
 
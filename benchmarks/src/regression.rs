@@ -0,0 +1,368 @@
+//! Machine-readable benchmark results and baseline comparison
+//!
+//! Every case of the regression suite reports one headline value (median
+//! latency or sustained throughput) plus its noise, measured as the median
+//! absolute deviation relative to the median. A case regresses when it moves
+//! in the bad direction by more than the threshold *and* by more than three
+//! times the combined noise of both runs, so a jittery case doesn't flag on
+//! every run.
+
+use serde::{Deserialize, Serialize};
+use std::path::Path;
+
+/// Bumped when case ids or units change meaning
+pub const SUITE_VERSION: u32 = 1;
+
+/// One measured (or skipped) benchmark case
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct CaseResult {
+    /// Stable id, e.g. "throughput/shm_blob/1MiB"
+    pub id: String,
+    /// Unit of `value` and `p99` ("ns", "msg/s", "MB/s")
+    pub unit: String,
+    pub higher_is_better: bool,
+    /// Headline value: median latency or median throughput
+    pub value: f64,
+    /// 99th percentile (latency cases only)
+    pub p99: Option<f64>,
+    pub samples: usize,
+    /// Median absolute deviation / median
+    pub noise: f64,
+    /// Why the case could not run (backend unavailable, ...)
+    pub skipped: Option<String>,
+}
+
+impl CaseResult {
+    /// Latency case from raw samples in nanoseconds
+    pub fn latency(id: impl Into<String>, samples_ns: &mut [f64]) -> Self {
+        let (median, noise) = median_and_noise(samples_ns);
+        CaseResult {
+            id: id.into(),
+            unit: "ns".to_string(),
+            higher_is_better: false,
+            value: median,
+            p99: Some(crate::calculate_percentile(samples_ns, 99.0)),
+            samples: samples_ns.len(),
+            noise,
+            skipped: None,
+        }
+    }
+
+    /// Throughput case from repeated rate measurements
+    pub fn throughput(id: impl Into<String>, unit: &str, rates: &mut [f64]) -> Self {
+        let (median, noise) = median_and_noise(rates);
+        CaseResult {
+            id: id.into(),
+            unit: unit.to_string(),
+            higher_is_better: true,
+            value: median,
+            p99: None,
+            samples: rates.len(),
+            noise,
+            skipped: None,
+        }
+    }
+
+    /// Case that could not run in this environment
+    pub fn skipped(id: impl Into<String>, reason: impl Into<String>) -> Self {
+        CaseResult {
+            id: id.into(),
+            unit: String::new(),
+            higher_is_better: false,
+            value: 0.0,
+            p99: None,
+            samples: 0,
+            noise: 0.0,
+            skipped: Some(reason.into()),
+        }
+    }
+}
+
+/// Sort `values` and return (median, MAD / median)
+fn median_and_noise(values: &mut [f64]) -> (f64, f64) {
+    if values.is_empty() {
+        return (0.0, 0.0);
+    }
+    values.sort_by(|a, b| a.partial_cmp(b).unwrap());
+    let median = crate::calculate_percentile(values, 50.0);
+    let mut deviations: Vec<f64> = values.iter().map(|v| (v - median).abs()).collect();
+    deviations.sort_by(|a, b| a.partial_cmp(b).unwrap());
+    let mad = crate::calculate_percentile(&deviations, 50.0);
+    let noise = if median != 0.0 {
+        mad / median.abs()
+    } else {
+        0.0
+    };
+    (median, noise)
+}
+
+/// Where a report was produced
+#[derive(Debug, Clone, Default, Serialize, Deserialize)]
+pub struct PlatformSummary {
+    pub cpu_model: String,
+    pub logical_cores: usize,
+    pub os: String,
+    pub kernel: String,
+    pub arch: String,
+}
+
+impl PlatformSummary {
+    pub fn detect() -> Self {
+        let mut platform = PlatformSummary {
+            cpu_model: "Unknown".to_string(),
+            logical_cores: std::thread::available_parallelism()
+                .map(|n| n.get())
+                .unwrap_or(1),
+            os: std::env::consts::OS.to_string(),
+            kernel: "Unknown".to_string(),
+            arch: std::env::consts::ARCH.to_string(),
+        };
+        #[cfg(target_os = "linux")]
+        {
+            if let Ok(cpuinfo) = std::fs::read_to_string("/proc/cpuinfo") {
+                if let Some(model) = cpuinfo
+                    .lines()
+                    .find(|l| l.starts_with("model name"))
+                    .and_then(|l| l.split(':').nth(1))
+                {
+                    platform.cpu_model = model.trim().to_string();
+                }
+            }
+            if let Ok(release) = std::fs::read_to_string("/proc/sys/kernel/osrelease") {
+                platform.kernel = release.trim().to_string();
+            }
+        }
+        platform
+    }
+}
+
+/// A full run of the regression suite
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct SuiteReport {
+    pub suite_version: u32,
+    /// Seconds since the Unix epoch
+    pub timestamp: u64,
+    /// `git rev-parse HEAD` of the tree under test, when available
+    pub git_rev: Option<String>,
+    pub platform: PlatformSummary,
+    pub cases: Vec<CaseResult>,
+}
+
+impl SuiteReport {
+    pub fn new(cases: Vec<CaseResult>) -> Self {
+        SuiteReport {
+            suite_version: SUITE_VERSION,
+            timestamp: std::time::SystemTime::now()
+                .duration_since(std::time::UNIX_EPOCH)
+                .map(|d| d.as_secs())
+                .unwrap_or(0),
+            git_rev: std::process::Command::new("git")
+                .args(["rev-parse", "HEAD"])
+                .output()
+                .ok()
+                .filter(|o| o.status.success())
+                .map(|o| String::from_utf8_lossy(&o.stdout).trim().to_string()),
+            platform: PlatformSummary::detect(),
+            cases,
+        }
+    }
+
+    pub fn load(path: &Path) -> Result<Self, String> {
+        let content = std::fs::read_to_string(path)
+            .map_err(|e| format!("Failed to read {}: {}", path.display(), e))?;
+        serde_json::from_str(&content)
+            .map_err(|e| format!("Failed to parse {}: {}", path.display(), e))
+    }
+
+    pub fn save(&self, path: &Path) -> Result<(), String> {
+        if let Some(parent) = path.parent() {
+            std::fs::create_dir_all(parent)
+                .map_err(|e| format!("Failed to create {}: {}", parent.display(), e))?;
+        }
+        let json = serde_json::to_string_pretty(self)
+            .map_err(|e| format!("Failed to serialize: {}", e))?;
+        std::fs::write(path, json).map_err(|e| format!("Failed to write {}: {}", path.display(), e))
+    }
+}
+
+/// Outcome of comparing one case against the baseline
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
+pub enum Verdict {
+    Regressed,
+    Improved,
+    Unchanged,
+    /// Not in the baseline (or skipped there)
+    New,
+    /// Measured in the baseline but skipped or missing in this run
+    NotRun,
+}
+
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct Comparison {
+    pub id: String,
+    pub baseline: Option<f64>,
+    pub current: Option<f64>,
+    /// Change in the "worse" direction, in percent (negative = better)
+    pub worse_by_pct: f64,
+    pub verdict: Verdict,
+}
+
+/// Compare every case of `current` with the same case in `baseline`
+///
+/// `threshold_pct` is the smallest change worth flagging; noisier cases need
+/// a proportionally larger change. Baseline cases this run never produced
+/// are reported as [`Verdict::NotRun`] after the rest.
+pub fn compare(
+    baseline: &SuiteReport,
+    current: &SuiteReport,
+    threshold_pct: f64,
+) -> Vec<Comparison> {
+    let mut comparisons: Vec<Comparison> = current
+        .cases
+        .iter()
+        .map(|case| {
+            let base = baseline
+                .cases
+                .iter()
+                .find(|b| b.id == case.id && b.skipped.is_none())
+                .filter(|b| case.skipped.is_some() || b.unit == case.unit);
+            let (Some(base), None) = (base, &case.skipped) else {
+                let verdict = if case.skipped.is_some() && base.is_some() {
+                    Verdict::NotRun
+                } else {
+                    Verdict::New
+                };
+                return Comparison {
+                    id: case.id.clone(),
+                    baseline: base.map(|b| b.value),
+                    current: case.skipped.is_none().then_some(case.value),
+                    worse_by_pct: 0.0,
+                    verdict,
+                };
+            };
+
+            let change = if base.value != 0.0 {
+                (case.value - base.value) / base.value.abs()
+            } else {
+                0.0
+            };
+            let worse_by = if case.higher_is_better {
+                -change
+            } else {
+                change
+            };
+            let tolerance = (threshold_pct / 100.0).max(3.0 * (base.noise + case.noise));
+            let verdict = if worse_by > tolerance {
+                Verdict::Regressed
+            } else if worse_by < -tolerance {
+                Verdict::Improved
+            } else {
+                Verdict::Unchanged
+            };
+            Comparison {
+                id: case.id.clone(),
+                baseline: Some(base.value),
+                current: Some(case.value),
+                worse_by_pct: worse_by * 100.0,
+                verdict,
+            }
+        })
+        .collect();
+
+    let missing = baseline
+        .cases
+        .iter()
+        .filter(|b| b.skipped.is_none() && !current.cases.iter().any(|case| case.id == b.id));
+    comparisons.extend(missing.map(|b| Comparison {
+        id: b.id.clone(),
+        baseline: Some(b.value),
+        current: None,
+        worse_by_pct: 0.0,
+        verdict: Verdict::NotRun,
+    }));
+    comparisons
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn report(cases: Vec<CaseResult>) -> SuiteReport {
+        SuiteReport {
+            suite_version: SUITE_VERSION,
+            timestamp: 0,
+            git_rev: None,
+            platform: PlatformSummary::default(),
+            cases,
+        }
+    }
+
+    fn latency(id: &str, value: f64, noise: f64) -> CaseResult {
+        CaseResult {
+            noise,
+            ..CaseResult::latency(id, &mut [value])
+        }
+    }
+
+    #[test]
+    fn test_median_and_noise() {
+        let mut samples = [100.0, 102.0, 98.0, 101.0, 99.0, 500.0];
+        let case = CaseResult::latency("x", &mut samples);
+        assert_eq!(case.value, 100.5);
+        // One outlier barely moves the MAD
+        assert!(case.noise < 0.02);
+        assert_eq!(case.samples, 6);
+    }
+
+    #[test]
+    fn test_regression_direction() {
+        let base = report(vec![
+            latency("lat", 100.0, 0.0),
+            CaseResult::throughput("tput", "msg/s", &mut [1000.0]),
+        ]);
+        let cur = report(vec![
+            latency("lat", 120.0, 0.0),
+            CaseResult::throughput("tput", "msg/s", &mut [1300.0]),
+        ]);
+        let cmp = compare(&base, &cur, 10.0);
+        assert_eq!(cmp[0].verdict, Verdict::Regressed);
+        assert!((cmp[0].worse_by_pct - 20.0).abs() < 1e-9);
+        assert_eq!(cmp[1].verdict, Verdict::Improved);
+    }
+
+    #[test]
+    fn test_noise_widens_tolerance() {
+        let base = report(vec![latency("lat", 100.0, 0.05)]);
+        let cur = report(vec![latency("lat", 125.0, 0.05)]);
+        // 25% is above the 10% threshold but within 3 × (5% + 5%) noise
+        assert_eq!(compare(&base, &cur, 10.0)[0].verdict, Verdict::Unchanged);
+    }
+
+    #[test]
+    fn test_new_and_skipped_cases() {
+        let base = report(vec![latency("a", 100.0, 0.0)]);
+        let cur = report(vec![
+            CaseResult::skipped("a", "router not running"),
+            latency("b", 50.0, 0.0),
+        ]);
+        let cmp = compare(&base, &cur, 10.0);
+        assert_eq!(cmp[0].verdict, Verdict::NotRun);
+        assert_eq!(cmp[1].verdict, Verdict::New);
+    }
+
+    #[test]
+    fn test_cases_missing_from_run() {
+        let base = report(vec![
+            latency("a", 100.0, 0.0),
+            latency("gone", 80.0, 0.0),
+            CaseResult::skipped("never_ran", "router not running"),
+        ]);
+        let cur = report(vec![latency("a", 100.0, 0.0)]);
+        let cmp = compare(&base, &cur, 10.0);
+        assert_eq!(cmp.len(), 2);
+        assert_eq!(cmp[1].id, "gone");
+        assert_eq!(cmp[1].verdict, Verdict::NotRun);
+        assert_eq!(cmp[1].baseline, Some(80.0));
+        assert_eq!(cmp[1].current, None);
+    }
+}
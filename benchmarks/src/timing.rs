@@ -0,0 +1,100 @@
+//! Cycle-accurate timing shared by the benchmark binaries
+//!
+//! The RDTSC reader and null-cost calibration from `ipc_benchmark`, plus a
+//! cycles→nanoseconds conversion measured against the monotonic clock.
+//! On architectures without RDTSC, `cycles()` falls back to monotonic
+//! nanoseconds so the regression suite still runs there (at ~20ns precision).
+
+use std::sync::OnceLock;
+use std::time::{Duration, Instant};
+
+#[cfg(target_arch = "x86_64")]
+use std::arch::x86_64::_rdtsc;
+
+/// Read the CPU timestamp counter (cycles, not nanoseconds)
+#[inline(always)]
+pub fn cycles() -> u64 {
+    #[cfg(target_arch = "x86_64")]
+    unsafe {
+        _rdtsc()
+    }
+
+    #[cfg(not(target_arch = "x86_64"))]
+    {
+        static EPOCH: OnceLock<Instant> = OnceLock::new();
+        EPOCH.get_or_init(Instant::now).elapsed().as_nanos() as u64
+    }
+}
+
+/// Minimum cost of two back-to-back `cycles()` calls
+pub fn calibrate_overhead() -> u64 {
+    let mut min_cost = u64::MAX;
+
+    // Warmup
+    for _ in 0..100 {
+        let _ = cycles();
+    }
+
+    // Measure minimum overhead
+    for _ in 0..1000 {
+        let start = cycles();
+        let end = cycles();
+        let cost = end.wrapping_sub(start);
+        if cost > 0 && cost < min_cost {
+            min_cost = cost;
+        }
+    }
+
+    min_cost
+}
+
+/// Counter frequency and null cost, measured once per process
+#[derive(Debug, Clone, Copy)]
+pub struct CycleClock {
+    /// Counter ticks per nanosecond
+    pub ticks_per_ns: f64,
+    /// Cost of one back-to-back read pair, in ticks
+    pub overhead: u64,
+}
+
+impl CycleClock {
+    /// Calibrate against the monotonic clock (takes ~50ms the first time)
+    pub fn get() -> CycleClock {
+        static CLOCK: OnceLock<CycleClock> = OnceLock::new();
+        *CLOCK.get_or_init(|| {
+            let overhead = calibrate_overhead();
+            // Median of several short windows rejects a preempted one
+            let mut rates: Vec<f64> = (0..5)
+                .map(|_| {
+                    let t0 = Instant::now();
+                    let c0 = cycles();
+                    while t0.elapsed() < Duration::from_millis(10) {
+                        std::hint::spin_loop();
+                    }
+                    let c1 = cycles();
+                    c1.wrapping_sub(c0) as f64 / t0.elapsed().as_nanos() as f64
+                })
+                .collect();
+            rates.sort_by(|a, b| a.partial_cmp(b).unwrap());
+            CycleClock {
+                ticks_per_ns: rates[rates.len() / 2].max(f64::MIN_POSITIVE),
+                overhead,
+            }
+        })
+    }
+
+    /// Nanoseconds spanned by `ticks`, minus the read overhead
+    #[inline]
+    pub fn to_ns(&self, ticks: u64) -> f64 {
+        ticks.saturating_sub(self.overhead) as f64 / self.ticks_per_ns
+    }
+}
+
+/// Time `f` with the cycle counter and return nanoseconds
+#[inline(always)]
+pub fn time_ns<F: FnOnce() -> R, R>(clock: &CycleClock, f: F) -> (f64, R) {
+    let start = cycles();
+    let out = f();
+    let end = cycles();
+    (clock.to_ns(end.wrapping_sub(start)), out)
+}
@@ -1,7 +1,9 @@
 use crate::communication::network::{parse_endpoint, Endpoint, NetworkBackend};
 use crate::core::node::NodeInfo;
 use crate::error::HorusResult;
-use crate::memory::shm_topic::ShmTopic;
+use crate::memory::shm_blob_pool::{BlobMessage, BlobSample, ShmBlobPool};
+use crate::memory::shm_topic::{BackpressurePolicy, ConsumerSample, ShmTopic, SubscriberLag};
+use crate::scheduling::metrics::{hub_latency, HubLatency};
 use std::sync::Arc;
 use std::time::Instant;
 
@@ -23,7 +25,8 @@ pub struct AtomicHubMetrics {
     pub messages_received: std::sync::atomic::AtomicU64,
     pub send_failures: std::sync::atomic::AtomicU64,
     pub recv_failures: std::sync::atomic::AtomicU64,
-    _padding: [u8; 32], // Pad to cache line boundary
+    pub messages_dropped: std::sync::atomic::AtomicU64,
+    _padding: [u8; 24], // Pad to cache line boundary
 }
 
 impl Default for AtomicHubMetrics {
@@ -33,7 +36,8 @@ impl Default for AtomicHubMetrics {
             messages_received: std::sync::atomic::AtomicU64::new(0),
             send_failures: std::sync::atomic::AtomicU64::new(0),
             recv_failures: std::sync::atomic::AtomicU64::new(0),
-            _padding: [0; 32],
+            messages_dropped: std::sync::atomic::AtomicU64::new(0),
+            _padding: [0; 24],
         }
     }
 }
@@ -54,6 +58,11 @@ impl AtomicHubMetrics {
             recv_failures: self
                 .recv_failures
                 .load(std::sync::atomic::Ordering::Relaxed),
+            messages_dropped: self
+                .messages_dropped
+                .load(std::sync::atomic::Ordering::Relaxed),
+            recv_dropped: 0,
+            subscribers: Vec::new(),
             last_activity: None, // Eliminated to remove Instant::now() overhead
         }
     }
@@ -66,6 +75,12 @@ pub struct HubMetrics {
     pub messages_received: u64,
     pub send_failures: u64,
     pub recv_failures: u64,
+    /// Sends rejected by the backpressure policy because the ring was full
+    pub messages_dropped: u64,
+    /// Messages this Hub missed as a subscriber because a producer lapped it
+    pub recv_dropped: u64,
+    /// Lag and drop counters of every registered subscriber on the topic
+    pub subscribers: Vec<SubscriberLag>,
     pub last_activity: Option<Instant>,
 }
 
@@ -78,6 +93,7 @@ pub struct Hub<T> {
     topic_name: String,
     state: std::sync::atomic::AtomicU8, // Lock-free state using atomic u8
     metrics: Arc<AtomicHubMetrics>,     // Lock-free atomic metrics
+    latency: Option<Arc<HubLatency>>,   // IPC latency histograms (opt-in)
     _padding: [u8; 14],                 // Pad to prevent false sharing
 }
 
@@ -96,6 +112,7 @@ where
                 self.state.load(std::sync::atomic::Ordering::Relaxed),
             ),
             metrics: self.metrics.clone(),
+            latency: self.latency.clone(),
             _padding: [0; 14],
         }
     }
@@ -242,13 +259,35 @@ impl<
     ///
     /// Note: Network endpoints require T: serde::Serialize + serde::de::DeserializeOwned
     pub fn new_with_capacity(topic_name: &str, capacity: usize) -> HorusResult<Self> {
+        Self::new_with_policy(topic_name, capacity, BackpressurePolicy::default())
+    }
+
+    /// Create a new Hub with custom capacity and overflow behaviour
+    ///
+    /// `policy` decides what `send` does when the slowest subscriber is a full
+    /// ring behind:
+    /// - `DropOldest` (default): overwrite; lapped subscribers skip ahead and
+    ///   count the loss in `HubMetrics::subscribers[..].dropped`
+    /// - `DropNewest`: `send` returns `Err(msg)` and unread data stays intact
+    /// - `Block { timeout }`: `send` waits for space, then returns `Err(msg)`
+    ///
+    /// Rejected sends are counted in `HubMetrics::messages_dropped`. Only
+    /// subscribers that have received at least once are tracked, so a Hub used
+    /// purely for publishing never holds back other producers.
+    ///
+    /// The policy applies to local shared memory; network endpoints ignore it.
+    pub fn new_with_policy(
+        topic_name: &str,
+        capacity: usize,
+        policy: BackpressurePolicy,
+    ) -> HorusResult<Self> {
         // Parse endpoint
         let endpoint = parse_endpoint(topic_name)?;
 
         match endpoint {
             Endpoint::Local { topic } => {
-                // Fast path: local shared memory only (existing code unchanged)
-                let shm_topic = Arc::new(ShmTopic::new(&topic, capacity)?);
+                // Fast path: local shared memory only
+                let shm_topic = Arc::new(ShmTopic::new_with_policy(&topic, capacity, policy)?);
 
                 Ok(Hub {
                     shm_topic,
@@ -257,6 +296,7 @@ impl<
                     topic_name: topic_name.to_string(),
                     state: std::sync::atomic::AtomicU8::new(ConnectionState::Connected.into_u8()),
                     metrics: Arc::new(AtomicHubMetrics::default()),
+                    latency: hub_latency(topic_name),
                     _padding: [0; 14],
                 })
             }
@@ -276,6 +316,7 @@ impl<
                     topic_name: topic_name.to_string(),
                     state: std::sync::atomic::AtomicU8::new(ConnectionState::Connected.into_u8()),
                     metrics: Arc::new(AtomicHubMetrics::default()),
+                    latency: hub_latency(topic_name),
                     _padding: [0; 14],
                 })
             }
@@ -300,6 +341,7 @@ impl<
             topic_name: topic_name.to_string(),
             state: std::sync::atomic::AtomicU8::new(ConnectionState::Connected.into_u8()),
             metrics: Arc::new(AtomicHubMetrics::default()),
+            latency: hub_latency(topic_name),
             _padding: [0; 14],
         })
     }
@@ -356,6 +398,7 @@ impl<
         }
 
         // Local shared memory path (OPTIMIZED - time only IPC)
+        let latency_start = self.latency.as_ref().map(|_| Instant::now());
         match self.shm_topic.loan() {
             Ok(mut sample) => {
                 // Fast path: when ctx is None (benchmarks), bypass logging completely
@@ -372,6 +415,7 @@ impl<
                     drop(sample);
                     let ipc_ns = ipc_start.elapsed().as_nanos() as u64;
                     // END TIMING - everything after this is logging overhead
+                    self.record_send_latency(latency_start);
 
                     // Post-IPC operations (not timed - happen after IPC completes)
                     self.metrics
@@ -388,6 +432,7 @@ impl<
                     // No logging: zero overhead path for benchmarks
                     sample.write(msg);
                     drop(sample);
+                    self.record_send_latency(latency_start);
 
                     self.metrics
                         .messages_sent
@@ -401,17 +446,94 @@ impl<
                 Ok(())
             }
             Err(_) => {
+                // Ring full under a DropNewest/Block policy
                 self.metrics
                     .send_failures
                     .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
-                self.state.store(
-                    ConnectionState::Failed.into_u8(),
-                    std::sync::atomic::Ordering::Relaxed,
-                );
+                self.metrics
+                    .messages_dropped
+                    .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
                 Err(msg)
             }
         }
     }
+    #[inline(always)]
+    fn record_send_latency(&self, start: Option<Instant>) {
+        if let (Some(latency), Some(start)) = (&self.latency, start) {
+            latency.send.record(start.elapsed());
+        }
+    }
+
+    /// Publish several messages with a single slot reservation
+    ///
+    /// A node publishing many messages per tick (e.g. 50 detections) reserves
+    /// all slots with one atomic and makes them visible together, instead of
+    /// paying one synchronization per message. Under `DropNewest`/`Block` the
+    /// batch is accepted or rejected as a whole; rejected messages are counted
+    /// in `messages_dropped`. Batches larger than the topic capacity are sent
+    /// in capacity-sized chunks.
+    ///
+    /// Network endpoints send the messages one by one.
+    pub fn send_batch(&self, msgs: &[T], ctx: &mut Option<&mut NodeInfo>) -> HorusResult<()>
+    where
+        T: crate::core::LogSummary,
+    {
+        if msgs.is_empty() {
+            return Ok(());
+        }
+
+        if self.is_network {
+            for msg in msgs {
+                self.send(msg.clone(), ctx).map_err(|_| {
+                    crate::error::HorusError::Communication(format!(
+                        "Failed to send batch on network topic '{}'",
+                        self.topic_name
+                    ))
+                })?;
+            }
+            return Ok(());
+        }
+
+        let ipc_start = Instant::now();
+        for chunk in msgs.chunks(self.shm_topic.capacity()) {
+            match self.shm_topic.loan_n(chunk.len()) {
+                Ok(mut batch) => {
+                    for msg in chunk {
+                        let _ = batch.write(msg.clone());
+                    }
+                    drop(batch);
+                    self.metrics
+                        .messages_sent
+                        .fetch_add(chunk.len() as u64, std::sync::atomic::Ordering::Relaxed);
+                }
+                Err(e) => {
+                    self.metrics
+                        .send_failures
+                        .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                    self.metrics
+                        .messages_dropped
+                        .fetch_add(chunk.len() as u64, std::sync::atomic::Ordering::Relaxed);
+                    return Err(e);
+                }
+            }
+        }
+        let ipc_ns = ipc_start.elapsed().as_nanos() as u64;
+
+        self.state.store(
+            ConnectionState::Connected.into_u8(),
+            std::sync::atomic::Ordering::Relaxed,
+        );
+        if let Some(ref mut ctx) = ctx {
+            ctx.register_publisher(&self.topic_name, std::any::type_name::<T>());
+            if let Some(last) = msgs.last() {
+                let summary = format!("{} (batch of {})", last.log_summary(), msgs.len());
+                ctx.log_pub_summary(&self.topic_name, &summary, ipc_ns);
+            }
+        }
+
+        Ok(())
+    }
+
     /// Receive a message from the topic
     ///
     /// Supports both local shared memory and network backends transparently
@@ -457,20 +579,27 @@ impl<
             Some(sample) => {
                 let ipc_ns = ipc_start.elapsed().as_nanos() as u64;
                 // END TIMING
+                if let Some(ref latency) = self.latency {
+                    latency.recv.record_ns(ipc_ns);
+                }
+
+                // Clone only once the slot is known to be intact (after timing)
+                let Some(msg) = sample.clone_valid() else {
+                    self.metrics
+                        .recv_failures
+                        .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                    return None;
+                };
 
                 // Fast path: when ctx is None, bypass logging completely (benchmarks + production)
                 if let Some(ref mut ctx) = ctx {
                     // Register as subscriber for discovery (only stores once per topic)
                     ctx.register_subscriber(&self.topic_name, std::any::type_name::<T>());
 
-                    // Logging enabled: get summary from zero-copy reference
-                    let summary = sample.get_ref().log_summary();
+                    let summary = msg.log_summary();
                     ctx.log_sub_summary(&self.topic_name, &summary, ipc_ns);
                 }
 
-                // Clone only when needed (after timing and logging)
-                let msg = sample.get_ref().clone();
-
                 // Lock-free atomic increment for success metrics
                 self.metrics
                     .messages_received
@@ -487,6 +616,194 @@ impl<
             }
         }
     }
+
+    /// Receive a message without cloning it out of shared memory
+    ///
+    /// Returns the zero-copy guard pointing at the slot in the ring buffer.
+    /// The slot is not locked, so check `sample.is_valid()` after reading to
+    /// make sure the producer did not overwrite it in the meantime.
+    ///
+    /// Network endpoints have no shared slot to borrow from and always return
+    /// `None`; use `recv` or `recv_with` for those.
+    #[inline(always)]
+    pub fn recv_ref(&self, ctx: &mut Option<&mut NodeInfo>) -> Option<ConsumerSample<'_, T>>
+    where
+        T: crate::core::LogSummary,
+    {
+        let sample = self.receive_in_place(ctx)?;
+        self.metrics
+            .messages_received
+            .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+        Some(sample)
+    }
+
+    /// Receive a message and run `f` on it in place, without cloning it
+    ///
+    /// Returns `None` if there was no message, or if the producer overwrote
+    /// the slot while `f` was running (the result is discarded and counted as
+    /// a receive failure). Network endpoints receive an owned message and pass
+    /// a reference to it.
+    ///
+    /// A producer that laps the subscriber writes while `f` reads, so `f` must
+    /// tolerate a torn value for types with heap pointers; keep the handler
+    /// short or size the topic capacity with enough headroom.
+    #[inline(always)]
+    pub fn recv_with<R, F>(&self, ctx: &mut Option<&mut NodeInfo>, f: F) -> Option<R>
+    where
+        T: crate::core::LogSummary,
+        F: FnOnce(&T) -> R,
+    {
+        if self.is_network {
+            return self.recv(ctx).map(|msg| f(&msg));
+        }
+
+        let sample = self.receive_in_place(ctx)?;
+        let result = f(sample.get_ref());
+        if sample.is_valid() {
+            self.metrics
+                .messages_received
+                .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+            Some(result)
+        } else {
+            self.metrics
+                .recv_failures
+                .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+            None
+        }
+    }
+
+    /// Next shared memory slot for reading in place, not yet counted as received
+    ///
+    /// With a logging context the summary is built from a validated clone,
+    /// never from the live slot, so `log_summary` can't see a torn value; a
+    /// slot overwritten before it could be cloned counts as a receive failure.
+    #[inline(always)]
+    fn receive_in_place(&self, ctx: &mut Option<&mut NodeInfo>) -> Option<ConsumerSample<'_, T>>
+    where
+        T: crate::core::LogSummary,
+    {
+        if self.is_network {
+            return None;
+        }
+
+        let ipc_start = Instant::now();
+        let Some(sample) = self.shm_topic.receive() else {
+            self.metrics
+                .recv_failures
+                .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+            return None;
+        };
+        let ipc_ns = ipc_start.elapsed().as_nanos() as u64;
+
+        if let Some(ref mut ctx) = ctx {
+            let Some(msg) = sample.clone_valid() else {
+                self.metrics
+                    .recv_failures
+                    .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                return None;
+            };
+            ctx.register_subscriber(&self.topic_name, std::any::type_name::<T>());
+            ctx.log_sub_summary(&self.topic_name, &msg.log_summary(), ipc_ns);
+        }
+        Some(sample)
+    }
+
+    /// Drain every pending message into `out`, returning how many were appended
+    ///
+    /// Intended for high-rate topics (IMU, encoders) where a node wants all
+    /// samples since its last tick. Discovery registration and metrics are
+    /// done once per call instead of once per message, and `out` is reused so
+    /// steady-state draining does not allocate. Messages overwritten while
+    /// being copied are dropped and counted as receive failures.
+    pub fn recv_all_into(&self, out: &mut Vec<T>, ctx: &mut Option<&mut NodeInfo>) -> usize
+    where
+        T: crate::core::LogSummary,
+    {
+        if self.is_network {
+            let start = out.len();
+            while let Some(msg) = self.recv(ctx) {
+                out.push(msg);
+            }
+            return out.len() - start;
+        }
+
+        let ipc_start = Instant::now();
+        let mut received = 0u64;
+        let mut overwritten = 0u64;
+        while let Some(sample) = self.shm_topic.receive() {
+            // Validated before cloning, so torn values never reach T::clone
+            match sample.clone_valid() {
+                Some(msg) => {
+                    out.push(msg);
+                    received += 1;
+                }
+                None => overwritten += 1,
+            }
+        }
+        let ipc_ns = ipc_start.elapsed().as_nanos() as u64;
+
+        if received > 0 {
+            if let Some(ref mut ctx) = ctx {
+                ctx.register_subscriber(&self.topic_name, std::any::type_name::<T>());
+                if let Some(last) = out.last() {
+                    let summary = format!("{} (batch of {})", last.log_summary(), received);
+                    ctx.log_sub_summary(&self.topic_name, &summary, ipc_ns);
+                }
+            }
+            self.metrics
+                .messages_received
+                .fetch_add(received, std::sync::atomic::Ordering::Relaxed);
+        }
+        if overwritten > 0 {
+            self.metrics
+                .recv_failures
+                .fetch_add(overwritten, std::sync::atomic::Ordering::Relaxed);
+        }
+
+        received as usize
+    }
+
+    /// Receive a handle message and resolve its payload from a blob pool
+    ///
+    /// Use with the fixed-layout handle messages (e.g. `ImageHandle`) whose
+    /// pixels or points live in a `ShmBlobPool`. The returned sample borrows
+    /// the payload straight from shared memory and keeps its slot alive until
+    /// dropped; nothing is copied or deserialized. Handles whose slot was
+    /// already recycled by the producer are skipped and counted as failures.
+    pub fn recv_blob(
+        &self,
+        pool: &Arc<ShmBlobPool>,
+        ctx: &mut Option<&mut NodeInfo>,
+    ) -> Option<BlobSample<T>>
+    where
+        T: crate::core::LogSummary + BlobMessage,
+    {
+        while let Some(msg) = self.recv(ctx) {
+            if let Some(view) = pool.view(&msg.blob_handle()) {
+                return Some(BlobSample::new(msg, view));
+            }
+            self.metrics
+                .recv_failures
+                .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+        }
+        None
+    }
+
+    /// Block until a message is waiting for this subscriber, or `timeout` expires
+    ///
+    /// Parks the calling thread on the topic's futex word instead of polling
+    /// `recv`, so event-triggered code wakes within microseconds of a publish
+    /// and idle subscribers use no CPU. Returns true if a message is pending.
+    ///
+    /// Network endpoints have no shared wakeup word and return true immediately,
+    /// so callers fall back to polling `recv`.
+    pub fn wait_for_data(&self, timeout: std::time::Duration) -> bool {
+        if self.is_network {
+            return true;
+        }
+        self.shm_topic.wait_for_data(timeout)
+    }
+
     /// Get current connection state (lock-free)
     pub fn get_connection_state(&self) -> ConnectionState {
         let state_u8 = self.state.load(std::sync::atomic::Ordering::Relaxed);
@@ -494,8 +811,21 @@ impl<
     }
 
     /// Get current metrics snapshot (lock-free)
+    ///
+    /// Includes per-subscriber lag read from the shared topic header, so a
+    /// stalled consumer shows up as steadily growing `lag`.
     pub fn get_metrics(&self) -> HubMetrics {
-        self.metrics.snapshot()
+        let mut metrics = self.metrics.snapshot();
+        if !self.is_network {
+            metrics.recv_dropped = self.shm_topic.dropped_count();
+            metrics.subscribers = self.shm_topic.subscriber_lag();
+        }
+        metrics
+    }
+
+    /// Backpressure policy this Hub applies when publishing
+    pub fn backpressure_policy(&self) -> BackpressurePolicy {
+        self.shm_topic.policy()
     }
 
     /// Get the topic name for this Hub
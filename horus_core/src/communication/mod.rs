@@ -34,8 +34,9 @@ pub mod network;
 pub mod traits;
 
 // Re-export commonly used types for convenience
+pub use crate::memory::shm_topic::{BackpressurePolicy, SubscriberLag};
 pub use config::{HorusConfig, HubConfig};
-pub use hub::Hub;
+pub use hub::{Hub, HubMetrics};
 pub use link::{ConnectionState, Link, LinkMetrics, LinkRole};
 pub use traits::{Channel, Publisher, Subscriber};
 
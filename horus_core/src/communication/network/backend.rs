@@ -9,6 +9,10 @@ use super::unix_socket::UnixSocketBackend;
 
 #[cfg(target_os = "linux")]
 use super::batch_udp::{BatchUdpConfig, BatchUdpReceiver, BatchUdpSender};
+#[cfg(target_os = "linux")]
+use super::fragmentation::{FragmentManager, FRAGMENT_HEADER_SIZE};
+#[cfg(target_os = "linux")]
+use super::recv_staging::{RecvStaging, RecvStagingStats};
 
 use crate::error::HorusResult;
 use std::net::SocketAddr;
@@ -45,12 +49,27 @@ pub enum NetworkBackend<T> {
     Router(RouterBackend<T>),
 }
 
+/// First byte of every batch UDP datagram: a whole message follows
+#[cfg(target_os = "linux")]
+const DATAGRAM_WHOLE: u8 = 0;
+/// First byte of every batch UDP datagram: a fragment header and chunk follow
+#[cfg(target_os = "linux")]
+const DATAGRAM_FRAGMENT: u8 = 1;
+
 /// Wrapper for batch UDP sender/receiver pair with smart copy support
+///
+/// The receiver runs on its own thread and stages datagrams into a lock-free
+/// queue (see `recv_staging`), so `recv` never makes a syscall or takes a lock.
+///
+/// Messages larger than the fragment MTU are split into fragments that
+/// borrow the serialized buffer and go out through `sendmmsg` with a
+/// header iovec and a payload iovec each, optionally with XOR parity.
 #[cfg(target_os = "linux")]
 pub struct BatchUdpBackendWrapper<T> {
     sender: std::sync::Mutex<BatchUdpSender>,
-    receiver: std::sync::Mutex<BatchUdpReceiver>,
+    receiver: RecvStaging,
     smart_copy: Arc<SmartCopySender>,
+    fragments: FragmentManager,
     topic: String,
     remote_addr: SocketAddr,
     _phantom: std::marker::PhantomData<T>,
@@ -69,10 +88,73 @@ impl<T> std::fmt::Debug for BatchUdpBackendWrapper<T> {
             .field("topic", &self.topic)
             .field("remote_addr", &self.remote_addr)
             .field("smart_copy", &self.smart_copy)
+            .field("receiver", &self.receiver)
             .finish()
     }
 }
 
+#[cfg(target_os = "linux")]
+impl<T> BatchUdpBackendWrapper<T>
+where
+    T: serde::de::DeserializeOwned,
+{
+    /// Send a serialized message too large for one datagram
+    ///
+    /// Only the tag byte and fragment header of each datagram are written
+    /// here; the payload iovecs point into `payload`.
+    fn send_fragmented(&self, payload: &[u8]) -> HorusResult<()> {
+        const FRAMED_HEADER: usize = 1 + FRAGMENT_HEADER_SIZE;
+
+        let mut parity = Vec::new();
+        let fragments = self.fragments.fragment(payload, &mut parity)?;
+
+        let mut headers = Vec::with_capacity(fragments.len() * FRAMED_HEADER);
+        for fragment in &fragments {
+            headers.push(DATAGRAM_FRAGMENT);
+            headers.extend_from_slice(&fragment.header.to_bytes());
+        }
+        let datagrams: Vec<[&[u8]; 2]> = headers
+            .chunks_exact(FRAMED_HEADER)
+            .zip(&fragments)
+            .map(|(header, fragment)| [header, fragment.data])
+            .collect();
+
+        let mut sender = self.sender.lock().map_err(|e| {
+            crate::error::HorusError::Communication(format!("Sender lock error: {}", e))
+        })?;
+        sender
+            .send_vectored(&datagrams, self.remote_addr)
+            .map_err(|e| {
+                crate::error::HorusError::Communication(format!(
+                    "Batch UDP fragment send error: {}",
+                    e
+                ))
+            })?;
+        Ok(())
+    }
+
+    /// Decode one staged datagram; `Ok(None)` while a message is incomplete
+    fn decode_datagram(&self, data: &[u8]) -> Result<Option<T>, String> {
+        match data.split_first() {
+            Some((&DATAGRAM_WHOLE, payload)) => bincode::deserialize(payload)
+                .map(Some)
+                .map_err(|e| e.to_string()),
+            Some((&DATAGRAM_FRAGMENT, bytes)) => {
+                let fragment = self.fragments.decode(bytes)?;
+                let Some(message) = self.fragments.reassemble(fragment) else {
+                    return Ok(None);
+                };
+                let result = bincode::deserialize(&message)
+                    .map(Some)
+                    .map_err(|e| e.to_string());
+                self.fragments.recycle(message);
+                result
+            }
+            _ => Err("unknown datagram tag".to_string()),
+        }
+    }
+}
+
 impl<T> NetworkBackend<T>
 where
     T: serde::Serialize
@@ -272,20 +354,25 @@ where
             "[::]:0".parse().unwrap()
         };
 
-        let receiver = BatchUdpReceiver::new(recv_addr, config).map_err(|e| {
-            crate::error::HorusError::Communication(format!(
-                "Failed to create batch UDP receiver: {}",
-                e
-            ))
-        })?;
+        let batch_size = config.batch_size;
+        let fragments = FragmentManager::default().with_fec(config.fec_group);
+        let receiver = BatchUdpReceiver::new(recv_addr, config)
+            .and_then(|receiver| RecvStaging::spawn(receiver, batch_size, topic))
+            .map_err(|e| {
+                crate::error::HorusError::Communication(format!(
+                    "Failed to create batch UDP receiver: {}",
+                    e
+                ))
+            })?;
 
         // Create smart copy sender for automatic zero-copy on large messages
         let smart_copy = Arc::new(SmartCopySender::new(SmartCopyConfig::default()));
 
         Ok(NetworkBackend::BatchUdp(BatchUdpBackendWrapper {
             sender: std::sync::Mutex::new(sender),
-            receiver: std::sync::Mutex::new(receiver),
+            receiver,
             smart_copy,
+            fragments,
             topic: topic.to_string(),
             remote_addr: addr,
             _phantom: std::marker::PhantomData,
@@ -300,10 +387,16 @@ where
             NetworkBackend::UdpDirect(backend) => backend.send(msg),
             #[cfg(target_os = "linux")]
             NetworkBackend::BatchUdp(backend) => {
-                let data = bincode::serialize(msg).map_err(|e| {
+                let mut data = Vec::with_capacity(256);
+                data.push(DATAGRAM_WHOLE);
+                bincode::serialize_into(&mut data, msg).map_err(|e| {
                     crate::error::HorusError::Communication(format!("Serialization error: {}", e))
                 })?;
 
+                if data.len() - 1 > backend.fragments.mtu() {
+                    return backend.send_fragmented(&data[1..]);
+                }
+
                 // Use smart copy - automatically selects zero-copy for large messages
                 let (strategy, buffer) = backend.smart_copy.prepare_send(&data);
 
@@ -347,19 +440,17 @@ where
             NetworkBackend::UdpDirect(backend) => backend.recv(),
             #[cfg(target_os = "linux")]
             NetworkBackend::BatchUdp(backend) => {
-                let mut receiver = match backend.receiver.lock() {
-                    Ok(r) => r,
-                    Err(_) => return None,
-                };
-                match receiver.recv_batch(1) {
-                    Ok(packets) => {
-                        if let Some(packet) = packets.into_iter().next() {
-                            bincode::deserialize(&packet.data).ok()
-                        } else {
-                            None
-                        }
+                // Decode straight out of the pooled datagram; fragments are
+                // placed into their message buffer; skip undecodable ones
+                loop {
+                    match backend
+                        .receiver
+                        .pop_with(|data| backend.decode_datagram(data))?
+                    {
+                        Ok(Some(msg)) => return Some(msg),
+                        Ok(None) => {}
+                        Err(e) => log::debug!("BatchUdp dropped undecodable datagram: {}", e),
                     }
-                    Err(_) => None,
                 }
             }
             NetworkBackend::Multicast(backend) => backend.recv(),
@@ -391,6 +482,17 @@ where
         }
     }
 
+    /// Get receive staging queue statistics (BatchUdp only)
+    ///
+    /// Returns None for non-BatchUdp backends
+    #[cfg(target_os = "linux")]
+    pub fn recv_staging_stats(&self) -> Option<RecvStagingStats> {
+        match self {
+            NetworkBackend::BatchUdp(backend) => Some(backend.receiver.stats()),
+            _ => None,
+        }
+    }
+
     /// Get copy strategy that would be used for a message of given size
     #[cfg(target_os = "linux")]
     pub fn copy_strategy_for_size(&self, size: usize) -> Option<CopyStrategy> {
@@ -30,6 +30,8 @@ const DEFAULT_SOCKET_BUFFER: usize = 4 * 1024 * 1024;
 const DEFAULT_FLUSH_INTERVAL: Duration = Duration::from_micros(100);
 /// Maximum packet size
 const MAX_PACKET_SIZE: usize = 65535;
+/// How long a gather send waits for socket buffer space before giving up
+const SEND_BLOCK_TIMEOUT: Duration = Duration::from_millis(50);
 
 /// Configuration for batch UDP operations
 #[derive(Debug, Clone)]
@@ -48,6 +50,9 @@ pub struct BatchUdpConfig {
     pub reuse_port: bool,
     /// Number of receiver threads (requires reuse_port)
     pub num_receivers: usize,
+    /// Data fragments per XOR parity fragment for messages larger than one
+    /// datagram (0 disables FEC); see `fragmentation::FragmentManager::with_fec`
+    pub fec_group: u8,
 }
 
 impl Default for BatchUdpConfig {
@@ -60,6 +65,7 @@ impl Default for BatchUdpConfig {
             busy_poll_us: Some(50), // 50µs busy poll
             reuse_port: false,
             num_receivers: 1,
+            fec_group: 0,
         }
     }
 }
@@ -75,6 +81,7 @@ impl BatchUdpConfig {
             busy_poll_us: Some(100),
             reuse_port: true,
             num_receivers: num_cpus::get().min(8),
+            fec_group: 0,
         }
     }
 
@@ -88,6 +95,7 @@ impl BatchUdpConfig {
             busy_poll_us: Some(25),
             reuse_port: false,
             num_receivers: 1,
+            fec_group: 0,
         }
     }
 }
@@ -145,6 +153,11 @@ pub struct BatchUdpSender {
     msg_headers: Vec<libc::mmsghdr>,
     #[cfg(target_os = "linux")]
     addrs: Vec<libc::sockaddr_storage>,
+    // Several iovecs per message for `send_vectored`
+    #[cfg(target_os = "linux")]
+    gather_iov: Vec<libc::iovec>,
+    #[cfg(not(target_os = "linux"))]
+    gather_buf: Vec<u8>,
 }
 
 impl BatchUdpSender {
@@ -172,6 +185,10 @@ impl BatchUdpSender {
             msg_headers: vec![unsafe { std::mem::zeroed() }; batch_size],
             #[cfg(target_os = "linux")]
             addrs: vec![unsafe { std::mem::zeroed() }; batch_size],
+            #[cfg(target_os = "linux")]
+            gather_iov: Vec::new(),
+            #[cfg(not(target_os = "linux"))]
+            gather_buf: Vec::new(),
             config,
         })
     }
@@ -210,6 +227,161 @@ impl BatchUdpSender {
         Ok(n)
     }
 
+    /// Send datagrams gathered from several slices each, without copying them
+    ///
+    /// Each datagram is the concatenation of its `N` parts, handed to the
+    /// kernel as `N` iovecs (e.g. a fragment header plus the slice of the
+    /// message it carries). Queued packets are flushed first to keep
+    /// ordering. If the socket buffer is full, waits up to
+    /// `SEND_BLOCK_TIMEOUT` for space before failing with `WouldBlock`.
+    pub fn send_vectored<const N: usize>(
+        &mut self,
+        datagrams: &[[&[u8]; N]],
+        addr: SocketAddr,
+    ) -> io::Result<usize> {
+        self.flush()?;
+
+        #[cfg(target_os = "linux")]
+        let sent = self.send_vectored_mmsg(datagrams, addr)?;
+
+        #[cfg(not(target_os = "linux"))]
+        let sent = self.send_vectored_fallback(datagrams, addr)?;
+
+        Ok(sent)
+    }
+
+    #[cfg(target_os = "linux")]
+    fn send_vectored_mmsg<const N: usize>(
+        &mut self,
+        datagrams: &[[&[u8]; N]],
+        addr: SocketAddr,
+    ) -> io::Result<usize> {
+        let batch_size = self.msg_headers.len();
+        self.gather_iov.resize(
+            batch_size * N,
+            libc::iovec {
+                iov_base: std::ptr::null_mut(),
+                iov_len: 0,
+            },
+        );
+        let (addr_ptr, addr_len) = socket_addr_to_raw(&addr, &mut self.addrs[0]);
+        let fd = self.socket.as_raw_fd();
+
+        for batch in datagrams.chunks(batch_size) {
+            for (i, parts) in batch.iter().enumerate() {
+                for (j, part) in parts.iter().enumerate() {
+                    self.gather_iov[i * N + j] = libc::iovec {
+                        iov_base: part.as_ptr() as *mut _,
+                        iov_len: part.len(),
+                    };
+                }
+                self.msg_headers[i].msg_hdr = libc::msghdr {
+                    msg_name: addr_ptr as *mut _,
+                    msg_namelen: addr_len,
+                    msg_iov: unsafe { self.gather_iov.as_mut_ptr().add(i * N) },
+                    msg_iovlen: N as _,
+                    msg_control: std::ptr::null_mut(),
+                    msg_controllen: 0,
+                    msg_flags: 0,
+                };
+                self.msg_headers[i].msg_len = 0;
+            }
+
+            // The kernel may accept part of a batch; resume where it stopped
+            let mut done = 0;
+            while done < batch.len() {
+                let sent = unsafe {
+                    libc::sendmmsg(
+                        fd,
+                        self.msg_headers.as_mut_ptr().add(done),
+                        (batch.len() - done) as u32,
+                        0,
+                    )
+                };
+                if sent < 0 {
+                    let err = io::Error::last_os_error();
+                    match err.kind() {
+                        io::ErrorKind::Interrupted => continue,
+                        io::ErrorKind::WouldBlock if self.wait_writable(SEND_BLOCK_TIMEOUT)? => {
+                            continue
+                        }
+                        _ => {
+                            self.stats.send_errors.fetch_add(1, Ordering::Relaxed);
+                            return Err(err);
+                        }
+                    }
+                }
+                let sent = sent as usize;
+                let bytes: u64 = self.msg_headers[done..done + sent]
+                    .iter()
+                    .map(|m| m.msg_len as u64)
+                    .sum();
+                self.stats
+                    .packets_sent
+                    .fetch_add(sent as u64, Ordering::Relaxed);
+                self.stats.bytes_sent.fetch_add(bytes, Ordering::Relaxed);
+                self.stats.batches_sent.fetch_add(1, Ordering::Relaxed);
+                done += sent;
+            }
+        }
+
+        Ok(datagrams.len())
+    }
+
+    /// Fallback for non-Linux systems: assemble each datagram, then send it
+    #[cfg(not(target_os = "linux"))]
+    fn send_vectored_fallback<const N: usize>(
+        &mut self,
+        datagrams: &[[&[u8]; N]],
+        addr: SocketAddr,
+    ) -> io::Result<usize> {
+        for parts in datagrams {
+            self.gather_buf.clear();
+            for part in parts {
+                self.gather_buf.extend_from_slice(part);
+            }
+            let n = loop {
+                match self.socket.send_to(&self.gather_buf, addr) {
+                    Ok(n) => break n,
+                    Err(e) if e.kind() == io::ErrorKind::WouldBlock => {
+                        if !self.wait_writable(SEND_BLOCK_TIMEOUT)? {
+                            return Err(e);
+                        }
+                    }
+                    Err(e) => {
+                        self.stats.send_errors.fetch_add(1, Ordering::Relaxed);
+                        return Err(e);
+                    }
+                }
+            };
+            self.stats.packets_sent.fetch_add(1, Ordering::Relaxed);
+            self.stats.bytes_sent.fetch_add(n as u64, Ordering::Relaxed);
+        }
+        if !datagrams.is_empty() {
+            self.stats.batches_sent.fetch_add(1, Ordering::Relaxed);
+        }
+        Ok(datagrams.len())
+    }
+
+    /// Block until the socket has send buffer space or `timeout` expires
+    fn wait_writable(&self, timeout: Duration) -> io::Result<bool> {
+        let mut pfd = libc::pollfd {
+            fd: self.socket.as_raw_fd(),
+            events: libc::POLLOUT,
+            revents: 0,
+        };
+        let timeout_ms = timeout.as_millis().min(i32::MAX as u128) as libc::c_int;
+        let ready = unsafe { libc::poll(&mut pfd, 1, timeout_ms) };
+        if ready < 0 {
+            let err = io::Error::last_os_error();
+            if err.kind() == io::ErrorKind::Interrupted {
+                return Ok(true);
+            }
+            return Err(err);
+        }
+        Ok(ready > 0 && (pfd.revents & libc::POLLOUT) != 0)
+    }
+
     /// Flush all pending packets using sendmmsg (Linux) or fallback
     pub fn flush(&mut self) -> io::Result<usize> {
         if self.pending.is_empty() {
@@ -358,6 +530,12 @@ pub struct BatchUdpReceiver {
     addrs: Vec<libc::sockaddr_storage>,
 }
 
+// Safety: the raw pointers in the iovec/mmsghdr scratch arrays only ever point
+// into `recv_buffers` and `addrs`, which are heap buffers owned by the receiver
+// (stable across moves), and are rewritten before every recvmmsg call.
+#[cfg(target_os = "linux")]
+unsafe impl Send for BatchUdpReceiver {}
+
 /// Received packet with source address
 #[derive(Debug, Clone)]
 pub struct ReceivedPacket {
@@ -403,18 +581,67 @@ impl BatchUdpReceiver {
 
     /// Receive multiple packets in a single syscall (Linux) or fallback
     pub fn recv_batch(&mut self, max_packets: usize) -> io::Result<Vec<ReceivedPacket>> {
+        let mut packets = Vec::new();
+        self.recv_batch_with(max_packets, |data, addr| {
+            packets.push(ReceivedPacket {
+                data: data.to_vec(),
+                addr,
+            })
+        })?;
+        Ok(packets)
+    }
+
+    /// Receive multiple packets and hand each one to `f` without allocating
+    ///
+    /// `f` borrows the receiver's pre-allocated buffer, which is reused by the
+    /// next call, so copy out anything that must outlive it. Returns the
+    /// number of packets received (0 if none were waiting).
+    pub fn recv_batch_with<F>(&mut self, max_packets: usize, f: F) -> io::Result<usize>
+    where
+        F: FnMut(&[u8], SocketAddr),
+    {
         let max = max_packets.min(self.config.batch_size);
 
         #[cfg(target_os = "linux")]
-        return self.recv_batch_mmsg(max);
+        return self.recv_batch_mmsg(max, f);
 
         #[cfg(not(target_os = "linux"))]
-        return self.recv_batch_fallback(max);
+        return self.recv_batch_fallback(max, f);
+    }
+
+    /// Block until a packet is waiting or `timeout` expires
+    ///
+    /// The socket itself stays non-blocking; this lets a dedicated receive
+    /// thread sleep in the kernel instead of spinning on `recv_batch`.
+    pub fn wait_readable(&self, timeout: Duration) -> io::Result<bool> {
+        let mut pfd = libc::pollfd {
+            fd: self.socket.as_raw_fd(),
+            events: libc::POLLIN,
+            revents: 0,
+        };
+        let timeout_ms = timeout.as_millis().min(i32::MAX as u128) as libc::c_int;
+        let ready = unsafe { libc::poll(&mut pfd, 1, timeout_ms) };
+        if ready < 0 {
+            let err = io::Error::last_os_error();
+            if err.kind() == io::ErrorKind::Interrupted {
+                return Ok(false);
+            }
+            return Err(err);
+        }
+        Ok(ready > 0 && (pfd.revents & libc::POLLIN) != 0)
+    }
+
+    /// Local address the receiver is bound to
+    pub fn local_addr(&self) -> io::Result<SocketAddr> {
+        self.socket.local_addr()
     }
 
     /// Linux-specific recvmmsg implementation
     #[cfg(target_os = "linux")]
-    fn recv_batch_mmsg(&mut self, max_packets: usize) -> io::Result<Vec<ReceivedPacket>> {
+    fn recv_batch_mmsg<F>(&mut self, max_packets: usize, mut f: F) -> io::Result<usize>
+    where
+        F: FnMut(&[u8], SocketAddr),
+    {
         // Set up iovec and message headers
         for i in 0..max_packets {
             self.iov_buffers[i] = libc::iovec {
@@ -454,7 +681,7 @@ impl BatchUdpReceiver {
         if received < 0 {
             let err = io::Error::last_os_error();
             if err.kind() == io::ErrorKind::WouldBlock {
-                return Ok(Vec::new());
+                return Ok(0);
             }
             self.stats.recv_errors.fetch_add(1, Ordering::Relaxed);
             return Err(err);
@@ -462,11 +689,10 @@ impl BatchUdpReceiver {
 
         let received = received as usize;
         if received == 0 {
-            return Ok(Vec::new());
+            return Ok(0);
         }
 
-        // Extract received packets
-        let mut packets = Vec::with_capacity(received);
+        // Hand out received packets straight from the pre-allocated buffers
         let mut bytes_received = 0u64;
 
         for i in 0..received {
@@ -474,11 +700,7 @@ impl BatchUdpReceiver {
             bytes_received += len as u64;
 
             let addr = raw_to_socket_addr(&self.addrs[i]);
-
-            packets.push(ReceivedPacket {
-                data: self.recv_buffers[i][..len].to_vec(),
-                addr,
-            });
+            f(&self.recv_buffers[i][..len], addr);
         }
 
         self.stats
@@ -489,13 +711,16 @@ impl BatchUdpReceiver {
             .fetch_add(bytes_received, Ordering::Relaxed);
         self.stats.batches_received.fetch_add(1, Ordering::Relaxed);
 
-        Ok(packets)
+        Ok(received)
     }
 
     /// Fallback for non-Linux systems
     #[cfg(not(target_os = "linux"))]
-    fn recv_batch_fallback(&mut self, max_packets: usize) -> io::Result<Vec<ReceivedPacket>> {
-        let mut packets = Vec::with_capacity(max_packets);
+    fn recv_batch_fallback<F>(&mut self, max_packets: usize, mut f: F) -> io::Result<usize>
+    where
+        F: FnMut(&[u8], SocketAddr),
+    {
+        let mut received = 0usize;
         let mut buf = vec![0u8; MAX_PACKET_SIZE];
 
         for _ in 0..max_packets {
@@ -506,15 +731,13 @@ impl BatchUdpReceiver {
                         .bytes_received
                         .fetch_add(len as u64, Ordering::Relaxed);
 
-                    packets.push(ReceivedPacket {
-                        data: buf[..len].to_vec(),
-                        addr,
-                    });
+                    f(&buf[..len], addr);
+                    received += 1;
                 }
                 Err(e) if e.kind() == io::ErrorKind::WouldBlock => break,
                 Err(e) => {
                     self.stats.recv_errors.fetch_add(1, Ordering::Relaxed);
-                    if packets.is_empty() {
+                    if received == 0 {
                         return Err(e);
                     }
                     break;
@@ -522,11 +745,11 @@ impl BatchUdpReceiver {
             }
         }
 
-        if !packets.is_empty() {
+        if received > 0 {
             self.stats.batches_received.fetch_add(1, Ordering::Relaxed);
         }
 
-        Ok(packets)
+        Ok(received)
     }
 
     /// Receive a single packet (convenience method)
@@ -936,6 +1159,44 @@ mod tests {
         assert_eq!(sender.pending_count(), 0);
     }
 
+    #[test]
+    fn test_send_vectored_gathers_parts() {
+        let send_addr = SocketAddr::V4(SocketAddrV4::new(Ipv4Addr::LOCALHOST, 0));
+        let recv_addr = SocketAddr::V4(SocketAddrV4::new(Ipv4Addr::LOCALHOST, 0));
+        let config = BatchUdpConfig {
+            batch_size: 8,
+            ..BatchUdpConfig::default()
+        };
+
+        let mut receiver = BatchUdpReceiver::new(recv_addr, config.clone()).unwrap();
+        let target = receiver.local_addr().unwrap();
+        let mut sender = BatchUdpSender::new(send_addr, config).unwrap();
+
+        // 20 datagrams over 3 sendmmsg batches, each a header plus a payload slice
+        let payload: Vec<u8> = (0..2000).map(|i| i as u8).collect();
+        let headers: Vec<[u8; 2]> = (0..20u16).map(|i| i.to_le_bytes()).collect();
+        let datagrams: Vec<[&[u8]; 2]> = headers
+            .iter()
+            .zip(payload.chunks(100))
+            .map(|(h, chunk)| [&h[..], chunk])
+            .collect();
+        assert_eq!(sender.send_vectored(&datagrams, target).unwrap(), 20);
+        assert_eq!(sender.stats().packets_sent.load(Ordering::Relaxed), 20);
+
+        let mut received = Vec::new();
+        let deadline = Instant::now() + Duration::from_secs(2);
+        while received.len() < 20 && Instant::now() < deadline {
+            receiver
+                .recv_batch_with(32, |data, _| received.push(data.to_vec()))
+                .unwrap();
+        }
+        assert_eq!(received.len(), 20);
+        for (i, datagram) in received.iter().enumerate() {
+            assert_eq!(u16::from_le_bytes([datagram[0], datagram[1]]), i as u16);
+            assert_eq!(&datagram[2..], &payload[i * 100..(i + 1) * 100]);
+        }
+    }
+
     #[test]
     fn test_stats() {
         let stats = BatchUdpStats::default();
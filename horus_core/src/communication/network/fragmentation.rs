@@ -1,116 +1,534 @@
 /// Message fragmentation for large payloads
 ///
-/// Automatically splits messages larger than MTU into fragments and reassembles them
+/// Automatically splits messages larger than MTU into fragments and reassembles them.
+///
+/// Fragments borrow their bytes from the source buffer; only a fixed 20-byte
+/// header is written per fragment, so a sender can hand the kernel the header
+/// and the payload slice as separate iovecs. On the receive side each
+/// fragment is copied exactly once, straight to its offset in a pooled
+/// message buffer. In-flight messages are spread over independently locked
+/// shards, so concurrent receive threads rarely touch the same lock.
+///
+/// Optional forward error correction adds one XOR parity fragment per group
+/// of `fec_group` data fragments, which rebuilds any single lost fragment of
+/// the group without a retransmission.
+use crate::communication::network::protocol::{HorusPacket, MessageType};
+use crate::error::HorusResult;
 use std::collections::HashMap;
+use std::ops::Range;
 use std::sync::atomic::{AtomicU64, Ordering};
-use std::sync::{Arc, Mutex};
+use std::sync::Mutex;
 use std::time::{Duration, Instant};
 
 const DEFAULT_MTU: usize = 1400; // Conservative MTU (1500 - headers)
 const FRAGMENT_TIMEOUT: Duration = Duration::from_secs(5);
+/// Independently locked reassembly tables
+const SHARDS: usize = 8;
+/// Incomplete messages per shard before the oldest is evicted
+const MAX_PENDING_PER_SHARD: usize = 32;
+/// Recently completed message ids remembered per shard (late parity)
+const COMPLETED_HISTORY: usize = 16;
+/// Reassembly buffers kept for reuse
+const BUFFER_POOL_SIZE: usize = 8;
+/// Larger reassembly buffers are freed rather than pooled
+const MAX_POOLED_BUFFER: usize = 4 * 1024 * 1024;
+
+/// Largest message accepted for reassembly unless configured otherwise
+///
+/// A fragment header alone decides how much memory reassembly reserves, so
+/// anything above the limit is rejected before that happens.
+pub const DEFAULT_MAX_MESSAGE_SIZE: usize = 16 * 1024 * 1024;
 
-/// A single fragment of a larger message
-#[derive(Debug, Clone, serde::Serialize, serde::Deserialize)]
-pub struct Fragment {
+/// Encoded size of a `FragmentHeader`
+pub const FRAGMENT_HEADER_SIZE: usize = 20;
+
+const KIND_DATA: u8 = 0;
+const KIND_PARITY: u8 = 1;
+
+/// Fixed little-endian header in front of every fragment
+///
+/// ```text
+/// fragment_id u64 | message_len u32 | index u16 | total u16 | chunk_size u16 | fec_group u8 | kind u8
+/// ```
+///
+/// Data fragment `index` holds bytes `index * chunk_size ..` of the message.
+/// Parity fragment `index` is the XOR of data fragments
+/// `index * fec_group .. (index + 1) * fec_group`, zero-padded to the longest.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct FragmentHeader {
     pub fragment_id: u64, // Unique ID for this fragmented message
-    pub index: u16,       // Fragment index (0-based)
-    pub total: u16,       // Total number of fragments
-    pub data: Vec<u8>,    // Fragment payload
+    pub message_len: u32, // Length of the reassembled message
+    pub index: u16,       // Data fragment index, or parity group index
+    pub total: u16,       // Total number of data fragments
+    pub chunk_size: u16,  // Payload bytes per data fragment (last may be shorter)
+    pub fec_group: u8,    // Data fragments per parity fragment, 0 = no FEC
+    pub parity: bool,     // Parity fragment rather than data
 }
 
-impl Fragment {
-    pub fn encode(&self) -> Vec<u8> {
-        bincode::serialize(self).unwrap()
+impl FragmentHeader {
+    pub fn to_bytes(&self) -> [u8; FRAGMENT_HEADER_SIZE] {
+        let mut out = [0u8; FRAGMENT_HEADER_SIZE];
+        out[0..8].copy_from_slice(&self.fragment_id.to_le_bytes());
+        out[8..12].copy_from_slice(&self.message_len.to_le_bytes());
+        out[12..14].copy_from_slice(&self.index.to_le_bytes());
+        out[14..16].copy_from_slice(&self.total.to_le_bytes());
+        out[16..18].copy_from_slice(&self.chunk_size.to_le_bytes());
+        out[18] = self.fec_group;
+        out[19] = if self.parity { KIND_PARITY } else { KIND_DATA };
+        out
+    }
+
+    pub fn from_bytes(buf: &[u8]) -> Result<Self, &'static str> {
+        if buf.len() < FRAGMENT_HEADER_SIZE {
+            return Err("Buffer too small for fragment header");
+        }
+        let u16_at = |i: usize| u16::from_le_bytes([buf[i], buf[i + 1]]);
+        let parity = match buf[19] {
+            KIND_DATA => false,
+            KIND_PARITY => true,
+            _ => return Err("Unknown fragment kind"),
+        };
+        Ok(FragmentHeader {
+            fragment_id: u64::from_le_bytes(buf[0..8].try_into().unwrap()),
+            message_len: u32::from_le_bytes(buf[8..12].try_into().unwrap()),
+            index: u16_at(12),
+            total: u16_at(14),
+            chunk_size: u16_at(16),
+            fec_group: buf[18],
+            parity,
+        })
+    }
+
+    /// Byte range of data fragment `index` within the message
+    #[inline]
+    fn chunk_range(&self, index: usize) -> Range<usize> {
+        let chunk = self.chunk_size as usize;
+        let start = (index * chunk).min(self.message_len as usize);
+        start..(start + chunk).min(self.message_len as usize)
+    }
+
+    /// Number of parity groups (0 without FEC)
+    #[inline]
+    fn group_count(&self) -> usize {
+        match self.fec_group {
+            0 => 0,
+            k => (self.total as usize).div_ceil(k as usize),
+        }
+    }
+
+    /// Data fragment indices covered by parity group `group`
+    #[inline]
+    fn group_range(&self, group: usize) -> Range<usize> {
+        let k = self.fec_group as usize;
+        group * k..((group + 1) * k).min(self.total as usize)
     }
 
-    pub fn decode(data: &[u8]) -> Result<Self, Box<bincode::ErrorKind>> {
-        bincode::deserialize(data)
+    /// Length of a parity fragment: the longest data fragment of its group
+    #[inline]
+    fn parity_len(&self, group: usize) -> usize {
+        self.chunk_range(group * self.fec_group as usize).len()
+    }
+
+    /// Whether `other` describes the same message layout
+    #[inline]
+    fn same_message(&self, other: &FragmentHeader) -> bool {
+        self.message_len == other.message_len
+            && self.total == other.total
+            && self.chunk_size == other.chunk_size
+            && self.fec_group == other.fec_group
+    }
+}
+
+/// A single fragment of a larger message, borrowing its bytes
+#[derive(Debug, Clone, Copy)]
+pub struct Fragment<'a> {
+    pub header: FragmentHeader,
+    pub data: &'a [u8], // Fragment payload
+}
+
+impl<'a> Fragment<'a> {
+    /// Append header and payload to `buf`
+    pub fn encode(&self, buf: &mut Vec<u8>) {
+        buf.extend_from_slice(&self.header.to_bytes());
+        buf.extend_from_slice(self.data);
+    }
+
+    /// Parse and validate a fragment, borrowing its payload from `buf`
+    ///
+    /// Messages over [`DEFAULT_MAX_MESSAGE_SIZE`] are rejected; use
+    /// [`Fragment::decode_with_limit`] or [`FragmentManager::decode`] for
+    /// another limit.
+    pub fn decode(buf: &'a [u8]) -> Result<Self, &'static str> {
+        Self::decode_with_limit(buf, DEFAULT_MAX_MESSAGE_SIZE)
+    }
+
+    /// Like [`Fragment::decode`], rejecting messages over `max_message_size`
+    pub fn decode_with_limit(buf: &'a [u8], max_message_size: usize) -> Result<Self, &'static str> {
+        let header = FragmentHeader::from_bytes(buf)?;
+        let data = &buf[FRAGMENT_HEADER_SIZE..];
+
+        let total = header.total as usize;
+        let chunk = header.chunk_size as usize;
+        let len = header.message_len as usize;
+        if len > max_message_size {
+            return Err("Fragmented message exceeds maximum message size");
+        }
+        if total == 0
+            || chunk == 0
+            || len > total * chunk
+            || (len > 0 && len + chunk <= total * chunk)
+        {
+            return Err("Inconsistent fragment layout");
+        }
+        let expected = if header.parity {
+            if header.fec_group == 0 || header.index as usize >= header.group_count() {
+                return Err("Parity fragment out of range");
+            }
+            header.parity_len(header.index as usize)
+        } else {
+            if header.index >= header.total {
+                return Err("Fragment index out of range");
+            }
+            header.chunk_range(header.index as usize).len()
+        };
+        if data.len() != expected {
+            return Err("Fragment length does not match header");
+        }
+
+        Ok(Fragment { header, data })
+    }
+}
+
+/// XOR `src` into `dst` (same length)
+#[inline]
+fn xor_into(dst: &mut [u8], src: &[u8]) {
+    // Simple enough for the compiler to vectorize
+    for (d, s) in dst.iter_mut().zip(src) {
+        *d ^= *s;
     }
 }
 
 /// Manages fragmentation and reassembly
 pub struct FragmentManager {
     mtu: usize,
+    fec_group: u8,
+    max_message_size: usize,
     next_fragment_id: AtomicU64,
-    pending_fragments: Arc<Mutex<HashMap<u64, FragmentedMessage>>>,
+    shards: [Mutex<Shard>; SHARDS],
+    buffer_pool: Mutex<Vec<Vec<u8>>>,
+    recovered: AtomicU64,
 }
 
 impl FragmentManager {
     pub fn new(mtu: Option<usize>) -> Self {
+        // Random-ish starting id so senders sharing a receiver don't collide
+        let seed = std::time::SystemTime::now()
+            .duration_since(std::time::UNIX_EPOCH)
+            .map(|d| d.as_nanos() as u64)
+            .unwrap_or(0)
+            ^ ((std::process::id() as u64) << 40);
         Self {
-            mtu: mtu.unwrap_or(DEFAULT_MTU),
-            next_fragment_id: AtomicU64::new(0),
-            pending_fragments: Arc::new(Mutex::new(HashMap::new())),
-        }
-    }
-
-    /// Split data into fragments if needed
-    pub fn fragment(&self, data: &[u8]) -> Vec<Fragment> {
-        if data.len() <= self.mtu {
-            // No fragmentation needed, return single fragment
-            return vec![Fragment {
-                fragment_id: self.next_fragment_id.fetch_add(1, Ordering::Relaxed),
-                index: 0,
-                total: 1,
-                data: data.to_vec(),
-            }];
-        }
-
-        // Need fragmentation
-        let fragment_id = self.next_fragment_id.fetch_add(1, Ordering::Relaxed);
-        let chunks: Vec<&[u8]> = data.chunks(self.mtu).collect();
-        let total = chunks.len() as u16;
-
-        chunks
-            .into_iter()
-            .enumerate()
-            .map(|(i, chunk)| Fragment {
-                fragment_id,
-                index: i as u16,
-                total,
-                data: chunk.to_vec(),
-            })
-            .collect()
+            mtu: mtu.unwrap_or(DEFAULT_MTU).clamp(1, u16::MAX as usize),
+            fec_group: 0,
+            max_message_size: DEFAULT_MAX_MESSAGE_SIZE,
+            next_fragment_id: AtomicU64::new(seed),
+            shards: std::array::from_fn(|_| Mutex::new(Shard::default())),
+            buffer_pool: Mutex::new(Vec::with_capacity(BUFFER_POOL_SIZE)),
+            recovered: AtomicU64::new(0),
+        }
+    }
+
+    /// Send one XOR parity fragment per `group` data fragments (0 disables)
+    ///
+    /// Costs `1 / group` extra bandwidth on fragmented messages and recovers
+    /// one lost fragment per group. Receivers need no configuration.
+    pub fn with_fec(mut self, group: u8) -> Self {
+        self.fec_group = group;
+        self
+    }
+
+    /// Refuse to reassemble messages larger than `bytes`
+    ///
+    /// Defaults to [`DEFAULT_MAX_MESSAGE_SIZE`]. Fragments announcing a
+    /// larger message fail [`FragmentManager::decode`] and are dropped by
+    /// `reassemble` before any buffer is reserved for them.
+    pub fn with_max_message_size(mut self, bytes: usize) -> Self {
+        self.max_message_size = bytes;
+        self
+    }
+
+    /// Parse and validate a fragment against this manager's size limit
+    pub fn decode<'a>(&self, buf: &'a [u8]) -> Result<Fragment<'a>, &'static str> {
+        Fragment::decode_with_limit(buf, self.max_message_size)
+    }
+
+    /// Split data into fragments referencing `data`
+    ///
+    /// Parity fragments (with FEC) are computed into `parity` and interleaved
+    /// after the group they protect. Data that fits the MTU yields a single
+    /// fragment with `total == 1`.
+    pub fn fragment<'a>(
+        &self,
+        data: &'a [u8],
+        parity: &'a mut Vec<u8>,
+    ) -> Result<Vec<Fragment<'a>>, &'static str> {
+        let chunk = self.mtu;
+        let total = data.len().div_ceil(chunk).max(1);
+        if total > u16::MAX as usize || data.len() > u32::MAX as usize {
+            return Err("Message too large to fragment");
+        }
+
+        let header = FragmentHeader {
+            fragment_id: self.next_fragment_id.fetch_add(1, Ordering::Relaxed),
+            message_len: data.len() as u32,
+            index: 0,
+            total: total as u16,
+            chunk_size: chunk as u16,
+            fec_group: if total > 1 { self.fec_group } else { 0 },
+            parity: false,
+        };
+        let groups = header.group_count();
+
+        if groups > 0 {
+            parity.clear();
+            parity.resize(groups * chunk, 0);
+            for (i, bytes) in data.chunks(chunk).enumerate() {
+                let start = (i / header.fec_group as usize) * chunk;
+                xor_into(&mut parity[start..start + bytes.len()], bytes);
+            }
+        }
+        let parity: &'a Vec<u8> = parity;
+
+        let mut fragments = Vec::with_capacity(total + groups);
+        for group in 0..groups.max(1) {
+            let indices = if groups > 0 {
+                header.group_range(group)
+            } else {
+                0..total
+            };
+            for index in indices {
+                fragments.push(Fragment {
+                    header: FragmentHeader {
+                        index: index as u16,
+                        ..header
+                    },
+                    data: &data[header.chunk_range(index)],
+                });
+            }
+            if groups > 0 {
+                let start = group * chunk;
+                fragments.push(Fragment {
+                    header: FragmentHeader {
+                        index: group as u16,
+                        parity: true,
+                        ..header
+                    },
+                    data: &parity[start..start + header.parity_len(group)],
+                });
+            }
+        }
+
+        Ok(fragments)
+    }
+
+    /// Frame `payload` as HORUS packets and hand each one to `emit`
+    ///
+    /// Payloads that fit the MTU go out as a single `whole_type` packet,
+    /// larger ones as `Fragment` packets. Every packet is written into `buf`
+    /// (cleared first) straight from the payload slice; `emit` may take the
+    /// buffer with `std::mem::take` / `replace`.
+    pub fn write_packets(
+        &self,
+        topic: &str,
+        whole_type: MessageType,
+        sequence: &mut u32,
+        payload: &[u8],
+        buf: &mut Vec<u8>,
+        mut emit: impl FnMut(&mut Vec<u8>) -> HorusResult<()>,
+    ) -> HorusResult<()> {
+        let timestamp_us = HorusPacket::now_us();
+
+        if payload.len() <= self.mtu {
+            buf.clear();
+            HorusPacket::encode_header(
+                whole_type,
+                *sequence,
+                timestamp_us,
+                topic,
+                payload.len(),
+                buf,
+            );
+            buf.extend_from_slice(payload);
+            *sequence = sequence.wrapping_add(1);
+            return emit(buf);
+        }
+
+        let mut parity = Vec::new();
+        for fragment in self.fragment(payload, &mut parity)? {
+            buf.clear();
+            HorusPacket::encode_header(
+                MessageType::Fragment,
+                *sequence,
+                timestamp_us,
+                topic,
+                FRAGMENT_HEADER_SIZE + fragment.data.len(),
+                buf,
+            );
+            fragment.encode(buf);
+            *sequence = sequence.wrapping_add(1);
+            emit(buf)?;
+        }
+        Ok(())
     }
 
     /// Add a received fragment and return complete message if all fragments received
-    pub fn reassemble(&self, fragment: Fragment) -> Option<Vec<u8>> {
-        let mut pending = self.pending_fragments.lock().unwrap();
+    ///
+    /// The returned buffer comes from an internal pool; hand it back with
+    /// `recycle` once decoded to keep reassembly allocation-free.
+    pub fn reassemble(&self, fragment: Fragment<'_>) -> Option<Vec<u8>> {
+        let header = fragment.header;
+        if header.message_len as usize > self.max_message_size {
+            return None;
+        }
 
         // Single fragment (not fragmented)
-        if fragment.total == 1 {
-            return Some(fragment.data);
+        if header.total == 1 && !header.parity {
+            let mut buffer = self.acquire(fragment.data.len());
+            buffer.copy_from_slice(fragment.data);
+            return Some(buffer);
         }
 
-        // Multi-fragment message
-        let fragmented = pending
-            .entry(fragment.fragment_id)
-            .or_insert_with(|| FragmentedMessage::new(fragment.total));
+        let id = header.fragment_id;
+        let mut shard = self.shard(id).lock().unwrap();
+        if shard.completed.contains(&id) {
+            // Late parity (or duplicate) for a message already delivered
+            return None;
+        }
 
-        let fragment_id = fragment.fragment_id;
-        fragmented.add_fragment(fragment);
+        if !shard.pending.contains_key(&id) {
+            if shard.pending.len() >= MAX_PENDING_PER_SHARD {
+                self.evict(&mut shard);
+            }
+            let buffer = self.acquire(header.message_len as usize);
+            shard
+                .pending
+                .insert(id, PendingMessage::new(header, buffer));
+        }
 
-        if fragmented.is_complete() {
-            // All fragments received, assemble and remove from pending
-            Some(pending.remove(&fragment_id).unwrap().assemble())
+        let message = shard.pending.get_mut(&id)?;
+        if !message.header.same_message(&header) {
+            return None;
+        }
+        let recovered = message.add(&header, fragment.data);
+        if recovered > 0 {
+            self.recovered
+                .fetch_add(recovered as u64, Ordering::Relaxed);
+        }
+
+        if message.is_complete() {
+            // All fragments received (or rebuilt), hand out the buffer
+            let message = shard.pending.remove(&id).unwrap();
+            let slot = shard.completed_next;
+            shard.completed[slot] = id;
+            shard.completed_next = (slot + 1) % COMPLETED_HISTORY;
+            Some(message.buffer)
         } else {
             None
         }
     }
 
+    /// Return a buffer from `reassemble` to the pool
+    ///
+    /// Buffers over `MAX_POOLED_BUFFER` are freed instead, so one large
+    /// message doesn't stay resident after it has been decoded.
+    pub fn recycle(&self, buffer: Vec<u8>) {
+        if buffer.capacity() > MAX_POOLED_BUFFER {
+            return;
+        }
+        let mut pool = self.buffer_pool.lock().unwrap();
+        if pool.len() < BUFFER_POOL_SIZE {
+            pool.push(buffer);
+        }
+    }
+
     /// Clean up stale fragments (called periodically)
     pub fn cleanup_stale(&self) {
-        let mut pending = self.pending_fragments.lock().unwrap();
         let now = Instant::now();
+        for shard in &self.shards {
+            let mut shard = shard.lock().unwrap();
+            let stale: Vec<u64> = shard
+                .pending
+                .iter()
+                .filter(|(_, m)| now.duration_since(m.first_received) >= FRAGMENT_TIMEOUT)
+                .map(|(&id, _)| id)
+                .collect();
+            for id in stale {
+                if let Some(message) = shard.pending.remove(&id) {
+                    self.recycle(message.buffer);
+                }
+            }
+        }
+    }
 
-        pending.retain(|_, fragmented| {
-            now.duration_since(fragmented.first_received) < FRAGMENT_TIMEOUT
-        });
+    /// Fragments rebuilt from parity since creation
+    pub fn recovered_count(&self) -> u64 {
+        self.recovered.load(Ordering::Relaxed)
     }
 
     pub fn mtu(&self) -> usize {
         self.mtu
     }
+
+    pub fn fec_group(&self) -> u8 {
+        self.fec_group
+    }
+
+    pub fn max_message_size(&self) -> usize {
+        self.max_message_size
+    }
+
+    #[inline]
+    fn shard(&self, fragment_id: u64) -> &Mutex<Shard> {
+        // Ids are sequential per sender; mix so neighbours spread out
+        let mixed = fragment_id.wrapping_mul(0x9E37_79B9_7F4A_7C15);
+        &self.shards[(mixed >> 61) as usize % SHARDS]
+    }
+
+    /// Pooled buffer of exactly `len` bytes
+    ///
+    /// Bytes left over from a previous message are not cleared: reassembly
+    /// overwrites every byte before the buffer is handed out.
+    fn acquire(&self, len: usize) -> Vec<u8> {
+        let mut buffer = self.buffer_pool.lock().unwrap().pop().unwrap_or_default();
+        buffer.resize(len, 0);
+        buffer
+    }
+
+    /// Make room in a full shard: drop timed-out messages, else the oldest
+    fn evict(&self, shard: &mut Shard) {
+        let now = Instant::now();
+        let victim = shard
+            .pending
+            .iter()
+            .min_by_key(|(_, m)| m.first_received)
+            .map(|(&id, m)| (id, now.duration_since(m.first_received)));
+        let stale: Vec<u64> = shard
+            .pending
+            .iter()
+            .filter(|(_, m)| now.duration_since(m.first_received) >= FRAGMENT_TIMEOUT)
+            .map(|(&id, _)| id)
+            .collect();
+        let ids = if stale.is_empty() {
+            victim.map(|(id, _)| vec![id]).unwrap_or_default()
+        } else {
+            stale
+        };
+        for id in ids {
+            if let Some(message) = shard.pending.remove(&id) {
+                self.recycle(message.buffer);
+            }
+        }
+    }
 }
 
 impl Default for FragmentManager {
@@ -119,44 +537,133 @@ impl Default for FragmentManager {
     }
 }
 
-/// Incomplete fragmented message being reassembled
-struct FragmentedMessage {
-    fragment_id: u64,
-    fragments: Vec<Option<Vec<u8>>>,
+/// One independently locked slice of the reassembly table
+#[derive(Default)]
+struct Shard {
+    pending: HashMap<u64, PendingMessage>,
+    completed: [u64; COMPLETED_HISTORY],
+    completed_next: usize,
+}
+
+/// Incomplete fragmented message being reassembled in place
+struct PendingMessage {
+    header: FragmentHeader,
+    buffer: Vec<u8>,
+    received: Vec<u64>, // Bitmap of data fragments placed in `buffer`
     received_count: usize,
+    group_received: Vec<u16>,     // Data fragments received per parity group
+    parity: Vec<Option<Vec<u8>>>, // Parity that arrived before it could be used
     first_received: Instant,
 }
 
-impl FragmentedMessage {
-    fn new(total: u16) -> Self {
+impl PendingMessage {
+    fn new(header: FragmentHeader, buffer: Vec<u8>) -> Self {
+        let groups = header.group_count();
         Self {
-            fragment_id: 0,
-            fragments: vec![None; total as usize],
+            header,
+            buffer,
+            received: vec![0; (header.total as usize).div_ceil(64)],
             received_count: 0,
+            group_received: vec![0; groups],
+            parity: vec![None; groups],
             first_received: Instant::now(),
         }
     }
 
-    fn add_fragment(&mut self, fragment: Fragment) {
-        self.fragment_id = fragment.fragment_id;
+    #[inline]
+    fn has(&self, index: usize) -> bool {
+        self.received[index / 64] & (1 << (index % 64)) != 0
+    }
 
-        let index = fragment.index as usize;
-        if index < self.fragments.len() && self.fragments[index].is_none() {
-            self.fragments[index] = Some(fragment.data);
-            self.received_count += 1;
+    #[inline]
+    fn mark(&mut self, index: usize) {
+        self.received[index / 64] |= 1 << (index % 64);
+        self.received_count += 1;
+        if let Some(count) = self
+            .group_received
+            .get_mut(index / self.header.fec_group.max(1) as usize)
+        {
+            *count += 1;
         }
     }
 
     fn is_complete(&self) -> bool {
-        self.received_count == self.fragments.len()
+        self.received_count == self.header.total as usize
+    }
+
+    /// Place one fragment; returns how many fragments parity rebuilt
+    fn add(&mut self, header: &FragmentHeader, data: &[u8]) -> usize {
+        if header.parity {
+            return self.add_parity(header.index as usize, data);
+        }
+
+        let index = header.index as usize;
+        if self.has(index) {
+            return 0;
+        }
+        self.buffer[self.header.chunk_range(index)].copy_from_slice(data);
+        self.mark(index);
+        if self.header.fec_group == 0 {
+            return 0;
+        }
+
+        let group = index / self.header.fec_group as usize;
+        if self.missing_in(group) == 1 {
+            if let Some(parity) = self.parity[group].take() {
+                self.recover(group, &parity);
+                return 1;
+            }
+        }
+        0
     }
 
-    fn assemble(self) -> Vec<u8> {
-        let mut result = Vec::new();
-        for data in self.fragments.into_iter().flatten() {
-            result.extend_from_slice(&data);
+    fn add_parity(&mut self, group: usize, data: &[u8]) -> usize {
+        match self.missing_in(group) {
+            // Nothing lost in this group
+            0 => 0,
+            1 => {
+                self.recover(group, data);
+                1
+            }
+            _ => {
+                // Keep it until all but one data fragment of the group arrive
+                if self.parity[group].is_none() {
+                    self.parity[group] = Some(data.to_vec());
+                }
+                0
+            }
         }
-        result
+    }
+
+    #[inline]
+    fn missing_in(&self, group: usize) -> usize {
+        self.header.group_range(group).len() - self.group_received[group] as usize
+    }
+
+    /// Rebuild the one missing data fragment of `group` from its parity
+    fn recover(&mut self, group: usize, parity: &[u8]) {
+        let range = self.header.group_range(group);
+        let Some(missing) = range.clone().find(|&i| !self.has(i)) else {
+            return;
+        };
+        let dst = self.header.chunk_range(missing);
+        let len = dst.len();
+        self.buffer[dst.clone()].copy_from_slice(&parity[..len]);
+
+        for other in range.filter(|&i| i != missing) {
+            let src = self.header.chunk_range(other);
+            let n = len.min(src.len());
+            // Ranges never overlap, so split the buffer between them
+            let (dst_bytes, src_bytes) = if dst.start < src.start {
+                let (lo, hi) = self.buffer.split_at_mut(src.start);
+                (&mut lo[dst.start..dst.start + n], &hi[..n])
+            } else {
+                let (lo, hi) = self.buffer.split_at_mut(dst.start);
+                (&mut hi[..n], &lo[src.start..src.start + n])
+            };
+            xor_into(dst_bytes, src_bytes);
+        }
+        self.mark(missing);
     }
 }
 
@@ -164,15 +671,32 @@ impl FragmentedMessage {
 mod tests {
     use super::*;
 
+    /// Encode every fragment the way a sender puts it on the wire
+    fn wire(fragments: &[Fragment<'_>]) -> Vec<Vec<u8>> {
+        fragments
+            .iter()
+            .map(|f| {
+                let mut buf = Vec::new();
+                f.encode(&mut buf);
+                buf
+            })
+            .collect()
+    }
+
+    fn pattern(len: usize) -> Vec<u8> {
+        (0..len).map(|i| (i * 7 + i / 251) as u8).collect()
+    }
+
     #[test]
     fn test_no_fragmentation_needed() {
         let manager = FragmentManager::new(Some(1500));
         let data = vec![0u8; 1000]; // Smaller than MTU
 
-        let fragments = manager.fragment(&data);
+        let mut parity = Vec::new();
+        let fragments = manager.fragment(&data, &mut parity).unwrap();
         assert_eq!(fragments.len(), 1);
-        assert_eq!(fragments[0].total, 1);
-        assert_eq!(fragments[0].index, 0);
+        assert_eq!(fragments[0].header.total, 1);
+        assert_eq!(fragments[0].header.index, 0);
     }
 
     #[test]
@@ -180,29 +704,54 @@ mod tests {
         let manager = FragmentManager::new(Some(1000));
         let data = vec![0u8; 3500]; // 3.5x MTU
 
-        let fragments = manager.fragment(&data);
+        let mut parity = Vec::new();
+        let fragments = manager.fragment(&data, &mut parity).unwrap();
         assert_eq!(fragments.len(), 4); // ceil(3500/1000) = 4
 
         // Check fragment metadata
+        let id = fragments[0].header.fragment_id;
         for (i, frag) in fragments.iter().enumerate() {
-            assert_eq!(frag.index, i as u16);
-            assert_eq!(frag.total, 4);
-            assert_eq!(frag.fragment_id, 0);
+            assert_eq!(frag.header.index, i as u16);
+            assert_eq!(frag.header.total, 4);
+            assert_eq!(frag.header.fragment_id, id);
         }
+
+        // Fragments borrow the source buffer instead of copying it
+        assert_eq!(fragments[1].data.as_ptr(), data[1000..].as_ptr());
+        assert_eq!(fragments[3].data.len(), 500);
+    }
+
+    #[test]
+    fn test_header_roundtrip_and_validation() {
+        let manager = FragmentManager::new(Some(1000));
+        let data = pattern(2500);
+        let mut parity = Vec::new();
+        let fragments = manager.fragment(&data, &mut parity).unwrap();
+
+        let encoded = wire(&fragments);
+        let decoded = Fragment::decode(&encoded[2]).unwrap();
+        assert_eq!(decoded.header, fragments[2].header);
+        assert_eq!(decoded.data, &data[2000..]);
+
+        // Truncated payload is rejected
+        let short = &encoded[1][..encoded[1].len() - 1];
+        assert!(Fragment::decode(short).is_err());
+        assert!(Fragment::decode(&encoded[0][..10]).is_err());
     }
 
     #[test]
     fn test_reassembly() {
         let manager = FragmentManager::new(Some(1000));
-        let original_data = vec![42u8; 2500];
+        let original_data = pattern(2500);
 
         // Fragment
-        let fragments = manager.fragment(&original_data);
+        let mut parity = Vec::new();
+        let fragments = wire(&manager.fragment(&original_data, &mut parity).unwrap());
         assert_eq!(fragments.len(), 3);
 
         // Reassemble in order
         for (i, frag) in fragments.iter().enumerate() {
-            let result = manager.reassemble(frag.clone());
+            let result = manager.reassemble(Fragment::decode(frag).unwrap());
             if i < 2 {
                 assert!(result.is_none()); // Not complete yet
             } else {
@@ -215,20 +764,19 @@ mod tests {
     #[test]
     fn test_reassembly_out_of_order() {
         let manager = FragmentManager::new(Some(1000));
-        let original_data = vec![42u8; 2500];
+        let original_data = pattern(2500);
 
         // Fragment
-        let mut fragments = manager.fragment(&original_data);
+        let mut parity = Vec::new();
+        let fragments = wire(&manager.fragment(&original_data, &mut parity).unwrap());
 
-        // Reassemble out of order (2, 0, 1)
-        let frag2 = fragments.pop().unwrap();
-        let frag0 = fragments.remove(0);
-        let frag1 = fragments.pop().unwrap();
+        // Reassemble out of order (2, 0, 1), with a duplicate
+        let decode = |i: usize| Fragment::decode(&fragments[i]).unwrap();
+        assert!(manager.reassemble(decode(2)).is_none());
+        assert!(manager.reassemble(decode(0)).is_none());
+        assert!(manager.reassemble(decode(2)).is_none());
 
-        assert!(manager.reassemble(frag2).is_none());
-        assert!(manager.reassemble(frag0).is_none());
-
-        let result = manager.reassemble(frag1);
+        let result = manager.reassemble(decode(1));
         assert!(result.is_some());
         assert_eq!(result.unwrap(), original_data);
     }
@@ -238,12 +786,231 @@ mod tests {
         let manager = FragmentManager::new(Some(1500));
         let data = vec![42u8; 500];
 
-        let fragments = manager.fragment(&data);
+        let mut parity = Vec::new();
+        let fragments = manager.fragment(&data, &mut parity).unwrap();
         assert_eq!(fragments.len(), 1);
 
         // Should return immediately (single fragment)
-        let result = manager.reassemble(fragments[0].clone());
+        let result = manager.reassemble(fragments[0]);
         assert!(result.is_some());
         assert_eq!(result.unwrap(), data);
     }
+
+    #[test]
+    fn test_interleaved_messages_and_buffer_reuse() {
+        let manager = FragmentManager::new(Some(100));
+        let a = pattern(950);
+        let b: Vec<u8> = pattern(640).iter().map(|x| x ^ 0xFF).collect();
+
+        let (mut pa, mut pb) = (Vec::new(), Vec::new());
+        let fa = wire(&manager.fragment(&a, &mut pa).unwrap());
+        let fb = wire(&manager.fragment(&b, &mut pb).unwrap());
+
+        let mut done = Vec::new();
+        for i in 0..fa.len().max(fb.len()) {
+            for frags in [&fb, &fa] {
+                if let Some(f) = frags.get(i) {
+                    done.extend(manager.reassemble(Fragment::decode(f).unwrap()));
+                }
+            }
+        }
+        assert_eq!(done, vec![b, a.clone()]);
+
+        // A recycled (larger) buffer is trimmed to the next message's length
+        for buffer in done {
+            manager.recycle(buffer);
+        }
+        let c = pattern(150);
+        let mut pc = Vec::new();
+        let mut result = None;
+        for f in wire(&manager.fragment(&c, &mut pc).unwrap()) {
+            result = manager.reassemble(Fragment::decode(&f).unwrap());
+        }
+        assert_eq!(result.unwrap(), c);
+    }
+
+    #[test]
+    fn test_oversized_message_rejected_before_allocation() {
+        // A lone datagram claiming a ~4 GiB message
+        let header = FragmentHeader {
+            fragment_id: 1,
+            message_len: u16::MAX as u32 * u16::MAX as u32,
+            index: 0,
+            total: u16::MAX,
+            chunk_size: u16::MAX,
+            fec_group: 0,
+            parity: false,
+        };
+        let mut datagram = Vec::new();
+        Fragment {
+            header,
+            data: &vec![0u8; u16::MAX as usize],
+        }
+        .encode(&mut datagram);
+
+        let manager = FragmentManager::default();
+        assert!(Fragment::decode(&datagram).is_err());
+        assert!(manager.decode(&datagram).is_err());
+
+        // Even a fragment that skipped the check reserves nothing
+        let fragment = Fragment::decode_with_limit(&datagram, usize::MAX).unwrap();
+        assert!(manager.reassemble(fragment).is_none());
+        assert!(manager
+            .shards
+            .iter()
+            .all(|s| s.lock().unwrap().pending.is_empty()));
+    }
+
+    #[test]
+    fn test_configured_max_message_size() {
+        let manager = FragmentManager::new(Some(1000)).with_max_message_size(2000);
+        assert_eq!(manager.max_message_size(), 2000);
+
+        let mut parity = Vec::new();
+        let fits = wire(&manager.fragment(&pattern(2000), &mut parity).unwrap());
+        assert!(fits.iter().all(|f| manager.decode(f).is_ok()));
+        let too_big = wire(&manager.fragment(&pattern(2001), &mut parity).unwrap());
+        assert!(too_big.iter().all(|f| manager.decode(f).is_err()));
+    }
+
+    #[test]
+    fn test_large_buffers_not_pooled() {
+        let manager = FragmentManager::default();
+        manager.recycle(vec![0; MAX_POOLED_BUFFER + 1]);
+        assert!(manager.buffer_pool.lock().unwrap().is_empty());
+        manager.recycle(vec![0; 1024]);
+        assert_eq!(manager.buffer_pool.lock().unwrap().len(), 1);
+    }
+
+    #[test]
+    fn test_fec_recovers_one_loss_per_group() {
+        let manager = FragmentManager::new(Some(100)).with_fec(4);
+        let data = pattern(1050); // 11 data fragments, groups of 4/4/3
+
+        let mut parity = Vec::new();
+        let fragments = manager.fragment(&data, &mut parity).unwrap();
+        let parities: Vec<_> = fragments.iter().filter(|f| f.header.parity).collect();
+        assert_eq!(parities.len(), 3);
+        assert_eq!(fragments.len(), 14);
+        // Parity follows the group it protects
+        assert!(fragments[4].header.parity && fragments[4].header.index == 0);
+
+        let encoded = wire(&fragments);
+        // Drop one data fragment in every group, including the short last one
+        let lost = |f: &Fragment<'_>| !f.header.parity && [1, 7, 10].contains(&f.header.index);
+        let mut result = None;
+        for bytes in &encoded {
+            let fragment = Fragment::decode(bytes).unwrap();
+            if lost(&fragment) {
+                continue;
+            }
+            if let Some(message) = manager.reassemble(fragment) {
+                result = Some(message);
+            }
+        }
+        assert_eq!(result.unwrap(), data);
+        assert_eq!(manager.recovered_count(), 3);
+    }
+
+    #[test]
+    fn test_fec_parity_before_data() {
+        let manager = FragmentManager::new(Some(100)).with_fec(3);
+        let data = pattern(600);
+
+        let mut parity = Vec::new();
+        let mut encoded = wire(&manager.fragment(&data, &mut parity).unwrap());
+        // Reverse delivery: parity arrives first and must be held
+        encoded.reverse();
+        let mut result = None;
+        for bytes in &encoded {
+            let fragment = Fragment::decode(bytes).unwrap();
+            if !fragment.header.parity && fragment.header.index == 4 {
+                continue;
+            }
+            if let Some(message) = manager.reassemble(fragment) {
+                result = Some(message);
+            }
+        }
+        assert_eq!(result.unwrap(), data);
+        // Group 0 is rebuilt from held parity before its last (first-sent)
+        // fragment shows up; group 1 recovers the dropped fragment
+        assert_eq!(manager.recovered_count(), 2);
+    }
+
+    #[test]
+    fn test_fec_two_losses_in_group_drop_message() {
+        let manager = FragmentManager::new(Some(100)).with_fec(4);
+        let data = pattern(800);
+
+        let mut parity = Vec::new();
+        let encoded = wire(&manager.fragment(&data, &mut parity).unwrap());
+        for bytes in &encoded {
+            let fragment = Fragment::decode(bytes).unwrap();
+            if !fragment.header.parity && (fragment.header.index == 0 || fragment.header.index == 2)
+            {
+                continue;
+            }
+            assert!(manager.reassemble(fragment).is_none());
+        }
+    }
+
+    #[test]
+    fn test_concurrent_reassembly_across_shards() {
+        let manager = std::sync::Arc::new(FragmentManager::new(Some(64)).with_fec(8));
+        let handles: Vec<_> = (0..4)
+            .map(|t| {
+                let manager = std::sync::Arc::clone(&manager);
+                std::thread::spawn(move || {
+                    for n in 0..50 {
+                        let data: Vec<u8> = pattern(500 + t * 97 + n)
+                            .iter()
+                            .map(|x| x ^ t as u8)
+                            .collect();
+                        let mut parity = Vec::new();
+                        let mut result = None;
+                        for bytes in wire(&manager.fragment(&data, &mut parity).unwrap()) {
+                            if let Some(m) = manager.reassemble(Fragment::decode(&bytes).unwrap()) {
+                                result = Some(m);
+                            }
+                        }
+                        let message = result.expect("message reassembled");
+                        assert_eq!(message, data);
+                        manager.recycle(message);
+                    }
+                })
+            })
+            .collect();
+        for handle in handles {
+            handle.join().unwrap();
+        }
+    }
+
+    #[test]
+    fn test_write_packets() {
+        let manager = FragmentManager::new(Some(1000)).with_fec(2);
+        let data = pattern(2500);
+        let mut seq = 7u32;
+        let mut buf = Vec::new();
+        let mut result = None;
+        manager
+            .write_packets(
+                "points",
+                MessageType::Data,
+                &mut seq,
+                &data,
+                &mut buf,
+                |bytes| {
+                    let packet = crate::communication::network::protocol::PacketView::parse(bytes)?;
+                    assert_eq!(packet.msg_type, MessageType::Fragment);
+                    if let Some(m) = manager.reassemble(Fragment::decode(packet.payload)?) {
+                        result = Some(m);
+                    }
+                    Ok(())
+                },
+            )
+            .unwrap();
+        // 3 data + 2 parity packets
+        assert_eq!(seq, 12);
+        assert_eq!(result.unwrap(), data);
+    }
 }
@@ -36,6 +36,8 @@ pub mod udp_multicast;
 
 // Network v2 high-performance modules
 pub mod batch_udp;
+#[cfg(target_os = "linux")]
+pub mod recv_staging;
 pub mod smart_copy;
 pub mod smart_transport;
 
@@ -60,8 +62,8 @@ pub use backend::NetworkBackend;
 pub use direct::{DirectBackend, DirectRole};
 pub use discovery::{DiscoveryService, PeerInfo};
 pub use endpoint::{parse_endpoint, Endpoint, DEFAULT_PORT, MULTICAST_ADDR, MULTICAST_PORT};
-pub use fragmentation::{Fragment, FragmentManager};
-pub use protocol::{HorusPacket, MessageType};
+pub use fragmentation::{Fragment, FragmentHeader, FragmentManager, FRAGMENT_HEADER_SIZE};
+pub use protocol::{HorusPacket, MessageType, PacketView};
 pub use reconnect::{ConnectionHealth, ReconnectContext, ReconnectStrategy};
 pub use router::RouterBackend;
 pub use udp_direct::UdpDirectBackend;
@@ -71,7 +73,9 @@ pub use udp_multicast::UdpMulticastBackend;
 pub use batching::{BatchConfig, BatchReceiver, MessageBatch, MessageBatcher, SharedBatcher};
 pub use caching::{CacheConfig, CacheStats, SharedCache, TopicCache};
 pub use compression::{
-    CompressedData, CompressedPacket, CompressionAlgo, CompressionConfig, Compressor,
+    CodecEstimate, CodecProfile, CompressedData, CompressedPacket, CompressionAlgo,
+    CompressionConfig, CompressionError, Compressor, TopicCompressor, TopicDecompressor,
+    FRAME_HEADER_SIZE,
 };
 pub use congestion::{
     CongestionConfig, CongestionController, CongestionResult, DropPolicy,
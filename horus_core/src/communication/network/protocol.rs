@@ -157,15 +157,41 @@ impl HorusPacket {
     /// Encode packet to bytes (zero-allocation where possible)
     pub fn encode(&self, buf: &mut Vec<u8>) -> usize {
         buf.clear();
+        Self::encode_header(
+            self.msg_type,
+            self.sequence,
+            self.timestamp_us,
+            &self.topic,
+            self.payload.len(),
+            buf,
+        );
 
+        // Write payload
+        buf.extend_from_slice(&self.payload);
+
+        buf.len()
+    }
+
+    /// Append a packet header and topic name for a payload of `payload_len` bytes
+    ///
+    /// Lets senders frame a payload that lives elsewhere (a fragment of a
+    /// larger buffer) without building a `HorusPacket` around a copy of it.
+    pub fn encode_header(
+        msg_type: MessageType,
+        sequence: u32,
+        timestamp_us: u64,
+        topic: &str,
+        payload_len: usize,
+        buf: &mut Vec<u8>,
+    ) {
         let header = PacketHeader {
             magic: MAGIC,
             version: VERSION,
-            msg_type: self.msg_type as u8,
-            sequence: self.sequence,
-            timestamp_us: self.timestamp_us,
-            topic_len: self.topic.len() as u16,
-            payload_len: self.payload.len() as u32,
+            msg_type: msg_type as u8,
+            sequence,
+            timestamp_us,
+            topic_len: topic.len() as u16,
+            payload_len: payload_len as u32,
         };
 
         // Write header (unsafe but fast)
@@ -178,16 +204,48 @@ impl HorusPacket {
         }
 
         // Write topic name
-        buf.extend_from_slice(self.topic.as_bytes());
-
-        // Write payload
-        buf.extend_from_slice(&self.payload);
-
-        buf.len()
+        buf.extend_from_slice(topic.as_bytes());
     }
 
     /// Decode packet from bytes (zero-copy where possible)
     pub fn decode(buf: &[u8]) -> Result<Self, &'static str> {
+        let view = PacketView::parse(buf)?;
+
+        Ok(HorusPacket {
+            msg_type: view.msg_type,
+            sequence: view.sequence,
+            timestamp_us: view.timestamp_us,
+            topic: view.topic.into_owned(),
+            payload: view.payload.to_vec(),
+        })
+    }
+
+    /// Get current timestamp in microseconds
+    pub fn now_us() -> u64 {
+        use std::time::{SystemTime, UNIX_EPOCH};
+        SystemTime::now()
+            .duration_since(UNIX_EPOCH)
+            .unwrap()
+            .as_micros() as u64
+    }
+}
+
+/// Borrowed view of an encoded packet
+///
+/// Parses the header and borrows the topic and payload from the input buffer,
+/// so forwarders (e.g. the router) can inspect a packet without copying it.
+#[derive(Debug)]
+pub struct PacketView<'a> {
+    pub msg_type: MessageType,
+    pub sequence: u32,
+    pub timestamp_us: u64,
+    pub topic: std::borrow::Cow<'a, str>,
+    pub payload: &'a [u8],
+}
+
+impl<'a> PacketView<'a> {
+    /// Parse a packet header and borrow its topic and payload from `buf`
+    pub fn parse(buf: &'a [u8]) -> Result<Self, &'static str> {
         if buf.len() < mem::size_of::<PacketHeader>() {
             return Err("Buffer too small for header");
         }
@@ -228,29 +286,15 @@ impl HorusPacket {
             return Err("Buffer too small for payload");
         }
 
-        // Extract topic (requires allocation)
-        let topic = String::from_utf8_lossy(&buf[topic_start..topic_end]).to_string();
-
-        // Extract payload (clone for now, could use Arc for zero-copy)
-        let payload = buf[payload_start..payload_end].to_vec();
-
-        Ok(HorusPacket {
+        Ok(PacketView {
             msg_type,
             sequence: header.sequence,
             timestamp_us: header.timestamp_us,
-            topic,
-            payload,
+            // Borrowed unless the topic is not valid UTF-8
+            topic: String::from_utf8_lossy(&buf[topic_start..topic_end]),
+            payload: &buf[payload_start..payload_end],
         })
     }
-
-    /// Get current timestamp in microseconds
-    pub fn now_us() -> u64 {
-        use std::time::{SystemTime, UNIX_EPOCH};
-        SystemTime::now()
-            .duration_since(UNIX_EPOCH)
-            .unwrap()
-            .as_micros() as u64
-    }
 }
 
 #[cfg(test)]
@@ -277,6 +321,20 @@ mod tests {
         assert_eq!(decoded.payload, vec![1, 2, 3, 4, 5]);
     }
 
+    #[test]
+    fn test_packet_view_borrows_buffer() {
+        let packet = HorusPacket::new_router_publish("tf".to_string(), vec![9; 16], 7);
+        let mut buf = Vec::new();
+        packet.encode(&mut buf);
+
+        let view = PacketView::parse(&buf).unwrap();
+        assert_eq!(view.msg_type, MessageType::RouterPublish);
+        assert_eq!(view.sequence, 7);
+        assert!(matches!(view.topic, std::borrow::Cow::Borrowed("tf")));
+        assert_eq!(view.payload.as_ptr(), buf[buf.len() - 16..].as_ptr());
+        assert!(PacketView::parse(&buf[..buf.len() - 1]).is_err());
+    }
+
     #[test]
     fn test_header_size() {
         // Ensure header is exactly 24 bytes for predictable performance
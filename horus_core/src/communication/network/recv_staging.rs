@@ -0,0 +1,264 @@
+//! Receive staging queue for batch UDP
+//!
+//! A dedicated thread drains the socket with `recvmmsg`, pulling up to a full
+//! batch of datagrams per syscall, copies each one into a pooled buffer and
+//! pushes it onto a bounded lock-free queue. The node pops buffers one at a
+//! time, decodes straight out of the pooled bytes and hands the buffer back,
+//! so the steady-state receive path makes no allocations and takes no locks.
+//!
+//! If the node falls behind and the queue fills up, the oldest datagram is
+//! dropped to make room (latest state wins, as for joint-state streams).
+
+use super::batch_udp::BatchUdpReceiver;
+use super::smart_copy::{BufferPool, RegisteredBuffer, SmartCopyConfig, SmartCopyStats};
+use crossbeam::queue::ArrayQueue;
+use std::io;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::sync::Arc;
+use std::thread::JoinHandle;
+use std::time::Duration;
+
+/// Size of each pooled staging buffer; larger datagrams get a one-off buffer
+const STAGING_BUFFER_SIZE: usize = 2048;
+/// Queue depth in units of the receiver batch size
+const QUEUE_BATCHES: usize = 4;
+/// How long the receive thread sleeps in poll() before re-checking shutdown
+const POLL_INTERVAL: Duration = Duration::from_millis(10);
+
+/// Snapshot of staging queue counters
+#[derive(Debug, Clone, Copy, Default)]
+pub struct RecvStagingStats {
+    /// Datagrams currently waiting to be consumed
+    pub queued: usize,
+    /// Datagrams staged by the receive thread since creation
+    pub staged: u64,
+    /// Datagrams dropped because the queue was full
+    pub dropped: u64,
+    /// Datagrams that did not fit a pooled buffer
+    pub overflow: u64,
+}
+
+/// State shared between the receive thread and the consumer
+struct Shared {
+    queue: ArrayQueue<RegisteredBuffer>,
+    pool: BufferPool,
+    running: AtomicBool,
+    staged: AtomicU64,
+    dropped: AtomicU64,
+    overflow: AtomicU64,
+}
+
+impl Shared {
+    fn stage(&self, data: &[u8]) {
+        let mut buffer = match self.pool.acquire() {
+            Some(mut buf) if data.len() <= buf.capacity() => {
+                buf.copy_from(data);
+                buf
+            }
+            other => {
+                if let Some(buf) = other {
+                    self.pool.release(buf);
+                }
+                self.overflow.fetch_add(1, Ordering::Relaxed);
+                let mut buf = self.pool.allocate_overflow(data.len());
+                buf.copy_from(data);
+                buf
+            }
+        };
+
+        loop {
+            match self.queue.push(buffer) {
+                Ok(()) => break,
+                Err(rejected) => {
+                    // Full: evict the oldest datagram and retry
+                    buffer = rejected;
+                    if let Some(oldest) = self.queue.pop() {
+                        self.recycle(oldest);
+                        self.dropped.fetch_add(1, Ordering::Relaxed);
+                    }
+                }
+            }
+        }
+        self.staged.fetch_add(1, Ordering::Relaxed);
+    }
+
+    #[inline]
+    fn recycle(&self, buffer: RegisteredBuffer) {
+        // Overflow buffers are just dropped
+        if self.pool.is_pooled(&buffer) {
+            self.pool.release(buffer);
+        }
+    }
+}
+
+/// Lock-free handoff from a background `recvmmsg` thread to one consumer
+pub struct RecvStaging {
+    shared: Arc<Shared>,
+    thread: Option<JoinHandle<()>>,
+}
+
+impl RecvStaging {
+    /// Move `receiver` onto a background thread and start staging datagrams
+    pub fn spawn(
+        mut receiver: BatchUdpReceiver,
+        batch_size: usize,
+        name: &str,
+    ) -> io::Result<Self> {
+        let batch_size = batch_size.max(1);
+        let depth = batch_size * QUEUE_BATCHES;
+
+        let pool_config = SmartCopyConfig {
+            buffer_size: STAGING_BUFFER_SIZE,
+            // One extra batch so the thread can fill a batch while the queue is full
+            pool_size: depth + batch_size,
+            ..SmartCopyConfig::default()
+        };
+
+        let shared = Arc::new(Shared {
+            queue: ArrayQueue::new(depth),
+            pool: BufferPool::new(pool_config, Arc::new(SmartCopyStats::default())),
+            running: AtomicBool::new(true),
+            staged: AtomicU64::new(0),
+            dropped: AtomicU64::new(0),
+            overflow: AtomicU64::new(0),
+        });
+
+        let thread_shared = Arc::clone(&shared);
+        let thread = std::thread::Builder::new()
+            .name(format!("horus-udp-rx-{}", name))
+            .spawn(move || {
+                while thread_shared.running.load(Ordering::Relaxed) {
+                    match receiver.wait_readable(POLL_INTERVAL) {
+                        Ok(true) => {}
+                        Ok(false) => continue,
+                        Err(e) => {
+                            log::warn!("Batch UDP poll failed: {}", e);
+                            std::thread::sleep(POLL_INTERVAL);
+                            continue;
+                        }
+                    }
+
+                    // Drain everything the kernel has buffered, a batch per syscall
+                    loop {
+                        match receiver
+                            .recv_batch_with(batch_size, |data, _addr| thread_shared.stage(data))
+                        {
+                            Ok(n) if n == batch_size => continue,
+                            Ok(_) => break,
+                            Err(e) => {
+                                log::debug!("Batch UDP receive error: {}", e);
+                                break;
+                            }
+                        }
+                    }
+                }
+            })?;
+
+        Ok(Self {
+            shared,
+            thread: Some(thread),
+        })
+    }
+
+    /// Take the next staged datagram and run `f` on its bytes
+    ///
+    /// The buffer goes back to the pool as soon as `f` returns.
+    #[inline]
+    pub fn pop_with<R>(&self, f: impl FnOnce(&[u8]) -> R) -> Option<R> {
+        let buffer = self.shared.queue.pop()?;
+        let result = f(buffer.as_slice());
+        self.shared.recycle(buffer);
+        Some(result)
+    }
+
+    /// Counters for diagnostics
+    pub fn stats(&self) -> RecvStagingStats {
+        RecvStagingStats {
+            queued: self.shared.queue.len(),
+            staged: self.shared.staged.load(Ordering::Relaxed),
+            dropped: self.shared.dropped.load(Ordering::Relaxed),
+            overflow: self.shared.overflow.load(Ordering::Relaxed),
+        }
+    }
+}
+
+impl Drop for RecvStaging {
+    fn drop(&mut self) {
+        self.shared.running.store(false, Ordering::Relaxed);
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
+}
+
+impl std::fmt::Debug for RecvStaging {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("RecvStaging")
+            .field("stats", &self.stats())
+            .finish()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::communication::network::batch_udp::BatchUdpConfig;
+    use std::net::{SocketAddr, UdpSocket};
+    use std::time::Instant;
+
+    fn staging(batch_size: usize) -> (RecvStaging, SocketAddr) {
+        let config = BatchUdpConfig {
+            batch_size,
+            ..BatchUdpConfig::default()
+        };
+        let receiver = BatchUdpReceiver::new("127.0.0.1:0".parse().unwrap(), config).unwrap();
+        let addr = receiver.local_addr().unwrap();
+        (
+            RecvStaging::spawn(receiver, batch_size, "test").unwrap(),
+            addr,
+        )
+    }
+
+    #[test]
+    fn test_staging_delivers_in_order() {
+        let (staging, addr) = staging(16);
+        let socket = UdpSocket::bind("127.0.0.1:0").unwrap();
+
+        for i in 0u32..40 {
+            socket.send_to(&i.to_le_bytes(), addr).unwrap();
+        }
+
+        let mut received = Vec::new();
+        let deadline = Instant::now() + Duration::from_secs(2);
+        while received.len() < 40 && Instant::now() < deadline {
+            match staging.pop_with(|bytes| u32::from_le_bytes(bytes.try_into().unwrap())) {
+                Some(v) => received.push(v),
+                None => std::thread::sleep(Duration::from_millis(1)),
+            }
+        }
+
+        assert_eq!(received, (0..40).collect::<Vec<_>>());
+        assert_eq!(staging.stats().dropped, 0);
+    }
+
+    #[test]
+    fn test_full_queue_drops_oldest() {
+        let (staging, addr) = staging(2);
+        let socket = UdpSocket::bind("127.0.0.1:0").unwrap();
+        let depth = 2 * QUEUE_BATCHES as u32;
+
+        for i in 0u32..depth + 3 {
+            socket.send_to(&i.to_le_bytes(), addr).unwrap();
+        }
+
+        let deadline = Instant::now() + Duration::from_secs(2);
+        while staging.stats().staged < (depth + 3) as u64 && Instant::now() < deadline {
+            std::thread::sleep(Duration::from_millis(1));
+        }
+
+        let stats = staging.stats();
+        assert_eq!(stats.dropped, 3);
+        let first = staging.pop_with(|bytes| u32::from_le_bytes(bytes.try_into().unwrap()));
+        assert_eq!(first, Some(3));
+    }
+}
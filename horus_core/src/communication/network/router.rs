@@ -1,4 +1,4 @@
-use crate::communication::network::fragmentation::{Fragment, FragmentManager};
+use crate::communication::network::fragmentation::FragmentManager;
 /// High-performance async router client backend
 ///
 /// Optimizations:
@@ -225,11 +225,12 @@ where
                     }
                     MessageType::Fragment => {
                         // Fragment reassembly
-                        if let Ok(fragment) = Fragment::decode(&packet.payload) {
+                        if let Ok(fragment) = fragment_manager.decode(&packet.payload) {
                             if let Some(complete_data) = fragment_manager.reassemble(fragment) {
                                 if let Ok(msg) = bincode::deserialize::<T>(&complete_data) {
                                     let _ = recv_tx.try_send(msg);
                                 }
+                                fragment_manager.recycle(complete_data);
                             }
                         }
                     }
@@ -247,31 +248,26 @@ where
         // Serialize payload
         let payload = bincode::serialize(msg).map_err(|e| format!("Serialization error: {}", e))?;
 
-        // Fragment if needed
-        let fragments = self.fragment_manager.fragment(&payload);
-
         // Get sequence number
         let mut seq = self.sequence.lock();
 
-        // Encode all fragments
-        for fragment in fragments {
-            let packet = if fragment.total == 1 {
-                HorusPacket::new_router_publish(self.topic_name.clone(), fragment.data, *seq)
-            } else {
-                let fragment_data = fragment.encode();
-                HorusPacket::new_fragment(self.topic_name.clone(), fragment_data, *seq)
-            };
-            *seq = seq.wrapping_add(1);
-
-            // Encode packet - use pooled buffer (zero-allocation fast path)
-            let mut buffer = self.buffer_pool.get();
-            packet.encode(&mut buffer);
-
-            // Send via lock-free queue (non-blocking)
-            self.send_tx.try_send(buffer).map_err(|_| {
-                crate::error::HorusError::Communication("Send queue full".to_string())
-            })?;
-        }
+        // Fragment if needed; each packet is encoded into a pooled buffer
+        // (zero-allocation fast path) and moved onto the lock-free queue
+        let mut buffer = self.buffer_pool.get();
+        self.fragment_manager.write_packets(
+            &self.topic_name,
+            MessageType::RouterPublish,
+            &mut seq,
+            &payload,
+            &mut buffer,
+            |packet| {
+                let packet = std::mem::replace(packet, self.buffer_pool.get());
+                self.send_tx.try_send(packet).map_err(|_| {
+                    crate::error::HorusError::Communication("Send queue full".to_string())
+                })
+            },
+        )?;
+        self.buffer_pool.put(buffer);
 
         Ok(())
     }
@@ -31,10 +31,10 @@
 //! sender.send(&large_image, target)?;
 //! ```
 
-use std::collections::VecDeque;
+use crossbeam::queue::ArrayQueue;
 use std::net::SocketAddr;
 use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
-use std::sync::{Arc, Mutex};
+use std::sync::Arc;
 
 /// Configuration for smart copy behavior
 #[derive(Debug, Clone)]
@@ -205,10 +205,14 @@ impl RegisteredBuffer {
 }
 
 /// Pool of pre-allocated buffers for zero-copy operations
+///
+/// The free list is a lock-free bounded queue, so a buffer can be acquired on
+/// one thread and released on another (e.g. a receive thread staging datagrams
+/// for a node) without either side taking a lock.
 #[derive(Debug)]
 pub struct BufferPool {
     /// Available buffers
-    available: Mutex<VecDeque<RegisteredBuffer>>,
+    available: ArrayQueue<RegisteredBuffer>,
     /// Configuration
     config: SmartCopyConfig,
     /// Statistics
@@ -220,16 +224,16 @@ pub struct BufferPool {
 impl BufferPool {
     /// Create a new buffer pool
     pub fn new(config: SmartCopyConfig, stats: Arc<SmartCopyStats>) -> Self {
-        let mut available = VecDeque::with_capacity(config.pool_size);
         let pool_size = config.pool_size;
+        let available = ArrayQueue::new(pool_size.max(1));
 
         // Pre-allocate buffers
-        for i in 0..config.pool_size {
-            available.push_back(RegisteredBuffer::new(config.buffer_size, i));
+        for i in 0..pool_size {
+            let _ = available.push(RegisteredBuffer::new(config.buffer_size, i));
         }
 
         Self {
-            available: Mutex::new(available),
+            available,
             config,
             stats,
             next_id: AtomicUsize::new(pool_size),
@@ -238,21 +242,16 @@ impl BufferPool {
 
     /// Acquire a buffer from the pool
     pub fn acquire(&self) -> Option<RegisteredBuffer> {
-        let mut available = self.available.lock().ok()?;
-
-        let buffer = available.pop_front();
+        let buffer = self.available.pop();
 
         if buffer.is_some() {
-            let in_use = self.config.pool_size - available.len();
+            let in_use = self.config.pool_size.saturating_sub(self.available.len());
             self.stats.buffers_in_use.store(in_use, Ordering::Relaxed);
 
             // Update peak
-            let peak = self.stats.peak_buffers_in_use.load(Ordering::Relaxed);
-            if in_use > peak {
-                self.stats
-                    .peak_buffers_in_use
-                    .store(in_use, Ordering::Relaxed);
-            }
+            self.stats
+                .peak_buffers_in_use
+                .fetch_max(in_use, Ordering::Relaxed);
         } else {
             self.stats
                 .pool_exhausted_count
@@ -264,15 +263,16 @@ impl BufferPool {
 
     /// Release a buffer back to the pool
     pub fn release(&self, buffer: RegisteredBuffer) {
-        if let Ok(mut available) = self.available.lock() {
-            // Only return to pool if we're not over capacity
-            if available.len() < self.config.pool_size {
-                available.push_back(buffer);
-            }
+        // Only return to pool if we're not over capacity
+        let _ = self.available.push(buffer);
 
-            let in_use = self.config.pool_size.saturating_sub(available.len());
-            self.stats.buffers_in_use.store(in_use, Ordering::Relaxed);
-        }
+        let in_use = self.config.pool_size.saturating_sub(self.available.len());
+        self.stats.buffers_in_use.store(in_use, Ordering::Relaxed);
+    }
+
+    /// Whether `buffer` was pre-allocated by this pool (as opposed to overflow)
+    pub fn is_pooled(&self, buffer: &RegisteredBuffer) -> bool {
+        buffer.id() < self.config.pool_size
     }
 
     /// Allocate a new buffer (when pool is exhausted)
@@ -283,7 +283,7 @@ impl BufferPool {
 
     /// Get number of available buffers
     pub fn available_count(&self) -> usize {
-        self.available.lock().map(|a| a.len()).unwrap_or(0)
+        self.available.len()
     }
 }
 
@@ -1,4 +1,4 @@
-use crate::communication::network::fragmentation::{Fragment, FragmentManager};
+use crate::communication::network::fragmentation::FragmentManager;
 /// UDP direct backend for point-to-point network communication
 ///
 /// Provides <50μs latency for LAN communication using direct UDP sockets.
@@ -100,7 +100,7 @@ where
                                     }
                                     MessageType::Fragment => {
                                         // Decode fragment
-                                        match Fragment::decode(&packet.payload) {
+                                        match fragment_manager.decode(&packet.payload) {
                                             Ok(fragment) => {
                                                 // Try to reassemble
                                                 if let Some(complete_data) =
@@ -124,6 +124,7 @@ where
                                                             eprintln!("Deserialization error after reassembly: {}", e);
                                                         }
                                                     }
+                                                    fragment_manager.recycle(complete_data);
                                                 }
                                             }
                                             Err(e) => {
@@ -159,31 +160,22 @@ where
         // Serialize payload
         let payload = bincode::serialize(msg).map_err(|e| format!("Serialization error: {}", e))?;
 
-        // Fragment the payload if needed
-        let fragments = self.fragment_manager.fragment(&payload);
-
-        // Send fragments
+        // Fragment the payload if needed and send each packet straight from it
+        let mut buffer = Vec::with_capacity(2048);
         let mut seq = self.sequence.lock().unwrap();
-        for fragment in fragments {
-            let packet = if fragment.total == 1 {
-                // Single fragment - send as Data
-                HorusPacket::new_data(self.topic_name.clone(), fragment.data, *seq)
-            } else {
-                // Multi-fragment - send as Fragment
-                let fragment_data = fragment.encode();
-                HorusPacket::new_fragment(self.topic_name.clone(), fragment_data, *seq)
-            };
-            *seq = seq.wrapping_add(1);
-
-            // Encode packet
-            let mut buffer = Vec::with_capacity(2048);
-            packet.encode(&mut buffer);
-
-            // Send UDP packet
-            self.socket
-                .send_to(&buffer, self.remote_addr)
-                .map_err(|e| format!("UDP send error: {}", e))?;
-        }
+        self.fragment_manager.write_packets(
+            &self.topic_name,
+            MessageType::Data,
+            &mut seq,
+            &payload,
+            &mut buffer,
+            |packet| {
+                self.socket
+                    .send_to(packet, self.remote_addr)
+                    .map_err(|e| format!("UDP send error: {}", e))?;
+                Ok(())
+            },
+        )?;
         drop(seq);
 
         Ok(())
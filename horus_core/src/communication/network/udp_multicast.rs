@@ -140,6 +140,7 @@ where
                                                             eprintln!("Deserialization error after reassembly: {}", e);
                                                         }
                                                     }
+                                                    fragment_manager.recycle(complete_data);
                                                 }
                                             }
                                             Err(e) => {
@@ -201,9 +202,6 @@ where
         // Serialize payload
         let payload = bincode::serialize(msg).map_err(|e| format!("Serialization error: {}", e))?;
 
-        // Fragment the payload if needed
-        let fragments = self.fragment_manager.fragment(&payload);
-
         // Get peers
         let peers = self.peers.lock().unwrap();
         if peers.is_empty() {
@@ -212,30 +210,24 @@ where
             ));
         }
 
-        // Send each fragment to all peers
+        // Send each fragment to all peers, framed straight from the payload
+        let mut buffer = Vec::with_capacity(2048);
         let mut seq = self.sequence.lock().unwrap();
-        for fragment in fragments {
-            let packet = if fragment.total == 1 {
-                // Single fragment - send as Data
-                HorusPacket::new_data(self.topic_name.clone(), fragment.data, *seq)
-            } else {
-                // Multi-fragment - send as Fragment
-                let fragment_data = fragment.encode();
-                HorusPacket::new_fragment(self.topic_name.clone(), fragment_data, *seq)
-            };
-            *seq = seq.wrapping_add(1);
-
-            // Encode packet
-            let mut buffer = Vec::with_capacity(2048);
-            packet.encode(&mut buffer);
-
-            // Send to all peers
-            for peer_addr in peers.iter() {
-                self.socket
-                    .send_to(&buffer, peer_addr)
-                    .map_err(|e| format!("UDP send error: {}", e))?;
-            }
-        }
+        self.fragment_manager.write_packets(
+            &self.topic_name,
+            MessageType::Data,
+            &mut seq,
+            &payload,
+            &mut buffer,
+            |packet| {
+                for peer_addr in peers.iter() {
+                    self.socket
+                        .send_to(packet, peer_addr)
+                        .map_err(|e| format!("UDP send error: {}", e))?;
+                }
+                Ok(())
+            },
+        )?;
         drop(seq);
 
         Ok(())
@@ -1,9 +1,11 @@
 use crate::memory::platform::shm_logs_path;
 use memmap2::MmapMut;
 use serde::{Deserialize, Serialize};
+use std::collections::HashMap;
 use std::fs::{self, OpenOptions};
-use std::path::PathBuf;
-use std::sync::Mutex;
+use std::path::{Path, PathBuf};
+use std::ptr::NonNull;
+use std::sync::atomic::{fence, AtomicU32, AtomicU64, Ordering};
 
 /// Log entry with timestamp and metadata
 #[derive(Debug, Clone, Serialize, Deserialize)]
@@ -18,7 +20,7 @@ pub struct LogEntry {
     pub ipc_ns: u64,
 }
 
-#[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
+#[derive(Debug, Clone, Copy, Serialize, Deserialize, PartialEq)]
 pub enum LogType {
     // Node/IPC operations
     Publish,
@@ -37,168 +39,688 @@ pub enum LogType {
     TopicUnmap,
 }
 
-const MAX_LOG_ENTRIES: usize = 5000;
-const LOG_ENTRY_SIZE: usize = 512; // Fixed size per entry (serialized)
-const MAX_MESSAGE_LEN: usize = 300; // Max message string length before truncation
-const HEADER_SIZE: usize = 64; // Space for metadata (write_idx, etc.)
+impl LogType {
+    fn to_u8(&self) -> u8 {
+        match self {
+            LogType::Publish => 0,
+            LogType::Subscribe => 1,
+            LogType::Info => 2,
+            LogType::Warning => 3,
+            LogType::Error => 4,
+            LogType::Debug => 5,
+            LogType::RemoteDeploy => 6,
+            LogType::RemoteCompile => 7,
+            LogType::RemoteExecute => 8,
+            LogType::TopicRead => 9,
+            LogType::TopicWrite => 10,
+            LogType::TopicMap => 11,
+            LogType::TopicUnmap => 12,
+        }
+    }
+
+    fn from_u8(value: u8) -> Option<Self> {
+        Some(match value {
+            0 => LogType::Publish,
+            1 => LogType::Subscribe,
+            2 => LogType::Info,
+            3 => LogType::Warning,
+            4 => LogType::Error,
+            5 => LogType::Debug,
+            6 => LogType::RemoteDeploy,
+            7 => LogType::RemoteCompile,
+            8 => LogType::RemoteExecute,
+            9 => LogType::TopicRead,
+            10 => LogType::TopicWrite,
+            11 => LogType::TopicMap,
+            12 => LogType::TopicUnmap,
+            _ => return None,
+        })
+    }
+}
+
+/// Binary log record handed to `SharedLogBuffer::push_record`
+///
+/// Node and topic are IDs from `SharedLogBuffer::intern`; the timestamp is
+/// taken when the record is pushed and formatted by the reader.
+#[derive(Debug, Clone, Copy)]
+pub struct LogRecord<'a> {
+    pub log_type: LogType,
+    pub node: u32,
+    pub topic: Option<u32>,
+    pub tick_number: u64,
+    pub tick_us: u64,
+    pub ipc_ns: u64,
+    pub message: &'a str,
+}
+
+const LOG_MAGIC: u64 = 0x484F_5255_534C_4F47; // "HORUSLOG"
+const LOG_LAYOUT_VERSION: u32 = 2;
+const MAX_LOG_ENTRIES: usize = 8192; // Power of two
+const LOG_ENTRY_SIZE: usize = 384; // Fixed size per record
+const MAX_MESSAGE_LEN: usize = LOG_ENTRY_SIZE - 56; // Message bytes per record
+const INTERN_SLOTS: usize = 4096; // Power of two
+const INTERN_NAME_LEN: usize = 112; // Name bytes stored per interned string
+const HEADER_SIZE: usize = 128; // Metadata line + write index line
+
+/// ID used when a name could not be interned (table full)
+pub const UNKNOWN_NAME_ID: u32 = u32::MAX;
+
+const SLOT_EMPTY: u32 = 0;
+const SLOT_WRITING: u32 = 1;
+const SLOT_READY: u32 = 2;
+
+const FLAG_TRUNCATED: u8 = 1;
+const FLAG_HAS_TOPIC: u8 = 2;
+
+/// Ring metadata, written once when the file is created
+#[repr(C, align(64))]
+struct LogMeta {
+    magic: AtomicU64,
+    version: u32,
+    record_size: u32,
+    capacity: u32,
+    intern_slots: u32,
+    anchor_realtime_ns: u64,  // Wall clock at creation...
+    anchor_monotonic_ns: u64, // ...and the monotonic clock at the same moment
+    base: AtomicU64,          // Oldest position still visible (moved by clear)
+}
+
+/// Claim counter, on its own cache line since every writer hits it
+#[repr(C, align(64))]
+struct WriteIndex {
+    value: AtomicU64,
+}
+
+#[repr(C)]
+struct LogHeader {
+    meta: LogMeta,
+    write_idx: WriteIndex,
+}
+
+/// Interned node/topic name
+#[repr(C, align(64))]
+struct InternSlot {
+    state: AtomicU32,
+    len: u32, // Full name length (may exceed INTERN_NAME_LEN)
+    hash: u64,
+    name: [u8; INTERN_NAME_LEN],
+}
+
+/// One fixed-size log record
+///
+/// `seq` is position + 1 once the record is complete and 0 while a writer is
+/// filling it, so readers can skip records that are in flight or torn.
+#[repr(C, align(64))]
+struct RecordSlot {
+    seq: AtomicU64,
+    timestamp_ns: u64, // CLOCK_MONOTONIC
+    tick_number: u64,
+    tick_us: u64,
+    ipc_ns: u64,
+    node: u32,
+    topic: u32,
+    log_type: u8,
+    flags: u8,
+    msg_len: u16,
+    _reserved: u32,
+    message: [u8; MAX_MESSAGE_LEN],
+}
+
+const _: () = assert!(std::mem::size_of::<LogHeader>() == HEADER_SIZE);
+const _: () = assert!(std::mem::size_of::<RecordSlot>() == LOG_ENTRY_SIZE);
+const _: () = assert!(std::mem::size_of::<InternSlot>() == 128);
+
+const INTERN_OFFSET: usize = HEADER_SIZE;
+const RECORDS_OFFSET: usize = INTERN_OFFSET + INTERN_SLOTS * std::mem::size_of::<InternSlot>();
+const TOTAL_SIZE: usize = RECORDS_OFFSET + MAX_LOG_ENTRIES * LOG_ENTRY_SIZE;
 
 /// Shared memory ring buffer for logs - lock-free, cross-process
+///
+/// Writers in any process claim a record with one `fetch_add` on the shared
+/// write index and fill it in place: a raw monotonic timestamp, interned
+/// node/topic IDs and the message bytes. Nothing is formatted, allocated or
+/// locked on the write path; readers (the dashboard) resolve names and format
+/// timestamps when they read.
 pub struct SharedLogBuffer {
-    mmap: Mutex<MmapMut>,
+    _mmap: MmapMut,
+    base: NonNull<u8>,
     #[allow(dead_code)]
     path: PathBuf,
 }
 
+// Safety: all shared state is accessed through atomics or guarded by the
+// per-record sequence word; the mapping lives as long as the buffer
+unsafe impl Send for SharedLogBuffer {}
+unsafe impl Sync for SharedLogBuffer {}
+
 // Default implementation removed - use SharedLogBuffer::new()? instead
 // since initialization can fail
 
 impl SharedLogBuffer {
     pub fn new() -> crate::error::HorusResult<Self> {
         // Logs are intentionally global (not session-isolated) so dashboard can see all logs
-        let path = shm_logs_path();
+        Self::open_at(&shm_logs_path())
+    }
 
+    /// Open (or create) a log ring at `path`
+    ///
+    /// An existing ring with the current layout is attached to as-is, so
+    /// opening the buffer (e.g. from the dashboard) never wipes other
+    /// processes' logs. Files from an older layout, or from before a reboot,
+    /// are reinitialized.
+    pub fn open_at(path: &Path) -> crate::error::HorusResult<Self> {
         // Ensure parent directory exists
         if let Some(parent) = path.parent() {
             let _ = fs::create_dir_all(parent);
         }
 
-        // Calculate total size: header + ring buffer
-        let total_size = HEADER_SIZE + (MAX_LOG_ENTRIES * LOG_ENTRY_SIZE);
-
         // Create or open memory-mapped file
         let file = OpenOptions::new()
             .read(true)
             .write(true)
             .create(true)
-            .truncate(true)
-            .open(&path)?;
+            .truncate(false)
+            .open(path)?;
+
+        // Serialize initialization across processes
+        #[cfg(unix)]
+        let _lock = FileLock::exclusive(&file);
+
+        let compatible = file.metadata()?.len() == TOTAL_SIZE as u64 && {
+            let mmap = unsafe { memmap2::Mmap::map(&file) }
+                .map_err(|e| crate::error::HorusError::Memory(format!("Failed to mmap: {}", e)))?;
+            let header = unsafe { &*(mmap.as_ptr() as *const LogHeader) };
+            header.meta.magic.load(Ordering::Acquire) == LOG_MAGIC
+                && header.meta.version == LOG_LAYOUT_VERSION
+                && header.meta.anchor_monotonic_ns <= monotonic_ns()
+        };
 
-        file.set_len(total_size as u64)?;
+        if !compatible {
+            file.set_len(0)?;
+            file.set_len(TOTAL_SIZE as u64)?;
+        }
 
-        let mmap = unsafe {
+        let mut mmap = unsafe {
             MmapMut::map_mut(&file)
                 .map_err(|e| crate::error::HorusError::Memory(format!("Failed to mmap: {}", e)))?
         };
+        let base = NonNull::new(mmap.as_mut_ptr()).ok_or_else(|| {
+            crate::error::HorusError::Memory("Log buffer mapped at null".to_string())
+        })?;
+
+        let buffer = Self {
+            _mmap: mmap,
+            base,
+            path: path.to_path_buf(),
+        };
 
-        Ok(Self {
-            mmap: Mutex::new(mmap),
-            path,
-        })
+        if !compatible {
+            // Fresh zeroed file, still under the file lock
+            let header = buffer.base.as_ptr() as *mut LogHeader;
+            unsafe {
+                (*header).meta.version = LOG_LAYOUT_VERSION;
+                (*header).meta.record_size = LOG_ENTRY_SIZE as u32;
+                (*header).meta.capacity = MAX_LOG_ENTRIES as u32;
+                (*header).meta.intern_slots = INTERN_SLOTS as u32;
+                (*header).meta.anchor_monotonic_ns = monotonic_ns();
+                (*header).meta.anchor_realtime_ns = realtime_ns();
+                // Publish the layout last
+                (*header).meta.magic.store(LOG_MAGIC, Ordering::Release);
+            }
+        }
+
+        Ok(buffer)
     }
 
-    /// Push a log entry to the ring buffer (lock-free write)
-    pub fn push(&self, entry: LogEntry) {
-        let mut mmap = self.mmap.lock().unwrap();
-
-        // Read current write index from header
-        let write_idx_bytes = &mmap[0..8];
-        let write_idx = match write_idx_bytes.try_into() {
-            Ok(bytes) => u64::from_le_bytes(bytes) as usize,
-            Err(_) => {
-                eprintln!(" Failed to read log buffer index");
-                return;
+    #[inline]
+    fn header(&self) -> &LogHeader {
+        unsafe { &*(self.base.as_ptr() as *const LogHeader) }
+    }
+
+    #[inline]
+    fn intern_slot(&self, index: usize) -> *mut InternSlot {
+        unsafe {
+            (self.base.as_ptr().add(INTERN_OFFSET) as *mut InternSlot)
+                .add(index & (INTERN_SLOTS - 1))
+        }
+    }
+
+    #[inline]
+    fn record_slot(&self, position: u64) -> *mut RecordSlot {
+        let index = position as usize & (MAX_LOG_ENTRIES - 1);
+        unsafe { (self.base.as_ptr().add(RECORDS_OFFSET) as *mut RecordSlot).add(index) }
+    }
+
+    /// Get the shared ID for a node or topic name, registering it if needed
+    ///
+    /// IDs are stable for the lifetime of the ring and shared by all
+    /// processes, so callers can cache them. Returns `UNKNOWN_NAME_ID` if the
+    /// name table is full.
+    pub fn intern(&self, name: &str) -> u32 {
+        self.find_name(name, true).unwrap_or(UNKNOWN_NAME_ID)
+    }
+
+    /// ID of an already interned name, without registering it
+    pub fn lookup(&self, name: &str) -> Option<u32> {
+        self.find_name(name, false)
+    }
+
+    fn find_name(&self, name: &str, insert: bool) -> Option<u32> {
+        let hash = fnv1a(name.as_bytes());
+        let stored_len = name.len().min(INTERN_NAME_LEN);
+
+        for probe in 0..INTERN_SLOTS {
+            let index = (hash as usize).wrapping_add(probe) & (INTERN_SLOTS - 1);
+            let slot = self.intern_slot(index);
+            let state = unsafe { &(*slot).state };
+
+            let mut current = state.load(Ordering::Acquire);
+            if current == SLOT_EMPTY && !insert {
+                return None;
+            }
+            if current == SLOT_EMPTY {
+                match state.compare_exchange(
+                    SLOT_EMPTY,
+                    SLOT_WRITING,
+                    Ordering::Acquire,
+                    Ordering::Acquire,
+                ) {
+                    Ok(_) => {
+                        unsafe {
+                            (*slot).len = name.len() as u32;
+                            (*slot).hash = hash;
+                            (&mut (*slot).name)[..stored_len]
+                                .copy_from_slice(&name.as_bytes()[..stored_len]);
+                        }
+                        state.store(SLOT_READY, Ordering::Release);
+                        return Some(index as u32);
+                    }
+                    Err(actual) => current = actual,
+                }
+            }
+
+            // Another writer is registering this slot; it only takes a few stores
+            while current == SLOT_WRITING {
+                std::hint::spin_loop();
+                current = state.load(Ordering::Acquire);
             }
-        };
 
-        // Truncate message if too long (BEFORE serialization to keep metadata intact)
-        let mut entry = entry;
-        if entry.message.len() > MAX_MESSAGE_LEN {
-            entry.message.truncate(MAX_MESSAGE_LEN - 3);
-            entry.message.push_str("...");
+            let matches = unsafe {
+                (*slot).hash == hash
+                    && (*slot).len as usize == name.len()
+                    && (&(*slot).name)[..stored_len] == name.as_bytes()[..stored_len]
+            };
+            if matches {
+                return Some(index as u32);
+            }
         }
 
-        // Serialize log entry
-        let serialized = match bincode::serialize(&entry) {
-            Ok(data) if data.len() <= LOG_ENTRY_SIZE => data,
-            Ok(data) => {
-                // This should rarely happen now, but keep as safety net
-                eprintln!(" Log entry still too large ({} bytes) after message truncation - metadata too big?", data.len());
-                data[..LOG_ENTRY_SIZE].to_vec()
+        None
+    }
+
+    /// Name registered under `id`, if any
+    pub fn resolve(&self, id: u32) -> Option<String> {
+        if id as usize >= INTERN_SLOTS {
+            return None;
+        }
+        let slot = self.intern_slot(id as usize);
+        unsafe {
+            if (*slot).state.load(Ordering::Acquire) != SLOT_READY {
+                return None;
             }
-            Err(e) => {
-                eprintln!(" Failed to serialize log: {}", e);
-                return;
+            let full_len = (*slot).len as usize;
+            let stored_len = full_len.min(INTERN_NAME_LEN);
+            let mut name = String::from_utf8_lossy(&(&(*slot).name)[..stored_len]).into_owned();
+            if full_len > stored_len {
+                name.push_str("...");
             }
-        };
+            Some(name)
+        }
+    }
 
-        // Calculate position in ring buffer
-        let slot_idx = write_idx % MAX_LOG_ENTRIES;
-        let offset = HEADER_SIZE + (slot_idx * LOG_ENTRY_SIZE);
+    /// Push a binary record (lock-free, allocation-free)
+    #[inline]
+    pub fn push_record(&self, record: &LogRecord<'_>) {
+        let timestamp_ns = monotonic_ns();
+        let position = self
+            .header()
+            .write_idx
+            .value
+            .fetch_add(1, Ordering::Relaxed);
+        let slot = self.record_slot(position);
+
+        let bytes = record.message.as_bytes();
+        let mut len = bytes.len().min(MAX_MESSAGE_LEN);
+        while !record.message.is_char_boundary(len) {
+            len -= 1;
+        }
 
-        // Write log entry
-        let len = serialized.len().min(LOG_ENTRY_SIZE);
-        mmap[offset..offset + len].copy_from_slice(&serialized[..len]);
+        let mut flags = 0;
+        if len < bytes.len() {
+            flags |= FLAG_TRUNCATED;
+        }
+        if record.topic.is_some() {
+            flags |= FLAG_HAS_TOPIC;
+        }
 
-        // Clear remaining space in slot
-        if len < LOG_ENTRY_SIZE {
-            mmap[offset + len..offset + LOG_ENTRY_SIZE].fill(0);
+        unsafe {
+            // Mark in flight, then fill; readers discard the slot until seq is set
+            (*slot).seq.store(0, Ordering::Relaxed);
+            fence(Ordering::Release);
+
+            (*slot).timestamp_ns = timestamp_ns;
+            (*slot).tick_number = record.tick_number;
+            (*slot).tick_us = record.tick_us;
+            (*slot).ipc_ns = record.ipc_ns;
+            (*slot).node = record.node;
+            (*slot).topic = record.topic.unwrap_or(UNKNOWN_NAME_ID);
+            (*slot).log_type = record.log_type.to_u8();
+            (*slot).flags = flags;
+            (*slot).msg_len = len as u16;
+            (&mut (*slot).message)[..len].copy_from_slice(&bytes[..len]);
+
+            (*slot).seq.store(position + 1, Ordering::Release);
         }
+    }
 
-        // Update write index atomically
-        let new_write_idx = write_idx + 1;
-        mmap[0..8].copy_from_slice(&(new_write_idx as u64).to_le_bytes());
+    /// Push a log entry to the ring buffer (lock-free write)
+    ///
+    /// Convenience wrapper over `push_record` that interns the names on every
+    /// call; hot paths should cache IDs and call `push_record` directly. The
+    /// entry's `timestamp` string is ignored, the ring records its own.
+    pub fn push(&self, entry: LogEntry) {
+        let node = self.intern(&entry.node_name);
+        let topic = entry.topic.as_deref().map(|t| self.intern(t));
+        self.push_record(&LogRecord {
+            log_type: entry.log_type,
+            node,
+            topic,
+            tick_number: entry.tick_number,
+            tick_us: entry.tick_us,
+            ipc_ns: entry.ipc_ns,
+            message: &entry.message,
+        });
     }
 
     /// Read all logs from the ring buffer
     pub fn get_all(&self) -> Vec<LogEntry> {
-        let mmap = self.mmap.lock().unwrap();
-
-        // Read write index
-        let write_idx_bytes = &mmap[0..8];
-        let write_idx = match write_idx_bytes.try_into() {
-            Ok(bytes) => u64::from_le_bytes(bytes) as usize,
-            Err(_) => {
-                eprintln!(" Failed to read log buffer index");
-                return Vec::new();
-            }
+        self.read_filtered(|_, _| true)
+    }
+
+    /// Get logs for a specific node
+    pub fn get_for_node(&self, node_name: &str) -> Vec<LogEntry> {
+        let Some(id) = self.lookup(node_name) else {
+            return Vec::new();
+        };
+        self.read_filtered(|node, _| node == id)
+    }
+
+    /// Get logs for a specific topic
+    pub fn get_for_topic(&self, topic: &str) -> Vec<LogEntry> {
+        let Some(id) = self.lookup(topic) else {
+            return Vec::new();
         };
+        self.read_filtered(|_, t| t == Some(id))
+    }
+
+    /// Position the next record will be written at
+    pub fn write_position(&self) -> u64 {
+        self.header().write_idx.value.load(Ordering::Acquire)
+    }
+
+    /// Decode at most `max` records written since `cursor`, advancing it
+    ///
+    /// Only the new records are touched, so a reader that polls often pays
+    /// for what was logged in between rather than for the whole ring.
+    /// Records overwritten before the cursor reached them are counted in
+    /// `LogCursor::missed`.
+    ///
+    /// Reading stops at the first record a writer has claimed but not yet
+    /// committed, and the cursor stays there, so it is returned by a later
+    /// call instead of being skipped. A claimed record is only given up on
+    /// once the ring has wrapped over it.
+    pub fn read_since(&self, cursor: &mut LogCursor, max: usize) -> Vec<LogEntry> {
+        let write_idx = self.write_position();
+        if cursor.position > write_idx {
+            // Ring was recreated underneath us
+            cursor.position = 0;
+        }
+        let evicted = write_idx.saturating_sub(MAX_LOG_ENTRIES as u64);
+        if cursor.position < evicted {
+            cursor.missed += evicted - cursor.position;
+        }
+        let start = self.oldest_position(write_idx).max(cursor.position);
+        let end = write_idx.min(start.saturating_add(max as u64));
 
         let mut logs = Vec::new();
+        let (reached, overwritten) =
+            self.decode_range(start..end, &mut cursor.names, |_, _| true, &mut logs, true);
+        cursor.position = reached;
+        cursor.missed += overwritten;
+        logs
+    }
 
-        // Determine how many valid entries exist
-        let num_entries = write_idx.min(MAX_LOG_ENTRIES);
+    /// Move `cursor` to the newest record without decoding anything
+    pub fn skip_to_end(&self, cursor: &mut LogCursor) {
+        cursor.position = self.write_position();
+    }
 
-        // Read from oldest to newest
-        let start_idx = if write_idx > MAX_LOG_ENTRIES {
-            write_idx % MAX_LOG_ENTRIES
-        } else {
-            0
-        };
+    pub fn clear(&self) {
+        // Hide everything written so far; writers are unaffected
+        let write_idx = self.header().write_idx.value.load(Ordering::Acquire);
+        self.header()
+            .meta
+            .base
+            .fetch_max(write_idx, Ordering::AcqRel);
+    }
+
+    /// Oldest position still readable, given the current write index
+    fn oldest_position(&self, write_idx: u64) -> u64 {
+        write_idx
+            .saturating_sub(MAX_LOG_ENTRIES as u64)
+            .max(self.header().meta.base.load(Ordering::Acquire))
+    }
 
-        for i in 0..num_entries {
-            let slot_idx = (start_idx + i) % MAX_LOG_ENTRIES;
-            let offset = HEADER_SIZE + (slot_idx * LOG_ENTRY_SIZE);
+    /// Decode records from oldest to newest, keeping those `keep` accepts
+    fn read_filtered<F>(&self, keep: F) -> Vec<LogEntry>
+    where
+        F: Fn(u32, Option<u32>) -> bool,
+    {
+        let write_idx = self.write_position();
+        let mut logs = Vec::new();
+        self.decode_range(
+            self.oldest_position(write_idx)..write_idx,
+            &mut HashMap::new(),
+            keep,
+            &mut logs,
+            false,
+        );
+        logs
+    }
 
-            let entry_bytes = &mmap[offset..offset + LOG_ENTRY_SIZE];
+    /// Decode `positions` oldest first into `logs`
+    ///
+    /// Records that are not readable are skipped, unless
+    /// `stop_at_uncommitted` is set. In that case a record that has been
+    /// claimed but not yet committed ends the range. Returns the position
+    /// after the last record consumed and how many of them had already been
+    /// overwritten by newer ones.
+    fn decode_range<F>(
+        &self,
+        positions: std::ops::Range<u64>,
+        names: &mut HashMap<u32, String>,
+        keep: F,
+        logs: &mut Vec<LogEntry>,
+        stop_at_uncommitted: bool,
+    ) -> (u64, u64)
+    where
+        F: Fn(u32, Option<u32>) -> bool,
+    {
+        let header = self.header();
+        let anchor_mono = header.meta.anchor_monotonic_ns;
+        let anchor_real = header.meta.anchor_realtime_ns;
+        let mut name_of = |id: u32| -> String {
+            names
+                .entry(id)
+                .or_insert_with(|| self.resolve(id).unwrap_or_else(|| "?".to_string()))
+                .clone()
+        };
 
-            // Try to deserialize
-            if let Ok(entry) = bincode::deserialize::<LogEntry>(entry_bytes) {
-                logs.push(entry);
+        let mut overwritten = 0;
+        for position in positions.clone() {
+            let slot = self.record_slot(position);
+            let Some(record) = (unsafe { read_record(slot, position) }) else {
+                if !stop_at_uncommitted {
+                    continue; // In flight or overwritten
+                }
+                // The slot now belongs to a later lap only once the ring
+                // has wrapped past `position`; otherwise its writer is
+                // still filling it in
+                if position + (MAX_LOG_ENTRIES as u64) < self.write_position() {
+                    overwritten += 1;
+                    continue;
+                }
+                return (position, overwritten);
+            };
+
+            let topic = (record.flags & FLAG_HAS_TOPIC != 0).then_some(record.topic);
+            if !keep(record.node, topic) {
+                continue;
+            }
+            let Some(log_type) = LogType::from_u8(record.log_type) else {
+                continue;
+            };
+
+            let len = (record.msg_len as usize).min(MAX_MESSAGE_LEN);
+            let mut message = String::from_utf8_lossy(&record.message[..len]).into_owned();
+            if record.flags & FLAG_TRUNCATED != 0 {
+                message.push_str("...");
             }
+
+            let wall_ns = anchor_real as i128 + (record.timestamp_ns as i128 - anchor_mono as i128);
+            logs.push(LogEntry {
+                timestamp: format_timestamp(wall_ns),
+                tick_number: record.tick_number,
+                node_name: name_of(record.node),
+                log_type,
+                topic: topic.map(&mut name_of),
+                message,
+                tick_us: record.tick_us,
+                ipc_ns: record.ipc_ns,
+            });
         }
+        (positions.end, overwritten)
+    }
+}
 
-        logs
+/// Incremental read position for `SharedLogBuffer::read_since`
+///
+/// Also caches resolved node/topic names, which are stable for the lifetime
+/// of the ring.
+#[derive(Debug, Default)]
+pub struct LogCursor {
+    position: u64,
+    missed: u64,
+    names: HashMap<u32, String>,
+}
+
+impl LogCursor {
+    /// Cursor at the oldest record still in the ring
+    pub fn new() -> Self {
+        Self::default()
     }
 
-    /// Get logs for a specific node
-    pub fn get_for_node(&self, node_name: &str) -> Vec<LogEntry> {
-        self.get_all()
-            .into_iter()
-            .filter(|e| e.node_name == node_name)
-            .collect()
+    /// Position of the next record this cursor will read
+    pub fn position(&self) -> u64 {
+        self.position
     }
 
-    /// Get logs for a specific topic
-    pub fn get_for_topic(&self, topic: &str) -> Vec<LogEntry> {
-        self.get_all()
-            .into_iter()
-            .filter(|e| e.topic.as_ref().is_some_and(|t| t == topic))
-            .collect()
+    /// Records overwritten before this cursor could read them
+    pub fn missed(&self) -> u64 {
+        self.missed
     }
+}
 
-    pub fn clear(&self) {
-        let mut mmap = self.mmap.lock().unwrap();
-        mmap[0..8].fill(0); // Reset write index
+/// Copy a record out if it is complete and still holds `position`
+unsafe fn read_record(slot: *const RecordSlot, position: u64) -> Option<RecordSlot> {
+    let expected = position + 1;
+    if (*slot).seq.load(Ordering::Acquire) != expected {
+        return None;
+    }
+    let copy = std::ptr::read_volatile(slot);
+    fence(Ordering::Acquire);
+    if (*slot).seq.load(Ordering::Relaxed) != expected {
+        return None;
+    }
+    Some(copy)
+}
+
+fn format_timestamp(wall_ns: i128) -> String {
+    let secs = wall_ns.div_euclid(1_000_000_000) as i64;
+    let nanos = wall_ns.rem_euclid(1_000_000_000) as u32;
+    use chrono::TimeZone;
+    match chrono::Local.timestamp_opt(secs, nanos).single() {
+        Some(local) => local.format("%H:%M:%S%.3f").to_string(),
+        None => String::new(),
+    }
+}
+
+/// FNV-1a, stable across processes (unlike `RandomState`)
+fn fnv1a(bytes: &[u8]) -> u64 {
+    let mut hash = 0xcbf2_9ce4_8422_2325u64;
+    for &b in bytes {
+        hash ^= b as u64;
+        hash = hash.wrapping_mul(0x0000_0100_0000_01b3);
+    }
+    hash
+}
+
+/// System-wide monotonic clock in nanoseconds (comparable across processes)
+#[cfg(unix)]
+fn monotonic_ns() -> u64 {
+    let mut ts = libc::timespec {
+        tv_sec: 0,
+        tv_nsec: 0,
+    };
+    unsafe { libc::clock_gettime(libc::CLOCK_MONOTONIC, &mut ts) };
+    ts.tv_sec as u64 * 1_000_000_000 + ts.tv_nsec as u64
+}
+
+#[cfg(not(unix))]
+fn monotonic_ns() -> u64 {
+    // Process-local fallback: anchored to the wall clock at first use
+    use std::time::Instant;
+    lazy_static::lazy_static! {
+        static ref ANCHOR: (Instant, u64) = (Instant::now(), realtime_ns());
+    }
+    ANCHOR.1 + ANCHOR.0.elapsed().as_nanos() as u64
+}
+
+fn realtime_ns() -> u64 {
+    std::time::SystemTime::now()
+        .duration_since(std::time::UNIX_EPOCH)
+        .map(|d| d.as_nanos() as u64)
+        .unwrap_or(0)
+}
+
+/// Advisory whole-file lock held while the ring is (re)initialized
+#[cfg(unix)]
+struct FileLock(std::os::unix::io::RawFd);
+
+#[cfg(unix)]
+impl FileLock {
+    fn exclusive(file: &fs::File) -> Self {
+        use std::os::unix::io::AsRawFd;
+        let fd = file.as_raw_fd();
+        unsafe { libc::flock(fd, libc::LOCK_EX) };
+        Self(fd)
+    }
+}
+
+#[cfg(unix)]
+impl Drop for FileLock {
+    fn drop(&mut self) {
+        unsafe { libc::flock(self.0, libc::LOCK_UN) };
     }
 }
 
@@ -212,3 +734,263 @@ lazy_static::lazy_static! {
 pub fn publish_log(entry: LogEntry) {
     GLOBAL_LOG_BUFFER.push(entry);
 }
+
+/// Publish a binary record to the shared memory ring buffer
+#[inline]
+pub fn publish_record(record: &LogRecord<'_>) {
+    GLOBAL_LOG_BUFFER.push_record(record);
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn temp_buffer(name: &str) -> SharedLogBuffer {
+        let path = std::env::temp_dir().join(format!("horus_logs_{}_{}", name, std::process::id()));
+        let _ = fs::remove_file(&path);
+        SharedLogBuffer::open_at(&path).unwrap()
+    }
+
+    #[test]
+    fn test_records_round_trip() {
+        let logs = temp_buffer("round_trip");
+        let node = logs.intern("imu_driver");
+        let topic = logs.intern("imu/data");
+        assert_eq!(logs.intern("imu_driver"), node);
+        assert_ne!(node, topic);
+
+        for i in 0..3 {
+            logs.push_record(&LogRecord {
+                log_type: LogType::Publish,
+                node,
+                topic: Some(topic),
+                tick_number: i,
+                tick_us: 5,
+                ipc_ns: 300,
+                message: "accel=[0,0,9.8]",
+            });
+        }
+        logs.push(LogEntry {
+            timestamp: String::new(),
+            tick_number: 3,
+            node_name: "planner".to_string(),
+            log_type: LogType::Warning,
+            topic: None,
+            message: "slow tick".to_string(),
+            tick_us: 0,
+            ipc_ns: 0,
+        });
+
+        let all = logs.get_all();
+        assert_eq!(all.len(), 4);
+        assert_eq!(all[0].node_name, "imu_driver");
+        assert_eq!(all[0].topic.as_deref(), Some("imu/data"));
+        assert_eq!(all[2].tick_number, 2);
+        assert_eq!(all[3].log_type, LogType::Warning);
+        assert!(!all[3].timestamp.is_empty());
+
+        assert_eq!(logs.get_for_topic("imu/data").len(), 3);
+        assert_eq!(logs.get_for_node("planner").len(), 1);
+        assert!(logs.get_for_node("never_logged").is_empty());
+        assert_eq!(logs.lookup("never_logged"), None);
+
+        logs.clear();
+        assert!(logs.get_all().is_empty());
+    }
+
+    #[test]
+    fn test_ring_keeps_newest_and_truncates() {
+        let logs = temp_buffer("wrap");
+        let node = logs.intern("n");
+        let long = "x".repeat(MAX_MESSAGE_LEN + 10);
+
+        for i in 0..(MAX_LOG_ENTRIES as u64 + 10) {
+            logs.push_record(&LogRecord {
+                log_type: LogType::Debug,
+                node,
+                topic: None,
+                tick_number: i,
+                tick_us: 0,
+                ipc_ns: 0,
+                message: &long,
+            });
+        }
+
+        let all = logs.get_all();
+        assert_eq!(all.len(), MAX_LOG_ENTRIES);
+        assert_eq!(all[0].tick_number, 10);
+        assert_eq!(all[0].message.len(), MAX_MESSAGE_LEN + 3);
+        assert!(all[0].message.ends_with("..."));
+    }
+
+    #[test]
+    fn test_concurrent_writers() {
+        let logs = std::sync::Arc::new(temp_buffer("concurrent"));
+        let handles: Vec<_> = (0..4)
+            .map(|t| {
+                let logs = logs.clone();
+                std::thread::spawn(move || {
+                    let node = logs.intern(&format!("writer_{}", t));
+                    for i in 0..500 {
+                        logs.push_record(&LogRecord {
+                            log_type: LogType::Info,
+                            node,
+                            topic: None,
+                            tick_number: i,
+                            tick_us: 0,
+                            ipc_ns: 0,
+                            message: "tick",
+                        });
+                    }
+                })
+            })
+            .collect();
+        for h in handles {
+            h.join().unwrap();
+        }
+
+        assert_eq!(logs.get_all().len(), 2000);
+        assert_eq!(logs.get_for_node("writer_2").len(), 500);
+    }
+
+    #[test]
+    fn test_cursor_reads_only_new_records() {
+        let logs = temp_buffer("cursor");
+        let node = logs.intern("lidar");
+        let push = |i: u64| {
+            logs.push_record(&LogRecord {
+                log_type: LogType::Info,
+                node,
+                topic: None,
+                tick_number: i,
+                tick_us: 0,
+                ipc_ns: 0,
+                message: "scan",
+            })
+        };
+
+        let mut cursor = LogCursor::new();
+        for i in 0..5 {
+            push(i);
+        }
+        let first = logs.read_since(&mut cursor, 3);
+        assert_eq!(first.len(), 3);
+        assert_eq!(first[0].node_name, "lidar");
+        let rest = logs.read_since(&mut cursor, usize::MAX);
+        assert_eq!(rest.len(), 2);
+        assert_eq!(rest[1].tick_number, 4);
+        assert!(logs.read_since(&mut cursor, usize::MAX).is_empty());
+
+        // Falling a full ring behind reports the overwritten records
+        for i in 0..(MAX_LOG_ENTRIES as u64 + 7) {
+            push(i);
+        }
+        let caught_up = logs.read_since(&mut cursor, usize::MAX);
+        assert_eq!(caught_up.len(), MAX_LOG_ENTRIES);
+        assert_eq!(cursor.missed(), 7);
+
+        push(0);
+        logs.skip_to_end(&mut cursor);
+        assert!(logs.read_since(&mut cursor, usize::MAX).is_empty());
+        assert_eq!(cursor.position(), logs.write_position());
+    }
+
+    #[test]
+    fn test_cursor_waits_for_claimed_record() {
+        let logs = temp_buffer("claimed");
+        let node = logs.intern("camera");
+        let push = |i: u64| {
+            logs.push_record(&LogRecord {
+                log_type: LogType::Info,
+                node,
+                topic: None,
+                tick_number: i,
+                tick_us: 0,
+                ipc_ns: 0,
+                message: "frame",
+            })
+        };
+
+        push(0);
+        // A writer claims position 1 and has not committed it yet
+        let claimed = logs
+            .header()
+            .write_idx
+            .value
+            .fetch_add(1, Ordering::Relaxed);
+        push(2);
+
+        let mut cursor = LogCursor::new();
+        let first = logs.read_since(&mut cursor, usize::MAX);
+        assert_eq!(first.len(), 1);
+        assert_eq!(cursor.position(), claimed);
+
+        unsafe {
+            let slot = logs.record_slot(claimed);
+            (*slot).node = node;
+            (*slot).tick_number = 1;
+            (*slot).log_type = LogType::Info.to_u8();
+            (*slot).seq.store(claimed + 1, Ordering::Release);
+        }
+        let rest = logs.read_since(&mut cursor, usize::MAX);
+        let ticks: Vec<u64> = rest.iter().map(|e| e.tick_number).collect();
+        assert_eq!(ticks, [1, 2]);
+        assert_eq!(cursor.missed(), 0);
+    }
+
+    #[test]
+    fn test_cursor_has_no_gaps_with_concurrent_writers() {
+        const WRITERS: u64 = 8;
+        const PER_WRITER: u64 = 1000; // Stays within one ring, so nothing is evicted
+
+        let logs = std::sync::Arc::new(temp_buffer("cursor_concurrent"));
+        let writers: Vec<_> = (0..WRITERS)
+            .map(|t| {
+                let logs = logs.clone();
+                std::thread::spawn(move || {
+                    let node = logs.intern(&format!("writer_{}", t));
+                    // Full-length messages keep each record in flight longer
+                    let message = "x".repeat(MAX_MESSAGE_LEN);
+                    for i in 0..PER_WRITER {
+                        logs.push_record(&LogRecord {
+                            log_type: LogType::Info,
+                            node,
+                            topic: None,
+                            tick_number: i,
+                            tick_us: 0,
+                            ipc_ns: 0,
+                            message: &message,
+                        });
+                    }
+                })
+            })
+            .collect();
+
+        let mut cursor = LogCursor::new();
+        let mut next: HashMap<String, u64> = HashMap::new();
+        let mut check = |entries: Vec<LogEntry>| {
+            for entry in entries {
+                let expected = next.entry(entry.node_name.clone()).or_insert(0);
+                assert_eq!(
+                    entry.tick_number, *expected,
+                    "Gap in records from {}",
+                    entry.node_name
+                );
+                *expected += 1;
+            }
+        };
+        // Poll while the writers are running, then drain what is left
+        while !writers.iter().all(|w| w.is_finished()) {
+            check(logs.read_since(&mut cursor, 8));
+        }
+        for writer in writers {
+            writer.join().unwrap();
+        }
+        check(logs.read_since(&mut cursor, usize::MAX));
+
+        assert_eq!(cursor.position(), logs.write_position());
+        assert_eq!(cursor.missed(), 0);
+        assert_eq!(next.len(), WRITERS as usize);
+        assert!(next.values().all(|&n| n == PER_WRITER));
+    }
+}
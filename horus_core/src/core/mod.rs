@@ -19,8 +19,9 @@ pub mod log_buffer;
 pub mod node;
 pub mod node_info_ext;
 pub mod rt_node;
+pub mod tick_arena;
 
-pub use log_buffer::{LogEntry, LogType, SharedLogBuffer, GLOBAL_LOG_BUFFER};
+pub use log_buffer::{LogCursor, LogEntry, LogRecord, LogType, SharedLogBuffer, GLOBAL_LOG_BUFFER};
 pub use node::{
     HealthStatus, LogSummary, NetworkStatus, Node, NodeConfig, NodeHeartbeat, NodeInfo,
     NodeMetrics, NodeState, TopicMetadata,
@@ -29,3 +30,4 @@ pub use node_info_ext::NodeInfoExt;
 pub use rt_node::{
     DeadlineMissPolicy, RTClass, RTNode, RTNodeWrapper, RTPriority, RTStats, WCETViolation,
 };
+pub use tick_arena::TickArena;
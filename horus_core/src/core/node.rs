@@ -1,3 +1,4 @@
+use super::tick_arena::TickArena;
 use crate::memory::platform::shm_heartbeats_dir;
 use crate::params::RuntimeParams;
 use std::collections::HashMap;
@@ -411,6 +412,14 @@ pub struct NodeInfo {
     registered_publishers: HashMap<String, String>, // topic_name -> type_name
     registered_subscribers: HashMap<String, String>, // topic_name -> type_name
 
+    // Shared log ring name IDs, interned on first use
+    log_node_id: Option<u32>,
+    log_topic_ids: HashMap<String, u32>,
+
+    // Scratch memory for the current tick, reset by the scheduler
+    arena: Arc<TickArena>,
+    arena_resets_skipped: u64,
+
     // Debugging
     custom_data: HashMap<String, String>,
 
@@ -459,6 +468,10 @@ impl NodeInfo {
             subscribed_topics: HashMap::new(),
             registered_publishers: HashMap::new(),
             registered_subscribers: HashMap::new(),
+            log_node_id: None,
+            log_topic_ids: HashMap::new(),
+            arena: Arc::new(TickArena::new()),
+            arena_resets_skipped: 0,
             custom_data: HashMap::new(),
             metrics_lock: Arc::new(Mutex::new(())),
             params: RuntimeParams::default(),
@@ -672,6 +685,11 @@ impl NodeInfo {
             .collect()
     }
 
+    /// Number of topics registered via `register_subscriber`
+    pub fn registered_subscriber_count(&self) -> usize {
+        self.registered_subscribers.len()
+    }
+
     /// Get all registered subscribers (topic_name -> type_name)
     pub fn get_registered_subscribers(&self) -> Vec<TopicMetadata> {
         self.registered_subscribers
@@ -695,10 +713,29 @@ impl NodeInfo {
         self.log_sub_summary(topic, &summary, ipc_ns);
     }
 
+    /// Shared log ring IDs for this node and `topic`
+    ///
+    /// Interned once and cached, so steady-state pub/sub logging does no
+    /// hashing into shared memory and no allocation.
+    fn log_ids(&mut self, topic: &str) -> (u32, u32) {
+        use crate::core::log_buffer::GLOBAL_LOG_BUFFER;
+        let node = *self
+            .log_node_id
+            .get_or_insert_with(|| GLOBAL_LOG_BUFFER.intern(&self.name));
+        let topic = match self.log_topic_ids.get(topic) {
+            Some(&id) => id,
+            None => {
+                let id = GLOBAL_LOG_BUFFER.intern(topic);
+                self.log_topic_ids.insert(topic.to_string(), id);
+                id
+            }
+        };
+        (node, topic)
+    }
+
     /// Internal logging method that accepts a pre-computed summary string
     /// Used by Hub::send() to avoid needing message reference after move
     pub fn log_pub_summary(&mut self, topic: &str, summary: &str, ipc_ns: u64) {
-        let now = chrono::Local::now();
         let current_tick_us = if let Some(start_time) = self.tick_start_time {
             start_time.elapsed().as_micros() as u64
         } else {
@@ -706,6 +743,7 @@ impl NodeInfo {
         };
 
         if self.config.enable_logging {
+            let now = chrono::Local::now();
             // Color-coded logging for readability
             // Cyan timestamp | Green metrics | Blue tick# | Yellow node | Bold Green PUB arrow | Magenta topic | White data
             print!("\r\n\x1b[36m[{}]\x1b[0m \x1b[32m[IPC: {}ns | Tick: {}μs]\x1b[0m \x1b[34m[#{}]\x1b[0m \x1b[33m{}\x1b[0m \x1b[1;32m--PUB-->\x1b[0m \x1b[35m'{}'\x1b[0m = {}\r\n",
@@ -718,27 +756,31 @@ impl NodeInfo {
             let _ = io::stdout().flush();
         }
 
-        // Write to global log buffer and publish to system/logs topic
-        use crate::core::log_buffer::{publish_log, LogEntry, LogType};
-        publish_log(LogEntry {
-            timestamp: now.format("%H:%M:%S%.3f").to_string(),
-            tick_number: self.metrics.total_ticks,
-            node_name: self.name.clone(),
+        // Write a binary record to the global log ring (formatted by the reader)
+        use crate::core::log_buffer::{publish_record, LogRecord, LogType};
+        let (node, topic_id) = self.log_ids(topic);
+        publish_record(&LogRecord {
             log_type: LogType::Publish,
-            topic: Some(topic.to_string()),
-            message: summary.to_string(),
+            node,
+            topic: Some(topic_id),
+            tick_number: self.metrics.total_ticks,
             tick_us: current_tick_us,
             ipc_ns,
+            message: summary,
         });
 
-        *self.published_topics.entry(topic.to_string()).or_insert(0) += 1;
+        match self.published_topics.get_mut(topic) {
+            Some(count) => *count += 1,
+            None => {
+                self.published_topics.insert(topic.to_string(), 1);
+            }
+        }
         self.metrics.messages_sent += 1;
     }
 
     /// Internal logging method that accepts a pre-computed summary string
     /// Used by Hub::recv() to avoid needing message reference after move
     pub fn log_sub_summary(&mut self, topic: &str, summary: &str, ipc_ns: u64) {
-        let now = chrono::Local::now();
         let current_tick_us = if let Some(start_time) = self.tick_start_time {
             start_time.elapsed().as_micros() as u64
         } else {
@@ -749,6 +791,7 @@ impl NodeInfo {
         let display_tick = self.metrics.total_ticks;
 
         if self.config.enable_logging {
+            let now = chrono::Local::now();
             // Color-coded logging for readability
             // Cyan timestamp | Green metrics | Blue tick# | Yellow node | Bold Blue SUB arrow | Magenta topic | White data
             println!("\x1b[36m[{}]\x1b[0m \x1b[32m[IPC: {}ns | Tick: {}μs]\x1b[0m \x1b[34m[#{}]\x1b[0m \x1b[33m{}\x1b[0m \x1b[1;34m<--SUB--\x1b[0m \x1b[35m'{}'\x1b[0m = {}",
@@ -761,25 +804,29 @@ impl NodeInfo {
             let _ = io::stdout().flush();
         }
 
-        // Write to global log buffer and publish to system/logs topic
-        use crate::core::log_buffer::{publish_log, LogEntry, LogType};
-        publish_log(LogEntry {
-            timestamp: now.format("%H:%M:%S%.3f").to_string(),
-            tick_number: display_tick,
-            node_name: self.name.clone(),
+        // Write a binary record to the global log ring (formatted by the reader)
+        use crate::core::log_buffer::{publish_record, LogRecord, LogType};
+        let (node, topic_id) = self.log_ids(topic);
+        publish_record(&LogRecord {
             log_type: LogType::Subscribe,
-            topic: Some(topic.to_string()),
-            message: summary.to_string(),
+            node,
+            topic: Some(topic_id),
+            tick_number: display_tick,
             tick_us: current_tick_us,
             ipc_ns,
+            message: summary,
         });
 
-        *self.subscribed_topics.entry(topic.to_string()).or_insert(0) += 1;
+        match self.subscribed_topics.get_mut(topic) {
+            Some(count) => *count += 1,
+            None => {
+                self.subscribed_topics.insert(topic.to_string(), 1);
+            }
+        }
         self.metrics.messages_received += 1;
     }
 
     pub fn log_info(&self, message: &str) {
-        let now = chrono::Local::now();
         let current_tick_us = if let Some(start_time) = self.tick_start_time {
             start_time.elapsed().as_micros() as u64
         } else {
@@ -796,21 +843,21 @@ impl NodeInfo {
         }
 
         // Write to global log buffer for dashboard
-        use crate::core::log_buffer::{publish_log, LogEntry, LogType};
-        publish_log(LogEntry {
-            timestamp: now.format("%H:%M:%S%.3f").to_string(),
-            tick_number: self.metrics.total_ticks,
-            node_name: self.name.clone(),
+        use crate::core::log_buffer::{publish_record, LogRecord, LogType, GLOBAL_LOG_BUFFER};
+        publish_record(&LogRecord {
             log_type: LogType::Info,
+            node: self
+                .log_node_id
+                .unwrap_or_else(|| GLOBAL_LOG_BUFFER.intern(&self.name)),
             topic: None,
-            message: message.to_string(),
+            tick_number: self.metrics.total_ticks,
             tick_us: current_tick_us,
             ipc_ns: 0,
+            message,
         });
     }
 
     pub fn log_warning(&mut self, message: &str) {
-        let now = chrono::Local::now();
         let current_tick_us = if let Some(start_time) = self.tick_start_time {
             start_time.elapsed().as_micros() as u64
         } else {
@@ -829,16 +876,17 @@ impl NodeInfo {
         }
 
         // Write to global log buffer for dashboard
-        use crate::core::log_buffer::{publish_log, LogEntry, LogType};
-        publish_log(LogEntry {
-            timestamp: now.format("%H:%M:%S%.3f").to_string(),
-            tick_number: self.metrics.total_ticks,
-            node_name: self.name.clone(),
+        use crate::core::log_buffer::{publish_record, LogRecord, LogType, GLOBAL_LOG_BUFFER};
+        publish_record(&LogRecord {
             log_type: LogType::Warning,
+            node: self
+                .log_node_id
+                .unwrap_or_else(|| GLOBAL_LOG_BUFFER.intern(&self.name)),
             topic: None,
-            message: message.to_string(),
+            tick_number: self.metrics.total_ticks,
             tick_us: current_tick_us,
             ipc_ns: 0,
+            message,
         });
 
         self.warning_history
@@ -850,7 +898,6 @@ impl NodeInfo {
     }
 
     pub fn log_error(&mut self, message: &str) {
-        let now = chrono::Local::now();
         let current_tick_us = if let Some(start_time) = self.tick_start_time {
             start_time.elapsed().as_micros() as u64
         } else {
@@ -869,16 +916,17 @@ impl NodeInfo {
         }
 
         // Write to global log buffer for dashboard
-        use crate::core::log_buffer::{publish_log, LogEntry, LogType};
-        publish_log(LogEntry {
-            timestamp: now.format("%H:%M:%S%.3f").to_string(),
-            tick_number: self.metrics.total_ticks,
-            node_name: self.name.clone(),
+        use crate::core::log_buffer::{publish_record, LogRecord, LogType, GLOBAL_LOG_BUFFER};
+        publish_record(&LogRecord {
             log_type: LogType::Error,
+            node: self
+                .log_node_id
+                .unwrap_or_else(|| GLOBAL_LOG_BUFFER.intern(&self.name)),
             topic: None,
-            message: message.to_string(),
+            tick_number: self.metrics.total_ticks,
             tick_us: current_tick_us,
             ipc_ns: 0,
+            message,
         });
 
         self.error_history
@@ -890,7 +938,6 @@ impl NodeInfo {
     }
 
     pub fn log_debug(&mut self, message: &str) {
-        let now = chrono::Local::now();
         let current_tick_us = if let Some(start_time) = self.tick_start_time {
             start_time.elapsed().as_micros() as u64
         } else {
@@ -909,16 +956,17 @@ impl NodeInfo {
         }
 
         // Write to global log buffer for dashboard
-        use crate::core::log_buffer::{publish_log, LogEntry, LogType};
-        publish_log(LogEntry {
-            timestamp: now.format("%H:%M:%S%.3f").to_string(),
-            tick_number: self.metrics.total_ticks,
-            node_name: self.name.clone(),
+        use crate::core::log_buffer::{publish_record, LogRecord, LogType, GLOBAL_LOG_BUFFER};
+        publish_record(&LogRecord {
             log_type: LogType::Debug,
+            node: self
+                .log_node_id
+                .unwrap_or_else(|| GLOBAL_LOG_BUFFER.intern(&self.name)),
             topic: None,
-            message: message.to_string(),
+            tick_number: self.metrics.total_ticks,
             tick_us: current_tick_us,
             ipc_ns: 0,
+            message,
         });
     }
 
@@ -989,6 +1037,43 @@ impl NodeInfo {
         self.config.enable_logging
     }
 
+    /// Bump arena for allocation-free scratch data during `tick`
+    ///
+    /// Everything allocated in it is released when the tick returns. Keep
+    /// the handle local to the tick: while a clone is held elsewhere the
+    /// scheduler cannot reset the arena, so its heap spills are never freed.
+    /// Such resets are counted in `arena_resets_skipped` and logged once.
+    pub fn arena(&self) -> Arc<TickArena> {
+        Arc::clone(&self.arena)
+    }
+
+    /// Pre-size the tick arena, e.g. from `init`, so no tick spills to the heap
+    pub fn reserve_arena(&mut self, bytes: usize) {
+        if let Some(arena) = Arc::get_mut(&mut self.arena) {
+            arena.reserve(bytes);
+        }
+    }
+
+    /// Release the tick arena's allocations (called after every tick)
+    pub fn reset_arena(&mut self) {
+        if let Some(arena) = Arc::get_mut(&mut self.arena) {
+            arena.reset();
+            return;
+        }
+        if self.arena_resets_skipped == 0 {
+            log::warn!(
+                "Node '{}' kept its tick arena past the tick; the arena cannot be reset and its spilled allocations will accumulate",
+                self.name
+            );
+        }
+        self.arena_resets_skipped += 1;
+    }
+
+    /// Resets skipped because the tick arena was still shared
+    pub fn arena_resets_skipped(&self) -> u64 {
+        self.arena_resets_skipped
+    }
+
     // Custom data management
     pub fn set_custom_data(&mut self, key: String, value: String) {
         self.custom_data.insert(key, value);
@@ -1111,6 +1196,59 @@ pub trait Node: Send {
     fn get_jit_arithmetic_params(&self) -> Option<(i64, i64)> {
         None
     }
+
+    /// Describe this node's tick as an f64 dataflow graph.
+    ///
+    /// Once the learning phase classifies the node as ultra-fast, the
+    /// scheduler compiles the graph to native code and replaces `tick()` with
+    /// `jit_read_inputs` → kernel → `jit_write_outputs`. A linear chain of
+    /// such nodes (each one's single output topic consumed only by the next)
+    /// that was registered with `Scheduler::fuse_dataflow_chain` is fused
+    /// into one kernel: inner nodes stop ticking and intermediates never go
+    /// through a Hub. `tick()` must compute the same thing, since it runs
+    /// until then.
+    ///
+    /// # Example
+    /// ```ignore
+    /// fn get_jit_dataflow(&self) -> Option<DataflowGraph> {
+    ///     let mut g = DataflowGraph::new(2);
+    ///     let (setpoint, feedback) = (g.input(0), g.input(1));
+    ///     let out = g.pid(setpoint, feedback, &self.params);
+    ///     g.output(out);
+    ///     Some(g)
+    /// }
+    /// ```
+    fn get_jit_dataflow(&self) -> Option<crate::scheduling::jit::DataflowGraph> {
+        None
+    }
+
+    /// Fill the dataflow inputs when this node heads a (fused) kernel.
+    /// Return false when there is no new input; the kernel is skipped.
+    fn jit_read_inputs(&mut self, _inputs: &mut [f64]) -> bool {
+        false
+    }
+
+    /// Publish the dataflow outputs when this node ends a (fused) kernel.
+    fn jit_write_outputs(&mut self, _outputs: &[f64]) {}
+
+    /// State to include in the next incremental checkpoint
+    ///
+    /// Called at every checkpoint on the scheduler thread. Return `None` if
+    /// nothing changed since the last call; the stored state stays current.
+    /// Keep large state in an `Arc` updated with `Arc::make_mut` and return a
+    /// clone, so this is O(1) and serialization happens on the writer thread.
+    ///
+    /// # Example
+    /// ```ignore
+    /// fn checkpoint_state(&mut self) -> Option<Arc<dyn CheckpointState>> {
+    ///     std::mem::take(&mut self.map_dirty).then(|| self.map.clone() as _)
+    /// }
+    /// ```
+    fn checkpoint_state(
+        &mut self,
+    ) -> Option<Arc<dyn crate::scheduling::checkpoint::CheckpointState>> {
+        None
+    }
 }
 
 // LogSummary implementations for primitive types
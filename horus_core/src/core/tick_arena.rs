@@ -0,0 +1,365 @@
+//! Per-tick bump arena for node scratch data
+//!
+//! Each `NodeInfo` owns a `TickArena` that the scheduler resets after every
+//! tick, so formatted strings, scratch slices and small temporaries can be
+//! built inside `tick` without touching the global allocator. Allocation is
+//! a single atomic bump; when a tick needs more than the arena holds, the
+//! excess spills to the heap and the next reset grows the arena to the
+//! observed peak, so a node with steady-state usage stops allocating after
+//! its first ticks (or immediately, if sized with `reserve` in `init`).
+
+use std::alloc::{self, Layout};
+use std::fmt::{self, Write};
+use std::ptr::NonNull;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::Mutex;
+
+/// Alignment of the arena's backing buffer
+const BASE_ALIGN: usize = 64;
+
+/// Bump allocator reset once per tick
+///
+/// Only `Copy` values are accepted, since nothing is dropped on reset.
+/// References handed out borrow the arena, and `reset` needs `&mut`, so
+/// they cannot outlive the tick.
+///
+/// # Example
+/// ```no_run
+/// # use horus_core::core::NodeInfo;
+/// # fn tick(ctx: &mut NodeInfo, speed: f64) {
+/// let arena = ctx.arena();
+/// let line = arena.format(format_args!("speed={:.2}", speed));
+/// ctx.log_info(line);
+/// # }
+/// ```
+pub struct TickArena {
+    base: Option<NonNull<u8>>,
+    capacity: usize,
+    offset: AtomicUsize,
+    /// Bytes that did not fit and went to the heap this tick
+    spilled_bytes: AtomicUsize,
+    spilled: Mutex<Vec<(NonNull<u8>, Layout)>>,
+    peak: usize,
+}
+
+// SAFETY: every allocation is a disjoint range claimed by an atomic bump (or
+// a separate heap block under the mutex), and the buffer is only reused by
+// `reset`, which takes `&mut self`.
+unsafe impl Send for TickArena {}
+unsafe impl Sync for TickArena {}
+
+impl TickArena {
+    /// Empty arena; the buffer is created by the first `reserve` or reset
+    pub const fn new() -> Self {
+        Self {
+            base: None,
+            capacity: 0,
+            offset: AtomicUsize::new(0),
+            spilled_bytes: AtomicUsize::new(0),
+            spilled: Mutex::new(Vec::new()),
+            peak: 0,
+        }
+    }
+
+    /// Arena with `bytes` of backing buffer
+    pub fn with_capacity(bytes: usize) -> Self {
+        let mut arena = Self::new();
+        arena.reserve(bytes);
+        arena
+    }
+
+    /// Grow the backing buffer to at least `bytes`
+    ///
+    /// Releases everything allocated so far.
+    pub fn reserve(&mut self, bytes: usize) {
+        self.reset();
+        if bytes <= self.capacity {
+            return;
+        }
+        self.free_base();
+        let layout = Layout::from_size_align(bytes, BASE_ALIGN).expect("arena size overflow");
+        // SAFETY: `bytes > capacity >= 0`, so the layout is non-zero
+        let ptr = unsafe { alloc::alloc(layout) };
+        let Some(base) = NonNull::new(ptr) else {
+            alloc::handle_alloc_error(layout);
+        };
+        self.base = Some(base);
+        self.capacity = bytes;
+    }
+
+    /// Release this tick's allocations
+    ///
+    /// Grows the buffer to cover the tick's peak if anything spilled.
+    pub fn reset(&mut self) {
+        let used = *self.offset.get_mut() + *self.spilled_bytes.get_mut();
+        self.peak = self.peak.max(used);
+        *self.offset.get_mut() = 0;
+        *self.spilled_bytes.get_mut() = 0;
+
+        let spilled = self.spilled.get_mut().unwrap_or_else(|e| e.into_inner());
+        if spilled.is_empty() {
+            return;
+        }
+        for (ptr, layout) in spilled.drain(..) {
+            // SAFETY: allocated in `alloc_spill` with this layout
+            unsafe { alloc::dealloc(ptr.as_ptr(), layout) };
+        }
+        let target = self.peak.next_power_of_two().max(1024);
+        self.reserve(target);
+    }
+
+    /// Bytes allocated this tick
+    pub fn used(&self) -> usize {
+        self.offset.load(Ordering::Relaxed).min(self.capacity)
+            + self.spilled_bytes.load(Ordering::Relaxed)
+    }
+
+    /// Size of the backing buffer
+    pub fn capacity(&self) -> usize {
+        self.capacity
+    }
+
+    /// Most bytes used by any finished tick
+    pub fn peak(&self) -> usize {
+        self.peak
+    }
+
+    /// Whether an allocation this tick had to fall back to the heap
+    pub fn spilled(&self) -> bool {
+        self.spilled_bytes.load(Ordering::Relaxed) > 0
+    }
+
+    /// Move `value` into the arena
+    #[allow(clippy::mut_from_ref)]
+    pub fn alloc<T: Copy>(&self, value: T) -> &mut T {
+        let ptr = self.alloc_layout(Layout::new::<T>()).cast::<T>();
+        // SAFETY: fresh, aligned, exclusively owned memory for one T
+        unsafe {
+            ptr.as_ptr().write(value);
+            &mut *ptr.as_ptr()
+        }
+    }
+
+    /// Slice of `len` copies of `value`
+    #[allow(clippy::mut_from_ref)]
+    pub fn alloc_slice_fill<T: Copy>(&self, len: usize, value: T) -> &mut [T] {
+        let layout = Layout::array::<T>(len).expect("arena slice overflow");
+        let ptr = self.alloc_layout(layout).cast::<T>();
+        // SAFETY: fresh, aligned memory for `len` Ts, each initialized below
+        unsafe {
+            for i in 0..len {
+                ptr.as_ptr().add(i).write(value);
+            }
+            std::slice::from_raw_parts_mut(ptr.as_ptr(), len)
+        }
+    }
+
+    /// Copy of `src`
+    #[allow(clippy::mut_from_ref)]
+    pub fn alloc_slice_copy<T: Copy>(&self, src: &[T]) -> &mut [T] {
+        let layout = Layout::array::<T>(src.len()).expect("arena slice overflow");
+        let ptr = self.alloc_layout(layout).cast::<T>();
+        // SAFETY: fresh, aligned memory for `src.len()` Ts, fully overwritten
+        unsafe {
+            ptr.as_ptr()
+                .copy_from_nonoverlapping(src.as_ptr(), src.len());
+            std::slice::from_raw_parts_mut(ptr.as_ptr(), src.len())
+        }
+    }
+
+    /// Copy of `s`
+    pub fn alloc_str(&self, s: &str) -> &str {
+        let bytes = self.alloc_slice_copy(s.as_bytes());
+        // SAFETY: copied from a valid str
+        unsafe { std::str::from_utf8_unchecked(bytes) }
+    }
+
+    /// Format into the arena, like `format!` without the `String`
+    ///
+    /// Formats twice: once to measure, once to write.
+    pub fn format(&self, args: fmt::Arguments<'_>) -> &str {
+        if let Some(s) = args.as_str() {
+            return self.alloc_str(s);
+        }
+        let mut counter = Counter(0);
+        let _ = counter.write_fmt(args);
+        let buf = self.alloc_slice_fill(counter.0, 0u8);
+        let mut writer = SliceWriter { buf, len: 0 };
+        let _ = writer.write_fmt(args);
+        let SliceWriter { buf, len } = writer;
+        // SAFETY: only whole `str`s are copied in by `write_str`
+        unsafe { std::str::from_utf8_unchecked(&buf[..len]) }
+    }
+
+    fn alloc_layout(&self, layout: Layout) -> NonNull<u8> {
+        if layout.size() == 0 {
+            // SAFETY: alignments are non-zero
+            return unsafe { NonNull::new_unchecked(layout.align() as *mut u8) };
+        }
+        if let Some(base) = self.base {
+            let addr = base.as_ptr() as usize;
+            let mut offset = self.offset.load(Ordering::Relaxed);
+            loop {
+                let start = (addr + offset).next_multiple_of(layout.align()) - addr;
+                let end = start + layout.size();
+                if end > self.capacity {
+                    break;
+                }
+                match self.offset.compare_exchange_weak(
+                    offset,
+                    end,
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    // SAFETY: `start < capacity`, inside the buffer
+                    Ok(_) => return unsafe { NonNull::new_unchecked(base.as_ptr().add(start)) },
+                    Err(current) => offset = current,
+                }
+            }
+        }
+        self.alloc_spill(layout)
+    }
+
+    #[cold]
+    fn alloc_spill(&self, layout: Layout) -> NonNull<u8> {
+        // SAFETY: `layout` has a non-zero size
+        let ptr = unsafe { alloc::alloc(layout) };
+        let Some(ptr) = NonNull::new(ptr) else {
+            alloc::handle_alloc_error(layout);
+        };
+        self.spilled
+            .lock()
+            .unwrap_or_else(|e| e.into_inner())
+            .push((ptr, layout));
+        self.spilled_bytes
+            .fetch_add(layout.size() + layout.align(), Ordering::Relaxed);
+        ptr
+    }
+
+    fn free_base(&mut self) {
+        if let Some(base) = self.base.take() {
+            // SAFETY: allocated in `reserve` with this layout
+            unsafe {
+                alloc::dealloc(
+                    base.as_ptr(),
+                    Layout::from_size_align_unchecked(self.capacity, BASE_ALIGN),
+                )
+            };
+            self.capacity = 0;
+        }
+    }
+}
+
+impl Default for TickArena {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for TickArena {
+    fn drop(&mut self) {
+        for (ptr, layout) in self
+            .spilled
+            .get_mut()
+            .unwrap_or_else(|e| e.into_inner())
+            .drain(..)
+        {
+            // SAFETY: allocated in `alloc_spill` with this layout
+            unsafe { alloc::dealloc(ptr.as_ptr(), layout) };
+        }
+        self.free_base();
+    }
+}
+
+impl fmt::Debug for TickArena {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("TickArena")
+            .field("used", &self.used())
+            .field("capacity", &self.capacity)
+            .field("peak", &self.peak)
+            .finish()
+    }
+}
+
+/// Measures formatted length
+struct Counter(usize);
+
+impl Write for Counter {
+    fn write_str(&mut self, s: &str) -> fmt::Result {
+        self.0 += s.len();
+        Ok(())
+    }
+}
+
+/// Writes formatted text into a fixed buffer, dropping what does not fit
+struct SliceWriter<'a> {
+    buf: &'a mut [u8],
+    len: usize,
+}
+
+impl Write for SliceWriter<'_> {
+    fn write_str(&mut self, s: &str) -> fmt::Result {
+        let end = self.len + s.len();
+        if end > self.buf.len() {
+            return Err(fmt::Error);
+        }
+        self.buf[self.len..end].copy_from_slice(s.as_bytes());
+        self.len = end;
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_alloc_and_reset() {
+        let mut arena = TickArena::with_capacity(256);
+        {
+            let a = arena.alloc(7u64);
+            let b = arena.alloc_slice_copy(&[1.0f32, 2.0, 3.0]);
+            *a += 1;
+            b[0] = 9.0;
+            assert_eq!(*a, 8);
+            assert_eq!(b, &[9.0, 2.0, 3.0]);
+            assert_eq!(arena.format(format_args!("x={} y={}", 1, 2.5)), "x=1 y=2.5");
+            assert_eq!(arena.alloc_str("static"), "static");
+            assert!(!arena.spilled());
+        }
+        assert!(arena.used() > 0);
+        arena.reset();
+        assert_eq!(arena.used(), 0);
+        assert_eq!(arena.capacity(), 256);
+    }
+
+    #[test]
+    fn test_spill_grows_to_peak() {
+        let mut arena = TickArena::new();
+        for len in [100usize, 3000] {
+            let slice = arena.alloc_slice_fill(len, 0xABu8);
+            assert!(slice.iter().all(|&b| b == 0xAB));
+        }
+        assert!(arena.spilled());
+        arena.reset();
+        assert!(arena.capacity() >= 3100);
+
+        // The same workload now fits
+        arena.alloc_slice_fill(100, 0u8);
+        arena.alloc_slice_fill(3000, 0u8);
+        assert!(!arena.spilled());
+    }
+
+    #[test]
+    fn test_alignment() {
+        #[derive(Clone, Copy)]
+        #[repr(align(32))]
+        struct Aligned(u8);
+
+        let arena = TickArena::with_capacity(512);
+        arena.alloc(1u8);
+        let a = arena.alloc(Aligned(3));
+        assert_eq!(a as *mut Aligned as usize % 32, 0);
+        assert_eq!(a.0, 3);
+    }
+}
@@ -48,7 +48,7 @@ pub use core::{
     TopicMetadata,
 };
 pub use error::{HorusError, HorusResult};
-pub use params::RuntimeParams;
+pub use params::{ParamHandle, RuntimeParams};
 pub use scheduling::Scheduler;
 
 // Re-export communication traits for backend-agnostic usage
@@ -0,0 +1,315 @@
+//! Lock-free fixed-block pool with per-core free lists
+//!
+//! All blocks are carved out of one slab allocated (and prefaulted) up
+//! front, so acquiring and releasing never touch the global allocator. Each
+//! CPU has its own free list; `acquire` pops from the current CPU's list and
+//! only steals from other CPUs when it is empty, so nodes pinned to separate
+//! cores do not contend. Blocks return to the list of the CPU they came from.
+//!
+//! Combined with `Scheduler::lock_memory()` the slab stays resident, which
+//! makes the pool suitable for buffers used inside real-time ticks.
+
+use std::alloc::{self, Layout};
+use std::ops::{Deref, DerefMut};
+use std::ptr::NonNull;
+use std::sync::atomic::{AtomicU32, AtomicU64, AtomicUsize, Ordering};
+use std::sync::Arc;
+
+/// Alignment of every block
+const BLOCK_ALIGN: usize = 64;
+
+/// Empty list marker in the low half of a head word
+const NIL: u32 = u32::MAX;
+
+/// Treiber stack head: ABA tag in the high 32 bits, block index in the low
+#[repr(align(64))]
+struct FreeList {
+    head: AtomicU64,
+}
+
+impl FreeList {
+    fn pack(tag: u32, index: u32) -> u64 {
+        ((tag as u64) << 32) | index as u64
+    }
+
+    fn unpack(word: u64) -> (u32, u32) {
+        ((word >> 32) as u32, word as u32)
+    }
+}
+
+struct PoolInner {
+    slab: NonNull<u8>,
+    layout: Layout,
+    block_size: usize,
+    blocks_per_core: usize,
+    /// Next block in the free list, per block
+    next: Box<[AtomicU32]>,
+    lists: Box<[FreeList]>,
+    in_use: AtomicUsize,
+}
+
+// SAFETY: the slab is only reached through blocks, which are handed out to
+// one owner at a time by the atomic free lists.
+unsafe impl Send for PoolInner {}
+unsafe impl Sync for PoolInner {}
+
+impl PoolInner {
+    fn push(&self, core: usize, index: u32) {
+        let list = &self.lists[core];
+        let mut head = list.head.load(Ordering::Relaxed);
+        loop {
+            let (tag, first) = FreeList::unpack(head);
+            self.next[index as usize].store(first, Ordering::Relaxed);
+            match list.head.compare_exchange_weak(
+                head,
+                FreeList::pack(tag.wrapping_add(1), index),
+                Ordering::Release,
+                Ordering::Relaxed,
+            ) {
+                Ok(_) => return,
+                Err(current) => head = current,
+            }
+        }
+    }
+
+    fn pop(&self, core: usize) -> Option<u32> {
+        let list = &self.lists[core];
+        let mut head = list.head.load(Ordering::Acquire);
+        loop {
+            let (tag, first) = FreeList::unpack(head);
+            if first == NIL {
+                return None;
+            }
+            let next = self.next[first as usize].load(Ordering::Relaxed);
+            match list.head.compare_exchange_weak(
+                head,
+                FreeList::pack(tag.wrapping_add(1), next),
+                Ordering::Acquire,
+                Ordering::Acquire,
+            ) {
+                Ok(_) => return Some(first),
+                Err(current) => head = current,
+            }
+        }
+    }
+}
+
+impl Drop for PoolInner {
+    fn drop(&mut self) {
+        // SAFETY: allocated in `BlockPool::new` with this layout
+        unsafe { alloc::dealloc(self.slab.as_ptr(), self.layout) };
+    }
+}
+
+/// Fixed-size block pool shared by all cores
+///
+/// Cloning is cheap and shares the pool.
+///
+/// # Example
+/// ```no_run
+/// use horus_core::memory::BlockPool;
+///
+/// // 64 blocks of 4 KiB per core, allocated once before the control loop
+/// let pool = BlockPool::new(4096, 64);
+///
+/// // Inside tick: no heap allocation
+/// if let Some(mut block) = pool.acquire() {
+///     block[..4].copy_from_slice(b"scan");
+/// } // returned to the pool here
+/// ```
+#[derive(Clone)]
+pub struct BlockPool {
+    inner: Arc<PoolInner>,
+}
+
+impl BlockPool {
+    /// Pool with `blocks_per_core` blocks of `block_size` bytes for every CPU
+    pub fn new(block_size: usize, blocks_per_core: usize) -> Self {
+        Self::with_cores(block_size, blocks_per_core, num_cpus::get().max(1))
+    }
+
+    /// Pool with an explicit number of per-core free lists
+    pub fn with_cores(block_size: usize, blocks_per_core: usize, cores: usize) -> Self {
+        let block_size = block_size.max(1).next_multiple_of(BLOCK_ALIGN);
+        let cores = cores.max(1);
+        let total = blocks_per_core.max(1) * cores;
+        assert!(total < NIL as usize, "too many blocks for one pool");
+
+        let layout = total
+            .checked_mul(block_size)
+            .and_then(|size| Layout::from_size_align(size, BLOCK_ALIGN).ok())
+            .expect("pool size overflow");
+        // SAFETY: non-zero size; zeroing also prefaults the pages
+        let ptr = unsafe { alloc::alloc_zeroed(layout) };
+        let Some(slab) = NonNull::new(ptr) else {
+            alloc::handle_alloc_error(layout);
+        };
+        prefault(slab, layout.size());
+
+        let inner = PoolInner {
+            slab,
+            layout,
+            block_size,
+            blocks_per_core: blocks_per_core.max(1),
+            next: (0..total).map(|_| AtomicU32::new(NIL)).collect(),
+            lists: (0..cores)
+                .map(|_| FreeList {
+                    head: AtomicU64::new(FreeList::pack(0, NIL)),
+                })
+                .collect(),
+            in_use: AtomicUsize::new(0),
+        };
+        for index in (0..total).rev() {
+            inner.push(index / inner.blocks_per_core, index as u32);
+        }
+        Self {
+            inner: Arc::new(inner),
+        }
+    }
+
+    /// Take a block, preferring the calling CPU's free list
+    ///
+    /// Returns `None` when every block is in use. Block contents are
+    /// whatever the previous user left.
+    pub fn acquire(&self) -> Option<PoolBlock> {
+        let cores = self.inner.lists.len();
+        let home = current_cpu() % cores;
+        let index = (0..cores).find_map(|i| self.inner.pop((home + i) % cores))?;
+        self.inner.in_use.fetch_add(1, Ordering::Relaxed);
+        Some(PoolBlock {
+            pool: Arc::clone(&self.inner),
+            index,
+        })
+    }
+
+    /// Usable bytes per block (requested size rounded up to 64)
+    pub fn block_size(&self) -> usize {
+        self.inner.block_size
+    }
+
+    /// Total number of blocks
+    pub fn capacity(&self) -> usize {
+        self.inner.next.len()
+    }
+
+    /// Blocks currently held
+    pub fn in_use(&self) -> usize {
+        self.inner.in_use.load(Ordering::Relaxed)
+    }
+}
+
+/// Block borrowed from a `BlockPool`, returned on drop
+pub struct PoolBlock {
+    pool: Arc<PoolInner>,
+    index: u32,
+}
+
+impl PoolBlock {
+    fn ptr(&self) -> *mut u8 {
+        // SAFETY: index < total, so the offset is inside the slab
+        unsafe {
+            self.pool
+                .slab
+                .as_ptr()
+                .add(self.index as usize * self.pool.block_size)
+        }
+    }
+}
+
+impl Deref for PoolBlock {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        // SAFETY: this handle owns the block exclusively
+        unsafe { std::slice::from_raw_parts(self.ptr(), self.pool.block_size) }
+    }
+}
+
+impl DerefMut for PoolBlock {
+    fn deref_mut(&mut self) -> &mut [u8] {
+        // SAFETY: this handle owns the block exclusively
+        unsafe { std::slice::from_raw_parts_mut(self.ptr(), self.pool.block_size) }
+    }
+}
+
+impl Drop for PoolBlock {
+    fn drop(&mut self) {
+        let home = self.index as usize / self.pool.blocks_per_core;
+        self.pool.push(home, self.index);
+        self.pool.in_use.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+/// Touch one byte per page so the first real use does not page-fault
+fn prefault(ptr: NonNull<u8>, len: usize) {
+    const PAGE: usize = 4096;
+    for offset in (0..len).step_by(PAGE) {
+        // SAFETY: `offset < len`, inside the allocation
+        unsafe { std::ptr::write_volatile(ptr.as_ptr().add(offset), 0) };
+    }
+}
+
+#[cfg(target_os = "linux")]
+fn current_cpu() -> usize {
+    // SAFETY: sched_getcpu has no preconditions
+    let cpu = unsafe { libc::sched_getcpu() };
+    cpu.max(0) as usize
+}
+
+#[cfg(not(target_os = "linux"))]
+fn current_cpu() -> usize {
+    0
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_acquire_release() {
+        let pool = BlockPool::with_cores(100, 2, 2);
+        assert_eq!(pool.block_size(), 128);
+        assert_eq!(pool.capacity(), 4);
+
+        let mut blocks: Vec<PoolBlock> = (0..4).map(|_| pool.acquire().unwrap()).collect();
+        assert!(pool.acquire().is_none());
+        assert_eq!(pool.in_use(), 4);
+
+        for (i, block) in blocks.iter_mut().enumerate() {
+            block.fill(i as u8);
+        }
+        for (i, block) in blocks.iter().enumerate() {
+            assert!(block.iter().all(|&b| b == i as u8));
+            assert_eq!(block.as_ptr() as usize % BLOCK_ALIGN, 0);
+        }
+
+        blocks.clear();
+        assert_eq!(pool.in_use(), 0);
+        assert!(pool.acquire().is_some());
+    }
+
+    #[test]
+    fn test_concurrent_churn() {
+        let pool = BlockPool::with_cores(64, 8, 4);
+        let threads: Vec<_> = (0..4)
+            .map(|t| {
+                let pool = pool.clone();
+                std::thread::spawn(move || {
+                    for i in 0..10_000u32 {
+                        let mut a = pool.acquire().expect("pool exhausted");
+                        let mut b = pool.acquire().expect("pool exhausted");
+                        let tag = (t * 31 + i) as u8;
+                        a.fill(tag);
+                        b.fill(!tag);
+                        assert!(a.iter().all(|&x| x == tag));
+                        assert!(b.iter().all(|&x| x == !tag));
+                    }
+                })
+            })
+            .collect();
+        for thread in threads {
+            thread.join().unwrap();
+        }
+        assert_eq!(pool.in_use(), 0);
+    }
+}
@@ -4,6 +4,8 @@
 //!
 //! - **ShmRegion**: Cross-process memory regions using HORUS absolute paths
 //! - **ShmTopic**: Lock-free ring buffers in shared memory for high-performance messaging
+//! - **ShmBlobPool**: Refcounted shared memory slots for large payloads (images, point clouds)
+//! - **BlockPool**: Lock-free per-core fixed-block pool for allocation-free ticks
 //!
 //! ## Performance Features
 //!
@@ -17,12 +19,19 @@
 //! All memory operations maintain Rust's safety guarantees through careful
 //! use of lifetime management and atomic operations.
 
+pub mod block_pool;
+pub(crate) mod notify;
 pub mod platform;
+pub mod shm_blob_pool;
 pub mod shm_region;
 pub mod shm_topic;
 
+pub use block_pool::{BlockPool, PoolBlock};
 pub use platform::*;
+pub use shm_blob_pool::{
+    BlobHandle, BlobMessage, BlobMut, BlobSample, BlobView, OwnedBlobMut, ShmBlobPool,
+};
 pub use shm_region::ShmRegion;
-pub use shm_topic::ShmTopic;
+pub use shm_topic::{BackpressurePolicy, PublisherBatch, ShmTopic, SubscriberLag, TopicNotifier};
 
 // Tests are in the tests/ directory
@@ -0,0 +1,250 @@
+// Cross-process wakeup words for shared memory topics
+//
+// A `NotifyWord` lives in a topic's shared memory header. Publishers bump its
+// epoch after every publish and only pay for a wake syscall when somebody is
+// actually parked on it. Subscribers park until the epoch moves away from the
+// value they last saw.
+//
+// Linux uses shared (non-private) futexes, which work on MAP_SHARED file
+// mappings across processes, and `futex_waitv` (5.16+) to park on several
+// topics at once. Other platforms fall back to short sleeps.
+
+use std::sync::atomic::{AtomicU32, Ordering};
+use std::time::{Duration, Instant};
+
+/// Poll interval for platforms (or kernels) without a multi-word wait
+const FALLBACK_POLL: Duration = Duration::from_micros(100);
+
+/// Epoch counter plus waiter count, alone on a cache line
+#[repr(C, align(64))]
+pub(crate) struct NotifyWord {
+    epoch: AtomicU32,
+    waiters: AtomicU32,
+    _padding: [u8; 56], // Pad to 64-byte cache line boundary (4 + 4 + 56 = 64)
+}
+
+impl NotifyWord {
+    pub(crate) fn reset(&self) {
+        self.epoch.store(0, Ordering::Relaxed);
+        self.waiters.store(0, Ordering::Relaxed);
+    }
+
+    /// Current epoch; changes after every publish
+    #[inline]
+    pub(crate) fn epoch(&self) -> u32 {
+        self.epoch.load(Ordering::Acquire)
+    }
+
+    /// Bump the epoch and wake parked subscribers, if any
+    #[inline]
+    pub(crate) fn notify(&self) {
+        // SeqCst pairs with the waiter's increment-then-recheck in `wait_any`
+        self.epoch.fetch_add(1, Ordering::SeqCst);
+        if self.waiters.load(Ordering::SeqCst) > 0 {
+            futex_wake_all(&self.epoch);
+        }
+    }
+}
+
+/// Park until any word's epoch differs from its paired `seen` value
+///
+/// Returns true if a change was observed, false on timeout. Spurious early
+/// returns are possible; callers re-check their own condition.
+pub(crate) fn wait_any(words: &[(&NotifyWord, u32)], timeout: Duration) -> bool {
+    let changed = || words.iter().any(|(w, seen)| w.epoch() != *seen);
+    if words.is_empty() {
+        std::thread::sleep(timeout);
+        return false;
+    }
+    if changed() {
+        return true;
+    }
+
+    for (w, _) in words {
+        w.waiters.fetch_add(1, Ordering::SeqCst);
+    }
+
+    let deadline = Instant::now() + timeout;
+    let mut result = changed();
+    while !result {
+        let now = Instant::now();
+        if now >= deadline {
+            break;
+        }
+        futex_wait_any(words, deadline - now);
+        result = changed();
+    }
+
+    for (w, _) in words {
+        w.waiters.fetch_sub(1, Ordering::SeqCst);
+    }
+    result
+}
+
+#[cfg(target_os = "linux")]
+fn futex_wake_all(word: &AtomicU32) {
+    unsafe {
+        libc::syscall(
+            libc::SYS_futex,
+            word.as_ptr(),
+            libc::FUTEX_WAKE,
+            i32::MAX,
+            std::ptr::null::<libc::timespec>(),
+        );
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn futex_wake_all(_word: &AtomicU32) {
+    // Waiters poll on these platforms
+}
+
+#[cfg(target_os = "linux")]
+fn futex_wait_any(words: &[(&NotifyWord, u32)], timeout: Duration) {
+    use std::sync::atomic::AtomicBool;
+
+    // futex_waitv has the same number on every architecture
+    const SYS_FUTEX_WAITV: libc::c_long = 449;
+    const FUTEX2_SIZE_U32: u32 = 0x02;
+    const MAX_WAITV: usize = 128;
+
+    #[repr(C)]
+    struct FutexWaitv {
+        val: u64,
+        uaddr: u64,
+        flags: u32,
+        reserved: u32,
+    }
+
+    static WAITV_UNSUPPORTED: AtomicBool = AtomicBool::new(false);
+
+    if words.len() == 1 {
+        let (w, seen) = words[0];
+        let ts = libc::timespec {
+            tv_sec: timeout.as_secs() as libc::time_t,
+            tv_nsec: timeout.subsec_nanos() as libc::c_long,
+        };
+        unsafe {
+            libc::syscall(
+                libc::SYS_futex,
+                w.epoch.as_ptr(),
+                libc::FUTEX_WAIT,
+                seen,
+                &ts as *const libc::timespec,
+            );
+        }
+        return;
+    }
+
+    if words.len() <= MAX_WAITV && !WAITV_UNSUPPORTED.load(Ordering::Relaxed) {
+        let waitv: Vec<FutexWaitv> = words
+            .iter()
+            .map(|(w, seen)| FutexWaitv {
+                val: *seen as u64,
+                uaddr: w.epoch.as_ptr() as u64,
+                flags: FUTEX2_SIZE_U32,
+                reserved: 0,
+            })
+            .collect();
+
+        // futex_waitv takes an absolute CLOCK_MONOTONIC deadline
+        let mut now = libc::timespec {
+            tv_sec: 0,
+            tv_nsec: 0,
+        };
+        unsafe { libc::clock_gettime(libc::CLOCK_MONOTONIC, &mut now) };
+        let total_ns = now.tv_nsec as u128 + timeout.subsec_nanos() as u128;
+        let deadline = libc::timespec {
+            tv_sec: now.tv_sec
+                + timeout.as_secs() as libc::time_t
+                + (total_ns / 1_000_000_000) as libc::time_t,
+            tv_nsec: (total_ns % 1_000_000_000) as libc::c_long,
+        };
+
+        let ret = unsafe {
+            libc::syscall(
+                SYS_FUTEX_WAITV,
+                waitv.as_ptr(),
+                waitv.len() as libc::c_uint,
+                0 as libc::c_uint,
+                &deadline as *const libc::timespec,
+                libc::CLOCK_MONOTONIC,
+            )
+        };
+        if ret >= 0 {
+            return;
+        }
+        match std::io::Error::last_os_error().raw_os_error() {
+            Some(libc::ENOSYS) => WAITV_UNSUPPORTED.store(true, Ordering::Relaxed),
+            _ => return, // EAGAIN (already changed), ETIMEDOUT, EINTR
+        }
+    }
+
+    // Older kernels: sleep on the first word in short slices, callers re-check all
+    let (w, seen) = words[0];
+    let slice = timeout.min(FALLBACK_POLL);
+    let ts = libc::timespec {
+        tv_sec: 0,
+        tv_nsec: slice.as_nanos() as libc::c_long,
+    };
+    unsafe {
+        libc::syscall(
+            libc::SYS_futex,
+            w.epoch.as_ptr(),
+            libc::FUTEX_WAIT,
+            seen,
+            &ts as *const libc::timespec,
+        );
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn futex_wait_any(_words: &[(&NotifyWord, u32)], timeout: Duration) {
+    std::thread::sleep(timeout.min(FALLBACK_POLL));
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::Arc;
+
+    fn word() -> Arc<NotifyWord> {
+        let w = Arc::new(NotifyWord {
+            epoch: AtomicU32::new(0),
+            waiters: AtomicU32::new(0),
+            _padding: [0; 56],
+        });
+        w.reset();
+        w
+    }
+
+    #[test]
+    fn test_wait_any_times_out_without_notify() {
+        let w = word();
+        let start = Instant::now();
+        assert!(!wait_any(&[(&*w, w.epoch())], Duration::from_millis(10)));
+        assert!(start.elapsed() >= Duration::from_millis(10));
+    }
+
+    #[test]
+    fn test_notify_wakes_parked_waiter() {
+        let a = word();
+        let b = word();
+        let seen = (a.epoch(), b.epoch());
+
+        let notifier = b.clone();
+        let handle = std::thread::spawn(move || {
+            std::thread::sleep(Duration::from_millis(5));
+            notifier.notify();
+        });
+
+        let start = Instant::now();
+        assert!(wait_any(
+            &[(&*a, seen.0), (&*b, seen.1)],
+            Duration::from_secs(5)
+        ));
+        assert!(start.elapsed() < Duration::from_secs(5));
+        handle.join().unwrap();
+        assert_eq!(b.waiters.load(Ordering::Relaxed), 0);
+    }
+}
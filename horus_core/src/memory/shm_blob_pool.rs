@@ -0,0 +1,954 @@
+// HORUS Shared Memory Blob Pool - fixed-size slots for variable-size payloads
+//
+// Ring-buffer topics (ShmTopic) copy `T` by value into shared memory, so any
+// heap data behind a `Vec` never leaves the producing process. The blob pool
+// provides the missing half: a slab of fixed-size slots in a ShmRegion that
+// producers fill in place and publish as a small `BlobHandle`. The handle is
+// plain data and travels over a regular Hub; subscribers resolve it back to a
+// borrowed view of the slot without copying or deserializing.
+//
+// Slot lifetime is reference counted in shared memory:
+// - `loan()` pops a free slot and gives the writer the first reference
+// - `BlobMut::publish()` moves that reference into the pool's retention queue,
+//   which keeps the last `retain_depth` published slots alive while they can
+//   still be sitting in the topic ring
+// - every `BlobView` holds one more reference; the slot goes back on the free
+//   list when the last reference is dropped
+// - every reuse bumps the slot generation, so handles to a recycled slot are
+//   rejected instead of aliasing newer data
+
+use super::shm_region::ShmRegion;
+use crate::error::HorusResult;
+use crossbeam::queue::ArrayQueue;
+use serde::{Deserialize, Serialize};
+use std::mem;
+use std::ptr::NonNull;
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+const POOL_MAGIC: u64 = 0x484F_5255_5342_4C42; // "HORUSBLB"
+const POOL_VERSION: u32 = 1;
+const SLOT_ALIGN: usize = 64;
+const NIL_SLOT: u32 = u32::MAX;
+const MAX_SLOTS: usize = 65_536;
+const MAX_POOL_SIZE: usize = 1 << 31; // 2GB
+const INIT_TIMEOUT: Duration = Duration::from_secs(1);
+
+/// Pool header at the start of the shared region
+#[repr(C, align(64))]
+struct PoolHeader {
+    magic: AtomicU64,
+    version: AtomicU32,
+    slot_count: AtomicU32,
+    slot_size: AtomicU64,
+    /// Free-list head: upper 32 bits ABA tag, lower 32 bits slot index
+    free_head: AtomicU64,
+    /// Slots currently loaned or referenced (diagnostics only)
+    in_use: AtomicU64,
+    /// Failed loans because every slot was referenced
+    exhausted: AtomicU64,
+    _padding: [u8; 16],
+}
+
+/// Per-slot bookkeeping, one cache line per slot
+#[repr(C, align(64))]
+struct SlotDesc {
+    refcount: AtomicU32,
+    generation: AtomicU32,
+    next_free: AtomicU32,
+    _reserved: AtomicU32,
+    len: AtomicU64,
+    _padding: [u8; 40],
+}
+
+/// Reference to a published blob, small enough to send through any Hub
+///
+/// A handle is only a name for the data; resolve it with `ShmBlobPool::view`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Hash, Serialize, Deserialize)]
+pub struct BlobHandle {
+    /// Slot index inside the pool
+    pub slot: u32,
+    /// Slot generation at publish time (0 = null handle)
+    pub generation: u32,
+    /// Payload length in bytes
+    pub len: u64,
+}
+
+impl BlobHandle {
+    /// Whether this handle points at a published blob
+    pub fn is_null(&self) -> bool {
+        self.generation == 0
+    }
+}
+
+/// Messages whose payload lives in a `ShmBlobPool`
+///
+/// Implemented by the fixed-layout handle variants of large messages (images,
+/// point clouds, depth images) so `Hub::recv_blob` can resolve them.
+pub trait BlobMessage {
+    /// The blob holding this message's payload
+    fn blob_handle(&self) -> BlobHandle;
+}
+
+impl BlobMessage for BlobHandle {
+    fn blob_handle(&self) -> BlobHandle {
+        *self
+    }
+}
+
+/// Shared memory slab allocator for large message payloads
+pub struct ShmBlobPool {
+    _region: ShmRegion,
+    header: NonNull<PoolHeader>,
+    slots: NonNull<SlotDesc>,
+    data_ptr: NonNull<u8>,
+    slot_count: usize,
+    slot_size: usize,
+    /// Publisher-side references to recently published slots (process local)
+    retained: ArrayQueue<BlobHandle>,
+    name: String,
+}
+
+unsafe impl Send for ShmBlobPool {}
+unsafe impl Sync for ShmBlobPool {}
+
+impl std::fmt::Debug for ShmBlobPool {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("ShmBlobPool")
+            .field("name", &self.name)
+            .field("slot_count", &self.slot_count)
+            .field("slot_size", &self.slot_size)
+            .field("in_use", &self.in_use())
+            .finish()
+    }
+}
+
+impl ShmBlobPool {
+    /// Create or open a blob pool
+    ///
+    /// # Arguments
+    /// * `name` - Shared memory name (see `for_topic` for the topic convention)
+    /// * `slot_size` - Maximum payload size per blob in bytes
+    /// * `slot_count` - Number of slots; must exceed `retain_depth` plus the
+    ///   number of views subscribers hold at the same time
+    /// * `retain_depth` - How many published blobs this process keeps alive
+    ///   (normally the capacity of the topic carrying the handles)
+    pub fn new(
+        name: &str,
+        slot_size: usize,
+        slot_count: usize,
+        retain_depth: usize,
+    ) -> HorusResult<Arc<Self>> {
+        if slot_size == 0 {
+            return Err("Blob pool slot size must be non-zero".into());
+        }
+        if slot_count == 0 || slot_count > MAX_SLOTS {
+            return Err(format!(
+                "Blob pool slot count {} out of range (1-{})",
+                slot_count, MAX_SLOTS
+            )
+            .into());
+        }
+        if retain_depth >= slot_count {
+            return Err(format!(
+                "Blob pool '{}' retain depth {} leaves no free slots (slot count {})",
+                name, retain_depth, slot_count
+            )
+            .into());
+        }
+
+        let slot_size = slot_size.div_ceil(SLOT_ALIGN) * SLOT_ALIGN;
+        let (slots_offset, data_offset, total_size) = Self::layout(slot_count, slot_size)?;
+
+        let region = ShmRegion::new(name, total_size)?;
+        let is_owner = region.is_owner();
+        let base = region.as_ptr() as *mut u8;
+
+        let header =
+            NonNull::new(base as *mut PoolHeader).ok_or("Null pointer for blob pool header")?;
+        let slots = NonNull::new(unsafe { base.add(slots_offset) } as *mut SlotDesc)
+            .ok_or("Null pointer for blob pool slots")?;
+        let data_ptr =
+            NonNull::new(unsafe { base.add(data_offset) }).ok_or("Null pointer for blob data")?;
+
+        if is_owner {
+            unsafe {
+                let h = header.as_ref();
+                h.version.store(POOL_VERSION, Ordering::Relaxed);
+                h.slot_count.store(slot_count as u32, Ordering::Relaxed);
+                h.slot_size.store(slot_size as u64, Ordering::Relaxed);
+                h.in_use.store(0, Ordering::Relaxed);
+                h.exhausted.store(0, Ordering::Relaxed);
+
+                // Thread every slot onto the free list
+                for i in 0..slot_count {
+                    let desc = &*slots.as_ptr().add(i);
+                    desc.refcount.store(0, Ordering::Relaxed);
+                    desc.generation.store(0, Ordering::Relaxed);
+                    desc.len.store(0, Ordering::Relaxed);
+                    let next = if i + 1 < slot_count {
+                        (i + 1) as u32
+                    } else {
+                        NIL_SLOT
+                    };
+                    desc.next_free.store(next, Ordering::Relaxed);
+                }
+                h.free_head.store(0, Ordering::Relaxed);
+
+                // Publish the initialized layout to other processes
+                h.magic.store(POOL_MAGIC, Ordering::Release);
+            }
+        } else {
+            Self::wait_initialized(unsafe { header.as_ref() }, name)?;
+            let h = unsafe { header.as_ref() };
+            let existing_count = h.slot_count.load(Ordering::Relaxed) as usize;
+            let existing_size = h.slot_size.load(Ordering::Relaxed) as usize;
+            if existing_count != slot_count || existing_size != slot_size {
+                return Err(format!(
+                    "Blob pool '{}' layout mismatch: existing {}x{} bytes, requested {}x{} bytes",
+                    name, existing_count, existing_size, slot_count, slot_size
+                )
+                .into());
+            }
+        }
+
+        log::info!(
+            "SHM_BLOB: {} blob pool '{}' ({} slots x {} bytes)",
+            if is_owner { "Created" } else { "Opened" },
+            name,
+            slot_count,
+            slot_size
+        );
+
+        Ok(Arc::new(Self {
+            _region: region,
+            header,
+            slots,
+            data_ptr,
+            slot_count,
+            slot_size,
+            retained: ArrayQueue::new(retain_depth.max(1)),
+            name: name.to_string(),
+        }))
+    }
+
+    /// Open an existing blob pool, taking its layout from the shared header
+    ///
+    /// Used by subscribers that don't know the producer's slot size.
+    pub fn open(name: &str) -> HorusResult<Arc<Self>> {
+        let region = ShmRegion::open(name)?;
+        if region.size() < mem::size_of::<PoolHeader>() {
+            return Err(format!("Blob pool '{}' too small for header", name).into());
+        }
+
+        let base = region.as_ptr() as *mut u8;
+        let header =
+            NonNull::new(base as *mut PoolHeader).ok_or("Null pointer for blob pool header")?;
+        Self::wait_initialized(unsafe { header.as_ref() }, name)?;
+
+        let h = unsafe { header.as_ref() };
+        let slot_count = h.slot_count.load(Ordering::Relaxed) as usize;
+        let slot_size = h.slot_size.load(Ordering::Relaxed) as usize;
+        let (slots_offset, data_offset, total_size) = Self::layout(slot_count, slot_size)?;
+        if region.size() < total_size {
+            return Err(format!(
+                "Blob pool '{}' region too small: {} < {}",
+                name,
+                region.size(),
+                total_size
+            )
+            .into());
+        }
+
+        let slots = NonNull::new(unsafe { base.add(slots_offset) } as *mut SlotDesc)
+            .ok_or("Null pointer for blob pool slots")?;
+        let data_ptr =
+            NonNull::new(unsafe { base.add(data_offset) }).ok_or("Null pointer for blob data")?;
+
+        Ok(Arc::new(Self {
+            _region: region,
+            header,
+            slots,
+            data_ptr,
+            slot_count,
+            slot_size,
+            retained: ArrayQueue::new(1),
+            name: name.to_string(),
+        }))
+    }
+
+    /// Create or open the pool that backs a topic (`<topic>.blobs`)
+    pub fn for_topic(
+        topic: &str,
+        slot_size: usize,
+        slot_count: usize,
+        retain_depth: usize,
+    ) -> HorusResult<Arc<Self>> {
+        Self::new(
+            &Self::topic_pool_name(topic),
+            slot_size,
+            slot_count,
+            retain_depth,
+        )
+    }
+
+    /// Shared memory name of the pool backing `topic`
+    pub fn topic_pool_name(topic: &str) -> String {
+        format!("{}.blobs", topic)
+    }
+
+    fn layout(slot_count: usize, slot_size: usize) -> HorusResult<(usize, usize, usize)> {
+        let header_size = mem::size_of::<PoolHeader>();
+        let slots_offset = header_size.div_ceil(SLOT_ALIGN) * SLOT_ALIGN;
+        let slots_size = slot_count
+            .checked_mul(mem::size_of::<SlotDesc>())
+            .ok_or("Integer overflow calculating blob slot table size")?;
+        let data_offset = (slots_offset + slots_size).div_ceil(SLOT_ALIGN) * SLOT_ALIGN;
+        let data_size = slot_count
+            .checked_mul(slot_size)
+            .ok_or("Integer overflow calculating blob data size")?;
+        let total_size = data_offset
+            .checked_add(data_size)
+            .ok_or("Integer overflow calculating blob pool size")?;
+        if total_size > MAX_POOL_SIZE {
+            return Err(format!(
+                "Blob pool size {} exceeds maximum {}",
+                total_size, MAX_POOL_SIZE
+            )
+            .into());
+        }
+        Ok((slots_offset, data_offset, total_size))
+    }
+
+    fn wait_initialized(header: &PoolHeader, name: &str) -> HorusResult<()> {
+        let start = Instant::now();
+        while header.magic.load(Ordering::Acquire) != POOL_MAGIC {
+            if start.elapsed() > INIT_TIMEOUT {
+                return Err(format!("Blob pool '{}' was never initialized", name).into());
+            }
+            std::thread::yield_now();
+        }
+        let version = header.version.load(Ordering::Relaxed);
+        if version != POOL_VERSION {
+            return Err(format!(
+                "Blob pool '{}' has layout version {}, expected {}. \
+                 Please delete shared memory files in the horus directory and recreate topics.",
+                name, version, POOL_VERSION
+            )
+            .into());
+        }
+        Ok(())
+    }
+
+    #[inline]
+    fn header(&self) -> &PoolHeader {
+        unsafe { self.header.as_ref() }
+    }
+
+    #[inline]
+    fn desc(&self, slot: u32) -> &SlotDesc {
+        debug_assert!((slot as usize) < self.slot_count);
+        unsafe { &*self.slots.as_ptr().add(slot as usize) }
+    }
+
+    #[inline]
+    fn slot_ptr(&self, slot: u32) -> *mut u8 {
+        unsafe { self.data_ptr.as_ptr().add(slot as usize * self.slot_size) }
+    }
+
+    /// Maximum payload size of one blob
+    pub fn slot_size(&self) -> usize {
+        self.slot_size
+    }
+
+    /// Number of slots in the pool
+    pub fn slot_count(&self) -> usize {
+        self.slot_count
+    }
+
+    /// Slots currently loaned or referenced, across all processes
+    pub fn in_use(&self) -> u64 {
+        self.header().in_use.load(Ordering::Relaxed)
+    }
+
+    /// Number of loans that failed because the pool was exhausted
+    pub fn exhausted_count(&self) -> u64 {
+        self.header().exhausted.load(Ordering::Relaxed)
+    }
+
+    /// Pool name
+    pub fn name(&self) -> &str {
+        &self.name
+    }
+
+    /// Loan a free slot for writing a payload of up to `len` bytes
+    ///
+    /// The payload is written in place; nothing is copied on publish.
+    pub fn loan(&self, len: usize) -> HorusResult<BlobMut<'_>> {
+        let (slot, generation) = self.reserve(len)?;
+        Ok(BlobMut {
+            pool: self,
+            slot,
+            generation,
+            len,
+            published: false,
+        })
+    }
+
+    /// Loan a free slot that holds its own reference to the pool
+    ///
+    /// Same as `loan`, for writers that outlive any borrow of the pool, such
+    /// as a slot handed to Python to fill and published on a later call.
+    pub fn loan_owned(self: &Arc<Self>, len: usize) -> HorusResult<OwnedBlobMut> {
+        let (slot, generation) = self.reserve(len)?;
+        Ok(OwnedBlobMut {
+            pool: Arc::clone(self),
+            slot,
+            generation,
+            len,
+            published: false,
+        })
+    }
+
+    /// Pop a free slot for a new payload, returning (slot, generation)
+    fn reserve(&self, len: usize) -> HorusResult<(u32, u32)> {
+        if len > self.slot_size {
+            return Err(format!(
+                "Blob of {} bytes exceeds slot size {} in pool '{}'",
+                len, self.slot_size, self.name
+            )
+            .into());
+        }
+
+        let slot = match self.pop_free() {
+            Some(slot) => slot,
+            None => {
+                self.header().exhausted.fetch_add(1, Ordering::Relaxed);
+                return Err(format!("Blob pool '{}' exhausted", self.name).into());
+            }
+        };
+
+        let desc = self.desc(slot);
+        // Bump generation before the slot becomes visible again, so stale
+        // handles to its previous contents are rejected
+        let mut generation = desc.generation.load(Ordering::Relaxed).wrapping_add(1);
+        if generation == 0 {
+            generation = 1;
+        }
+        desc.generation.store(generation, Ordering::Relaxed);
+        desc.len.store(len as u64, Ordering::Relaxed);
+        desc.refcount.store(1, Ordering::Release);
+        self.header().in_use.fetch_add(1, Ordering::Relaxed);
+
+        Ok((slot, generation))
+    }
+
+    /// Publish a filled slot: record its length and hand the writer's
+    /// reference to the retention queue
+    fn publish_slot(&self, slot: u32, generation: u32, len: usize) -> BlobHandle {
+        self.desc(slot).len.store(len as u64, Ordering::Release);
+        let handle = BlobHandle {
+            slot,
+            generation,
+            len: len as u64,
+        };
+        self.retain(handle);
+        handle
+    }
+
+    /// Resolve a handle to a read-only view, taking a reference on the slot
+    ///
+    /// Returns None if the handle is null or its slot has since been recycled.
+    pub fn view(self: &Arc<Self>, handle: &BlobHandle) -> Option<BlobView> {
+        if !self.acquire(handle) {
+            return None;
+        }
+        Some(BlobView {
+            pool: Arc::clone(self),
+            slot: handle.slot,
+            len: handle.len as usize,
+        })
+    }
+
+    fn acquire(&self, handle: &BlobHandle) -> bool {
+        if handle.is_null()
+            || handle.slot as usize >= self.slot_count
+            || handle.len as usize > self.slot_size
+        {
+            return false;
+        }
+
+        let desc = self.desc(handle.slot);
+        let mut rc = desc.refcount.load(Ordering::Acquire);
+        loop {
+            if rc == 0 || desc.generation.load(Ordering::Acquire) != handle.generation {
+                return false;
+            }
+            match desc.refcount.compare_exchange_weak(
+                rc,
+                rc + 1,
+                Ordering::AcqRel,
+                Ordering::Acquire,
+            ) {
+                Ok(_) => break,
+                Err(current) => rc = current,
+            }
+        }
+
+        // The slot may have been freed and reloaned between the load and the
+        // CAS; we now hold a real reference either way, so re-check and give
+        // it back if it's not the blob we asked for
+        if desc.generation.load(Ordering::Acquire) != handle.generation {
+            self.release(handle.slot);
+            return false;
+        }
+        true
+    }
+
+    fn release(&self, slot: u32) {
+        let desc = self.desc(slot);
+        if desc.refcount.fetch_sub(1, Ordering::AcqRel) == 1 {
+            self.header().in_use.fetch_sub(1, Ordering::Relaxed);
+            self.push_free(slot);
+        }
+    }
+
+    /// Keep the publisher's reference to a blob until `retain_depth` newer
+    /// blobs have been published
+    fn retain(&self, handle: BlobHandle) {
+        let mut handle = handle;
+        while let Err(h) = self.retained.push(handle) {
+            handle = h;
+            if let Some(oldest) = self.retained.pop() {
+                self.release(oldest.slot);
+            }
+        }
+    }
+
+    fn pop_free(&self) -> Option<u32> {
+        let header = self.header();
+        let mut head = header.free_head.load(Ordering::Acquire);
+        loop {
+            let slot = (head & 0xFFFF_FFFF) as u32;
+            if slot == NIL_SLOT {
+                return None;
+            }
+            let next = self.desc(slot).next_free.load(Ordering::Relaxed);
+            let tag = (head >> 32).wrapping_add(1);
+            let new_head = (tag << 32) | next as u64;
+            match header.free_head.compare_exchange_weak(
+                head,
+                new_head,
+                Ordering::AcqRel,
+                Ordering::Acquire,
+            ) {
+                Ok(_) => return Some(slot),
+                Err(current) => head = current,
+            }
+        }
+    }
+
+    fn push_free(&self, slot: u32) {
+        let header = self.header();
+        let desc = self.desc(slot);
+        let mut head = header.free_head.load(Ordering::Acquire);
+        loop {
+            desc.next_free
+                .store((head & 0xFFFF_FFFF) as u32, Ordering::Relaxed);
+            let tag = (head >> 32).wrapping_add(1);
+            let new_head = (tag << 32) | slot as u64;
+            match header.free_head.compare_exchange_weak(
+                head,
+                new_head,
+                Ordering::AcqRel,
+                Ordering::Acquire,
+            ) {
+                Ok(_) => return,
+                Err(current) => head = current,
+            }
+        }
+    }
+}
+
+impl Drop for ShmBlobPool {
+    fn drop(&mut self) {
+        // Hand back the publisher references this process still holds
+        while let Some(handle) = self.retained.pop() {
+            self.release(handle.slot);
+        }
+    }
+}
+
+/// A loaned slot being filled by a producer
+///
+/// Dropping it without calling `publish` returns the slot to the pool.
+pub struct BlobMut<'a> {
+    pool: &'a ShmBlobPool,
+    slot: u32,
+    generation: u32,
+    len: usize,
+    published: bool,
+}
+
+impl BlobMut<'_> {
+    /// The writable payload (length given to `loan`, adjustable with `set_len`)
+    pub fn as_mut_slice(&mut self) -> &mut [u8] {
+        unsafe { std::slice::from_raw_parts_mut(self.pool.slot_ptr(self.slot), self.len) }
+    }
+
+    /// The whole slot, regardless of the current payload length
+    pub fn capacity_mut(&mut self) -> &mut [u8] {
+        unsafe {
+            std::slice::from_raw_parts_mut(self.pool.slot_ptr(self.slot), self.pool.slot_size)
+        }
+    }
+
+    /// View the payload as a slice of plain-old-data values (e.g. `u16` depths)
+    pub fn as_mut_pod<P: bytemuck::Pod>(&mut self) -> &mut [P] {
+        let len = self.len / mem::size_of::<P>() * mem::size_of::<P>();
+        bytemuck::cast_slice_mut(&mut self.as_mut_slice()[..len])
+    }
+
+    /// Change the payload length (clamped to the slot size)
+    pub fn set_len(&mut self, len: usize) {
+        self.len = len.min(self.pool.slot_size);
+    }
+
+    /// Current payload length in bytes
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether the payload is empty
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Make the payload visible to subscribers and return its handle
+    ///
+    /// Send the handle (usually embedded in a handle message) over a Hub.
+    pub fn publish(mut self) -> BlobHandle {
+        self.published = true;
+        self.pool.publish_slot(self.slot, self.generation, self.len)
+    }
+}
+
+impl Drop for BlobMut<'_> {
+    fn drop(&mut self) {
+        if !self.published {
+            self.pool.release(self.slot);
+        }
+    }
+}
+
+/// A loaned slot that keeps the pool alive on its own
+///
+/// Behaves like `BlobMut`; created by `ShmBlobPool::loan_owned`.
+pub struct OwnedBlobMut {
+    pool: Arc<ShmBlobPool>,
+    slot: u32,
+    generation: u32,
+    len: usize,
+    published: bool,
+}
+
+impl OwnedBlobMut {
+    /// The writable payload (length given to `loan_owned`, adjustable with `set_len`)
+    pub fn as_mut_slice(&mut self) -> &mut [u8] {
+        unsafe { std::slice::from_raw_parts_mut(self.pool.slot_ptr(self.slot), self.len) }
+    }
+
+    /// Raw pointer to the payload; stays valid until the loan is published or dropped
+    pub fn as_mut_ptr(&mut self) -> *mut u8 {
+        self.pool.slot_ptr(self.slot)
+    }
+
+    /// View the payload as a slice of plain-old-data values (e.g. `u16` depths)
+    pub fn as_mut_pod<P: bytemuck::Pod>(&mut self) -> &mut [P] {
+        let len = self.len / mem::size_of::<P>() * mem::size_of::<P>();
+        bytemuck::cast_slice_mut(&mut self.as_mut_slice()[..len])
+    }
+
+    /// Change the payload length (clamped to the slot size)
+    pub fn set_len(&mut self, len: usize) {
+        self.len = len.min(self.pool.slot_size);
+    }
+
+    /// Current payload length in bytes
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether the payload is empty
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// The pool this slot belongs to
+    pub fn pool(&self) -> &Arc<ShmBlobPool> {
+        &self.pool
+    }
+
+    /// Make the payload visible to subscribers and return its handle
+    pub fn publish(mut self) -> BlobHandle {
+        self.published = true;
+        self.pool.publish_slot(self.slot, self.generation, self.len)
+    }
+
+    /// Publish, keeping a read-only view of the payload
+    ///
+    /// The view takes its reference before the slot is published, so the
+    /// slot is not recycled while the view lives even after subscribers and
+    /// the retention queue have let go of it.
+    pub fn publish_with_view(self) -> (BlobHandle, BlobView) {
+        self.pool
+            .desc(self.slot)
+            .refcount
+            .fetch_add(1, Ordering::AcqRel);
+        let view = BlobView {
+            pool: Arc::clone(&self.pool),
+            slot: self.slot,
+            len: self.len,
+        };
+        (self.publish(), view)
+    }
+}
+
+impl Drop for OwnedBlobMut {
+    fn drop(&mut self) {
+        if !self.published {
+            self.pool.release(self.slot);
+        }
+    }
+}
+
+impl std::fmt::Debug for OwnedBlobMut {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("OwnedBlobMut")
+            .field("pool", &self.pool.name)
+            .field("slot", &self.slot)
+            .field("len", &self.len)
+            .finish()
+    }
+}
+
+/// Read-only view of a published blob in shared memory
+///
+/// Holds a reference on the slot; the slot is recycled only after every
+/// view (and the publisher's retention) has been released.
+pub struct BlobView {
+    pool: Arc<ShmBlobPool>,
+    slot: u32,
+    len: usize,
+}
+
+impl BlobView {
+    /// Payload bytes
+    pub fn as_slice(&self) -> &[u8] {
+        unsafe { std::slice::from_raw_parts(self.pool.slot_ptr(self.slot), self.len) }
+    }
+
+    /// Payload as plain-old-data values (e.g. `u16` depths, `f32` points)
+    pub fn as_pod<P: bytemuck::Pod>(&self) -> &[P] {
+        let len = self.len / mem::size_of::<P>() * mem::size_of::<P>();
+        bytemuck::cast_slice(&self.as_slice()[..len])
+    }
+
+    /// Payload length in bytes
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether the payload is empty
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+}
+
+impl std::ops::Deref for BlobView {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        self.as_slice()
+    }
+}
+
+impl Clone for BlobView {
+    fn clone(&self) -> Self {
+        self.pool
+            .desc(self.slot)
+            .refcount
+            .fetch_add(1, Ordering::AcqRel);
+        Self {
+            pool: Arc::clone(&self.pool),
+            slot: self.slot,
+            len: self.len,
+        }
+    }
+}
+
+impl Drop for BlobView {
+    fn drop(&mut self) {
+        self.pool.release(self.slot);
+    }
+}
+
+impl std::fmt::Debug for BlobView {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("BlobView")
+            .field("pool", &self.pool.name)
+            .field("slot", &self.slot)
+            .field("len", &self.len)
+            .finish()
+    }
+}
+
+/// A received handle message together with a view of its payload
+pub struct BlobSample<T> {
+    msg: T,
+    view: BlobView,
+}
+
+impl<T> BlobSample<T> {
+    /// Pair a handle message with its resolved payload
+    pub fn new(msg: T, view: BlobView) -> Self {
+        Self { msg, view }
+    }
+
+    /// The handle message (metadata such as width, height, encoding)
+    pub fn message(&self) -> &T {
+        &self.msg
+    }
+
+    /// The payload bytes in shared memory
+    pub fn data(&self) -> &[u8] {
+        self.view.as_slice()
+    }
+
+    /// The payload view (can be kept after the message is dropped)
+    pub fn view(&self) -> &BlobView {
+        &self.view
+    }
+
+    /// Split into message and payload view
+    pub fn into_parts(self) -> (T, BlobView) {
+        (self.msg, self.view)
+    }
+}
+
+impl<T> std::ops::Deref for BlobSample<T> {
+    type Target = T;
+
+    fn deref(&self) -> &T {
+        &self.msg
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn unique_name(tag: &str) -> String {
+        format!("test_blob_{}_{}", tag, std::process::id())
+    }
+
+    #[test]
+    fn test_loan_publish_view() {
+        let pool = ShmBlobPool::new(&unique_name("basic"), 1024, 4, 2).unwrap();
+
+        let mut blob = pool.loan(16).unwrap();
+        blob.as_mut_slice().copy_from_slice(&[7u8; 16]);
+        let handle = blob.publish();
+
+        let view = pool.view(&handle).expect("published blob should resolve");
+        assert_eq!(view.len(), 16);
+        assert!(view.iter().all(|&b| b == 7));
+        assert_eq!(pool.in_use(), 1);
+    }
+
+    #[test]
+    fn test_recycled_slot_rejects_stale_handle() {
+        // retain_depth = 1: publishing a second blob releases the first
+        let pool = ShmBlobPool::new(&unique_name("stale"), 64, 2, 1).unwrap();
+
+        let first = pool.loan(8).unwrap().publish();
+        let _second = pool.loan(8).unwrap().publish();
+        // First slot is free again; reloan it so its generation moves on
+        let third = pool.loan(8).unwrap().publish();
+
+        assert_eq!(first.slot, third.slot);
+        assert!(pool.view(&first).is_none());
+        assert!(pool.view(&third).is_some());
+    }
+
+    #[test]
+    fn test_view_keeps_slot_alive() {
+        let pool = ShmBlobPool::new(&unique_name("alive"), 64, 2, 1).unwrap();
+
+        let mut blob = pool.loan(4).unwrap();
+        blob.as_mut_slice().copy_from_slice(&[1, 2, 3, 4]);
+        let handle = blob.publish();
+        let view = pool.view(&handle).unwrap();
+
+        // Publishing another blob drops the retention reference, but our
+        // view still holds the first slot
+        let _next = pool.loan(4).unwrap().publish();
+        assert!(pool.loan(4).is_err());
+        assert_eq!(&view[..], &[1, 2, 3, 4]);
+
+        drop(view);
+        assert!(pool.loan(4).is_ok());
+    }
+
+    #[test]
+    fn test_unpublished_loan_returns_slot() {
+        let pool = ShmBlobPool::new(&unique_name("unpub"), 64, 2, 1).unwrap();
+        {
+            let _a = pool.loan(1).unwrap();
+            let _b = pool.loan(1).unwrap();
+            assert!(pool.loan(1).is_err());
+        }
+        assert_eq!(pool.in_use(), 0);
+        assert!(pool.loan(1).is_ok());
+    }
+
+    #[test]
+    fn test_publish_with_view_holds_slot() {
+        // retain_depth = 1: the next publish drops the retention reference
+        let pool = ShmBlobPool::new(&unique_name("pubview"), 64, 2, 1).unwrap();
+        let mut blob = pool.loan_owned(4).unwrap();
+        blob.as_mut_slice().copy_from_slice(&[5, 6, 7, 8]);
+        let (handle, view) = blob.publish_with_view();
+        assert!(pool.view(&handle).is_some());
+
+        let _next = pool.loan(4).unwrap().publish();
+        assert!(
+            pool.loan(4).is_err(),
+            "slot must stay referenced by the view"
+        );
+        assert_eq!(&view[..], &[5, 6, 7, 8]);
+
+        drop(view);
+        assert!(pool.loan(4).is_ok());
+    }
+
+    #[test]
+    fn test_owned_loan_outlives_pool_handle() {
+        let pool = ShmBlobPool::new(&unique_name("owned"), 64, 2, 1).unwrap();
+        let mut blob = pool.loan_owned(8).unwrap();
+        let reader = Arc::clone(blob.pool());
+        drop(pool);
+
+        blob.as_mut_pod::<u16>().copy_from_slice(&[1, 2, 3, 4]);
+        let handle = blob.publish();
+        let view = reader.view(&handle).unwrap();
+        assert_eq!(view.as_pod::<u16>(), &[1, 2, 3, 4]);
+
+        let unpublished = reader.loan_owned(1).unwrap();
+        assert_eq!(reader.in_use(), 2);
+        drop(unpublished);
+        assert_eq!(reader.in_use(), 1);
+    }
+}
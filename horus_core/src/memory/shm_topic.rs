@@ -1,10 +1,13 @@
+use super::notify::{self, NotifyWord};
+use super::platform::is_process_running;
 use super::shm_region::ShmRegion;
 use crate::error::HorusResult;
 use std::marker::PhantomData;
-use std::mem;
+use std::mem::{self, MaybeUninit};
 use std::ptr::NonNull;
-use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::atomic::{AtomicU32, AtomicU64, AtomicUsize, Ordering};
 use std::sync::Arc;
+use std::time::{Duration, Instant};
 
 // Safety constants to prevent dangerous configurations
 const MAX_CAPACITY: usize = 1_000_000; // Maximum number of elements
@@ -12,17 +15,139 @@ const MIN_CAPACITY: usize = 1; // Minimum number of elements
 const MAX_ELEMENT_SIZE: usize = 1_000_000; // Maximum size per element in bytes
 const MAX_TOTAL_SIZE: usize = 100_000_000; // Maximum total shared memory size (100MB)
 const MAX_CONSUMERS: usize = 16; // Maximum number of consumers per topic (MPMC support)
+const BLOCK_SPIN_LIMIT: u32 = 128; // Busy-wait iterations before yielding in Block policy
+const HEADER_INIT_TIMEOUT: Duration = Duration::from_secs(1); // Wait for creator to finish init
+
+// Shared memory layout identification. Bump TOPIC_LAYOUT_VERSION whenever the
+// header or slot layout changes so mismatched processes refuse to attach.
+const TOPIC_MAGIC: u64 = 0x484F_5255_5354_4F50; // "HORUSTOP"
+const TOPIC_LAYOUT_VERSION: u32 = 4;
+
+// Consumer cursor slot states
+const CURSOR_FREE: u32 = 0;
+const CURSOR_INIT: u32 = 1;
+const CURSOR_ACTIVE: u32 = 2;
+
+// Local cursor index sentinels
+const CURSOR_UNREGISTERED: usize = usize::MAX;
+const CURSOR_UNAVAILABLE: usize = usize::MAX - 1;
+
+/// What a producer does when the slowest registered subscriber is a full ring behind
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum BackpressurePolicy {
+    /// Never wait: overwrite the oldest message. Subscribers that were lapped
+    /// skip ahead to the oldest intact message and count what they missed.
+    #[default]
+    DropOldest,
+    /// Reject the new message (send returns `Err(msg)`) and keep unread data intact
+    DropNewest,
+    /// Spin, then yield, until a slot frees up; reject the message after `timeout`
+    Block { timeout: Duration },
+}
+
+/// Read position of one subscriber, shared with producers through the header
+#[repr(C, align(64))]
+struct ConsumerCursor {
+    state: AtomicU32,
+    pid: AtomicU32,
+    position: AtomicUsize, // Next monotonic position this subscriber will read
+    dropped: AtomicU64,    // Messages skipped because the producer lapped us
+    _padding: [u8; 40],    // Pad to 64-byte cache line boundary (4 + 4 + 8 + 8 + 40 = 64)
+}
+
+/// Lag snapshot for one subscriber of a topic
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct SubscriberLag {
+    /// Cursor slot in the topic header
+    pub consumer_id: usize,
+    /// Process that owns the subscriber
+    pub pid: u32,
+    /// Messages published but not yet consumed
+    pub lag: usize,
+    /// Messages the subscriber missed because it was overwritten
+    pub dropped: u64,
+}
+
+/// Read-mostly topic metadata, written once by the creator
+#[repr(C, align(64))]
+struct TopicMeta {
+    magic: AtomicU64, // Stored last (Release) once the header is initialized
+    version: AtomicU32,
+    _reserved: AtomicU32,
+    capacity: AtomicUsize,
+    element_size: AtomicUsize,
+    consumer_count: AtomicUsize, // Number of registered subscriber cursors
+    _padding: [u8; 24],          // Pad to 64-byte cache line boundary (8 + 4 + 4 + 3 * 8 + 24 = 64)
+}
+
+/// Low stamp bit: the position was claimed but never written, readers skip it
+const STAMP_SKIP: usize = 1;
+
+/// Publish stamp of a slot holding position `p`: `(p + 1) << 1`
+///
+/// Zero means never published, and `STAMP_SKIP` may be or-ed in. Stamps of
+/// later laps compare greater, so `fetch_max` never lets a slow producer roll
+/// a slot's stamp back.
+#[inline]
+fn slot_stamp(position: usize) -> usize {
+    (position + 1) << 1
+}
+
+/// A single counter alone on its cache line
+#[repr(C, align(64))]
+struct PaddedCounter {
+    value: AtomicUsize,
+    _padding: [u8; 56],
+}
 
 /// Header for shared memory ring buffer with cache-line alignment
+///
+/// Every hot counter has its own cache line so producers claiming slots do
+/// not invalidate the line consumers poll, and vice versa. `head` (claimed)
+/// and `sequence_number` (published) are monotonic positions; the slot of
+/// position `p` is `p & (capacity - 1)`.
+///
+/// The header is followed by one publish stamp per slot, then the slots.
+/// Producers stamp their slots once written and `sequence_number` only
+/// advances over a contiguous run of stamped positions, so messages become
+/// visible in claim order even when producers finish out of order.
 #[repr(C, align(64))] // Cache-line aligned for optimal performance (x86_64 cache line = 64 bytes)
 struct RingBufferHeader {
-    capacity: AtomicUsize,
-    head: AtomicUsize,
-    tail: AtomicUsize, // This is now unused - kept for compatibility
-    element_size: AtomicUsize,
-    consumer_count: AtomicUsize,
-    sequence_number: AtomicUsize, // Global sequence counter
-    _padding: [u8; 16],           // Pad to 64-byte cache line boundary (6 * 8 + 16 = 64)
+    meta: TopicMeta,
+    head: PaddedCounter,            // Producers CAS/fetch_add to claim slots
+    sequence_number: PaddedCounter, // Producers publish, consumers poll
+    notify: NotifyWord,             // Wakes subscribers parked in wait_for_data
+    cursors: [ConsumerCursor; MAX_CONSUMERS], // One cache line per subscriber
+}
+
+impl RingBufferHeader {
+    /// Wait for the creator to finish initializing, then check the layout matches ours
+    fn validate_layout(&self, name: &str) -> HorusResult<()> {
+        let deadline = Instant::now() + HEADER_INIT_TIMEOUT;
+        while self.meta.magic.load(Ordering::Acquire) != TOPIC_MAGIC {
+            if Instant::now() >= deadline {
+                return Err(format!(
+                    "Topic '{}' has an unrecognized shared memory layout (created by an older \
+                     HORUS version or still initializing). Please delete shared memory files \
+                     in the horus directory and recreate topics.",
+                    name
+                )
+                .into());
+            }
+            std::thread::yield_now();
+        }
+
+        let version = self.meta.version.load(Ordering::Relaxed);
+        if version != TOPIC_LAYOUT_VERSION {
+            return Err(format!(
+                "Topic '{}' uses shared memory layout v{}, this process expects v{}. \
+                 All processes on a topic must run the same HORUS version.",
+                name, version, TOPIC_LAYOUT_VERSION
+            )
+            .into());
+        }
+        Ok(())
+    }
 }
 
 /// Lock-free ring buffer in real shared memory using mmap with cache optimization
@@ -30,10 +155,13 @@ struct RingBufferHeader {
 pub struct ShmTopic<T> {
     _region: Arc<ShmRegion>,
     header: NonNull<RingBufferHeader>,
+    stamps: NonNull<AtomicUsize>, // One publish stamp per slot, after the header
     data_ptr: NonNull<u8>,
     capacity: usize,
-    _consumer_id: usize, // MPMC: Consumer ID for registration (not used for tail tracking)
+    cursor: AtomicUsize, // Index of our cursor in the header, registered on first receive
     consumer_tail: AtomicUsize, // MPMC OPTIMIZED: Each consumer tracks tail in LOCAL memory (not shared)
+    dropped: AtomicU64,         // Messages this subscriber skipped after being lapped
+    policy: BackpressurePolicy,
     _phantom: std::marker::PhantomData<T>,
     _padding: [u8; 16], // Pad to prevent false sharing
 }
@@ -41,31 +169,101 @@ pub struct ShmTopic<T> {
 unsafe impl<T: Send> Send for ShmTopic<T> {}
 unsafe impl<T: Send> Sync for ShmTopic<T> {}
 
+/// Handle on a topic's wakeup word that does not need the message type
+///
+/// Lets the scheduler park on the topics a node subscribes to, knowing only
+/// their names.
+pub struct TopicNotifier {
+    _region: Arc<ShmRegion>,
+    header: NonNull<RingBufferHeader>,
+}
+
+unsafe impl Send for TopicNotifier {}
+unsafe impl Sync for TopicNotifier {}
+
+impl TopicNotifier {
+    /// Attach to the wakeup word of an existing topic
+    pub fn open(name: &str) -> HorusResult<Self> {
+        let region = Arc::new(ShmRegion::open(name)?);
+        if region.size() < mem::size_of::<RingBufferHeader>() {
+            return Err("Existing shared memory region too small for header".into());
+        }
+        let header_ptr = region.as_ptr() as *mut RingBufferHeader;
+        if (header_ptr as usize) % mem::align_of::<RingBufferHeader>() != 0 {
+            return Err("Existing header pointer not properly aligned".into());
+        }
+        let header = unsafe { NonNull::new_unchecked(header_ptr) };
+        unsafe { header.as_ref() }.validate_layout(name)?;
+        Ok(Self {
+            _region: region,
+            header,
+        })
+    }
+
+    /// Current publish epoch; changes after every publish on the topic
+    #[inline]
+    pub fn epoch(&self) -> u32 {
+        unsafe { self.header.as_ref() }.notify.epoch()
+    }
+
+    /// Park until any notifier's epoch differs from its paired value, or timeout
+    ///
+    /// Returns true if a change was observed.
+    pub fn wait_any(notifiers: &[(&TopicNotifier, u32)], timeout: Duration) -> bool {
+        let words: Vec<(&NotifyWord, u32)> = notifiers
+            .iter()
+            .map(|(n, seen)| (&unsafe { n.header.as_ref() }.notify, *seen))
+            .collect();
+        notify::wait_any(&words, timeout)
+    }
+}
+
 /// A loaned sample for zero-copy publishing
 /// When dropped, automatically marks the slot as available for consumers
 pub struct PublisherSample<'a, T> {
     data_ptr: *mut T,
     #[allow(dead_code)]
     slot_index: usize,
-    #[allow(dead_code)]
     topic: &'a ShmTopic<T>,
+    /// Monotonic ring position claimed for this sample
+    position: usize,
     _phantom: PhantomData<&'a mut T>,
 }
 
+/// A batch of consecutive loaned slots for zero-copy publishing
+///
+/// Write every slot before dropping the batch: dropping publishes all of
+/// them at once, like `PublisherSample`. Slots left unwritten are marked
+/// as skipped, so subscribers never see them.
+pub struct PublisherBatch<'a, T> {
+    topic: &'a ShmTopic<T>,
+    start: usize,
+    len: usize,
+    written: usize,
+}
+
 /// A received sample for zero-copy consumption  
 /// When dropped, automatically releases the slot
+///
+/// Under `DropOldest` the slot is not locked: a fast producer can wrap around
+/// the ring and overwrite it while the sample is held. Like a seqlock reader,
+/// check `is_valid()` after reading to know whether what was read is intact.
 pub struct ConsumerSample<'a, T> {
     data_ptr: *const T,
     #[allow(dead_code)]
     slot_index: usize,
     #[allow(dead_code)]
     topic: &'a ShmTopic<T>,
+    /// Monotonic ring position of this message
+    position: usize,
     _phantom: PhantomData<&'a T>,
 }
 
 unsafe impl<T: Send> Send for PublisherSample<'_, T> {}
 unsafe impl<T: Sync> Sync for PublisherSample<'_, T> {}
 
+unsafe impl<T: Send> Send for PublisherBatch<'_, T> {}
+
 unsafe impl<T: Send> Send for ConsumerSample<'_, T> {}
 unsafe impl<T: Sync> Sync for ConsumerSample<'_, T> {}
 
@@ -93,6 +291,50 @@ impl<T> PublisherSample<'_, T> {
     }
 }
 
+impl<T> PublisherBatch<'_, T> {
+    /// Number of slots in the batch
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether the batch has no slots
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Number of slots written so far with `write`
+    pub fn written(&self) -> usize {
+        self.written
+    }
+
+    /// Write the next message of the batch; returns Err(value) once all slots are written
+    pub fn write(&mut self, value: T) -> Result<(), T> {
+        if self.written == self.len {
+            return Err(value);
+        }
+        unsafe { std::ptr::write(self.slot_ptr(self.written), value) };
+        self.written += 1;
+        Ok(())
+    }
+
+    /// Get a raw pointer to slot `index` of the batch (for in-place construction)
+    ///
+    /// # Panics
+    ///
+    /// Panics if `index >= len()`.
+    pub fn as_mut_ptr(&mut self, index: usize) -> *mut T {
+        assert!(index < self.len, "batch index {} out of range", index);
+        self.slot_ptr(index)
+    }
+
+    #[inline]
+    fn slot_ptr(&self, index: usize) -> *mut T {
+        // The batch may wrap around the end of the ring
+        let slot = (self.start + index) & (self.topic.capacity - 1);
+        unsafe { self.topic.data_ptr.as_ptr().add(slot * mem::size_of::<T>()) as *mut T }
+    }
+}
+
 impl<T> ConsumerSample<'_, T> {
     /// Get a const reference to the received data
     pub fn get_ref(&self) -> &T {
@@ -111,24 +353,102 @@ impl<T> ConsumerSample<'_, T> {
     {
         unsafe { std::ptr::read(self.data_ptr) }
     }
+
+    /// Clone the message out if the slot is still intact
+    ///
+    /// The slot's bytes are copied out first and validated before anything
+    /// looks at them as a `T`, so `T::clone` never runs on a torn value (which
+    /// could follow garbage heap pointers for `String`/`Vec`). Returns `None`
+    /// if the producer overwrote the slot.
+    pub fn clone_valid(&self) -> Option<T>
+    where
+        T: Clone,
+    {
+        let mut copy = MaybeUninit::<T>::uninit();
+        unsafe { std::ptr::copy_nonoverlapping(self.data_ptr, copy.as_mut_ptr(), 1) };
+        if !self.is_valid() {
+            return None;
+        }
+        // The copy shares the slot's heap pointers, so it is never dropped;
+        // only the clone is handed out
+        Some(unsafe { copy.assume_init_ref() }.clone())
+    }
+
+    /// Check that the producer has not overwritten this slot since it was received
+    ///
+    /// Call after reading: if this returns false the read may be torn and must
+    /// be discarded. Always true under `DropNewest`/`Block`, where producers
+    /// wait for the sample to be dropped before reusing its slot.
+    #[inline]
+    pub fn is_valid(&self) -> bool {
+        let header = unsafe { self.topic.header.as_ref() };
+        // The slot is reused by the claim of position + capacity
+        header
+            .head
+            .value
+            .load(Ordering::Acquire)
+            .wrapping_sub(self.position)
+            <= self.topic.capacity
+    }
+
+    /// Monotonic ring position of this message (publish order)
+    pub fn position(&self) -> usize {
+        self.position
+    }
 }
 
 impl<T> Drop for PublisherSample<'_, T> {
     fn drop(&mut self) {
-        // When the publisher sample is dropped, publish it by updating sequence number
-        let header = unsafe { self.topic.header.as_ref() };
-        header.sequence_number.fetch_add(1, Ordering::Release);
+        // When the publisher sample is dropped, publish it in claim order
+        self.topic.publish(self.position, 1, 1);
+    }
+}
+
+impl<T> Drop for PublisherBatch<'_, T> {
+    fn drop(&mut self) {
+        if self.written < self.len {
+            log::error!(
+                "PublisherBatch dropped with {} of {} slots written; skipping the rest",
+                self.written,
+                self.len
+            );
+        }
+        // Publish the whole batch with a single sequence update
+        self.topic.publish(self.start, self.len, self.written);
     }
 }
 
 impl<T> Drop for ConsumerSample<'_, T> {
     fn drop(&mut self) {
-        // Consumer sample drop is automatic - just releases the reference
-        // The actual slot management is handled by the consumer's tail position
+        // Publish our read position so bounded producers may reuse the slot.
+        // fetch_max keeps the cursor monotonic if samples are dropped out of order.
+        if let Some(cursor) = self.topic.cursor() {
+            cursor
+                .position
+                .fetch_max(self.position + 1, Ordering::Release);
+        }
+    }
+}
+
+impl<T> Drop for ShmTopic<T> {
+    fn drop(&mut self) {
+        if let Some(cursor) = self.cursor() {
+            cursor.state.store(CURSOR_FREE, Ordering::Release);
+            let header = unsafe { self.header.as_ref() };
+            header.meta.consumer_count.fetch_sub(1, Ordering::Relaxed);
+        }
     }
 }
 
 impl<T> ShmTopic<T> {
+    /// Byte offset of the first slot: header, then one stamp per slot, aligned for `T`
+    #[inline]
+    fn data_offset(capacity: usize, element_align: usize) -> usize {
+        let stamps_end =
+            mem::size_of::<RingBufferHeader>() + capacity * mem::size_of::<AtomicUsize>();
+        stamps_end.div_ceil(element_align) * element_align
+    }
+
     /// Round up to next power of 2 for optimal modulo performance
     /// Uses bitwise AND instead of expensive division
     #[inline]
@@ -145,16 +465,30 @@ impl<T> ShmTopic<T> {
 
     /// Create a new ring buffer in shared memory
     pub fn new(name: &str, capacity: usize) -> HorusResult<Self> {
-        Self::new_internal(name, capacity, false)
+        Self::new_internal(name, capacity, false, BackpressurePolicy::default())
+    }
+
+    /// Create a new ring buffer whose producer side applies `policy` when full
+    pub fn new_with_policy(
+        name: &str,
+        capacity: usize,
+        policy: BackpressurePolicy,
+    ) -> HorusResult<Self> {
+        Self::new_internal(name, capacity, false, policy)
     }
 
     /// Create or open a global shared memory topic (accessible across all sessions)
     pub fn new_global(name: &str, capacity: usize) -> HorusResult<Self> {
-        Self::new_internal(name, capacity, true)
+        Self::new_internal(name, capacity, true, BackpressurePolicy::default())
     }
 
     /// Internal function to create topic with optional global flag
-    fn new_internal(name: &str, capacity: usize, global: bool) -> HorusResult<Self> {
+    fn new_internal(
+        name: &str,
+        capacity: usize,
+        global: bool,
+        policy: BackpressurePolicy,
+    ) -> HorusResult<Self> {
         // Safety validation: check capacity bounds
         if capacity < MIN_CAPACITY {
             return Err(format!(
@@ -201,8 +535,8 @@ impl<T> ShmTopic<T> {
             );
         }
 
-        // Ensure data section is properly aligned
-        let aligned_header_size = header_size.div_ceil(element_align) * element_align;
+        // Slot stamps follow the header; ensure data section is properly aligned
+        let aligned_header_size = Self::data_offset(capacity, element_align);
         let total_size = aligned_header_size
             .checked_add(data_size)
             .ok_or("Integer overflow calculating total size")?;
@@ -248,27 +582,46 @@ impl<T> ShmTopic<T> {
         // Otherwise, we would reset consumer_count causing duplicate consumer IDs!
         let actual_capacity = if is_owner {
             unsafe {
-                (*header.as_ptr())
-                    .capacity
-                    .store(capacity, Ordering::Relaxed);
-                (*header.as_ptr()).head.store(0, Ordering::Relaxed);
-                (*header.as_ptr()).tail.store(0, Ordering::Relaxed);
-                (*header.as_ptr())
-                    .element_size
-                    .store(element_size, Ordering::Relaxed);
-                (*header.as_ptr())
-                    .consumer_count
-                    .store(0, Ordering::Relaxed);
-                (*header.as_ptr())
-                    .sequence_number
-                    .store(0, Ordering::Relaxed);
+                let h = &*header.as_ptr();
+                h.meta
+                    .version
+                    .store(TOPIC_LAYOUT_VERSION, Ordering::Relaxed);
+                h.meta.capacity.store(capacity, Ordering::Relaxed);
+                h.meta.element_size.store(element_size, Ordering::Relaxed);
+                h.meta.consumer_count.store(0, Ordering::Relaxed);
+                h.head.value.store(0, Ordering::Relaxed);
+                h.sequence_number.value.store(0, Ordering::Relaxed);
+                let stamps = header_ptr.add(1) as *const AtomicUsize;
+                for slot in 0..capacity {
+                    (*stamps.add(slot)).store(0, Ordering::Relaxed);
+                }
+                h.notify.reset();
                 // MPMC OPTIMIZED: Consumer tails now tracked in local memory (not in header)
-                (*header.as_ptr())._padding = [0; 16]; // Initialize padding for cache alignment
+                for cursor in h.cursors.iter() {
+                    cursor.state.store(CURSOR_FREE, Ordering::Relaxed);
+                    cursor.position.store(0, Ordering::Relaxed);
+                    cursor.dropped.store(0, Ordering::Relaxed);
+                }
+                // Publish the initialized header to processes waiting in validate_layout
+                h.meta.magic.store(TOPIC_MAGIC, Ordering::Release);
             }
             capacity
         } else {
-            // Not owner - read capacity from existing header
-            let existing_capacity = unsafe { (*header.as_ptr()).capacity.load(Ordering::Relaxed) };
+            // Not owner - wait for the creator, then read capacity from existing header
+            unsafe { header.as_ref() }.validate_layout(name)?;
+            let existing_capacity =
+                unsafe { (*header.as_ptr()).meta.capacity.load(Ordering::Relaxed) };
+
+            let existing_element_size =
+                unsafe { (*header.as_ptr()).meta.element_size.load(Ordering::Relaxed) };
+            if existing_element_size != element_size {
+                return Err(format!(
+                    "Topic '{}' element size mismatch: existing={}, requested={} \
+                     (different message type on the same topic?)",
+                    name, existing_element_size, element_size
+                )
+                .into());
+            }
 
             // CRITICAL: Validate existing capacity is power of 2 for bitwise AND optimization
             if !existing_capacity.is_power_of_two() {
@@ -346,34 +699,21 @@ impl<T> ShmTopic<T> {
             NonNull::new_unchecked(raw_ptr)
         };
 
-        // MPMC FIX: Register this consumer and get a unique ID
-        let (consumer_id, current_head) = unsafe {
-            let id = (*header.as_ptr())
-                .consumer_count
-                .fetch_add(1, Ordering::Relaxed);
-
-            // Check if we've exceeded max consumers
-            if id >= MAX_CONSUMERS {
-                return Err(format!(
-                    "Maximum number of consumers ({}) exceeded for topic '{}'",
-                    MAX_CONSUMERS, name
-                )
-                .into());
-            }
-
-            // MPMC OPTIMIZED: Consumer tail will be initialized in local memory below
-            let current_head = (*header.as_ptr()).head.load(Ordering::Relaxed);
-
-            (id, current_head)
-        };
+        // Start reading at the current head. The shared cursor is registered
+        // lazily on first receive so publisher-only handles never hold back
+        // bounded producers.
+        let current_head = unsafe { (*header.as_ptr()).head.value.load(Ordering::Acquire) };
 
         Ok(ShmTopic {
             _region: region,
             header,
+            stamps: unsafe { NonNull::new_unchecked(header.as_ptr().add(1) as *mut AtomicUsize) },
             data_ptr,
             capacity: actual_capacity,
-            _consumer_id: consumer_id, // MPMC: Consumer ID for registration
+            cursor: AtomicUsize::new(CURSOR_UNREGISTERED),
             consumer_tail: AtomicUsize::new(current_head), // MPMC OPTIMIZED: Local tail tracking
+            dropped: AtomicU64::new(0),
+            policy,
             _phantom: std::marker::PhantomData,
             _padding: [0; 16],
         })
@@ -400,8 +740,9 @@ impl<T> ShmTopic<T> {
         }
 
         let header = unsafe { NonNull::new_unchecked(header_ptr) };
+        unsafe { header.as_ref() }.validate_layout(name)?;
 
-        let capacity = unsafe { (*header.as_ptr()).capacity.load(Ordering::Relaxed) };
+        let capacity = unsafe { (*header.as_ptr()).meta.capacity.load(Ordering::Relaxed) };
 
         // Validate capacity is within safe bounds
         if !(MIN_CAPACITY..=MAX_CAPACITY).contains(&capacity) {
@@ -414,7 +755,7 @@ impl<T> ShmTopic<T> {
 
         // Validate element size matches
         let stored_element_size =
-            unsafe { (*header.as_ptr()).element_size.load(Ordering::Relaxed) };
+            unsafe { (*header.as_ptr()).meta.element_size.load(Ordering::Relaxed) };
         let expected_element_size = mem::size_of::<T>();
         if stored_element_size != expected_element_size {
             return Err(format!(
@@ -445,8 +786,7 @@ impl<T> ShmTopic<T> {
         });
 
         let element_align = mem::align_of::<T>();
-        let header_size = mem::size_of::<RingBufferHeader>();
-        let aligned_header_size = header_size.div_ceil(element_align) * element_align;
+        let aligned_header_size = Self::data_offset(capacity, element_align);
 
         let data_ptr = unsafe {
             let raw_ptr = (region.as_ptr() as *mut u8).add(aligned_header_size);
@@ -485,285 +825,176 @@ impl<T> ShmTopic<T> {
             NonNull::new_unchecked(raw_ptr)
         };
 
-        // MPMC FIX: Register as a new consumer and get current head position to start from
-        let (consumer_id, current_head) = unsafe {
-            let id = (*header.as_ptr())
-                .consumer_count
-                .fetch_add(1, Ordering::Relaxed);
-
-            // Check if we've exceeded max consumers
-            if id >= MAX_CONSUMERS {
-                return Err(format!(
-                    "Maximum number of consumers ({}) exceeded for topic '{}'",
-                    MAX_CONSUMERS, name
-                )
-                .into());
-            }
-
-            let head = (*header.as_ptr()).head.load(Ordering::Relaxed);
-
-            // MPMC OPTIMIZED: Consumer tail will be initialized in local memory below
-
-            (id, head)
-        };
+        // Start reading at the current head; the cursor is registered on first receive
+        let current_head = unsafe { (*header.as_ptr()).head.value.load(Ordering::Acquire) };
 
         Ok(ShmTopic {
             _region: region,
             header,
+            stamps: unsafe { NonNull::new_unchecked(header.as_ptr().add(1) as *mut AtomicUsize) },
             data_ptr,
             capacity,
-            _consumer_id: consumer_id, // MPMC: Consumer ID for registration
+            cursor: AtomicUsize::new(CURSOR_UNREGISTERED),
             consumer_tail: AtomicUsize::new(current_head), // MPMC OPTIMIZED: Local tail tracking
+            dropped: AtomicU64::new(0),
+            policy: BackpressurePolicy::default(),
             _phantom: std::marker::PhantomData,
             _padding: [0; 16],
         })
     }
 
-    /// Push a message; returns Err(msg) if the buffer is full
+    /// Push a message; returns Err(msg) if the backpressure policy rejects it
     /// Thread-safe for multiple producers
-    /// Uses sequence numbering instead of tail checking for multi-consumer safety
     pub fn push(&self, msg: T) -> Result<(), T> {
-        let header = unsafe { self.header.as_ref() };
-
-        loop {
-            let head = header.head.load(Ordering::Relaxed);
-            // PERFORMANCE: Use bitwise AND instead of modulo (capacity is power of 2)
-            let next = (head + 1) & (self.capacity - 1);
-
-            // For multi-consumer, we need to check if buffer would wrap around
-            // and potentially overwrite unread messages. For now, use a simple
-            // heuristic: don't fill more than 75% of buffer capacity
-            let current_sequence = header.sequence_number.load(Ordering::Relaxed);
-            let max_unread = (self.capacity * 3) / 4; // Allow 75% fill
-
-            if current_sequence >= max_unread
-                && current_sequence - header.sequence_number.load(Ordering::Relaxed) >= max_unread
-            {
-                // Buffer getting too full for safe multi-consumer operation
-                return Err(msg);
-            }
-
-            // Try to claim this slot atomically
-            match header.head.compare_exchange_weak(
-                head,
-                next,
-                Ordering::Release,
-                Ordering::Relaxed,
-            ) {
-                Ok(_) => {
-                    // Successfully claimed slot, now write data with comprehensive bounds checking
-                    unsafe {
-                        // Comprehensive bounds checking
-                        if head >= self.capacity {
-                            // This should never happen due to modulo arithmetic, but be extra safe
-                            eprintln!(
-                                "Critical safety violation: head index {} >= capacity {}",
-                                head, self.capacity
-                            );
-                            return Err(msg);
-                        }
-
-                        // Calculate byte offset and verify it's within bounds
-                        let byte_offset = head * mem::size_of::<T>();
-                        let slot_ptr = self.data_ptr.as_ptr().add(byte_offset) as *mut T;
-
-                        // Verify the write location is within our data region
-                        let data_region_size = self.capacity * mem::size_of::<T>();
-                        if byte_offset + mem::size_of::<T>() > data_region_size {
-                            eprintln!(
-                                "Critical safety violation: write would exceed data region bounds"
-                            );
-                            return Err(msg);
-                        }
-
-                        // Safe to write now that we've verified bounds
-                        std::ptr::write(slot_ptr, msg);
-                    }
+        let Some(position) = self.claim_positions(1) else {
+            return Err(msg);
+        };
 
-                    // Increment global sequence number
-                    header.sequence_number.fetch_add(1, Ordering::Relaxed);
-                    return Ok(());
-                }
-                Err(_) => {
-                    // Another thread updated head, retry
-                    continue;
-                }
-            }
+        // PERFORMANCE: Use bitwise AND instead of modulo (capacity is power of 2)
+        let slot = position & (self.capacity - 1);
+        unsafe {
+            let slot_ptr = self.data_ptr.as_ptr().add(slot * mem::size_of::<T>()) as *mut T;
+            std::ptr::write(slot_ptr, msg);
         }
+
+        // Publish: readers only see positions below the sequence number
+        self.publish(position, 1, 1);
+        Ok(())
     }
 
     /// Pop a message; returns None if the buffer is empty
-    /// MPMC FIX: Thread-safe for multiple consumers - each consumer tracks position in shared memory
+    /// MPMC FIX: Thread-safe for multiple consumers - each consumer tracks its own position
     pub fn pop(&self) -> Option<T>
     where
         T: Clone,
     {
-        let header = unsafe { self.header.as_ref() };
-
-        // MPMC OPTIMIZED: Get this consumer's current tail position from LOCAL MEMORY
-        let my_tail = self.consumer_tail.load(Ordering::Relaxed);
-        let current_head = header.head.load(Ordering::Acquire); // Synchronize with producer's Release
-
-        // Validate tail position is within bounds
-        if my_tail >= self.capacity {
-            eprintln!(
-                "Critical safety violation: consumer tail {} >= capacity {}",
-                my_tail, self.capacity
-            );
-            return None;
-        }
-
-        // Validate head position is within bounds
-        if current_head >= self.capacity {
-            eprintln!(
-                "Critical safety violation: head {} >= capacity {}",
-                current_head, self.capacity
-            );
-            return None;
-        }
-
-        if my_tail == current_head {
-            // No new messages for this consumer
-            return None;
-        }
-
-        // Calculate next position for this consumer
-        // PERFORMANCE: Use bitwise AND instead of modulo (capacity is power of 2)
-        let next_tail = (my_tail + 1) & (self.capacity - 1);
-
-        // MPMC OPTIMIZED: Update this consumer's tail position in LOCAL MEMORY
-        self.consumer_tail.store(next_tail, Ordering::Relaxed);
-
-        // Read the message (non-destructive - message stays for other consumers)
-        // Bounds already validated above
-        let msg = unsafe {
-            // Calculate byte offset and verify it's within bounds
-            let byte_offset = my_tail * mem::size_of::<T>();
-            let slot_ptr = self.data_ptr.as_ptr().add(byte_offset) as *const T;
-
-            // Verify the read location is within our data region
-            let data_region_size = self.capacity * mem::size_of::<T>();
-            if byte_offset + mem::size_of::<T>() > data_region_size {
-                eprintln!("Critical safety violation: read would exceed data region bounds");
-                return None;
-            }
-
-            // MPMC CRITICAL FIX: Clone instead of read (move) to avoid double-free
-            // Multiple consumers must be able to read the same slot
-            (*slot_ptr).clone()
-        };
-
-        Some(msg)
+        // MPMC CRITICAL FIX: Clone instead of read (move) to avoid double-free
+        // Multiple consumers must be able to read the same slot
+        self.receive().and_then(|sample| sample.clone_valid())
     }
 
     /// Loan a slot in the shared memory for zero-copy publishing
     /// Returns a PublisherSample that provides direct access to shared memory
+    ///
+    /// Fails only when the backpressure policy rejects the message.
     pub fn loan(&self) -> crate::error::HorusResult<PublisherSample<'_, T>> {
-        let header = unsafe { self.header.as_ref() };
+        let position = self.claim_positions(1).ok_or_else(|| {
+            format!(
+                "Topic full: slowest subscriber is {} messages behind ({:?})",
+                self.capacity, self.policy
+            )
+        })?;
 
-        loop {
-            let head = header.head.load(Ordering::Relaxed);
-            // PERFORMANCE: Use bitwise AND instead of modulo (capacity is power of 2)
-            let next = (head + 1) & (self.capacity - 1);
-
-            // Try to claim this slot atomically
-            // Note: Buffer full checking removed (was buggy - sequence_number increments forever)
-            match header.head.compare_exchange_weak(
-                head,
-                next,
-                Ordering::Acquire, // Synchronize with consumers
-                Ordering::Relaxed,
-            ) {
-                Ok(_) => {
-                    // Successfully claimed slot, return sample pointing to it
-                    unsafe {
-                        // Bounds checking
-                        if head >= self.capacity {
-                            eprintln!(
-                                "Critical safety violation: head index {} >= capacity {}",
-                                head, self.capacity
-                            );
-                            return Err(format!(
-                                "Head index {} >= capacity {}",
-                                head, self.capacity
-                            )
-                            .into());
-                        }
-
-                        let byte_offset = head * mem::size_of::<T>();
-                        let data_ptr = self.data_ptr.as_ptr().add(byte_offset) as *mut T;
-
-                        // Prefetch the data slot we're about to write to (reduces write latency)
-                        #[cfg(target_arch = "x86_64")]
-                        {
-                            use std::arch::x86_64::{_mm_prefetch, _MM_HINT_T0};
-                            _mm_prefetch(data_ptr as *const i8, _MM_HINT_T0);
-                        }
-
-                        // Verify bounds
-                        let data_region_size = self.capacity * mem::size_of::<T>();
-                        if byte_offset + mem::size_of::<T>() > data_region_size {
-                            eprintln!(
-                                "Critical safety violation: loan would exceed data region bounds"
-                            );
-                            return Err("Loan would exceed data region bounds".into());
-                        }
-
-                        return Ok(PublisherSample {
-                            data_ptr,
-                            slot_index: head,
-                            topic: self,
-                            _phantom: PhantomData,
-                        });
-                    }
-                }
-                Err(_) => {
-                    // Another thread updated head, retry
-                    continue;
-                }
+        // PERFORMANCE: Use bitwise AND instead of modulo (capacity is power of 2)
+        let slot = position & (self.capacity - 1);
+        unsafe {
+            let data_ptr = self.data_ptr.as_ptr().add(slot * mem::size_of::<T>()) as *mut T;
+
+            // Prefetch the data slot we're about to write to (reduces write latency)
+            #[cfg(target_arch = "x86_64")]
+            {
+                use std::arch::x86_64::{_mm_prefetch, _MM_HINT_T0};
+                _mm_prefetch(data_ptr as *const i8, _MM_HINT_T0);
             }
+
+            Ok(PublisherSample {
+                data_ptr,
+                slot_index: slot,
+                topic: self,
+                position,
+                _phantom: PhantomData,
+            })
         }
     }
 
+    /// Loan `n` consecutive slots for zero-copy publishing with one atomic claim
+    ///
+    /// All `n` messages become visible to subscribers together when the batch
+    /// is dropped, so a node publishing many messages per tick pays one
+    /// synchronization instead of one per message. Under `DropNewest`/`Block`
+    /// the whole batch is accepted or rejected.
+    pub fn loan_n(&self, n: usize) -> crate::error::HorusResult<PublisherBatch<'_, T>> {
+        if n == 0 || n > self.capacity {
+            return Err(format!(
+                "Batch of {} messages does not fit topic capacity {}",
+                n, self.capacity
+            )
+            .into());
+        }
+
+        let start = self.claim_positions(n).ok_or_else(|| {
+            format!(
+                "Topic full: no room for a batch of {} messages ({:?})",
+                n, self.policy
+            )
+        })?;
+
+        Ok(PublisherBatch {
+            topic: self,
+            start,
+            len: n,
+            written: 0,
+        })
+    }
+
     /// Receive a message using zero-copy access
     /// Returns a ConsumerSample that provides direct access to shared memory
     pub fn receive(&self) -> Option<ConsumerSample<'_, T>> {
         let header = unsafe { self.header.as_ref() };
 
-        // MPMC OPTIMIZED: Get this consumer's current tail position from LOCAL MEMORY
-        let my_tail = self.consumer_tail.load(Ordering::Relaxed);
-        let current_head = header.head.load(Ordering::Acquire);
+        if self.cursor.load(Ordering::Relaxed) == CURSOR_UNREGISTERED {
+            self.register_cursor();
+        }
 
-        // Validate positions
-        if my_tail >= self.capacity {
-            eprintln!(
-                "Critical safety violation: consumer tail {} >= capacity {}",
-                my_tail, self.capacity
-            );
+        // MPMC OPTIMIZED: Get this consumer's current position from LOCAL MEMORY
+        let mut position = self.consumer_tail.load(Ordering::Relaxed);
+        let published = header.sequence_number.value.load(Ordering::Acquire);
+        if position >= published {
+            // No new messages for this consumer
             return None;
         }
 
-        if current_head >= self.capacity {
-            eprintln!(
-                "Critical safety violation: head {} >= capacity {}",
-                current_head, self.capacity
-            );
-            return None;
+        // Lapped by the producer: skip to the oldest slot that is still intact
+        let claimed = header.head.value.load(Ordering::Acquire);
+        let behind = claimed.wrapping_sub(position);
+        if behind > self.capacity {
+            let skipped = behind - self.capacity;
+            position += skipped;
+            self.dropped.fetch_add(skipped as u64, Ordering::Relaxed);
+            if let Some(cursor) = self.cursor() {
+                cursor.dropped.fetch_add(skipped as u64, Ordering::Relaxed);
+            }
+            if position >= published {
+                self.consumer_tail.store(position, Ordering::Relaxed);
+                return None;
+            }
         }
 
-        if my_tail == current_head {
-            // No new messages for this consumer
+        // Step over positions a producer claimed but never wrote
+        let skipped_from = position;
+        while position < published
+            && self.stamp(position).load(Ordering::Acquire) == slot_stamp(position) | STAMP_SKIP
+        {
+            position += 1;
+        }
+        if position >= published {
+            self.consumer_tail.store(position, Ordering::Relaxed);
+            if position > skipped_from {
+                if let Some(cursor) = self.cursor() {
+                    cursor.position.fetch_max(position, Ordering::Release);
+                }
+            }
             return None;
         }
 
-        // Calculate next position for this consumer and update in local memory
-        let next_tail = (my_tail + 1) % self.capacity;
-        self.consumer_tail.store(next_tail, Ordering::Relaxed);
+        // The shared cursor advances when the sample is dropped, not here,
+        // so bounded producers cannot overwrite a slot that is still borrowed
+        self.consumer_tail.store(position + 1, Ordering::Relaxed);
 
         // Return sample pointing to the message in shared memory
+        let slot = position & (self.capacity - 1);
         unsafe {
-            let byte_offset = my_tail * mem::size_of::<T>();
-            let data_ptr = self.data_ptr.as_ptr().add(byte_offset) as *const T;
+            let data_ptr = self.data_ptr.as_ptr().add(slot * mem::size_of::<T>()) as *const T;
 
             // Prefetch the data we're about to read (reduces read latency)
             #[cfg(target_arch = "x86_64")]
@@ -772,22 +1003,324 @@ impl<T> ShmTopic<T> {
                 _mm_prefetch(data_ptr as *const i8, _MM_HINT_T0);
             }
 
-            // Verify bounds
-            let data_region_size = self.capacity * mem::size_of::<T>();
-            if byte_offset + mem::size_of::<T>() > data_region_size {
-                eprintln!("Critical safety violation: receive would exceed data region bounds");
-                return None;
-            }
-
             Some(ConsumerSample {
                 data_ptr,
-                slot_index: my_tail,
+                slot_index: slot,
                 topic: self,
+                position,
                 _phantom: PhantomData,
             })
         }
     }
 
+    /// Receive a message and run `f` on it in place, without copying it out
+    ///
+    /// Returns `None` if there is no new message. Returns `Some(None)` if the
+    /// producer overwrote the slot while `f` was running; the result is then
+    /// discarded because `f` may have observed a torn value. Only use this
+    /// with types that are safe to read while being overwritten (plain data
+    /// without heap pointers) if the producer can lap the consumer.
+    #[inline]
+    pub fn receive_with<R, F>(&self, f: F) -> Option<Option<R>>
+    where
+        F: FnOnce(&T) -> R,
+    {
+        let sample = self.receive()?;
+        let result = f(sample.get_ref());
+        Some(sample.is_valid().then_some(result))
+    }
+
+    /// Whether a message is waiting for this subscriber
+    #[inline]
+    pub fn has_pending(&self) -> bool {
+        let header = unsafe { self.header.as_ref() };
+        header.sequence_number.value.load(Ordering::Acquire)
+            > self.consumer_tail.load(Ordering::Relaxed)
+    }
+
+    /// Block until a message is waiting for this subscriber or `timeout` expires
+    ///
+    /// Parks on the topic's futex word instead of polling, so an idle
+    /// subscriber uses no CPU and wakes within microseconds of a publish.
+    /// Returns true if a message is pending.
+    pub fn wait_for_data(&self, timeout: Duration) -> bool {
+        let header = unsafe { self.header.as_ref() };
+        let deadline = Instant::now() + timeout;
+        loop {
+            let seen = header.notify.epoch();
+            if self.has_pending() {
+                return true;
+            }
+            let now = Instant::now();
+            if now >= deadline {
+                return false;
+            }
+            notify::wait_any(&[(&header.notify, seen)], deadline - now);
+        }
+    }
+
+    /// Type-erased handle on this topic's wakeup word
+    pub fn notifier(&self) -> TopicNotifier {
+        TopicNotifier {
+            _region: self._region.clone(),
+            header: self.header,
+        }
+    }
+
+    /// Number of slots in the ring (rounded up to a power of two)
+    pub fn capacity(&self) -> usize {
+        self.capacity
+    }
+
+    /// Backpressure policy applied by this handle when publishing
+    pub fn policy(&self) -> BackpressurePolicy {
+        self.policy
+    }
+
+    /// Messages this subscriber skipped because a producer lapped it
+    pub fn dropped_count(&self) -> u64 {
+        self.dropped.load(Ordering::Relaxed)
+    }
+
+    /// Lag and drop counters for every registered subscriber of this topic
+    pub fn subscriber_lag(&self) -> Vec<SubscriberLag> {
+        let header = unsafe { self.header.as_ref() };
+        let published = header.sequence_number.value.load(Ordering::Acquire);
+        header
+            .cursors
+            .iter()
+            .enumerate()
+            .filter(|(_, c)| c.state.load(Ordering::Acquire) == CURSOR_ACTIVE)
+            .map(|(consumer_id, c)| SubscriberLag {
+                consumer_id,
+                pid: c.pid.load(Ordering::Relaxed),
+                lag: published.saturating_sub(c.position.load(Ordering::Acquire)),
+                dropped: c.dropped.load(Ordering::Relaxed),
+            })
+            .collect()
+    }
+
+    /// Our cursor in the shared header, if we registered one
+    #[inline]
+    fn cursor(&self) -> Option<&ConsumerCursor> {
+        let index = self.cursor.load(Ordering::Relaxed);
+        if index < MAX_CONSUMERS {
+            let header = unsafe { self.header.as_ref() };
+            Some(&header.cursors[index])
+        } else {
+            None
+        }
+    }
+
+    /// Claim a free cursor slot so producers can see how far behind we are
+    ///
+    /// If all slots are taken the subscriber keeps working unregistered:
+    /// it is simply invisible to bounded producers.
+    fn register_cursor(&self) {
+        let header = unsafe { self.header.as_ref() };
+        let position = self.consumer_tail.load(Ordering::Relaxed);
+
+        for (index, cursor) in header.cursors.iter().enumerate() {
+            if cursor
+                .state
+                .compare_exchange(
+                    CURSOR_FREE,
+                    CURSOR_INIT,
+                    Ordering::Acquire,
+                    Ordering::Relaxed,
+                )
+                .is_err()
+            {
+                continue;
+            }
+
+            cursor.pid.store(std::process::id(), Ordering::Relaxed);
+            cursor.position.store(position, Ordering::Relaxed);
+            cursor.dropped.store(0, Ordering::Relaxed);
+
+            // Another thread sharing this handle may have registered first
+            if self
+                .cursor
+                .compare_exchange(
+                    CURSOR_UNREGISTERED,
+                    index,
+                    Ordering::AcqRel,
+                    Ordering::Relaxed,
+                )
+                .is_err()
+            {
+                cursor.state.store(CURSOR_FREE, Ordering::Release);
+                return;
+            }
+
+            cursor.state.store(CURSOR_ACTIVE, Ordering::Release);
+            header.meta.consumer_count.fetch_add(1, Ordering::Relaxed);
+            return;
+        }
+
+        log::warn!(
+            "Topic has {} registered subscribers already; this one is not tracked for backpressure",
+            MAX_CONSUMERS
+        );
+        let _ = self.cursor.compare_exchange(
+            CURSOR_UNREGISTERED,
+            CURSOR_UNAVAILABLE,
+            Ordering::AcqRel,
+            Ordering::Relaxed,
+        );
+    }
+
+    /// Claim `n` consecutive monotonic write positions with a single atomic,
+    /// applying the backpressure policy
+    ///
+    /// Returns the first claimed position, or None if the messages must be
+    /// rejected. Callers guarantee `1 <= n <= capacity`.
+    #[inline]
+    fn claim_positions(&self, n: usize) -> Option<usize> {
+        let header = unsafe { self.header.as_ref() };
+        match self.policy {
+            BackpressurePolicy::DropOldest => {
+                Some(header.head.value.fetch_add(n, Ordering::AcqRel))
+            }
+            BackpressurePolicy::DropNewest => self.try_claim_bounded(header, n).or_else(|| {
+                self.reap_dead_cursors(header)
+                    .then(|| self.try_claim_bounded(header, n))
+                    .flatten()
+            }),
+            BackpressurePolicy::Block { timeout } => {
+                if let Some(position) = self.try_claim_bounded(header, n) {
+                    return Some(position);
+                }
+                self.reap_dead_cursors(header);
+
+                let deadline = Instant::now() + timeout;
+                let mut spins = 0u32;
+                loop {
+                    if let Some(position) = self.try_claim_bounded(header, n) {
+                        return Some(position);
+                    }
+                    if spins < BLOCK_SPIN_LIMIT {
+                        spins += 1;
+                        std::hint::spin_loop();
+                    } else if Instant::now() >= deadline {
+                        return None;
+                    } else {
+                        std::thread::yield_now();
+                    }
+                }
+            }
+        }
+    }
+
+    /// Claim `n` positions only if no registered subscriber would be lapped
+    #[inline]
+    fn try_claim_bounded(&self, header: &RingBufferHeader, n: usize) -> Option<usize> {
+        loop {
+            let head = header.head.value.load(Ordering::Acquire);
+            let full = header.cursors.iter().any(|c| {
+                c.state.load(Ordering::Acquire) == CURSOR_ACTIVE
+                    && head.wrapping_sub(c.position.load(Ordering::Acquire)) + n > self.capacity
+            });
+            if full {
+                return None;
+            }
+
+            if header
+                .head
+                .value
+                .compare_exchange_weak(head, head + n, Ordering::AcqRel, Ordering::Relaxed)
+                .is_ok()
+            {
+                return Some(head);
+            }
+        }
+    }
+
+    /// Free cursors left behind by crashed subscriber processes
+    ///
+    /// Only called when the ring is full, so the liveness check stays off the
+    /// hot path. Returns true if any cursor was freed.
+    fn reap_dead_cursors(&self, header: &RingBufferHeader) -> bool {
+        let mut reaped = false;
+        for cursor in header.cursors.iter() {
+            if cursor.state.load(Ordering::Acquire) != CURSOR_ACTIVE {
+                continue;
+            }
+            let pid = cursor.pid.load(Ordering::Relaxed);
+            if pid != std::process::id()
+                && !is_process_running(pid)
+                && cursor
+                    .state
+                    .compare_exchange(
+                        CURSOR_ACTIVE,
+                        CURSOR_FREE,
+                        Ordering::AcqRel,
+                        Ordering::Relaxed,
+                    )
+                    .is_ok()
+            {
+                header.meta.consumer_count.fetch_sub(1, Ordering::Relaxed);
+                reaped = true;
+            }
+        }
+        reaped
+    }
+
+    /// Publish stamp word of the slot that holds `position`
+    #[inline]
+    fn stamp(&self, position: usize) -> &AtomicUsize {
+        unsafe { &*self.stamps.as_ptr().add(position & (self.capacity - 1)) }
+    }
+
+    /// Mark `n` claimed positions from `start` as published and advance the
+    /// sequence number over every leading position that is
+    ///
+    /// Only the first `written` positions hold messages; the rest are stamped
+    /// as skipped so they still unblock later producers.
+    ///
+    /// The sequence number never passes a position whose producer has not
+    /// finished, so readers cannot see a claimed but unwritten slot. Whoever
+    /// stamps the last missing position of a run publishes the whole run;
+    /// nobody waits for a slower producer.
+    fn publish(&self, start: usize, n: usize, written: usize) {
+        for (i, position) in (start..start + n).enumerate() {
+            let skip = if i < written { 0 } else { STAMP_SKIP };
+            // SeqCst pairs with the loads in `advance_sequence`: either we see
+            // the advancing producer's new sequence, or it sees our stamp
+            self.stamp(position)
+                .fetch_max(slot_stamp(position) | skip, Ordering::SeqCst);
+        }
+        self.advance_sequence();
+        unsafe { self.header.as_ref() }.notify.notify();
+    }
+
+    fn advance_sequence(&self) {
+        let header = unsafe { self.header.as_ref() };
+        let mut sequence = header.sequence_number.value.load(Ordering::SeqCst);
+        loop {
+            let mut end = sequence;
+            // A greater stamp means a later lap already reused the slot under
+            // DropOldest; that position is lost either way, so step over it
+            while end - sequence < self.capacity
+                && self.stamp(end).load(Ordering::SeqCst) >= slot_stamp(end)
+            {
+                end += 1;
+            }
+            if end == sequence {
+                return;
+            }
+            match header.sequence_number.value.compare_exchange(
+                sequence,
+                end,
+                Ordering::SeqCst,
+                Ordering::SeqCst,
+            ) {
+                Ok(_) => return,
+                Err(current) => sequence = current,
+            }
+        }
+    }
+
     /// Loan a slot and immediately write data (convenience method)
     /// This is equivalent to loan() followed by write(), but more convenient
     pub fn loan_and_write(&self, value: T) -> Result<(), T> {
@@ -4,10 +4,12 @@
 
 use crate::error::{HorusError, HorusResult};
 use regex;
+use serde::de::DeserializeOwned;
 use serde::{Deserialize, Serialize};
 use serde_json::Value;
 use std::collections::BTreeMap;
 use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::{Arc, RwLock};
 
 /// Validation rules for parameter values
@@ -52,11 +54,113 @@ pub struct RuntimeParams {
     metadata: Arc<RwLock<BTreeMap<String, ParamMetadata>>>,
     /// Version tracking for optimistic locking (concurrent edit protection)
     versions: Arc<RwLock<BTreeMap<String, u64>>>,
+    /// Change cells shared with outstanding `ParamHandle`s, created on demand
+    cells: Arc<RwLock<BTreeMap<String, Arc<ParamCell>>>>,
+    /// Bumped after every change to any parameter
+    epoch: Arc<AtomicU64>,
     /// Optional persistence path
     persist_path: Option<PathBuf>,
 }
 
+/// Latest value of one key plus a counter bumped whenever it changes
+struct ParamCell {
+    epoch: AtomicU64,
+    value: RwLock<Option<Value>>,
+}
+
+impl ParamCell {
+    fn store(&self, value: Option<Value>) {
+        if let Ok(mut slot) = self.value.write() {
+            *slot = value;
+        }
+        // Release pairs with the Acquire in ParamHandle::has_changed
+        self.epoch.fetch_add(1, Ordering::Release);
+    }
+}
+
+/// Typed, cached handle to a single parameter
+///
+/// Obtain one at init with [`RuntimeParams::handle`] and keep it in the node.
+/// Reading is a single atomic load while the parameter is unchanged; the
+/// value is only deserialized again after `set`, `remove`, `reset` or a
+/// reload touched the key.
+///
+/// ```ignore
+/// let mut max_speed = params.handle("max_speed", 1.0f64);
+/// // in tick():
+/// let v = *max_speed.get();
+/// ```
+#[derive(Clone)]
+pub struct ParamHandle<T> {
+    key: String,
+    cell: Arc<ParamCell>,
+    default: T,
+    cached: T,
+    seen: u64,
+}
+
+impl<T: DeserializeOwned + Clone> ParamHandle<T> {
+    /// Current value, refreshed if the parameter changed since the last call
+    ///
+    /// Falls back to the default if the key is missing or has the wrong type.
+    #[inline]
+    pub fn get(&mut self) -> &T {
+        self.refresh();
+        &self.cached
+    }
+
+    /// Re-read the value if it changed; returns true if it did
+    #[inline]
+    pub fn refresh(&mut self) -> bool {
+        let epoch = self.cell.epoch.load(Ordering::Acquire);
+        if epoch == self.seen {
+            return false;
+        }
+        self.seen = epoch;
+        self.cached = self
+            .cell
+            .value
+            .read()
+            .ok()
+            .and_then(|v| v.as_ref().and_then(|v| T::deserialize(v).ok()))
+            .unwrap_or_else(|| self.default.clone());
+        true
+    }
+
+    /// Whether the parameter changed since the value was last read
+    #[inline]
+    pub fn has_changed(&self) -> bool {
+        self.cell.epoch.load(Ordering::Acquire) != self.seen
+    }
+
+    /// Parameter key this handle reads
+    pub fn key(&self) -> &str {
+        &self.key
+    }
+}
+
+impl<T: std::fmt::Debug> std::fmt::Debug for ParamHandle<T> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("ParamHandle")
+            .field("key", &self.key)
+            .field("cached", &self.cached)
+            .field("seen", &self.seen)
+            .finish()
+    }
+}
+
 impl RuntimeParams {
+    fn from_map(params: BTreeMap<String, Value>, persist_path: Option<PathBuf>) -> Self {
+        Self {
+            params: Arc::new(RwLock::new(params)),
+            metadata: Arc::new(RwLock::new(BTreeMap::new())),
+            versions: Arc::new(RwLock::new(BTreeMap::new())),
+            cells: Arc::new(RwLock::new(BTreeMap::new())),
+            epoch: Arc::new(AtomicU64::new(0)),
+            persist_path,
+        }
+    }
+
     /// Create new parameter store with defaults
     pub fn init() -> HorusResult<Self> {
         let mut initial_params = BTreeMap::new();
@@ -97,12 +201,7 @@ impl RuntimeParams {
             initial_params.insert("pid_kd".to_string(), Value::from(0.05));
         }
 
-        Ok(Self {
-            params: Arc::new(RwLock::new(initial_params)),
-            metadata: Arc::new(RwLock::new(BTreeMap::new())),
-            versions: Arc::new(RwLock::new(BTreeMap::new())),
-            persist_path: Some(params_file),
-        })
+        Ok(Self::from_map(initial_params, Some(params_file)))
     }
 
     /// Set default parameters
@@ -191,6 +290,8 @@ impl RuntimeParams {
         // Set new value and increment version
         let mut params = self.params.write()?;
         params.insert(key.to_string(), json_value.clone());
+        // Publish under the map lock so handles never see an older value win
+        self.publish(key, Some(json_value.clone()));
         drop(params);
 
         // Increment version for concurrent edit protection
@@ -228,7 +329,12 @@ impl RuntimeParams {
 
     /// Remove a parameter
     pub fn remove(&self, key: &str) -> Option<Value> {
-        self.params.write().ok()?.remove(key)
+        let mut params = self.params.write().ok()?;
+        let removed = params.remove(key);
+        if removed.is_some() {
+            self.publish(key, None);
+        }
+        removed
     }
 
     /// Clear all parameters and reset to defaults
@@ -237,9 +343,69 @@ impl RuntimeParams {
         params.clear();
         drop(params);
         self.set_defaults()?;
+        self.republish_all();
         Ok(())
     }
 
+    /// Get a typed handle that caches `key` and refreshes only when it changes
+    ///
+    /// `default` is used while the key is missing or cannot be converted to `T`.
+    pub fn handle<T: DeserializeOwned + Clone>(&self, key: &str, default: T) -> ParamHandle<T> {
+        // Lock order is always params, then cells
+        let cell = {
+            let params = self.params.read().unwrap_or_else(|e| e.into_inner());
+            let mut cells = self.cells.write().unwrap_or_else(|e| e.into_inner());
+            cells
+                .entry(key.to_string())
+                .or_insert_with(|| {
+                    let current = params.get(key).cloned();
+                    Arc::new(ParamCell {
+                        // Start at 1 so a fresh handle (seen = 0) loads on first get()
+                        epoch: AtomicU64::new(1),
+                        value: RwLock::new(current),
+                    })
+                })
+                .clone()
+        };
+        ParamHandle {
+            key: key.to_string(),
+            cell,
+            cached: default.clone(),
+            default,
+            seen: 0,
+        }
+    }
+
+    /// Counter bumped after every change to any parameter
+    ///
+    /// Compare against a previously seen value to cheaply detect changes.
+    #[inline]
+    pub fn epoch(&self) -> u64 {
+        self.epoch.load(Ordering::Acquire)
+    }
+
+    /// Push a new value to the key's handles, if any, and bump the epochs
+    ///
+    /// Called with the params lock held.
+    fn publish(&self, key: &str, value: Option<Value>) {
+        if let Ok(cells) = self.cells.read() {
+            if let Some(cell) = cells.get(key) {
+                cell.store(value);
+            }
+        }
+        self.epoch.fetch_add(1, Ordering::Release);
+    }
+
+    /// Refresh every handle after a bulk change (reset or reload)
+    fn republish_all(&self) {
+        if let (Ok(params), Ok(cells)) = (self.params.read(), self.cells.read()) {
+            for (key, cell) in cells.iter() {
+                cell.store(params.get(key).cloned());
+            }
+        }
+        self.epoch.fetch_add(1, Ordering::Release);
+    }
+
     /// Set metadata for a parameter
     pub fn set_metadata(&self, key: &str, metadata: ParamMetadata) -> Result<(), HorusError> {
         let mut meta_map = self.metadata.write()?;
@@ -450,6 +616,8 @@ impl RuntimeParams {
 
             let mut params = self.params.write()?;
             *params = loaded;
+            drop(params);
+            self.republish_all();
         }
         Ok(())
     }
@@ -461,6 +629,8 @@ impl Clone for RuntimeParams {
             params: self.params.clone(),
             metadata: self.metadata.clone(),
             versions: self.versions.clone(),
+            cells: self.cells.clone(),
+            epoch: self.epoch.clone(),
             persist_path: self.persist_path.clone(),
         }
     }
@@ -473,12 +643,7 @@ impl Default for RuntimeParams {
                 "Warning: Failed to initialize RuntimeParams: {}. Using empty params.",
                 e
             );
-            Self {
-                params: Arc::new(RwLock::new(BTreeMap::new())),
-                metadata: Arc::new(RwLock::new(BTreeMap::new())),
-                versions: Arc::new(RwLock::new(BTreeMap::new())),
-                persist_path: None,
-            }
+            Self::from_map(BTreeMap::new(), None)
         })
     }
 }
@@ -490,12 +655,7 @@ mod tests {
     use tempfile::TempDir;
 
     fn create_test_params() -> RuntimeParams {
-        RuntimeParams {
-            params: Arc::new(RwLock::new(BTreeMap::new())),
-            metadata: Arc::new(RwLock::new(BTreeMap::new())),
-            versions: Arc::new(RwLock::new(BTreeMap::new())),
-            persist_path: None,
-        }
+        RuntimeParams::from_map(BTreeMap::new(), None)
     }
 
     #[test]
@@ -691,24 +851,14 @@ mod tests {
         let test_file = temp_dir.path().join("test_params.yaml");
 
         // Create params and save
-        let params1 = RuntimeParams {
-            params: Arc::new(RwLock::new(BTreeMap::new())),
-            metadata: Arc::new(RwLock::new(BTreeMap::new())),
-            versions: Arc::new(RwLock::new(BTreeMap::new())),
-            persist_path: Some(test_file.clone()),
-        };
+        let params1 = RuntimeParams::from_map(BTreeMap::new(), Some(test_file.clone()));
 
         params1.set("test_key", "test_value").unwrap();
         params1.set("test_number", 42).unwrap();
         params1.save_to_disk().unwrap();
 
         // Load into new instance
-        let params2 = RuntimeParams {
-            params: Arc::new(RwLock::new(BTreeMap::new())),
-            metadata: Arc::new(RwLock::new(BTreeMap::new())),
-            versions: Arc::new(RwLock::new(BTreeMap::new())),
-            persist_path: Some(test_file.clone()),
-        };
+        let params2 = RuntimeParams::from_map(BTreeMap::new(), Some(test_file.clone()));
 
         params2.load_from_disk(&test_file).unwrap();
 
@@ -1014,4 +1164,51 @@ mod tests {
         assert_eq!(retrieved.unit, metadata.unit);
         assert_eq!(retrieved.read_only, metadata.read_only);
     }
+
+    #[test]
+    fn test_handle_tracks_changes() {
+        let params = create_test_params();
+        params.set("max_speed", 1.5).unwrap();
+
+        let mut speed = params.handle("max_speed", 0.0f64);
+        assert!(speed.has_changed(), "Fresh handle loads on first get");
+        assert_eq!(*speed.get(), 1.5);
+        assert!(!speed.has_changed());
+        assert!(!speed.refresh());
+
+        let epoch = params.epoch();
+        params.set("max_speed", 2.5).unwrap();
+        assert!(params.epoch() > epoch);
+        assert!(speed.has_changed());
+        assert_eq!(*speed.get(), 2.5);
+
+        // Unrelated keys do not disturb the handle
+        params.set("other", 1).unwrap();
+        assert!(!speed.has_changed());
+
+        params.remove("max_speed");
+        assert_eq!(*speed.get(), 0.0, "Removed key falls back to default");
+    }
+
+    #[test]
+    fn test_handle_missing_key_and_reload() {
+        let temp_dir = TempDir::new().unwrap();
+        let test_file = temp_dir.path().join("handle_params.yaml");
+        fs::write(&test_file, "camera_fps: 60\n").unwrap();
+
+        let params = create_test_params();
+        let mut fps = params.handle("camera_fps", 30i32);
+        let shared = params.clone();
+        assert_eq!(*fps.get(), 30);
+
+        // Updates through a clone and bulk reloads reach the handle
+        shared.set_with_version("camera_fps", 15, 0).unwrap();
+        assert_eq!(*fps.get(), 15);
+        shared.load_from_disk(&test_file).unwrap();
+        assert_eq!(*fps.get(), 60);
+
+        // Wrong type falls back to the default
+        params.set("camera_fps", "fast").unwrap();
+        assert_eq!(*fps.get(), 30);
+    }
 }
@@ -0,0 +1,173 @@
+//! Per-thread heap allocation counting
+//!
+//! `CountingAllocator` wraps a global allocator and counts allocations,
+//! frees and allocated bytes of the calling thread. Like the hardware
+//! counters in `perf`, the scheduler samples the counts before and after a
+//! node's tick and attributes the delta to the node, which is how
+//! `Scheduler::with_alloc_tracking` finds real-time nodes that allocate.
+//!
+//! Counting needs the allocator to be installed as the global allocator,
+//! either by the binary:
+//!
+//! ```ignore
+//! #[global_allocator]
+//! static ALLOC: horus_core::scheduling::CountingAllocator =
+//!     horus_core::scheduling::CountingAllocator::system();
+//! ```
+//!
+//! or by building horus_core with the `alloc-tracking` feature. Without it
+//! every count reads as zero.
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::cell::Cell;
+use std::sync::atomic::{AtomicBool, Ordering};
+
+/// Allocator calls made by the calling thread
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct AllocSample {
+    /// `alloc`, `alloc_zeroed` and `realloc` calls
+    pub allocations: u64,
+    /// `dealloc` calls
+    pub frees: u64,
+    /// Bytes requested by allocations
+    pub bytes: u64,
+}
+
+impl AllocSample {
+    /// Counts accumulated since `earlier`
+    pub fn since(&self, earlier: &AllocSample) -> AllocSample {
+        AllocSample {
+            allocations: self.allocations.wrapping_sub(earlier.allocations),
+            frees: self.frees.wrapping_sub(earlier.frees),
+            bytes: self.bytes.wrapping_sub(earlier.bytes),
+        }
+    }
+
+    /// Whether any allocator call happened
+    pub fn any(&self) -> bool {
+        self.allocations > 0 || self.frees > 0
+    }
+
+    /// Add another sample's counts
+    pub fn add(&mut self, other: &AllocSample) {
+        self.allocations += other.allocations;
+        self.frees += other.frees;
+        self.bytes += other.bytes;
+    }
+}
+
+/// What the scheduler does when a real-time node allocates during a tick
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum RtAllocPolicy {
+    /// Print a warning (rate limited per node)
+    Warn,
+    /// Treat the tick as failed, like a panic
+    Fail,
+}
+
+thread_local! {
+    // Const-initialized without a destructor, so accessing it from inside
+    // the allocator never allocates
+    static COUNTS: Cell<AllocSample> = const {
+        Cell::new(AllocSample { allocations: 0, frees: 0, bytes: 0 })
+    };
+}
+
+static INSTALLED: AtomicBool = AtomicBool::new(false);
+
+/// Global allocator wrapper that counts allocator calls per thread
+pub struct CountingAllocator<A = System> {
+    inner: A,
+}
+
+impl CountingAllocator<System> {
+    /// Counting wrapper around the system allocator
+    pub const fn system() -> Self {
+        Self { inner: System }
+    }
+}
+
+impl<A> CountingAllocator<A> {
+    pub const fn new(inner: A) -> Self {
+        Self { inner }
+    }
+}
+
+#[inline]
+fn count(allocations: u64, frees: u64, bytes: usize) {
+    if !INSTALLED.load(Ordering::Relaxed) {
+        INSTALLED.store(true, Ordering::Relaxed);
+    }
+    let _ = COUNTS.try_with(|c| {
+        let mut s = c.get();
+        s.allocations += allocations;
+        s.frees += frees;
+        s.bytes += bytes as u64;
+        c.set(s);
+    });
+}
+
+unsafe impl<A: GlobalAlloc> GlobalAlloc for CountingAllocator<A> {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        count(1, 0, layout.size());
+        self.inner.alloc(layout)
+    }
+
+    unsafe fn alloc_zeroed(&self, layout: Layout) -> *mut u8 {
+        count(1, 0, layout.size());
+        self.inner.alloc_zeroed(layout)
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        count(0, 1, 0);
+        self.inner.dealloc(ptr, layout)
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        count(1, 0, new_size);
+        self.inner.realloc(ptr, layout, new_size)
+    }
+}
+
+#[cfg(feature = "alloc-tracking")]
+#[global_allocator]
+static GLOBAL: CountingAllocator = CountingAllocator::system();
+
+/// Whether a `CountingAllocator` is the global allocator
+///
+/// Becomes true on the first allocation through it, which in practice
+/// happens before `main`.
+pub fn is_installed() -> bool {
+    INSTALLED.load(Ordering::Relaxed)
+}
+
+/// Allocator counts of the calling thread
+#[inline]
+pub fn read_thread_allocs() -> AllocSample {
+    COUNTS.try_with(|c| c.get()).unwrap_or_default()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_counts_wrapped_calls() {
+        let alloc = CountingAllocator::system();
+        let layout = Layout::from_size_align(48, 8).unwrap();
+        let before = read_thread_allocs();
+        unsafe {
+            let p = alloc.alloc(layout);
+            let p = alloc.realloc(p, layout, 96);
+            alloc.dealloc(p, Layout::from_size_align(96, 8).unwrap());
+        }
+        let delta = read_thread_allocs().since(&before);
+        assert!(is_installed());
+        assert!(delta.any());
+        // The test harness may use any global allocator, so only check the
+        // wrapped calls are included
+        assert!(delta.allocations >= 2);
+        assert!(delta.frees >= 1);
+        assert!(delta.bytes >= 144);
+    }
+}
@@ -2,15 +2,30 @@
 //!
 //! Records all significant events in a circular buffer that persists
 //! across crashes for debugging and incident analysis.
+//!
+//! Recording is lock-free and makes no syscalls: each thread that records
+//! owns a single-producer ring of fixed-size binary records. A ring that
+//! fills before it is drained overwrites its oldest records, so the most
+//! recent events always survive. The rings are drained into the in-memory
+//! history whenever it is read; with persistence a flusher thread also
+//! drains them every few milliseconds, batching records into a binary
+//! write-ahead log that it `fdatasync`s at a fixed interval rather than per
+//! event (group commit). Crash reports are generated from a memory map of
+//! the WAL, so they include events from a previous run that died.
 
+use bytemuck::{Pod, Zeroable};
+use memmap2::Mmap;
+use parking_lot::{Mutex, RwLock};
 use serde::{Deserialize, Serialize};
+use std::cell::{RefCell, UnsafeCell};
 use std::collections::VecDeque;
 use std::fs::{self, File, OpenOptions};
-use std::io::{BufWriter, Write};
+use std::io::{BufWriter, Read, Write};
 use std::path::PathBuf;
-use std::sync::{Arc, Mutex};
-use std::time::{SystemTime, UNIX_EPOCH};
-
+use std::sync::atomic::{fence, AtomicBool, AtomicU64, AtomicUsize, Ordering};
+use std::sync::Arc;
+use std::thread::JoinHandle;
+use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
 /// Black box event types
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub enum BlackBoxEvent {
@@ -74,20 +89,549 @@ pub struct BlackBoxRecord {
     pub event: BlackBoxEvent,
 }
 
+/// Records buffered per recording thread between drains
+const THREAD_RING_CAPACITY: usize = 1024;
+/// How often the flusher drains the thread rings
+const FLUSH_INTERVAL: Duration = Duration::from_millis(5);
+/// How often the WAL is synced to stable storage
+const WAL_SYNC_INTERVAL: Duration = Duration::from_millis(50);
+/// WAL file magic
+const WAL_MAGIC: &[u8; 8] = b"HORUSBBX";
+/// WAL header: magic, version, record size
+const WAL_HEADER_SIZE: usize = 16;
+/// WAL format version
+const WAL_VERSION: u32 = 1;
+/// The WAL is rotated to `.wal.1` once it holds this many history capacities
+const WAL_ROTATE_FACTOR: usize = 4;
+
+/// Size of one binary record
+const RECORD_SIZE: usize = std::mem::size_of::<RawRecord>();
+const NAME_LEN: usize = 32;
+const TEXT_LEN: usize = 56;
+
+/// Fixed-size binary form of a [`BlackBoxRecord`]
+///
+/// Strings are truncated to `NAME_LEN` / `TEXT_LEN` bytes, which keeps
+/// every record 128 bytes so the WAL can be indexed from either end.
+#[repr(C)]
+#[derive(Clone, Copy, Pod, Zeroable)]
+struct RawRecord {
+    timestamp_us: u64,
+    tick: u64,
+    kind: u8,
+    flag: u8,
+    name_len: u8,
+    text_len: u8,
+    a: u32,
+    b: u64,
+    c: u64,
+    name: [u8; NAME_LEN],
+    text: [u8; TEXT_LEN],
+}
+
+const _: () = assert!(RECORD_SIZE == 128);
+
+/// Copy as much of `s` as fits, cutting on a char boundary
+fn put_str<const N: usize>(dst: &mut [u8; N], s: &str) -> u8 {
+    let mut len = s.len().min(N);
+    while !s.is_char_boundary(len) {
+        len -= 1;
+    }
+    dst[..len].copy_from_slice(&s.as_bytes()[..len]);
+    len as u8
+}
+
+impl RawRecord {
+    fn encode(timestamp_us: u64, tick: u64, event: &BlackBoxEvent) -> Self {
+        let mut r = RawRecord::zeroed();
+        r.timestamp_us = timestamp_us;
+        r.tick = tick;
+        r.kind = event.kind();
+        match event {
+            BlackBoxEvent::SchedulerStart {
+                name,
+                node_count,
+                config,
+            } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.b = *node_count as u64;
+                r.text_len = put_str(&mut r.text, config);
+            }
+            BlackBoxEvent::SchedulerStop {
+                reason,
+                total_ticks,
+            } => {
+                r.text_len = put_str(&mut r.text, reason);
+                r.b = *total_ticks;
+            }
+            BlackBoxEvent::NodeAdded { name, priority } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.a = *priority;
+            }
+            BlackBoxEvent::NodeTick {
+                name,
+                duration_us,
+                success,
+            } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.b = *duration_us;
+                r.flag = *success as u8;
+            }
+            BlackBoxEvent::NodeError { name, error } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.text_len = put_str(&mut r.text, error);
+            }
+            BlackBoxEvent::DeadlineMiss {
+                name,
+                deadline_us,
+                actual_us,
+            } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.b = *deadline_us;
+                r.c = *actual_us;
+            }
+            BlackBoxEvent::WCETViolation {
+                name,
+                budget_us,
+                actual_us,
+            } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.b = *budget_us;
+                r.c = *actual_us;
+            }
+            BlackBoxEvent::CircuitBreakerChange {
+                name,
+                new_state,
+                failure_count,
+            } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.text_len = put_str(&mut r.text, new_state);
+                r.a = *failure_count;
+            }
+            BlackBoxEvent::LearningComplete {
+                duration_ms,
+                tier_summary,
+            } => {
+                r.b = *duration_ms;
+                r.text_len = put_str(&mut r.text, tier_summary);
+            }
+            BlackBoxEvent::JITCompilation { name, success } => {
+                r.name_len = put_str(&mut r.name, name);
+                r.flag = *success as u8;
+            }
+            BlackBoxEvent::EmergencyStop { reason } => {
+                r.text_len = put_str(&mut r.text, reason);
+            }
+            BlackBoxEvent::Custom { category, message } => {
+                r.name_len = put_str(&mut r.name, category);
+                r.text_len = put_str(&mut r.text, message);
+            }
+        }
+        r
+    }
+
+    fn name(&self) -> String {
+        let len = (self.name_len as usize).min(NAME_LEN);
+        String::from_utf8_lossy(&self.name[..len]).into_owned()
+    }
+
+    fn text(&self) -> String {
+        let len = (self.text_len as usize).min(TEXT_LEN);
+        String::from_utf8_lossy(&self.text[..len]).into_owned()
+    }
+
+    /// Whether this record is an error or warning (see `get_anomalies`)
+    fn is_anomaly(&self) -> bool {
+        matches!(self.kind, 4..=6 | 10)
+    }
+
+    fn decode(&self) -> Option<BlackBoxRecord> {
+        let event = match self.kind {
+            0 => BlackBoxEvent::SchedulerStart {
+                name: self.name(),
+                node_count: self.b as usize,
+                config: self.text(),
+            },
+            1 => BlackBoxEvent::SchedulerStop {
+                reason: self.text(),
+                total_ticks: self.b,
+            },
+            2 => BlackBoxEvent::NodeAdded {
+                name: self.name(),
+                priority: self.a,
+            },
+            3 => BlackBoxEvent::NodeTick {
+                name: self.name(),
+                duration_us: self.b,
+                success: self.flag != 0,
+            },
+            4 => BlackBoxEvent::NodeError {
+                name: self.name(),
+                error: self.text(),
+            },
+            5 => BlackBoxEvent::DeadlineMiss {
+                name: self.name(),
+                deadline_us: self.b,
+                actual_us: self.c,
+            },
+            6 => BlackBoxEvent::WCETViolation {
+                name: self.name(),
+                budget_us: self.b,
+                actual_us: self.c,
+            },
+            7 => BlackBoxEvent::CircuitBreakerChange {
+                name: self.name(),
+                new_state: self.text(),
+                failure_count: self.a,
+            },
+            8 => BlackBoxEvent::LearningComplete {
+                duration_ms: self.b,
+                tier_summary: self.text(),
+            },
+            9 => BlackBoxEvent::JITCompilation {
+                name: self.name(),
+                success: self.flag != 0,
+            },
+            10 => BlackBoxEvent::EmergencyStop {
+                reason: self.text(),
+            },
+            11 => BlackBoxEvent::Custom {
+                category: self.name(),
+                message: self.text(),
+            },
+            _ => return None,
+        };
+        Some(BlackBoxRecord {
+            timestamp_us: self.timestamp_us,
+            tick: self.tick,
+            event,
+        })
+    }
+}
+
+impl BlackBoxEvent {
+    fn kind(&self) -> u8 {
+        match self {
+            BlackBoxEvent::SchedulerStart { .. } => 0,
+            BlackBoxEvent::SchedulerStop { .. } => 1,
+            BlackBoxEvent::NodeAdded { .. } => 2,
+            BlackBoxEvent::NodeTick { .. } => 3,
+            BlackBoxEvent::NodeError { .. } => 4,
+            BlackBoxEvent::DeadlineMiss { .. } => 5,
+            BlackBoxEvent::WCETViolation { .. } => 6,
+            BlackBoxEvent::CircuitBreakerChange { .. } => 7,
+            BlackBoxEvent::LearningComplete { .. } => 8,
+            BlackBoxEvent::JITCompilation { .. } => 9,
+            BlackBoxEvent::EmergencyStop { .. } => 10,
+            BlackBoxEvent::Custom { .. } => 11,
+        }
+    }
+
+    fn type_name(&self) -> &'static str {
+        match self {
+            BlackBoxEvent::SchedulerStart { .. } => "SchedulerStart",
+            BlackBoxEvent::SchedulerStop { .. } => "SchedulerStop",
+            BlackBoxEvent::NodeAdded { .. } => "NodeAdded",
+            BlackBoxEvent::NodeTick { .. } => "NodeTick",
+            BlackBoxEvent::NodeError { .. } => "NodeError",
+            BlackBoxEvent::DeadlineMiss { .. } => "DeadlineMiss",
+            BlackBoxEvent::WCETViolation { .. } => "WCETViolation",
+            BlackBoxEvent::CircuitBreakerChange { .. } => "CircuitBreakerChange",
+            BlackBoxEvent::LearningComplete { .. } => "LearningComplete",
+            BlackBoxEvent::JITCompilation { .. } => "JITCompilation",
+            BlackBoxEvent::EmergencyStop { .. } => "EmergencyStop",
+            BlackBoxEvent::Custom { .. } => "Custom",
+        }
+    }
+}
+
+/// One ring entry, stamped with the position it holds
+struct RingSlot {
+    /// Ring position + 1 once written, 0 while the producer is writing
+    stamp: AtomicUsize,
+    record: UnsafeCell<RawRecord>,
+}
+
+/// Single-producer, single-consumer ring owned by one recording thread
+///
+/// The producer is the thread the ring is registered to; consumers are
+/// serialized by the black box's drain lock. The producer never waits: when
+/// the consumer falls a full ring behind, new records overwrite the oldest.
+struct ThreadRing {
+    slots: Box<[RingSlot]>,
+    /// Next position the producer writes
+    head: AtomicUsize,
+    /// Next position the consumer reads (consumer-only)
+    tail: AtomicUsize,
+    /// Records overwritten before they were drained
+    dropped: AtomicU64,
+}
+
+// SAFETY: a slot is only written by the producer; the consumer copies it
+// out and keeps the copy only if the slot's stamp was the same before and
+// after, so it never uses a record the producer was overwriting
+unsafe impl Send for ThreadRing {}
+unsafe impl Sync for ThreadRing {}
+
+impl ThreadRing {
+    fn new() -> Self {
+        Self {
+            slots: (0..THREAD_RING_CAPACITY)
+                .map(|_| RingSlot {
+                    stamp: AtomicUsize::new(0),
+                    record: UnsafeCell::new(RawRecord::zeroed()),
+                })
+                .collect(),
+            head: AtomicUsize::new(0),
+            tail: AtomicUsize::new(0),
+            dropped: AtomicU64::new(0),
+        }
+    }
+
+    #[inline]
+    fn push(&self, record: RawRecord) {
+        let head = self.head.load(Ordering::Relaxed);
+        let slot = &self.slots[head % THREAD_RING_CAPACITY];
+
+        // Seqlock-style: invalidate, write, then stamp with the new position
+        slot.stamp.store(0, Ordering::Relaxed);
+        fence(Ordering::Release);
+        unsafe { std::ptr::write_volatile(slot.record.get(), record) };
+        slot.stamp.store(head.wrapping_add(1), Ordering::Release);
+        self.head.store(head.wrapping_add(1), Ordering::Release);
+    }
+
+    /// Move everything currently queued into `out`
+    ///
+    /// Records the producer overwrote before they could be read are
+    /// counted in `dropped`.
+    fn drain_into(&self, out: &mut Vec<RawRecord>) {
+        let tail = self.tail.load(Ordering::Relaxed);
+        let head = self.head.load(Ordering::Acquire);
+
+        // Anything more than a ring behind the head is already gone
+        let start = if head.wrapping_sub(tail) > THREAD_RING_CAPACITY {
+            head.wrapping_sub(THREAD_RING_CAPACITY)
+        } else {
+            tail
+        };
+        let mut lost = start.wrapping_sub(tail) as u64;
+
+        let mut i = start;
+        while i != head {
+            let slot = &self.slots[i % THREAD_RING_CAPACITY];
+            let expected = i.wrapping_add(1);
+            if slot.stamp.load(Ordering::Acquire) == expected {
+                let record = unsafe { std::ptr::read_volatile(slot.record.get()) };
+                fence(Ordering::Acquire);
+                if slot.stamp.load(Ordering::Relaxed) == expected {
+                    out.push(record);
+                } else {
+                    lost += 1;
+                }
+            } else {
+                lost += 1;
+            }
+            i = i.wrapping_add(1);
+        }
+
+        self.tail.store(head, Ordering::Relaxed);
+        if lost > 0 {
+            self.dropped.fetch_add(lost, Ordering::Relaxed);
+        }
+    }
+}
+
+/// Global counter giving every black box a distinct id for thread-local lookup
+static NEXT_BLACKBOX_ID: AtomicU64 = AtomicU64::new(1);
+
+thread_local! {
+    /// Rings this thread produces into, keyed by black box id
+    static THREAD_RINGS: RefCell<Vec<(u64, Arc<ThreadRing>)>> = const { RefCell::new(Vec::new()) };
+}
+
+/// Binary write-ahead log
+struct Wal {
+    file: File,
+    path: PathBuf,
+    records: usize,
+    last_sync: Instant,
+    dirty: bool,
+}
+
+impl Wal {
+    /// Open (or create) the WAL at `path`
+    ///
+    /// A file in another format (e.g. the old JSON-lines WAL) is moved
+    /// aside to `.wal.old`; a torn final record is truncated.
+    fn open(path: PathBuf) -> std::io::Result<Self> {
+        if let Ok(mut existing) = File::open(&path) {
+            let mut header = [0u8; WAL_HEADER_SIZE];
+            let valid = existing.read_exact(&mut header).is_ok()
+                && &header[..8] == WAL_MAGIC
+                && u32::from_le_bytes(header[8..12].try_into().unwrap()) == WAL_VERSION
+                && u32::from_le_bytes(header[12..16].try_into().unwrap()) as usize == RECORD_SIZE;
+            let empty = existing.metadata().map(|m| m.len() == 0).unwrap_or(true);
+            if !valid && !empty {
+                fs::rename(&path, path.with_extension("wal.old"))?;
+            }
+        }
+
+        let file = OpenOptions::new()
+            .create(true)
+            .read(true)
+            .append(true)
+            .open(&path)?;
+        let len = file.metadata()?.len() as usize;
+        let records = if len < WAL_HEADER_SIZE {
+            file.set_len(0)?;
+            let mut header = Vec::with_capacity(WAL_HEADER_SIZE);
+            header.extend_from_slice(WAL_MAGIC);
+            header.extend_from_slice(&WAL_VERSION.to_le_bytes());
+            header.extend_from_slice(&(RECORD_SIZE as u32).to_le_bytes());
+            (&file).write_all(&header)?;
+            0
+        } else {
+            let records = (len - WAL_HEADER_SIZE) / RECORD_SIZE;
+            file.set_len((WAL_HEADER_SIZE + records * RECORD_SIZE) as u64)?;
+            records
+        };
+
+        Ok(Self {
+            file,
+            path,
+            records,
+            last_sync: Instant::now(),
+            dirty: false,
+        })
+    }
+
+    fn append(&mut self, batch: &[RawRecord], rotate_at: usize) -> std::io::Result<()> {
+        if batch.is_empty() {
+            return Ok(());
+        }
+        if self.records + batch.len() > rotate_at {
+            self.sync()?;
+            fs::rename(&self.path, self.path.with_extension("wal.1"))?;
+            *self = Self::open(self.path.clone())?;
+        }
+        (&self.file).write_all(bytemuck::cast_slice(batch))?;
+        self.records += batch.len();
+        self.dirty = true;
+        Ok(())
+    }
+
+    /// Group commit: sync if anything was written since the last sync
+    fn sync(&mut self) -> std::io::Result<()> {
+        if self.dirty {
+            self.file.sync_data()?;
+            self.dirty = false;
+        }
+        self.last_sync = Instant::now();
+        Ok(())
+    }
+}
+
+/// Consumer-side state, behind the drain lock
+struct DrainState {
+    history: VecDeque<RawRecord>,
+    wal: Option<Wal>,
+    batch: Vec<RawRecord>,
+}
+
+struct Shared {
+    id: u64,
+    enabled: AtomicBool,
+    tick_counter: AtomicU64,
+    max_size: AtomicUsize,
+    rings: RwLock<Vec<Arc<ThreadRing>>>,
+    state: Mutex<DrainState>,
+    stop: AtomicBool,
+}
+
+impl Shared {
+    /// Ring the calling thread produces into, registering one on first use
+    #[inline]
+    fn with_ring(self: &Arc<Self>, f: impl FnOnce(&ThreadRing)) {
+        THREAD_RINGS.with(|rings| {
+            let mut rings = rings.borrow_mut();
+            if let Some((_, ring)) = rings.iter().find(|(id, _)| *id == self.id) {
+                return f(ring);
+            }
+
+            // Registration (once per thread): forget rings of dropped black boxes
+            rings.retain(|(_, ring)| Arc::strong_count(ring) > 1);
+            let ring = Arc::new(ThreadRing::new());
+            self.rings.write().push(ring.clone());
+            f(&ring);
+            rings.push((self.id, ring));
+        })
+    }
+
+    /// Move queued records from every thread ring into history and the WAL
+    fn drain(&self, state: &mut DrainState) {
+        let DrainState {
+            history,
+            wal,
+            batch,
+        } = state;
+
+        batch.clear();
+        let mut orphaned = false;
+        for ring in self.rings.read().iter() {
+            ring.drain_into(batch);
+            orphaned |= Arc::strong_count(ring) == 1;
+        }
+        if orphaned {
+            // The producing thread exited and its ring is now empty
+            self.rings
+                .write()
+                .retain(|ring| Arc::strong_count(ring) > 1);
+        }
+        if batch.len() > 1 {
+            batch.sort_by_key(|r| r.timestamp_us);
+        }
+
+        let max_size = self.max_size.load(Ordering::Relaxed).max(1);
+        if let Some(w) = wal.as_mut() {
+            let result = w.append(batch, max_size * WAL_ROTATE_FACTOR).and_then(|_| {
+                if w.last_sync.elapsed() >= WAL_SYNC_INTERVAL {
+                    w.sync()
+                } else {
+                    Ok(())
+                }
+            });
+            if let Err(e) = result {
+                log::warn!("Black box WAL write failed, disabling persistence: {}", e);
+                *wal = None;
+            }
+        }
+
+        for record in batch.drain(..) {
+            if history.len() >= max_size {
+                history.pop_front();
+            }
+            history.push_back(record);
+        }
+        while history.len() > max_size {
+            history.pop_front();
+        }
+    }
+
+    fn drained(&self) -> parking_lot::MutexGuard<'_, DrainState> {
+        let mut state = self.state.lock();
+        self.drain(&mut state);
+        state
+    }
+}
+
 /// Black box recorder with circular buffer
 pub struct BlackBox {
-    /// Circular buffer of events
-    buffer: VecDeque<BlackBoxRecord>,
-    /// Maximum buffer size
-    max_size: usize,
-    /// Current tick counter
-    tick_counter: u64,
+    shared: Arc<Shared>,
     /// Path for persistence
     persist_path: Option<PathBuf>,
-    /// Write-ahead log file (for crash recovery)
-    wal_file: Option<BufWriter<File>>,
-    /// Whether recording is enabled
-    enabled: bool,
+    /// Background thread draining rings into the WAL
+    flusher: Option<JoinHandle<()>>,
 }
 
 impl BlackBox {
@@ -97,16 +641,27 @@ impl BlackBox {
         let max_records = (max_size_mb * 1024 * 1024) / 200;
 
         Self {
-            buffer: VecDeque::with_capacity(max_records.min(100000)),
-            max_size: max_records.max(1000),
-            tick_counter: 0,
+            shared: Arc::new(Shared {
+                id: NEXT_BLACKBOX_ID.fetch_add(1, Ordering::Relaxed),
+                enabled: AtomicBool::new(max_size_mb > 0),
+                tick_counter: AtomicU64::new(0),
+                max_size: AtomicUsize::new(max_records.max(1000)),
+                rings: RwLock::new(Vec::new()),
+                state: Mutex::new(DrainState {
+                    history: VecDeque::with_capacity(max_records.min(100000)),
+                    wal: None,
+                    batch: Vec::new(),
+                }),
+                stop: AtomicBool::new(false),
+            }),
             persist_path: None,
-            wal_file: None,
-            enabled: max_size_mb > 0,
+            flusher: None,
         }
     }
 
     /// Enable persistence to disk
+    ///
+    /// Starts the flusher thread that writes the WAL next to `path`.
     pub fn with_persistence(mut self, path: PathBuf) -> Self {
         if let Some(parent) = path.parent() {
             let _ = fs::create_dir_all(parent);
@@ -115,121 +670,127 @@ impl BlackBox {
         self.persist_path = Some(path.clone());
 
         // Open WAL file for append
-        if let Ok(file) = OpenOptions::new()
-            .create(true)
-            .append(true)
-            .open(path.with_extension("wal"))
-        {
-            self.wal_file = Some(BufWriter::new(file));
+        match Wal::open(path.with_extension("wal")) {
+            Ok(wal) => self.shared.state.lock().wal = Some(wal),
+            Err(e) => {
+                log::warn!("Black box WAL unavailable: {}", e);
+                return self;
+            }
+        }
+
+        if self.flusher.is_none() {
+            let shared = self.shared.clone();
+            self.flusher = std::thread::Builder::new()
+                .name("horus-blackbox".to_string())
+                .spawn(move || {
+                    while !shared.stop.load(Ordering::Acquire) {
+                        std::thread::park_timeout(FLUSH_INTERVAL);
+                        let mut state = shared.state.lock();
+                        shared.drain(&mut state);
+                    }
+                })
+                .map_err(|e| log::warn!("Black box flusher did not start: {}", e))
+                .ok();
         }
 
         self
     }
 
     /// Record an event
-    pub fn record(&mut self, event: BlackBoxEvent) {
-        if !self.enabled {
+    ///
+    /// Lock-free and syscall-free: the event is encoded into the calling
+    /// thread's ring and picked up by the next drain.
+    #[inline]
+    pub fn record(&self, event: BlackBoxEvent) {
+        if !self.shared.enabled.load(Ordering::Relaxed) {
             return;
         }
 
-        let record = BlackBoxRecord {
-            timestamp_us: SystemTime::now()
+        let record = RawRecord::encode(
+            SystemTime::now()
                 .duration_since(UNIX_EPOCH)
                 .unwrap_or_default()
                 .as_micros() as u64,
-            tick: self.tick_counter,
-            event,
-        };
+            self.shared.tick_counter.load(Ordering::Relaxed),
+            &event,
+        );
+        self.shared.with_ring(|ring| ring.push(record));
+    }
 
-        // Write to WAL first (for crash recovery)
-        if let Some(ref mut wal) = self.wal_file {
-            if let Ok(json) = serde_json::to_string(&record) {
-                let _ = writeln!(wal, "{}", json);
-                let _ = wal.flush();
-            }
-        }
+    /// Increment tick counter (call once per scheduler tick)
+    #[inline]
+    pub fn tick(&self) {
+        self.shared.tick_counter.fetch_add(1, Ordering::Relaxed);
+    }
 
-        // Add to circular buffer
-        if self.buffer.len() >= self.max_size {
-            self.buffer.pop_front();
+    /// Drain queued records and sync the WAL now
+    pub fn flush(&self) -> std::io::Result<()> {
+        let mut state = self.shared.drained();
+        match state.wal.as_mut() {
+            Some(wal) => wal.sync(),
+            None => Ok(()),
         }
-        self.buffer.push_back(record);
     }
 
-    /// Increment tick counter (call once per scheduler tick)
-    pub fn tick(&mut self) {
-        self.tick_counter += 1;
+    /// Records lost because a thread's ring wrapped before it was drained
+    ///
+    /// Each ring keeps its newest records, so these are always the oldest.
+    pub fn dropped(&self) -> u64 {
+        self.shared
+            .rings
+            .read()
+            .iter()
+            .map(|r| r.dropped.load(Ordering::Relaxed))
+            .sum()
     }
 
     /// Get all recorded events
     pub fn get_events(&self) -> Vec<BlackBoxRecord> {
-        self.buffer.iter().cloned().collect()
+        self.collect(|_| true)
     }
 
     /// Get events from the last N ticks
     pub fn get_recent(&self, last_n_ticks: u64) -> Vec<BlackBoxRecord> {
-        let min_tick = self.tick_counter.saturating_sub(last_n_ticks);
-        self.buffer
-            .iter()
-            .filter(|r| r.tick >= min_tick)
-            .cloned()
-            .collect()
+        let min_tick = self
+            .shared
+            .tick_counter
+            .load(Ordering::Relaxed)
+            .saturating_sub(last_n_ticks);
+        self.collect(|r| r.tick >= min_tick)
     }
 
     /// Get events of a specific type
     pub fn get_by_type(&self, event_type: &str) -> Vec<BlackBoxRecord> {
-        self.buffer
-            .iter()
-            .filter(|r| {
-                let type_name = match &r.event {
-                    BlackBoxEvent::SchedulerStart { .. } => "SchedulerStart",
-                    BlackBoxEvent::SchedulerStop { .. } => "SchedulerStop",
-                    BlackBoxEvent::NodeAdded { .. } => "NodeAdded",
-                    BlackBoxEvent::NodeTick { .. } => "NodeTick",
-                    BlackBoxEvent::NodeError { .. } => "NodeError",
-                    BlackBoxEvent::DeadlineMiss { .. } => "DeadlineMiss",
-                    BlackBoxEvent::WCETViolation { .. } => "WCETViolation",
-                    BlackBoxEvent::CircuitBreakerChange { .. } => "CircuitBreakerChange",
-                    BlackBoxEvent::LearningComplete { .. } => "LearningComplete",
-                    BlackBoxEvent::JITCompilation { .. } => "JITCompilation",
-                    BlackBoxEvent::EmergencyStop { .. } => "EmergencyStop",
-                    BlackBoxEvent::Custom { .. } => "Custom",
-                };
-                type_name == event_type
-            })
-            .cloned()
+        self.collect(|_| true)
+            .into_iter()
+            .filter(|r| r.event.type_name() == event_type)
             .collect()
     }
 
     /// Get all errors and warnings
     pub fn get_anomalies(&self) -> Vec<BlackBoxRecord> {
-        self.buffer
+        self.collect(RawRecord::is_anomaly)
+    }
+
+    fn collect(&self, keep: impl Fn(&RawRecord) -> bool) -> Vec<BlackBoxRecord> {
+        self.shared
+            .drained()
+            .history
             .iter()
-            .filter(|r| {
-                matches!(
-                    r.event,
-                    BlackBoxEvent::NodeError { .. }
-                        | BlackBoxEvent::DeadlineMiss { .. }
-                        | BlackBoxEvent::WCETViolation { .. }
-                        | BlackBoxEvent::EmergencyStop { .. }
-                        | BlackBoxEvent::CircuitBreakerChange { .. }
-                )
-            })
-            .cloned()
+            .filter(|r| keep(r))
+            .filter_map(RawRecord::decode)
             .collect()
     }
 
     /// Save buffer to disk
     pub fn save(&self) -> std::io::Result<()> {
         if let Some(ref path) = self.persist_path {
+            let events = self.get_events();
             let file = File::create(path)?;
             let writer = BufWriter::new(file);
-            serde_json::to_writer_pretty(writer, &self.get_events())?;
-            println!(
-                "[BLACKBOX] Saved {} events to {:?}",
-                self.buffer.len(),
-                path
-            );
+            serde_json::to_writer_pretty(writer, &events)?;
+            self.flush()?;
+            println!("[BLACKBOX] Saved {} events to {:?}", events.len(), path);
         }
         Ok(())
     }
@@ -240,10 +801,14 @@ impl BlackBox {
             if path.exists() {
                 let content = fs::read_to_string(path)?;
                 let events: Vec<BlackBoxRecord> = serde_json::from_str(&content)?;
-                self.buffer = VecDeque::from(events);
+                let mut state = self.shared.state.lock();
+                state.history = events
+                    .iter()
+                    .map(|r| RawRecord::encode(r.timestamp_us, r.tick, &r.event))
+                    .collect();
                 println!(
                     "[BLACKBOX] Loaded {} events from {:?}",
-                    self.buffer.len(),
+                    state.history.len(),
                     path
                 );
             }
@@ -251,25 +816,73 @@ impl BlackBox {
         Ok(())
     }
 
-    /// Generate a crash report from current buffer
+    /// Generate a crash report
+    ///
+    /// With persistence the report is read from a memory map of the WAL,
+    /// so it covers everything durably logged (including earlier runs);
+    /// otherwise it uses the in-memory buffer.
     pub fn generate_crash_report(&self) -> String {
+        let wal_path = {
+            let mut state = self.shared.drained();
+            match state.wal.as_mut() {
+                Some(wal) => {
+                    // Push what is buffered to the file before mapping it
+                    let _ = wal.sync();
+                    Some(wal.path.clone())
+                }
+                None => None,
+            }
+        };
+
+        let mapped = wal_path.and_then(|path| {
+            let file = File::open(path).ok()?;
+            // SAFETY: the WAL is append-only and only read here
+            unsafe { Mmap::map(&file) }.ok()
+        });
+        match &mapped {
+            Some(map) if map.len() >= WAL_HEADER_SIZE => {
+                let body = &map[WAL_HEADER_SIZE..];
+                let whole = body.len() / RECORD_SIZE * RECORD_SIZE;
+                // The map is page-aligned and the header keeps records 8-aligned
+                match bytemuck::try_cast_slice::<u8, RawRecord>(&body[..whole]) {
+                    Ok(records) => self.format_report(records),
+                    Err(_) => self.format_report(&bytemuck::pod_collect_to_vec(&body[..whole])),
+                }
+            }
+            _ => {
+                let state = self.shared.drained();
+                let records: Vec<RawRecord> = state.history.iter().copied().collect();
+                drop(state);
+                self.format_report(&records)
+            }
+        }
+    }
+
+    fn format_report(&self, records: &[RawRecord]) -> String {
         let mut report = String::new();
         report.push_str("=== HORUS BLACK BOX CRASH REPORT ===\n\n");
 
         // Summary
-        report.push_str(&format!("Total events: {}\n", self.buffer.len()));
-        report.push_str(&format!("Last tick: {}\n\n", self.tick_counter));
+        report.push_str(&format!("Total events: {}\n", records.len()));
+        report.push_str(&format!(
+            "Last tick: {}\n\n",
+            self.shared.tick_counter.load(Ordering::Relaxed)
+        ));
 
         // Anomalies
-        let anomalies = self.get_anomalies();
+        let anomalies: Vec<BlackBoxRecord> = records
+            .iter()
+            .filter(|r| r.is_anomaly())
+            .filter_map(RawRecord::decode)
+            .collect();
         report.push_str(&format!("=== ANOMALIES ({}) ===\n", anomalies.len()));
-        for record in anomalies.iter().take(50) {
+        for record in anomalies.iter().rev().take(50) {
             report.push_str(&format!("[tick {}] {:?}\n", record.tick, record.event));
         }
 
         // Last 100 events
         report.push_str("\n=== LAST 100 EVENTS ===\n");
-        for record in self.buffer.iter().rev().take(100) {
+        for record in records.iter().rev().take(100).filter_map(RawRecord::decode) {
             report.push_str(&format!("[tick {}] {:?}\n", record.tick, record.event));
         }
 
@@ -277,24 +890,43 @@ impl BlackBox {
     }
 
     /// Clear the buffer
-    pub fn clear(&mut self) {
-        self.buffer.clear();
-        self.tick_counter = 0;
+    pub fn clear(&self) {
+        let mut state = self.shared.drained();
+        state.history.clear();
+        self.shared.tick_counter.store(0, Ordering::Relaxed);
     }
 
     /// Enable or disable recording
-    pub fn set_enabled(&mut self, enabled: bool) {
-        self.enabled = enabled;
+    pub fn set_enabled(&self, enabled: bool) {
+        self.shared.enabled.store(enabled, Ordering::Relaxed);
+    }
+
+    /// Set the number of records kept in memory
+    pub fn set_capacity(&self, max_records: usize) {
+        self.shared.max_size.store(max_records, Ordering::Relaxed);
     }
 
     /// Get buffer size
     pub fn len(&self) -> usize {
-        self.buffer.len()
+        self.shared.drained().history.len()
     }
 
     /// Check if buffer is empty
     pub fn is_empty(&self) -> bool {
-        self.buffer.is_empty()
+        self.len() == 0
+    }
+}
+
+impl Drop for BlackBox {
+    fn drop(&mut self) {
+        self.shared.stop.store(true, Ordering::Release);
+        if let Some(flusher) = self.flusher.take() {
+            flusher.thread().unpark();
+            let _ = flusher.join();
+        }
+        if let Err(e) = self.flush() {
+            log::warn!("Black box final flush failed: {}", e);
+        }
     }
 }
 
@@ -304,12 +936,14 @@ impl Default for BlackBox {
     }
 }
 
-/// Thread-safe black box wrapper
-pub type SharedBlackBox = Arc<Mutex<BlackBox>>;
+/// Thread-safe black box handle
+///
+/// `BlackBox` records through `&self`, so sharing needs no lock.
+pub type SharedBlackBox = Arc<BlackBox>;
 
 /// Create a thread-safe black box
 pub fn create_shared_blackbox(max_size_mb: usize) -> SharedBlackBox {
-    Arc::new(Mutex::new(BlackBox::new(max_size_mb)))
+    Arc::new(BlackBox::new(max_size_mb))
 }
 
 #[cfg(test)]
@@ -318,7 +952,7 @@ mod tests {
 
     #[test]
     fn test_blackbox_record() {
-        let mut bb = BlackBox::new(1); // 1MB
+        let bb = BlackBox::new(1); // 1MB
 
         bb.record(BlackBoxEvent::SchedulerStart {
             name: "test".to_string(),
@@ -339,8 +973,8 @@ mod tests {
 
     #[test]
     fn test_blackbox_circular() {
-        let mut bb = BlackBox::new(1);
-        bb.max_size = 10; // Override for testing
+        let bb = BlackBox::new(1);
+        bb.set_capacity(10); // Override for testing
 
         for i in 0..20 {
             bb.record(BlackBoxEvent::Custom {
@@ -353,9 +987,35 @@ mod tests {
         assert_eq!(bb.len(), 10);
     }
 
+    #[test]
+    fn test_blackbox_ring_keeps_newest_without_persistence() {
+        let bb = BlackBox::new(1);
+        let total = THREAD_RING_CAPACITY * 3;
+
+        // Nothing drains the ring while recording (no flusher without persistence)
+        for i in 0..total {
+            bb.record(BlackBoxEvent::Custom {
+                category: "test".to_string(),
+                message: format!("event {}", i),
+            });
+        }
+
+        let events = bb.get_events();
+        assert_eq!(events.len(), THREAD_RING_CAPACITY);
+        assert_eq!(bb.dropped(), (total - THREAD_RING_CAPACITY) as u64);
+        for (record, i) in events.iter().zip(total - THREAD_RING_CAPACITY..) {
+            match &record.event {
+                BlackBoxEvent::Custom { message, .. } => {
+                    assert_eq!(message, &format!("event {}", i))
+                }
+                other => panic!("unexpected event {:?}", other),
+            }
+        }
+    }
+
     #[test]
     fn test_blackbox_anomalies() {
-        let mut bb = BlackBox::new(1);
+        let bb = BlackBox::new(1);
 
         bb.record(BlackBoxEvent::NodeTick {
             name: "ok".to_string(),
@@ -377,4 +1037,71 @@ mod tests {
         let anomalies = bb.get_anomalies();
         assert_eq!(anomalies.len(), 2);
     }
+
+    #[test]
+    fn test_blackbox_threads_and_truncation() {
+        let bb = create_shared_blackbox(1);
+
+        let handles: Vec<_> = (0..4)
+            .map(|t| {
+                let bb = bb.clone();
+                std::thread::spawn(move || {
+                    for i in 0..100 {
+                        bb.record(BlackBoxEvent::NodeTick {
+                            name: format!("node_{}", t),
+                            duration_us: i,
+                            success: true,
+                        });
+                    }
+                })
+            })
+            .collect();
+        for h in handles {
+            h.join().unwrap();
+        }
+
+        bb.record(BlackBoxEvent::NodeError {
+            name: "a_very_long_node_name_that_does_not_fit_in_the_record".to_string(),
+            error: "é".repeat(40),
+        });
+
+        assert_eq!(bb.len(), 401);
+        assert_eq!(bb.dropped(), 0);
+        match &bb.get_anomalies()[0].event {
+            BlackBoxEvent::NodeError { name, error } => {
+                assert_eq!(name.len(), 32);
+                // Cut on a char boundary, never mid-codepoint
+                assert!(error.chars().all(|c| c == 'é'));
+                assert_eq!(error.len(), 56);
+            }
+            other => panic!("unexpected {:?}", other),
+        }
+    }
+
+    #[test]
+    fn test_blackbox_wal_crash_report() {
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("blackbox.json");
+
+        {
+            let bb = BlackBox::new(1).with_persistence(path.clone());
+            bb.record(BlackBoxEvent::DeadlineMiss {
+                name: "control".to_string(),
+                deadline_us: 1000,
+                actual_us: 2500,
+            });
+            bb.tick();
+            bb.record(BlackBoxEvent::Custom {
+                category: "test".to_string(),
+                message: "before crash".to_string(),
+            });
+            // Dropped without save(): the WAL still has everything
+        }
+
+        let bb = BlackBox::new(1).with_persistence(path);
+        let report = bb.generate_crash_report();
+        assert!(report.contains("Total events: 2"));
+        assert!(report.contains("ANOMALIES (1)"));
+        assert!(report.contains("before crash"));
+    }
 }
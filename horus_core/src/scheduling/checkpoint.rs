@@ -2,14 +2,77 @@
 //!
 //! Provides periodic state snapshots that can be used to recover
 //! from crashes or rollback to known-good states.
+//!
+//! Besides whole-file checkpoints (`save_checkpoint`), the manager keeps an
+//! incremental store fed by [`CheckpointManager::submit`]. Nodes hand over
+//! copy-on-write snapshots of their state (`Node::checkpoint_state`) only
+//! when it changed; a background thread serializes them, diffs each one
+//! against the previous version in 4 KiB pages and appends the changes to
+//! the current delta segment:
+//!
+//! ```text
+//! incr_00000007.base   FULL(node)... COMMIT(checkpoint)
+//! incr_00000007.delta  FULL|PATCH(node)... COMMIT  FULL|PATCH... COMMIT ...
+//! ```
+//!
+//! Records become visible at the next COMMIT, so a torn tail after a crash
+//! is ignored on restore. Every `compact_after` commits the writer folds
+//! everything into a new base generation and deletes the old one. Restore
+//! memory-maps the newest base and its delta and replays them in one pass.
 
+use crossbeam::channel::{self, Sender, TrySendError};
+use memmap2::Mmap;
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 use std::fs::{self, File};
-use std::io::{BufReader, BufWriter};
-use std::path::PathBuf;
+use std::io::{self, BufReader, BufWriter, Write};
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+use std::thread::JoinHandle;
 use std::time::{Duration, Instant, SystemTime};
 
+/// Incremental segment file magic
+const SEGMENT_MAGIC: &[u8; 8] = b"HORUSCKP";
+/// Current segment format version
+const SEGMENT_VERSION: u32 = 1;
+/// magic + version + reserved
+const SEGMENT_HEADER_SIZE: usize = 16;
+/// kind + pad, name length, payload length
+const RECORD_HEADER_SIZE: usize = 12;
+
+/// Complete node state
+const RECORD_FULL: u8 = 1;
+/// Changed pages of a node state
+const RECORD_PATCH: u8 = 2;
+/// Checkpoint metadata; makes the preceding records visible
+const RECORD_COMMIT: u8 = 3;
+
+/// Granularity of state diffs
+const PATCH_PAGE: usize = 4096;
+/// Checkpoints that may wait for the writer before new ones are deferred
+const WRITER_QUEUE_DEPTH: usize = 2;
+/// Default number of delta commits between compactions
+pub const DEFAULT_COMPACT_AFTER: usize = 60;
+
+/// Node state handed to the checkpoint writer
+///
+/// Serialization runs on the writer thread, so implementors are usually an
+/// `Arc` of state the node updates with `Arc::make_mut`: handing it over is
+/// a reference count increment, and the node only copies if it mutates the
+/// state before the writer is done with it.
+pub trait CheckpointState: Send + Sync {
+    /// Append the serialized state to `out`
+    fn write_state(&self, out: &mut Vec<u8>);
+}
+
+impl<T: Serialize + Send + Sync> CheckpointState for T {
+    fn write_state(&self, out: &mut Vec<u8>) {
+        if let Err(e) = bincode::serialize_into(out, self) {
+            log::warn!("Checkpoint state failed to serialize: {}", e);
+        }
+    }
+}
+
 /// Checkpoint manager for periodic state persistence
 pub struct CheckpointManager {
     /// Directory to store checkpoints
@@ -24,6 +87,14 @@ pub struct CheckpointManager {
     checkpoint_index: u64,
     /// Whether checkpointing is enabled
     enabled: bool,
+    /// Background writer of the incremental store (started by `submit`)
+    writer: Option<SegmentWriterHandle>,
+    /// States not yet queued because the writer was busy, newest per node
+    deferred: HashMap<String, Arc<dyn CheckpointState>>,
+    /// Delta commits between compactions
+    compact_after: usize,
+    /// Checkpoints folded into a later one because the writer was busy
+    deferred_count: u64,
 }
 
 /// A checkpoint containing scheduler state
@@ -82,6 +153,10 @@ impl CheckpointManager {
             max_checkpoints: 10,
             checkpoint_index: 0,
             enabled: interval_ms > 0,
+            writer: None,
+            deferred: HashMap::new(),
+            compact_after: DEFAULT_COMPACT_AFTER,
+            deferred_count: 0,
         }
     }
 
@@ -131,8 +206,93 @@ impl CheckpointManager {
         Ok(path)
     }
 
+    /// Queue an incremental checkpoint for the background writer
+    ///
+    /// `states` only needs the nodes whose state changed since their last
+    /// submission. Never blocks: while the writer is still busy with earlier
+    /// checkpoints, this one is skipped and its states are carried into the
+    /// next submission (see `deferred_count`).
+    pub fn submit(
+        &mut self,
+        checkpoint: Checkpoint,
+        states: Vec<(String, Arc<dyn CheckpointState>)>,
+    ) -> io::Result<()> {
+        if self.writer.is_none() {
+            self.writer = Some(SegmentWriterHandle::start(
+                &self.checkpoint_dir,
+                self.compact_after,
+            )?);
+        }
+        self.deferred.extend(states);
+
+        let Some(writer) = self.writer.as_ref() else {
+            return Ok(());
+        };
+        let job = WriteJob {
+            checkpoint,
+            states: self.deferred.drain().collect(),
+        };
+        let job = match writer.sender.as_ref() {
+            Some(sender) => match sender.try_send(job) {
+                Ok(()) => return Ok(()),
+                Err(TrySendError::Full(job)) => {
+                    self.deferred_count += 1;
+                    self.deferred.extend(job.states);
+                    return Ok(());
+                }
+                Err(TrySendError::Disconnected(job)) => job,
+            },
+            None => job,
+        };
+        // Keep the drained states for the restarted writer's first base
+        self.deferred.extend(job.states);
+        let result = self.finish_writer();
+        result.and(Err(io::Error::other("checkpoint writer stopped")))
+    }
+
+    /// Wait until every submitted checkpoint is on disk and stop the writer
+    ///
+    /// The next `submit` continues from the stored states in a new base
+    /// generation.
+    pub fn finish_writer(&mut self) -> io::Result<()> {
+        match self.writer.take() {
+            Some(mut writer) => writer.join(),
+            None => Ok(()),
+        }
+    }
+
+    /// Number of submissions folded into a later one (writer was busy)
+    pub fn deferred_count(&self) -> u64 {
+        self.deferred_count
+    }
+
+    /// Delta commits between compactions of the incremental store
+    pub fn set_compact_after(&mut self, commits: usize) {
+        self.compact_after = commits.max(1);
+    }
+
+    /// Rebuild the latest committed checkpoint from the incremental store
+    ///
+    /// Node states are returned in `NodeCheckpoint::custom_state`.
+    pub fn load_incremental(&self) -> io::Result<Option<Checkpoint>> {
+        Ok(Replay::load(&self.checkpoint_dir)?.finish())
+    }
+
     /// Load the latest checkpoint from disk
+    ///
+    /// Prefers the incremental store when it holds a checkpoint. If the store
+    /// can't be read (corrupt, truncated or from a newer version), the
+    /// legacy checkpoint files are used instead.
     pub fn load_latest_checkpoint(&self) -> std::io::Result<Option<Checkpoint>> {
+        match self.load_incremental() {
+            Ok(Some(checkpoint)) => return Ok(Some(checkpoint)),
+            Ok(None) => {}
+            Err(e) => log::warn!(
+                "Incremental checkpoint store unreadable ({}), trying checkpoint files",
+                e
+            ),
+        }
+
         let mut checkpoints: Vec<_> = fs::read_dir(&self.checkpoint_dir)?
             .filter_map(|e| e.ok())
             .filter(|e| {
@@ -234,6 +394,14 @@ impl CheckpointManager {
     }
 }
 
+impl Drop for CheckpointManager {
+    fn drop(&mut self) {
+        if let Err(e) = self.finish_writer() {
+            log::warn!("Checkpoint writer did not finish cleanly: {}", e);
+        }
+    }
+}
+
 impl Default for CheckpointManager {
     fn default() -> Self {
         Self::new(
@@ -245,6 +413,392 @@ impl Default for CheckpointManager {
     }
 }
 
+// ============================================================================
+// Incremental store
+// ============================================================================
+
+fn invalid(msg: impl Into<String>) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, msg.into())
+}
+
+fn read_u32(bytes: &[u8], at: usize) -> u32 {
+    u32::from_le_bytes(bytes[at..at + 4].try_into().unwrap())
+}
+
+fn read_u64(bytes: &[u8], at: usize) -> u64 {
+    u64::from_le_bytes(bytes[at..at + 8].try_into().unwrap())
+}
+
+fn segment_path(dir: &Path, generation: u64, kind: &str) -> PathBuf {
+    dir.join(format!("incr_{:08}.{}", generation, kind))
+}
+
+/// Generations that have a complete base segment, ascending
+fn base_generations(dir: &Path) -> Vec<u64> {
+    let mut generations: Vec<u64> = fs::read_dir(dir)
+        .map(|entries| {
+            entries
+                .filter_map(|e| e.ok())
+                .filter_map(|e| {
+                    let name = e.file_name();
+                    let name = name.to_str()?;
+                    name.strip_prefix("incr_")?
+                        .strip_suffix(".base")?
+                        .parse()
+                        .ok()
+                })
+                .collect()
+        })
+        .unwrap_or_default();
+    generations.sort_unstable();
+    generations
+}
+
+fn latest_generation(dir: &Path) -> Option<u64> {
+    base_generations(dir).last().copied()
+}
+
+/// Start a record; returns where its payload length goes
+fn begin_record(out: &mut Vec<u8>, kind: u8, name: &str) -> usize {
+    out.extend_from_slice(&[kind, 0, 0, 0]);
+    out.extend_from_slice(&(name.len() as u32).to_le_bytes());
+    let len_at = out.len();
+    out.extend_from_slice(&0u32.to_le_bytes());
+    out.extend_from_slice(name.as_bytes());
+    len_at
+}
+
+/// Fill in the payload length of the record started at `len_at`
+fn end_record(out: &mut [u8], len_at: usize, name_len: usize) {
+    let payload_len = out.len() - (len_at + 4 + name_len);
+    out[len_at..len_at + 4].copy_from_slice(&(payload_len as u32).to_le_bytes());
+}
+
+fn write_full(out: &mut Vec<u8>, name: &str, state: &[u8]) {
+    let len_at = begin_record(out, RECORD_FULL, name);
+    out.extend_from_slice(state);
+    end_record(out, len_at, name.len());
+}
+
+/// Append the pages of `current` that differ from `previous`
+///
+/// Payload: `[new_len u64][count u32][pad u32]`, then `count` times
+/// `[page u32]` followed by that page of the new state. Falls back to a
+/// FULL record when more than half of the pages changed.
+fn write_diff(
+    out: &mut Vec<u8>,
+    pages: &mut Vec<u32>,
+    name: &str,
+    previous: &[u8],
+    current: &[u8],
+) {
+    pages.clear();
+    for (i, page) in current.chunks(PATCH_PAGE).enumerate() {
+        let start = i * PATCH_PAGE;
+        if previous.get(start..start + page.len()) != Some(page) {
+            pages.push(i as u32);
+        }
+    }
+    if pages.len() * 2 > current.len().div_ceil(PATCH_PAGE) {
+        write_full(out, name, current);
+        return;
+    }
+
+    let len_at = begin_record(out, RECORD_PATCH, name);
+    out.extend_from_slice(&(current.len() as u64).to_le_bytes());
+    out.extend_from_slice(&(pages.len() as u32).to_le_bytes());
+    out.extend_from_slice(&0u32.to_le_bytes());
+    for &page in pages.iter() {
+        let start = page as usize * PATCH_PAGE;
+        let end = (start + PATCH_PAGE).min(current.len());
+        out.extend_from_slice(&page.to_le_bytes());
+        out.extend_from_slice(&current[start..end]);
+    }
+    end_record(out, len_at, name.len());
+}
+
+/// Apply a PATCH payload to `state`; `None` if the payload is malformed
+fn apply_patch(mut state: Vec<u8>, payload: &[u8]) -> Option<Vec<u8>> {
+    if payload.len() < 16 {
+        return None;
+    }
+    let new_len = usize::try_from(read_u64(payload, 0)).ok()?;
+    let count = read_u32(payload, 8) as usize;
+    state.resize(new_len, 0);
+    let mut at = 16;
+    for _ in 0..count {
+        let page = read_u32(payload.get(at..at + 4)?, 0) as usize;
+        let start = page.checked_mul(PATCH_PAGE)?;
+        let end = (start + PATCH_PAGE).min(new_len);
+        let data = payload.get(at + 4..at + 4 + end.checked_sub(start)?)?;
+        state[start..end].copy_from_slice(data);
+        at += 4 + data.len();
+    }
+    Some(state)
+}
+
+/// One checkpoint queued for the writer thread
+struct WriteJob {
+    checkpoint: Checkpoint,
+    states: Vec<(String, Arc<dyn CheckpointState>)>,
+}
+
+struct SegmentWriterHandle {
+    sender: Option<Sender<WriteJob>>,
+    thread: Option<JoinHandle<io::Result<()>>>,
+}
+
+impl SegmentWriterHandle {
+    fn start(dir: &Path, compact_after: usize) -> io::Result<Self> {
+        fs::create_dir_all(dir)?;
+        let mut writer = SegmentWriter {
+            dir: dir.to_path_buf(),
+            generation: latest_generation(dir).unwrap_or(0),
+            delta: None,
+            commits_since_base: 0,
+            compact_after,
+            latest: HashMap::new(),
+            scratch: Vec::new(),
+            pages: Vec::new(),
+            records: Vec::new(),
+            commit: Vec::new(),
+        };
+        let (sender, receiver) = channel::bounded::<WriteJob>(WRITER_QUEUE_DEPTH);
+        let thread = std::thread::Builder::new()
+            .name("horus-checkpoint".to_string())
+            .spawn(move || {
+                // Continue from what is on disk, so nodes that do not resubmit
+                // survive the next compaction
+                writer.latest = Replay::load(&writer.dir)?.committed;
+                for job in receiver {
+                    writer.write(job)?;
+                }
+                Ok(())
+            })?;
+        Ok(Self {
+            sender: Some(sender),
+            thread: Some(thread),
+        })
+    }
+
+    fn join(&mut self) -> io::Result<()> {
+        self.sender = None;
+        match self.thread.take() {
+            Some(thread) => thread
+                .join()
+                .map_err(|_| io::Error::other("checkpoint writer panicked"))?,
+            None => Ok(()),
+        }
+    }
+}
+
+/// Writer thread state: latest serialized state of every node
+struct SegmentWriter {
+    dir: PathBuf,
+    generation: u64,
+    /// Open delta segment of the current generation (None before the first base)
+    delta: Option<BufWriter<File>>,
+    commits_since_base: usize,
+    compact_after: usize,
+    latest: HashMap<String, Vec<u8>>,
+    scratch: Vec<u8>,
+    pages: Vec<u32>,
+    records: Vec<u8>,
+    commit: Vec<u8>,
+}
+
+impl SegmentWriter {
+    fn write(&mut self, job: WriteJob) -> io::Result<()> {
+        self.records.clear();
+        for (name, state) in &job.states {
+            self.scratch.clear();
+            state.write_state(&mut self.scratch);
+            match self.latest.get_mut(name) {
+                Some(previous) if *previous == self.scratch => {}
+                Some(previous) => {
+                    write_diff(
+                        &mut self.records,
+                        &mut self.pages,
+                        name,
+                        previous,
+                        &self.scratch,
+                    );
+                    std::mem::swap(previous, &mut self.scratch);
+                }
+                None => {
+                    write_full(&mut self.records, name, &self.scratch);
+                    self.latest
+                        .insert(name.clone(), std::mem::take(&mut self.scratch));
+                }
+            }
+        }
+        // Let nodes mutate their state again without copying
+        drop(job.states);
+
+        self.commit.clear();
+        let len_at = begin_record(&mut self.commit, RECORD_COMMIT, "");
+        bincode::serialize_into(&mut self.commit, &job.checkpoint).map_err(io::Error::other)?;
+        end_record(&mut self.commit, len_at, 0);
+
+        match self.delta.as_mut() {
+            Some(delta) if self.commits_since_base < self.compact_after => {
+                delta.write_all(&self.records)?;
+                delta.write_all(&self.commit)?;
+                delta.flush()?;
+                delta.get_ref().sync_data()?;
+                self.commits_since_base += 1;
+                Ok(())
+            }
+            _ => self.compact(),
+        }
+    }
+
+    /// Write every latest state into a new base generation, drop older ones
+    fn compact(&mut self) -> io::Result<()> {
+        let generation = self.generation + 1;
+        let base = segment_path(&self.dir, generation, "base");
+        let tmp = base.with_extension("base.tmp");
+
+        let mut header = [0u8; SEGMENT_HEADER_SIZE];
+        header[..8].copy_from_slice(SEGMENT_MAGIC);
+        header[8..12].copy_from_slice(&SEGMENT_VERSION.to_le_bytes());
+
+        let mut out = BufWriter::new(File::create(&tmp)?);
+        out.write_all(&header)?;
+        self.records.clear();
+        for (name, state) in &self.latest {
+            write_full(&mut self.records, name, state);
+            out.write_all(&self.records)?;
+            self.records.clear();
+        }
+        out.write_all(&self.commit)?;
+        out.flush()?;
+        out.get_ref().sync_all()?;
+        drop(out);
+        fs::rename(&tmp, &base)?;
+
+        let mut delta = BufWriter::new(File::create(segment_path(&self.dir, generation, "delta"))?);
+        delta.write_all(&header)?;
+        delta.flush()?;
+
+        for old in base_generations(&self.dir) {
+            if old < generation {
+                let _ = fs::remove_file(segment_path(&self.dir, old, "base"));
+                let _ = fs::remove_file(segment_path(&self.dir, old, "delta"));
+            }
+        }
+
+        self.generation = generation;
+        self.delta = Some(delta);
+        self.commits_since_base = 0;
+        Ok(())
+    }
+}
+
+/// Replays segments into the latest committed state
+#[derive(Default)]
+struct Replay {
+    committed: HashMap<String, Vec<u8>>,
+    /// Records since the last COMMIT
+    staged: HashMap<String, Vec<u8>>,
+    checkpoint: Option<Checkpoint>,
+}
+
+impl Replay {
+    /// Replay the newest generation in `dir` (empty if there is none)
+    fn load(dir: &Path) -> io::Result<Self> {
+        let mut replay = Replay::default();
+        if let Some(generation) = latest_generation(dir) {
+            replay.apply_file(&segment_path(dir, generation, "base"))?;
+            let delta = segment_path(dir, generation, "delta");
+            if delta.exists() {
+                replay.apply_file(&delta)?;
+            }
+        }
+        Ok(replay)
+    }
+
+    fn apply_file(&mut self, path: &Path) -> io::Result<()> {
+        let file = File::open(path)?;
+        // SAFETY: segments are append-only and only read here; every access
+        // is bounds-checked against the mapped length
+        let map = unsafe { Mmap::map(&file)? };
+        if map.len() < SEGMENT_HEADER_SIZE || &map[..8] != SEGMENT_MAGIC {
+            return Err(invalid("not a HORUS checkpoint segment"));
+        }
+        let version = read_u32(&map, 8);
+        if version != SEGMENT_VERSION {
+            return Err(invalid(format!(
+                "unsupported checkpoint segment version {}",
+                version
+            )));
+        }
+
+        self.staged.clear();
+        let mut at = SEGMENT_HEADER_SIZE;
+        while at + RECORD_HEADER_SIZE <= map.len() {
+            let kind = map[at];
+            let name_len = read_u32(&map, at + 4) as usize;
+            let payload_len = read_u32(&map, at + 8) as usize;
+            let name_at = at + RECORD_HEADER_SIZE;
+            let payload_at = name_at + name_len;
+            let end = payload_at + payload_len;
+            if end > map.len() {
+                break; // Torn tail
+            }
+            let Ok(name) = std::str::from_utf8(&map[name_at..payload_at]) else {
+                break;
+            };
+            let payload = &map[payload_at..end];
+
+            match kind {
+                RECORD_FULL => {
+                    self.staged.insert(name.to_string(), payload.to_vec());
+                }
+                RECORD_PATCH => {
+                    let base = self
+                        .staged
+                        .remove(name)
+                        .or_else(|| self.committed.get(name).cloned())
+                        .unwrap_or_default();
+                    let Some(state) = apply_patch(base, payload) else {
+                        break;
+                    };
+                    self.staged.insert(name.to_string(), state);
+                }
+                RECORD_COMMIT => {
+                    let Ok(checkpoint) = bincode::deserialize(payload) else {
+                        break;
+                    };
+                    self.committed.extend(self.staged.drain());
+                    self.checkpoint = Some(checkpoint);
+                }
+                _ => break,
+            }
+            at = end;
+        }
+        Ok(())
+    }
+
+    fn finish(self) -> Option<Checkpoint> {
+        let mut checkpoint = self.checkpoint?;
+        for (name, state) in self.committed {
+            checkpoint
+                .node_states
+                .entry(name.clone())
+                .or_insert_with(|| NodeCheckpoint {
+                    name,
+                    tick_count: 0,
+                    last_tick_us: 0,
+                    error_count: 0,
+                    custom_state: None,
+                })
+                .custom_state = Some(state);
+        }
+        Some(checkpoint)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -294,4 +848,192 @@ mod tests {
         let checkpoints = manager.list_checkpoints();
         assert!(checkpoints.len() <= 3);
     }
+
+    fn empty_checkpoint(manager: &mut CheckpointManager, total_ticks: u64) -> Checkpoint {
+        manager
+            .create_checkpoint(CheckpointMetadata {
+                scheduler_name: "test".to_string(),
+                total_ticks,
+                learning_complete: true,
+                node_count: 2,
+                uptime_secs: 0.0,
+            })
+            .unwrap()
+    }
+
+    #[test]
+    fn test_incremental_roundtrip() {
+        let temp_dir = TempDir::new().unwrap();
+        let mut manager = CheckpointManager::new(temp_dir.path().to_path_buf(), 1000);
+
+        // A large map with local edits goes out as page patches
+        let mut map = Arc::new(vec![0u8; 64 * 1024]);
+        let pose = Arc::new((1.0f64, 2.0f64));
+        for step in 0..9u8 {
+            Arc::make_mut(&mut map)[step as usize * 5000] = step + 1;
+            let mut states: Vec<(String, Arc<dyn CheckpointState>)> =
+                vec![("slam".to_string(), map.clone())];
+            if step == 0 {
+                states.push(("pose".to_string(), pose.clone()));
+            }
+            let checkpoint = empty_checkpoint(&mut manager, step as u64);
+            manager.submit(checkpoint, states).unwrap();
+            let sender = manager.writer.as_ref().unwrap().sender.as_ref().unwrap();
+            while !sender.is_empty() {
+                std::thread::yield_now();
+            }
+        }
+        manager.finish_writer().unwrap();
+
+        // Eight commits of one changed page each, less than one copy of the map
+        let generation = latest_generation(temp_dir.path()).unwrap();
+        let delta_len = fs::metadata(segment_path(temp_dir.path(), generation, "delta"))
+            .unwrap()
+            .len();
+        assert!(delta_len < 64 * 1024, "delta is {} bytes", delta_len);
+
+        let restored = manager.load_incremental().unwrap().unwrap();
+        assert_eq!(restored.metadata.total_ticks, 8);
+        let slam: Vec<u8> =
+            bincode::deserialize(restored.node_states["slam"].custom_state.as_ref().unwrap())
+                .unwrap();
+        assert_eq!(slam, *map);
+        let restored_pose: (f64, f64) =
+            bincode::deserialize(restored.node_states["pose"].custom_state.as_ref().unwrap())
+                .unwrap();
+        assert_eq!(restored_pose, *pose);
+    }
+
+    #[test]
+    fn test_incremental_compaction_and_torn_tail() {
+        let temp_dir = TempDir::new().unwrap();
+        let mut manager = CheckpointManager::new(temp_dir.path().to_path_buf(), 1000);
+        manager.set_compact_after(3);
+
+        for step in 0..8u64 {
+            let state: Arc<dyn CheckpointState> = Arc::new(vec![step; 100]);
+            let checkpoint = empty_checkpoint(&mut manager, step);
+            manager
+                .submit(checkpoint, vec![("node".to_string(), state)])
+                .unwrap();
+            // Keep the queue from filling so no checkpoint is deferred
+            let sender = manager.writer.as_ref().unwrap().sender.as_ref().unwrap();
+            while !sender.is_empty() {
+                std::thread::yield_now();
+            }
+        }
+        manager.finish_writer().unwrap();
+        assert_eq!(manager.deferred_count(), 0);
+
+        // Only the newest generation survives compaction
+        let generations = base_generations(temp_dir.path());
+        assert_eq!(generations, vec![2]);
+
+        let restored = manager.load_incremental().unwrap().unwrap();
+        let latest_ticks = restored.metadata.total_ticks;
+        assert_eq!(latest_ticks, 7);
+        let state: Vec<u64> =
+            bincode::deserialize(restored.node_states["node"].custom_state.as_ref().unwrap())
+                .unwrap();
+        assert_eq!(state, vec![latest_ticks; 100]);
+
+        // An uncommitted record and a torn header at the end are ignored
+        let delta = segment_path(temp_dir.path(), generations[0], "delta");
+        let mut tail = Vec::new();
+        write_full(&mut tail, "node", &[0xFF; 32]);
+        tail.extend_from_slice(&[RECORD_FULL, 0, 0]);
+        let mut file = fs::OpenOptions::new().append(true).open(&delta).unwrap();
+        file.write_all(&tail).unwrap();
+        drop(file);
+
+        let again = manager.load_incremental().unwrap().unwrap();
+        assert_eq!(again.metadata.total_ticks, latest_ticks);
+        assert_eq!(
+            again.node_states["node"].custom_state,
+            restored.node_states["node"].custom_state
+        );
+    }
+
+    #[test]
+    fn test_corrupt_incremental_store_falls_back_to_files() {
+        let temp_dir = TempDir::new().unwrap();
+        let mut manager = CheckpointManager::new(temp_dir.path().to_path_buf(), 1000);
+
+        let legacy = empty_checkpoint(&mut manager, 42);
+        manager.save_checkpoint(&legacy).unwrap();
+
+        let state: Arc<dyn CheckpointState> = Arc::new(vec![1u8; 100]);
+        let checkpoint = empty_checkpoint(&mut manager, 43);
+        manager
+            .submit(checkpoint, vec![("node".to_string(), state)])
+            .unwrap();
+        manager.finish_writer().unwrap();
+
+        // Clobber the base segment's header
+        let generation = latest_generation(temp_dir.path()).unwrap();
+        let base = segment_path(temp_dir.path(), generation, "base");
+        let mut bytes = fs::read(&base).unwrap();
+        bytes[..8].copy_from_slice(b"GARBAGE!");
+        fs::write(&base, bytes).unwrap();
+
+        assert!(manager.load_incremental().is_err());
+        let loaded = manager.load_latest_checkpoint().unwrap().unwrap();
+        assert_eq!(loaded.id, legacy.id);
+        assert_eq!(loaded.metadata.total_ticks, 42);
+    }
+
+    #[test]
+    fn test_states_survive_disconnected_writer() {
+        let temp_dir = TempDir::new().unwrap();
+        let mut manager = CheckpointManager::new(temp_dir.path().to_path_buf(), 1000);
+
+        let first: Arc<dyn CheckpointState> = Arc::new(vec![1u8; 10]);
+        let checkpoint = empty_checkpoint(&mut manager, 1);
+        manager
+            .submit(checkpoint, vec![("a".to_string(), first)])
+            .unwrap();
+
+        // The writer goes away behind the manager's back
+        let writer = manager.writer.as_mut().unwrap();
+        drop(writer.sender.take());
+        if let Some(thread) = writer.thread.take() {
+            thread.join().unwrap().unwrap();
+        }
+        writer.sender = Some(channel::bounded(1).0);
+
+        let second: Arc<dyn CheckpointState> = Arc::new(vec![2u8; 10]);
+        let checkpoint = empty_checkpoint(&mut manager, 2);
+        assert!(manager
+            .submit(checkpoint, vec![("b".to_string(), second)])
+            .is_err());
+        assert!(manager.deferred.contains_key("b"));
+
+        // The restarted writer still stores the state that was in flight
+        let checkpoint = empty_checkpoint(&mut manager, 3);
+        manager.submit(checkpoint, Vec::new()).unwrap();
+        manager.finish_writer().unwrap();
+        let restored = manager.load_incremental().unwrap().unwrap();
+        assert_eq!(restored.metadata.total_ticks, 3);
+        let b: Vec<u8> =
+            bincode::deserialize(restored.node_states["b"].custom_state.as_ref().unwrap()).unwrap();
+        assert_eq!(b, vec![2u8; 10]);
+        assert!(restored.node_states.contains_key("a"));
+    }
+
+    #[test]
+    fn test_patch_roundtrip() {
+        let previous: Vec<u8> = (0..20_000u32).map(|i| i as u8).collect();
+        let mut current = previous.clone();
+        current[4100] = 7;
+        current.truncate(15_000);
+
+        let (mut out, mut pages) = (Vec::new(), Vec::new());
+        write_diff(&mut out, &mut pages, "n", &previous, &current);
+        assert_eq!(out[0], RECORD_PATCH);
+        // The truncated last page is unchanged
+        assert_eq!(pages, vec![1]);
+
+        let payload = &out[RECORD_HEADER_SIZE + 1..];
+        assert_eq!(apply_patch(previous, payload).unwrap(), current);
+    }
 }
@@ -138,6 +138,11 @@ pub struct MonitoringConfig {
     pub black_box_enabled: bool,
     /// Black box buffer size in MB
     pub black_box_size_mb: usize,
+    /// Record per-node tick latency histograms (p50/p99/p99.9/max)
+    pub latency_histograms: bool,
+    /// Also count cycles / instructions / LLC misses / context switches
+    /// around each node tick (implies `latency_histograms`)
+    pub hardware_counters: bool,
 }
 
 /// Robot-specific presets
@@ -267,6 +272,8 @@ impl SchedulerConfig {
                 telemetry_endpoint: None,
                 black_box_enabled: false,
                 black_box_size_mb: 0,
+                latency_histograms: false,
+                hardware_counters: false,
             },
             preset: RobotPreset::Standard,
             custom: HashMap::new(),
@@ -321,6 +328,8 @@ impl SchedulerConfig {
                 telemetry_endpoint: Some("local".to_string()),
                 black_box_enabled: true, // Always record
                 black_box_size_mb: 1024, // Large buffer
+                latency_histograms: false,
+                hardware_counters: false,
             },
             preset: RobotPreset::SafetyCritical,
             custom: HashMap::new(),
@@ -375,6 +384,8 @@ impl SchedulerConfig {
                 telemetry_endpoint: None,
                 black_box_enabled: false,
                 black_box_size_mb: 0,
+                latency_histograms: false,
+                hardware_counters: false,
             },
             preset: RobotPreset::HighPerformance,
             custom: HashMap::new(),
@@ -0,0 +1,143 @@
+//! Event-driven node triggering
+//!
+//! An event-driven node only ticks when one of the topics it subscribes to
+//! has published since its previous tick. The scheduler parks on the topics'
+//! shared futex words between ticks instead of sleeping a fixed period, so
+//! such nodes react within microseconds and idle robots use almost no CPU.
+
+use crate::memory::TopicNotifier;
+use std::collections::HashMap;
+use std::time::{Duration, Instant};
+
+/// How long to wait before retrying a topic that could not be opened yet
+const OPEN_RETRY: Duration = Duration::from_secs(1);
+
+/// Per-node set of watched topics and the epochs seen at the last tick
+#[derive(Default)]
+pub(crate) struct EventTrigger {
+    /// Watched topics: (name, notifier, epoch at last tick)
+    topics: Vec<(String, TopicNotifier, u32)>,
+    /// Topics whose shared memory did not exist yet, with the last attempt
+    pending_open: HashMap<String, Instant>,
+    /// Set after the first tick; until then the node ticks unconditionally
+    /// so that it gets a chance to register its subscriptions
+    primed: bool,
+}
+
+impl EventTrigger {
+    pub(crate) fn new() -> Self {
+        Self::default()
+    }
+
+    /// Whether the node has new input (or has never ticked)
+    #[inline]
+    pub(crate) fn is_pending(&self) -> bool {
+        !self.primed
+            || self
+                .topics
+                .iter()
+                .any(|(_, notifier, seen)| notifier.epoch() != *seen)
+    }
+
+    /// Record the current epochs right before the node ticks
+    ///
+    /// Anything published during the tick therefore triggers the next one.
+    #[inline]
+    pub(crate) fn begin_tick(&mut self) {
+        for (_, notifier, seen) in self.topics.iter_mut() {
+            *seen = notifier.epoch();
+        }
+        self.primed = true;
+    }
+
+    /// Number of topics being watched (resolved or still waiting to open)
+    pub(crate) fn known_topics(&self) -> usize {
+        self.topics.len() + self.pending_open.len()
+    }
+
+    /// Start watching any topics from `names` not already known
+    pub(crate) fn watch<'a>(&mut self, names: impl IntoIterator<Item = &'a str>) {
+        for name in names {
+            if self.topics.iter().any(|(n, _, _)| n == name) {
+                continue;
+            }
+            self.pending_open
+                .entry(name.to_string())
+                .or_insert_with(|| {
+                    Instant::now()
+                        .checked_sub(OPEN_RETRY)
+                        .unwrap_or_else(Instant::now)
+                });
+        }
+        self.retry_pending();
+    }
+
+    /// Try again to open topics that did not exist when first seen
+    pub(crate) fn retry_pending(&mut self) {
+        if self.pending_open.is_empty() {
+            return;
+        }
+        let now = Instant::now();
+        let mut opened = Vec::new();
+        for (name, last_attempt) in self.pending_open.iter_mut() {
+            if now.duration_since(*last_attempt) < OPEN_RETRY {
+                continue;
+            }
+            *last_attempt = now;
+            if let Ok(notifier) = TopicNotifier::open(name) {
+                // Treat the topic as changed so data published before we
+                // started watching is not missed
+                let seen = notifier.epoch().wrapping_sub(1);
+                opened.push((name.clone(), notifier, seen));
+            }
+        }
+        for (name, notifier, seen) in opened {
+            self.pending_open.remove(&name);
+            self.topics.push((name, notifier, seen));
+        }
+    }
+
+    /// Park until any trigger has new input, or `timeout` expires
+    ///
+    /// Returns true if woken by a publish.
+    pub(crate) fn wait_any<'a>(
+        triggers: impl IntoIterator<Item = &'a EventTrigger>,
+        timeout: Duration,
+    ) -> bool {
+        let words: Vec<(&TopicNotifier, u32)> = triggers
+            .into_iter()
+            .flat_map(|t| t.topics.iter().map(|(_, notifier, seen)| (notifier, *seen)))
+            .collect();
+        TopicNotifier::wait_any(&words, timeout)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::memory::ShmTopic;
+
+    #[test]
+    fn test_trigger_fires_on_publish() {
+        let name = format!("test_event_trigger_{}", std::process::id());
+        let topic = ShmTopic::<u64>::new(&name, 8).unwrap();
+
+        let mut trigger = EventTrigger::new();
+        assert!(trigger.is_pending(), "Unprimed trigger always fires");
+
+        trigger.watch([name.as_str()]);
+        trigger.begin_tick();
+        assert!(!trigger.is_pending());
+
+        topic.push(7).unwrap();
+        assert!(trigger.is_pending());
+        assert!(EventTrigger::wait_any([&trigger], Duration::from_secs(1)));
+
+        trigger.begin_tick();
+        assert!(!trigger.is_pending());
+        assert!(!EventTrigger::wait_any(
+            [&trigger],
+            Duration::from_millis(5)
+        ));
+    }
+}
@@ -5,4 +5,4 @@ pub mod parallel;
 pub mod async_io;
 
 pub use async_io::{AsyncIOExecutor, AsyncResult};
-pub use parallel::ParallelExecutor;
+pub use parallel::{LevelMetrics, ParallelExecutor};
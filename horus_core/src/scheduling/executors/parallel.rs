@@ -1,15 +1,95 @@
-//! Parallel executor module for thread pool configuration
+//! Parallel executor module for running dependency-graph levels concurrently
 //!
-//! This module provides thread pool configuration for the scheduler.
-//! Actual parallel execution is handled by AsyncIOExecutor for I/O-bound nodes.
+//! Nodes in the same dependency level have no pub/sub edges between them, so
+//! they can tick at the same time. The executor owns a work-stealing worker
+//! pool (rayon), optionally pinned to the cores given by `set_cpu_cores`.
+//! Each call to `run_level` hands every node to exactly one worker and only
+//! returns once all of them have finished, which acts as the per-level barrier.
 
-/// Parallel executor configuration for thread pool settings
-#[derive(Debug)]
+use rayon::prelude::*;
+use std::time::{Duration, Instant};
+
+/// Execution metrics for a single dependency level
+#[derive(Debug, Clone, Default)]
+pub struct LevelMetrics {
+    /// Number of times this level was executed
+    pub executions: u64,
+    /// Number of nodes ticked in the most recent execution
+    pub last_node_count: usize,
+    /// Wall-clock time of the most recent execution (barrier to barrier)
+    pub last_makespan: Duration,
+    /// Largest makespan observed
+    pub max_makespan: Duration,
+    /// Sum of all makespans
+    pub total_makespan: Duration,
+    /// Sum of individual node tick times (what a sequential run would cost)
+    pub total_node_time: Duration,
+    /// Executions that were dispatched to the worker pool
+    pub parallel_executions: u64,
+}
+
+impl LevelMetrics {
+    /// Average wall-clock time per execution of this level
+    pub fn avg_makespan(&self) -> Duration {
+        if self.executions == 0 {
+            Duration::ZERO
+        } else {
+            self.total_makespan / self.executions as u32
+        }
+    }
+
+    /// Ratio of summed node time to makespan (>1.0 means nodes overlapped)
+    pub fn speedup(&self) -> f64 {
+        let makespan = self.total_makespan.as_secs_f64();
+        if makespan > 0.0 {
+            self.total_node_time.as_secs_f64() / makespan
+        } else {
+            1.0
+        }
+    }
+
+    fn record(
+        &mut self,
+        node_count: usize,
+        makespan: Duration,
+        node_time: Duration,
+        parallel: bool,
+    ) {
+        self.executions += 1;
+        self.last_node_count = node_count;
+        self.last_makespan = makespan;
+        self.max_makespan = self.max_makespan.max(makespan);
+        self.total_makespan += makespan;
+        self.total_node_time += node_time;
+        if parallel {
+            self.parallel_executions += 1;
+        }
+    }
+}
+
+/// Parallel executor backed by a work-stealing thread pool
 pub struct ParallelExecutor {
     /// Number of worker threads (defaults to CPU count)
     num_threads: usize,
     /// CPU cores to pin threads to (optional)
     cpu_cores: Option<Vec<usize>>,
+    /// Worker pool, built lazily on first parallel level
+    pool: Option<rayon::ThreadPool>,
+    /// Set when pool creation failed so we don't retry every tick
+    pool_failed: bool,
+    /// Per-level execution metrics (indexed by dependency level)
+    level_metrics: Vec<LevelMetrics>,
+}
+
+impl std::fmt::Debug for ParallelExecutor {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("ParallelExecutor")
+            .field("num_threads", &self.num_threads)
+            .field("cpu_cores", &self.cpu_cores)
+            .field("pool_started", &self.pool.is_some())
+            .field("levels", &self.level_metrics.len())
+            .finish()
+    }
 }
 
 impl ParallelExecutor {
@@ -19,18 +99,151 @@ impl ParallelExecutor {
         Self {
             num_threads,
             cpu_cores: None,
+            pool: None,
+            pool_failed: false,
+            level_metrics: Vec::new(),
         }
     }
 
     /// Set the maximum number of threads to use
     pub fn set_max_threads(&mut self, num_threads: usize) {
         self.num_threads = num_threads.max(1);
+        self.reset_pool();
     }
 
     /// Set specific CPU cores to pin threads to
+    ///
+    /// The pool runs one worker per listed core; worker `i` is pinned to `cores[i]`.
+    /// A single-threaded (sequential) executor stays single-threaded.
     pub fn set_cpu_cores(&mut self, cores: Vec<usize>) {
         if !cores.is_empty() {
+            if self.num_threads > 1 {
+                self.num_threads = cores.len();
+            }
             self.cpu_cores = Some(cores);
+            self.reset_pool();
+        }
+    }
+
+    /// Whether levels with several nodes will be dispatched to worker threads
+    pub fn is_parallel(&self) -> bool {
+        self.num_threads > 1 && !self.pool_failed
+    }
+
+    /// Number of worker threads
+    pub fn num_threads(&self) -> usize {
+        self.num_threads
+    }
+
+    /// Per-level execution metrics, indexed by dependency level
+    pub fn level_metrics(&self) -> &[LevelMetrics] {
+        &self.level_metrics
+    }
+
+    /// Drop collected level metrics (e.g. after the dependency graph changes)
+    pub fn clear_level_metrics(&mut self) {
+        self.level_metrics.clear();
+    }
+
+    /// Record a level that was executed on the calling thread
+    pub fn record_sequential_level(
+        &mut self,
+        level: usize,
+        node_count: usize,
+        makespan: Duration,
+        node_time: Duration,
+    ) {
+        self.metrics_for(level)
+            .record(node_count, makespan, node_time, false);
+    }
+
+    /// Run `f` once for every item of a dependency level on the worker pool
+    ///
+    /// Each item is owned by exactly one worker for the duration of the call,
+    /// and the call returns only when every item is done (per-level barrier).
+    /// Results are returned in the same order as `items`. `node_time` maps a
+    /// result to the time its node spent ticking, used for speedup metrics.
+    ///
+    /// Falls back to running on the calling thread if the pool is unavailable.
+    pub fn run_level<T, R, F, D>(
+        &mut self,
+        level: usize,
+        items: &mut [T],
+        f: F,
+        node_time: D,
+    ) -> Vec<R>
+    where
+        T: Send,
+        R: Send,
+        F: Fn(&mut T) -> R + Sync,
+        D: Fn(&R) -> Duration,
+    {
+        let start = Instant::now();
+        let parallel = items.len() > 1 && self.ensure_pool();
+
+        let results: Vec<R> = match (&self.pool, parallel) {
+            (Some(pool), true) => pool.install(|| items.par_iter_mut().map(&f).collect()),
+            _ => items.iter_mut().map(&f).collect(),
+        };
+
+        let makespan = start.elapsed();
+        let total: Duration = results.iter().map(node_time).sum();
+        self.metrics_for(level)
+            .record(items.len(), makespan, total, parallel);
+
+        results
+    }
+
+    fn metrics_for(&mut self, level: usize) -> &mut LevelMetrics {
+        if self.level_metrics.len() <= level {
+            self.level_metrics
+                .resize_with(level + 1, LevelMetrics::default);
+        }
+        &mut self.level_metrics[level]
+    }
+
+    fn reset_pool(&mut self) {
+        self.pool = None;
+        self.pool_failed = false;
+    }
+
+    /// Build the worker pool on first use. Returns false if running sequentially.
+    fn ensure_pool(&mut self) -> bool {
+        if self.num_threads <= 1 || self.pool_failed {
+            return false;
+        }
+        if self.pool.is_some() {
+            return true;
+        }
+
+        let cores = self.cpu_cores.clone();
+        let builder = rayon::ThreadPoolBuilder::new()
+            .num_threads(self.num_threads)
+            .thread_name(|i| format!("horus-worker-{}", i))
+            .start_handler(move |i| {
+                if let Some(ref cores) = cores {
+                    let core = cores[i % cores.len()];
+                    if let Some(core_ids) = core_affinity::get_core_ids() {
+                        if core < core_ids.len() {
+                            core_affinity::set_for_current(core_ids[core]);
+                        }
+                    }
+                }
+            });
+
+        match builder.build() {
+            Ok(pool) => {
+                self.pool = Some(pool);
+                true
+            }
+            Err(e) => {
+                eprintln!(
+                    "[PARALLEL] Failed to start worker pool, running levels sequentially: {}",
+                    e
+                );
+                self.pool_failed = true;
+                false
+            }
         }
     }
 }
@@ -40,3 +253,72 @@ impl Default for ParallelExecutor {
         Self::new()
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+    use std::sync::Arc;
+
+    #[test]
+    fn test_run_level_visits_each_item_once() {
+        let mut executor = ParallelExecutor::new();
+        executor.set_max_threads(4);
+
+        let mut items: Vec<u64> = (0..32).collect();
+        let results = executor.run_level(
+            0,
+            &mut items,
+            |x| {
+                *x *= 2;
+                *x
+            },
+            |_| Duration::ZERO,
+        );
+
+        assert_eq!(results, (0..32).map(|x| x * 2).collect::<Vec<_>>());
+        assert_eq!(items, results);
+        assert_eq!(executor.level_metrics()[0].executions, 1);
+        assert_eq!(executor.level_metrics()[0].last_node_count, 32);
+    }
+
+    #[test]
+    fn test_level_nodes_overlap() {
+        let mut executor = ParallelExecutor::new();
+        executor.set_max_threads(4);
+
+        let active = Arc::new(AtomicUsize::new(0));
+        let peak = Arc::new(AtomicUsize::new(0));
+        let mut items = vec![(); 4];
+
+        executor.run_level(
+            2,
+            &mut items,
+            |_| {
+                let now = active.fetch_add(1, Ordering::SeqCst) + 1;
+                peak.fetch_max(now, Ordering::SeqCst);
+                std::thread::sleep(Duration::from_millis(20));
+                active.fetch_sub(1, Ordering::SeqCst);
+                Duration::from_millis(20)
+            },
+            |d| *d,
+        );
+
+        assert!(peak.load(Ordering::SeqCst) > 1);
+        let metrics = &executor.level_metrics()[2];
+        assert_eq!(metrics.parallel_executions, 1);
+        assert!(metrics.speedup() > 1.0);
+    }
+
+    #[test]
+    fn test_single_thread_runs_sequentially() {
+        let mut executor = ParallelExecutor::new();
+        executor.set_max_threads(1);
+        assert!(!executor.is_parallel());
+
+        let mut items = vec![1, 2, 3];
+        let results = executor.run_level(0, &mut items, |x| *x + 1, |_| Duration::ZERO);
+        assert_eq!(results, vec![2, 3, 4]);
+        assert_eq!(executor.level_metrics()[0].parallel_executions, 0);
+    }
+}
@@ -0,0 +1,232 @@
+//! Fusion of linear dataflow chains into one JIT kernel
+//!
+//! A chain is a run of JIT-capable nodes where each node's only published
+//! topic is consumed by exactly one node, the next one in the chain, whose
+//! only subscription it is. The scheduler compiles the chain's fused graph
+//! into a single kernel run by the head; inner nodes stop ticking and the
+//! tail publishes the kernel's outputs. Intermediate topics go quiet, which
+//! other processes (monitors, dashboards, loggers) would notice, so chains
+//! are only fused where the user opted in with
+//! `Scheduler::fuse_dataflow_chain`.
+
+use super::jit::DataflowKernel;
+use crate::core::Node;
+use parking_lot::Mutex;
+use std::collections::HashMap;
+use std::sync::Arc;
+
+/// What chain detection needs to know about one node
+pub(crate) struct FusionCandidate<'a> {
+    pub publishes: Vec<&'a str>,
+    pub subscribes: Vec<&'a str>,
+    /// (inputs, outputs) of the node's dataflow graph; None = not fusable
+    pub arity: Option<(usize, usize)>,
+    /// Nodes with different rates can't share one kernel tick
+    pub rate_hz: Option<f64>,
+}
+
+/// Find fusable chains, as node indices from head to tail
+///
+/// `linked(i, j)` says whether node `i` may hand its output to node `j`
+/// inside a fused kernel. Single-node "chains" are returned too: they
+/// still gain from running their graph as native code, and keep
+/// publishing their topic.
+pub(crate) fn find_chains(
+    nodes: &[FusionCandidate<'_>],
+    linked: impl Fn(usize, usize) -> bool,
+) -> Vec<Vec<usize>> {
+    let mut subscribers: HashMap<&str, Vec<usize>> = HashMap::new();
+    let mut publishers: HashMap<&str, usize> = HashMap::new();
+    for (i, node) in nodes.iter().enumerate() {
+        for topic in &node.subscribes {
+            subscribers.entry(topic).or_default().push(i);
+        }
+        for topic in &node.publishes {
+            *publishers.entry(topic).or_default() += 1;
+        }
+    }
+
+    // next[i] = the node that node i feeds exclusively
+    let mut next: Vec<Option<usize>> = vec![None; nodes.len()];
+    let mut has_prev = vec![false; nodes.len()];
+    for (i, node) in nodes.iter().enumerate() {
+        let (Some((_, outputs)), [topic]) = (node.arity, node.publishes.as_slice()) else {
+            continue;
+        };
+        let Some(&[j]) = subscribers.get(topic).map(Vec::as_slice) else {
+            continue;
+        };
+        let succ = &nodes[j];
+        if j != i
+            && publishers[topic] == 1
+            && succ.subscribes.len() == 1
+            && succ.arity.is_some_and(|(inputs, _)| inputs == outputs)
+            && succ.rate_hz == node.rate_hz
+            && linked(i, j)
+        {
+            next[i] = Some(j);
+            has_prev[j] = true;
+        }
+    }
+
+    // Every node has at most one successor and one predecessor, so walking
+    // from each predecessor-less node visits disjoint paths (cycles have no
+    // such node and are left unfused)
+    let mut chains = Vec::new();
+    for head in 0..nodes.len() {
+        if nodes[head].arity.is_none() || has_prev[head] {
+            continue;
+        }
+        let mut chain = vec![head];
+        let mut cur = head;
+        while let Some(j) = next[cur] {
+            chain.push(j);
+            cur = j;
+        }
+        chains.push(chain);
+    }
+    chains
+}
+
+/// Kernel outputs handed from a chain's head to its tail
+#[derive(Debug, Default)]
+pub(crate) struct FusedHandoff {
+    pub outputs: Vec<f64>,
+    pub fresh: bool,
+}
+
+/// A node's part in a fused chain
+pub(crate) enum FusedRole {
+    /// Head and tail: reads inputs, runs the kernel and writes outputs
+    Solo {
+        kernel: DataflowKernel,
+        inputs: Vec<f64>,
+        outputs: Vec<f64>,
+    },
+    /// Reads inputs and runs the kernel for the whole chain
+    Head {
+        kernel: DataflowKernel,
+        inputs: Vec<f64>,
+        handoff: Arc<Mutex<FusedHandoff>>,
+    },
+    /// Work is inlined into the head's kernel; never ticked
+    Inner,
+    /// Publishes the outputs the head computed this tick
+    Tail { handoff: Arc<Mutex<FusedHandoff>> },
+}
+
+impl FusedRole {
+    /// Take this node's part of the fused tick in place of `Node::tick`
+    pub(crate) fn tick(&mut self, node: &mut dyn Node) {
+        match self {
+            FusedRole::Solo {
+                kernel,
+                inputs,
+                outputs,
+            } => {
+                if node.jit_read_inputs(inputs) {
+                    kernel.run(inputs, outputs);
+                    node.jit_write_outputs(outputs);
+                }
+            }
+            FusedRole::Head {
+                kernel,
+                inputs,
+                handoff,
+            } => {
+                if node.jit_read_inputs(inputs) {
+                    let mut handoff = handoff.lock();
+                    kernel.run(inputs, &mut handoff.outputs);
+                    handoff.fresh = true;
+                }
+            }
+            FusedRole::Inner => {}
+            FusedRole::Tail { handoff } => {
+                let mut handoff = handoff.lock();
+                if handoff.fresh {
+                    handoff.fresh = false;
+                    node.jit_write_outputs(&handoff.outputs);
+                }
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn node<'a>(
+        publishes: &[&'a str],
+        subscribes: &[&'a str],
+        arity: Option<(usize, usize)>,
+    ) -> FusionCandidate<'a> {
+        FusionCandidate {
+            publishes: publishes.to_vec(),
+            subscribes: subscribes.to_vec(),
+            arity,
+            rate_hz: None,
+        }
+    }
+
+    #[test]
+    fn test_linear_chain() {
+        // Registration order differs from chain order
+        let nodes = [
+            node(&["cmd"], &["err"], Some((2, 1))),    // pid
+            node(&["err"], &["target"], Some((1, 2))), // scale
+            node(&["wheels"], &["cmd"], Some((1, 2))), // drive
+            node(&["log"], &["wheels"], None),         // not fusable
+        ];
+        assert_eq!(find_chains(&nodes, |_, _| true), vec![vec![1, 0, 2]]);
+    }
+
+    #[test]
+    fn test_chain_split_where_not_opted_in() {
+        let nodes = [
+            node(&["err"], &["target"], Some((1, 2))), // scale
+            node(&["cmd"], &["err"], Some((2, 1))),    // pid
+            node(&["wheels"], &["cmd"], Some((1, 2))), // drive
+        ];
+        // Nothing opted in: every node runs its own kernel and publishes
+        assert_eq!(
+            find_chains(&nodes, |_, _| false),
+            vec![vec![0], vec![1], vec![2]]
+        );
+        // Only scale -> pid may fuse: "cmd" keeps being published
+        assert_eq!(
+            find_chains(&nodes, |i, j| (i, j) == (0, 1)),
+            vec![vec![0, 1], vec![2]]
+        );
+    }
+
+    #[test]
+    fn test_fan_out_breaks_chain() {
+        let nodes = [
+            node(&["a"], &[], Some((0, 1))),
+            node(&["b"], &["a"], Some((1, 1))),
+            node(&[], &["a"], Some((1, 0))),
+        ];
+        // "a" has two subscribers: nothing fuses, each node runs alone
+        assert_eq!(
+            find_chains(&nodes, |_, _| true),
+            vec![vec![0], vec![1], vec![2]]
+        );
+    }
+
+    #[test]
+    fn test_arity_and_rate_mismatch() {
+        let mut nodes = vec![
+            node(&["a"], &[], Some((0, 2))),
+            node(&["b"], &["a"], Some((3, 1))),
+            node(&["c"], &["b"], Some((1, 1))),
+        ];
+        nodes[2].rate_hz = Some(10.0);
+        assert_eq!(
+            find_chains(&nodes, |_, _| true),
+            vec![vec![0], vec![1], vec![2]]
+        );
+        nodes[2].rate_hz = None;
+        assert_eq!(find_chains(&nodes, |_, _| true), vec![vec![0], vec![1, 2]]);
+    }
+}
@@ -165,10 +165,15 @@ impl RuntimeProfiler {
 
         let duration_us = duration.as_micros() as f64;
 
-        self.node_stats
-            .entry(node_name.to_string())
-            .or_default()
-            .update(duration_us);
+        // Only the first sample of a node allocates its key
+        match self.node_stats.get_mut(node_name) {
+            Some(stats) => stats.update(duration_us),
+            None => self
+                .node_stats
+                .entry(node_name.to_string())
+                .or_default()
+                .update(duration_us),
+        }
     }
 
     /// Record a failure for a node (for Isolated tier classification)
@@ -177,10 +182,14 @@ impl RuntimeProfiler {
             return;
         }
 
-        self.node_stats
-            .entry(node_name.to_string())
-            .or_default()
-            .record_failure();
+        match self.node_stats.get_mut(node_name) {
+            Some(stats) => stats.record_failure(),
+            None => self
+                .node_stats
+                .entry(node_name.to_string())
+                .or_default()
+                .record_failure(),
+        }
     }
 
     /// Advance learning phase tick counter
@@ -1,3 +1,4 @@
+use super::graph::{DataflowGraph, Op};
 use cranelift::prelude::*;
 use cranelift_jit::{JITBuilder, JITModule};
 use cranelift_module::{FuncId, Linkage, Module};
@@ -193,6 +194,112 @@ impl JITCompiler {
         Ok(code_ptr)
     }
 
+    /// Compile an f64 dataflow graph
+    ///
+    /// The generated function has the signature
+    /// `extern "C" fn(inputs: *const f64, outputs: *mut f64, state: *mut f64)`.
+    /// Every SSA value of the graph becomes a Cranelift value, so fused chains
+    /// keep their intermediates in registers. State is loaded at entry and
+    /// written back after all outputs are computed.
+    pub fn compile_dataflow(
+        &mut self,
+        name: &str,
+        graph: &DataflowGraph,
+    ) -> Result<*const u8, String> {
+        graph.validate()?;
+
+        // Clear the context for a fresh function
+        self.ctx.clear();
+
+        let ptr_type = self.module.target_config().pointer_type();
+        for _ in 0..3 {
+            self.ctx.func.signature.params.push(AbiParam::new(ptr_type));
+        }
+
+        // Declare the function
+        let func_id = self
+            .module
+            .declare_function(name, Linkage::Local, &self.ctx.func.signature)
+            .map_err(|e| format!("Failed to declare function: {}", e))?;
+
+        {
+            let mut builder = FunctionBuilder::new(&mut self.ctx.func, &mut self.func_ctx);
+
+            let entry_block = builder.create_block();
+            builder.append_block_params_for_function_params(entry_block);
+            builder.switch_to_block(entry_block);
+
+            let params = builder.block_params(entry_block);
+            let (inputs, outputs, state) = (params[0], params[1], params[2]);
+            // Buffers are sized by the caller and never alias
+            let flags = MemFlags::trusted();
+            let offset = |i: u32| (i as usize * std::mem::size_of::<f64>()) as i32;
+
+            let mut values: Vec<cranelift::prelude::Value> = Vec::with_capacity(graph.ops().len());
+            for op in graph.ops() {
+                let v = |x: super::graph::Value| values[x.index()];
+                let ins = builder.ins();
+                let value = match *op {
+                    Op::Input(i) => ins.load(types::F64, flags, inputs, offset(i)),
+                    Op::Const(c) => ins.f64const(c),
+                    Op::State(s) => ins.load(types::F64, flags, state, offset(s)),
+                    Op::Add(a, b) => ins.fadd(v(a), v(b)),
+                    Op::Sub(a, b) => ins.fsub(v(a), v(b)),
+                    Op::Mul(a, b) => ins.fmul(v(a), v(b)),
+                    Op::Div(a, b) => ins.fdiv(v(a), v(b)),
+                    Op::Min(a, b) => ins.fmin(v(a), v(b)),
+                    Op::Max(a, b) => ins.fmax(v(a), v(b)),
+                    Op::Neg(a) => ins.fneg(v(a)),
+                    Op::Abs(a) => ins.fabs(v(a)),
+                    Op::Sqrt(a) => ins.sqrt(v(a)),
+                    Op::SelectLt {
+                        lhs,
+                        rhs,
+                        then,
+                        otherwise,
+                    } => {
+                        let cond = ins.fcmp(FloatCC::LessThan, v(lhs), v(rhs));
+                        builder.ins().select(cond, v(then), v(otherwise))
+                    }
+                };
+                values.push(value);
+            }
+
+            for (i, out) in graph.outputs().iter().enumerate() {
+                builder
+                    .ins()
+                    .store(flags, values[out.index()], outputs, offset(i as u32));
+            }
+            for &(slot, value) in graph.state_updates() {
+                builder
+                    .ins()
+                    .store(flags, values[value.index()], state, offset(slot));
+            }
+            builder.ins().return_(&[]);
+
+            builder.seal_all_blocks();
+            builder.finalize();
+        }
+
+        // Define the function
+        self.module
+            .define_function(func_id, &mut self.ctx)
+            .map_err(|e| format!("Failed to define function: {}", e))?;
+
+        // Clear the context to free resources
+        self.module.clear_context(&mut self.ctx);
+
+        // Compile the function
+        self.module
+            .finalize_definitions()
+            .map_err(|e| format!("Failed to finalize: {}", e))?;
+
+        let code_ptr = self.module.get_finalized_function(func_id);
+        self.compiled_funcs.insert(name.to_string(), func_id);
+
+        Ok(code_ptr)
+    }
+
     /// Execute a compiled arithmetic function
     ///
     /// # Safety
@@ -1,4 +1,5 @@
 use super::compiler::JITCompiler;
+use super::graph::DataflowGraph;
 use crate::core::Node;
 use std::time::Instant;
 
@@ -173,3 +174,158 @@ impl CompiledDataflow {
         self.avg_exec_ns() < 100.0
     }
 }
+
+/// Signature of a compiled `DataflowGraph`: (inputs, outputs, state)
+type DataflowFn = unsafe extern "C" fn(*const f64, *mut f64, *mut f64);
+
+/// A compiled f64 dataflow graph together with its state vector
+///
+/// Falls back to interpreting the graph when Cranelift compilation fails,
+/// so callers always get the same results.
+pub struct DataflowKernel {
+    /// Name of the compiled dataflow
+    pub name: String,
+    graph: DataflowGraph,
+    func: Option<DataflowFn>,
+    state: Vec<f64>,
+    scratch: Vec<f64>,
+    /// Owns the code memory `func` points into
+    _compiler: Option<JITCompiler>,
+    /// Number of executions
+    pub exec_count: u64,
+}
+
+// Safety: the compiler is only kept alive to own the finalized code, which
+// is never modified again; the state buffers are owned by the kernel
+unsafe impl Send for DataflowKernel {}
+
+impl DataflowKernel {
+    /// Compile `graph`, interpreting it instead if code generation fails
+    pub fn compile(name: &str, graph: DataflowGraph) -> Self {
+        let compiled = JITCompiler::new().and_then(|mut compiler| {
+            let ptr = compiler.compile_dataflow(name, &graph)?;
+            Ok((compiler, ptr))
+        });
+        let (compiler, func) = match compiled {
+            Ok((compiler, ptr)) => {
+                // Safety: compile_dataflow emits exactly the DataflowFn signature
+                let func = unsafe { std::mem::transmute::<*const u8, DataflowFn>(ptr) };
+                (Some(compiler), Some(func))
+            }
+            Err(e) => {
+                eprintln!("[JIT] Failed to compile dataflow '{}': {}", name, e);
+                (None, None)
+            }
+        };
+
+        Self {
+            name: name.to_string(),
+            state: graph.initial_state().to_vec(),
+            graph,
+            func,
+            scratch: Vec::new(),
+            _compiler: compiler,
+            exec_count: 0,
+        }
+    }
+
+    /// Run one tick: read `inputs`, write `outputs`, advance the state
+    ///
+    /// # Panics
+    /// If the slice lengths don't match the graph's input/output counts.
+    #[inline]
+    pub fn run(&mut self, inputs: &[f64], outputs: &mut [f64]) {
+        assert_eq!(
+            inputs.len(),
+            self.graph.num_inputs(),
+            "dataflow input count"
+        );
+        assert_eq!(
+            outputs.len(),
+            self.graph.num_outputs(),
+            "dataflow output count"
+        );
+        match self.func {
+            // Safety: buffer sizes checked above, state sized from the graph
+            Some(func) => unsafe {
+                func(
+                    inputs.as_ptr(),
+                    outputs.as_mut_ptr(),
+                    self.state.as_mut_ptr(),
+                )
+            },
+            None => self
+                .graph
+                .eval(inputs, outputs, &mut self.state, &mut self.scratch),
+        }
+        self.exec_count += 1;
+    }
+
+    /// Whether the kernel runs native code (false = interpreter fallback)
+    pub fn is_native(&self) -> bool {
+        self.func.is_some()
+    }
+
+    pub fn num_inputs(&self) -> usize {
+        self.graph.num_inputs()
+    }
+
+    pub fn num_outputs(&self) -> usize {
+        self.graph.num_outputs()
+    }
+
+    /// Current state vector (PID integrators etc.)
+    pub fn state(&self) -> &[f64] {
+        &self.state
+    }
+
+    /// Restore the graph's initial state
+    pub fn reset_state(&mut self) {
+        self.state.clear();
+        self.state.extend_from_slice(self.graph.initial_state());
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::super::graph::PidParams;
+    use super::*;
+
+    fn controller() -> DataflowGraph {
+        let mut g = DataflowGraph::new(2);
+        let (sp, fb) = (g.input(0), g.input(1));
+        let sp = g.scale(sp, 1.5, 0.0);
+        let mut params = PidParams::new(2.0, 0.5, 0.05, 0.01);
+        params.output_min = -1.0;
+        params.output_max = 1.0;
+        params.deadband = 0.01;
+        let w = g.pid(sp, fb, &params);
+        let v = g.constant(0.3);
+        let (left, right) = g.differential_drive(v, w, 0.4);
+        g.output(left);
+        g.output(right);
+        g
+    }
+
+    #[test]
+    fn test_kernel_matches_interpreter() {
+        let graph = controller();
+        let mut kernel = DataflowKernel::compile("test_controller", graph.clone());
+        assert!(kernel.is_native());
+
+        let mut state = graph.initial_state().to_vec();
+        let mut scratch = Vec::new();
+        let (mut native, mut interpreted) = ([0.0; 2], [0.0; 2]);
+        for step in 0..100 {
+            let inputs = [0.4, (step as f64 * 0.07).sin()];
+            kernel.run(&inputs, &mut native);
+            graph.eval(&inputs, &mut interpreted, &mut state, &mut scratch);
+            assert_eq!(native, interpreted, "step {}", step);
+        }
+        assert_eq!(kernel.state(), &state[..]);
+        assert_eq!(kernel.exec_count, 100);
+
+        kernel.reset_state();
+        assert!(kernel.state().iter().all(|&s| s == 0.0));
+    }
+}
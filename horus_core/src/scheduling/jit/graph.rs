@@ -0,0 +1,581 @@
+//! f64 dataflow IR for JIT compilation and node fusion
+//!
+//! A `DataflowGraph` is a straight-line SSA program over f64 values: it reads
+//! an input vector and per-node state, and writes an output vector and the
+//! next state. Nodes describe their tick with one (see `Node::get_jit_dataflow`)
+//! and the scheduler compiles it with Cranelift. Graphs of a linear
+//! publish/subscribe chain can be fused into one, so intermediates stay in
+//! registers instead of going through Hubs.
+//!
+//! f32 payloads are converted at the input/output edges; all arithmetic is f64.
+
+/// SSA value produced by one op of a `DataflowGraph`
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub struct Value(u32);
+
+impl Value {
+    #[inline]
+    pub(crate) fn index(self) -> usize {
+        self.0 as usize
+    }
+}
+
+/// One instruction of a dataflow graph
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum Op {
+    /// Element of the input vector
+    Input(u32),
+    /// Constant
+    Const(f64),
+    /// State slot as it was at the start of the tick
+    State(u32),
+    Add(Value, Value),
+    Sub(Value, Value),
+    Mul(Value, Value),
+    Div(Value, Value),
+    Min(Value, Value),
+    Max(Value, Value),
+    Neg(Value),
+    Abs(Value),
+    Sqrt(Value),
+    /// `if lhs < rhs { then } else { otherwise }`
+    SelectLt {
+        lhs: Value,
+        rhs: Value,
+        then: Value,
+        otherwise: Value,
+    },
+}
+
+impl Op {
+    fn map_values(self, f: impl Fn(Value) -> Value) -> Self {
+        match self {
+            Op::Input(_) | Op::Const(_) | Op::State(_) => self,
+            Op::Add(a, b) => Op::Add(f(a), f(b)),
+            Op::Sub(a, b) => Op::Sub(f(a), f(b)),
+            Op::Mul(a, b) => Op::Mul(f(a), f(b)),
+            Op::Div(a, b) => Op::Div(f(a), f(b)),
+            Op::Min(a, b) => Op::Min(f(a), f(b)),
+            Op::Max(a, b) => Op::Max(f(a), f(b)),
+            Op::Neg(a) => Op::Neg(f(a)),
+            Op::Abs(a) => Op::Abs(f(a)),
+            Op::Sqrt(a) => Op::Sqrt(f(a)),
+            Op::SelectLt {
+                lhs,
+                rhs,
+                then,
+                otherwise,
+            } => Op::SelectLt {
+                lhs: f(lhs),
+                rhs: f(rhs),
+                then: f(then),
+                otherwise: f(otherwise),
+            },
+        }
+    }
+}
+
+/// Gains and limits of the PID built-in
+///
+/// Same semantics as `horus_library::algorithms::pid::PID::compute`.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct PidParams {
+    pub kp: f64,
+    pub ki: f64,
+    pub kd: f64,
+    /// Fixed time step (seconds)
+    pub dt: f64,
+    pub output_min: f64,
+    pub output_max: f64,
+    pub integral_min: f64,
+    pub integral_max: f64,
+    pub deadband: f64,
+}
+
+impl PidParams {
+    /// Unlimited PID with the given gains and time step
+    pub fn new(kp: f64, ki: f64, kd: f64, dt: f64) -> Self {
+        Self {
+            kp,
+            ki,
+            kd,
+            dt,
+            output_min: f64::NEG_INFINITY,
+            output_max: f64::INFINITY,
+            integral_min: f64::NEG_INFINITY,
+            integral_max: f64::INFINITY,
+            deadband: 0.0,
+        }
+    }
+}
+
+/// Straight-line f64 program: inputs + state -> outputs + next state
+#[derive(Debug, Clone, PartialEq)]
+pub struct DataflowGraph {
+    ops: Vec<Op>,
+    num_inputs: u32,
+    outputs: Vec<Value>,
+    state_init: Vec<f64>,
+    /// State slots written at the end of the tick
+    state_updates: Vec<(u32, Value)>,
+}
+
+impl DataflowGraph {
+    /// Empty graph reading `num_inputs` values
+    pub fn new(num_inputs: usize) -> Self {
+        Self {
+            ops: Vec::new(),
+            num_inputs: num_inputs as u32,
+            outputs: Vec::new(),
+            state_init: Vec::new(),
+            state_updates: Vec::new(),
+        }
+    }
+
+    fn push(&mut self, op: Op) -> Value {
+        self.ops.push(op);
+        Value(self.ops.len() as u32 - 1)
+    }
+
+    // ---- Primitives ----
+
+    /// Input element `index`
+    pub fn input(&mut self, index: usize) -> Value {
+        assert!(
+            index < self.num_inputs as usize,
+            "dataflow input out of range"
+        );
+        self.push(Op::Input(index as u32))
+    }
+
+    pub fn constant(&mut self, value: f64) -> Value {
+        self.push(Op::Const(value))
+    }
+
+    pub fn add(&mut self, a: Value, b: Value) -> Value {
+        self.push(Op::Add(a, b))
+    }
+
+    pub fn sub(&mut self, a: Value, b: Value) -> Value {
+        self.push(Op::Sub(a, b))
+    }
+
+    pub fn mul(&mut self, a: Value, b: Value) -> Value {
+        self.push(Op::Mul(a, b))
+    }
+
+    pub fn div(&mut self, a: Value, b: Value) -> Value {
+        self.push(Op::Div(a, b))
+    }
+
+    pub fn min(&mut self, a: Value, b: Value) -> Value {
+        self.push(Op::Min(a, b))
+    }
+
+    pub fn max(&mut self, a: Value, b: Value) -> Value {
+        self.push(Op::Max(a, b))
+    }
+
+    pub fn neg(&mut self, a: Value) -> Value {
+        self.push(Op::Neg(a))
+    }
+
+    pub fn abs(&mut self, a: Value) -> Value {
+        self.push(Op::Abs(a))
+    }
+
+    pub fn sqrt(&mut self, a: Value) -> Value {
+        self.push(Op::Sqrt(a))
+    }
+
+    /// `if lhs < rhs { then } else { otherwise }`
+    pub fn select_lt(&mut self, lhs: Value, rhs: Value, then: Value, otherwise: Value) -> Value {
+        self.push(Op::SelectLt {
+            lhs,
+            rhs,
+            then,
+            otherwise,
+        })
+    }
+
+    /// New state slot starting at `init`; returns the slot and its value this tick
+    pub fn state(&mut self, init: f64) -> (u32, Value) {
+        let slot = self.state_init.len() as u32;
+        self.state_init.push(init);
+        (slot, self.push(Op::State(slot)))
+    }
+
+    /// Value of `slot` at the start of the next tick
+    pub fn set_state(&mut self, slot: u32, value: Value) {
+        match self.state_updates.iter_mut().find(|(s, _)| *s == slot) {
+            Some(update) => update.1 = value,
+            None => self.state_updates.push((slot, value)),
+        }
+    }
+
+    /// Append `value` to the output vector
+    pub fn output(&mut self, value: Value) {
+        self.outputs.push(value);
+    }
+
+    // ---- Built-ins ----
+
+    /// `x * scale + offset`
+    pub fn scale(&mut self, x: Value, scale: f64, offset: f64) -> Value {
+        let k = self.constant(scale);
+        let b = self.constant(offset);
+        let scaled = self.mul(x, k);
+        self.add(scaled, b)
+    }
+
+    /// Clamp `x` to `[lo, hi]`
+    pub fn clamp(&mut self, x: Value, lo: f64, hi: f64) -> Value {
+        if lo == f64::NEG_INFINITY && hi == f64::INFINITY {
+            return x;
+        }
+        let lo = self.constant(lo);
+        let hi = self.constant(hi);
+        let upper = self.min(x, hi);
+        self.max(upper, lo)
+    }
+
+    /// PID step on `setpoint - feedback`, with integral and last-error state
+    pub fn pid(&mut self, setpoint: Value, feedback: Value, params: &PidParams) -> Value {
+        let (integral_slot, integral) = self.state(0.0);
+        let (last_error_slot, last_error) = self.state(0.0);
+
+        let mut error = self.sub(setpoint, feedback);
+        if params.deadband > 0.0 {
+            let magnitude = self.abs(error);
+            let deadband = self.constant(params.deadband);
+            let zero = self.constant(0.0);
+            error = self.select_lt(magnitude, deadband, zero, error);
+        }
+
+        let kp = self.constant(params.kp);
+        let p_term = self.mul(kp, error);
+
+        let dt = self.constant(params.dt);
+        let step = self.mul(error, dt);
+        let integral = self.add(integral, step);
+        let integral = self.clamp(integral, params.integral_min, params.integral_max);
+        let ki = self.constant(params.ki);
+        let i_term = self.mul(ki, integral);
+
+        let delta = self.sub(error, last_error);
+        let derivative = self.div(delta, dt);
+        let kd = self.constant(params.kd);
+        let d_term = self.mul(kd, derivative);
+
+        self.set_state(integral_slot, integral);
+        self.set_state(last_error_slot, error);
+
+        let pi = self.add(p_term, i_term);
+        let output = self.add(pi, d_term);
+        self.clamp(output, params.output_min, params.output_max)
+    }
+
+    /// Differential-drive inverse kinematics: (linear, angular) -> (left, right)
+    pub fn differential_drive(
+        &mut self,
+        linear: Value,
+        angular: Value,
+        wheel_base: f64,
+    ) -> (Value, Value) {
+        let half_base = self.constant(wheel_base / 2.0);
+        let turn = self.mul(angular, half_base);
+        (self.sub(linear, turn), self.add(linear, turn))
+    }
+
+    // ---- Introspection ----
+
+    pub fn num_inputs(&self) -> usize {
+        self.num_inputs as usize
+    }
+
+    pub fn num_outputs(&self) -> usize {
+        self.outputs.len()
+    }
+
+    pub fn num_state(&self) -> usize {
+        self.state_init.len()
+    }
+
+    /// Initial state vector
+    pub fn initial_state(&self) -> &[f64] {
+        &self.state_init
+    }
+
+    pub(crate) fn ops(&self) -> &[Op] {
+        &self.ops
+    }
+
+    pub(crate) fn outputs(&self) -> &[Value] {
+        &self.outputs
+    }
+
+    pub(crate) fn state_updates(&self) -> &[(u32, Value)] {
+        &self.state_updates
+    }
+
+    /// Check that every value is defined before use and in range
+    pub fn validate(&self) -> Result<(), String> {
+        for (i, op) in self.ops.iter().enumerate() {
+            let bad = std::cell::Cell::new(false);
+            op.map_values(|v| {
+                if v.index() >= i {
+                    bad.set(true);
+                }
+                v
+            });
+            let out_of_range = match *op {
+                Op::Input(n) => n >= self.num_inputs,
+                Op::State(s) => s as usize >= self.state_init.len(),
+                _ => false,
+            };
+            if bad.get() || out_of_range {
+                return Err(format!("Invalid dataflow op {} ({:?})", i, op));
+            }
+        }
+        let defined = |v: &Value| v.index() < self.ops.len();
+        if !self.outputs.iter().all(defined)
+            || !self
+                .state_updates
+                .iter()
+                .all(|(s, v)| defined(v) && (*s as usize) < self.state_init.len())
+        {
+            return Err("Dataflow output or state update references an undefined value".into());
+        }
+        Ok(())
+    }
+
+    /// Fuse a linear chain: each stage's outputs become the next stage's inputs
+    ///
+    /// State slots of every stage are kept, in stage order.
+    pub fn fuse(stages: &[&DataflowGraph]) -> Result<DataflowGraph, String> {
+        let first = stages.first().ok_or("Cannot fuse an empty chain")?;
+        let mut fused = DataflowGraph::new(first.num_inputs());
+        let mut carried: Vec<Value> = (0..first.num_inputs()).map(|i| fused.input(i)).collect();
+
+        for (n, stage) in stages.iter().enumerate() {
+            if stage.num_inputs() != carried.len() {
+                return Err(format!(
+                    "Dataflow stage {} expects {} inputs, previous stage produces {}",
+                    n,
+                    stage.num_inputs(),
+                    carried.len()
+                ));
+            }
+            let state_base = fused.state_init.len() as u32;
+            fused.state_init.extend_from_slice(&stage.state_init);
+
+            // Stage value -> fused value; inputs resolve to the previous
+            // stage's outputs directly, so intermediates are never copied
+            let mut map: Vec<Value> = Vec::with_capacity(stage.ops.len());
+            for op in &stage.ops {
+                let value = match *op {
+                    Op::Input(i) => carried[i as usize],
+                    Op::State(s) => fused.push(Op::State(s + state_base)),
+                    other => fused.push(other.map_values(|v| map[v.index()])),
+                };
+                map.push(value);
+            }
+            for &(slot, value) in &stage.state_updates {
+                fused
+                    .state_updates
+                    .push((slot + state_base, map[value.index()]));
+            }
+            carried = stage.outputs.iter().map(|v| map[v.index()]).collect();
+        }
+        fused.outputs = carried;
+        Ok(fused)
+    }
+
+    /// Interpret the graph (reference semantics for the compiled kernel)
+    ///
+    /// `scratch` is resized to the op count and reused across calls.
+    pub fn eval(
+        &self,
+        inputs: &[f64],
+        outputs: &mut [f64],
+        state: &mut [f64],
+        scratch: &mut Vec<f64>,
+    ) {
+        scratch.clear();
+        scratch.reserve(self.ops.len());
+        for op in &self.ops {
+            let v = |x: Value| scratch[x.index()];
+            let result = match *op {
+                Op::Input(i) => inputs[i as usize],
+                Op::Const(c) => c,
+                Op::State(s) => state[s as usize],
+                Op::Add(a, b) => v(a) + v(b),
+                Op::Sub(a, b) => v(a) - v(b),
+                Op::Mul(a, b) => v(a) * v(b),
+                Op::Div(a, b) => v(a) / v(b),
+                Op::Min(a, b) => fmin(v(a), v(b)),
+                Op::Max(a, b) => fmax(v(a), v(b)),
+                Op::Neg(a) => -v(a),
+                Op::Abs(a) => v(a).abs(),
+                Op::Sqrt(a) => v(a).sqrt(),
+                Op::SelectLt {
+                    lhs,
+                    rhs,
+                    then,
+                    otherwise,
+                } => {
+                    if v(lhs) < v(rhs) {
+                        v(then)
+                    } else {
+                        v(otherwise)
+                    }
+                }
+            };
+            scratch.push(result);
+        }
+        for (out, v) in outputs.iter_mut().zip(&self.outputs) {
+            *out = scratch[v.index()];
+        }
+        for &(slot, v) in &self.state_updates {
+            state[slot as usize] = scratch[v.index()];
+        }
+    }
+}
+
+/// NaN-propagating min, matching Cranelift's `fmin`
+#[inline]
+fn fmin(a: f64, b: f64) -> f64 {
+    if a.is_nan() || b.is_nan() {
+        f64::NAN
+    } else {
+        a.min(b)
+    }
+}
+
+/// NaN-propagating max, matching Cranelift's `fmax`
+#[inline]
+fn fmax(a: f64, b: f64) -> f64 {
+    if a.is_nan() || b.is_nan() {
+        f64::NAN
+    } else {
+        a.max(b)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn run(graph: &DataflowGraph, inputs: &[f64], state: &mut [f64]) -> Vec<f64> {
+        let mut outputs = vec![0.0; graph.num_outputs()];
+        graph.eval(inputs, &mut outputs, state, &mut Vec::new());
+        outputs
+    }
+
+    fn pid_graph(params: &PidParams) -> DataflowGraph {
+        let mut g = DataflowGraph::new(2);
+        let (sp, fb) = (g.input(0), g.input(1));
+        let out = g.pid(sp, fb, params);
+        g.output(out);
+        g
+    }
+
+    #[test]
+    fn test_pid_matches_reference() {
+        let mut params = PidParams::new(2.0, 0.5, 0.1, 0.01);
+        params.output_min = -50.0;
+        params.output_max = 50.0;
+        params.integral_max = 0.05;
+        let g = pid_graph(&params);
+        g.validate().unwrap();
+        let mut state = g.initial_state().to_vec();
+
+        // Reference: horus_library PID::compute
+        let (mut integral, mut last_error) = (0.0f64, 0.0f64);
+        for step in 0..50 {
+            let feedback = step as f64 * 1.7;
+            let error = 100.0 - feedback;
+            integral = (integral + error * params.dt).clamp(f64::NEG_INFINITY, 0.05);
+            let expected = (params.kp * error
+                + params.ki * integral
+                + params.kd * (error - last_error) / params.dt)
+                .clamp(-50.0, 50.0);
+            last_error = error;
+
+            let out = run(&g, &[100.0, feedback], &mut state);
+            assert!((out[0] - expected).abs() < 1e-9, "step {}", step);
+        }
+    }
+
+    #[test]
+    fn test_pid_deadband() {
+        let mut params = PidParams::new(1.0, 0.0, 0.0, 0.1);
+        params.deadband = 0.5;
+        let g = pid_graph(&params);
+        let mut state = g.initial_state().to_vec();
+        assert_eq!(run(&g, &[1.0, 0.8], &mut state), vec![0.0]);
+        assert_eq!(run(&g, &[1.0, 0.0], &mut state), vec![1.0]);
+    }
+
+    #[test]
+    fn test_differential_drive() {
+        let mut g = DataflowGraph::new(2);
+        let (v, w) = (g.input(0), g.input(1));
+        let (left, right) = g.differential_drive(v, w, 0.5);
+        g.output(left);
+        g.output(right);
+        assert_eq!(run(&g, &[1.0, 1.0], &mut []), vec![0.75, 1.25]);
+    }
+
+    #[test]
+    fn test_fuse_chain() {
+        // scale -> clamp -> pid -> differential drive
+        let mut scale = DataflowGraph::new(2);
+        let (sp, fb) = (scale.input(0), scale.input(1));
+        let sp = scale.scale(sp, 2.0, 0.0);
+        scale.output(sp);
+        scale.output(fb);
+
+        let pid = pid_graph(&PidParams::new(1.0, 1.0, 0.0, 0.1));
+
+        let mut drive = DataflowGraph::new(1);
+        let w = drive.input(0);
+        let w = drive.clamp(w, -1.0, 1.0);
+        let v = drive.constant(0.2);
+        let (l, r) = drive.differential_drive(v, w, 0.4);
+        drive.output(l);
+        drive.output(r);
+
+        let fused = DataflowGraph::fuse(&[&scale, &pid, &drive]).unwrap();
+        fused.validate().unwrap();
+        assert_eq!(fused.num_inputs(), 2);
+        assert_eq!(fused.num_outputs(), 2);
+        assert_eq!(fused.num_state(), 2);
+
+        // Same result as running the stages one after another
+        let (mut fused_state, mut pid_state) = (fused.initial_state().to_vec(), vec![0.0; 2]);
+        for step in 0..5 {
+            let inputs = [0.3, step as f64 * 0.1];
+            let a = run(&scale, &inputs, &mut []);
+            let b = run(&pid, &a, &mut pid_state);
+            let c = run(&drive, &b, &mut []);
+            assert_eq!(run(&fused, &inputs, &mut fused_state), c);
+        }
+    }
+
+    #[test]
+    fn test_fuse_arity_mismatch() {
+        let mut a = DataflowGraph::new(1);
+        let x = a.input(0);
+        a.output(x);
+        let b = DataflowGraph::new(2);
+        assert!(DataflowGraph::fuse(&[&a, &b]).is_err());
+    }
+
+    #[test]
+    fn test_validate_rejects_forward_reference() {
+        let mut g = DataflowGraph::new(0);
+        g.ops.push(Op::Neg(Value(3)));
+        assert!(g.validate().is_err());
+    }
+}
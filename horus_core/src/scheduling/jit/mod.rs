@@ -3,7 +3,9 @@
 mod compiler;
 mod dataflow;
 mod example_nodes;
+mod graph;
 
 pub use compiler::JITCompiler;
-pub use dataflow::CompiledDataflow;
+pub use dataflow::{CompiledDataflow, DataflowKernel};
 pub use example_nodes::ScalingNode;
+pub use graph::{DataflowGraph, Op, PidParams, Value};
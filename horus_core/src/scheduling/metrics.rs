@@ -0,0 +1,404 @@
+//! Lock-free latency histograms and OpenMetrics exposition
+//!
+//! Per-node tick latency, per-node hardware counters and per-Hub IPC latency
+//! are recorded into atomics by whichever thread does the work and read by
+//! the exporter without locking the hot path. Everything registered here is
+//! rendered by `render_openmetrics`, which the telemetry Prometheus/OpenMetrics
+//! endpoint serves.
+//!
+//! Recording is opt-in: node metrics via `MonitoringConfig::latency_histograms`
+//! / `hardware_counters`, Hub IPC latency via `enable_ipc_latency()` (or
+//! `HORUS_IPC_LATENCY=1`) before the Hubs are created.
+
+use super::alloc::AllocSample;
+use super::perf::CounterSample;
+use super::timing::{bucket_high, bucket_of, JitterHistogram, JitterStats, BUCKETS};
+use parking_lot::RwLock;
+use std::fmt::Write;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::sync::{Arc, OnceLock};
+use std::time::Duration;
+
+/// Lock-free log-linear latency histogram
+///
+/// Same buckets as `JitterHistogram` (about 6% resolution); `record` is a
+/// handful of relaxed atomic adds and never allocates.
+pub struct LatencyHistogram {
+    buckets: Box<[AtomicU64; BUCKETS]>,
+    sum_ns: AtomicU64,
+    min_ns: AtomicU64,
+    max_ns: AtomicU64,
+}
+
+impl Default for LatencyHistogram {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl std::fmt::Debug for LatencyHistogram {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("LatencyHistogram")
+            .field("stats", &self.stats())
+            .finish()
+    }
+}
+
+impl LatencyHistogram {
+    pub fn new() -> Self {
+        Self {
+            buckets: Box::new(std::array::from_fn(|_| AtomicU64::new(0))),
+            sum_ns: AtomicU64::new(0),
+            min_ns: AtomicU64::new(u64::MAX),
+            max_ns: AtomicU64::new(0),
+        }
+    }
+
+    /// Record one latency
+    #[inline]
+    pub fn record(&self, latency: Duration) {
+        self.record_ns(latency.as_nanos().min(u64::MAX as u128) as u64);
+    }
+
+    /// Record one latency in nanoseconds
+    #[inline]
+    pub fn record_ns(&self, ns: u64) {
+        self.buckets[bucket_of(ns)].fetch_add(1, Ordering::Relaxed);
+        self.sum_ns.fetch_add(ns, Ordering::Relaxed);
+        self.min_ns.fetch_min(ns, Ordering::Relaxed);
+        self.max_ns.fetch_max(ns, Ordering::Relaxed);
+    }
+
+    /// Point-in-time copy for percentile queries
+    ///
+    /// Concurrent records may be half-visible (a bucket counted, the sum not
+    /// yet); fine for monitoring.
+    pub fn snapshot(&self) -> JitterHistogram {
+        let mut buckets = Box::new([0u64; BUCKETS]);
+        for (dst, src) in buckets.iter_mut().zip(self.buckets.iter()) {
+            *dst = src.load(Ordering::Relaxed);
+        }
+        JitterHistogram::from_parts(
+            buckets,
+            self.sum_ns.load(Ordering::Relaxed) as u128,
+            self.min_ns.load(Ordering::Relaxed),
+            self.max_ns.load(Ordering::Relaxed),
+        )
+    }
+
+    /// count / min / mean / p50 / p99 / p99.9 / max
+    pub fn stats(&self) -> JitterStats {
+        self.snapshot().stats()
+    }
+
+    /// Count and sum without a full snapshot
+    fn count_and_sum(&self) -> (u64, u64) {
+        let count = self.buckets.iter().map(|b| b.load(Ordering::Relaxed)).sum();
+        (count, self.sum_ns.load(Ordering::Relaxed))
+    }
+
+    /// Quantiles for exposition, walking the buckets once (no allocation)
+    fn quantiles(&self, qs: &[f64; 3], count: u64) -> [u64; 3] {
+        let mut out = [0u64; 3];
+        if count == 0 {
+            return out;
+        }
+        let max = self.max_ns.load(Ordering::Relaxed);
+        let ranks = qs.map(|q| ((q * count as f64).ceil() as u64).max(1));
+        let (mut seen, mut next) = (0u64, 0usize);
+        for (bucket, n) in self.buckets.iter().enumerate() {
+            seen += n.load(Ordering::Relaxed);
+            while next < ranks.len() && seen >= ranks[next] {
+                out[next] = bucket_high(bucket).min(max);
+                next += 1;
+            }
+            if next == ranks.len() {
+                return out;
+            }
+        }
+        // Records raced with the walk: report the max for the rest
+        out[next..].fill(max);
+        out
+    }
+}
+
+/// Metrics of one scheduled node
+#[derive(Debug, Default)]
+pub struct NodeMetrics {
+    /// Tick duration
+    pub tick: LatencyHistogram,
+    pub cycles: AtomicU64,
+    pub instructions: AtomicU64,
+    pub llc_misses: AtomicU64,
+    pub context_switches: AtomicU64,
+    /// Heap allocations inside ticks (with allocation tracking)
+    pub allocations: AtomicU64,
+    pub allocated_bytes: AtomicU64,
+}
+
+impl NodeMetrics {
+    /// Add the counter deltas of one tick
+    #[inline]
+    pub fn add_counters(&self, delta: &CounterSample) {
+        self.cycles.fetch_add(delta.cycles, Ordering::Relaxed);
+        self.instructions
+            .fetch_add(delta.instructions, Ordering::Relaxed);
+        self.llc_misses
+            .fetch_add(delta.llc_misses, Ordering::Relaxed);
+        self.context_switches
+            .fetch_add(delta.context_switches, Ordering::Relaxed);
+    }
+
+    /// Add the allocator counts of one tick
+    #[inline]
+    pub fn add_allocs(&self, delta: &AllocSample) {
+        self.allocations
+            .fetch_add(delta.allocations, Ordering::Relaxed);
+        self.allocated_bytes
+            .fetch_add(delta.bytes, Ordering::Relaxed);
+    }
+
+    /// Instructions per cycle so far (0 without hardware counters)
+    pub fn ipc(&self) -> f64 {
+        let cycles = self.cycles.load(Ordering::Relaxed);
+        if cycles == 0 {
+            0.0
+        } else {
+            self.instructions.load(Ordering::Relaxed) as f64 / cycles as f64
+        }
+    }
+}
+
+/// IPC latency of one Hub endpoint (time inside the shared-memory send/recv)
+#[derive(Debug, Default)]
+pub struct HubLatency {
+    pub send: LatencyHistogram,
+    pub recv: LatencyHistogram,
+}
+
+/// Process-wide registry of exported metrics
+#[derive(Default)]
+struct Registry {
+    nodes: RwLock<Vec<(String, Arc<NodeMetrics>)>>,
+    hubs: RwLock<Vec<(String, Arc<HubLatency>)>>,
+    ipc_latency: AtomicBool,
+}
+
+fn registry() -> &'static Registry {
+    static REGISTRY: OnceLock<Registry> = OnceLock::new();
+    REGISTRY.get_or_init(|| {
+        let registry = Registry::default();
+        if std::env::var("HORUS_IPC_LATENCY").is_ok_and(|v| v == "1") {
+            registry.ipc_latency.store(true, Ordering::Relaxed);
+        }
+        registry
+    })
+}
+
+/// Metrics for node `name`, shared with every scheduler in the process
+pub fn node_metrics(name: &str) -> Arc<NodeMetrics> {
+    let reg = registry();
+    if let Some((_, m)) = reg.nodes.read().iter().find(|(n, _)| n == name) {
+        return Arc::clone(m);
+    }
+    let mut nodes = reg.nodes.write();
+    if let Some((_, m)) = nodes.iter().find(|(n, _)| n == name) {
+        return Arc::clone(m);
+    }
+    let metrics = Arc::new(NodeMetrics::default());
+    nodes.push((name.to_string(), Arc::clone(&metrics)));
+    metrics
+}
+
+/// Record IPC latency for Hubs created from now on
+pub fn enable_ipc_latency() {
+    registry().ipc_latency.store(true, Ordering::Relaxed);
+}
+
+/// IPC latency histograms for a new Hub on `topic`, if enabled
+///
+/// Every Hub endpoint of the topic in this process shares the histograms.
+pub fn hub_latency(topic: &str) -> Option<Arc<HubLatency>> {
+    let reg = registry();
+    if !reg.ipc_latency.load(Ordering::Relaxed) {
+        return None;
+    }
+    let mut hubs = reg.hubs.write();
+    if let Some((_, h)) = hubs.iter().find(|(t, _)| t == topic) {
+        return Some(Arc::clone(h));
+    }
+    let latency = Arc::new(HubLatency::default());
+    hubs.push((topic.to_string(), Arc::clone(&latency)));
+    Some(latency)
+}
+
+const QUANTILES: [f64; 3] = [0.5, 0.99, 0.999];
+const QUANTILE_LABELS: [&str; 3] = ["0.5", "0.99", "0.999"];
+
+/// Append one summary sample block (quantiles, sum, count) in seconds
+fn write_summary(out: &mut String, name: &str, labels: &str, h: &LatencyHistogram) {
+    let (count, sum_ns) = h.count_and_sum();
+    let qs = h.quantiles(&QUANTILES, count);
+    for (q, label) in qs.iter().zip(QUANTILE_LABELS) {
+        let _ = writeln!(
+            out,
+            "{}{{{},quantile=\"{}\"}} {:e}",
+            name,
+            labels,
+            label,
+            *q as f64 / 1e9
+        );
+    }
+    let _ = writeln!(out, "{}_sum{{{}}} {:e}", name, labels, sum_ns as f64 / 1e9);
+    let _ = writeln!(out, "{}_count{{{}}} {}", name, labels, count);
+}
+
+/// Append an OpenMetrics label value, escaped
+fn write_label(out: &mut String, key: &str, value: &str) {
+    let _ = write!(out, "{}=\"", key);
+    for c in value.chars() {
+        match c {
+            '\\' => out.push_str("\\\\"),
+            '"' => out.push_str("\\\""),
+            '\n' => out.push_str("\\n"),
+            c => out.push(c),
+        }
+    }
+    out.push('"');
+}
+
+/// Render all registered metrics as OpenMetrics text (without `# EOF`)
+///
+/// Appends to `out`, so callers can reuse one buffer across scrapes; after
+/// the first render (buffer and label scratch grown) no allocation happens.
+pub fn render_openmetrics(out: &mut String) {
+    let reg = registry();
+    let mut labels = String::new();
+
+    let nodes = reg.nodes.read();
+    if !nodes.is_empty() {
+        out.push_str("# TYPE horus_node_tick_seconds summary\n");
+        out.push_str("# HELP horus_node_tick_seconds Node tick duration.\n");
+        for (name, m) in nodes.iter() {
+            labels.clear();
+            write_label(&mut labels, "node", name);
+            write_summary(out, "horus_node_tick_seconds", &labels, &m.tick);
+        }
+        out.push_str("# TYPE horus_node_tick_max_seconds gauge\n");
+        for (name, m) in nodes.iter() {
+            labels.clear();
+            write_label(&mut labels, "node", name);
+            let max = m.tick.max_ns.load(Ordering::Relaxed);
+            let _ = writeln!(
+                out,
+                "horus_node_tick_max_seconds{{{}}} {:e}",
+                labels,
+                max as f64 / 1e9
+            );
+        }
+        let counters: [(&str, fn(&NodeMetrics) -> &AtomicU64); 6] = [
+            ("horus_node_cycles", |m| &m.cycles),
+            ("horus_node_instructions", |m| &m.instructions),
+            ("horus_node_llc_misses", |m| &m.llc_misses),
+            ("horus_node_context_switches", |m| &m.context_switches),
+            ("horus_node_allocations", |m| &m.allocations),
+            ("horus_node_allocated_bytes", |m| &m.allocated_bytes),
+        ];
+        for (metric, field) in counters {
+            let _ = writeln!(out, "# TYPE {} counter", metric);
+            for (name, m) in nodes.iter() {
+                labels.clear();
+                write_label(&mut labels, "node", name);
+                let _ = writeln!(
+                    out,
+                    "{}_total{{{}}} {}",
+                    metric,
+                    labels,
+                    field(m).load(Ordering::Relaxed)
+                );
+            }
+        }
+    }
+    drop(nodes);
+
+    let hubs = reg.hubs.read();
+    if !hubs.is_empty() {
+        out.push_str("# TYPE horus_hub_ipc_seconds summary\n");
+        out.push_str("# HELP horus_hub_ipc_seconds Time spent in Hub shared-memory send/recv.\n");
+        for (topic, h) in hubs.iter() {
+            for (op, hist) in [("send", &h.send), ("recv", &h.recv)] {
+                labels.clear();
+                write_label(&mut labels, "topic", topic);
+                labels.push(',');
+                write_label(&mut labels, "op", op);
+                write_summary(out, "horus_hub_ipc_seconds", &labels, hist);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_concurrent_records() {
+        let h = Arc::new(LatencyHistogram::new());
+        let threads: Vec<_> = (0..4)
+            .map(|t| {
+                let h = Arc::clone(&h);
+                std::thread::spawn(move || {
+                    for i in 0..10_000u64 {
+                        h.record_ns(1_000 + (i % 100) * 10 + t);
+                    }
+                })
+            })
+            .collect();
+        for t in threads {
+            t.join().unwrap();
+        }
+
+        let stats = h.stats();
+        assert_eq!(stats.count, 40_000);
+        assert_eq!(stats.min, Duration::from_nanos(1_000));
+        assert_eq!(stats.max, Duration::from_nanos(1_993));
+        // p50 ~ 1.5us within bucket resolution
+        let p50 = stats.p50.as_nanos() as f64;
+        assert!((p50 - 1_500.0).abs() / 1_500.0 < 0.07, "p50 = {}", p50);
+    }
+
+    #[test]
+    fn test_quantiles_match_snapshot() {
+        let h = LatencyHistogram::new();
+        for ns in 1..=10_000u64 {
+            h.record_ns(ns * 100);
+        }
+        let (count, _) = h.count_and_sum();
+        let q = h.quantiles(&QUANTILES, count);
+        let stats = h.stats();
+        assert_eq!(q[0], stats.p50.as_nanos() as u64);
+        assert_eq!(q[1], stats.p99.as_nanos() as u64);
+        assert_eq!(q[2], stats.p999.as_nanos() as u64);
+    }
+
+    #[test]
+    fn test_render_openmetrics() {
+        let m = node_metrics("render \"test\" node");
+        m.tick.record(Duration::from_micros(3));
+        m.add_counters(&CounterSample {
+            cycles: 1000,
+            instructions: 2500,
+            llc_misses: 7,
+            context_switches: 1,
+        });
+        assert!(Arc::ptr_eq(&m, &node_metrics("render \"test\" node")));
+        assert!((m.ipc() - 2.5).abs() < 1e-12);
+
+        let mut out = String::new();
+        render_openmetrics(&mut out);
+        assert!(out.contains("# TYPE horus_node_tick_seconds summary"));
+        assert!(out.contains("horus_node_tick_seconds_count{node=\"render \\\"test\\\" node\"} 1"));
+        assert!(out.contains("horus_node_llc_misses_total{node=\"render \\\"test\\\" node\"} 7"));
+        assert!(out.lines().all(|l| l.starts_with('#') || l.contains(' ')));
+    }
+}
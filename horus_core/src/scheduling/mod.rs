@@ -28,14 +28,22 @@ pub mod config;
 pub mod safety_monitor;
 pub mod scheduler;
 
+pub mod alloc;
+
 // Internal intelligence modules
+mod event_trigger;
 mod executors;
 mod fault_tolerance;
+mod fusion;
 mod intelligence;
 pub mod jit;
+pub mod metrics;
+pub mod perf;
+mod plan;
 
 // Runtime OS-level features
 pub mod runtime;
+pub mod timing;
 
 // Fault tolerance and monitoring
 pub mod blackbox;
@@ -45,15 +53,23 @@ pub mod telemetry;
 
 // Record/Replay system
 pub mod record_replay;
+pub mod recording_file;
 
 // Expose async_io module for AsyncNode
 pub mod async_io {
     pub use super::executors::async_io::AsyncNode;
 }
 
+pub use alloc::{AllocSample, CountingAllocator, RtAllocPolicy};
 pub use config::{ConfigValue, ExecutionMode, RobotPreset, SchedulerConfig};
+pub use metrics::{HubLatency, LatencyHistogram, NodeMetrics};
+pub use perf::CounterSample;
 pub use safety_monitor::{SafetyMonitor, SafetyState, SafetyStats, WCETEnforcer, Watchdog};
 pub use scheduler::Scheduler;
+pub use timing::{JitterHistogram, JitterStats, TickPacer};
+
+// Re-export parallel execution metrics
+pub use executors::LevelMetrics;
 
 // Re-export runtime features
 pub use runtime::{
@@ -63,7 +79,7 @@ pub use runtime::{
 
 // Re-export fault tolerance
 pub use blackbox::{BlackBox, BlackBoxEvent};
-pub use checkpoint::{Checkpoint, CheckpointManager};
+pub use checkpoint::{Checkpoint, CheckpointManager, CheckpointState};
 pub use redundancy::{RedundancyManager, VoteResult, VotingStrategy};
 pub use telemetry::{TelemetryEndpoint, TelemetryManager};
 
@@ -72,3 +88,4 @@ pub use record_replay::{
     NodeRecorder, NodeRecording, NodeReplayer, NodeTickSnapshot, RecordingConfig, RecordingManager,
     SchedulerRecording,
 };
+pub use recording_file::{ChunkOptions, RecordingReader, RecordingWriter};
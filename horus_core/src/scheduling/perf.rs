@@ -0,0 +1,218 @@
+//! Per-thread hardware performance counters
+//!
+//! Reads CPU cycles, retired instructions and last-level cache misses of the
+//! calling thread through one `perf_event_open` counter group, plus context
+//! switches from `getrusage(RUSAGE_THREAD)`. The scheduler reads them before
+//! and after a node's tick and attributes the delta to the node, so it works
+//! on whichever thread (main or parallel worker) ticked it.
+//!
+//! Hardware events are opened user-space only, which is allowed at the
+//! default `perf_event_paranoid` level of 2. Where they are unavailable
+//! (containers, VMs, non-Linux) the hardware fields read as zero.
+
+/// Counter values of the calling thread
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct CounterSample {
+    pub cycles: u64,
+    pub instructions: u64,
+    pub llc_misses: u64,
+    pub context_switches: u64,
+}
+
+impl CounterSample {
+    /// Counts accumulated since `earlier`
+    pub fn since(&self, earlier: &CounterSample) -> CounterSample {
+        CounterSample {
+            cycles: self.cycles.wrapping_sub(earlier.cycles),
+            instructions: self.instructions.wrapping_sub(earlier.instructions),
+            llc_misses: self.llc_misses.wrapping_sub(earlier.llc_misses),
+            context_switches: self.context_switches.wrapping_sub(earlier.context_switches),
+        }
+    }
+}
+
+#[cfg(target_os = "linux")]
+mod imp {
+    use super::CounterSample;
+    use std::cell::RefCell;
+
+    const PERF_TYPE_HARDWARE: u32 = 0;
+    const PERF_COUNT_HW_CPU_CYCLES: u64 = 0;
+    const PERF_COUNT_HW_INSTRUCTIONS: u64 = 1;
+    const PERF_COUNT_HW_CACHE_MISSES: u64 = 3;
+    const PERF_FORMAT_GROUP: u64 = 1 << 3;
+    const EXCLUDE_KERNEL: u64 = 1 << 5;
+    const EXCLUDE_HV: u64 = 1 << 6;
+
+    /// `struct perf_event_attr`, PERF_ATTR_SIZE_VER0 layout
+    #[repr(C)]
+    #[derive(Default)]
+    struct PerfEventAttr {
+        type_: u32,
+        size: u32,
+        config: u64,
+        sample_period: u64,
+        sample_type: u64,
+        read_format: u64,
+        flags: u64,
+        wakeup_events: u32,
+        bp_type: u32,
+        config1: u64,
+    }
+
+    /// Cycles (leader), instructions and cache misses of one thread
+    struct PerfGroup {
+        fds: [libc::c_int; 3],
+    }
+
+    impl PerfGroup {
+        fn open() -> Option<Self> {
+            let mut fds = [-1; 3];
+            let events = [
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_MISSES,
+            ];
+            for (i, &config) in events.iter().enumerate() {
+                let attr = PerfEventAttr {
+                    type_: PERF_TYPE_HARDWARE,
+                    size: std::mem::size_of::<PerfEventAttr>() as u32,
+                    config,
+                    read_format: PERF_FORMAT_GROUP,
+                    flags: EXCLUDE_KERNEL | EXCLUDE_HV,
+                    ..Default::default()
+                };
+                let group_fd = if i == 0 { -1 } else { fds[0] };
+                // pid 0 / cpu -1: this thread, on any CPU
+                let fd = unsafe {
+                    libc::syscall(
+                        libc::SYS_perf_event_open,
+                        &attr as *const PerfEventAttr,
+                        0 as libc::pid_t,
+                        -1 as libc::c_int,
+                        group_fd,
+                        0 as libc::c_ulong,
+                    )
+                } as libc::c_int;
+                if fd < 0 {
+                    Self::close(&fds);
+                    return None;
+                }
+                fds[i] = fd;
+            }
+            Some(Self { fds })
+        }
+
+        fn close(fds: &[libc::c_int]) {
+            for &fd in fds.iter().filter(|&&fd| fd >= 0) {
+                unsafe { libc::close(fd) };
+            }
+        }
+
+        /// One read() of the whole group: [nr, cycles, instructions, misses]
+        fn read(&self, sample: &mut CounterSample) -> bool {
+            let mut buf = [0u64; 4];
+            let n = unsafe {
+                libc::read(
+                    self.fds[0],
+                    buf.as_mut_ptr() as *mut libc::c_void,
+                    std::mem::size_of_val(&buf),
+                )
+            };
+            if n != std::mem::size_of_val(&buf) as isize || buf[0] != 3 {
+                return false;
+            }
+            sample.cycles = buf[1];
+            sample.instructions = buf[2];
+            sample.llc_misses = buf[3];
+            true
+        }
+    }
+
+    impl Drop for PerfGroup {
+        fn drop(&mut self) {
+            Self::close(&self.fds);
+        }
+    }
+
+    thread_local! {
+        /// None = not tried yet on this thread, Some(None) = unavailable
+        static GROUP: RefCell<Option<Option<PerfGroup>>> = const { RefCell::new(None) };
+    }
+
+    pub fn read_thread_counters() -> CounterSample {
+        let mut sample = CounterSample::default();
+        GROUP.with(|group| {
+            let mut group = group.borrow_mut();
+            if let Some(perf) = group.get_or_insert_with(PerfGroup::open) {
+                if !perf.read(&mut sample) {
+                    *group = Some(None);
+                }
+            }
+        });
+
+        let mut usage: libc::rusage = unsafe { std::mem::zeroed() };
+        if unsafe { libc::getrusage(libc::RUSAGE_THREAD, &mut usage) } == 0 {
+            sample.context_switches = (usage.ru_nvcsw + usage.ru_nivcsw) as u64;
+        }
+        sample
+    }
+
+    pub fn hardware_counters_available() -> bool {
+        GROUP.with(|group| {
+            group
+                .borrow_mut()
+                .get_or_insert_with(PerfGroup::open)
+                .is_some()
+        })
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+mod imp {
+    use super::CounterSample;
+
+    pub fn read_thread_counters() -> CounterSample {
+        CounterSample::default()
+    }
+
+    pub fn hardware_counters_available() -> bool {
+        false
+    }
+}
+
+/// Current counter values of the calling thread
+///
+/// The first call on a thread opens its counter group (one syscall per
+/// event); afterwards a read is one `read()` and one `getrusage()`.
+pub fn read_thread_counters() -> CounterSample {
+    imp::read_thread_counters()
+}
+
+/// Whether cycles / instructions / cache misses can be counted on this thread
+pub fn hardware_counters_available() -> bool {
+    imp::hardware_counters_available()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_counters_advance() {
+        let before = read_thread_counters();
+        let mut x = 0u64;
+        for i in 0..1_000_000u64 {
+            x = x.wrapping_mul(31).wrapping_add(i);
+        }
+        std::hint::black_box(x);
+        let delta = read_thread_counters().since(&before);
+
+        if hardware_counters_available() {
+            assert!(delta.instructions > 1_000_000);
+            assert!(delta.cycles > 0);
+        } else {
+            assert_eq!(delta.cycles, 0);
+        }
+    }
+}
@@ -0,0 +1,234 @@
+//! Index-based execution plan compiled from the dependency graph
+//!
+//! The scheduler resolves dependency levels, node filters and per-node rates
+//! once, when nodes or rates change, instead of on every tick: levels become
+//! lists of node indices and rates become harmonic rate groups sharing one
+//! integer deadline each. A tick then costs one integer compare per rate
+//! group plus a flag lookup per node, with no string compares, float divides
+//! or allocation.
+
+use std::collections::HashMap;
+
+/// Nodes that share a tick rate, due together on absolute deadlines
+#[derive(Debug, Clone)]
+struct RateGroup {
+    period_ns: u64,
+    next_due_ns: u64,
+    members: Vec<usize>,
+}
+
+/// Per-run execution plan over the scheduler's node list
+#[derive(Debug, Clone, Default)]
+pub(crate) struct ExecutionPlan {
+    /// Node indices per dependency level, ascending (= priority order)
+    levels: Vec<Vec<usize>>,
+    /// Every planned node in priority order (for sequential execution)
+    sequence: Vec<usize>,
+    groups: Vec<RateGroup>,
+    /// Whether each node is due this tick (always true for full-rate nodes)
+    due: Vec<bool>,
+    /// A group counts as due this far ahead of its deadline, so it fires on
+    /// the scheduler tick nearest the deadline instead of the one after it
+    tolerance_ns: u64,
+}
+
+/// What the plan needs to know about one registered node
+pub(crate) struct PlanNode<'a> {
+    pub name: &'a str,
+    pub rate_hz: Option<f64>,
+    /// Excluded by the run's node filter
+    pub filtered_out: bool,
+}
+
+impl ExecutionPlan {
+    /// Compile a plan for `nodes` (already sorted by priority)
+    ///
+    /// `levels` are the dependency graph's levels by node name; nodes that
+    /// the graph doesn't list run in a final level. Rate groups are anchored
+    /// at `now_ns` so harmonic rates (1 kHz / 100 Hz / 10 Hz) line up on the
+    /// same ticks. `base_period_ns` is the scheduler tick period.
+    pub(crate) fn compile(
+        nodes: &[PlanNode<'_>],
+        levels: &[Vec<String>],
+        base_period_ns: u64,
+        now_ns: u64,
+    ) -> Self {
+        let index: HashMap<&str, usize> =
+            nodes.iter().enumerate().map(|(i, n)| (n.name, i)).collect();
+
+        let mut placed = vec![false; nodes.len()];
+        let mut plan_levels: Vec<Vec<usize>> = levels
+            .iter()
+            .map(|level| {
+                let mut indices: Vec<usize> = level
+                    .iter()
+                    .filter_map(|name| index.get(name.as_str()).copied())
+                    .filter(|&i| !nodes[i].filtered_out && !std::mem::replace(&mut placed[i], true))
+                    .collect();
+                indices.sort_unstable();
+                indices
+            })
+            .filter(|level| !level.is_empty())
+            .collect();
+
+        let unplaced: Vec<usize> = (0..nodes.len())
+            .filter(|&i| !placed[i] && !nodes[i].filtered_out)
+            .collect();
+        if !unplaced.is_empty() {
+            plan_levels.push(unplaced);
+        }
+
+        let mut sequence: Vec<usize> = plan_levels.iter().flatten().copied().collect();
+        sequence.sort_unstable();
+
+        // Group rate-limited nodes by period
+        let mut groups: Vec<RateGroup> = Vec::new();
+        for &i in &sequence {
+            let Some(rate_hz) = nodes[i].rate_hz.filter(|r| *r > 0.0) else {
+                continue;
+            };
+            let period_ns = ((1e9 / rate_hz).round() as u64).max(1);
+            if period_ns <= base_period_ns {
+                // At or above the scheduler rate: tick every time
+                continue;
+            }
+            match groups.iter_mut().find(|g| g.period_ns == period_ns) {
+                Some(group) => group.members.push(i),
+                None => groups.push(RateGroup {
+                    period_ns,
+                    next_due_ns: now_ns,
+                    members: vec![i],
+                }),
+            }
+        }
+
+        let mut due = vec![false; nodes.len()];
+        for &i in &sequence {
+            due[i] = true;
+        }
+
+        Self {
+            levels: plan_levels,
+            sequence,
+            groups,
+            due,
+            tolerance_ns: base_period_ns / 2,
+        }
+    }
+
+    /// Advance rate groups to `now_ns` and refresh the due flags
+    pub(crate) fn begin_tick(&mut self, now_ns: u64) {
+        for group in &mut self.groups {
+            let fire = now_ns + self.tolerance_ns >= group.next_due_ns;
+            if fire {
+                // Next absolute deadline after now; missed ones are skipped
+                let behind = now_ns.saturating_sub(group.next_due_ns);
+                group.next_due_ns += (behind / group.period_ns + 1) * group.period_ns;
+            }
+            for &i in &group.members {
+                self.due[i] = fire;
+            }
+        }
+    }
+
+    pub(crate) fn levels(&self) -> &[Vec<usize>] {
+        &self.levels
+    }
+
+    pub(crate) fn sequence(&self) -> &[usize] {
+        &self.sequence
+    }
+
+    #[inline]
+    pub(crate) fn is_due(&self, idx: usize) -> bool {
+        self.due[idx]
+    }
+
+    /// Number of distinct sub-rate groups
+    pub(crate) fn rate_group_count(&self) -> usize {
+        self.groups.len()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const MS: u64 = 1_000_000;
+
+    fn node(name: &str, rate_hz: Option<f64>) -> PlanNode<'_> {
+        PlanNode {
+            name,
+            rate_hz,
+            filtered_out: false,
+        }
+    }
+
+    fn levels(names: &[&[&str]]) -> Vec<Vec<String>> {
+        names
+            .iter()
+            .map(|l| l.iter().map(|s| s.to_string()).collect())
+            .collect()
+    }
+
+    #[test]
+    fn test_levels_become_indices() {
+        let nodes = [node("a", None), node("b", None), node("c", None)];
+        let plan = ExecutionPlan::compile(&nodes, &levels(&[&["c", "a"], &["b"]]), MS, 0);
+        assert_eq!(plan.levels(), &[vec![0, 2], vec![1]]);
+        assert_eq!(plan.sequence(), &[0, 1, 2]);
+    }
+
+    #[test]
+    fn test_unlisted_and_filtered_nodes() {
+        let mut nodes = vec![node("a", None), node("b", None), node("c", None)];
+        nodes[1].filtered_out = true;
+        // "c" missing from the graph, "ghost" not registered
+        let plan = ExecutionPlan::compile(&nodes, &levels(&[&["a", "b", "ghost"]]), MS, 0);
+        assert_eq!(plan.levels(), &[vec![0], vec![2]]);
+        assert!(!plan.is_due(1));
+    }
+
+    #[test]
+    fn test_harmonic_rate_groups() {
+        let nodes = [
+            node("fast", None),
+            node("mid", Some(100.0)),
+            node("slow", Some(10.0)),
+            node("mid2", Some(100.0)),
+        ];
+        let mut plan = ExecutionPlan::compile(&nodes, &[], MS, 0);
+        assert_eq!(plan.rate_group_count(), 2);
+
+        let mut counts = [0u32; 4];
+        // 1 kHz base ticks, each woken a little late
+        for tick in 0..1000u64 {
+            plan.begin_tick(tick * MS + 30_000);
+            for (i, count) in counts.iter_mut().enumerate() {
+                if plan.is_due(i) {
+                    *count += 1;
+                }
+            }
+            if tick % 100 == 0 {
+                // Every 10 Hz tick coincides with a 100 Hz tick
+                assert!(plan.is_due(1) && plan.is_due(2) && plan.is_due(3));
+            }
+        }
+        assert_eq!(counts, [1000, 100, 10, 100]);
+    }
+
+    #[test]
+    fn test_rate_groups_skip_missed_deadlines() {
+        let nodes = [node("slow", Some(10.0))];
+        let mut plan = ExecutionPlan::compile(&nodes, &[], MS, 0);
+        plan.begin_tick(0);
+        assert!(plan.is_due(0));
+        // Stalled for 350 ms: fire once, then resume on the 100 ms grid
+        plan.begin_tick(350 * MS);
+        assert!(plan.is_due(0));
+        plan.begin_tick(351 * MS);
+        assert!(!plan.is_due(0));
+        plan.begin_tick(400 * MS);
+        assert!(plan.is_due(0));
+    }
+}
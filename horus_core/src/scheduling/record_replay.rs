@@ -6,6 +6,12 @@
 //! - Replay with tick-perfect determinism
 //! - Mix recordings from different runs
 //! - Time travel to specific ticks
+//!
+//! Recordings are written in the chunked format from
+//! [`recording_file`](super::recording_file): `NodeRecorder` streams
+//! snapshots to disk from a background thread, and `NodeReplayer` memory-maps
+//! the file and decodes only the chunks it visits. Legacy single-blob bincode
+//! recordings are still loaded.
 
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
@@ -14,6 +20,10 @@ use std::io::{BufReader, BufWriter};
 use std::path::PathBuf;
 use std::time::SystemTime;
 
+use super::recording_file::{
+    self, ChunkOptions, RecordingReader, RecordingWriter, DEFAULT_CHUNK_SIZE, DEFAULT_QUEUE_DEPTH,
+};
+
 /// Directory for storing recordings
 const RECORDINGS_DIR: &str = ".horus/recordings";
 
@@ -36,6 +46,10 @@ pub struct RecordingConfig {
     pub compress: bool,
     /// Record interval (record every N ticks, 1 = every tick)
     pub interval: u64,
+    /// Uncompressed bytes per on-disk chunk
+    pub chunk_size: usize,
+    /// Snapshots buffered between the node and the writer thread
+    pub queue_depth: usize,
 }
 
 impl Default for RecordingConfig {
@@ -56,6 +70,8 @@ impl Default for RecordingConfig {
             max_size: MAX_RECORDING_SIZE,
             compress: true,
             interval: 1,
+            chunk_size: DEFAULT_CHUNK_SIZE,
+            queue_depth: DEFAULT_QUEUE_DEPTH,
         }
     }
 }
@@ -80,6 +96,14 @@ impl RecordingConfig {
             .join(format!("{}@{}.{}", node_name, node_id, RECORDING_EXT))
     }
 
+    /// Chunk options for files written with this config
+    pub fn chunk_options(&self) -> ChunkOptions {
+        ChunkOptions {
+            chunk_size: self.chunk_size,
+            compress: self.compress,
+        }
+    }
+
     /// Get the path for the scheduler recording
     pub fn scheduler_path(&self, scheduler_id: &str) -> PathBuf {
         self.session_dir()
@@ -231,23 +255,21 @@ impl NodeRecording {
             .sum()
     }
 
-    /// Save to file
+    /// Save to file in the chunked format
     pub fn save(&self, path: &PathBuf) -> std::io::Result<()> {
-        if let Some(parent) = path.parent() {
-            fs::create_dir_all(parent)?;
-        }
-
-        let file = File::create(path)?;
-        let writer = BufWriter::new(file);
-
-        // Use bincode for efficient serialization
-        bincode::serialize_into(writer, self).map_err(|e| std::io::Error::other(e.to_string()))?;
-
+        recording_file::write_recording(path, self, ChunkOptions::default())?;
         Ok(())
     }
 
-    /// Load from file
+    /// Load a whole recording into memory
+    ///
+    /// Accepts both chunked and legacy single-blob files. Use
+    /// [`RecordingReader`] to read large recordings lazily instead.
     pub fn load(path: &PathBuf) -> std::io::Result<Self> {
+        if RecordingReader::is_chunked(path) {
+            return RecordingReader::open(path)?.load_all();
+        }
+
         let file = File::open(path)?;
         let reader = BufReader::new(file);
 
@@ -339,10 +361,17 @@ impl SchedulerRecording {
 }
 
 /// Active recorder for a node
+///
+/// Snapshots are handed to a [`RecordingWriter`] as each tick ends and
+/// never accumulate in memory. The file is created on the first recorded
+/// tick; if it cannot be written, recording is disabled with a warning.
 pub struct NodeRecorder {
+    /// Recording metadata; snapshots are streamed to disk, not kept here
     recording: NodeRecording,
     config: RecordingConfig,
     current_snapshot: Option<NodeTickSnapshot>,
+    writer: Option<RecordingWriter>,
+    snapshot_count: usize,
     enabled: bool,
 }
 
@@ -352,6 +381,8 @@ impl NodeRecorder {
             recording: NodeRecording::new(node_name, node_id, &config.session_name),
             config,
             current_snapshot: None,
+            writer: None,
+            snapshot_count: 0,
             enabled: true,
         }
     }
@@ -394,15 +425,59 @@ impl NodeRecorder {
 
     /// Finish recording the current tick
     pub fn end_tick(&mut self, duration_ns: u64) {
-        if let Some(mut snapshot) = self.current_snapshot.take() {
-            snapshot.duration_ns = duration_ns;
-            self.recording.add_snapshot(snapshot);
+        let Some(mut snapshot) = self.current_snapshot.take() else {
+            return;
+        };
+        snapshot.duration_ns = duration_ns;
+
+        if self.snapshot_count == 0 {
+            self.recording.first_tick = snapshot.tick;
+        }
+        self.recording.last_tick = snapshot.tick;
+
+        if let Err(e) = self.writer().and_then(|w| w.append(snapshot)) {
+            log::warn!(
+                "Recording for node '{}' stopped: {}",
+                self.recording.node_name,
+                e
+            );
+            self.enabled = false;
+            return;
         }
+        self.snapshot_count += 1;
+    }
+
+    fn writer(&mut self) -> std::io::Result<&RecordingWriter> {
+        if self.writer.is_none() {
+            let path = self.path();
+            self.writer = Some(RecordingWriter::create(
+                &path,
+                &self.recording,
+                self.config.chunk_options(),
+                self.config.queue_depth,
+            )?);
+        }
+        Ok(self.writer.as_ref().unwrap())
+    }
+
+    fn path(&self) -> PathBuf {
+        self.config
+            .node_path(&self.recording.node_name, &self.recording.node_id)
     }
 
     /// Check if we should stop (size limit reached)
     pub fn should_stop(&self) -> bool {
-        self.recording.estimated_size() >= self.config.max_size
+        self.bytes_written() >= self.config.max_size as u64
+    }
+
+    /// Bytes written to disk so far
+    pub fn bytes_written(&self) -> u64 {
+        self.writer.as_ref().map_or(0, |w| w.bytes_written())
+    }
+
+    /// Number of ticks recorded
+    pub fn snapshot_count(&self) -> usize {
+        self.snapshot_count
     }
 
     /// Finish and save the recording
@@ -410,15 +485,17 @@ impl NodeRecorder {
         self.recording.finish();
         self.enabled = false;
 
-        let path = self
-            .config
-            .node_path(&self.recording.node_name, &self.recording.node_id);
-        self.recording.save(&path)?;
+        // Make sure a file exists even if no tick was recorded
+        self.writer()?;
+        let path = self.path();
+        if let Some(writer) = self.writer.take() {
+            writer.finish(&self.recording)?;
+        }
 
         Ok(path)
     }
 
-    /// Get the current recording (for inspection)
+    /// Get the recording metadata (snapshots live on disk)
     pub fn recording(&self) -> &NodeRecording {
         &self.recording
     }
@@ -429,36 +506,78 @@ impl NodeRecorder {
     }
 }
 
+/// Where a replayer reads snapshots from
+enum ReplaySource {
+    /// Fully loaded recording
+    Memory(NodeRecording),
+    /// Memory-mapped chunked file, with the current snapshot decoded
+    Mapped {
+        reader: RecordingReader,
+        current: Option<NodeTickSnapshot>,
+    },
+}
+
 /// Replayer for a node recording
 pub struct NodeReplayer {
-    recording: NodeRecording,
+    source: ReplaySource,
     current_index: usize,
     current_tick: u64,
 }
 
 impl NodeReplayer {
     /// Load a recording from file
+    ///
+    /// Chunked recordings are memory-mapped and decoded lazily, so opening
+    /// takes the same time regardless of recording length.
     pub fn load(path: &PathBuf) -> std::io::Result<Self> {
-        let recording = NodeRecording::load(path)?;
-        Ok(Self {
-            recording,
+        if !RecordingReader::is_chunked(path) {
+            return Ok(Self::from_recording(NodeRecording::load(path)?));
+        }
+
+        let reader = RecordingReader::open(path)?;
+        let mut replayer = Self {
+            source: ReplaySource::Mapped {
+                reader,
+                current: None,
+            },
             current_index: 0,
             current_tick: 0,
-        })
+        };
+        replayer.move_to(0)?;
+        Ok(replayer)
     }
 
     /// Load from a recording struct
     pub fn from_recording(recording: NodeRecording) -> Self {
         Self {
-            recording,
+            source: ReplaySource::Memory(recording),
             current_index: 0,
             current_tick: 0,
         }
     }
 
+    /// Position on snapshot `index`, decoding it if the source is mapped
+    fn move_to(&mut self, index: usize) -> std::io::Result<bool> {
+        let tick = match &mut self.source {
+            ReplaySource::Memory(recording) => recording.snapshots.get(index).map(|s| s.tick),
+            ReplaySource::Mapped { reader, current } => {
+                *current = reader.snapshot_at(index)?;
+                current.as_ref().map(|s| s.tick)
+            }
+        };
+        self.current_index = index;
+        if let Some(tick) = tick {
+            self.current_tick = tick;
+        }
+        Ok(tick.is_some())
+    }
+
     /// Get the snapshot for the current tick
     pub fn current_snapshot(&self) -> Option<&NodeTickSnapshot> {
-        self.recording.snapshots.get(self.current_index)
+        match &self.source {
+            ReplaySource::Memory(recording) => recording.snapshots.get(self.current_index),
+            ReplaySource::Mapped { current, .. } => current.as_ref(),
+        }
     }
 
     /// Get outputs for the current tick
@@ -473,12 +592,15 @@ impl NodeReplayer {
 
     /// Advance to the next tick
     pub fn advance(&mut self) -> bool {
-        if self.current_index + 1 < self.recording.snapshots.len() {
-            self.current_index += 1;
-            if let Some(snapshot) = self.recording.snapshots.get(self.current_index) {
-                self.current_tick = snapshot.tick;
+        if self.current_index + 1 < self.total_ticks() {
+            let next = self.current_index + 1;
+            match self.move_to(next) {
+                Ok(moved) => moved,
+                Err(e) => {
+                    log::warn!("Failed to read recording at snapshot {}: {}", next, e);
+                    false
+                }
             }
-            true
         } else {
             false
         }
@@ -486,30 +608,40 @@ impl NodeReplayer {
 
     /// Jump to a specific tick
     pub fn seek(&mut self, tick: u64) -> bool {
-        for (i, snapshot) in self.recording.snapshots.iter().enumerate() {
-            if snapshot.tick >= tick {
-                self.current_index = i;
-                self.current_tick = snapshot.tick;
-                return true;
+        let index = match &self.source {
+            ReplaySource::Memory(recording) => {
+                recording.snapshots.iter().position(|s| s.tick >= tick)
             }
+            ReplaySource::Mapped { reader, .. } => reader.position_of(tick),
+        };
+        match index {
+            Some(index) => self.move_to(index).unwrap_or(false),
+            None => false,
         }
-        false
     }
 
     /// Reset to the beginning
     pub fn reset(&mut self) {
-        self.current_index = 0;
-        self.current_tick = self.recording.first_tick;
+        if let Err(e) = self.move_to(0) {
+            log::warn!("Failed to rewind recording: {}", e);
+        }
+        self.current_tick = self.recording().first_tick;
     }
 
     /// Check if replay is finished
     pub fn is_finished(&self) -> bool {
-        self.current_index >= self.recording.snapshots.len()
+        self.current_index >= self.total_ticks()
     }
 
     /// Get the recording
+    ///
+    /// For memory-mapped recordings this is the metadata only; its
+    /// `snapshots` are empty.
     pub fn recording(&self) -> &NodeRecording {
-        &self.recording
+        match &self.source {
+            ReplaySource::Memory(recording) => recording,
+            ReplaySource::Mapped { reader, .. } => reader.metadata(),
+        }
     }
 
     /// Get current tick number
@@ -519,7 +651,10 @@ impl NodeReplayer {
 
     /// Get total ticks in recording
     pub fn total_ticks(&self) -> usize {
-        self.recording.snapshots.len()
+        match &self.source {
+            ReplaySource::Memory(recording) => recording.snapshots.len(),
+            ReplaySource::Mapped { reader, .. } => reader.snapshot_count(),
+        }
     }
 }
 
@@ -783,10 +918,50 @@ mod tests {
         recorder.record_output("motor", vec![10, 11, 12]);
         recorder.end_tick(2000);
 
-        assert_eq!(recorder.recording().snapshot_count(), 2);
+        assert_eq!(recorder.snapshot_count(), 2);
 
         let path = recorder.finish().unwrap();
         assert!(path.exists());
+
+        let mut replayer = NodeReplayer::load(&path).unwrap();
+        assert_eq!(replayer.total_ticks(), 2);
+        assert_eq!(replayer.get_output("motor").unwrap(), &vec![4, 5, 6]);
+        assert!(replayer.advance());
+        assert_eq!(replayer.current_tick(), 1);
+        assert_eq!(replayer.recording().first_tick, 0);
+        assert_eq!(replayer.recording().last_tick, 1);
+    }
+
+    #[test]
+    fn test_mapped_replayer_seek() {
+        let dir = tempdir().unwrap();
+        let config = RecordingConfig {
+            session_name: "seek".to_string(),
+            base_dir: dir.path().to_path_buf(),
+            chunk_size: 1024,
+            ..Default::default()
+        };
+
+        let mut recorder = NodeRecorder::new("node", "id", config);
+        for tick in 0..500 {
+            recorder.begin_tick(tick);
+            recorder.record_output("out", tick.to_le_bytes().to_vec());
+            recorder.end_tick(10);
+        }
+        let path = recorder.finish().unwrap();
+
+        let mut replayer = NodeReplayer::load(&path).unwrap();
+        assert_eq!(replayer.total_ticks(), 500);
+        assert!(replayer.seek(321));
+        assert_eq!(replayer.current_tick(), 321);
+        assert_eq!(
+            replayer.get_output("out").unwrap(),
+            &321u64.to_le_bytes().to_vec()
+        );
+        assert!(!replayer.seek(10_000));
+
+        replayer.reset();
+        assert_eq!(replayer.current_tick(), 0);
     }
 
     #[test]
@@ -860,6 +1035,6 @@ mod tests {
         recorder.record_output("out", vec![3]);
         recorder.end_tick(100);
 
-        assert_eq!(recorder.recording().snapshot_count(), 2); // Only ticks 0 and 2
+        assert_eq!(recorder.snapshot_count(), 2); // Only ticks 0 and 2
     }
 }
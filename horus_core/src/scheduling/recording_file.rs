@@ -0,0 +1,854 @@
+//! Chunked, append-only recording file format
+//!
+//! Node recordings are streamed to disk as they are made instead of being
+//! held in memory until `finish()`. A file is laid out as:
+//!
+//! ```text
+//! ┌────────────┬──────────────┬─────────┬─────────┬─────┬──────────────────┐
+//! │ file header│ metadata     │ chunk 0 │ chunk 1 │ ... │ footer: metadata │
+//! │ magic, ver │ (bincode)    │         │         │     │ + index + trailer│
+//! └────────────┴──────────────┴─────────┴─────────┴─────┴──────────────────┘
+//! ```
+//!
+//! Each chunk holds a run of consecutive snapshots, optionally Zstd
+//! compressed, as `[tick u64][len u32][bincode snapshot]` records. The footer
+//! index maps tick ranges to chunk offsets, so a memory-mapped
+//! [`RecordingReader`] opens a file by reading only the trailer and index and
+//! finds any tick with two binary searches, decoding just the chunk it lands
+//! in. A file whose footer was never written (crash, power loss) is still
+//! readable: the reader rebuilds the index by walking the chunk headers.
+//!
+//! [`RecordingWriter`] moves encoding, compression and I/O to a background
+//! thread fed through a bounded queue, so memory stays bounded by the queue
+//! depth plus one chunk regardless of recording length.
+
+use std::fs::{self, File};
+use std::io::{self, BufWriter, Write};
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::Arc;
+use std::thread::JoinHandle;
+
+use crossbeam::channel::{self, Receiver, Sender};
+use memmap2::Mmap;
+use parking_lot::Mutex;
+
+use super::record_replay::{NodeRecording, NodeTickSnapshot};
+
+/// File magic for chunked recordings
+pub(crate) const FILE_MAGIC: &[u8; 8] = b"HORUSREC";
+/// Trailer magic marking a complete footer
+const TRAILER_MAGIC: &[u8; 8] = b"HORUSIDX";
+/// Chunk header magic ("CHNK")
+const CHUNK_MAGIC: u32 = 0x4B4E_4843;
+/// Current format version
+const FORMAT_VERSION: u32 = 2;
+
+/// magic + version + metadata length
+const FILE_HEADER_SIZE: usize = 16;
+/// magic, codec, pad, count, raw_len, stored_len, reserved, first_tick, last_tick
+const CHUNK_HEADER_SIZE: usize = 40;
+/// index_offset, index_count, meta_offset, meta_len, reserved, magic
+const TRAILER_SIZE: usize = 40;
+/// offset, first_tick, last_tick, count, raw_len, stored_len, codec+pad, first_ordinal
+const INDEX_ENTRY_SIZE: usize = 48;
+/// tick + length prefix in front of every record
+const RECORD_HEADER_SIZE: usize = 12;
+
+/// Chunk payload stored as-is
+const CODEC_RAW: u8 = 0;
+/// Chunk payload compressed with Zstd
+const CODEC_ZSTD: u8 = 1;
+
+/// Fast Zstd level: decompresses at memory speed, similar to LZ4
+const CHUNK_ZSTD_LEVEL: i32 = 1;
+
+/// Default uncompressed chunk size
+pub const DEFAULT_CHUNK_SIZE: usize = 256 * 1024;
+/// Default writer queue depth (snapshots)
+pub const DEFAULT_QUEUE_DEPTH: usize = 256;
+
+fn invalid(msg: impl Into<String>) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, msg.into())
+}
+
+fn read_u32(bytes: &[u8], at: usize) -> u32 {
+    u32::from_le_bytes(bytes[at..at + 4].try_into().unwrap())
+}
+
+fn read_u64(bytes: &[u8], at: usize) -> u64 {
+    u64::from_le_bytes(bytes[at..at + 8].try_into().unwrap())
+}
+
+/// Options for writing chunked recordings
+#[derive(Debug, Clone)]
+pub struct ChunkOptions {
+    /// Close a chunk once it holds this many uncompressed bytes
+    pub chunk_size: usize,
+    /// Compress chunks
+    pub compress: bool,
+}
+
+impl Default for ChunkOptions {
+    fn default() -> Self {
+        Self {
+            chunk_size: DEFAULT_CHUNK_SIZE,
+            compress: true,
+        }
+    }
+}
+
+/// One entry of the footer index
+#[derive(Debug, Clone, Copy)]
+struct ChunkEntry {
+    offset: u64,
+    first_tick: u64,
+    last_tick: u64,
+    count: u32,
+    raw_len: u32,
+    stored_len: u32,
+    codec: u8,
+    /// Position of the chunk's first snapshot in the whole recording
+    first_ordinal: u64,
+}
+
+impl ChunkEntry {
+    fn write_to(&self, out: &mut Vec<u8>) {
+        out.extend_from_slice(&self.offset.to_le_bytes());
+        out.extend_from_slice(&self.first_tick.to_le_bytes());
+        out.extend_from_slice(&self.last_tick.to_le_bytes());
+        out.extend_from_slice(&self.count.to_le_bytes());
+        out.extend_from_slice(&self.raw_len.to_le_bytes());
+        out.extend_from_slice(&self.stored_len.to_le_bytes());
+        out.extend_from_slice(&[self.codec, 0, 0, 0]);
+        out.extend_from_slice(&self.first_ordinal.to_le_bytes());
+    }
+
+    fn read_from(bytes: &[u8]) -> Self {
+        Self {
+            offset: read_u64(bytes, 0),
+            first_tick: read_u64(bytes, 8),
+            last_tick: read_u64(bytes, 16),
+            count: read_u32(bytes, 24),
+            raw_len: read_u32(bytes, 28),
+            stored_len: read_u32(bytes, 32),
+            codec: bytes[36],
+            first_ordinal: read_u64(bytes, 40),
+        }
+    }
+
+    fn header_bytes(&self) -> [u8; CHUNK_HEADER_SIZE] {
+        let mut h = [0u8; CHUNK_HEADER_SIZE];
+        h[0..4].copy_from_slice(&CHUNK_MAGIC.to_le_bytes());
+        h[4] = self.codec;
+        h[8..12].copy_from_slice(&self.count.to_le_bytes());
+        h[12..16].copy_from_slice(&self.raw_len.to_le_bytes());
+        h[16..20].copy_from_slice(&self.stored_len.to_le_bytes());
+        h[24..32].copy_from_slice(&self.first_tick.to_le_bytes());
+        h[32..40].copy_from_slice(&self.last_tick.to_le_bytes());
+        h
+    }
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+/// Synchronous chunk encoder; the writer thread runs one of these
+pub(crate) struct ChunkEncoder {
+    file: BufWriter<File>,
+    options: ChunkOptions,
+    meta: NodeRecording,
+    /// Uncompressed records of the open chunk
+    chunk: Vec<u8>,
+    chunk_count: u32,
+    chunk_first_tick: u64,
+    chunk_last_tick: u64,
+    /// Compression output, reused between chunks
+    compressed: Vec<u8>,
+    zstd: Option<zstd::bulk::Compressor<'static>>,
+    index: Vec<ChunkEntry>,
+    offset: u64,
+    snapshots: u64,
+    bytes_written: Arc<AtomicU64>,
+}
+
+impl ChunkEncoder {
+    /// Create `path` and write the file header
+    ///
+    /// `meta` is stored in the header (so a file without a footer is still
+    /// identifiable) and again, updated, in the footer.
+    pub(crate) fn create(
+        path: &Path,
+        meta: &NodeRecording,
+        options: ChunkOptions,
+    ) -> io::Result<Self> {
+        if let Some(parent) = path.parent() {
+            fs::create_dir_all(parent)?;
+        }
+        let mut file = BufWriter::new(File::create(path)?);
+
+        let meta = metadata_only(meta);
+        let meta_bytes = bincode::serialize(&meta).map_err(|e| io::Error::other(e.to_string()))?;
+        file.write_all(FILE_MAGIC)?;
+        file.write_all(&FORMAT_VERSION.to_le_bytes())?;
+        file.write_all(&(meta_bytes.len() as u32).to_le_bytes())?;
+        file.write_all(&meta_bytes)?;
+
+        let zstd = if options.compress {
+            Some(zstd::bulk::Compressor::new(CHUNK_ZSTD_LEVEL)?)
+        } else {
+            None
+        };
+        let offset = (FILE_HEADER_SIZE + meta_bytes.len()) as u64;
+
+        Ok(Self {
+            file,
+            chunk: Vec::with_capacity(options.chunk_size + options.chunk_size / 8),
+            options,
+            meta,
+            chunk_count: 0,
+            chunk_first_tick: 0,
+            chunk_last_tick: 0,
+            compressed: Vec::new(),
+            zstd,
+            index: Vec::new(),
+            offset,
+            snapshots: 0,
+            bytes_written: Arc::new(AtomicU64::new(offset)),
+        })
+    }
+
+    /// Append one snapshot, closing the chunk when it is full
+    pub(crate) fn push(&mut self, snapshot: &NodeTickSnapshot) -> io::Result<()> {
+        if self.chunk_count == 0 {
+            self.chunk_first_tick = snapshot.tick;
+        }
+        self.chunk_last_tick = snapshot.tick;
+
+        let start = self.chunk.len();
+        self.chunk.extend_from_slice(&snapshot.tick.to_le_bytes());
+        self.chunk.extend_from_slice(&[0u8; 4]);
+        bincode::serialize_into(&mut self.chunk, snapshot)
+            .map_err(|e| io::Error::other(e.to_string()))?;
+        let len = (self.chunk.len() - start - RECORD_HEADER_SIZE) as u32;
+        self.chunk[start + 8..start + 12].copy_from_slice(&len.to_le_bytes());
+        self.chunk_count += 1;
+
+        if self.chunk.len() >= self.options.chunk_size {
+            self.flush_chunk()?;
+        }
+        Ok(())
+    }
+
+    fn flush_chunk(&mut self) -> io::Result<()> {
+        if self.chunk_count == 0 {
+            return Ok(());
+        }
+        let raw_len = self.chunk.len();
+        let (codec, payload): (u8, &[u8]) = match self.zstd.as_mut() {
+            Some(zstd) => {
+                self.compressed
+                    .resize(zstd::zstd_safe::compress_bound(raw_len), 0);
+                let n = zstd.compress_to_buffer(&self.chunk[..], &mut self.compressed[..])?;
+                if n < raw_len {
+                    (CODEC_ZSTD, &self.compressed[..n])
+                } else {
+                    (CODEC_RAW, &self.chunk[..])
+                }
+            }
+            None => (CODEC_RAW, &self.chunk[..]),
+        };
+
+        let entry = ChunkEntry {
+            offset: self.offset,
+            first_tick: self.chunk_first_tick,
+            last_tick: self.chunk_last_tick,
+            count: self.chunk_count,
+            raw_len: raw_len as u32,
+            stored_len: payload.len() as u32,
+            codec,
+            first_ordinal: self.snapshots,
+        };
+        self.file.write_all(&entry.header_bytes())?;
+        self.file.write_all(payload)?;
+
+        self.offset += (CHUNK_HEADER_SIZE + payload.len()) as u64;
+        self.snapshots += self.chunk_count as u64;
+        self.bytes_written.store(self.offset, Ordering::Relaxed);
+        self.index.push(entry);
+        self.chunk.clear();
+        self.chunk_count = 0;
+        Ok(())
+    }
+
+    /// Flush the open chunk and write the footer
+    ///
+    /// `meta` replaces the header metadata (e.g. to record `ended_at`);
+    /// its tick range is taken from what was actually written.
+    pub(crate) fn finish(mut self, meta: Option<&NodeRecording>) -> io::Result<u64> {
+        self.flush_chunk()?;
+
+        let mut meta = meta.map(metadata_only).unwrap_or_else(|| self.meta.clone());
+        if let (Some(first), Some(last)) = (self.index.first(), self.index.last()) {
+            meta.first_tick = first.first_tick;
+            meta.last_tick = last.last_tick;
+        }
+        let meta_bytes = bincode::serialize(&meta).map_err(|e| io::Error::other(e.to_string()))?;
+
+        let meta_offset = self.offset;
+        let index_offset = meta_offset + meta_bytes.len() as u64;
+        let mut footer = meta_bytes;
+        for entry in &self.index {
+            entry.write_to(&mut footer);
+        }
+        footer.extend_from_slice(&index_offset.to_le_bytes());
+        footer.extend_from_slice(&(self.index.len() as u64).to_le_bytes());
+        footer.extend_from_slice(&meta_offset.to_le_bytes());
+        footer.extend_from_slice(&((index_offset - meta_offset) as u32).to_le_bytes());
+        footer.extend_from_slice(&[0u8; 4]);
+        footer.extend_from_slice(TRAILER_MAGIC);
+        self.file.write_all(&footer)?;
+        self.file.flush()?;
+        self.file.get_ref().sync_data()?;
+
+        self.offset += footer.len() as u64;
+        self.bytes_written.store(self.offset, Ordering::Relaxed);
+        Ok(self.offset)
+    }
+}
+
+/// Strip snapshots so only the recording's metadata is serialized
+fn metadata_only(recording: &NodeRecording) -> NodeRecording {
+    NodeRecording {
+        node_id: recording.node_id.clone(),
+        node_name: recording.node_name.clone(),
+        session_name: recording.session_name.clone(),
+        started_at: recording.started_at,
+        ended_at: recording.ended_at,
+        first_tick: recording.first_tick,
+        last_tick: recording.last_tick,
+        snapshots: Vec::new(),
+        config: recording.config.clone(),
+    }
+}
+
+enum WriterMsg {
+    Snapshot(NodeTickSnapshot),
+    Finish(NodeRecording),
+}
+
+/// Streams snapshots to a chunked recording file from a background thread
+///
+/// The queue between the caller and the thread is bounded; when the disk
+/// cannot keep up, [`append`](Self::append) blocks rather than letting the
+/// backlog grow without limit.
+pub struct RecordingWriter {
+    sender: Option<Sender<WriterMsg>>,
+    thread: Option<JoinHandle<io::Result<u64>>>,
+    bytes_written: Arc<AtomicU64>,
+    stalls: AtomicU64,
+    path: PathBuf,
+}
+
+impl RecordingWriter {
+    /// Create `path` and start the writer thread
+    pub fn create(
+        path: &Path,
+        meta: &NodeRecording,
+        options: ChunkOptions,
+        queue_depth: usize,
+    ) -> io::Result<Self> {
+        let encoder = ChunkEncoder::create(path, meta, options)?;
+        let bytes_written = encoder.bytes_written.clone();
+        let (sender, receiver) = channel::bounded(queue_depth.max(1));
+
+        let thread = std::thread::Builder::new()
+            .name(format!("horus-rec-{}", meta.node_name))
+            .spawn(move || Self::run(encoder, receiver))?;
+
+        Ok(Self {
+            sender: Some(sender),
+            thread: Some(thread),
+            bytes_written,
+            stalls: AtomicU64::new(0),
+            path: path.to_path_buf(),
+        })
+    }
+
+    fn run(mut encoder: ChunkEncoder, receiver: Receiver<WriterMsg>) -> io::Result<u64> {
+        // A dropped sender without Finish still gets a valid footer
+        let mut meta = None;
+        for msg in receiver {
+            match msg {
+                WriterMsg::Snapshot(snapshot) => encoder.push(&snapshot)?,
+                WriterMsg::Finish(m) => {
+                    meta = Some(m);
+                    break;
+                }
+            }
+        }
+        encoder.finish(meta.as_ref())
+    }
+
+    /// Queue a snapshot for writing
+    ///
+    /// Fails if the writer thread has stopped because of an I/O error.
+    pub fn append(&self, snapshot: NodeTickSnapshot) -> io::Result<()> {
+        let sender = self
+            .sender
+            .as_ref()
+            .ok_or_else(|| io::Error::other("recording already finished"))?;
+        let msg = match sender.try_send(WriterMsg::Snapshot(snapshot)) {
+            Ok(()) => return Ok(()),
+            Err(channel::TrySendError::Full(msg)) => msg,
+            Err(channel::TrySendError::Disconnected(_)) => {
+                return Err(io::Error::other("recording writer stopped"))
+            }
+        };
+        self.stalls.fetch_add(1, Ordering::Relaxed);
+        sender
+            .send(msg)
+            .map_err(|_| io::Error::other("recording writer stopped"))
+    }
+
+    /// Bytes committed to the file so far (excludes the open chunk)
+    pub fn bytes_written(&self) -> u64 {
+        self.bytes_written.load(Ordering::Relaxed)
+    }
+
+    /// Number of appends that had to wait for the writer thread
+    pub fn stalls(&self) -> u64 {
+        self.stalls.load(Ordering::Relaxed)
+    }
+
+    /// File being written
+    pub fn path(&self) -> &Path {
+        &self.path
+    }
+
+    /// Flush everything, write the footer with `meta` and wait for the thread
+    ///
+    /// Returns the final file size.
+    pub fn finish(mut self, meta: &NodeRecording) -> io::Result<u64> {
+        if let Some(sender) = self.sender.take() {
+            // If the thread already died the join below reports why
+            let _ = sender.send(WriterMsg::Finish(metadata_only(meta)));
+        }
+        self.join()
+    }
+
+    fn join(&mut self) -> io::Result<u64> {
+        self.sender = None;
+        match self.thread.take() {
+            Some(thread) => thread
+                .join()
+                .map_err(|_| io::Error::other("recording writer panicked"))?,
+            None => Ok(self.bytes_written()),
+        }
+    }
+}
+
+impl Drop for RecordingWriter {
+    fn drop(&mut self) {
+        if let Err(e) = self.join() {
+            log::warn!(
+                "Recording {} was not closed cleanly: {}",
+                self.path.display(),
+                e
+            );
+        }
+    }
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+/// Decoded records of one chunk
+struct DecodedChunk {
+    chunk: usize,
+    /// Decompressed payload; `None` for raw chunks, read straight from the map
+    data: Option<Vec<u8>>,
+    /// (tick, offset, len) of every record within the payload
+    records: Vec<(u64, usize, usize)>,
+}
+
+/// Memory-mapped reader for chunked recordings
+///
+/// Opening reads only the trailer and the index. Lookups are two binary
+/// searches (chunk, then record) and decode a single chunk; the last decoded
+/// chunk is cached so sequential replay decompresses each chunk once.
+pub struct RecordingReader {
+    map: Mmap,
+    meta: NodeRecording,
+    chunks: Vec<ChunkEntry>,
+    snapshot_count: usize,
+    cache: Mutex<Option<Arc<DecodedChunk>>>,
+    /// Whether the index had to be rebuilt because the footer is missing
+    recovered: bool,
+}
+
+impl RecordingReader {
+    /// Whether `path` is a chunked recording (as opposed to a legacy blob)
+    pub fn is_chunked(path: &Path) -> bool {
+        let mut magic = [0u8; 8];
+        File::open(path)
+            .and_then(|mut f| io::Read::read_exact(&mut f, &mut magic))
+            .map(|_| &magic == FILE_MAGIC)
+            .unwrap_or(false)
+    }
+
+    /// Map `path` and load its index
+    pub fn open(path: &Path) -> io::Result<Self> {
+        let file = File::open(path)?;
+        // SAFETY: recordings are append-only; the mapping is read-only and
+        // every access is bounds-checked against the mapped length
+        let map = unsafe { Mmap::map(&file)? };
+
+        if map.len() < FILE_HEADER_SIZE || &map[..8] != FILE_MAGIC {
+            return Err(invalid("not a chunked HORUS recording"));
+        }
+        let version = read_u32(&map, 8);
+        if version != FORMAT_VERSION {
+            return Err(invalid(format!(
+                "unsupported recording version {}",
+                version
+            )));
+        }
+        let header_meta_len = read_u32(&map, 12) as usize;
+        let data_start = FILE_HEADER_SIZE + header_meta_len;
+        if map.len() < data_start {
+            return Err(invalid("truncated recording header"));
+        }
+
+        let (meta, chunks, recovered) = match Self::read_footer(&map)? {
+            Some((meta, chunks)) => (meta, chunks, false),
+            None => {
+                let mut meta: NodeRecording =
+                    bincode::deserialize(&map[FILE_HEADER_SIZE..data_start])
+                        .map_err(|e| invalid(e.to_string()))?;
+                let chunks = Self::scan_chunks(&map, data_start);
+                if let (Some(first), Some(last)) = (chunks.first(), chunks.last()) {
+                    meta.first_tick = first.first_tick;
+                    meta.last_tick = last.last_tick;
+                }
+                (meta, chunks, true)
+            }
+        };
+        let snapshot_count = chunks
+            .last()
+            .map_or(0, |c| (c.first_ordinal + c.count as u64) as usize);
+
+        Ok(Self {
+            map,
+            meta,
+            chunks,
+            snapshot_count,
+            cache: Mutex::new(None),
+            recovered,
+        })
+    }
+
+    fn read_footer(map: &[u8]) -> io::Result<Option<(NodeRecording, Vec<ChunkEntry>)>> {
+        if map.len() < FILE_HEADER_SIZE + TRAILER_SIZE {
+            return Ok(None);
+        }
+        let trailer = &map[map.len() - TRAILER_SIZE..];
+        if &trailer[32..40] != TRAILER_MAGIC {
+            return Ok(None);
+        }
+        let index_offset = read_u64(trailer, 0) as usize;
+        let index_count = read_u64(trailer, 8) as usize;
+        let meta_offset = read_u64(trailer, 16) as usize;
+        let meta_len = read_u32(trailer, 24) as usize;
+
+        let index_end = index_count
+            .checked_mul(INDEX_ENTRY_SIZE)
+            .and_then(|n| n.checked_add(index_offset))
+            .ok_or_else(|| invalid("corrupt recording index"))?;
+        if meta_offset + meta_len != index_offset || index_end != map.len() - TRAILER_SIZE {
+            return Err(invalid("corrupt recording footer"));
+        }
+
+        let meta = bincode::deserialize(&map[meta_offset..index_offset])
+            .map_err(|e| invalid(e.to_string()))?;
+        let mut chunks: Vec<ChunkEntry> = map[index_offset..index_end]
+            .chunks_exact(INDEX_ENTRY_SIZE)
+            .map(ChunkEntry::read_from)
+            .collect();
+        for chunk in &chunks {
+            let end = chunk.offset as usize + CHUNK_HEADER_SIZE + chunk.stored_len as usize;
+            if end > meta_offset {
+                return Err(invalid("recording index points past the data"));
+            }
+        }
+        chunks.sort_by_key(|c| c.first_ordinal);
+        Ok(Some((meta, chunks)))
+    }
+
+    /// Rebuild the index by walking chunk headers; stops at the first
+    /// incomplete chunk
+    fn scan_chunks(map: &[u8], mut offset: usize) -> Vec<ChunkEntry> {
+        let mut chunks = Vec::new();
+        let mut ordinal = 0u64;
+        while offset + CHUNK_HEADER_SIZE <= map.len() {
+            let h = &map[offset..offset + CHUNK_HEADER_SIZE];
+            if read_u32(h, 0) != CHUNK_MAGIC {
+                break;
+            }
+            let entry = ChunkEntry {
+                offset: offset as u64,
+                codec: h[4],
+                count: read_u32(h, 8),
+                raw_len: read_u32(h, 12),
+                stored_len: read_u32(h, 16),
+                first_tick: read_u64(h, 24),
+                last_tick: read_u64(h, 32),
+                first_ordinal: ordinal,
+            };
+            let end = offset + CHUNK_HEADER_SIZE + entry.stored_len as usize;
+            if end > map.len() {
+                break;
+            }
+            ordinal += entry.count as u64;
+            offset = end;
+            chunks.push(entry);
+        }
+        chunks
+    }
+
+    /// Recording metadata (its `snapshots` field is empty)
+    pub fn metadata(&self) -> &NodeRecording {
+        &self.meta
+    }
+
+    /// Total snapshots in the file
+    pub fn snapshot_count(&self) -> usize {
+        self.snapshot_count
+    }
+
+    /// Number of chunks in the file
+    pub fn chunk_count(&self) -> usize {
+        self.chunks.len()
+    }
+
+    /// True if the footer was missing and the index was rebuilt by scanning
+    pub fn was_recovered(&self) -> bool {
+        self.recovered
+    }
+
+    /// Snapshot recorded at exactly `tick`
+    pub fn get_snapshot(&self, tick: u64) -> io::Result<Option<NodeTickSnapshot>> {
+        match self.position_of(tick) {
+            Some(ordinal) => Ok(self
+                .snapshot_at(ordinal)?
+                .filter(|snapshot| snapshot.tick == tick)),
+            None => Ok(None),
+        }
+    }
+
+    /// Snapshots with `start_tick <= tick <= end_tick`
+    pub fn get_snapshots_range(
+        &self,
+        start_tick: u64,
+        end_tick: u64,
+    ) -> io::Result<Vec<NodeTickSnapshot>> {
+        let mut snapshots = Vec::new();
+        let Some(mut ordinal) = self.position_of(start_tick) else {
+            return Ok(snapshots);
+        };
+        while let Some(snapshot) = self.snapshot_at(ordinal)? {
+            if snapshot.tick > end_tick {
+                break;
+            }
+            snapshots.push(snapshot);
+            ordinal += 1;
+        }
+        Ok(snapshots)
+    }
+
+    /// Position of the first snapshot with a tick `>= tick`
+    pub fn position_of(&self, tick: u64) -> Option<usize> {
+        let c = self.chunks.partition_point(|c| c.last_tick < tick);
+        let chunk = self.chunks.get(c)?;
+        if chunk.first_tick >= tick {
+            return Some(chunk.first_ordinal as usize);
+        }
+        let decoded = self.decode(c).ok()?;
+        let r = decoded.records.partition_point(|&(t, _, _)| t < tick);
+        Some(chunk.first_ordinal as usize + r)
+    }
+
+    /// Snapshot at position `ordinal` (0-based across the whole file)
+    pub fn snapshot_at(&self, ordinal: usize) -> io::Result<Option<NodeTickSnapshot>> {
+        if ordinal >= self.snapshot_count {
+            return Ok(None);
+        }
+        let c = self
+            .chunks
+            .partition_point(|c| c.first_ordinal as usize + c.count as usize <= ordinal);
+        let decoded = self.decode(c)?;
+        let (_, offset, len) = decoded.records[ordinal - self.chunks[c].first_ordinal as usize];
+        let bytes = match &decoded.data {
+            Some(data) => &data[offset..offset + len],
+            None => {
+                let base = self.chunks[c].offset as usize + CHUNK_HEADER_SIZE;
+                &self.map[base + offset..base + offset + len]
+            }
+        };
+        bincode::deserialize(bytes)
+            .map(Some)
+            .map_err(|e| invalid(e.to_string()))
+    }
+
+    /// Read the whole file into an in-memory recording
+    pub fn load_all(&self) -> io::Result<NodeRecording> {
+        let mut recording = metadata_only(&self.meta);
+        recording.snapshots.reserve(self.snapshot_count);
+        for ordinal in 0..self.snapshot_count {
+            if let Some(snapshot) = self.snapshot_at(ordinal)? {
+                recording.snapshots.push(snapshot);
+            }
+        }
+        Ok(recording)
+    }
+
+    fn decode(&self, c: usize) -> io::Result<Arc<DecodedChunk>> {
+        if let Some(cached) = self.cache.lock().as_ref() {
+            if cached.chunk == c {
+                return Ok(cached.clone());
+            }
+        }
+
+        let entry = &self.chunks[c];
+        let start = entry.offset as usize + CHUNK_HEADER_SIZE;
+        let stored = &self.map[start..start + entry.stored_len as usize];
+        let data = match entry.codec {
+            CODEC_RAW => None,
+            CODEC_ZSTD => Some(zstd::bulk::decompress(stored, entry.raw_len as usize)?),
+            other => return Err(invalid(format!("unknown chunk codec {}", other))),
+        };
+        let payload = data.as_deref().unwrap_or(stored);
+
+        let mut records = Vec::with_capacity(entry.count as usize);
+        let mut at = 0;
+        while at + RECORD_HEADER_SIZE <= payload.len() {
+            let tick = read_u64(payload, at);
+            let len = read_u32(payload, at + 8) as usize;
+            let body = at + RECORD_HEADER_SIZE;
+            if body + len > payload.len() {
+                return Err(invalid("truncated recording chunk"));
+            }
+            records.push((tick, body, len));
+            at = body + len;
+        }
+        if records.len() != entry.count as usize {
+            return Err(invalid("recording chunk record count mismatch"));
+        }
+
+        let decoded = Arc::new(DecodedChunk {
+            chunk: c,
+            data,
+            records,
+        });
+        *self.cache.lock() = Some(decoded.clone());
+        Ok(decoded)
+    }
+}
+
+impl std::fmt::Debug for RecordingReader {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("RecordingReader")
+            .field("node_name", &self.meta.node_name)
+            .field("snapshots", &self.snapshot_count)
+            .field("chunks", &self.chunks.len())
+            .field("recovered", &self.recovered)
+            .finish()
+    }
+}
+
+/// Write `recording` to `path` synchronously in the chunked format
+pub(crate) fn write_recording(
+    path: &Path,
+    recording: &NodeRecording,
+    options: ChunkOptions,
+) -> io::Result<u64> {
+    let mut encoder = ChunkEncoder::create(path, recording, options)?;
+    for snapshot in &recording.snapshots {
+        encoder.push(snapshot)?;
+    }
+    encoder.finish(Some(recording))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tempfile::tempdir;
+
+    fn snapshot(tick: u64) -> NodeTickSnapshot {
+        NodeTickSnapshot::new(tick)
+            .with_input("sensor", vec![tick as u8; 64])
+            .with_output("motor", (0..128).map(|i| (i + tick) as u8).collect())
+    }
+
+    fn write(path: &Path, ticks: impl Iterator<Item = u64>, chunk_size: usize) {
+        let meta = NodeRecording::new("node", "id", "session");
+        let options = ChunkOptions {
+            chunk_size,
+            compress: true,
+        };
+        let writer = RecordingWriter::create(path, &meta, options, 4).unwrap();
+        for tick in ticks {
+            writer.append(snapshot(tick)).unwrap();
+        }
+        writer.finish(&meta).unwrap();
+    }
+
+    #[test]
+    fn test_streamed_roundtrip_and_seek() {
+        let dir = tempdir().unwrap();
+        let path = dir.path().join("node.horus");
+        // Every other tick, in many small chunks
+        write(&path, (0..1000).map(|t| t * 2), 2048);
+
+        let reader = RecordingReader::open(&path).unwrap();
+        assert!(!reader.was_recovered());
+        assert_eq!(reader.snapshot_count(), 1000);
+        assert!(reader.chunk_count() > 10);
+        assert_eq!(reader.metadata().first_tick, 0);
+        assert_eq!(reader.metadata().last_tick, 1998);
+
+        let snap = reader.get_snapshot(1234).unwrap().unwrap();
+        assert_eq!(snap.outputs["motor"], snapshot(1234).outputs["motor"]);
+        assert!(reader.get_snapshot(1235).unwrap().is_none());
+        assert!(reader.get_snapshot(5000).unwrap().is_none());
+
+        let range = reader.get_snapshots_range(99, 121).unwrap();
+        let ticks: Vec<u64> = range.iter().map(|s| s.tick).collect();
+        assert_eq!(ticks, (100..=120).step_by(2).collect::<Vec<_>>());
+
+        assert_eq!(reader.load_all().unwrap().snapshot_count(), 1000);
+    }
+
+    #[test]
+    fn test_recovers_without_footer() {
+        let dir = tempdir().unwrap();
+        let path = dir.path().join("crashed.horus");
+        write(&path, 0..200, 1024);
+
+        // Chop off the footer and half of the last chunk, as a crash would
+        let full = RecordingReader::open(&path).unwrap();
+        let last = *full.chunks.last().unwrap();
+        drop(full);
+        let cut = last.offset + CHUNK_HEADER_SIZE as u64 + last.stored_len as u64 / 2;
+        let file = fs::OpenOptions::new().write(true).open(&path).unwrap();
+        file.set_len(cut).unwrap();
+
+        let reader = RecordingReader::open(&path).unwrap();
+        assert!(reader.was_recovered());
+        assert_eq!(reader.metadata().node_name, "node");
+        assert_eq!(reader.snapshot_count() as u64, last.first_ordinal);
+        assert_eq!(reader.get_snapshot(3).unwrap().unwrap().tick, 3);
+    }
+}
@@ -23,11 +23,18 @@ extern "C" fn sigterm_handler(_signum: libc::c_int) {
 }
 
 // Import intelligence modules
-use super::executors::{AsyncIOExecutor, AsyncResult, ParallelExecutor};
+use super::alloc::{self, AllocSample, RtAllocPolicy};
+use super::event_trigger::EventTrigger;
+use super::executors::{AsyncIOExecutor, AsyncResult, LevelMetrics, ParallelExecutor};
 use super::fault_tolerance::CircuitBreaker;
+use super::fusion::{find_chains, FusedHandoff, FusedRole, FusionCandidate};
 use super::intelligence::{DependencyGraph, ExecutionTier, RuntimeProfiler, TierClassifier};
-use super::jit::CompiledDataflow;
+use super::jit::{CompiledDataflow, DataflowGraph, DataflowKernel};
+use super::metrics::{self, NodeMetrics};
+use super::perf;
+use super::plan::{ExecutionPlan, PlanNode};
 use super::safety_monitor::SafetyMonitor;
+use super::timing::{monotonic_ns, JitterStats, TickPacer};
 use tokio::sync::mpsc;
 
 /// Enhanced node registration info with lifecycle tracking and per-node rate control
@@ -38,13 +45,38 @@ struct RegisteredNode {
     initialized: bool,
     context: Option<NodeInfo>,
     rate_hz: Option<f64>, // Per-node rate control (None = use global scheduler rate)
-    last_tick: Option<Instant>, // Last tick time for rate limiting
     circuit_breaker: CircuitBreaker, // Fault tolerance
     is_rt_node: bool,     // Track if this is a real-time node
     wcet_budget: Option<Duration>, // WCET budget for RT nodes
     deadline: Option<Duration>, // Deadline for RT nodes
     is_jit_compiled: bool, // Track if node uses JIT compilation
     jit_stats: Option<CompiledDataflow>, // JIT compilation statistics
+    event_trigger: Option<EventTrigger>, // Tick only on new input (None = every tick)
+    fusion: Option<FusedRole>, // Part of a fused dataflow kernel (None = tick())
+    metrics: Option<Arc<NodeMetrics>>, // Tick latency histogram (None = not recorded)
+    count_hw: bool,       // Sample perf counters around the tick
+    alloc_policy: Option<RtAllocPolicy>, // Count allocator calls around the tick (None = off)
+    allocs: AllocSample,  // Allocator calls inside ticks so far
+    alloc_violations: u64, // RT ticks that called the allocator
+}
+
+/// Longest the scheduler parks when every running node is event-driven.
+/// Bounds how long stop requests and periodic housekeeping can be delayed.
+const EVENT_IDLE_PARK: Duration = Duration::from_millis(100);
+
+/// How far ahead of a periodic deadline the event park hands over to the
+/// pacer, whose absolute sleep (and spin tail) then hits the deadline exactly
+const EVENT_PARK_MARGIN: Duration = Duration::from_micros(200);
+
+/// Busy-wait tail applied when the configured jitter budget is below 1 ms.
+/// Covers the usual clock_nanosleep wake-up latency on a non-RT kernel.
+const DEFAULT_SPIN_TAIL: Duration = Duration::from_micros(100);
+
+/// Result of ticking one node, reported back to the scheduler thread
+#[derive(Debug, Clone, Copy)]
+struct NodeTickOutcome {
+    duration: Duration,
+    failed: bool,
 }
 
 /// Central orchestrator: holds nodes, drives the tick loop.
@@ -68,6 +100,8 @@ pub struct Scheduler {
 
     // JIT compilation for ultra-fast nodes
     jit_compiled_nodes: HashMap<String, CompiledDataflow>,
+    // Node chains allowed to fuse into one dataflow kernel, in publish order
+    fused_chains: Vec<Vec<String>>,
 
     // Configuration (stored for runtime use)
     config: Option<super::config::SchedulerConfig>,
@@ -78,6 +112,20 @@ pub struct Scheduler {
     // === New runtime features ===
     // Tick rate enforcement
     tick_period: Duration,
+    // Absolute-deadline pacing of the tick loop, with jitter histogram
+    pacer: TickPacer,
+    // False while an iteration was woken by an event before the pacer
+    // deadline: only event-driven nodes run then
+    periodic_due: bool,
+    // Index-based plan; None when nodes or rates changed since it was built
+    plan: Option<ExecutionPlan>,
+    // Reused per-level list of node indices to tick
+    level_scratch: Vec<usize>,
+    // Per-node latency histograms / hardware counters (see scheduling::metrics)
+    node_metrics: bool,
+    hardware_counters: bool,
+    // Heap allocation tracking inside ticks (see scheduling::alloc)
+    alloc_policy: Option<RtAllocPolicy>,
 
     // Checkpoint system
     checkpoint_manager: Option<super::checkpoint::CheckpointManager>,
@@ -124,6 +172,7 @@ impl Scheduler {
 
             // JIT compilation
             jit_compiled_nodes: HashMap::new(),
+            fused_chains: Vec::new(),
 
             // Configuration
             config: None,
@@ -132,7 +181,14 @@ impl Scheduler {
             safety_monitor: None,
 
             // New runtime features (disabled by default)
-            tick_period: Duration::from_micros(16667), // ~60Hz default
+            tick_period: Duration::from_nanos(16_666_667), // ~60Hz default
+            pacer: TickPacer::new(Duration::from_nanos(16_666_667)),
+            periodic_due: true,
+            plan: None,
+            level_scratch: Vec::new(),
+            node_metrics: false,
+            hardware_counters: false,
+            alloc_policy: None,
             checkpoint_manager: None,
             blackbox: None,
             telemetry: None,
@@ -169,6 +225,7 @@ impl Scheduler {
     /// When enabled:
     /// - Learning disabled (no adaptive optimizations)
     /// - Deterministic collections (sorted iteration order)
+    /// - Nodes within a dependency level run sequentially (no worker pool)
     /// - Logical clock support (opt-in via config)
     /// - Predictable memory allocation (opt-in via config)
     ///
@@ -186,7 +243,10 @@ impl Scheduler {
     /// let scheduler = Scheduler::new()
     ///     .enable_determinism();  // Reproducible execution
     /// ```
-    pub fn enable_determinism(self) -> Self {
+    pub fn enable_determinism(mut self) -> Self {
+        // Nodes of a dependency level tick one after another, in a fixed order
+        self.parallel_executor.set_max_threads(1);
+
         // Disable learning for deterministic behavior
         self.disable_learning().with_name("DeterministicScheduler")
     }
@@ -231,6 +291,100 @@ impl Scheduler {
         self
     }
 
+    /// Record per-node tick latency histograms (p50/p99/p99.9/max)
+    ///
+    /// With `hardware_counters`, CPU cycles, instructions, LLC misses and
+    /// context switches are also sampled around every tick. Recording is
+    /// lock-free and the results are served by the OpenMetrics telemetry
+    /// endpoint (`prometheus://host:port`).
+    ///
+    /// # Example
+    /// ```no_run
+    /// use horus_core::Scheduler;
+    /// let scheduler = Scheduler::new().with_node_metrics(true);
+    /// ```
+    pub fn with_node_metrics(mut self, hardware_counters: bool) -> Self {
+        self.enable_node_metrics(hardware_counters);
+        self
+    }
+
+    fn enable_node_metrics(&mut self, hardware_counters: bool) {
+        self.node_metrics = true;
+        self.hardware_counters |= hardware_counters;
+        for registered in &mut self.nodes {
+            if registered.metrics.is_none() {
+                registered.metrics = Some(metrics::node_metrics(registered.node.name()));
+            }
+            registered.count_hw = self.hardware_counters;
+        }
+    }
+
+    /// Count heap allocations of every node per tick
+    ///
+    /// RT nodes that call the allocator during a tick are reported according
+    /// to `policy`: `Warn` prints a warning, `Fail` fails the tick like a
+    /// panic would. Totals are available from `node_allocations()` and, with
+    /// node metrics enabled, the OpenMetrics endpoint. Requires
+    /// `CountingAllocator` as the global allocator (or the `alloc-tracking`
+    /// feature); use `NodeInfo::arena()` and `BlockPool` for tick-local memory.
+    ///
+    /// # Example
+    /// ```no_run
+    /// use horus_core::Scheduler;
+    /// use horus_core::scheduling::RtAllocPolicy;
+    /// let scheduler = Scheduler::new_realtime()
+    ///     .unwrap()
+    ///     .with_alloc_tracking(RtAllocPolicy::Fail);
+    /// ```
+    pub fn with_alloc_tracking(mut self, policy: RtAllocPolicy) -> Self {
+        if !alloc::is_installed() {
+            eprintln!(
+                "[WARN] Allocation tracking enabled but CountingAllocator is not the global allocator; counts will stay at zero"
+            );
+        }
+        self.alloc_policy = Some(policy);
+        for registered in &mut self.nodes {
+            registered.alloc_policy = Some(policy);
+        }
+        self
+    }
+
+    /// Allocator calls a node made inside its ticks (with allocation tracking)
+    pub fn node_allocations(&self, name: &str) -> Option<AllocSample> {
+        self.nodes
+            .iter()
+            .find(|registered| registered.alloc_policy.is_some() && registered.node.name() == name)
+            .map(|registered| registered.allocs)
+    }
+
+    /// Busy-wait the last `spin` of every tick period instead of sleeping
+    ///
+    /// The tick loop sleeps to absolute deadlines, which by itself wakes tens
+    /// of microseconds late. Spinning the tail trades one core's idle time
+    /// for single-digit-microsecond wake-ups. `Duration::ZERO` disables it.
+    ///
+    /// # Example
+    /// ```no_run
+    /// use horus_core::Scheduler;
+    /// use std::time::Duration;
+    /// let scheduler = Scheduler::new()
+    ///     .with_spin_tail(Duration::from_micros(100));
+    /// ```
+    pub fn with_spin_tail(mut self, spin: Duration) -> Self {
+        self.pacer.set_spin(spin);
+        self
+    }
+
+    /// Wake-up lateness of the tick loop since the scheduler started
+    pub fn tick_jitter(&self) -> JitterStats {
+        self.pacer.jitter().stats()
+    }
+
+    /// Ticks whose deadline had already passed when the loop got to them
+    pub fn tick_overruns(&self) -> u64 {
+        self.pacer.overruns()
+    }
+
     // ============================================================================
     // Convenience Constructors (thin wrappers for common patterns)
     // ============================================================================
@@ -589,15 +743,22 @@ impl Scheduler {
             logging_enabled,
             initialized: false,
             context: Some(context),
-            rate_hz: None,   // Use global scheduler rate by default
-            last_tick: None, // Will be set on first tick
+            rate_hz: None, // Use global scheduler rate by default
             circuit_breaker: CircuitBreaker::new(5, 3, 5000), // 5 failures to open, 3 successes to close, 5s timeout
             is_rt_node,
             wcet_budget,
             deadline,
             is_jit_compiled,
             jit_stats: jit_compiled, // JIT-compiled dataflow (if available)
+            event_trigger: None,     // Periodic by default
+            fusion: None,
+            metrics: self.node_metrics.then(|| metrics::node_metrics(&node_name)),
+            count_hw: self.hardware_counters,
+            alloc_policy: self.alloc_policy,
+            allocs: AllocSample::default(),
+            alloc_violations: 0,
         });
+        self.plan = None;
 
         println!(
             "Added {} '{}' with priority {} (logging: {})",
@@ -643,14 +804,21 @@ impl Scheduler {
             initialized: false,
             context: Some(context),
             rate_hz: None,
-            last_tick: None,
             circuit_breaker: CircuitBreaker::new(5, 3, 5000),
             is_rt_node: true,
             wcet_budget: Some(wcet_budget),
             deadline: Some(deadline),
             is_jit_compiled: false, // RT nodes typically don't use JIT
             jit_stats: None,
+            event_trigger: None,
+            fusion: None,
+            metrics: self.node_metrics.then(|| metrics::node_metrics(&node_name)),
+            count_hw: self.hardware_counters,
+            alloc_policy: self.alloc_policy,
+            allocs: AllocSample::default(),
+            alloc_violations: 0,
         });
+        self.plan = None;
 
         println!(
             "Added RT node '{}' with priority {} (WCET: {:?}, deadline: {:?})",
@@ -704,6 +872,8 @@ impl Scheduler {
     ///
     /// Allows individual nodes to run at different frequencies independent of the global scheduler rate.
     /// If a node's rate is not set, it will tick at the global scheduler frequency.
+    /// Nodes with the same rate form a rate group that ticks on shared absolute
+    /// deadlines, so harmonic rates (e.g. 1 kHz / 100 Hz / 10 Hz) stay phase-aligned.
     ///
     /// # Arguments
     /// * `name` - The name of the node
@@ -718,7 +888,7 @@ impl Scheduler {
         for registered in self.nodes.iter_mut() {
             if registered.node.name() == name {
                 registered.rate_hz = Some(rate_hz);
-                registered.last_tick = Some(Instant::now());
+                self.plan = None;
                 println!("Set node '{}' rate to {:.1} Hz", name, rate_hz);
                 break;
             }
@@ -726,6 +896,69 @@ impl Scheduler {
         self
     }
 
+    /// Make a node event-driven (chainable)
+    ///
+    /// An event-driven node ticks only when a topic it subscribes to has
+    /// published since its last tick, instead of on every scheduler tick.
+    /// Between ticks the scheduler parks on the topics' shared futex words,
+    /// so nodes like an emergency stop or collision detector wake within
+    /// microseconds of a publish, and a scheduler whose nodes are all
+    /// event-driven uses almost no CPU while idle.
+    ///
+    /// Subscriptions are taken from `Node::get_subscribers()` and from the
+    /// topics the node receives on with its `NodeInfo`. The node always ticks
+    /// once so those can be discovered.
+    ///
+    /// # Example
+    /// ```ignore
+    /// scheduler.add(estop, 0, Some(true))
+    ///     .set_node_event_driven("emergency_stop", true);
+    /// ```
+    pub fn set_node_event_driven(&mut self, name: &str, enabled: bool) -> &mut Self {
+        for registered in self.nodes.iter_mut() {
+            if registered.node.name() == name {
+                if enabled {
+                    let mut trigger = EventTrigger::new();
+                    let declared = registered.node.get_subscribers();
+                    trigger.watch(declared.iter().map(|t| t.topic_name.as_str()));
+                    registered.event_trigger = Some(trigger);
+                } else {
+                    registered.event_trigger = None;
+                }
+                println!(
+                    "Set node '{}' to {}",
+                    name,
+                    if enabled { "event-driven" } else { "periodic" }
+                );
+                break;
+            }
+        }
+        self
+    }
+
+    /// Allow a chain of dataflow nodes to be fused into one JIT kernel
+    ///
+    /// `nodes` lists the chain in publish order: each node's single output
+    /// topic must be the next one's only input. Once learning completes, the
+    /// head runs the fused kernel for the whole chain, inner nodes stop
+    /// ticking and the tail publishes the result. The intermediate topics are
+    /// then no longer published, so nothing else (another process, the
+    /// monitor, the dashboard) can watch them; that is why fusion is opt-in.
+    /// Without it each dataflow node still runs its own native kernel and
+    /// publishes as usual.
+    ///
+    /// # Example
+    /// ```ignore
+    /// scheduler.fuse_dataflow_chain(&["scale", "pid", "drive"]);
+    /// ```
+    pub fn fuse_dataflow_chain(&mut self, nodes: &[&str]) -> &mut Self {
+        if nodes.len() > 1 {
+            self.fused_chains
+                .push(nodes.iter().map(|n| n.to_string()).collect());
+        }
+        self
+    }
+
     /// Main loop with automatic signal handling and cleanup
     pub fn run(&mut self) -> HorusResult<()> {
         self.run_with_filter(None, None)
@@ -822,6 +1055,9 @@ impl Scheduler {
 
             // Build dependency graph from node pub/sub relationships
             self.build_dependency_graph();
+            self.plan = None;
+            self.pacer.reset();
+            self.periodic_due = true;
 
             // Main tick loop
             while self.is_running() {
@@ -933,7 +1169,7 @@ impl Scheduler {
                     if monitor.is_emergency_stop() {
                         eprintln!(" Emergency stop activated - shutting down scheduler");
                         // Record to blackbox
-                        if let Some(ref mut bb) = self.blackbox {
+                        if let Some(ref bb) = self.blackbox {
                             bb.record(super::blackbox::BlackBoxEvent::EmergencyStop {
                                 reason: "Safety monitor triggered emergency stop".to_string(),
                             });
@@ -992,7 +1228,7 @@ impl Scheduler {
                 // === Runtime feature integrations ===
 
                 // Black box tick increment
-                if let Some(ref mut bb) = self.blackbox {
+                if let Some(ref bb) = self.blackbox {
                     bb.tick();
                 }
 
@@ -1010,6 +1246,10 @@ impl Scheduler {
                         tm.counter("scheduler_ticks", total_ticks);
                         tm.gauge("scheduler_uptime_secs", start_time.elapsed().as_secs_f64());
                         tm.gauge("nodes_active", self.nodes.len() as f64);
+                        let jitter = self.pacer.jitter().stats();
+                        tm.gauge("tick_jitter_p99_us", jitter.p99.as_nanos() as f64 / 1e3);
+                        tm.gauge("tick_jitter_max_us", jitter.max.as_nanos() as f64 / 1e3);
+                        tm.counter("tick_overruns", self.pacer.overruns());
 
                         // Record node stats from profiler
                         for registered in &self.nodes {
@@ -1057,8 +1297,10 @@ impl Scheduler {
 
                         // Create checkpoint
                         if let Some(mut checkpoint) = cm.create_checkpoint(metadata) {
-                            // Add node states
-                            for registered in &self.nodes {
+                            // Add node states; only changed custom state is
+                            // handed over, as copy-on-write snapshots
+                            let mut states = Vec::new();
+                            for registered in &mut self.nodes {
                                 let node_name = registered.node.name();
                                 let (tick_count, last_tick_us, error_count) = self
                                     .profiler
@@ -1078,17 +1320,28 @@ impl Scheduler {
                                 checkpoint
                                     .node_states
                                     .insert(node_name.to_string(), node_checkpoint);
+
+                                if let Some(state) = registered.node.checkpoint_state() {
+                                    states.push((node_name.to_string(), state));
+                                }
                             }
 
-                            if let Err(e) = cm.save_checkpoint(&checkpoint) {
+                            // Serialized and written by the background writer
+                            if let Err(e) = cm.submit(checkpoint, states) {
                                 eprintln!("[CHECKPOINT] Failed to save: {}", e);
                             }
                         }
                     }
                 }
 
-                // Use pre-computed tick period (from config or default ~60Hz)
-                tokio::time::sleep(self.tick_period).await;
+                // Sleep to the next absolute tick deadline (from config or default
+                // ~60Hz), or park on subscribed topics when event-driven nodes are present
+                if self.nodes.iter().any(|r| r.event_trigger.is_some()) {
+                    self.periodic_due = self.park_until_next_tick(node_filter);
+                } else {
+                    self.pacer.wait();
+                    self.periodic_due = true;
+                }
             }
 
             // Shutdown async I/O nodes first
@@ -1126,7 +1379,7 @@ impl Scheduler {
                 .unwrap_or(0) as u64;
 
             // Record scheduler stop to blackbox and save
-            if let Some(ref mut bb) = self.blackbox {
+            if let Some(ref bb) = self.blackbox {
                 bb.record(super::blackbox::BlackBoxEvent::SchedulerStop {
                     reason: "Normal shutdown".to_string(),
                     total_ticks,
@@ -1143,6 +1396,14 @@ impl Scheduler {
                 let _ = tm.export();
             }
 
+            if self.pacer.jitter().count() > 0 {
+                println!(
+                    "Tick jitter: {} ({} overruns)",
+                    self.pacer.jitter().stats(),
+                    self.pacer.overruns()
+                );
+            }
+
             // Clean up registry file and session (keep heartbeats for dashboards)
             self.cleanup_registry();
             // Note: Don't cleanup_heartbeats() - let dashboards see final state
@@ -1417,6 +1678,62 @@ impl Scheduler {
         }
     }
 
+    /// Wait for the next tick when event-driven nodes are registered
+    ///
+    /// Parks on the subscribed topics' futex words until the pacer's next
+    /// deadline, or for `EVENT_IDLE_PARK` if every running node is
+    /// event-driven. Returns false as soon as an event-driven node has input
+    /// before the deadline: that iteration runs only the triggered nodes, so
+    /// periodic nodes keep their own rate however busy the topics are.
+    /// Returns true once the deadline is reached.
+    fn park_until_next_tick(&mut self, node_filter: Option<&[&str]>) -> bool {
+        // Pick up subscriptions the nodes registered while ticking
+        for registered in self.nodes.iter_mut() {
+            if let (Some(trigger), Some(ctx)) = (
+                registered.event_trigger.as_mut(),
+                registered.context.as_ref(),
+            ) {
+                if ctx.registered_subscriber_count() > trigger.known_topics() {
+                    let topics = ctx.get_registered_subscribers();
+                    trigger.watch(topics.iter().map(|t| t.topic_name.as_str()));
+                } else {
+                    trigger.retry_pending();
+                }
+            }
+        }
+
+        let running = || {
+            self.nodes
+                .iter()
+                .filter(|r| r.initialized && node_filter.is_none_or(|f| f.contains(&r.node.name())))
+        };
+        let triggers = || running().filter_map(|r| r.event_trigger.as_ref());
+
+        if running().all(|r| r.event_trigger.is_some()) {
+            if !triggers().any(|t| t.is_pending()) {
+                EventTrigger::wait_any(triggers(), EVENT_IDLE_PARK);
+            }
+            return true;
+        }
+
+        self.pacer.anchor();
+        loop {
+            // The deadline wins over pending input, so a topic that is never
+            // quiet cannot starve the periodic nodes
+            let remaining = self.pacer.remaining();
+            if remaining <= EVENT_PARK_MARGIN {
+                break;
+            }
+            if triggers().any(|t| t.is_pending()) {
+                return false;
+            }
+            // A wake only ends the park if it left a trigger pending
+            EventTrigger::wait_any(triggers(), remaining - EVENT_PARK_MARGIN);
+        }
+        self.pacer.wait();
+        true
+    }
+
     /// Build dependency graph from node pub/sub relationships
     fn build_dependency_graph(&mut self) {
         let node_data: Vec<(&str, Vec<String>, Vec<String>)> = self
@@ -1446,34 +1763,58 @@ impl Scheduler {
         }
     }
 
+    /// Take the compiled execution plan, compiling it if nodes or rates changed
+    ///
+    /// Compiling sorts the nodes by priority, so plan indices stay valid
+    /// until the next `add`, `set_node_rate` or tier migration.
+    fn take_plan(&mut self, node_filter: Option<&[&str]>) -> ExecutionPlan {
+        if let Some(plan) = self.plan.take() {
+            return plan;
+        }
+
+        self.nodes.sort_by_key(|r| r.priority);
+        let nodes: Vec<PlanNode<'_>> = self
+            .nodes
+            .iter()
+            .map(|r| PlanNode {
+                name: r.node.name(),
+                rate_hz: r.rate_hz,
+                filtered_out: node_filter.is_some_and(|f| !f.contains(&r.node.name()))
+                    || matches!(r.fusion, Some(FusedRole::Inner)),
+            })
+            .collect();
+        let levels = self
+            .dependency_graph
+            .as_ref()
+            .map_or(&[][..], |g| g.levels.as_slice());
+        ExecutionPlan::compile(
+            &nodes,
+            levels,
+            self.tick_period.as_nanos() as u64,
+            monotonic_ns(),
+        )
+    }
+
     /// Execute nodes in learning mode (sequential with profiling)
     async fn execute_learning_mode(&mut self, node_filter: Option<&[&str]>) {
-        // Sort by priority
-        self.nodes.sort_by_key(|r| r.priority);
+        let mut plan = self.take_plan(node_filter);
+        // Rate groups only advance on periodic ticks, so an event-only wake
+        // cannot use up a rate-limited node's deadline
+        if self.periodic_due {
+            plan.begin_tick(monotonic_ns());
+        }
 
-        // We need to process nodes one at a time to avoid borrow checker issues
-        let num_nodes = self.nodes.len();
-        for i in 0..num_nodes {
-            let (should_run, node_name, should_tick) = {
+        // Nodes in priority order; filtered-out nodes are not in the plan
+        for &i in plan.sequence() {
+            let (node_name, should_tick) = {
                 let registered = &self.nodes[i];
-                let node_name = registered.node.name();
-                let should_run = node_filter.is_none_or(|filter| filter.contains(&node_name));
-
-                // Check rate limiting
-                let should_tick = if let Some(rate_hz) = registered.rate_hz {
-                    let current_time = Instant::now();
-                    if let Some(last_tick) = registered.last_tick {
-                        let elapsed_secs = (current_time - last_tick).as_secs_f64();
-                        let period_secs = 1.0 / rate_hz;
-                        elapsed_secs >= period_secs
-                    } else {
-                        true
-                    }
-                } else {
-                    true
-                };
-
-                (should_run, node_name, should_tick)
+                let should_tick = plan.is_due(i)
+                    && (self.periodic_due || registered.event_trigger.is_some())
+                    && registered
+                        .event_trigger
+                        .as_ref()
+                        .is_none_or(|t| t.is_pending());
+                (registered.node.name(), should_tick)
             };
 
             if !should_tick {
@@ -1486,12 +1827,11 @@ impl Scheduler {
                 continue;
             }
 
-            // Update last tick time if rate limited
-            if self.nodes[i].rate_hz.is_some() {
-                self.nodes[i].last_tick = Some(Instant::now());
+            if let Some(ref mut trigger) = self.nodes[i].event_trigger {
+                trigger.begin_tick();
             }
 
-            if should_run && self.nodes[i].initialized {
+            if self.nodes[i].initialized {
                 // Feed watchdog for RT nodes
                 if self.nodes[i].is_rt_node {
                     if let Some(ref monitor) = self.safety_monitor {
@@ -1613,6 +1953,8 @@ impl Scheduler {
                 }
             }
         }
+
+        self.plan = Some(plan);
     }
 
     /// Execute nodes in optimized mode (parallel execution based on dependency graph)
@@ -1623,108 +1965,164 @@ impl Scheduler {
             return;
         }
 
-        // Trigger async I/O nodes
+        // Trigger async I/O nodes (periodic, so not on event-only wakes)
         if let Some(ref executor) = self.async_io_executor {
-            executor.tick_all().await;
+            if self.periodic_due {
+                executor.tick_all().await;
+            }
         }
 
+        let mut plan = self.take_plan(node_filter);
+        // Rate groups only advance on periodic ticks, so an event-only wake
+        // cannot use up a rate-limited node's deadline
+        if self.periodic_due {
+            plan.begin_tick(monotonic_ns());
+        }
+        let mut level_indices = std::mem::take(&mut self.level_scratch);
+
         // Execute nodes level by level (nodes in same level can run in parallel)
-        let levels = self
-            .dependency_graph
-            .as_ref()
-            .expect("Dependency graph should exist - checked above")
-            .levels
-            .clone();
-
-        for level in &levels {
-            // Find indices of nodes in this level that should run
-            let mut level_indices = Vec::new();
-
-            for node_name in level {
-                for (idx, registered) in self.nodes.iter().enumerate() {
-                    if registered.node.name() == node_name {
-                        let should_run =
-                            node_filter.is_none_or(|filter| filter.contains(&node_name.as_str()));
-
-                        // Check rate limiting
-                        let should_tick = if let Some(rate_hz) = registered.rate_hz {
-                            let current_time = Instant::now();
-                            if let Some(last_tick) = registered.last_tick {
-                                let elapsed_secs = (current_time - last_tick).as_secs_f64();
-                                let period_secs = 1.0 / rate_hz;
-                                elapsed_secs >= period_secs
-                            } else {
-                                true
-                            }
-                        } else {
-                            true
-                        };
+        for (level_idx, level) in plan.levels().iter().enumerate() {
+            // Indices of nodes in this level that should run, ascending
+            level_indices.clear();
+            level_indices.extend(level.iter().copied().filter(|&idx| {
+                let registered = &self.nodes[idx];
+                plan.is_due(idx)
+                    && (self.periodic_due || registered.event_trigger.is_some())
+                    && registered.initialized
+                    && registered
+                        .event_trigger
+                        .as_ref()
+                        .is_none_or(|t| t.is_pending())
+            }));
+
+            if level_indices.is_empty() {
+                continue;
+            }
 
-                        if should_run && registered.initialized && should_tick {
-                            level_indices.push(idx);
-                        }
-                        break;
+            if level_indices.len() > 1 && self.parallel_executor.is_parallel() {
+                // Nodes in the same level have no pub/sub edges between them, so
+                // each one is handed to its own worker. run_level() returns only
+                // after every node in the level has finished (per-level barrier).
+                let mut level_nodes: Vec<&mut RegisteredNode> = self
+                    .nodes
+                    .iter_mut()
+                    .enumerate()
+                    .filter(|(idx, _)| level_indices.binary_search(idx).is_ok())
+                    .map(|(_, registered)| registered)
+                    .collect();
+
+                let safety_monitor = self.safety_monitor.as_ref();
+                let outcomes = self.parallel_executor.run_level(
+                    level_idx,
+                    &mut level_nodes,
+                    |registered| Self::tick_registered_node(registered, safety_monitor),
+                    |outcome| outcome.as_ref().map_or(Duration::ZERO, |o| o.duration),
+                );
+                drop(level_nodes);
+
+                for (idx, outcome) in level_indices.iter().copied().zip(outcomes) {
+                    if let Some(outcome) = outcome {
+                        self.record_tick_outcome(idx, outcome);
                     }
                 }
-            }
-
-            // Execute nodes in this level
-            // NOTE: True parallel execution requires refactoring to allow concurrent
-            // mutable access to different Vec elements. Options:
-            // 1. Use UnsafeCell/RwLock per node (adds overhead)
-            // 2. Restructure nodes into separate Vecs (breaks encapsulation)
-            // 3. Use async/await with message passing (architectural change)
-            //
-            // For now, execute level-by-level sequentially. Since levels are already
-            // topologically sorted, this ensures correctness. Parallelism benefit
-            // would only apply within levels with multiple independent nodes.
-            //
-            // Performance: Still better than original sequential-by-priority because:
-            // - Respects true dependencies (not just priority)
-            // - Enables future parallelization without API changes
-            // - Critical path optimization from dependency analysis
-            for idx in level_indices {
-                self.execute_single_node(idx);
+            } else {
+                let level_start = Instant::now();
+                let mut node_time = Duration::ZERO;
+                let node_count = level_indices.len();
+                for &idx in &level_indices {
+                    node_time += self.execute_single_node(idx);
+                }
+                self.parallel_executor.record_sequential_level(
+                    level_idx,
+                    node_count,
+                    level_start.elapsed(),
+                    node_time,
+                );
             }
         }
 
+        self.level_scratch = level_indices;
+        self.plan = Some(plan);
+
         // Process any async I/O results
         self.process_async_results().await;
     }
 
     /// Execute a single node by index with RT support
-    fn execute_single_node(&mut self, idx: usize) {
+    ///
+    /// Returns the time the node spent ticking (zero if it was skipped).
+    fn execute_single_node(&mut self, idx: usize) -> Duration {
+        let outcome =
+            Self::tick_registered_node(&mut self.nodes[idx], self.safety_monitor.as_ref());
+        match outcome {
+            Some(outcome) => {
+                let duration = outcome.duration;
+                self.record_tick_outcome(idx, outcome);
+                duration
+            }
+            None => Duration::ZERO,
+        }
+    }
+
+    /// Tick one node: circuit breaker, rate limiting, RT checks and error handling
+    ///
+    /// Only touches the node's own registration (plus the thread-safe safety
+    /// monitor), so nodes of the same dependency level can be ticked from
+    /// different worker threads. Scheduler-wide bookkeeping is done afterwards
+    /// by `record_tick_outcome` on the scheduler thread.
+    fn tick_registered_node(
+        registered: &mut RegisteredNode,
+        safety_monitor: Option<&SafetyMonitor>,
+    ) -> Option<NodeTickOutcome> {
+        // Inner nodes of a fused chain run inside the head's kernel
+        if matches!(registered.fusion, Some(FusedRole::Inner)) {
+            return None;
+        }
+
         // Check circuit breaker first
-        if !self.nodes[idx].circuit_breaker.should_allow() {
+        if !registered.circuit_breaker.should_allow() {
             // Circuit is open, skip this node
-            return;
+            return None;
         }
 
-        // Update rate limit timestamp
-        if self.nodes[idx].rate_hz.is_some() {
-            self.nodes[idx].last_tick = Some(Instant::now());
+        if let Some(ref mut trigger) = registered.event_trigger {
+            trigger.begin_tick();
         }
 
-        let node_name = self.nodes[idx].node.name();
-        let is_rt_node = self.nodes[idx].is_rt_node;
-        let wcet_budget = self.nodes[idx].wcet_budget;
-        let deadline = self.nodes[idx].deadline;
+        let node_name = registered.node.name();
+        let is_rt_node = registered.is_rt_node;
+        let wcet_budget = registered.wcet_budget;
+        let deadline = registered.deadline;
 
         // Feed watchdog for RT nodes
         if is_rt_node {
-            if let Some(ref monitor) = self.safety_monitor {
+            if let Some(monitor) = safety_monitor {
                 monitor.feed_watchdog(node_name);
             }
         }
 
+        let counters_before = registered.count_hw.then(perf::read_thread_counters);
+        let allocs_before = registered
+            .alloc_policy
+            .is_some()
+            .then(alloc::read_thread_allocs);
         let tick_start = Instant::now();
 
         // Check if this node should use JIT execution path
-        let use_jit_path = self.nodes[idx].is_jit_compiled && self.nodes[idx].jit_stats.is_some();
+        let use_jit_path = registered.is_jit_compiled && registered.jit_stats.is_some();
 
-        let (tick_result, jit_executed) = if use_jit_path {
+        let (tick_result, jit_executed) = if let Some(ref mut role) = registered.fusion {
+            // FUSED DATAFLOW PATH: read inputs / run kernel / write outputs
+            if let Some(ref mut context) = registered.context {
+                context.start_tick();
+            } else {
+                return None;
+            }
+            let node = registered.node.as_mut();
+            let result = std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| role.tick(node)));
+            (result, true)
+        } else if use_jit_path {
             // JIT EXECUTION PATH: Use compiled native code for ultra-fast execution
-            let registered = &mut self.nodes[idx];
             if let Some(ref mut context) = registered.context {
                 context.start_tick();
             }
@@ -1755,13 +2153,12 @@ impl Scheduler {
                         registered.node.tick(Some(context));
                     }))
                 } else {
-                    return;
+                    return None;
                 };
                 (tick_res, false)
             }
         } else {
             // REGULAR EXECUTION PATH: Standard node tick
-            let registered = &mut self.nodes[idx];
             if let Some(ref mut context) = registered.context {
                 context.start_tick();
 
@@ -1777,25 +2174,54 @@ impl Scheduler {
                 }));
                 (result, false)
             } else {
-                return;
+                return None;
             }
         };
 
         let tick_duration = tick_start.elapsed();
+        let allocs = allocs_before.map(|before| alloc::read_thread_allocs().since(&before));
+
+        if let Some(ref m) = registered.metrics {
+            m.tick.record(tick_duration);
+            if let Some(before) = counters_before {
+                m.add_counters(&perf::read_thread_counters().since(&before));
+            }
+            if let Some(ref allocs) = allocs {
+                m.add_allocs(allocs);
+            }
+        }
+
+        // Enforce allocation-free ticks for RT nodes
+        let mut tick_result = tick_result;
+        if let Some(allocs) = allocs {
+            registered.allocs.add(&allocs);
+            if is_rt_node && allocs.any() && tick_result.is_ok() {
+                registered.alloc_violations += 1;
+                let message = format!(
+                    "Heap allocation in RT tick: {} allocations ({} bytes), {} frees",
+                    allocs.allocations, allocs.bytes, allocs.frees
+                );
+                match registered.alloc_policy {
+                    Some(RtAllocPolicy::Fail) => tick_result = Err(Box::new(message)),
+                    // Log-spaced so a node allocating every tick does not flood stderr
+                    _ if registered.alloc_violations.is_power_of_two() => eprintln!(
+                        " {} in {} (seen {} times)",
+                        message, node_name, registered.alloc_violations
+                    ),
+                    _ => {}
+                }
+            }
+        }
+        let failed = tick_result.is_err();
 
         // Check if node execution failed
-        if tick_result.is_err() {
-            // Record failure for Isolated tier classification
-            self.profiler.record_node_failure(node_name);
+        if failed {
             eprintln!("Node '{}' panicked during execution", node_name);
         }
 
-        self.profiler.record(node_name, tick_duration);
-
         // Update JIT compilation statistics if this is a JIT-compiled node
-        if self.nodes[idx].is_jit_compiled {
-            // Update JIT execution statistics
-            if let Some(ref mut jit_stats) = self.nodes[idx].jit_stats {
+        if registered.is_jit_compiled {
+            if let Some(ref mut jit_stats) = registered.jit_stats {
                 // Stats are already updated by execute() call if JIT path was used
                 if !jit_executed {
                     // Only update manually if we didn't use JIT path
@@ -1817,17 +2243,11 @@ impl Scheduler {
                     );
                 }
             }
-
-            // Also update in the global JIT map
-            if let Some(compiled) = self.jit_compiled_nodes.get_mut(node_name) {
-                compiled.exec_count += 1;
-                compiled.total_ns += tick_duration.as_nanos() as u64;
-            }
         }
 
         // Check WCET budget for RT nodes
         if is_rt_node && wcet_budget.is_some() {
-            if let Some(ref monitor) = self.safety_monitor {
+            if let Some(monitor) = safety_monitor {
                 if let Err(violation) = monitor.check_wcet(node_name, tick_duration) {
                     eprintln!(
                         " WCET violation in {}: {:?} > {:?}",
@@ -1842,7 +2262,7 @@ impl Scheduler {
             if let Some(deadline_duration) = deadline {
                 let elapsed = tick_start.elapsed();
                 if elapsed > deadline_duration {
-                    if let Some(ref monitor) = self.safety_monitor {
+                    if let Some(monitor) = safety_monitor {
                         monitor.record_deadline_miss(node_name);
                         eprintln!(
                             " Deadline miss in {}: {:?} > {:?}",
@@ -1856,15 +2276,15 @@ impl Scheduler {
         match tick_result {
             Ok(_) => {
                 // Record success with circuit breaker
-                self.nodes[idx].circuit_breaker.record_success();
+                registered.circuit_breaker.record_success();
 
-                if let Some(ref mut context) = self.nodes[idx].context {
+                if let Some(ref mut context) = registered.context {
                     context.record_tick(); // Node writes its own heartbeat
                 }
             }
             Err(panic_err) => {
                 // Record failure with circuit breaker
-                self.nodes[idx].circuit_breaker.record_failure();
+                registered.circuit_breaker.record_failure();
                 let error_msg = if let Some(s) = panic_err.downcast_ref::<&str>() {
                     format!("Node panicked: {}", s)
                 } else if let Some(s) = panic_err.downcast_ref::<String>() {
@@ -1873,7 +2293,6 @@ impl Scheduler {
                     "Node panicked with unknown error".to_string()
                 };
 
-                let registered = &mut self.nodes[idx];
                 if let Some(ref mut context) = registered.context {
                     context.record_tick_failure(error_msg.clone()); // Node writes its own heartbeat
                     eprintln!(" {} failed: {}", node_name, error_msg);
@@ -1907,6 +2326,43 @@ impl Scheduler {
                 }
             }
         }
+
+        // Release the node's per-tick scratch memory
+        if let Some(ref mut context) = registered.context {
+            context.reset_arena();
+        }
+
+        Some(NodeTickOutcome {
+            duration: tick_duration,
+            failed,
+        })
+    }
+
+    /// Scheduler-wide bookkeeping for a node tick (profiler, global JIT map)
+    fn record_tick_outcome(&mut self, idx: usize, outcome: NodeTickOutcome) {
+        let node_name = self.nodes[idx].node.name();
+
+        if outcome.failed {
+            // Record failure for Isolated tier classification
+            self.profiler.record_node_failure(node_name);
+        }
+
+        self.profiler.record(node_name, outcome.duration);
+
+        if self.nodes[idx].is_jit_compiled {
+            if let Some(compiled) = self.jit_compiled_nodes.get_mut(node_name) {
+                compiled.exec_count += 1;
+                compiled.total_ns += outcome.duration.as_nanos() as u64;
+            }
+        }
+    }
+
+    /// Per-level makespan metrics from optimized execution, indexed by dependency level
+    ///
+    /// `LevelMetrics::speedup()` compares summed node time to wall-clock time,
+    /// showing how much levels benefit from parallel execution.
+    pub fn level_metrics(&self) -> Vec<LevelMetrics> {
+        self.parallel_executor.level_metrics().to_vec()
     }
 
     /// Setup JIT compiler for ultra-fast nodes
@@ -2000,6 +2456,131 @@ impl Scheduler {
                 );
             }
         }
+
+        self.setup_dataflow_fusion();
+    }
+
+    /// Compile dataflow nodes of the ultra-fast tier, fusing opted-in chains
+    ///
+    /// Each chain registered with `fuse_dataflow_chain` becomes one Cranelift
+    /// kernel run by its head node, so the inner nodes' scheduling and Hub
+    /// round-trips disappear. Other dataflow nodes get a kernel of their own.
+    /// Nodes that are RT, event-driven or not classified ultra-fast keep
+    /// ticking normally.
+    fn setup_dataflow_fusion(&mut self) {
+        let Some(ref classifier) = self.classifier else {
+            return;
+        };
+
+        let graphs: Vec<Option<DataflowGraph>> = self
+            .nodes
+            .iter()
+            .map(|r| {
+                let eligible = classifier.get_tier(r.node.name()) == Some(ExecutionTier::UltraFast)
+                    && !r.is_rt_node
+                    && r.event_trigger.is_none()
+                    && r.fusion.is_none();
+                if eligible {
+                    r.node.get_jit_dataflow()
+                } else {
+                    None
+                }
+            })
+            .collect();
+        if graphs.iter().all(Option::is_none) {
+            return;
+        }
+
+        let topics: Vec<(Vec<String>, Vec<String>)> = self
+            .nodes
+            .iter()
+            .map(|r| {
+                let names = |t: Vec<crate::core::TopicMetadata>| {
+                    t.into_iter().map(|m| m.topic_name).collect::<Vec<_>>()
+                };
+                (
+                    names(r.node.get_publishers()),
+                    names(r.node.get_subscribers()),
+                )
+            })
+            .collect();
+        let candidates: Vec<FusionCandidate<'_>> = self
+            .nodes
+            .iter()
+            .zip(&graphs)
+            .zip(&topics)
+            .map(|((r, graph), (pubs, subs))| FusionCandidate {
+                publishes: pubs.iter().map(String::as_str).collect(),
+                subscribes: subs.iter().map(String::as_str).collect(),
+                arity: graph.as_ref().map(|g| (g.num_inputs(), g.num_outputs())),
+                rate_hz: r.rate_hz,
+            })
+            .collect();
+        let node_names: Vec<&str> = self.nodes.iter().map(|r| r.node.name()).collect();
+        let chains = find_chains(&candidates, |i, j| {
+            self.fused_chains.iter().any(|chain| {
+                chain
+                    .windows(2)
+                    .any(|w| w[0] == node_names[i] && w[1] == node_names[j])
+            })
+        });
+        drop(candidates);
+        drop(node_names);
+
+        for chain in chains {
+            let stages: Vec<&DataflowGraph> =
+                chain.iter().filter_map(|&i| graphs[i].as_ref()).collect();
+            let names: Vec<&str> = chain.iter().map(|&i| self.nodes[i].node.name()).collect();
+            let fused = match DataflowGraph::fuse(&stages) {
+                Ok(fused) => fused,
+                Err(e) => {
+                    eprintln!("[JIT] Cannot fuse {}: {}", names.join(" -> "), e);
+                    continue;
+                }
+            };
+
+            let num_inputs = fused.num_inputs();
+            let num_outputs = fused.num_outputs();
+            let kernel = DataflowKernel::compile(&names.join("+"), fused);
+            println!(
+                "[JIT] Dataflow kernel {} ({} -> {} values, {})",
+                names.join(" -> "),
+                num_inputs,
+                num_outputs,
+                if kernel.is_native() {
+                    "native"
+                } else {
+                    "interpreted"
+                }
+            );
+
+            let (&head, rest) = chain.split_first().expect("chains are never empty");
+            let Some((&tail, inner)) = rest.split_last() else {
+                self.nodes[head].fusion = Some(FusedRole::Solo {
+                    kernel,
+                    inputs: vec![0.0; num_inputs],
+                    outputs: vec![0.0; num_outputs],
+                });
+                continue;
+            };
+
+            let handoff = Arc::new(parking_lot::Mutex::new(FusedHandoff {
+                outputs: vec![0.0; num_outputs],
+                fresh: false,
+            }));
+            self.nodes[head].fusion = Some(FusedRole::Head {
+                kernel,
+                inputs: vec![0.0; num_inputs],
+                handoff: Arc::clone(&handoff),
+            });
+            for &i in inner {
+                self.nodes[i].fusion = Some(FusedRole::Inner);
+            }
+            self.nodes[tail].fusion = Some(FusedRole::Tail { handoff });
+        }
+
+        // Inner nodes drop out of the execution plan
+        self.plan = None;
     }
 
     /// Setup async executor and move I/O-heavy nodes to it
@@ -2035,6 +2616,7 @@ impl Scheduler {
             for idx in nodes_to_move.into_iter().rev() {
                 // Remove from main scheduler
                 let registered = self.nodes.swap_remove(idx);
+                self.plan = None;
                 let node_name = registered.node.name().to_string();
 
                 // Spawn in async executor
@@ -2195,6 +2777,13 @@ impl Scheduler {
             self.profiler.disable();
             println!("Profiling disabled");
         }
+        if config.monitoring.latency_histograms || config.monitoring.hardware_counters {
+            self.enable_node_metrics(config.monitoring.hardware_counters);
+            println!(
+                "Node latency histograms enabled (hardware counters: {})",
+                config.monitoring.hardware_counters && perf::hardware_counters_available()
+            );
+        }
 
         // Handle robot presets with preset-specific optimizations
         match config.preset {
@@ -2271,8 +2860,16 @@ impl Scheduler {
         // === Apply new runtime features ===
 
         // 1. Global tick rate enforcement
-        self.tick_period =
-            std::time::Duration::from_micros((1_000_000.0 / config.timing.global_rate_hz) as u64);
+        self.tick_period = Duration::from_secs_f64(1.0 / config.timing.global_rate_hz);
+        self.pacer.set_period(self.tick_period);
+        self.plan = None;
+        // Sub-millisecond jitter budgets need the busy-wait tail: a plain
+        // clock_nanosleep wakes 50-150us late on a stock kernel
+        if config.timing.max_jitter_us < 1000 {
+            self.pacer.set_spin(DEFAULT_SPIN_TAIL);
+        } else {
+            self.pacer.set_spin(Duration::ZERO);
+        }
 
         // 2. Checkpoint system
         if config.fault.checkpoint_interval_ms > 0 {
@@ -2290,7 +2887,7 @@ impl Scheduler {
 
         // 3. Black box flight recorder
         if config.monitoring.black_box_enabled && config.monitoring.black_box_size_mb > 0 {
-            let mut bb = super::blackbox::BlackBox::new(config.monitoring.black_box_size_mb);
+            let bb = super::blackbox::BlackBox::new(config.monitoring.black_box_size_mb);
             bb.record(super::blackbox::BlackBoxEvent::SchedulerStart {
                 name: self.scheduler_name.clone(),
                 node_count: self.nodes.len(),
@@ -4,12 +4,14 @@
 //! - Local file (JSON)
 //! - HTTP endpoint
 //! - UDP broadcast
+//! - Prometheus/OpenMetrics scrape endpoint (includes the lock-free
+//!   node/Hub latency histograms from `scheduling::metrics`)
 
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 use std::fs::{self, File};
-use std::io::Write;
-use std::net::UdpSocket;
+use std::io::{Read, Write};
+use std::net::{TcpListener, TcpStream, UdpSocket};
 use std::path::PathBuf;
 use std::sync::{Arc, Mutex};
 use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
@@ -50,6 +52,8 @@ pub enum TelemetryEndpoint {
     Udp(String),
     /// HTTP POST endpoint (e.g., "http://localhost:8080/metrics")
     Http(String),
+    /// Serve OpenMetrics text on `GET /metrics` (e.g., "0.0.0.0:9464")
+    OpenMetrics(String),
     /// Stdout (for debugging)
     Stdout,
     /// Disabled
@@ -67,6 +71,11 @@ impl TelemetryEndpoint {
             TelemetryEndpoint::LocalFile(PathBuf::from(s.trim_start_matches("file://")))
         } else if s.starts_with("udp://") {
             TelemetryEndpoint::Udp(s.trim_start_matches("udp://").to_string())
+        } else if let Some(addr) = s
+            .strip_prefix("prometheus://")
+            .or_else(|| s.strip_prefix("openmetrics://"))
+        {
+            TelemetryEndpoint::OpenMetrics(addr.to_string())
         } else if s.starts_with("http://") || s.starts_with("https://") {
             TelemetryEndpoint::Http(s.to_string())
         } else {
@@ -92,6 +101,10 @@ pub struct TelemetryManager {
     start_time: Instant,
     /// UDP socket (cached)
     udp_socket: Option<UdpSocket>,
+    /// Page served by the OpenMetrics endpoint, refreshed on export
+    openmetrics_page: Option<Arc<Mutex<String>>>,
+    /// Render buffer reused across exports
+    render_buf: String,
     /// Whether telemetry is enabled
     enabled: bool,
 }
@@ -107,6 +120,17 @@ impl TelemetryManager {
             None
         };
 
+        let openmetrics_page = match &endpoint {
+            TelemetryEndpoint::OpenMetrics(addr) => match serve_openmetrics(addr) {
+                Ok(page) => Some(page),
+                Err(e) => {
+                    eprintln!("[TELEMETRY] Cannot serve OpenMetrics on {}: {}", addr, e);
+                    None
+                }
+            },
+            _ => None,
+        };
+
         Self {
             endpoint,
             interval: Duration::from_millis(interval_ms),
@@ -115,6 +139,8 @@ impl TelemetryManager {
             scheduler_name: "horus".to_string(),
             start_time: Instant::now(),
             udp_socket,
+            openmetrics_page,
+            render_buf: String::new(),
             enabled,
         }
     }
@@ -174,6 +200,18 @@ impl TelemetryManager {
             return Ok(());
         }
 
+        if let TelemetryEndpoint::OpenMetrics(_) = self.endpoint {
+            // Render without building a snapshot; the page buffer is reused
+            self.render_openmetrics_page();
+            if let Some(ref page) = self.openmetrics_page {
+                let mut page = page.lock().map_err(|e| e.to_string())?;
+                page.clear();
+                page.push_str(&self.render_buf);
+            }
+            self.last_export = Instant::now();
+            return Ok(());
+        }
+
         let snapshot = TelemetrySnapshot {
             timestamp: SystemTime::now()
                 .duration_since(UNIX_EPOCH)
@@ -189,7 +227,7 @@ impl TelemetryManager {
             TelemetryEndpoint::Udp(addr) => self.export_to_udp(addr, &snapshot),
             TelemetryEndpoint::Http(url) => self.export_to_http(url, &snapshot),
             TelemetryEndpoint::Stdout => self.export_to_stdout(&snapshot),
-            TelemetryEndpoint::Disabled => Ok(()),
+            TelemetryEndpoint::OpenMetrics(_) | TelemetryEndpoint::Disabled => Ok(()),
         };
 
         self.last_export = Instant::now();
@@ -197,19 +235,67 @@ impl TelemetryManager {
     }
 
     /// Export to local file
+    ///
+    /// Compact JSON written to a sibling temp file and renamed over the
+    /// target, so readers never see a truncated snapshot.
     fn export_to_file(&self, path: &PathBuf, snapshot: &TelemetrySnapshot) -> Result<(), String> {
         if let Some(parent) = path.parent() {
             fs::create_dir_all(parent).map_err(|e| e.to_string())?;
         }
 
-        let json = serde_json::to_string_pretty(snapshot).map_err(|e| e.to_string())?;
-
-        let mut file = File::create(path).map_err(|e| e.to_string())?;
-        file.write_all(json.as_bytes()).map_err(|e| e.to_string())?;
+        let tmp_path = path.with_extension("json.tmp");
+        let file = File::create(&tmp_path).map_err(|e| e.to_string())?;
+        let mut writer = std::io::BufWriter::new(file);
+        serde_json::to_writer(&mut writer, snapshot).map_err(|e| e.to_string())?;
+        writer.flush().map_err(|e| e.to_string())?;
+        drop(writer);
+        fs::rename(&tmp_path, path).map_err(|e| e.to_string())?;
 
         Ok(())
     }
 
+    /// Render recorded metrics plus the latency registry as OpenMetrics text
+    fn render_openmetrics_page(&mut self) {
+        use std::fmt::Write as _;
+
+        let out = &mut self.render_buf;
+        out.clear();
+        let _ = writeln!(out, "# TYPE horus_uptime_seconds gauge");
+        let _ = writeln!(
+            out,
+            "horus_uptime_seconds{{scheduler=\"{}\"}} {}",
+            self.scheduler_name,
+            self.start_time.elapsed().as_secs_f64()
+        );
+        for metric in self.metrics.values() {
+            let (kind, suffix, value) = match metric.value {
+                MetricValue::Counter(v) => ("counter", "_total", v as f64),
+                MetricValue::Gauge(v) => ("gauge", "", v),
+                // No OpenMetrics equivalent for raw samples or text
+                MetricValue::Histogram(_) | MetricValue::Text(_) => continue,
+            };
+            let _ = writeln!(out, "# TYPE horus_{} {}", metric.name, kind);
+            let _ = write!(out, "horus_{}{}", metric.name, suffix);
+            for (i, (key, val)) in metric.labels.iter().enumerate() {
+                out.push(if i == 0 { '{' } else { ',' });
+                let _ = write!(out, "{}=\"", key);
+                for c in val.chars() {
+                    if matches!(c, '"' | '\\') {
+                        out.push('\\');
+                    }
+                    out.push(c);
+                }
+                out.push('"');
+            }
+            if !metric.labels.is_empty() {
+                out.push('}');
+            }
+            let _ = writeln!(out, " {}", value);
+        }
+        super::metrics::render_openmetrics(out);
+        out.push_str("# EOF\n");
+    }
+
     /// Export to UDP endpoint
     fn export_to_udp(&self, addr: &str, snapshot: &TelemetrySnapshot) -> Result<(), String> {
         if let Some(ref socket) = self.udp_socket {
@@ -331,6 +417,54 @@ impl Default for TelemetryManager {
     }
 }
 
+/// Serve the OpenMetrics page on `addr` from a background thread
+///
+/// Each scrape copies the latest page rendered by `export()`; the scheduler
+/// thread never blocks on the network.
+fn serve_openmetrics(addr: &str) -> std::io::Result<Arc<Mutex<String>>> {
+    let listener = TcpListener::bind(addr)?;
+    let page = Arc::new(Mutex::new(String::from("# EOF\n")));
+    let shared = Arc::clone(&page);
+    std::thread::Builder::new()
+        .name("horus-openmetrics".to_string())
+        .spawn(move || {
+            let mut body = String::new();
+            for stream in listener.incoming().flatten() {
+                if let Ok(page) = shared.lock() {
+                    body.clear();
+                    body.push_str(&page);
+                }
+                let _ = respond_openmetrics(stream, &body);
+            }
+        })?;
+    Ok(page)
+}
+
+fn respond_openmetrics(mut stream: TcpStream, body: &str) -> std::io::Result<()> {
+    stream.set_read_timeout(Some(Duration::from_secs(2)))?;
+    stream.set_write_timeout(Some(Duration::from_secs(2)))?;
+
+    // Any GET is answered with the metrics page; only the request line matters
+    let mut request = [0u8; 1024];
+    let n = stream.read(&mut request)?;
+    let status = if request[..n].starts_with(b"GET ") {
+        "200 OK"
+    } else {
+        "405 Method Not Allowed"
+    };
+    write!(
+        stream,
+        "HTTP/1.1 {}\r\n\
+         Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n\
+         Content-Length: {}\r\n\
+         Connection: close\r\n\
+         \r\n",
+        status,
+        body.len()
+    )?;
+    stream.write_all(body.as_bytes())
+}
+
 /// Thread-safe telemetry wrapper
 pub type SharedTelemetry = Arc<Mutex<TelemetryManager>>;
 
@@ -377,5 +511,32 @@ mod tests {
             TelemetryEndpoint::from_string("udp://127.0.0.1:9999"),
             TelemetryEndpoint::Udp(_)
         ));
+        assert!(matches!(
+            TelemetryEndpoint::from_string("prometheus://0.0.0.0:9464"),
+            TelemetryEndpoint::OpenMetrics(_)
+        ));
+    }
+
+    #[test]
+    fn test_openmetrics_scrape() {
+        let mut tm = TelemetryManager::new(
+            TelemetryEndpoint::OpenMetrics("127.0.0.1:0".to_string()),
+            100,
+        );
+        // Port 0 can't be scraped back; render the page directly instead
+        tm.counter("scheduler_ticks", 42);
+        tm.gauge("nodes_active", 3.0);
+        tm.export().unwrap();
+        let page = tm
+            .openmetrics_page
+            .as_ref()
+            .unwrap()
+            .lock()
+            .unwrap()
+            .clone();
+        assert!(page.contains("# TYPE horus_scheduler_ticks counter"));
+        assert!(page.contains("horus_scheduler_ticks_total 42"));
+        assert!(page.contains("horus_nodes_active 3"));
+        assert!(page.ends_with("# EOF\n"));
     }
 }
@@ -364,3 +364,387 @@ fn test_custom_struct() {
     let received = sub_hub.recv(&mut None).expect("Should receive struct");
     assert_eq!(received, data, "Struct should be received correctly");
 }
+
+#[test]
+fn test_recv_with_borrows_in_place() {
+    let topic = format!("test_recv_with_{}", std::process::id());
+
+    let pub_hub = Hub::<Vec<u8>>::new(&topic).expect("Failed to create publisher");
+    let sub_hub = Hub::<Vec<u8>>::new(&topic).expect("Failed to create subscriber");
+
+    pub_hub
+        .send(vec![7u8; 16], &mut None)
+        .expect("Failed to send");
+
+    let sum = sub_hub.recv_with(&mut None, |msg| msg.iter().map(|&b| b as u32).sum::<u32>());
+    assert_eq!(
+        sum,
+        Some(7 * 16),
+        "Closure should run on the received message"
+    );
+    assert_eq!(
+        sub_hub.recv_with(&mut None, |msg| msg.len()),
+        None,
+        "No message should be left"
+    );
+}
+
+#[test]
+fn test_recv_ref_sample_is_valid() {
+    let topic = format!("test_recv_ref_{}", std::process::id());
+
+    let pub_hub = Hub::<u64>::new_with_capacity(&topic, 8).expect("Failed to create publisher");
+    let sub_hub = Hub::<u64>::new_with_capacity(&topic, 8).expect("Failed to create subscriber");
+
+    pub_hub.send(1, &mut None).expect("Failed to send");
+
+    let sample = sub_hub
+        .recv_ref(&mut None)
+        .expect("Should receive a sample");
+    assert_eq!(*sample.get_ref(), 1);
+    assert!(sample.is_valid(), "Nothing was published since receive");
+
+    // Lap the ring so the borrowed slot gets overwritten
+    for i in 0..8 {
+        pub_hub.send(100 + i, &mut None).expect("Failed to send");
+    }
+    assert!(!sample.is_valid(), "Slot should be reported as overwritten");
+}
+
+#[test]
+fn test_recv_with_discards_lapped_sample() {
+    use horus_core::core::NodeInfo;
+
+    let topic = format!("test_recv_with_lapped_{}", std::process::id());
+
+    let pub_hub = Hub::<Vec<u8>>::new_with_capacity(&topic, 4).expect("Failed to create publisher");
+    let sub_hub =
+        Hub::<Vec<u8>>::new_with_capacity(&topic, 4).expect("Failed to create subscriber");
+    let mut info = NodeInfo::new("lapped_reader".to_string(), true);
+
+    pub_hub.send(vec![1; 8], &mut None).expect("Failed to send");
+    // The producer laps the reader while the handler runs
+    let result = sub_hub.recv_with(&mut Some(&mut info), |msg| {
+        for i in 0..4 {
+            pub_hub
+                .send(vec![i; 64], &mut None)
+                .expect("Failed to send");
+        }
+        msg.len()
+    });
+    assert_eq!(result, None, "Overwritten sample must be discarded");
+    let metrics = sub_hub.get_metrics();
+    assert_eq!(metrics.messages_received, 0, "Discarded, not delivered");
+    assert_eq!(metrics.recv_failures, 1);
+
+    // Intact samples are delivered, logged and counted once
+    assert_eq!(
+        sub_hub.recv_with(&mut Some(&mut info), |msg| msg.len()),
+        Some(64)
+    );
+    let sample = sub_hub
+        .recv_ref(&mut Some(&mut info))
+        .expect("Should receive a sample");
+    assert!(sample.is_valid());
+    let metrics = sub_hub.get_metrics();
+    assert_eq!(metrics.messages_received, 2);
+    assert_eq!(metrics.recv_failures, 1);
+}
+
+#[test]
+fn test_recv_all_into_drains_topic() {
+    let topic = format!("test_recv_all_{}", std::process::id());
+
+    let pub_hub = Hub::<i32>::new(&topic).expect("Failed to create publisher");
+    let sub_hub = Hub::<i32>::new(&topic).expect("Failed to create subscriber");
+
+    for i in 0..10 {
+        pub_hub.send(i, &mut None).expect("Failed to send");
+    }
+
+    let mut batch = Vec::new();
+    assert_eq!(sub_hub.recv_all_into(&mut batch, &mut None), 10);
+    assert_eq!(batch, (0..10).collect::<Vec<_>>());
+
+    // Buffer is appended to, and an empty topic appends nothing
+    assert_eq!(sub_hub.recv_all_into(&mut batch, &mut None), 0);
+    assert_eq!(batch.len(), 10);
+}
+
+#[test]
+fn test_backpressure_drop_newest_rejects_when_full() {
+    use horus_core::communication::BackpressurePolicy;
+
+    let topic = format!("test_bp_drop_newest_{}", std::process::id());
+
+    let pub_hub = Hub::<u32>::new_with_policy(&topic, 4, BackpressurePolicy::DropNewest)
+        .expect("Failed to create publisher");
+    let sub_hub = Hub::<u32>::new_with_capacity(&topic, 4).expect("Failed to create subscriber");
+
+    // First receive registers the subscriber's cursor
+    assert_eq!(sub_hub.recv(&mut None), None);
+
+    for i in 0..4 {
+        pub_hub.send(i, &mut None).expect("Ring has space");
+    }
+    assert_eq!(
+        pub_hub.send(99, &mut None),
+        Err(99),
+        "Fifth send must be rejected"
+    );
+
+    let metrics = pub_hub.get_metrics();
+    assert_eq!(metrics.messages_dropped, 1);
+    assert_eq!(metrics.subscribers.len(), 1);
+    assert_eq!(metrics.subscribers[0].lag, 4);
+
+    // Unread data is intact and consuming frees space again
+    assert_eq!(sub_hub.recv(&mut None), Some(0));
+    pub_hub
+        .send(4, &mut None)
+        .expect("Slot freed by subscriber");
+    let mut rest = Vec::new();
+    sub_hub.recv_all_into(&mut rest, &mut None);
+    assert_eq!(rest, vec![1, 2, 3, 4]);
+}
+
+#[test]
+fn test_backpressure_drop_oldest_counts_lapped_messages() {
+    let topic = format!("test_bp_drop_oldest_{}", std::process::id());
+
+    let pub_hub = Hub::<u32>::new_with_capacity(&topic, 4).expect("Failed to create publisher");
+    let sub_hub = Hub::<u32>::new_with_capacity(&topic, 4).expect("Failed to create subscriber");
+    assert_eq!(sub_hub.recv(&mut None), None);
+
+    for i in 0..10 {
+        pub_hub
+            .send(i, &mut None)
+            .expect("DropOldest never rejects");
+    }
+
+    // Subscriber skips to the oldest intact message
+    assert_eq!(sub_hub.recv(&mut None), Some(6));
+    let metrics = sub_hub.get_metrics();
+    assert_eq!(metrics.recv_dropped, 6);
+    assert_eq!(metrics.subscribers[0].dropped, 6);
+}
+
+#[test]
+fn test_backpressure_block_times_out() {
+    use horus_core::communication::BackpressurePolicy;
+    use std::time::{Duration, Instant};
+
+    let topic = format!("test_bp_block_{}", std::process::id());
+    let policy = BackpressurePolicy::Block {
+        timeout: Duration::from_millis(20),
+    };
+
+    let pub_hub = Hub::<u32>::new_with_policy(&topic, 2, policy).expect("Failed to create");
+    let sub_hub = Hub::<u32>::new_with_capacity(&topic, 2).expect("Failed to create");
+    assert_eq!(sub_hub.recv(&mut None), None);
+
+    pub_hub.send(1, &mut None).expect("Ring has space");
+    pub_hub.send(2, &mut None).expect("Ring has space");
+
+    let start = Instant::now();
+    assert_eq!(pub_hub.send(3, &mut None), Err(3));
+    assert!(start.elapsed() >= Duration::from_millis(20));
+}
+
+#[test]
+fn test_send_batch_publishes_all_messages() {
+    let topic = format!("test_send_batch_{}", std::process::id());
+
+    let pub_hub = Hub::<u32>::new_with_capacity(&topic, 64).expect("Failed to create publisher");
+    let sub_hub = Hub::<u32>::new_with_capacity(&topic, 64).expect("Failed to create subscriber");
+
+    let detections: Vec<u32> = (0..50).collect();
+    pub_hub
+        .send_batch(&detections, &mut None)
+        .expect("Batch should fit");
+
+    let mut received = Vec::new();
+    assert_eq!(sub_hub.recv_all_into(&mut received, &mut None), 50);
+    assert_eq!(received, detections);
+    assert_eq!(pub_hub.get_metrics().messages_sent, 50);
+}
+
+#[test]
+fn test_send_batch_wraps_ring() {
+    let topic = format!("test_send_batch_wrap_{}", std::process::id());
+
+    let pub_hub = Hub::<u32>::new_with_capacity(&topic, 8).expect("Failed to create publisher");
+    let sub_hub = Hub::<u32>::new_with_capacity(&topic, 8).expect("Failed to create subscriber");
+
+    // Move head so the next batch straddles the end of the ring
+    for i in 0..6 {
+        pub_hub.send(i, &mut None).unwrap();
+        assert_eq!(sub_hub.recv(&mut None), Some(i));
+    }
+
+    pub_hub.send_batch(&[10, 11, 12, 13], &mut None).unwrap();
+    let mut received = Vec::new();
+    sub_hub.recv_all_into(&mut received, &mut None);
+    assert_eq!(received, vec![10, 11, 12, 13]);
+}
+
+#[test]
+fn test_wait_for_data_wakes_on_publish() {
+    use std::time::{Duration, Instant};
+
+    let topic = format!("test_wait_for_data_{}", std::process::id());
+
+    let pub_hub = Hub::<u32>::new_with_capacity(&topic, 8).expect("Failed to create publisher");
+    let sub_hub = Hub::<u32>::new_with_capacity(&topic, 8).expect("Failed to create subscriber");
+    assert!(!sub_hub.wait_for_data(Duration::from_millis(5)));
+
+    let publisher = std::thread::spawn(move || {
+        std::thread::sleep(Duration::from_millis(20));
+        pub_hub.send(42, &mut None).unwrap();
+        pub_hub
+    });
+
+    let start = Instant::now();
+    assert!(sub_hub.wait_for_data(Duration::from_secs(5)));
+    assert!(start.elapsed() < Duration::from_secs(1));
+    assert_eq!(sub_hub.recv(&mut None), Some(42));
+    publisher.join().unwrap();
+}
+
+#[test]
+fn test_out_of_order_loans_publish_in_claim_order() {
+    use horus_core::memory::ShmTopic;
+
+    let topic = format!("test_loan_order_{}", std::process::id());
+    let producer = ShmTopic::<u64>::new(&topic, 8).expect("Failed to create producer");
+    let consumer = ShmTopic::<u64>::new(&topic, 8).expect("Failed to create consumer");
+
+    let mut first = producer.loan().expect("Failed to loan");
+    let mut second = producer.loan().expect("Failed to loan");
+    second.write(2);
+    drop(second);
+    assert!(
+        consumer.receive().is_none(),
+        "A later loan must not expose the earlier, unwritten slot"
+    );
+
+    first.write(1);
+    drop(first);
+    assert_eq!(consumer.receive().map(|s| s.read()), Some(1));
+    assert_eq!(consumer.receive().map(|s| s.read()), Some(2));
+}
+
+#[test]
+fn test_multi_producer_receives_only_written_values() {
+    use horus_core::communication::BackpressurePolicy;
+    use horus_core::memory::ShmTopic;
+    use std::time::Duration;
+
+    const PRODUCERS: u64 = 4;
+    const PER_PRODUCER: u64 = 5_000;
+
+    let topic = format!("test_multi_producer_{}", std::process::id());
+    let policy = BackpressurePolicy::Block {
+        timeout: Duration::from_secs(10),
+    };
+    let consumer =
+        ShmTopic::<u64>::new_with_policy(&topic, 64, policy).expect("Failed to create consumer");
+    // Register the cursor so producers wait for us instead of lapping
+    assert!(consumer.receive().is_none());
+
+    let producers: Vec<_> = (0..PRODUCERS)
+        .map(|p| {
+            let topic = topic.clone();
+            std::thread::spawn(move || {
+                let producer = ShmTopic::<u64>::new_with_policy(&topic, 64, policy)
+                    .expect("Failed to create producer");
+                for i in 1..=PER_PRODUCER {
+                    // Mix push and loan so both publish paths race
+                    if i % 2 == 0 {
+                        producer.push((p << 32) | i).expect("Consumer keeps up");
+                    } else {
+                        producer
+                            .loan()
+                            .expect("Consumer keeps up")
+                            .write((p << 32) | i);
+                    }
+                }
+            })
+        })
+        .collect();
+
+    // Every value must be one a producer wrote, in each producer's order
+    let mut next = vec![1u64; PRODUCERS as usize];
+    let mut received = 0;
+    while received < PRODUCERS * PER_PRODUCER {
+        let Some(sample) = consumer.receive() else {
+            std::thread::yield_now();
+            continue;
+        };
+        let value = sample.read();
+        let (p, i) = ((value >> 32) as usize, value & 0xFFFF_FFFF);
+        assert!(
+            p < PRODUCERS as usize && i == next[p],
+            "Received {:#x} that producer {} had not written next",
+            value,
+            p
+        );
+        next[p] += 1;
+        received += 1;
+    }
+    for producer in producers {
+        producer.join().unwrap();
+    }
+}
+
+#[test]
+fn test_partial_batch_publishes_only_written_slots() {
+    use horus_core::communication::BackpressurePolicy;
+    use horus_core::memory::ShmTopic;
+
+    let topic = format!("test_partial_batch_{}", std::process::id());
+    let producer = ShmTopic::<u64>::new_with_policy(&topic, 4, BackpressurePolicy::DropNewest)
+        .expect("Failed to create producer");
+    let consumer = ShmTopic::<u64>::new(&topic, 4).expect("Failed to create consumer");
+    assert!(consumer.receive().is_none());
+
+    let mut batch = producer.loan_n(4).expect("Batch fits");
+    batch.write(1).unwrap();
+    batch.write(2).unwrap();
+    drop(batch);
+
+    // The two unwritten slots are skipped, not delivered
+    assert_eq!(consumer.receive().map(|s| s.read()), Some(1));
+    assert_eq!(consumer.receive().map(|s| s.read()), Some(2));
+    assert!(consumer.receive().is_none());
+
+    // Skipped slots were released to the bounded producer as well
+    for i in 3..7 {
+        producer.push(i).expect("Consumer has drained the ring");
+    }
+    let received: Vec<u64> = std::iter::from_fn(|| consumer.receive().map(|s| s.read())).collect();
+    assert_eq!(received, vec![3, 4, 5, 6]);
+}
+
+#[test]
+fn test_clone_valid_rejects_overwritten_slot() {
+    use horus_core::memory::ShmTopic;
+
+    let topic = format!("test_clone_valid_{}", std::process::id());
+    let producer = ShmTopic::<u64>::new(&topic, 4).expect("Failed to create producer");
+    let consumer = ShmTopic::<u64>::new(&topic, 4).expect("Failed to create consumer");
+
+    producer.push(1).unwrap();
+    let sample = consumer.receive().expect("Should receive a sample");
+    assert_eq!(sample.clone_valid(), Some(1));
+
+    // Lap the ring so the borrowed slot is reused
+    for i in 0..4 {
+        producer.push(10 + i).unwrap();
+    }
+    assert_eq!(
+        sample.clone_valid(),
+        None,
+        "Overwritten slot must not be cloned"
+    );
+}
@@ -0,0 +1,110 @@
+//! Event-driven nodes alongside periodic ones in the scheduler loop
+
+use horus_core::communication::hub::Hub;
+use horus_core::core::{Node, NodeInfo, TopicMetadata};
+use horus_core::scheduling::Scheduler;
+use std::sync::atomic::{AtomicBool, AtomicU32, Ordering};
+use std::sync::Arc;
+use std::time::Duration;
+
+struct PeriodicNode {
+    ticks: Arc<AtomicU32>,
+}
+
+impl Node for PeriodicNode {
+    fn name(&self) -> &'static str {
+        "periodic_controller"
+    }
+
+    fn tick(&mut self, _ctx: Option<&mut NodeInfo>) {
+        self.ticks.fetch_add(1, Ordering::SeqCst);
+    }
+}
+
+struct EventNode {
+    topic: String,
+    hub: Hub<u32>,
+    ticks: Arc<AtomicU32>,
+}
+
+impl Node for EventNode {
+    fn name(&self) -> &'static str {
+        "event_listener"
+    }
+
+    fn tick(&mut self, _ctx: Option<&mut NodeInfo>) {
+        while self.hub.recv(&mut None).is_some() {}
+        self.ticks.fetch_add(1, Ordering::SeqCst);
+    }
+
+    fn get_subscribers(&self) -> Vec<TopicMetadata> {
+        vec![TopicMetadata {
+            topic_name: self.topic.clone(),
+            type_name: "u32".to_string(),
+        }]
+    }
+}
+
+#[test]
+fn test_busy_topic_does_not_speed_up_periodic_nodes() {
+    let topic = format!("test_event_rate_{}", std::process::id());
+    let publisher = Hub::<u32>::new(&topic).expect("Failed to create publisher");
+
+    let periodic_ticks = Arc::new(AtomicU32::new(0));
+    let event_ticks = Arc::new(AtomicU32::new(0));
+
+    let mut scheduler = Scheduler::new();
+    scheduler.add(
+        Box::new(PeriodicNode {
+            ticks: periodic_ticks.clone(),
+        }),
+        0,
+        Some(false),
+    );
+    scheduler
+        .add(
+            Box::new(EventNode {
+                topic: topic.clone(),
+                hub: Hub::<u32>::new(&topic).expect("Failed to create subscriber"),
+                ticks: event_ticks.clone(),
+            }),
+            1,
+            Some(false),
+        )
+        .set_node_event_driven("event_listener", true);
+
+    // Publish far faster than the ~60 Hz scheduler tick
+    let stop = Arc::new(AtomicBool::new(false));
+    let source = {
+        let stop = stop.clone();
+        std::thread::spawn(move || {
+            let mut i = 0;
+            while !stop.load(Ordering::Relaxed) {
+                let _ = publisher.send(i, &mut None);
+                i += 1;
+                std::thread::sleep(Duration::from_micros(250));
+            }
+        })
+    };
+
+    let run = Duration::from_millis(600);
+    scheduler.run_for(run).expect("Scheduler failed");
+    stop.store(true, Ordering::Relaxed);
+    source.join().unwrap();
+
+    // 600 ms at 60 Hz is 36 ticks; allow a few for start-up and shutdown
+    let periodic = periodic_ticks.load(Ordering::SeqCst);
+    let events = event_ticks.load(Ordering::SeqCst);
+    assert!(
+        periodic <= 40,
+        "Periodic node ticked {} times, faster than its rate",
+        periodic
+    );
+    assert!(periodic >= 10, "Periodic node barely ran: {}", periodic);
+    assert!(
+        events > 2 * periodic,
+        "Event node should follow the publish rate ({} vs {} periodic ticks)",
+        events,
+        periodic
+    );
+}
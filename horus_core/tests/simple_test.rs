@@ -124,4 +124,23 @@ mod tests {
         // NodeInfo basic test
         // (node_id method or similar would be tested here if available)
     }
+
+    #[test]
+    fn test_arena_reset_skipped_while_clone_kept() {
+        let mut info = NodeInfo::new("arena_keeper".to_string(), false);
+
+        // A node holds on to the arena past its tick
+        let kept = info.arena();
+        kept.alloc_slice_fill(4096, 0u8);
+        info.reset_arena();
+        info.reset_arena();
+        assert_eq!(info.arena_resets_skipped(), 2);
+        assert!(kept.spilled(), "Spill must not be freed under a live clone");
+
+        // Once released, the next reset goes through
+        drop(kept);
+        info.reset_arena();
+        assert_eq!(info.arena_resets_skipped(), 2);
+        assert_eq!(info.arena().used(), 0);
+    }
 }
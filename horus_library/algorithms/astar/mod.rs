@@ -9,6 +9,7 @@
 //! - Configurable heuristic weight for speed/optimality tradeoff
 //! - Euclidean and Manhattan distance heuristics
 //! - Obstacle-aware grid navigation
+//! - Flat row-major grid and dense search state reused across `plan()` calls
 //!
 //! # Example
 //!
@@ -34,38 +35,52 @@
 //! ```
 
 use std::cmp::Ordering;
-use std::collections::{BinaryHeap, HashMap, HashSet};
-
-/// A* Node in the search tree
-#[derive(Clone, Debug)]
-struct Node {
-    x: i32,
-    y: i32,
-    g_cost: f64,  // Cost from start
-    _h_cost: f64, // Heuristic cost to goal (stored for debugging, used to compute f_cost)
-    f_cost: f64,  // Total cost (g + h)
-    parent: Option<(i32, i32)>,
+use std::collections::BinaryHeap;
+
+/// 8-connected moves; the first four are the straight ones
+const DIRECTIONS: [(i32, i32); 8] = [
+    (0, 1),
+    (1, 0),
+    (0, -1),
+    (-1, 0),
+    (1, 1),
+    (1, -1),
+    (-1, 1),
+    (-1, -1),
+];
+
+/// Open-list entry keyed by cell index
+#[derive(Clone, Copy, Debug)]
+struct OpenEntry {
+    f_cost: f32, // Total cost (g + h)
+    g_cost: f32, // Cost from start
+    index: u32,
 }
 
-impl Eq for Node {}
+impl Eq for OpenEntry {}
 
-impl PartialEq for Node {
+impl PartialEq for OpenEntry {
     fn eq(&self, other: &Self) -> bool {
-        self.x == other.x && self.y == other.y
+        self.cmp(other) == Ordering::Equal
     }
 }
 
-impl Ord for Node {
+impl Ord for OpenEntry {
     fn cmp(&self, other: &Self) -> Ordering {
-        // Reverse ordering for min-heap
+        // Reverse ordering for min-heap; ties go to the deeper node
         other
             .f_cost
             .partial_cmp(&self.f_cost)
             .unwrap_or(Ordering::Equal)
+            .then_with(|| {
+                self.g_cost
+                    .partial_cmp(&other.g_cost)
+                    .unwrap_or(Ordering::Equal)
+            })
     }
 }
 
-impl PartialOrd for Node {
+impl PartialOrd for OpenEntry {
     fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
         Some(self.cmp(other))
     }
@@ -83,15 +98,27 @@ pub enum Heuristic {
 }
 
 /// A* Pathfinding Algorithm
+///
+/// The grid is one byte per cell, row-major. Search state lives in dense
+/// arrays indexed by cell and is kept between calls; a generation stamp
+/// marks which entries belong to the current search, so replanning never
+/// clears or reallocates it.
 pub struct AStar {
     width: usize,
     height: usize,
-    grid: Vec<Vec<bool>>, // true = obstacle, false = free
+    grid: Vec<u8>, // row-major, 1 = obstacle, 0 = free
     start: (i32, i32),
     goal: (i32, i32),
     heuristic: Heuristic,
     heuristic_weight: f64,
     allow_diagonal: bool,
+
+    // Search state, sized on first plan()
+    g_cost: Vec<f32>,
+    parent: Vec<u32>,
+    mark: Vec<u32>, // 2 * generation = open, 2 * generation + 1 = closed
+    generation: u32,
+    open: BinaryHeap<OpenEntry>,
 }
 
 impl AStar {
@@ -100,12 +127,17 @@ impl AStar {
         Self {
             width,
             height,
-            grid: vec![vec![false; width]; height],
+            grid: vec![0; width * height],
             start: (0, 0),
             goal: (0, 0),
             heuristic: Heuristic::Euclidean,
             heuristic_weight: 1.0,
             allow_diagonal: true,
+            g_cost: Vec::new(),
+            parent: Vec::new(),
+            mark: Vec::new(),
+            generation: 0,
+            open: BinaryHeap::new(),
         }
     }
 
@@ -122,21 +154,39 @@ impl AStar {
     /// Set obstacle at position
     pub fn set_obstacle(&mut self, x: i32, y: i32) {
         if self.is_valid(x, y) {
-            self.grid[y as usize][x as usize] = true;
+            let index = self.index(x, y);
+            self.grid[index] = 1;
         }
     }
 
     /// Clear obstacle at position
     pub fn clear_obstacle(&mut self, x: i32, y: i32) {
         if self.is_valid(x, y) {
-            self.grid[y as usize][x as usize] = false;
+            let index = self.index(x, y);
+            self.grid[index] = 0;
         }
     }
 
     /// Set entire grid (true = obstacle, false = free)
     pub fn set_grid(&mut self, grid: Vec<Vec<bool>>) {
         if grid.len() == self.height && grid[0].len() == self.width {
-            self.grid = grid;
+            for (dst, row) in self.grid.chunks_mut(self.width).zip(&grid) {
+                for (cell, &blocked) in dst.iter_mut().zip(row) {
+                    *cell = blocked as u8;
+                }
+            }
+        }
+    }
+
+    /// Load obstacles from row-major occupancy cells (message convention)
+    ///
+    /// Cells at or above `threshold` are obstacles; unknown (`-1`) cells are
+    /// treated as free. Ignored if `data` does not match the grid size.
+    pub fn load_occupancy(&mut self, data: &[i8], threshold: i8) {
+        if data.len() == self.grid.len() {
+            for (cell, &value) in self.grid.iter_mut().zip(data) {
+                *cell = (value >= threshold) as u8;
+            }
         }
     }
 
@@ -157,103 +207,135 @@ impl AStar {
 
     /// Clear all obstacles
     pub fn clear_obstacles(&mut self) {
-        for row in &mut self.grid {
-            row.fill(false);
-        }
+        self.grid.fill(0);
     }
 
     /// Plan path from start to goal
-    pub fn plan(&self) -> Option<Vec<(i32, i32)>> {
+    pub fn plan(&mut self) -> Option<Vec<(i32, i32)>> {
+        let mut path = Vec::new();
+        self.plan_into(&mut path).then_some(path)
+    }
+
+    /// Plan path from start to goal into a caller-owned buffer
+    ///
+    /// Returns false (leaving `path` empty) when no path exists.
+    pub fn plan_into(&mut self, path: &mut Vec<(i32, i32)>) -> bool {
+        path.clear();
+
         // Validate start and goal
         if !self.is_valid(self.start.0, self.start.1) || !self.is_valid(self.goal.0, self.goal.1) {
-            return None;
+            return false;
         }
 
         if self.is_obstacle(self.start.0, self.start.1)
             || self.is_obstacle(self.goal.0, self.goal.1)
         {
-            return None;
+            return false;
         }
 
         // Check if already at goal
         if self.start == self.goal {
-            return Some(vec![self.start]);
+            path.push(self.start);
+            return true;
         }
 
-        let mut open_set = BinaryHeap::new();
-        let mut closed_set = HashSet::new();
-        let mut nodes = HashMap::new();
+        let (open_mark, closed_mark) = self.begin_search();
+        let start = self.index(self.start.0, self.start.1);
+        let goal = self.index(self.goal.0, self.goal.1);
+        let directions = if self.allow_diagonal { 8 } else { 4 };
 
-        // Initialize start node
-        let start_node = Node {
-            x: self.start.0,
-            y: self.start.1,
-            g_cost: 0.0,
-            _h_cost: self.heuristic_cost(self.start.0, self.start.1),
+        self.g_cost[start] = 0.0;
+        self.parent[start] = start as u32;
+        self.mark[start] = open_mark;
+        self.open.push(OpenEntry {
             f_cost: self.heuristic_cost(self.start.0, self.start.1),
-            parent: None,
-        };
-
-        open_set.push(start_node.clone());
-        nodes.insert((self.start.0, self.start.1), start_node);
-
-        while let Some(current) = open_set.pop() {
-            let current_pos = (current.x, current.y);
+            g_cost: 0.0,
+            index: start as u32,
+        });
 
-            // Check if reached goal
-            if current_pos == self.goal {
-                return Some(self.reconstruct_path(&nodes, current_pos));
-            }
+        while let Some(current) = self.open.pop() {
+            let current_index = current.index as usize;
 
             // Skip if already processed
-            if closed_set.contains(&current_pos) {
+            if self.mark[current_index] == closed_mark {
                 continue;
             }
+            self.mark[current_index] = closed_mark;
+
+            // Check if reached goal
+            if current_index == goal {
+                self.reconstruct_path(start, goal, path);
+                self.open.clear();
+                return true;
+            }
 
-            closed_set.insert(current_pos);
+            let x = (current_index % self.width) as i32;
+            let y = (current_index / self.width) as i32;
 
             // Explore neighbors
-            for (nx, ny) in self.get_neighbors(current.x, current.y) {
-                let neighbor_pos = (nx, ny);
+            for (k, &(dx, dy)) in DIRECTIONS[..directions].iter().enumerate() {
+                let (nx, ny) = (x + dx, y + dy);
+                if self.is_obstacle(nx, ny) {
+                    continue;
+                }
 
-                if closed_set.contains(&neighbor_pos) {
+                // Diagonal moves may not cut obstacle corners
+                let diagonal = k >= 4;
+                if diagonal && (self.is_obstacle(x + dx, y) || self.is_obstacle(x, y + dy)) {
                     continue;
                 }
 
-                // Calculate cost to neighbor
-                let move_cost = if (nx - current.x).abs() + (ny - current.y).abs() == 2 {
-                    std::f64::consts::SQRT_2 // Diagonal movement
+                let neighbor = self.index(nx, ny);
+                if self.mark[neighbor] == closed_mark {
+                    continue;
+                }
+
+                let move_cost = if diagonal {
+                    std::f32::consts::SQRT_2
                 } else {
-                    1.0 // Straight movement
+                    1.0
                 };
-
                 let tentative_g = current.g_cost + move_cost;
 
                 // Check if this path is better
-                let should_update = if let Some(existing) = nodes.get(&neighbor_pos) {
-                    tentative_g < existing.g_cost
-                } else {
-                    true
-                };
-
-                if should_update {
-                    let _h_cost = self.heuristic_cost(nx, ny);
-                    let neighbor_node = Node {
-                        x: nx,
-                        y: ny,
+                if self.mark[neighbor] != open_mark || tentative_g < self.g_cost[neighbor] {
+                    self.g_cost[neighbor] = tentative_g;
+                    self.parent[neighbor] = current.index;
+                    self.mark[neighbor] = open_mark;
+                    self.open.push(OpenEntry {
+                        f_cost: tentative_g + self.heuristic_cost(nx, ny),
                         g_cost: tentative_g,
-                        _h_cost,
-                        f_cost: tentative_g + _h_cost,
-                        parent: Some(current_pos),
-                    };
-
-                    open_set.push(neighbor_node.clone());
-                    nodes.insert(neighbor_pos, neighbor_node);
+                        index: neighbor as u32,
+                    });
                 }
             }
         }
 
-        None // No path found
+        false // No path found
+    }
+
+    /// Size the search arrays and start a new generation, returning (open, closed) marks
+    fn begin_search(&mut self) -> (u32, u32) {
+        let cells = self.width * self.height;
+        if self.mark.len() != cells {
+            self.g_cost = vec![0.0; cells];
+            self.parent = vec![0; cells];
+            self.mark = vec![0; cells];
+            self.generation = 0;
+        }
+
+        self.generation += 1;
+        if self.generation > u32::MAX / 2 - 1 {
+            self.mark.fill(0);
+            self.generation = 1;
+        }
+        self.open.clear();
+
+        (self.generation * 2, self.generation * 2 + 1)
+    }
+
+    fn index(&self, x: i32, y: i32) -> usize {
+        y as usize * self.width + x as usize
     }
 
     fn is_valid(&self, x: i32, y: i32) -> bool {
@@ -264,10 +346,10 @@ impl AStar {
         if !self.is_valid(x, y) {
             return true;
         }
-        self.grid[y as usize][x as usize]
+        self.grid[self.index(x, y)] != 0
     }
 
-    fn heuristic_cost(&self, x: i32, y: i32) -> f64 {
+    fn heuristic_cost(&self, x: i32, y: i32) -> f32 {
         let dx = (self.goal.0 - x).abs() as f64;
         let dy = (self.goal.1 - y).abs() as f64;
 
@@ -277,65 +359,20 @@ impl AStar {
             Heuristic::Diagonal => dx.max(dy) + (std::f64::consts::SQRT_2 - 1.0) * dx.min(dy),
         };
 
-        cost * self.heuristic_weight
-    }
-
-    fn get_neighbors(&self, x: i32, y: i32) -> Vec<(i32, i32)> {
-        let mut neighbors = Vec::new();
-
-        // 4-directional movement
-        let directions = [(0, 1), (1, 0), (0, -1), (-1, 0)];
-
-        for (dx, dy) in directions {
-            let nx = x + dx;
-            let ny = y + dy;
-
-            if self.is_valid(nx, ny) && !self.is_obstacle(nx, ny) {
-                neighbors.push((nx, ny));
-            }
-        }
-
-        // Diagonal movement
-        if self.allow_diagonal {
-            let diagonals = [(1, 1), (1, -1), (-1, 1), (-1, -1)];
-
-            for (dx, dy) in diagonals {
-                let nx = x + dx;
-                let ny = y + dy;
-
-                if self.is_valid(nx, ny) && !self.is_obstacle(nx, ny) {
-                    // Check for diagonal corner cutting
-                    let check_x = self.is_obstacle(x + dx, y);
-                    let check_y = self.is_obstacle(x, y + dy);
-
-                    if !check_x && !check_y {
-                        neighbors.push((nx, ny));
-                    }
-                }
-            }
-        }
-
-        neighbors
+        (cost * self.heuristic_weight) as f32
     }
 
-    fn reconstruct_path(
-        &self,
-        nodes: &HashMap<(i32, i32), Node>,
-        mut current: (i32, i32),
-    ) -> Vec<(i32, i32)> {
-        let mut path = vec![current];
-
-        while let Some(node) = nodes.get(&current) {
-            if let Some(parent) = node.parent {
-                path.push(parent);
-                current = parent;
-            } else {
+    fn reconstruct_path(&self, start: usize, goal: usize, path: &mut Vec<(i32, i32)>) {
+        let mut current = goal;
+        loop {
+            path.push(((current % self.width) as i32, (current / self.width) as i32));
+            if current == start {
                 break;
             }
+            current = self.parent[current] as usize;
         }
 
         path.reverse();
-        path
     }
 
     /// Calculate path length
@@ -436,4 +473,39 @@ mod tests {
         // Weighted might be slightly longer (or equal in open space)
         assert!(len2 >= len1 * 0.9); // Within 10% tolerance
     }
+
+    #[test]
+    fn test_replan_reuses_state() {
+        let mut astar = AStar::new(30, 30);
+        astar.set_start(0, 0);
+        astar.set_goal(29, 29);
+        let open_len = AStar::path_length(&astar.plan().unwrap());
+
+        // Wall with a gap at the top forces a detour on the second search
+        for y in 0..29 {
+            astar.set_obstacle(15, y);
+        }
+        let detour = astar.plan().unwrap();
+        assert!(AStar::path_length(&detour) > open_len);
+        assert!(detour.iter().all(|&(x, y)| x != 15 || y == 29));
+
+        // Removing it again must not leave stale search data behind
+        astar.clear_obstacles();
+        let again = astar.plan().unwrap();
+        assert!((AStar::path_length(&again) - open_len).abs() < 1e-9);
+    }
+
+    #[test]
+    fn test_load_occupancy() {
+        let mut astar = AStar::new(3, 3);
+        // Middle column blocked except unknown bottom cell
+        let data = [0, 100, 0, 0, 100, 0, 0, -1, 0];
+        astar.load_occupancy(&data, 50);
+        astar.set_start(0, 2);
+        astar.set_goal(2, 2);
+
+        let path = astar.plan().unwrap();
+        assert!(path.contains(&(1, 2)));
+        assert!(!path.contains(&(1, 1)));
+    }
 }
@@ -23,6 +23,8 @@
 //! let (linear, angular) = dd.forward_kinematics(1.2, 0.8);  // left, right
 //! ```
 
+use horus_core::scheduling::jit::{DataflowGraph, Value};
+
 /// Differential Drive Kinematics
 pub struct DifferentialDrive {
     wheel_base: f64,   // Distance between wheels (m)
@@ -127,6 +129,18 @@ impl DifferentialDrive {
     pub fn set_wheel_radius(&mut self, wheel_radius: f64) {
         self.wheel_radius = wheel_radius;
     }
+
+    /// Emit inverse kinematics into a JIT dataflow graph
+    ///
+    /// Returns the (left, right) wheel speed values.
+    pub fn to_dataflow(
+        &self,
+        graph: &mut DataflowGraph,
+        linear: Value,
+        angular: Value,
+    ) -> (Value, Value) {
+        graph.differential_drive(linear, angular, self.wheel_base)
+    }
 }
 
 #[cfg(test)]
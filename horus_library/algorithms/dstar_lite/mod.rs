@@ -0,0 +1,560 @@
+//! D* Lite Incremental Pathfinding
+//!
+//! Grid planner that repairs its previous solution when cells change or the
+//! robot moves instead of searching again from scratch (Koenig & Likhachev).
+//!
+//! # Features
+//!
+//! - Optimal 8-directional (or 4-directional) paths, same costs as `AStar`
+//! - Incremental replanning: only cells affected by a change are re-expanded
+//! - Start may move between plans without invalidating the search
+//! - Flat row-major grid; occupancy messages are diffed cell by cell
+//!
+//! # Example
+//!
+//! ```rust
+//! use horus_library::algorithms::dstar_lite::DStarLite;
+//!
+//! let mut planner = DStarLite::new(100, 100);
+//! planner.set_start(10, 10);
+//! planner.set_goal(90, 90);
+//!
+//! let first = planner.plan();
+//!
+//! // A new obstacle only repairs the affected part of the search
+//! planner.set_obstacle(50, 50);
+//! if let Some(path) = planner.plan() {
+//!     println!("Replanned with {} waypoints", path.len());
+//! }
+//! ```
+
+use std::cmp::Ordering;
+use std::collections::BinaryHeap;
+
+/// 8-connected moves; the first four are the straight ones
+const DIRECTIONS: [(i32, i32); 8] = [
+    (0, 1),
+    (1, 0),
+    (0, -1),
+    (-1, 0),
+    (1, 1),
+    (1, -1),
+    (-1, 1),
+    (-1, -1),
+];
+
+/// Cost of a straight move in fixed point (one cell = 100)
+const STRAIGHT_COST: u32 = 100;
+/// Cost of a diagonal move in fixed point (sqrt(2) to 0.02%)
+const DIAGONAL_COST: u32 = 141;
+/// Unreachable
+const INFINITY: u32 = u32::MAX;
+
+/// Priority of a cell: (min(g, rhs) + h + km, min(g, rhs)), compared lexicographically
+type Key = (u32, u32);
+
+/// Open-list entry; stale entries are skipped when popped
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+struct QueueEntry {
+    key: Key,
+    index: u32,
+}
+
+impl Ord for QueueEntry {
+    fn cmp(&self, other: &Self) -> Ordering {
+        // Reverse ordering for min-heap
+        other
+            .key
+            .cmp(&self.key)
+            .then_with(|| other.index.cmp(&self.index))
+    }
+}
+
+impl PartialOrd for QueueEntry {
+    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+/// D* Lite incremental planner
+///
+/// Searches backwards from the goal, so `g` holds cost-to-goal and stays
+/// valid as the start moves. Cell updates re-evaluate only the changed cell
+/// and its neighbours; the next `plan()` expands just the region whose
+/// cost-to-goal actually changed. Costs are fixed-point integers so the
+/// key comparisons that decide when the search may stop are exact.
+pub struct DStarLite {
+    width: usize,
+    height: usize,
+    grid: Vec<u8>, // row-major, 1 = obstacle, 0 = free
+    start: (i32, i32),
+    goal: (i32, i32),
+    allow_diagonal: bool,
+
+    // Search state, valid while `initialized`
+    g: Vec<u32>,
+    rhs: Vec<u32>,
+    in_open: Vec<bool>,
+    open: BinaryHeap<QueueEntry>,
+    km: u32,
+    last_start: (i32, i32),
+    initialized: bool,
+    expansions: usize,
+}
+
+impl DStarLite {
+    /// Create new D* Lite planner with grid dimensions
+    pub fn new(width: usize, height: usize) -> Self {
+        Self {
+            width,
+            height,
+            grid: vec![0; width * height],
+            start: (0, 0),
+            goal: (0, 0),
+            allow_diagonal: true,
+            g: Vec::new(),
+            rhs: Vec::new(),
+            in_open: Vec::new(),
+            open: BinaryHeap::new(),
+            km: 0,
+            last_start: (0, 0),
+            initialized: false,
+            expansions: 0,
+        }
+    }
+
+    /// Set start position (the robot may move between plans)
+    pub fn set_start(&mut self, x: i32, y: i32) {
+        self.start = (x, y);
+    }
+
+    /// Set goal position; a new goal restarts the search
+    pub fn set_goal(&mut self, x: i32, y: i32) {
+        if self.goal != (x, y) {
+            self.goal = (x, y);
+            self.initialized = false;
+        }
+    }
+
+    /// Allow or disallow diagonal movement; restarts the search
+    pub fn set_allow_diagonal(&mut self, allow: bool) {
+        if self.allow_diagonal != allow {
+            self.allow_diagonal = allow;
+            self.initialized = false;
+        }
+    }
+
+    /// Set obstacle at position
+    pub fn set_obstacle(&mut self, x: i32, y: i32) {
+        self.set_cell(x, y, true);
+    }
+
+    /// Clear obstacle at position
+    pub fn clear_obstacle(&mut self, x: i32, y: i32) {
+        self.set_cell(x, y, false);
+    }
+
+    /// Update obstacles from row-major occupancy cells (message convention)
+    ///
+    /// Cells at or above `threshold` are obstacles; unknown (`-1`) cells are
+    /// treated as free. Only cells whose state differs from the current grid
+    /// touch the search. Ignored if `data` does not match the grid size.
+    pub fn load_occupancy(&mut self, data: &[i8], threshold: i8) {
+        if data.len() != self.grid.len() {
+            return;
+        }
+        for (index, &value) in data.iter().enumerate() {
+            let blocked = value >= threshold;
+            if (self.grid[index] != 0) != blocked {
+                let x = (index % self.width) as i32;
+                let y = (index / self.width) as i32;
+                self.set_cell(x, y, blocked);
+            }
+        }
+    }
+
+    /// Cells expanded by the last `plan()` call
+    pub fn expansions(&self) -> usize {
+        self.expansions
+    }
+
+    /// Plan (or repair) the path from start to goal
+    pub fn plan(&mut self) -> Option<Vec<(i32, i32)>> {
+        let mut path = Vec::new();
+        self.plan_into(&mut path).then_some(path)
+    }
+
+    /// Plan (or repair) the path into a caller-owned buffer
+    ///
+    /// Returns false (leaving `path` empty) when no path exists.
+    pub fn plan_into(&mut self, path: &mut Vec<(i32, i32)>) -> bool {
+        path.clear();
+        self.expansions = 0;
+
+        if !self.is_valid(self.start.0, self.start.1) || !self.is_valid(self.goal.0, self.goal.1) {
+            return false;
+        }
+        if self.is_obstacle(self.start.0, self.start.1)
+            || self.is_obstacle(self.goal.0, self.goal.1)
+        {
+            return false;
+        }
+        if self.start == self.goal {
+            path.push(self.start);
+            return true;
+        }
+
+        if !self.initialized {
+            self.initialize();
+        }
+        self.sync_start();
+        self.compute_shortest_path();
+
+        let start = self.index(self.start.0, self.start.1);
+        let goal = self.index(self.goal.0, self.goal.1);
+        if self.g[start] == INFINITY {
+            return false;
+        }
+
+        // Walk down the cost-to-goal field
+        let mut current = start;
+        path.push(self.start);
+        while current != goal {
+            let mut best = None;
+            let mut best_cost = INFINITY;
+            for k in 0..self.directions() {
+                if let Some((next, cost)) = self.edge(current, k) {
+                    let total = cost.saturating_add(self.g[next]);
+                    if total < best_cost {
+                        best_cost = total;
+                        best = Some(next);
+                    }
+                }
+            }
+            match best {
+                Some(next) if path.len() <= self.grid.len() => {
+                    current = next;
+                    path.push(((next % self.width) as i32, (next / self.width) as i32));
+                }
+                _ => {
+                    path.clear();
+                    return false;
+                }
+            }
+        }
+        true
+    }
+
+    /// Reset search state for a new goal
+    fn initialize(&mut self) {
+        let cells = self.width * self.height;
+        self.g.clear();
+        self.g.resize(cells, INFINITY);
+        self.rhs.clear();
+        self.rhs.resize(cells, INFINITY);
+        self.in_open.clear();
+        self.in_open.resize(cells, false);
+        self.open.clear();
+        self.km = 0;
+        self.last_start = self.start;
+
+        let goal = self.index(self.goal.0, self.goal.1);
+        self.rhs[goal] = 0;
+        self.push(goal);
+        self.initialized = true;
+    }
+
+    /// Account for start movement since keys were last computed
+    fn sync_start(&mut self) {
+        if self.last_start != self.start {
+            self.km = self
+                .km
+                .saturating_add(self.heuristic(self.last_start, self.start));
+            self.last_start = self.start;
+        }
+    }
+
+    fn set_cell(&mut self, x: i32, y: i32, blocked: bool) {
+        if !self.is_valid(x, y) {
+            return;
+        }
+        let index = self.index(x, y);
+        if (self.grid[index] != 0) == blocked {
+            return;
+        }
+        self.grid[index] = blocked as u8;
+
+        if self.initialized {
+            // Keys pushed from here on must use the current start
+            self.sync_start();
+            self.update_vertex(index);
+            for k in 0..8 {
+                if let Some(neighbor) = self.neighbor(index, k) {
+                    self.update_vertex(neighbor);
+                }
+            }
+        }
+    }
+
+    fn compute_shortest_path(&mut self) {
+        let start = self.index(self.start.0, self.start.1);
+
+        while let Some(top) = self.peek() {
+            let start_key = self.key(start);
+            if top.key >= start_key && self.rhs[start] == self.g[start] {
+                break;
+            }
+            self.open.pop();
+
+            let u = top.index as usize;
+            self.expansions += 1;
+
+            let new_key = self.key(u);
+            if top.key < new_key {
+                self.open.push(QueueEntry {
+                    key: new_key,
+                    index: top.index,
+                });
+            } else if self.g[u] > self.rhs[u] {
+                self.g[u] = self.rhs[u];
+                self.in_open[u] = false;
+                for k in 0..self.directions() {
+                    if let Some(neighbor) = self.neighbor(u, k) {
+                        self.update_vertex(neighbor);
+                    }
+                }
+            } else {
+                self.g[u] = INFINITY;
+                self.update_vertex(u);
+                for k in 0..self.directions() {
+                    if let Some(neighbor) = self.neighbor(u, k) {
+                        self.update_vertex(neighbor);
+                    }
+                }
+            }
+        }
+    }
+
+    /// Recompute rhs from the neighbours and fix the cell's queue membership
+    fn update_vertex(&mut self, u: usize) {
+        let goal = self.index(self.goal.0, self.goal.1);
+        if u != goal {
+            let mut rhs = INFINITY;
+            for k in 0..self.directions() {
+                if let Some((next, cost)) = self.edge(u, k) {
+                    rhs = rhs.min(cost.saturating_add(self.g[next]));
+                }
+            }
+            self.rhs[u] = rhs;
+        }
+
+        if self.g[u] != self.rhs[u] {
+            self.push(u);
+        } else {
+            self.in_open[u] = false;
+        }
+    }
+
+    /// Smallest live queue entry, discarding entries for cells no longer open
+    fn peek(&mut self) -> Option<QueueEntry> {
+        while let Some(&top) = self.open.peek() {
+            if self.in_open[top.index as usize] {
+                return Some(top);
+            }
+            self.open.pop();
+        }
+        None
+    }
+
+    fn push(&mut self, u: usize) {
+        self.in_open[u] = true;
+        self.open.push(QueueEntry {
+            key: self.key(u),
+            index: u as u32,
+        });
+    }
+
+    fn key(&self, u: usize) -> Key {
+        let best = self.g[u].min(self.rhs[u]);
+        let cell = ((u % self.width) as i32, (u / self.width) as i32);
+        let priority = best
+            .saturating_add(self.heuristic(self.start, cell))
+            .saturating_add(self.km);
+        (priority, best)
+    }
+
+    /// Octile (or Manhattan) distance; consistent with the fixed-point move costs
+    fn heuristic(&self, a: (i32, i32), b: (i32, i32)) -> u32 {
+        let dx = a.0.abs_diff(b.0);
+        let dy = a.1.abs_diff(b.1);
+        if self.allow_diagonal {
+            STRAIGHT_COST * dx.max(dy) + (DIAGONAL_COST - STRAIGHT_COST) * dx.min(dy)
+        } else {
+            STRAIGHT_COST * (dx + dy)
+        }
+    }
+
+    fn directions(&self) -> usize {
+        if self.allow_diagonal {
+            8
+        } else {
+            4
+        }
+    }
+
+    /// In-bounds neighbour in direction `k`
+    fn neighbor(&self, u: usize, k: usize) -> Option<usize> {
+        let (dx, dy) = DIRECTIONS[k];
+        let x = (u % self.width) as i32 + dx;
+        let y = (u / self.width) as i32 + dy;
+        self.is_valid(x, y).then(|| self.index(x, y))
+    }
+
+    /// Traversable edge in direction `k` as (neighbour, cost); same rules as `AStar`
+    fn edge(&self, u: usize, k: usize) -> Option<(usize, u32)> {
+        let (dx, dy) = DIRECTIONS[k];
+        let x = (u % self.width) as i32;
+        let y = (u / self.width) as i32;
+        let (nx, ny) = (x + dx, y + dy);
+
+        if self.grid[u] != 0 || self.is_obstacle(nx, ny) {
+            return None;
+        }
+        if k >= 4 {
+            // Diagonal moves may not cut obstacle corners
+            if self.is_obstacle(x + dx, y) || self.is_obstacle(x, y + dy) {
+                return None;
+            }
+            return Some((self.index(nx, ny), DIAGONAL_COST));
+        }
+        Some((self.index(nx, ny), STRAIGHT_COST))
+    }
+
+    fn index(&self, x: i32, y: i32) -> usize {
+        y as usize * self.width + x as usize
+    }
+
+    fn is_valid(&self, x: i32, y: i32) -> bool {
+        x >= 0 && x < self.width as i32 && y >= 0 && y < self.height as i32
+    }
+
+    fn is_obstacle(&self, x: i32, y: i32) -> bool {
+        if !self.is_valid(x, y) {
+            return true;
+        }
+        self.grid[self.index(x, y)] != 0
+    }
+
+    /// Calculate path length
+    pub fn path_length(path: &[(i32, i32)]) -> f64 {
+        path.windows(2)
+            .map(|w| {
+                let dx = (w[1].0 - w[0].0) as f64;
+                let dy = (w[1].1 - w[0].1) as f64;
+                (dx * dx + dy * dy).sqrt()
+            })
+            .sum()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::algorithms::astar::AStar;
+
+    fn reference_length(
+        obstacles: &[(i32, i32)],
+        size: usize,
+        start: (i32, i32),
+        goal: (i32, i32),
+    ) -> Option<f64> {
+        let mut astar = AStar::new(size, size);
+        for &(x, y) in obstacles {
+            astar.set_obstacle(x, y);
+        }
+        astar.set_start(start.0, start.1);
+        astar.set_goal(goal.0, goal.1);
+        astar.plan().map(|path| AStar::path_length(&path))
+    }
+
+    #[test]
+    fn test_basic_pathfinding() {
+        let mut planner = DStarLite::new(10, 10);
+        planner.set_start(0, 0);
+        planner.set_goal(9, 9);
+
+        let path = planner.plan().unwrap();
+        assert_eq!(path[0], (0, 0));
+        assert_eq!(path[path.len() - 1], (9, 9));
+        assert!((DStarLite::path_length(&path) - 9.0 * std::f64::consts::SQRT_2).abs() < 1e-6);
+    }
+
+    #[test]
+    fn test_matches_astar_after_changes() {
+        let mut planner = DStarLite::new(40, 40);
+        planner.set_start(2, 20);
+        planner.set_goal(37, 20);
+        planner.plan().unwrap();
+
+        let mut obstacles = Vec::new();
+        for y in 5..35 {
+            obstacles.push((20, y));
+            planner.set_obstacle(20, y);
+        }
+        let path = planner.plan().unwrap();
+        let expected = reference_length(&obstacles, 40, (2, 20), (37, 20)).unwrap();
+        assert!((DStarLite::path_length(&path) - expected).abs() < 1e-3 * expected);
+
+        // Open a gap and move the robot along the old path
+        for y in 18..23 {
+            obstacles.retain(|&cell| cell != (20, y));
+            planner.clear_obstacle(20, y);
+        }
+        planner.set_start(path[3].0, path[3].1);
+        let path = planner.plan().unwrap();
+        let expected = reference_length(&obstacles, 40, path[0], (37, 20)).unwrap();
+        assert!((DStarLite::path_length(&path) - expected).abs() < 1e-3 * expected);
+    }
+
+    #[test]
+    fn test_incremental_replan_is_cheaper() {
+        let mut planner = DStarLite::new(100, 100);
+        planner.set_start(5, 50);
+        planner.set_goal(95, 50);
+        planner.plan().unwrap();
+        let initial = planner.expansions();
+
+        // Block a cell far behind the goal: almost nothing should change
+        planner.set_obstacle(98, 5);
+        planner.plan().unwrap();
+        assert!(planner.expansions() < initial / 10);
+    }
+
+    #[test]
+    fn test_no_path() {
+        let mut planner = DStarLite::new(10, 10);
+        planner.set_start(0, 0);
+        planner.set_goal(9, 9);
+        assert!(planner.plan().is_some());
+
+        for y in 0..10 {
+            planner.set_obstacle(5, y);
+        }
+        assert!(planner.plan().is_none());
+
+        planner.clear_obstacle(5, 9);
+        assert!(planner.plan().is_some());
+    }
+
+    #[test]
+    fn test_load_occupancy_diff() {
+        let mut planner = DStarLite::new(3, 3);
+        planner.set_start(0, 2);
+        planner.set_goal(2, 2);
+        assert_eq!(planner.plan().unwrap().len(), 3);
+
+        let data = [0, 100, 0, 0, 100, 0, 0, 100, 0];
+        planner.load_occupancy(&data, 50);
+        assert!(planner.plan().is_none());
+    }
+}
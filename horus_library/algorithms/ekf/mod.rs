@@ -11,6 +11,7 @@
 //! - Prediction and update steps
 //! - Configurable process and measurement noise
 //! - Handles nonlinear motion models
+//! - Built on the const-generic `kalman::Ekf` (Cholesky gain, Joseph-form update)
 //!
 //! # Example
 //!
@@ -29,97 +30,77 @@
 //! ekf.update_odometry([1.0, 0.5, 0.1]);  // x, y, theta measurements
 //! ```
 
+use crate::algorithms::kalman::{Ekf, Matrix};
+
 /// Extended Kalman Filter for 2D Robot Localization
 ///
 /// State vector: [x, y, theta, vx, vy, omega]
 pub struct EKF {
-    /// State vector: [x, y, theta, vx, vy, omega]
-    state: [f64; 6],
-
-    /// State covariance matrix (6x6)
-    covariance: [[f64; 6]; 6],
-
-    /// Process noise covariance (6x6)
-    process_noise: [[f64; 6]; 6],
-
-    /// Measurement noise covariance for odometry (3x3)
-    odometry_noise: [[f64; 3]; 3],
+    /// State, covariance, process noise (per second) and odometry noise
+    filter: Ekf<6, 3>,
 }
 
 impl EKF {
     /// Create new EKF with default parameters
     pub fn new() -> Self {
-        let mut ekf = Self {
-            state: [0.0; 6],
-            covariance: [[0.0; 6]; 6],
-            process_noise: [[0.0; 6]; 6],
-            odometry_noise: [[0.0; 3]; 3],
-        };
-
-        // Initialize covariance (high initial uncertainty)
-        for i in 0..6 {
-            ekf.covariance[i][i] = 1.0;
+        Self {
+            filter: Ekf::new(
+                [0.0; 6],
+                // High initial uncertainty
+                Matrix::identity(),
+                // x, y, theta, vx, vy, omega
+                Matrix::from_diagonal([0.1, 0.1, 0.05, 0.2, 0.2, 0.1]),
+                // x, y, theta measurements
+                Matrix::from_diagonal([0.05, 0.05, 0.02]),
+            ),
         }
-
-        // Initialize process noise
-        ekf.process_noise[0][0] = 0.1; // x
-        ekf.process_noise[1][1] = 0.1; // y
-        ekf.process_noise[2][2] = 0.05; // theta
-        ekf.process_noise[3][3] = 0.2; // vx
-        ekf.process_noise[4][4] = 0.2; // vy
-        ekf.process_noise[5][5] = 0.1; // omega
-
-        // Initialize odometry noise
-        ekf.odometry_noise[0][0] = 0.05; // x measurement
-        ekf.odometry_noise[1][1] = 0.05; // y measurement
-        ekf.odometry_noise[2][2] = 0.02; // theta measurement
-
-        ekf
     }
 
     /// Set state vector
     pub fn set_state(&mut self, state: [f64; 6]) {
-        self.state = state;
+        self.filter.x = state;
     }
 
     /// Get state vector
     pub fn get_state(&self) -> [f64; 6] {
-        self.state
+        self.filter.x
     }
 
     /// Get pose (x, y, theta)
     pub fn get_pose(&self) -> (f64, f64, f64) {
-        (self.state[0], self.state[1], self.state[2])
+        let x = &self.filter.x;
+        (x[0], x[1], x[2])
     }
 
     /// Get velocity (vx, vy, omega)
     pub fn get_velocity(&self) -> (f64, f64, f64) {
-        (self.state[3], self.state[4], self.state[5])
+        let x = &self.filter.x;
+        (x[3], x[4], x[5])
     }
 
     /// Get position uncertainty (std dev)
     pub fn get_position_uncertainty(&self) -> f64 {
-        (self.covariance[0][0] + self.covariance[1][1]).sqrt()
+        (self.filter.p[(0, 0)] + self.filter.p[(1, 1)]).sqrt()
     }
 
     /// Set covariance matrix
     pub fn set_covariance(&mut self, covariance: [[f64; 6]; 6]) {
-        self.covariance = covariance;
+        self.filter.p = Matrix(covariance);
     }
 
     /// Get covariance matrix
     pub fn get_covariance(&self) -> [[f64; 6]; 6] {
-        self.covariance
+        self.filter.p.0
     }
 
     /// Set process noise covariance
     pub fn set_process_noise(&mut self, noise: [[f64; 6]; 6]) {
-        self.process_noise = noise;
+        self.filter.q = Matrix(noise);
     }
 
     /// Set odometry measurement noise
     pub fn set_odometry_noise(&mut self, noise: [[f64; 3]; 3]) {
-        self.odometry_noise = noise;
+        self.filter.r = Matrix(noise);
     }
 
     /// Prediction step (time update)
@@ -129,113 +110,47 @@ impl EKF {
     /// y(k+1) = y(k) + vy*dt
     /// theta(k+1) = theta(k) + omega*dt
     pub fn predict(&mut self, dt: f64) {
-        // Predict state using motion model
-        let old_state = self.state;
-
-        self.state[0] += old_state[3] * dt; // x += vx * dt
-        self.state[1] += old_state[4] * dt; // y += vy * dt
-        self.state[2] += old_state[5] * dt; // theta += omega * dt
-
-        // Normalize angle
-        self.state[2] = normalize_angle(self.state[2]);
+        // Motion model Jacobian: identity with dt coupling pose to velocity
+        let mut f = Matrix::<6, 6>::identity();
+        for i in 0..3 {
+            f[(i, i + 3)] = dt;
+        }
 
-        // Velocities remain constant
-        // state[3], state[4], state[5] unchanged
+        let mut state = f.mul_vec(&self.filter.x);
+        state[2] = normalize_angle(state[2]);
 
-        // Predict covariance: P = P + Q*dt
-        for i in 0..6 {
-            for j in 0..6 {
-                self.covariance[i][j] += self.process_noise[i][j] * dt;
-            }
-        }
+        // P = F*P*F' + Q*dt
+        let q = self.filter.q.scale(dt);
+        self.filter.predict_with_noise(state, &f, &q);
     }
 
     /// Update step with odometry measurement
     ///
-    /// Measurement: [x, y, theta]
+    /// Measurement: [x, y, theta]. A measurement whose innovation covariance
+    /// is not positive definite is ignored.
     pub fn update_odometry(&mut self, measurement: [f64; 3]) {
-        // Measurement prediction (expected measurement from state)
-        let predicted = [self.state[0], self.state[1], self.state[2]];
-
-        // Innovation (measurement residual)
-        let mut innovation = [0.0; 3];
+        let x = &self.filter.x;
+        let innovation = [
+            measurement[0] - x[0],
+            measurement[1] - x[1],
+            normalize_angle(measurement[2] - x[2]),
+        ];
+
+        // Direct pose measurement: H = [I_3x3 | 0_3x3]
+        let mut h = Matrix::<3, 6>::zeros();
         for i in 0..3 {
-            innovation[i] = measurement[i] - predicted[i];
+            h[(i, i)] = 1.0;
         }
 
-        // Normalize angle innovation
-        innovation[2] = normalize_angle(innovation[2]);
-
-        // Measurement Jacobian H (observation model derivative)
-        // For direct position measurement: H = [I_3x3 | 0_3x3]
-        let mut h = [[0.0; 6]; 3];
-        h[0][0] = 1.0;
-        h[1][1] = 1.0;
-        h[2][2] = 1.0;
-
-        // Innovation covariance: S = H*P*H' + R
-        let mut s = [[0.0; 3]; 3];
-        for i in 0..3 {
-            for j in 0..3 {
-                s[i][j] = self.odometry_noise[i][j];
-                for k in 0..6 {
-                    s[i][j] += h[i][k] * self.covariance[k][j];
-                }
-            }
-        }
-
-        // Kalman gain: K = P*H' * inv(S)
-        let s_inv = invert_3x3(s);
-        let mut kalman_gain = [[0.0; 3]; 6];
-        for i in 0..6 {
-            for j in 0..3 {
-                for k in 0..3 {
-                    kalman_gain[i][j] += self.covariance[i][k] * h[k][j] * s_inv[k][j];
-                }
-            }
-        }
-
-        // State update: x = x + K*innovation
-        for i in 0..6 {
-            for j in 0..3 {
-                self.state[i] += kalman_gain[i][j] * innovation[j];
-            }
-        }
-
-        // Normalize angle
-        self.state[2] = normalize_angle(self.state[2]);
-
-        // Covariance update: P = (I - K*H) * P
-        let mut i_kh = [[0.0; 6]; 6];
-        for i in 0..6 {
-            i_kh[i][i] = 1.0;
-            for j in 0..6 {
-                for k in 0..3 {
-                    i_kh[i][j] -= kalman_gain[i][k] * h[k][j];
-                }
-            }
-        }
-
-        let old_cov = self.covariance;
-        for i in 0..6 {
-            for j in 0..6 {
-                self.covariance[i][j] = 0.0;
-                for k in 0..6 {
-                    self.covariance[i][j] += i_kh[i][k] * old_cov[k][j];
-                }
-            }
+        if self.filter.update(&innovation, &h).is_ok() {
+            self.filter.x[2] = normalize_angle(self.filter.x[2]);
         }
     }
 
     /// Reset EKF to initial state
     pub fn reset(&mut self) {
-        self.state = [0.0; 6];
-
-        for i in 0..6 {
-            for j in 0..6 {
-                self.covariance[i][j] = if i == j { 1.0 } else { 0.0 };
-            }
-        }
+        self.filter.x = [0.0; 6];
+        self.filter.p = Matrix::identity();
     }
 }
 
@@ -257,38 +172,6 @@ fn normalize_angle(angle: f64) -> f64 {
     a
 }
 
-/// Invert 3x3 matrix (simplified for covariance matrices)
-fn invert_3x3(m: [[f64; 3]; 3]) -> [[f64; 3]; 3] {
-    let det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
-        - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
-        + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
-
-    if det.abs() < 1e-10 {
-        // Return identity if not invertible
-        return [[1.0, 0.0, 0.0], [0.0, 1.0, 0.0], [0.0, 0.0, 1.0]];
-    }
-
-    let inv_det = 1.0 / det;
-
-    [
-        [
-            (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * inv_det,
-            (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det,
-            (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det,
-        ],
-        [
-            (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * inv_det,
-            (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det,
-            (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det,
-        ],
-        [
-            (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * inv_det,
-            (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det,
-            (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det,
-        ],
-    ]
-}
-
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -0,0 +1,710 @@
+//! Image Preprocessing for Neural Network Inference
+//!
+//! Fused resize + color conversion + normalization + HWC→NCHW kernel that
+//! writes straight into a caller-owned `f32` input tensor.
+//!
+//! # Features
+//!
+//! - Nearest-neighbor and bilinear (fixed-point) resize
+//! - RGB/BGR/RGBA/BGRA/Mono8 sources, RGB or BGR planar output
+//! - Per-channel `(x / 255 - mean) / std` in a single multiply-add
+//! - SIMD conversion (AVX2+FMA, SSE2, NEON) with a scalar fallback,
+//!   selected once at construction
+//! - Optional row parallelism with the `parallel` feature
+//! - No allocation per frame: lookup tables and scratch rows are reused
+//!   until the source or target size changes
+//!
+//! Each output row is produced in two steps: the resize gathers the source
+//! pixels into a planar `u8` scratch row (doing the color swizzle for free),
+//! then the vector kernel widens that row to `f32`, applies the channel's
+//! scale and bias and stores it into the matching NCHW plane.
+//!
+//! # Example
+//!
+//! ```rust
+//! use horus_library::algorithms::image_preprocess::{PixelFormat, PreprocessConfig, Preprocessor};
+//!
+//! let mut pre = Preprocessor::new(PreprocessConfig::imagenet(224, 224));
+//! let frame = vec![128u8; 640 * 480 * 3];
+//! let mut tensor = vec![0.0f32; pre.output_len()];
+//!
+//! pre.run(&frame, 640, 480, 0, PixelFormat::Rgb8, &mut tensor).unwrap();
+//! ```
+
+use crate::messages::vision::ImageEncoding;
+
+/// Source pixel layout
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum PixelFormat {
+    Rgb8,
+    Bgr8,
+    Rgba8,
+    Bgra8,
+    Mono8,
+}
+
+impl PixelFormat {
+    /// Layout for an 8-bit image encoding, if supported
+    pub fn from_encoding(encoding: ImageEncoding) -> Option<Self> {
+        match encoding {
+            ImageEncoding::Rgb8 => Some(PixelFormat::Rgb8),
+            ImageEncoding::Bgr8 => Some(PixelFormat::Bgr8),
+            ImageEncoding::Rgba8 => Some(PixelFormat::Rgba8),
+            ImageEncoding::Bgra8 => Some(PixelFormat::Bgra8),
+            ImageEncoding::Mono8 => Some(PixelFormat::Mono8),
+            _ => None,
+        }
+    }
+
+    /// Bytes per source pixel
+    pub fn bytes_per_pixel(self) -> usize {
+        match self {
+            PixelFormat::Rgb8 | PixelFormat::Bgr8 => 3,
+            PixelFormat::Rgba8 | PixelFormat::Bgra8 => 4,
+            PixelFormat::Mono8 => 1,
+        }
+    }
+
+    /// Byte offset of R, G and B within a source pixel
+    fn rgb_offsets(self) -> [usize; 3] {
+        match self {
+            PixelFormat::Rgb8 | PixelFormat::Rgba8 => [0, 1, 2],
+            PixelFormat::Bgr8 | PixelFormat::Bgra8 => [2, 1, 0],
+            PixelFormat::Mono8 => [0, 0, 0],
+        }
+    }
+}
+
+/// Resize interpolation
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum ResizeFilter {
+    Nearest,
+    Bilinear,
+}
+
+/// Preprocessing configuration
+#[derive(Debug, Clone)]
+pub struct PreprocessConfig {
+    /// Output width
+    pub width: usize,
+    /// Output height
+    pub height: usize,
+    /// Per-channel mean, in output channel order, on the 0..1 scale
+    pub mean: [f32; 3],
+    /// Per-channel standard deviation, in output channel order
+    pub std: [f32; 3],
+    /// Emit planes as B, G, R instead of R, G, B
+    pub bgr_output: bool,
+    /// Resize interpolation
+    pub filter: ResizeFilter,
+    /// Output pixel count above which rows are processed in parallel
+    /// (only with the `parallel` feature)
+    pub parallel_min_pixels: usize,
+}
+
+impl PreprocessConfig {
+    /// Scale to 0..1 without mean/std normalization
+    pub fn unit(width: usize, height: usize) -> Self {
+        Self {
+            width,
+            height,
+            mean: [0.0; 3],
+            std: [1.0; 3],
+            bgr_output: false,
+            filter: ResizeFilter::Nearest,
+            parallel_min_pixels: 512 * 512,
+        }
+    }
+
+    /// ImageNet mean/std normalization
+    pub fn imagenet(width: usize, height: usize) -> Self {
+        Self {
+            mean: [0.485, 0.456, 0.406],
+            std: [0.229, 0.224, 0.225],
+            ..Self::unit(width, height)
+        }
+    }
+}
+
+/// Vector kernel used for the u8 → f32 affine pass
+///
+/// Every variant for the target architecture can be named, but a SIMD
+/// variant only runs when the CPU supports it; see [`Kernel::is_supported`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Kernel {
+    Scalar,
+    #[cfg(target_arch = "x86_64")]
+    Sse2,
+    #[cfg(target_arch = "x86_64")]
+    Avx2,
+    #[cfg(target_arch = "aarch64")]
+    Neon,
+}
+
+impl Kernel {
+    /// Best kernel supported by the running CPU
+    pub fn detect() -> Self {
+        #[cfg(target_arch = "x86_64")]
+        {
+            if is_x86_feature_detected!("avx2") && is_x86_feature_detected!("fma") {
+                return Kernel::Avx2;
+            }
+            Kernel::Sse2
+        }
+        #[cfg(target_arch = "aarch64")]
+        {
+            Kernel::Neon
+        }
+        #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+        {
+            Kernel::Scalar
+        }
+    }
+
+    /// Whether the running CPU has the instructions this kernel needs
+    pub fn is_supported(self) -> bool {
+        match self {
+            Kernel::Scalar => true,
+            #[cfg(target_arch = "x86_64")]
+            Kernel::Sse2 => is_x86_feature_detected!("sse2"),
+            #[cfg(target_arch = "x86_64")]
+            Kernel::Avx2 => is_x86_feature_detected!("avx2") && is_x86_feature_detected!("fma"),
+            #[cfg(target_arch = "aarch64")]
+            Kernel::Neon => std::arch::is_aarch64_feature_detected!("neon"),
+        }
+    }
+
+    /// `dst[i] = src[i] as f32 * scale + bias`
+    ///
+    /// Falls back to the scalar kernel if the CPU lacks this one.
+    #[inline]
+    pub fn affine(self, src: &[u8], dst: &mut [f32], scale: f32, bias: f32) {
+        assert_eq!(src.len(), dst.len());
+        // Feature detection is cached, so this check is a load per call
+        let kernel = if self.is_supported() {
+            self
+        } else {
+            Kernel::Scalar
+        };
+        match kernel {
+            Kernel::Scalar => affine_scalar(src, dst, scale, bias),
+            // SAFETY: `is_supported` confirmed the CPU has the required features
+            #[cfg(target_arch = "x86_64")]
+            Kernel::Sse2 => unsafe { affine_sse2(src, dst, scale, bias) },
+            #[cfg(target_arch = "x86_64")]
+            Kernel::Avx2 => unsafe { affine_avx2(src, dst, scale, bias) },
+            #[cfg(target_arch = "aarch64")]
+            Kernel::Neon => unsafe { affine_neon(src, dst, scale, bias) },
+        }
+    }
+}
+
+#[inline]
+fn affine_scalar(src: &[u8], dst: &mut [f32], scale: f32, bias: f32) {
+    for (d, &s) in dst.iter_mut().zip(src) {
+        *d = s as f32 * scale + bias;
+    }
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "sse2")]
+unsafe fn affine_sse2(src: &[u8], dst: &mut [f32], scale: f32, bias: f32) {
+    use std::arch::x86_64::*;
+
+    let n = src.len();
+    let vs = _mm_set1_ps(scale);
+    let vb = _mm_set1_ps(bias);
+    let zero = _mm_setzero_si128();
+    let mut i = 0;
+    while i + 16 <= n {
+        let bytes = _mm_loadu_si128(src.as_ptr().add(i) as *const __m128i);
+        let lo = _mm_unpacklo_epi8(bytes, zero);
+        let hi = _mm_unpackhi_epi8(bytes, zero);
+        let quads = [
+            _mm_unpacklo_epi16(lo, zero),
+            _mm_unpackhi_epi16(lo, zero),
+            _mm_unpacklo_epi16(hi, zero),
+            _mm_unpackhi_epi16(hi, zero),
+        ];
+        for (q, ints) in quads.into_iter().enumerate() {
+            let f = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(ints), vs), vb);
+            _mm_storeu_ps(dst.as_mut_ptr().add(i + q * 4), f);
+        }
+        i += 16;
+    }
+    affine_scalar(&src[i..], &mut dst[i..], scale, bias);
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,fma")]
+unsafe fn affine_avx2(src: &[u8], dst: &mut [f32], scale: f32, bias: f32) {
+    use std::arch::x86_64::*;
+
+    let n = src.len();
+    let vs = _mm256_set1_ps(scale);
+    let vb = _mm256_set1_ps(bias);
+    let mut i = 0;
+    while i + 16 <= n {
+        let bytes = _mm_loadu_si128(src.as_ptr().add(i) as *const __m128i);
+        let lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+        let hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+        _mm256_storeu_ps(dst.as_mut_ptr().add(i), _mm256_fmadd_ps(lo, vs, vb));
+        _mm256_storeu_ps(dst.as_mut_ptr().add(i + 8), _mm256_fmadd_ps(hi, vs, vb));
+        i += 16;
+    }
+    affine_scalar(&src[i..], &mut dst[i..], scale, bias);
+}
+
+#[cfg(target_arch = "aarch64")]
+#[target_feature(enable = "neon")]
+unsafe fn affine_neon(src: &[u8], dst: &mut [f32], scale: f32, bias: f32) {
+    use std::arch::aarch64::*;
+
+    let n = src.len();
+    let vs = vdupq_n_f32(scale);
+    let vb = vdupq_n_f32(bias);
+    let mut i = 0;
+    while i + 8 <= n {
+        let wide = vmovl_u8(vld1_u8(src.as_ptr().add(i)));
+        let lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(wide)));
+        let hi = vcvtq_f32_u32(vmovl_high_u16(wide));
+        vst1q_f32(dst.as_mut_ptr().add(i), vfmaq_f32(vb, lo, vs));
+        vst1q_f32(dst.as_mut_ptr().add(i + 4), vfmaq_f32(vb, hi, vs));
+        i += 8;
+    }
+    affine_scalar(&src[i..], &mut dst[i..], scale, bias);
+}
+
+/// Fixed-point precision of bilinear weights
+const WEIGHT_BITS: u32 = 11;
+const WEIGHT_ONE: i32 = 1 << WEIGHT_BITS;
+
+/// Source sampling tables for one (source size, target size) pair
+#[derive(Default)]
+struct ResizeTables {
+    src_width: usize,
+    src_height: usize,
+    format: Option<PixelFormat>,
+    /// Byte offset of the left sample for each output column
+    x0: Vec<usize>,
+    /// Byte offset of the right sample (bilinear)
+    x1: Vec<usize>,
+    /// Weight of the right sample (bilinear)
+    wx: Vec<i32>,
+    /// Top source row for each output row
+    y0: Vec<usize>,
+    /// Bottom source row (bilinear)
+    y1: Vec<usize>,
+    /// Weight of the bottom row (bilinear)
+    wy: Vec<i32>,
+}
+
+/// Map output index `i` to a source coordinate and the fractional weight
+/// of the next sample, using pixel-center alignment
+fn sample(i: usize, src: usize, dst: usize, filter: ResizeFilter) -> (usize, usize, i32) {
+    let ratio = src as f32 / dst as f32;
+    let center = (i as f32 + 0.5) * ratio;
+    match filter {
+        ResizeFilter::Nearest => ((center as usize).min(src - 1), 0, 0),
+        ResizeFilter::Bilinear => {
+            let pos = (center - 0.5).max(0.0);
+            let lo = (pos as usize).min(src - 1);
+            let hi = (lo + 1).min(src - 1);
+            let w = ((pos - lo as f32) * WEIGHT_ONE as f32).round() as i32;
+            (lo, hi, w.clamp(0, WEIGHT_ONE))
+        }
+    }
+}
+
+impl ResizeTables {
+    fn rebuild(
+        &mut self,
+        src_width: usize,
+        src_height: usize,
+        format: PixelFormat,
+        config: &PreprocessConfig,
+    ) {
+        if self.src_width == src_width
+            && self.src_height == src_height
+            && self.format == Some(format)
+        {
+            return;
+        }
+        let bpp = format.bytes_per_pixel();
+
+        self.x0.clear();
+        self.x1.clear();
+        self.wx.clear();
+        for x in 0..config.width {
+            let (lo, hi, w) = sample(x, src_width, config.width, config.filter);
+            self.x0.push(lo * bpp);
+            self.x1.push(hi * bpp);
+            self.wx.push(w);
+        }
+
+        self.y0.clear();
+        self.y1.clear();
+        self.wy.clear();
+        for y in 0..config.height {
+            let (lo, hi, w) = sample(y, src_height, config.height, config.filter);
+            self.y0.push(lo);
+            self.y1.push(hi);
+            self.wy.push(w);
+        }
+
+        self.src_width = src_width;
+        self.src_height = src_height;
+        self.format = Some(format);
+    }
+}
+
+/// Reusable preprocessing pipeline
+pub struct Preprocessor {
+    config: PreprocessConfig,
+    kernel: Kernel,
+    tables: ResizeTables,
+    /// Planar u8 scratch rows, one per output row so rows can run in parallel
+    scratch: Vec<u8>,
+    /// Per output plane `scale` and `bias`
+    affine: [(f32, f32); 3],
+}
+
+/// Source image view shared by the row workers
+struct Source<'a> {
+    data: &'a [u8],
+    step: usize,
+    offsets: [usize; 3],
+}
+
+impl Preprocessor {
+    /// Create a preprocessor using the best kernel for this CPU
+    pub fn new(config: PreprocessConfig) -> Self {
+        let affine = std::array::from_fn(|c| {
+            let std = if config.std[c] == 0.0 {
+                1.0
+            } else {
+                config.std[c]
+            };
+            (1.0 / (255.0 * std), -config.mean[c] / std)
+        });
+        Self {
+            scratch: vec![0; 3 * config.width * config.height],
+            config,
+            kernel: Kernel::detect(),
+            tables: ResizeTables::default(),
+            affine,
+        }
+    }
+
+    /// Force a specific kernel (e.g. `Kernel::Scalar` for comparison)
+    ///
+    /// Fails, keeping the current kernel, if the CPU does not support it.
+    pub fn set_kernel(&mut self, kernel: Kernel) -> Result<(), &'static str> {
+        if !kernel.is_supported() {
+            return Err("Kernel is not supported by this CPU");
+        }
+        self.kernel = kernel;
+        Ok(())
+    }
+
+    /// Kernel in use
+    pub fn kernel(&self) -> Kernel {
+        self.kernel
+    }
+
+    /// Configuration
+    pub fn config(&self) -> &PreprocessConfig {
+        &self.config
+    }
+
+    /// Length of the NCHW output tensor (batch of one)
+    pub fn output_len(&self) -> usize {
+        3 * self.config.width * self.config.height
+    }
+
+    /// Output tensor shape `[1, 3, height, width]`
+    pub fn output_shape(&self) -> [usize; 4] {
+        [1, 3, self.config.height, self.config.width]
+    }
+
+    /// Resize, convert and normalize `src` into `out` (NCHW)
+    ///
+    /// `step` is the source row stride in bytes (0 for tightly packed).
+    pub fn run(
+        &mut self,
+        src: &[u8],
+        src_width: usize,
+        src_height: usize,
+        step: usize,
+        format: PixelFormat,
+        out: &mut [f32],
+    ) -> Result<(), &'static str> {
+        let source = self.prepare(src, src_width, src_height, step, format)?;
+        if out.len() != self.output_len() {
+            return Err("Output tensor has the wrong length");
+        }
+
+        let (w, h) = (self.config.width, self.config.height);
+        let plane = w * h;
+        let (p0, rest) = out.split_at_mut(plane);
+        let (p1, p2) = rest.split_at_mut(plane);
+
+        let tables = &self.tables;
+        let filter = self.config.filter;
+        let kernel = self.kernel;
+        let affine = self.affine;
+        let row = |y: usize, scratch: &mut [u8], r0: &mut [f32], r1: &mut [f32], r2: &mut [f32]| {
+            gather_row(&source, tables, filter, y, scratch);
+            let (s0, rest) = scratch.split_at(w);
+            let (s1, s2) = rest.split_at(w);
+            kernel.affine(s0, r0, affine[0].0, affine[0].1);
+            kernel.affine(s1, r1, affine[1].0, affine[1].1);
+            kernel.affine(s2, r2, affine[2].0, affine[2].1);
+        };
+
+        #[cfg(feature = "parallel")]
+        if plane >= self.config.parallel_min_pixels {
+            use rayon::prelude::*;
+            self.scratch
+                .par_chunks_mut(3 * w)
+                .zip(p0.par_chunks_mut(w))
+                .zip(p1.par_chunks_mut(w))
+                .zip(p2.par_chunks_mut(w))
+                .enumerate()
+                .for_each(|(y, (((s, r0), r1), r2))| row(y, s, r0, r1, r2));
+            return Ok(());
+        }
+
+        // Serially, one scratch row stays hot in L1
+        let scratch = &mut self.scratch[..3 * w];
+        for (y, ((r0, r1), r2)) in p0
+            .chunks_mut(w)
+            .zip(p1.chunks_mut(w))
+            .zip(p2.chunks_mut(w))
+            .enumerate()
+        {
+            row(y, scratch, r0, r1, r2);
+        }
+        Ok(())
+    }
+
+    /// Resize and convert only, producing interleaved `u8` in the output
+    /// channel order (3 bytes per pixel)
+    pub fn resize_into(
+        &mut self,
+        src: &[u8],
+        src_width: usize,
+        src_height: usize,
+        step: usize,
+        format: PixelFormat,
+        out: &mut [u8],
+    ) -> Result<(), &'static str> {
+        let source = self.prepare(src, src_width, src_height, step, format)?;
+        let w = self.config.width;
+        if out.len() != 3 * w * self.config.height {
+            return Err("Output buffer has the wrong length");
+        }
+
+        let scratch = &mut self.scratch[..3 * w];
+        for (y, dst) in out.chunks_mut(3 * w).enumerate() {
+            gather_row(&source, &self.tables, self.config.filter, y, scratch);
+            for (x, px) in dst.chunks_exact_mut(3).enumerate() {
+                px[0] = scratch[x];
+                px[1] = scratch[w + x];
+                px[2] = scratch[2 * w + x];
+            }
+        }
+        Ok(())
+    }
+
+    fn prepare<'a>(
+        &mut self,
+        src: &'a [u8],
+        src_width: usize,
+        src_height: usize,
+        step: usize,
+        format: PixelFormat,
+    ) -> Result<Source<'a>, &'static str> {
+        if src_width == 0 || src_height == 0 || self.config.width == 0 || self.config.height == 0 {
+            return Err("Image dimensions must be non-zero");
+        }
+        let row_bytes = src_width * format.bytes_per_pixel();
+        let step = if step == 0 { row_bytes } else { step };
+        if step < row_bytes || src.len() < step * (src_height - 1) + row_bytes {
+            return Err("Source buffer is smaller than its dimensions");
+        }
+
+        self.tables
+            .rebuild(src_width, src_height, format, &self.config);
+
+        let mut offsets = format.rgb_offsets();
+        if self.config.bgr_output {
+            offsets.swap(0, 2);
+        }
+        Ok(Source {
+            data: src,
+            step,
+            offsets,
+        })
+    }
+}
+
+/// Sample output row `y` into `scratch` as three planar channel rows
+#[inline]
+fn gather_row(
+    src: &Source<'_>,
+    tables: &ResizeTables,
+    filter: ResizeFilter,
+    y: usize,
+    scratch: &mut [u8],
+) {
+    let w = tables.x0.len();
+    let top = &src.data[tables.y0[y] * src.step..];
+    let [o0, o1, o2] = src.offsets;
+    let (s0, rest) = scratch.split_at_mut(w);
+    let (s1, s2) = rest.split_at_mut(w);
+
+    match filter {
+        ResizeFilter::Nearest => {
+            for (x, &off) in tables.x0.iter().enumerate() {
+                s0[x] = top[off + o0];
+                s1[x] = top[off + o1];
+                s2[x] = top[off + o2];
+            }
+        }
+        ResizeFilter::Bilinear => {
+            let bottom = &src.data[tables.y1[y] * src.step..];
+            let wy = tables.wy[y];
+            let lerp = |x: usize, o: usize| -> u8 {
+                let (a, b, wx) = (tables.x0[x] + o, tables.x1[x] + o, tables.wx[x]);
+                let t = top[a] as i32 * (WEIGHT_ONE - wx) + top[b] as i32 * wx;
+                let u = bottom[a] as i32 * (WEIGHT_ONE - wx) + bottom[b] as i32 * wx;
+                let v = t * (WEIGHT_ONE - wy) + u * wy;
+                ((v + (1 << (2 * WEIGHT_BITS - 1))) >> (2 * WEIGHT_BITS)) as u8
+            };
+            for x in 0..w {
+                s0[x] = lerp(x, o0);
+                s1[x] = lerp(x, o1);
+                s2[x] = lerp(x, o2);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn gradient(w: usize, h: usize, bpp: usize) -> Vec<u8> {
+        (0..w * h * bpp).map(|i| (i * 7 % 251) as u8).collect()
+    }
+
+    #[test]
+    fn test_kernels_match_scalar() {
+        let src: Vec<u8> = (0..=255).chain(0..37).collect();
+        let mut expected = vec![0.0; src.len()];
+        let mut actual = vec![0.0; src.len()];
+        affine_scalar(&src, &mut expected, 0.017, -2.1);
+        Kernel::detect().affine(&src, &mut actual, 0.017, -2.1);
+        for (a, e) in actual.iter().zip(&expected) {
+            assert!((a - e).abs() < 1e-5);
+        }
+    }
+
+    #[test]
+    fn test_set_kernel_rejects_unsupported() {
+        let mut pre = Preprocessor::new(PreprocessConfig::unit(4, 4));
+        assert_eq!(pre.kernel(), Kernel::detect());
+        assert!(Kernel::detect().is_supported());
+
+        pre.set_kernel(Kernel::Scalar).unwrap();
+        assert_eq!(pre.kernel(), Kernel::Scalar);
+
+        #[cfg(target_arch = "x86_64")]
+        {
+            let avx2 = is_x86_feature_detected!("avx2") && is_x86_feature_detected!("fma");
+            assert_eq!(pre.set_kernel(Kernel::Avx2).is_ok(), avx2);
+            assert_eq!(pre.kernel() == Kernel::Avx2, avx2);
+        }
+    }
+
+    #[test]
+    fn test_identity_size_is_normalized_nchw() {
+        let (w, h) = (5, 3);
+        let src = gradient(w, h, 3);
+        let mut pre = Preprocessor::new(PreprocessConfig::imagenet(w, h));
+        let mut out = vec![0.0; pre.output_len()];
+        pre.run(&src, w, h, 0, PixelFormat::Rgb8, &mut out).unwrap();
+
+        let cfg = pre.config().clone();
+        for c in 0..3 {
+            for y in 0..h {
+                for x in 0..w {
+                    let v = src[(y * w + x) * 3 + c] as f32 / 255.0;
+                    let expected = (v - cfg.mean[c]) / cfg.std[c];
+                    let got = out[c * w * h + y * w + x];
+                    assert!((got - expected).abs() < 1e-4, "c={} y={} x={}", c, y, x);
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_bgra_source_with_stride() {
+        // 2x2 BGRA with 4 bytes of row padding
+        let step = 2 * 4 + 4;
+        let mut src = vec![0u8; step * 2];
+        src[0..4].copy_from_slice(&[10, 20, 30, 255]);
+        src[step..step + 4].copy_from_slice(&[40, 50, 60, 255]);
+
+        let mut pre = Preprocessor::new(PreprocessConfig::unit(2, 2));
+        let mut out = vec![0u8; 12];
+        pre.resize_into(&src, 2, 2, step, PixelFormat::Bgra8, &mut out)
+            .unwrap();
+        assert_eq!(&out[0..3], &[30, 20, 10]);
+        assert_eq!(&out[6..9], &[60, 50, 40]);
+
+        assert!(pre
+            .resize_into(&src[..step], 2, 2, step, PixelFormat::Bgra8, &mut out)
+            .is_err());
+    }
+
+    #[test]
+    fn test_resize_downscale() {
+        let (w, h) = (64, 48);
+        let src = gradient(w, h, 3);
+
+        for filter in [ResizeFilter::Nearest, ResizeFilter::Bilinear] {
+            let mut cfg = PreprocessConfig::unit(16, 12);
+            cfg.filter = filter;
+            let mut pre = Preprocessor::new(cfg);
+
+            let mut bytes = vec![0u8; 16 * 12 * 3];
+            pre.resize_into(&src, w, h, 0, PixelFormat::Rgb8, &mut bytes)
+                .unwrap();
+            let mut tensor = vec![0.0; pre.output_len()];
+            pre.run(&src, w, h, 0, PixelFormat::Rgb8, &mut tensor)
+                .unwrap();
+
+            // The fused path must agree with resize + separate conversion
+            for (i, px) in bytes.chunks(3).enumerate() {
+                for c in 0..3 {
+                    let got = tensor[c * 16 * 12 + i];
+                    assert!((got - px[c] as f32 / 255.0).abs() < 1e-5);
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_bilinear_constant_image() {
+        let src = vec![77u8; 37 * 23];
+        let mut cfg = PreprocessConfig::unit(50, 31);
+        cfg.filter = ResizeFilter::Bilinear;
+        let mut pre = Preprocessor::new(cfg);
+        let mut out = vec![0u8; 50 * 31 * 3];
+        pre.resize_into(&src, 37, 23, 0, PixelFormat::Mono8, &mut out)
+            .unwrap();
+        assert!(out.iter().all(|&v| v == 77));
+    }
+}
@@ -0,0 +1,831 @@
+//! Structure-of-arrays bank of identical linear Kalman filters
+//!
+//! A multi-target tracker runs one small filter per object, all with the
+//! same motion and measurement model. Stepping them one by one spends most of
+//! the time on loop overhead and shuffling 4x4 matrices. The bank instead
+//! stores element `(i, j)` of every filter's covariance contiguously (one
+//! "lane" per filter), so each matrix operation becomes a handful of
+//! element-wise passes over all filters at once. Shared model matrices are
+//! scalars broadcast across the lanes, and their zero entries are skipped.
+//!
+//! The lane passes run on AVX2+FMA (x86_64) or NEON (aarch64), selected once
+//! at construction, with a scalar fallback for the tails and other targets.
+
+use super::matrix::Matrix;
+
+/// Vector kernel for the lane passes
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum LaneKernel {
+    Scalar,
+    #[cfg(target_arch = "x86_64")]
+    Avx2,
+    #[cfg(target_arch = "aarch64")]
+    Neon,
+}
+
+impl LaneKernel {
+    fn detect() -> Self {
+        #[cfg(target_arch = "x86_64")]
+        {
+            if is_x86_feature_detected!("avx2") && is_x86_feature_detected!("fma") {
+                return LaneKernel::Avx2;
+            }
+            LaneKernel::Scalar
+        }
+        #[cfg(target_arch = "aarch64")]
+        {
+            LaneKernel::Neon
+        }
+        #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+        {
+            LaneKernel::Scalar
+        }
+    }
+
+    /// `dst[l] += s * src[l]`
+    #[inline]
+    fn axpy(self, dst: &mut [f64], s: f64, src: &[f64]) {
+        debug_assert_eq!(dst.len(), src.len());
+        match self {
+            LaneKernel::Scalar => axpy_scalar(dst, s, src),
+            // SAFETY: the variant is only constructed when the CPU supports it
+            #[cfg(target_arch = "x86_64")]
+            LaneKernel::Avx2 => unsafe { axpy_avx2(dst, s, src) },
+            #[cfg(target_arch = "aarch64")]
+            LaneKernel::Neon => unsafe { axpy_neon(dst, s, src) },
+        }
+    }
+
+    /// `dst[l] += sign * a[l] * b[l]`, with `sign` = ±1
+    #[inline]
+    fn fma(self, dst: &mut [f64], a: &[f64], b: &[f64], negate: bool) {
+        debug_assert!(dst.len() == a.len() && a.len() == b.len());
+        match self {
+            LaneKernel::Scalar => fma_scalar(dst, a, b, negate),
+            // SAFETY: the variant is only constructed when the CPU supports it
+            #[cfg(target_arch = "x86_64")]
+            LaneKernel::Avx2 => unsafe { fma_avx2(dst, a, b, negate) },
+            #[cfg(target_arch = "aarch64")]
+            LaneKernel::Neon => unsafe { fma_neon(dst, a, b, negate) },
+        }
+    }
+}
+
+#[inline]
+fn axpy_scalar(dst: &mut [f64], s: f64, src: &[f64]) {
+    for (d, x) in dst.iter_mut().zip(src) {
+        *d += s * x;
+    }
+}
+
+#[inline]
+fn fma_scalar(dst: &mut [f64], a: &[f64], b: &[f64], negate: bool) {
+    let sign = if negate { -1.0 } else { 1.0 };
+    for ((d, a), b) in dst.iter_mut().zip(a).zip(b) {
+        *d += sign * a * b;
+    }
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,fma")]
+unsafe fn axpy_avx2(dst: &mut [f64], s: f64, src: &[f64]) {
+    use std::arch::x86_64::*;
+
+    let n = dst.len();
+    let vs = _mm256_set1_pd(s);
+    let mut i = 0;
+    while i + 4 <= n {
+        let d = _mm256_loadu_pd(dst.as_ptr().add(i));
+        let x = _mm256_loadu_pd(src.as_ptr().add(i));
+        _mm256_storeu_pd(dst.as_mut_ptr().add(i), _mm256_fmadd_pd(vs, x, d));
+        i += 4;
+    }
+    axpy_scalar(&mut dst[i..], s, &src[i..]);
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,fma")]
+unsafe fn fma_avx2(dst: &mut [f64], a: &[f64], b: &[f64], negate: bool) {
+    use std::arch::x86_64::*;
+
+    let n = dst.len();
+    let mut i = 0;
+    while i + 4 <= n {
+        let d = _mm256_loadu_pd(dst.as_ptr().add(i));
+        let va = _mm256_loadu_pd(a.as_ptr().add(i));
+        let vb = _mm256_loadu_pd(b.as_ptr().add(i));
+        let r = if negate {
+            _mm256_fnmadd_pd(va, vb, d)
+        } else {
+            _mm256_fmadd_pd(va, vb, d)
+        };
+        _mm256_storeu_pd(dst.as_mut_ptr().add(i), r);
+        i += 4;
+    }
+    fma_scalar(&mut dst[i..], &a[i..], &b[i..], negate);
+}
+
+#[cfg(target_arch = "aarch64")]
+#[target_feature(enable = "neon")]
+unsafe fn axpy_neon(dst: &mut [f64], s: f64, src: &[f64]) {
+    use std::arch::aarch64::*;
+
+    let n = dst.len();
+    let vs = vdupq_n_f64(s);
+    let mut i = 0;
+    while i + 2 <= n {
+        let d = vld1q_f64(dst.as_ptr().add(i));
+        let x = vld1q_f64(src.as_ptr().add(i));
+        vst1q_f64(dst.as_mut_ptr().add(i), vfmaq_f64(d, vs, x));
+        i += 2;
+    }
+    axpy_scalar(&mut dst[i..], s, &src[i..]);
+}
+
+#[cfg(target_arch = "aarch64")]
+#[target_feature(enable = "neon")]
+unsafe fn fma_neon(dst: &mut [f64], a: &[f64], b: &[f64], negate: bool) {
+    use std::arch::aarch64::*;
+
+    let n = dst.len();
+    let mut i = 0;
+    while i + 2 <= n {
+        let d = vld1q_f64(dst.as_ptr().add(i));
+        let va = vld1q_f64(a.as_ptr().add(i));
+        let vb = vld1q_f64(b.as_ptr().add(i));
+        let r = if negate {
+            vfmsq_f64(d, va, vb)
+        } else {
+            vfmaq_f64(d, va, vb)
+        };
+        vst1q_f64(dst.as_mut_ptr().add(i), r);
+        i += 2;
+    }
+    fma_scalar(&mut dst[i..], &a[i..], &b[i..], negate);
+}
+
+/// `rows` lane rows of `stride` lanes each, stored back to back
+#[derive(Debug, Clone)]
+struct Lanes {
+    data: Vec<f64>,
+    stride: usize,
+}
+
+impl Lanes {
+    fn new(rows: usize, stride: usize) -> Self {
+        Self {
+            data: vec![0.0; rows * stride],
+            stride,
+        }
+    }
+
+    fn rows(&self) -> usize {
+        self.data.len() / self.stride
+    }
+
+    #[inline]
+    fn row(&self, r: usize, len: usize) -> &[f64] {
+        &self.data[r * self.stride..r * self.stride + len]
+    }
+
+    #[inline]
+    fn row_mut(&mut self, r: usize, len: usize) -> &mut [f64] {
+        &mut self.data[r * self.stride..r * self.stride + len]
+    }
+
+    /// Row `dst` mutably, plus everything before it (rows `< dst`)
+    #[inline]
+    fn split_before(&mut self, dst: usize, len: usize) -> (&mut [f64], &[f64]) {
+        let (head, tail) = self.data.split_at_mut(dst * self.stride);
+        (&mut tail[..len], head)
+    }
+
+    /// Row `dst` mutably, plus everything after it as rows `0..` relative to `dst + 1`
+    #[inline]
+    fn split_after(&mut self, dst: usize, len: usize) -> (&mut [f64], &[f64]) {
+        let (head, tail) = self.data.split_at_mut((dst + 1) * self.stride);
+        (&mut head[dst * self.stride..dst * self.stride + len], tail)
+    }
+
+    /// Copy row `src` over row `dst`
+    #[inline]
+    fn copy_row(&mut self, dst: usize, src: usize, len: usize) {
+        let s = src * self.stride;
+        self.data.copy_within(s..s + len, dst * self.stride);
+    }
+
+    /// Same rows with room for `stride` lanes, keeping the first `len`
+    fn regrow(&mut self, stride: usize, len: usize) {
+        let mut grown = Lanes::new(self.rows(), stride);
+        for r in 0..self.rows() {
+            grown.row_mut(r, len).copy_from_slice(self.row(r, len));
+        }
+        *self = grown;
+    }
+}
+
+/// Many linear Kalman filters with shared `F`, `Q`, `H`, `R`
+///
+/// Filters are addressed by index; `swap_remove` keeps storage dense when a
+/// track is dropped, like `Vec::swap_remove`.
+#[derive(Debug, Clone)]
+pub struct KalmanBank<const N: usize, const M: usize> {
+    f: Matrix<N, N>,
+    q: Matrix<N, N>,
+    h: Matrix<M, N>,
+    r: Matrix<M, M>,
+    kernel: LaneKernel,
+    len: usize,
+
+    x: Lanes,   // N rows
+    p: Lanes,   // N * N rows, row-major
+    nis: Lanes, // 1 row, from the last update
+
+    // Scratch, reused every step
+    tmp_x: Lanes, // N rows
+    tmp_p: Lanes, // N * N rows
+    a: Lanes,     // N * N rows: F P, then I - K H
+    y: Lanes,     // M rows: innovation, then S⁻¹ y
+    l: Lanes,     // M * M rows: chol(S), lower triangle
+    pht: Lanes,   // N * M rows: P Hᵀ, then K R
+    gain: Lanes,  // N * M rows
+    gate: Lanes,  // 1 row: 1.0 where the update applies
+}
+
+impl<const N: usize, const M: usize> KalmanBank<N, M> {
+    pub fn new(f: Matrix<N, N>, q: Matrix<N, N>, h: Matrix<M, N>, r: Matrix<M, M>) -> Self {
+        Self::with_capacity(f, q, h, r, 64)
+    }
+
+    pub fn with_capacity(
+        f: Matrix<N, N>,
+        q: Matrix<N, N>,
+        h: Matrix<M, N>,
+        r: Matrix<M, M>,
+        capacity: usize,
+    ) -> Self {
+        let stride = capacity.max(1);
+        Self {
+            f,
+            q,
+            h,
+            r,
+            kernel: LaneKernel::detect(),
+            len: 0,
+            x: Lanes::new(N, stride),
+            p: Lanes::new(N * N, stride),
+            nis: Lanes::new(1, stride),
+            tmp_x: Lanes::new(N, stride),
+            tmp_p: Lanes::new(N * N, stride),
+            a: Lanes::new(N * N, stride),
+            y: Lanes::new(M, stride),
+            l: Lanes::new(M * M, stride),
+            pht: Lanes::new(N * M, stride),
+            gain: Lanes::new(N * M, stride),
+            gate: Lanes::new(1, stride),
+        }
+    }
+
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Add a filter and return its index
+    pub fn push(&mut self, x: [f64; N], p: Matrix<N, N>) -> usize {
+        if self.len == self.x.stride {
+            self.grow(self.x.stride * 2);
+        }
+        let index = self.len;
+        self.len += 1;
+        self.set_state(index, x);
+        self.set_covariance(index, &p);
+        self.nis.data[index] = 0.0;
+        index
+    }
+
+    /// Remove filter `index`, moving the last filter into its place
+    pub fn swap_remove(&mut self, index: usize) {
+        assert!(index < self.len, "filter index out of range");
+        let last = self.len - 1;
+        for lanes in [&mut self.x, &mut self.p, &mut self.nis] {
+            for r in 0..lanes.rows() {
+                lanes.data[r * lanes.stride + index] = lanes.data[r * lanes.stride + last];
+            }
+        }
+        self.len = last;
+    }
+
+    pub fn clear(&mut self) {
+        self.len = 0;
+    }
+
+    pub fn state(&self, index: usize) -> [f64; N] {
+        assert!(index < self.len, "filter index out of range");
+        std::array::from_fn(|i| self.x.data[i * self.x.stride + index])
+    }
+
+    pub fn set_state(&mut self, index: usize, x: [f64; N]) {
+        assert!(index < self.len, "filter index out of range");
+        for (i, v) in x.into_iter().enumerate() {
+            self.x.data[i * self.x.stride + index] = v;
+        }
+    }
+
+    pub fn covariance(&self, index: usize) -> Matrix<N, N> {
+        assert!(index < self.len, "filter index out of range");
+        let mut p = Matrix::zeros();
+        for i in 0..N {
+            for j in 0..N {
+                p.0[i][j] = self.p.data[(i * N + j) * self.p.stride + index];
+            }
+        }
+        p
+    }
+
+    pub fn set_covariance(&mut self, index: usize, p: &Matrix<N, N>) {
+        assert!(index < self.len, "filter index out of range");
+        for i in 0..N {
+            for j in 0..N {
+                self.p.data[(i * N + j) * self.p.stride + index] = p.0[i][j];
+            }
+        }
+    }
+
+    /// Normalized innovation squared of each filter from the last update
+    /// (0 for filters that were masked out or rejected)
+    pub fn nis(&self) -> &[f64] {
+        self.nis.row(0, self.len)
+    }
+
+    /// Time update of every filter: `x = F x`, `P = F P Fᵀ + Q`
+    pub fn predict(&mut self) {
+        let (n, k) = (self.len, self.kernel);
+        if n == 0 {
+            return;
+        }
+
+        // x = F x
+        for i in 0..N {
+            let dst = self.tmp_x.row_mut(i, n);
+            dst.fill(0.0);
+            for c in 0..N {
+                let f = self.f.0[i][c];
+                if f != 0.0 {
+                    k.axpy(dst, f, self.x.row(c, n));
+                }
+            }
+        }
+        std::mem::swap(&mut self.x, &mut self.tmp_x);
+
+        // A = F P
+        for i in 0..N {
+            for j in 0..N {
+                let dst = self.a.row_mut(i * N + j, n);
+                dst.fill(0.0);
+                for c in 0..N {
+                    let f = self.f.0[i][c];
+                    if f != 0.0 {
+                        k.axpy(dst, f, self.p.row(c * N + j, n));
+                    }
+                }
+            }
+        }
+
+        // P = A Fᵀ + Q, upper triangle then mirrored
+        for i in 0..N {
+            for j in i..N {
+                let dst = self.p.row_mut(i * N + j, n);
+                dst.fill(self.q.0[i][j]);
+                for c in 0..N {
+                    let f = self.f.0[j][c];
+                    if f != 0.0 {
+                        k.axpy(dst, f, self.a.row(i * N + c, n));
+                    }
+                }
+            }
+        }
+        self.mirror_p();
+    }
+
+    /// Measurement update of every filter, one measurement each
+    ///
+    /// Returns how many filters were updated; filters whose innovation
+    /// covariance is not positive definite are left unchanged.
+    pub fn update(&mut self, measurements: &[[f64; M]]) -> usize {
+        self.gate.row_mut(0, self.len).fill(1.0);
+        self.update_gated(measurements)
+    }
+
+    /// Like `update`, but only filters with `mask[i] == true` take their
+    /// measurement (unassociated tracks pass any placeholder)
+    pub fn update_masked(&mut self, measurements: &[[f64; M]], mask: &[bool]) -> usize {
+        assert_eq!(mask.len(), self.len, "one mask entry per filter");
+        for (g, &m) in self.gate.row_mut(0, self.len).iter_mut().zip(mask) {
+            *g = if m { 1.0 } else { 0.0 };
+        }
+        self.update_gated(measurements)
+    }
+
+    fn update_gated(&mut self, measurements: &[[f64; M]]) -> usize {
+        assert_eq!(measurements.len(), self.len, "one measurement per filter");
+        let (n, k) = (self.len, self.kernel);
+        if n == 0 {
+            return 0;
+        }
+
+        // y = z - H x
+        for m in 0..M {
+            let dst = self.y.row_mut(m, n);
+            for (d, z) in dst.iter_mut().zip(measurements) {
+                *d = z[m];
+            }
+            for c in 0..N {
+                let h = self.h.0[m][c];
+                if h != 0.0 {
+                    k.axpy(dst, -h, self.x.row(c, n));
+                }
+            }
+        }
+
+        // P Hᵀ (N x M)
+        for i in 0..N {
+            for m in 0..M {
+                let dst = self.pht.row_mut(i * M + m, n);
+                dst.fill(0.0);
+                for c in 0..N {
+                    let h = self.h.0[m][c];
+                    if h != 0.0 {
+                        k.axpy(dst, h, self.p.row(i * N + c, n));
+                    }
+                }
+            }
+        }
+
+        // Lower triangle of S = H P Hᵀ + R, then factor it in place
+        for a in 0..M {
+            for b in 0..=a {
+                let dst = self.l.row_mut(a * M + b, n);
+                dst.fill(self.r.0[a][b]);
+                for c in 0..N {
+                    let h = self.h.0[a][c];
+                    if h != 0.0 {
+                        k.axpy(dst, h, self.pht.row(c * M + b, n));
+                    }
+                }
+            }
+        }
+        self.factor_innovation();
+
+        // u = L⁻¹ y gives NIS = |u|², then S⁻¹ y = L⁻ᵀ u
+        self.forward_substitute(Block::Innovation);
+        let nis = self.nis.row_mut(0, n);
+        nis.fill(0.0);
+        for m in 0..M {
+            let u = self.y.row(m, n);
+            k.fma(nis, u, u, false);
+        }
+        self.back_substitute(Block::Innovation);
+
+        // K = P Hᵀ S⁻¹, row by row
+        for i in 0..N {
+            for m in 0..M {
+                let src = self.pht.row(i * M + m, n);
+                self.gain.row_mut(i * M + m, n).copy_from_slice(src);
+            }
+            self.forward_substitute(Block::Gain(i));
+            self.back_substitute(Block::Gain(i));
+        }
+
+        // Masked and rejected lanes get a zero gain, so x and P stay put
+        let gate = self.gate.row(0, n);
+        for lanes in [&mut self.y, &mut self.gain, &mut self.nis] {
+            for r in 0..lanes.rows() {
+                for (v, &g) in lanes.row_mut(r, n).iter_mut().zip(gate) {
+                    if g == 0.0 {
+                        *v = 0.0;
+                    }
+                }
+            }
+        }
+
+        // x += P Hᵀ S⁻¹ y
+        for i in 0..N {
+            for m in 0..M {
+                k.fma(
+                    self.x.row_mut(i, n),
+                    self.pht.row(i * M + m, n),
+                    self.y.row(m, n),
+                    false,
+                );
+            }
+        }
+
+        let updated = gate.iter().filter(|&&g| g != 0.0).count();
+        self.joseph_update();
+        updated
+    }
+
+    /// `P = (I - K H) P (I - K H)ᵀ + K R Kᵀ`, lane-wise
+    fn joseph_update(&mut self) {
+        let (n, k) = (self.len, self.kernel);
+
+        // A = I - K H
+        for i in 0..N {
+            for j in 0..N {
+                let dst = self.a.row_mut(i * N + j, n);
+                dst.fill(if i == j { 1.0 } else { 0.0 });
+                for m in 0..M {
+                    let h = self.h.0[m][j];
+                    if h != 0.0 {
+                        k.axpy(dst, -h, self.gain.row(i * M + m, n));
+                    }
+                }
+            }
+        }
+
+        // T = A P
+        for i in 0..N {
+            for j in 0..N {
+                let dst = self.tmp_p.row_mut(i * N + j, n);
+                dst.fill(0.0);
+                for c in 0..N {
+                    k.fma(
+                        dst,
+                        self.a.row(i * N + c, n),
+                        self.p.row(c * N + j, n),
+                        false,
+                    );
+                }
+            }
+        }
+
+        // K R, reusing the P Hᵀ rows
+        for i in 0..N {
+            for m in 0..M {
+                let dst = self.pht.row_mut(i * M + m, n);
+                dst.fill(0.0);
+                for c in 0..M {
+                    let r = self.r.0[c][m];
+                    if r != 0.0 {
+                        k.axpy(dst, r, self.gain.row(i * M + c, n));
+                    }
+                }
+            }
+        }
+
+        // P = T Aᵀ + (K R) Kᵀ, upper triangle then mirrored
+        for i in 0..N {
+            for j in i..N {
+                let dst = self.p.row_mut(i * N + j, n);
+                dst.fill(0.0);
+                for c in 0..N {
+                    k.fma(
+                        dst,
+                        self.tmp_p.row(i * N + c, n),
+                        self.a.row(j * N + c, n),
+                        false,
+                    );
+                }
+                for m in 0..M {
+                    k.fma(
+                        dst,
+                        self.pht.row(i * M + m, n),
+                        self.gain.row(j * M + m, n),
+                        false,
+                    );
+                }
+            }
+        }
+        self.mirror_p();
+    }
+
+    /// Cholesky factor of every lane's `S`; non-positive-definite lanes are
+    /// gated off and get a unit diagonal so the solves stay finite
+    fn factor_innovation(&mut self) {
+        let (n, k) = (self.len, self.kernel);
+        let stride = self.l.stride;
+        for j in 0..M {
+            {
+                let (dst, head) = self.l.split_before(j * M + j, n);
+                for c in 0..j {
+                    let ljc = &head[(j * M + c) * stride..][..n];
+                    k.fma(dst, ljc, ljc, true);
+                }
+                for (d, g) in dst.iter_mut().zip(self.gate.row_mut(0, n)) {
+                    if *d > 0.0 && d.is_finite() {
+                        *d = d.sqrt();
+                    } else {
+                        *d = 1.0;
+                        *g = 0.0;
+                    }
+                }
+            }
+            for i in j + 1..M {
+                let (dst, head) = self.l.split_before(i * M + j, n);
+                for c in 0..j {
+                    let lic = &head[(i * M + c) * stride..][..n];
+                    let ljc = &head[(j * M + c) * stride..][..n];
+                    k.fma(dst, lic, ljc, true);
+                }
+                let ljj = &head[(j * M + j) * stride..][..n];
+                for (d, l) in dst.iter_mut().zip(ljj) {
+                    *d /= l;
+                }
+            }
+        }
+    }
+
+    /// Solve `L u = b` in place for the `M` rows of `block`
+    fn forward_substitute(&mut self, block: Block) {
+        let (n, k) = (self.len, self.kernel);
+        let (lanes, base) = match block {
+            Block::Innovation => (&mut self.y, 0),
+            Block::Gain(i) => (&mut self.gain, i * M),
+        };
+        for a in 0..M {
+            let stride = lanes.stride;
+            let (dst, head) = lanes.split_before(base + a, n);
+            for b in 0..a {
+                k.fma(
+                    dst,
+                    self.l.row(a * M + b, n),
+                    &head[(base + b) * stride..][..n],
+                    true,
+                );
+            }
+            for (d, l) in dst.iter_mut().zip(self.l.row(a * M + a, n)) {
+                *d /= l;
+            }
+        }
+    }
+
+    /// Solve `Lᵀ x = u` in place for the `M` rows of `block`
+    fn back_substitute(&mut self, block: Block) {
+        let (n, k) = (self.len, self.kernel);
+        let (lanes, base) = match block {
+            Block::Innovation => (&mut self.y, 0),
+            Block::Gain(i) => (&mut self.gain, i * M),
+        };
+        for a in (0..M).rev() {
+            let stride = lanes.stride;
+            let (dst, tail) = lanes.split_after(base + a, n);
+            for b in a + 1..M {
+                let u = &tail[(b - a - 1) * stride..][..n];
+                k.fma(dst, self.l.row(b * M + a, n), u, true);
+            }
+            for (d, l) in dst.iter_mut().zip(self.l.row(a * M + a, n)) {
+                *d /= l;
+            }
+        }
+    }
+
+    /// Copy the upper triangle of every `P` over the lower one
+    fn mirror_p(&mut self) {
+        for i in 0..N {
+            for j in i + 1..N {
+                self.p.copy_row(j * N + i, i * N + j, self.len);
+            }
+        }
+    }
+
+    fn grow(&mut self, stride: usize) {
+        let len = self.len;
+        for lanes in [
+            &mut self.x,
+            &mut self.p,
+            &mut self.nis,
+            &mut self.tmp_x,
+            &mut self.tmp_p,
+            &mut self.a,
+            &mut self.y,
+            &mut self.l,
+            &mut self.pht,
+            &mut self.gain,
+            &mut self.gate,
+        ] {
+            lanes.regrow(stride, len);
+        }
+    }
+}
+
+/// Which `M`-row vector a triangular solve works on
+#[derive(Debug, Clone, Copy)]
+enum Block {
+    Innovation,
+    Gain(usize),
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::algorithms::kalman::Ekf;
+
+    /// 2-D constant velocity: state [x, y, vx, vy], measurement [x, y]
+    fn model() -> (Matrix<4, 4>, Matrix<4, 4>, Matrix<2, 4>, Matrix<2, 2>) {
+        let dt = 0.1;
+        let mut f = Matrix::identity();
+        f[(0, 2)] = dt;
+        f[(1, 3)] = dt;
+        let q = Matrix::from_diagonal([1e-4, 1e-4, 1e-2, 1e-2]);
+        let h = Matrix::from_rows([[1.0, 0.0, 0.0, 0.0], [0.0, 1.0, 0.0, 0.0]]);
+        let r = Matrix::from_rows([[0.05, 0.01], [0.01, 0.08]]);
+        (f, q, h, r)
+    }
+
+    fn measurement(lane: usize, step: usize) -> [f64; 2] {
+        let t = step as f64 * 0.1;
+        let jitter = ((lane * 31 + step * 17) % 11) as f64 / 50.0 - 0.1;
+        [
+            lane as f64 + 1.5 * t + jitter,
+            -(lane as f64) + 0.5 * t - jitter,
+        ]
+    }
+
+    #[test]
+    fn test_bank_matches_individual_filters() {
+        let (f, q, h, r) = model();
+        // Odd count and a small initial capacity exercise vector tails and growth
+        let mut bank = KalmanBank::with_capacity(f, q, h, r, 8);
+        let mut filters = Vec::new();
+        for lane in 0..37 {
+            let x0 = [lane as f64, -(lane as f64), 0.0, 0.0];
+            let p0 = Matrix::from_diagonal([1.0, 1.0, 4.0, 4.0 + lane as f64]);
+            assert_eq!(bank.push(x0, p0), lane);
+            filters.push(Ekf::<4, 2>::new(x0, p0, q, r));
+        }
+
+        for step in 1..=30 {
+            let z: Vec<_> = (0..bank.len()).map(|l| measurement(l, step)).collect();
+            bank.predict();
+            assert_eq!(bank.update(&z), bank.len());
+            for (lane, ekf) in filters.iter_mut().enumerate() {
+                ekf.predict_linear(&f);
+                let y = [z[lane][0] - ekf.x[0], z[lane][1] - ekf.x[1]];
+                let nis = ekf.update(&y, &h).unwrap();
+                assert!((bank.nis()[lane] - nis).abs() < 1e-9);
+            }
+        }
+
+        for (lane, ekf) in filters.iter().enumerate() {
+            let (x, p) = (bank.state(lane), bank.covariance(lane));
+            for i in 0..4 {
+                assert!((x[i] - ekf.x[i]).abs() < 1e-9, "lane {} x{}", lane, i);
+                for j in 0..4 {
+                    assert!((p[(i, j)] - ekf.p[(i, j)]).abs() < 1e-9);
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_masked_and_rejected_lanes_unchanged() {
+        let (f, q, h, r) = model();
+        let mut bank = KalmanBank::new(f, q, h, r);
+        for lane in 0..6 {
+            bank.push([lane as f64; 4], Matrix::identity());
+        }
+        // Lane 4 gets a covariance that makes S indefinite
+        let mut bad = Matrix::identity();
+        bad[(0, 0)] = -10.0;
+        bank.set_covariance(4, &bad);
+        bank.predict();
+
+        let before: Vec<_> = (0..6)
+            .map(|l| (bank.state(l), bank.covariance(l)))
+            .collect();
+        let z = vec![[100.0, 100.0]; 6];
+        let mask = [true, false, true, false, true, true];
+        assert_eq!(bank.update_masked(&z, &mask), 3);
+
+        for lane in [1, 3, 4] {
+            assert_eq!(bank.state(lane), before[lane].0);
+            assert_eq!(bank.covariance(lane), before[lane].1);
+            assert_eq!(bank.nis()[lane], 0.0);
+        }
+        for lane in [0, 2, 5] {
+            assert!(bank.state(lane)[0] > before[lane].0[0]);
+            assert!(bank.covariance(lane).trace() < before[lane].1.trace());
+        }
+    }
+
+    #[test]
+    fn test_swap_remove() {
+        let (f, q, h, r) = model();
+        let mut bank = KalmanBank::new(f, q, h, r);
+        for lane in 0..3 {
+            bank.push(
+                [lane as f64; 4],
+                Matrix::from_diagonal([1.0 + lane as f64; 4]),
+            );
+        }
+        bank.swap_remove(0);
+        assert_eq!(bank.len(), 2);
+        assert_eq!(bank.state(0), [2.0; 4]);
+        assert_eq!(bank.covariance(0)[(3, 3)], 3.0);
+        assert_eq!(bank.state(1), [1.0; 4]);
+    }
+}
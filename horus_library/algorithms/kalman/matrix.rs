@@ -0,0 +1,268 @@
+//! Fixed-size, stack-allocated matrices for the Kalman filters
+//!
+//! Row-major `[[f64; C]; R]` with the dimensions in the type, so shape errors
+//! are compile errors and every loop bound is a constant. Products are
+//! written as row-broadcast AXPYs (`out.row(i) += a[i][k] * b.row(k)`) over
+//! contiguous rows, which LLVM fully unrolls and vectorizes for the small
+//! sizes used in state estimation.
+
+use std::ops::{Add, Index, IndexMut, Mul, Sub};
+
+/// `R x C` matrix of `f64`, row-major
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct Matrix<const R: usize, const C: usize>(pub [[f64; C]; R]);
+
+/// `y += a * x`
+#[inline(always)]
+pub(crate) fn axpy<const K: usize>(y: &mut [f64; K], a: f64, x: &[f64; K]) {
+    for (y, x) in y.iter_mut().zip(x) {
+        *y += a * x;
+    }
+}
+
+/// Dot product of two rows
+#[inline(always)]
+pub(crate) fn dot<const K: usize>(a: &[f64; K], b: &[f64; K]) -> f64 {
+    a.iter().zip(b).map(|(a, b)| a * b).sum()
+}
+
+impl<const R: usize, const C: usize> Matrix<R, C> {
+    pub const fn zeros() -> Self {
+        Matrix([[0.0; C]; R])
+    }
+
+    pub const fn from_rows(rows: [[f64; C]; R]) -> Self {
+        Matrix(rows)
+    }
+
+    pub fn transpose(&self) -> Matrix<C, R> {
+        let mut out = Matrix::<C, R>::zeros();
+        for i in 0..R {
+            for j in 0..C {
+                out.0[j][i] = self.0[i][j];
+            }
+        }
+        out
+    }
+
+    /// `self * rhs`
+    #[inline]
+    pub fn mul<const K: usize>(&self, rhs: &Matrix<C, K>) -> Matrix<R, K> {
+        let mut out = Matrix::<R, K>::zeros();
+        for (out_row, row) in out.0.iter_mut().zip(&self.0) {
+            for (&a, rhs_row) in row.iter().zip(&rhs.0) {
+                // Jacobians are mostly sparse; skipping zeros is cheaper than the AXPY
+                if a != 0.0 {
+                    axpy(out_row, a, rhs_row);
+                }
+            }
+        }
+        out
+    }
+
+    /// `self * rhsᵀ` without materializing the transpose
+    #[inline]
+    pub fn mul_transpose<const K: usize>(&self, rhs: &Matrix<K, C>) -> Matrix<R, K> {
+        let mut out = Matrix::<R, K>::zeros();
+        for (out_row, row) in out.0.iter_mut().zip(&self.0) {
+            for (o, rhs_row) in out_row.iter_mut().zip(&rhs.0) {
+                *o = dot(row, rhs_row);
+            }
+        }
+        out
+    }
+
+    /// `self * v`
+    #[inline]
+    pub fn mul_vec(&self, v: &[f64; C]) -> [f64; R] {
+        let mut out = [0.0; R];
+        for (o, row) in out.iter_mut().zip(&self.0) {
+            *o = dot(row, v);
+        }
+        out
+    }
+
+    /// `self * s`
+    #[inline]
+    pub fn scale(&self, s: f64) -> Self {
+        let mut out = *self;
+        for row in out.0.iter_mut() {
+            for v in row.iter_mut() {
+                *v *= s;
+            }
+        }
+        out
+    }
+}
+
+impl<const N: usize> Matrix<N, N> {
+    pub fn identity() -> Self {
+        Self::from_diagonal([1.0; N])
+    }
+
+    pub fn from_diagonal(diagonal: [f64; N]) -> Self {
+        let mut out = Self::zeros();
+        for (i, d) in diagonal.into_iter().enumerate() {
+            out.0[i][i] = d;
+        }
+        out
+    }
+
+    pub fn diagonal(&self) -> [f64; N] {
+        std::array::from_fn(|i| self.0[i][i])
+    }
+
+    pub fn trace(&self) -> f64 {
+        (0..N).map(|i| self.0[i][i]).sum()
+    }
+
+    /// Replace with `(self + selfᵀ) / 2` to cancel rounding asymmetry
+    pub fn symmetrize(&mut self) {
+        for i in 0..N {
+            for j in i + 1..N {
+                let v = 0.5 * (self.0[i][j] + self.0[j][i]);
+                self.0[i][j] = v;
+                self.0[j][i] = v;
+            }
+        }
+    }
+
+    /// Lower-triangular `L` with `L Lᵀ = self`, or None if not positive definite
+    pub fn cholesky(&self) -> Option<Self> {
+        let mut l = Self::zeros();
+        for j in 0..N {
+            let mut d = self.0[j][j];
+            for k in 0..j {
+                d -= l.0[j][k] * l.0[j][k];
+            }
+            if d <= 0.0 || !d.is_finite() {
+                return None;
+            }
+            let d = d.sqrt();
+            l.0[j][j] = d;
+            for i in j + 1..N {
+                let mut v = self.0[i][j];
+                for k in 0..j {
+                    v -= l.0[i][k] * l.0[j][k];
+                }
+                l.0[i][j] = v / d;
+            }
+        }
+        Some(l)
+    }
+
+    /// Solve `L Lᵀ x = b` given the Cholesky factor `L` of this system
+    pub fn cholesky_solve(l: &Self, b: &[f64; N]) -> [f64; N] {
+        // Forward substitution: L u = b
+        let mut u = *b;
+        for i in 0..N {
+            for k in 0..i {
+                u[i] -= l.0[i][k] * u[k];
+            }
+            u[i] /= l.0[i][i];
+        }
+        // Back substitution: Lᵀ x = u
+        for i in (0..N).rev() {
+            for k in i + 1..N {
+                u[i] -= l.0[k][i] * u[k];
+            }
+            u[i] /= l.0[i][i];
+        }
+        u
+    }
+}
+
+impl<const R: usize, const C: usize> Default for Matrix<R, C> {
+    fn default() -> Self {
+        Self::zeros()
+    }
+}
+
+impl<const R: usize, const C: usize> Index<(usize, usize)> for Matrix<R, C> {
+    type Output = f64;
+
+    #[inline]
+    fn index(&self, (i, j): (usize, usize)) -> &f64 {
+        &self.0[i][j]
+    }
+}
+
+impl<const R: usize, const C: usize> IndexMut<(usize, usize)> for Matrix<R, C> {
+    #[inline]
+    fn index_mut(&mut self, (i, j): (usize, usize)) -> &mut f64 {
+        &mut self.0[i][j]
+    }
+}
+
+impl<const R: usize, const C: usize> Add for Matrix<R, C> {
+    type Output = Self;
+
+    #[inline]
+    fn add(mut self, rhs: Self) -> Self {
+        for (row, rhs_row) in self.0.iter_mut().zip(&rhs.0) {
+            axpy(row, 1.0, rhs_row);
+        }
+        self
+    }
+}
+
+impl<const R: usize, const C: usize> Sub for Matrix<R, C> {
+    type Output = Self;
+
+    #[inline]
+    fn sub(mut self, rhs: Self) -> Self {
+        for (row, rhs_row) in self.0.iter_mut().zip(&rhs.0) {
+            axpy(row, -1.0, rhs_row);
+        }
+        self
+    }
+}
+
+impl<const R: usize, const C: usize, const K: usize> Mul<Matrix<C, K>> for Matrix<R, C> {
+    type Output = Matrix<R, K>;
+
+    #[inline]
+    fn mul(self, rhs: Matrix<C, K>) -> Matrix<R, K> {
+        Matrix::mul(&self, &rhs)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_products() {
+        let a = Matrix::from_rows([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]);
+        let b = Matrix::from_rows([[7.0, 8.0], [9.0, 10.0], [11.0, 12.0]]);
+
+        let ab = a * b;
+        assert_eq!(ab, Matrix::from_rows([[58.0, 64.0], [139.0, 154.0]]));
+        assert_eq!(a.mul_transpose(&b.transpose()), ab);
+        assert_eq!(a.mul_vec(&[1.0, 0.0, -1.0]), [-2.0, -2.0]);
+        assert_eq!(a.transpose().transpose(), a);
+    }
+
+    #[test]
+    fn test_cholesky_solve() {
+        let s = Matrix::from_rows([[4.0, 2.0, 0.4], [2.0, 5.0, 1.0], [0.4, 1.0, 3.0]]);
+        let l = s.cholesky().unwrap();
+        let llt = l.mul_transpose(&l);
+        for i in 0..3 {
+            for j in 0..3 {
+                assert!((llt[(i, j)] - s[(i, j)]).abs() < 1e-12);
+            }
+        }
+
+        let b = [1.0, -2.0, 0.5];
+        let x = Matrix::cholesky_solve(&l, &b);
+        let sx = s.mul_vec(&x);
+        for i in 0..3 {
+            assert!((sx[i] - b[i]).abs() < 1e-12);
+        }
+
+        // Not positive definite
+        let bad = Matrix::from_rows([[1.0, 2.0], [2.0, 1.0]]);
+        assert!(bad.cholesky().is_none());
+    }
+}
@@ -0,0 +1,235 @@
+//! Const-Generic Kalman Filter Family
+//!
+//! Extended and unscented Kalman filters of any state size `N` and
+//! measurement size `M`, with every matrix on the stack, plus a
+//! structure-of-arrays bank that runs many identical linear filters at once.
+//!
+//! # Features
+//!
+//! - `Ekf<N, M>`: caller-supplied models and Jacobians, Joseph-form update
+//! - `Ukf<N, M>`: scaled sigma-point transform, no Jacobians needed
+//! - `KalmanBank<N, M>`: hundreds of same-shaped filters (one per tracked
+//!   object) predicted and updated lane-parallel with AVX2/FMA or NEON
+//! - Cholesky-based gain computation; non-positive-definite innovation
+//!   covariances are rejected instead of producing NaNs
+//! - Normalized innovation squared (NIS) from every update, for gating
+//!
+//! The Joseph form `P = (I - KH) P (I - KH)ᵀ + K R Kᵀ` keeps the covariance
+//! symmetric positive semi-definite even when the gain is slightly off,
+//! which matters for long-running 15-state INS filters.
+//!
+//! # Example
+//!
+//! ```rust
+//! use horus_library::algorithms::kalman::{Ekf, Matrix};
+//!
+//! // Constant-velocity tracker: state [x, vx], measurement [x]
+//! let dt = 0.1;
+//! let mut ekf = Ekf::<2, 1>::new(
+//!     [0.0, 0.0],
+//!     Matrix::identity(),
+//!     Matrix::from_diagonal([0.01, 0.1]),
+//!     Matrix::from_diagonal([0.25]),
+//! );
+//!
+//! let f = Matrix::from_rows([[1.0, dt], [0.0, 1.0]]);
+//! let h = Matrix::from_rows([[1.0, 0.0]]);
+//!
+//! ekf.predict_linear(&f);
+//! let nis = ekf.update(&[1.0], &h).unwrap();
+//! assert!(nis >= 0.0);
+//! ```
+
+mod bank;
+mod matrix;
+mod ukf;
+
+pub use bank::KalmanBank;
+pub use matrix::Matrix;
+pub use ukf::{Ukf, UkfParams};
+
+/// Extended Kalman Filter with `N` states and `M` measurements
+#[derive(Debug, Clone)]
+pub struct Ekf<const N: usize, const M: usize> {
+    /// State estimate
+    pub x: [f64; N],
+    /// State covariance
+    pub p: Matrix<N, N>,
+    /// Process noise added by every `predict`
+    pub q: Matrix<N, N>,
+    /// Measurement noise
+    pub r: Matrix<M, M>,
+}
+
+impl<const N: usize, const M: usize> Ekf<N, M> {
+    pub fn new(x: [f64; N], p: Matrix<N, N>, q: Matrix<N, N>, r: Matrix<M, M>) -> Self {
+        Self { x, p, q, r }
+    }
+
+    /// Time update with an already propagated state and the model Jacobian
+    ///
+    /// `x_pred = f(x)`, `jacobian = ∂f/∂x` at the previous estimate.
+    pub fn predict(&mut self, x_pred: [f64; N], jacobian: &Matrix<N, N>) {
+        let q = self.q;
+        self.predict_with_noise(x_pred, jacobian, &q);
+    }
+
+    /// Like `predict`, with process noise for this step only (e.g. `Q * dt`)
+    pub fn predict_with_noise(
+        &mut self,
+        x_pred: [f64; N],
+        jacobian: &Matrix<N, N>,
+        process_noise: &Matrix<N, N>,
+    ) {
+        self.x = x_pred;
+        self.p = jacobian.mul(&self.p).mul_transpose(jacobian) + *process_noise;
+        self.p.symmetrize();
+    }
+
+    /// Time update for a linear model `x = F x`
+    pub fn predict_linear(&mut self, f: &Matrix<N, N>) {
+        let x_pred = f.mul_vec(&self.x);
+        self.predict(x_pred, f);
+    }
+
+    /// Measurement update from an innovation `z - h(x)` and `H = ∂h/∂x`
+    ///
+    /// The caller forms the innovation so angular components can be
+    /// wrapped. Returns the normalized innovation squared `yᵀ S⁻¹ y`, or an
+    /// error (leaving the filter untouched) when `S` is not positive definite.
+    pub fn update(&mut self, innovation: &[f64; M], h: &Matrix<M, N>) -> Result<f64, &'static str> {
+        let r = self.r;
+        self.update_with_noise(innovation, h, &r)
+    }
+
+    /// Like `update`, with measurement noise for this measurement only
+    pub fn update_with_noise(
+        &mut self,
+        innovation: &[f64; M],
+        h: &Matrix<M, N>,
+        measurement_noise: &Matrix<M, M>,
+    ) -> Result<f64, &'static str> {
+        // S = H P Hᵀ + R
+        let pht = self.p.mul_transpose(h);
+        let s = h.mul(&pht) + *measurement_noise;
+        let l = s
+            .cholesky()
+            .ok_or("Innovation covariance is not positive definite")?;
+
+        // K = P Hᵀ S⁻¹, one row at a time (S is symmetric)
+        let mut k = Matrix::<N, M>::zeros();
+        for (k_row, pht_row) in k.0.iter_mut().zip(&pht.0) {
+            *k_row = Matrix::cholesky_solve(&l, pht_row);
+        }
+
+        let nis = matrix::dot(innovation, &Matrix::cholesky_solve(&l, innovation));
+
+        for (x, k_row) in self.x.iter_mut().zip(&k.0) {
+            *x += matrix::dot(k_row, innovation);
+        }
+
+        // Joseph form: P = (I - K H) P (I - K H)ᵀ + K R Kᵀ
+        let a = Matrix::<N, N>::identity() - k.mul(h);
+        self.p = a.mul(&self.p).mul_transpose(&a) + k.mul(measurement_noise).mul_transpose(&k);
+        self.p.symmetrize();
+
+        Ok(nis)
+    }
+
+    /// Standard deviation of state component `i`
+    pub fn std_dev(&self, i: usize) -> f64 {
+        self.p.0[i][i].max(0.0).sqrt()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn constant_velocity(dt: f64) -> (Ekf<2, 1>, Matrix<2, 2>, Matrix<1, 2>) {
+        let ekf = Ekf::new(
+            [0.0, 0.0],
+            Matrix::from_diagonal([10.0, 10.0]),
+            Matrix::from_diagonal([1e-4, 1e-3]),
+            Matrix::from_diagonal([0.04]),
+        );
+        let f = Matrix::from_rows([[1.0, dt], [0.0, 1.0]]);
+        let h = Matrix::from_rows([[1.0, 0.0]]);
+        (ekf, f, h)
+    }
+
+    #[test]
+    fn test_tracks_constant_velocity() {
+        let dt = 0.1;
+        let (mut ekf, f, h) = constant_velocity(dt);
+
+        // Target moving at 2 m/s, deterministic measurement jitter
+        for step in 1..=200 {
+            ekf.predict_linear(&f);
+            let truth = 2.0 * dt * step as f64;
+            let z = truth + 0.1 * ((step * 7919 % 13) as f64 / 6.0 - 1.0);
+            let y = [z - ekf.x[0]];
+            ekf.update(&y, &h).unwrap();
+        }
+
+        assert!((ekf.x[1] - 2.0).abs() < 0.05, "velocity {}", ekf.x[1]);
+        assert!(ekf.std_dev(0) < 0.2);
+    }
+
+    #[test]
+    fn test_joseph_form_matches_standard_form() {
+        let (mut ekf, f, h) = constant_velocity(0.05);
+        ekf.predict_linear(&f);
+        let p = ekf.p;
+
+        let s = h.mul(&p).mul_transpose(&h) + ekf.r;
+        let k = p.mul_transpose(&h).scale(1.0 / s[(0, 0)]);
+        let standard = (Matrix::<2, 2>::identity() - k.mul(&h)).mul(&p);
+
+        ekf.update(&[0.3], &h).unwrap();
+        for i in 0..2 {
+            for j in 0..2 {
+                assert!((ekf.p[(i, j)] - standard[(i, j)]).abs() < 1e-9);
+            }
+        }
+        assert_eq!(ekf.p[(0, 1)], ekf.p[(1, 0)]);
+    }
+
+    #[test]
+    fn test_nis_and_rejection() {
+        let (mut ekf, _, h) = constant_velocity(0.1);
+        // y = 2, S = 10 + 0.04
+        let nis = ekf.update(&[2.0], &h).unwrap();
+        assert!((nis - 4.0 / 10.04).abs() < 1e-12);
+
+        let before = ekf.x;
+        let bad_r = Matrix::from_diagonal([-100.0]);
+        assert!(ekf.update_with_noise(&[1.0], &h, &bad_r).is_err());
+        assert_eq!(ekf.x, before);
+    }
+
+    #[test]
+    fn test_fifteen_state_shapes() {
+        // 15-state INS error model with a 6-D GPS position/velocity fix
+        let mut ekf = Ekf::<15, 6>::new(
+            [0.0; 15],
+            Matrix::identity(),
+            Matrix::from_diagonal([1e-3; 15]),
+            Matrix::from_diagonal([0.5, 0.5, 1.0, 0.05, 0.05, 0.1]),
+        );
+        let mut f = Matrix::<15, 15>::identity();
+        for i in 0..3 {
+            f[(i, i + 3)] = 0.01;
+        }
+        let mut h = Matrix::<6, 15>::zeros();
+        for i in 0..6 {
+            h[(i, i)] = 1.0;
+        }
+
+        let trace_before = ekf.p.trace();
+        ekf.predict_linear(&f);
+        ekf.update(&[1.0, -1.0, 0.5, 0.1, 0.0, -0.1], &h).unwrap();
+        assert!(ekf.p.trace() < trace_before);
+        assert!(ekf.p.cholesky().is_some());
+    }
+}
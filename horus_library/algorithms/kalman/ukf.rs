@@ -0,0 +1,270 @@
+//! Unscented Kalman Filter
+//!
+//! Propagates `2N + 1` scaled sigma points through the nonlinear process and
+//! measurement models instead of linearizing them, so no Jacobians are
+//! needed. Sigma points live in fixed-size arrays on the stack.
+
+use super::matrix::{axpy, Matrix};
+
+/// Scaled unscented transform parameters (van der Merwe)
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct UkfParams {
+    /// Spread of the sigma points around the mean (1e-3 ..= 1)
+    pub alpha: f64,
+    /// Prior knowledge of the distribution (2 is optimal for Gaussians)
+    pub beta: f64,
+    /// Secondary scaling, usually 0 or `3 - N`
+    pub kappa: f64,
+}
+
+impl Default for UkfParams {
+    fn default() -> Self {
+        Self {
+            alpha: 1e-3,
+            beta: 2.0,
+            kappa: 0.0,
+        }
+    }
+}
+
+/// Sigma point spread and mean / covariance weights for `N` states
+#[derive(Debug, Clone, Copy)]
+struct Weights {
+    gamma: f64,
+    mean0: f64,
+    cov0: f64,
+    rest: f64,
+}
+
+impl Weights {
+    fn new(n: usize, params: &UkfParams) -> Self {
+        let n = n as f64;
+        let lambda = params.alpha * params.alpha * (n + params.kappa) - n;
+        let mean0 = lambda / (n + lambda);
+        Self {
+            gamma: (n + lambda).sqrt(),
+            mean0,
+            cov0: mean0 + 1.0 - params.alpha * params.alpha + params.beta,
+            rest: 0.5 / (n + lambda),
+        }
+    }
+}
+
+/// `2N + 1` points of dimension `D`: the center, then `N` pairs
+struct SigmaPoints<const N: usize, const D: usize> {
+    center: [f64; D],
+    plus: [[f64; D]; N],
+    minus: [[f64; D]; N],
+}
+
+impl<const N: usize> SigmaPoints<N, N> {
+    /// `x`, `x + γ Lᵢ` and `x - γ Lᵢ` for the columns `Lᵢ` of chol(P)
+    fn new(x: &[f64; N], p: &Matrix<N, N>, gamma: f64) -> Option<Self> {
+        let l = p.cholesky()?;
+        let mut plus = [*x; N];
+        let mut minus = [*x; N];
+        for i in 0..N {
+            for j in 0..N {
+                let d = gamma * l.0[j][i];
+                plus[i][j] += d;
+                minus[i][j] -= d;
+            }
+        }
+        Some(Self {
+            center: *x,
+            plus,
+            minus,
+        })
+    }
+}
+
+impl<const N: usize, const D: usize> SigmaPoints<N, D> {
+    fn map<const K: usize>(&self, mut f: impl FnMut(&[f64; D]) -> [f64; K]) -> SigmaPoints<N, K> {
+        SigmaPoints {
+            center: f(&self.center),
+            plus: std::array::from_fn(|i| f(&self.plus[i])),
+            minus: std::array::from_fn(|i| f(&self.minus[i])),
+        }
+    }
+
+    /// Weighted mean
+    fn mean(&self, w: &Weights) -> [f64; D] {
+        let mut mean = [0.0; D];
+        axpy(&mut mean, w.mean0, &self.center);
+        for (plus, minus) in self.plus.iter().zip(&self.minus) {
+            axpy(&mut mean, w.rest, plus);
+            axpy(&mut mean, w.rest, minus);
+        }
+        mean
+    }
+
+    /// Weighted cross covariance `Σ w (a - ā)(b - b̄)ᵀ`
+    fn cross_covariance<const K: usize>(
+        &self,
+        mean: &[f64; D],
+        other: &SigmaPoints<N, K>,
+        other_mean: &[f64; K],
+        w: &Weights,
+    ) -> Matrix<D, K> {
+        let mut out = Matrix::<D, K>::zeros();
+        let mut accumulate = |weight: f64, a: &[f64; D], b: &[f64; K]| {
+            let db: [f64; K] = std::array::from_fn(|j| b[j] - other_mean[j]);
+            for (row, (a, m)) in out.0.iter_mut().zip(a.iter().zip(mean)) {
+                axpy(row, weight * (a - m), &db);
+            }
+        };
+        accumulate(w.cov0, &self.center, &other.center);
+        for i in 0..N {
+            accumulate(w.rest, &self.plus[i], &other.plus[i]);
+            accumulate(w.rest, &self.minus[i], &other.minus[i]);
+        }
+        out
+    }
+}
+
+/// Unscented Kalman Filter with `N` states and `M` measurements
+#[derive(Debug, Clone)]
+pub struct Ukf<const N: usize, const M: usize> {
+    /// State estimate
+    pub x: [f64; N],
+    /// State covariance
+    pub p: Matrix<N, N>,
+    /// Process noise added by every `predict`
+    pub q: Matrix<N, N>,
+    /// Measurement noise
+    pub r: Matrix<M, M>,
+    weights: Weights,
+}
+
+impl<const N: usize, const M: usize> Ukf<N, M> {
+    pub fn new(x: [f64; N], p: Matrix<N, N>, q: Matrix<N, N>, r: Matrix<M, M>) -> Self {
+        Self::with_params(x, p, q, r, UkfParams::default())
+    }
+
+    pub fn with_params(
+        x: [f64; N],
+        p: Matrix<N, N>,
+        q: Matrix<N, N>,
+        r: Matrix<M, M>,
+        params: UkfParams,
+    ) -> Self {
+        Self {
+            x,
+            p,
+            q,
+            r,
+            weights: Weights::new(N, &params),
+        }
+    }
+
+    /// Time update through the process model `f`
+    ///
+    /// Fails (leaving the filter untouched) if `P` lost positive definiteness.
+    pub fn predict(&mut self, f: impl FnMut(&[f64; N]) -> [f64; N]) -> Result<(), &'static str> {
+        let sigma = SigmaPoints::new(&self.x, &self.p, self.weights.gamma)
+            .ok_or("State covariance is not positive definite")?;
+        let propagated = sigma.map(f);
+        let x = propagated.mean(&self.weights);
+        self.p = propagated.cross_covariance(&x, &propagated, &x, &self.weights) + self.q;
+        self.p.symmetrize();
+        self.x = x;
+        Ok(())
+    }
+
+    /// Measurement update with measurement `z` and model `h`
+    ///
+    /// Returns the normalized innovation squared, like `Ekf::update`.
+    pub fn update(
+        &mut self,
+        z: &[f64; M],
+        h: impl FnMut(&[f64; N]) -> [f64; M],
+    ) -> Result<f64, &'static str> {
+        let w = self.weights;
+        let sigma = SigmaPoints::new(&self.x, &self.p, w.gamma)
+            .ok_or("State covariance is not positive definite")?;
+        let predicted = sigma.map(h);
+        let z_mean = predicted.mean(&w);
+
+        let s = predicted.cross_covariance(&z_mean, &predicted, &z_mean, &w) + self.r;
+        let l = s
+            .cholesky()
+            .ok_or("Innovation covariance is not positive definite")?;
+        let pxz = sigma.cross_covariance(&self.x, &predicted, &z_mean, &w);
+
+        // K = Pxz S⁻¹
+        let mut k = Matrix::<N, M>::zeros();
+        for (k_row, pxz_row) in k.0.iter_mut().zip(&pxz.0) {
+            *k_row = Matrix::cholesky_solve(&l, pxz_row);
+        }
+
+        let y: [f64; M] = std::array::from_fn(|i| z[i] - z_mean[i]);
+        let nis = super::matrix::dot(&y, &Matrix::cholesky_solve(&l, &y));
+        for (x, k_row) in self.x.iter_mut().zip(&k.0) {
+            *x += super::matrix::dot(k_row, &y);
+        }
+
+        // P = P - K S Kᵀ
+        self.p = self.p - k.mul(&s).mul_transpose(&k);
+        self.p.symmetrize();
+        Ok(nis)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::algorithms::kalman::Ekf;
+
+    #[test]
+    fn test_linear_model_matches_ekf() {
+        // On a linear model the unscented transform is exact
+        let dt = 0.1;
+        let f = Matrix::from_rows([[1.0, dt], [0.0, 1.0]]);
+        let h = Matrix::from_rows([[1.0, 0.0]]);
+        let p0 = Matrix::from_rows([[2.0, 0.3], [0.3, 1.0]]);
+        let q = Matrix::from_diagonal([1e-3, 1e-2]);
+        let r = Matrix::from_diagonal([0.1]);
+
+        let mut ekf = Ekf::<2, 1>::new([0.5, 1.0], p0, q, r);
+        let mut ukf = Ukf::<2, 1>::new([0.5, 1.0], p0, q, r);
+
+        for step in 0..20 {
+            let z = [0.2 * step as f64];
+            ekf.predict_linear(&f);
+            ukf.predict(|x| f.mul_vec(x)).unwrap();
+            ekf.update(&[z[0] - ekf.x[0]], &h).unwrap();
+            ukf.update(&z, |x| h.mul_vec(x)).unwrap();
+        }
+
+        for i in 0..2 {
+            assert!((ekf.x[i] - ukf.x[i]).abs() < 1e-6);
+            for j in 0..2 {
+                assert!((ekf.p[(i, j)] - ukf.p[(i, j)]).abs() < 1e-6);
+            }
+        }
+    }
+
+    #[test]
+    fn test_range_bearing_update() {
+        // Position [x, y] observed by range and bearing from the origin
+        let mut ukf = Ukf::<2, 2>::with_params(
+            [4.0, 3.5],
+            Matrix::from_diagonal([1.0, 1.0]),
+            Matrix::zeros(),
+            Matrix::from_diagonal([0.01, 0.001]),
+            UkfParams {
+                alpha: 0.5,
+                ..UkfParams::default()
+            },
+        );
+        let h = |x: &[f64; 2]| [(x[0] * x[0] + x[1] * x[1]).sqrt(), x[1].atan2(x[0])];
+
+        // Truth at (3, 4): range 5, bearing atan2(4, 3)
+        let truth = [3.0, 4.0];
+        for _ in 0..10 {
+            ukf.update(&h(&truth), h).unwrap();
+        }
+        assert!((ukf.x[0] - 3.0).abs() < 0.05, "x {:?}", ukf.x);
+        assert!((ukf.x[1] - 4.0).abs() < 0.05, "x {:?}", ukf.x);
+    }
+}
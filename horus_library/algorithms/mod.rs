@@ -14,11 +14,13 @@
 //!
 //! ## Motion Planning
 //! - **astar**: A* grid-based optimal pathfinding
+//! - **dstar_lite**: D* Lite incremental grid replanning
 //! - **rrt**: Rapidly-exploring Random Tree sampling-based planning
 //! - **pure_pursuit**: Path tracking controller for mobile robots
 //!
 //! ## Localization & State Estimation
 //! - **ekf**: Extended Kalman Filter for 2D robot localization
+//! - **kalman**: Const-generic EKF/UKF and SIMD bank of batched linear filters
 //! - **kalman_filter**: Linear Kalman Filter for 1D state estimation
 //! - **sensor_fusion**: Multi-sensor fusion with variance weighting
 //!
@@ -29,6 +31,9 @@
 //! ## Mapping
 //! - **occupancy_grid**: 2D occupancy grid with ray tracing
 //!
+//! ## Perception
+//! - **image_preprocess**: Fused SIMD resize/normalize/NCHW for inference inputs
+//!
 //! ## Safety & Collision Detection
 //! - **aabb**: Axis-Aligned Bounding Box collision detection
 //! - **safety_layer**: Multi-level safety monitoring and enforcement
@@ -36,7 +41,10 @@
 pub mod aabb;
 pub mod astar;
 pub mod differential_drive;
+pub mod dstar_lite;
 pub mod ekf;
+pub mod image_preprocess;
+pub mod kalman;
 pub mod kalman_filter;
 pub mod occupancy_grid;
 pub mod pid;
@@ -7,7 +7,9 @@
 //! - Binary occupancy (free/occupied)
 //! - Probabilistic occupancy (0-1)
 //! - Ray tracing for sensor integration
+//! - Whole-scan integration with no per-ray allocation
 //! - Grid-world coordinate conversion
+//! - Flat row-major `i8` cells, shared with `messages::navigation::OccupancyGrid`
 //!
 //! # Example
 //!
@@ -25,13 +27,28 @@
 //! }
 //! ```
 
+use crate::messages::geometry::Pose2D;
+use crate::messages::navigation;
+use crate::messages::sensor::LaserScan;
+
+/// Cell value for free space (message convention)
+pub const FREE: i8 = 0;
+/// Cell value for an obstacle (message convention)
+pub const OCCUPIED: i8 = 100;
+/// Cell value for unobserved space (message convention)
+pub const UNKNOWN: i8 = -1;
+
 /// 2D Occupancy Grid
+///
+/// Cells are stored row-major as occupancy percentages (`0` free, `100`
+/// occupied, `-1` unknown), the same layout as the navigation message, so
+/// maps move between the two with a single copy.
 pub struct OccupancyGrid {
     width: usize,
     height: usize,
-    resolution: f64,     // meters per cell
-    grid: Vec<Vec<f64>>, // 0.0 = free, 1.0 = occupied
-    origin: (f64, f64),  // World coordinates of grid[0][0]
+    resolution: f64,    // meters per cell
+    data: Vec<i8>,      // row-major, index = y * width + x
+    origin: (f64, f64), // World coordinates of cell (0, 0)
 }
 
 impl OccupancyGrid {
@@ -46,12 +63,45 @@ impl OccupancyGrid {
             width,
             height,
             resolution,
-            grid: vec![vec![0.0; width]; height],
+            data: vec![FREE; width * height],
             origin: (0.0, 0.0),
         }
     }
 
-    /// Set origin (world coordinates of grid[0][0])
+    /// Create a grid from a navigation message, copying its cells
+    pub fn from_message(msg: &navigation::OccupancyGrid) -> Self {
+        let width = msg.width as usize;
+        let height = msg.height as usize;
+        let mut data = msg.data.clone();
+        data.resize(width * height, UNKNOWN);
+
+        Self {
+            width,
+            height,
+            resolution: msg.resolution as f64,
+            data,
+            origin: (msg.origin.x, msg.origin.y),
+        }
+    }
+
+    /// Build a navigation message holding a copy of this grid
+    pub fn to_message(&self) -> navigation::OccupancyGrid {
+        let mut msg = navigation::OccupancyGrid::new(
+            self.width as u32,
+            self.height as u32,
+            self.resolution as f32,
+            Pose2D::new(self.origin.0, self.origin.1, 0.0),
+        );
+        msg.data.copy_from_slice(&self.data);
+        msg
+    }
+
+    /// Row-major cells (`0` free, `100` occupied, `-1` unknown)
+    pub fn data(&self) -> &[i8] {
+        &self.data
+    }
+
+    /// Set origin (world coordinates of cell (0, 0))
     pub fn set_origin(&mut self, x: f64, y: f64) {
         self.origin = (x, y);
     }
@@ -59,30 +109,34 @@ impl OccupancyGrid {
     /// Set cell as occupied
     pub fn set_occupied(&mut self, x: usize, y: usize) {
         if self.is_valid(x, y) {
-            self.grid[y][x] = 1.0;
+            self.data[y * self.width + x] = OCCUPIED;
         }
     }
 
     /// Set cell as free
     pub fn set_free(&mut self, x: usize, y: usize) {
         if self.is_valid(x, y) {
-            self.grid[y][x] = 0.0;
+            self.data[y * self.width + x] = FREE;
         }
     }
 
     /// Set cell occupancy probability (0.0 - 1.0)
+    ///
+    /// Stored as a whole percentage.
     pub fn set_probability(&mut self, x: usize, y: usize, prob: f64) {
         if self.is_valid(x, y) {
-            self.grid[y][x] = prob.clamp(0.0, 1.0);
+            self.data[y * self.width + x] = (prob.clamp(0.0, 1.0) * 100.0).round() as i8;
         }
     }
 
     /// Get cell occupancy probability
     pub fn get_probability(&self, x: usize, y: usize) -> f64 {
-        if self.is_valid(x, y) {
-            self.grid[y][x]
-        } else {
-            1.0 // Out of bounds = occupied
+        if !self.is_valid(x, y) {
+            return 1.0; // Out of bounds = occupied
+        }
+        match self.data[y * self.width + x] {
+            UNKNOWN => 0.5,
+            value => value as f64 / 100.0,
         }
     }
 
@@ -98,9 +152,7 @@ impl OccupancyGrid {
 
     /// Clear grid (set all cells to free)
     pub fn clear(&mut self) {
-        for row in &mut self.grid {
-            row.fill(0.0);
-        }
+        self.data.fill(FREE);
     }
 
     /// Convert world coordinates to grid coordinates
@@ -122,24 +174,62 @@ impl OccupancyGrid {
         x < self.width && y < self.height
     }
 
+    /// Write a cell given signed coordinates, ignoring cells off the grid
+    fn set_cell(&mut self, x: i32, y: i32, value: i8) {
+        if x >= 0 && y >= 0 && (x as usize) < self.width && (y as usize) < self.height {
+            self.data[y as usize * self.width + x as usize] = value;
+        }
+    }
+
     /// Ray trace from start to end, marking cells
     pub fn ray_trace(&mut self, start: (f64, f64), end: (f64, f64), mark_free: bool) {
         let (start_x, start_y) = self.world_to_grid(start.0, start.1);
         let (end_x, end_y) = self.world_to_grid(end.0, end.1);
 
-        let cells = bresenham_line(start_x, start_y, end_x, end_y);
+        for (x, y) in BresenhamLine::new(start_x, start_y, end_x, end_y) {
+            if (x, y) == (end_x, end_y) {
+                // End point = obstacle
+                self.set_cell(x, y, OCCUPIED);
+            } else if mark_free {
+                // Intermediate points = free
+                self.set_cell(x, y, FREE);
+            }
+        }
+    }
 
-        for (i, (x, y)) in cells.iter().enumerate() {
-            if *x >= 0 && *x < self.width as i32 && *y >= 0 && *y < self.height as i32 {
-                let ux = *x as usize;
-                let uy = *y as usize;
+    /// Integrate a whole laser scan taken from `pose` (x, y, theta in world frame)
+    ///
+    /// Every valid beam clears the cells it crosses; beams that returned
+    /// before `range_max` then mark their end cell occupied. Clearing runs
+    /// before marking so a later beam cannot erase an earlier beam's hit.
+    /// No memory is allocated.
+    pub fn integrate_scan(&mut self, pose: (f64, f64, f64), scan: &LaserScan) {
+        let (start_x, start_y) = self.world_to_grid(pose.0, pose.1);
+
+        for mark_hits in [false, true] {
+            for (i, &range) in scan.ranges.iter().enumerate() {
+                if !range.is_finite() || range <= 0.0 || range < scan.range_min {
+                    continue;
+                }
+                let hit = range < scan.range_max;
+                if mark_hits && !hit {
+                    continue;
+                }
 
-                if i == cells.len() - 1 {
-                    // End point = obstacle
-                    self.set_occupied(ux, uy);
-                } else if mark_free {
-                    // Intermediate points = free
-                    self.set_free(ux, uy);
+                let angle = pose.2 + scan.angle_min as f64 + i as f64 * scan.angle_increment as f64;
+                let range = range.min(scan.range_max) as f64;
+                let (end_x, end_y) =
+                    self.world_to_grid(pose.0 + range * angle.cos(), pose.1 + range * angle.sin());
+
+                if mark_hits {
+                    self.set_cell(end_x, end_y, OCCUPIED);
+                } else {
+                    for (x, y) in BresenhamLine::new(start_x, start_y, end_x, end_y) {
+                        if hit && (x, y) == (end_x, end_y) {
+                            break;
+                        }
+                        self.set_cell(x, y, FREE);
+                    }
                 }
             }
         }
@@ -156,40 +246,67 @@ impl OccupancyGrid {
     }
 }
 
-/// Bresenham's line algorithm
-fn bresenham_line(x0: i32, y0: i32, x1: i32, y1: i32) -> Vec<(i32, i32)> {
-    let mut cells = Vec::new();
+/// Bresenham's line algorithm, yielding cells from start to end inclusive
+struct BresenhamLine {
+    x: i32,
+    y: i32,
+    x1: i32,
+    y1: i32,
+    dx: i32,
+    dy: i32,
+    sx: i32,
+    sy: i32,
+    err: i32,
+    done: bool,
+}
 
-    let dx = (x1 - x0).abs();
-    let dy = (y1 - y0).abs();
-    let sx = if x0 < x1 { 1 } else { -1 };
-    let sy = if y0 < y1 { 1 } else { -1 };
-    let mut err = dx - dy;
+impl BresenhamLine {
+    fn new(x0: i32, y0: i32, x1: i32, y1: i32) -> Self {
+        let dx = (x1 - x0).abs();
+        let dy = (y1 - y0).abs();
+        Self {
+            x: x0,
+            y: y0,
+            x1,
+            y1,
+            dx,
+            dy,
+            sx: if x0 < x1 { 1 } else { -1 },
+            sy: if y0 < y1 { 1 } else { -1 },
+            err: dx - dy,
+            done: false,
+        }
+    }
+}
 
-    let mut x = x0;
-    let mut y = y0;
+impl Iterator for BresenhamLine {
+    type Item = (i32, i32);
 
-    loop {
-        cells.push((x, y));
+    fn next(&mut self) -> Option<(i32, i32)> {
+        if self.done {
+            return None;
+        }
 
-        if x == x1 && y == y1 {
-            break;
+        let cell = (self.x, self.y);
+        if self.x == self.x1 && self.y == self.y1 {
+            self.done = true;
+            return Some(cell);
         }
 
-        let e2 = 2 * err;
+        let e2 = 2 * self.err;
 
-        if e2 > -dy {
-            err -= dy;
-            x += sx;
+        if e2 > -self.dy {
+            self.err -= self.dy;
+            self.x += self.sx;
         }
 
-        if e2 < dx {
-            err += dx;
-            y += sy;
+        if e2 < self.dx {
+            self.err += self.dx;
+            self.y += self.sy;
         }
-    }
 
-    cells
+        Some(cell)
+    }
 }
 
 #[cfg(test)]
@@ -290,4 +407,50 @@ mod tests {
         assert_eq!(gx, 5);
         assert_eq!(gy, 5);
     }
+
+    #[test]
+    fn test_bresenham_endpoints() {
+        let cells: Vec<_> = BresenhamLine::new(0, 0, 3, -2).collect();
+        assert_eq!(cells.first(), Some(&(0, 0)));
+        assert_eq!(cells.last(), Some(&(3, -2)));
+        assert_eq!(cells.len(), 4);
+    }
+
+    #[test]
+    fn test_integrate_scan() {
+        let mut grid = OccupancyGrid::new(40, 40, 0.1);
+        grid.set_origin(-2.0, -2.0);
+        grid.data.fill(UNKNOWN);
+
+        // Single beam straight ahead hitting at 1m, one max-range beam behind
+        let mut scan = LaserScan::new();
+        scan.angle_min = 0.0;
+        scan.angle_increment = std::f32::consts::PI / 180.0;
+        scan.ranges[0] = 1.0;
+        scan.ranges[180] = scan.range_max;
+
+        grid.integrate_scan((0.05, 0.05, 0.0), &scan);
+
+        assert!(grid.is_occupied(30, 20)); // 1m ahead of (20, 20)
+        assert_eq!(grid.data()[20 * 40 + 25], FREE);
+        assert_eq!(grid.data()[20 * 40 + 5], FREE); // cleared by the max-range beam
+        assert_eq!(grid.data()[30 * 40 + 20], UNKNOWN); // never observed
+    }
+
+    #[test]
+    fn test_message_roundtrip() {
+        let mut grid = OccupancyGrid::new(8, 4, 0.5);
+        grid.set_origin(1.0, 2.0);
+        grid.set_occupied(7, 3);
+        grid.set_probability(1, 1, 0.3);
+
+        let msg = grid.to_message();
+        assert_eq!(msg.data[3 * 8 + 7], OCCUPIED);
+        assert_eq!(msg.origin.x, 1.0);
+
+        let back = OccupancyGrid::from_message(&msg);
+        assert_eq!(back.get_dimensions(), (8, 4));
+        assert_eq!(back.data(), grid.data());
+        assert!((back.get_probability(1, 1) - 0.3).abs() < 1e-9);
+    }
 }
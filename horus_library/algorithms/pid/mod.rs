@@ -26,6 +26,8 @@
 //! let output = pid.compute(setpoint, feedback, 0.01);  // dt = 10ms
 //! ```
 
+use horus_core::scheduling::jit::{DataflowGraph, PidParams, Value};
+
 /// PID Controller
 pub struct PID {
     kp: f64, // Proportional gain
@@ -163,6 +165,31 @@ impl PID {
     pub fn get_state(&self) -> (f64, f64) {
         (self.last_error, self.integral)
     }
+
+    /// Emit this controller into a JIT dataflow graph with a fixed `dt`
+    ///
+    /// Uses the current gains and limits; the emitted controller starts from
+    /// the reset state and keeps its own integral and last error.
+    pub fn to_dataflow(
+        &self,
+        graph: &mut DataflowGraph,
+        setpoint: Value,
+        feedback: Value,
+        dt: f64,
+    ) -> Value {
+        let params = PidParams {
+            kp: self.kp,
+            ki: self.ki,
+            kd: self.kd,
+            dt,
+            output_min: self.output_min,
+            output_max: self.output_max,
+            integral_min: self.integral_min,
+            integral_max: self.integral_max,
+            deadband: self.deadband,
+        };
+        graph.pid(setpoint, feedback, &params)
+    }
 }
 
 #[cfg(test)]
@@ -331,4 +358,25 @@ mod tests {
         // Doubled Kp should double the output
         assert!((output2 - 2.0 * output1).abs() < 0.01);
     }
+
+    #[test]
+    fn test_dataflow_matches_compute() {
+        let mut pid = PID::new(2.0, 0.5, 0.1);
+        pid.set_output_limits(-10.0, 10.0);
+        pid.set_integral_limits(-1.0, 1.0);
+        pid.set_deadband(0.05);
+
+        let mut graph = DataflowGraph::new(2);
+        let (setpoint, feedback) = (graph.input(0), graph.input(1));
+        let out = pid.to_dataflow(&mut graph, setpoint, feedback, 0.01);
+        graph.output(out);
+
+        let mut state = graph.initial_state().to_vec();
+        let (mut output, mut scratch) = ([0.0], Vec::new());
+        for step in 0..20 {
+            let feedback = step as f64 * 0.3;
+            graph.eval(&[5.0, feedback], &mut output, &mut state, &mut scratch);
+            assert!((output[0] - pid.compute(5.0, feedback, 0.01)).abs() < 1e-12);
+        }
+    }
 }
@@ -244,6 +244,75 @@ fn hframe_benchmark_concurrent_reads() {
     );
 }
 
+/// Benchmark batched lookups and bulk point transforms
+#[test]
+#[ignore]
+fn hframe_benchmark_batch() {
+    let hf = HFrame::new();
+
+    // map -> odom -> base_link -> lidar, camera
+    let map = hf.register_frame("map", None).unwrap();
+    let odom = hf.register_frame("odom", Some("map")).unwrap();
+    let base = hf.register_frame("base_link", Some("odom")).unwrap();
+    let lidar = hf.register_frame("lidar", Some("base_link")).unwrap();
+    let camera = hf.register_frame("camera", Some("base_link")).unwrap();
+
+    for ts in [1000, 2000] {
+        hf.update_transform_by_id(
+            odom,
+            &Transform::from_translation([ts as f64, 0.0, 0.0]),
+            ts,
+        );
+        hf.update_transform_by_id(
+            base,
+            &Transform::from_euler([0.1, 0.0, 0.0], [0.0, 0.0, 0.3]),
+            ts,
+        );
+        hf.update_transform_by_id(lidar, &Transform::from_translation([0.0, 0.0, 0.4]), ts);
+        hf.update_transform_by_id(camera, &Transform::from_translation([0.2, 0.0, 0.3]), ts);
+    }
+
+    // One frame's worth of detections: mixed sources, same timestamp
+    let queries: Vec<_> = (0..1024)
+        .map(|i| (if i % 2 == 0 { lidar } else { camera }, map, 1500))
+        .collect();
+
+    let rounds = ITERATIONS / 100;
+    let start = Instant::now();
+    for _ in 0..rounds {
+        for &(src, dst, ts) in &queries {
+            let _ = hf.tf_at_by_id(src, dst, ts);
+        }
+    }
+    let single = start.elapsed();
+
+    let mut out = Vec::with_capacity(queries.len());
+    let start = Instant::now();
+    for _ in 0..rounds {
+        hf.core.resolve_batch_into(&queries, &mut out);
+    }
+    let batched = start.elapsed();
+
+    let total = rounds as u128 * queries.len() as u128;
+    println!(
+        "HFrame resolve_at x{}: {} ns/query single, {} ns/query batched",
+        queries.len(),
+        single.as_nanos() / total,
+        batched.as_nanos() / total
+    );
+
+    let mut points = vec![[1.0, 2.0, 3.0]; 100_000];
+    let start = Instant::now();
+    for _ in 0..100 {
+        hf.core.transform_points(lidar, map, 1500, &mut points);
+    }
+    let elapsed = start.elapsed();
+    println!(
+        "HFrame transform_points: {:.2} ns/point",
+        elapsed.as_nanos() as f64 / (100.0 * points.len() as f64)
+    );
+}
+
 /// Print all benchmark results
 #[test]
 #[ignore]
@@ -264,6 +333,8 @@ fn hframe_benchmark_all() {
     hframe_benchmark_concurrent_reads();
     println!();
     hframe_benchmark_register();
+    println!();
+    hframe_benchmark_batch();
 
     println!("\n========================================");
     println!("Benchmark complete!");
@@ -40,7 +40,9 @@ pub struct HFrameConfig {
 
     /// Cache size for transform chain lookups
     ///
-    /// Caches recently computed src->dst transform chains.
+    /// Chains are now planned from a per-frame depth/root index that is
+    /// kept up to date on registration, so no chain cache is allocated.
+    /// Kept so existing configurations still build.
     ///
     /// Default: 64
     pub chain_cache_size: usize,
@@ -187,10 +189,10 @@ impl HFrameConfig {
         // Registry overhead (strings, hashmap)
         let registry_overhead = self.max_frames * 64; // Approximate
 
-        // Chain cache
-        let cache_memory = self.chain_cache_size * 128;
+        // Topology index (depth + root per frame)
+        let index_memory = self.max_frames * 8;
 
-        static_memory + dynamic_memory + registry_overhead + cache_memory
+        static_memory + dynamic_memory + registry_overhead + index_memory
     }
 
     /// Get human-readable memory estimate
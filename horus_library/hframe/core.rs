@@ -4,43 +4,36 @@
 //! all frame transforms and handles chain resolution.
 
 use std::collections::HashMap;
-use std::sync::atomic::{AtomicU32, AtomicUsize, Ordering};
+use std::sync::atomic::{fence, Ordering};
 use std::sync::RwLock;
 
 use super::transform::Transform;
 
 use super::config::HFrameConfig;
-use super::slot::FrameSlot;
+use super::seqlock::SeqLock;
+use super::slot::SlotRef;
+use super::storage::{decode_name, name_matches, FrameStorage, MAX_FRAME_NAME_LEN};
 use super::types::{FrameId, FrameType, HFrameError, HFrameResult, NO_PARENT};
 
 /// Core HFrame storage with lock-free operations
 ///
 /// Contains:
 /// - Pre-allocated slots for fast path (configurable size)
-/// - Parent relationship tracking
+/// - Parent relationship tracking and frame names
 /// - Optional overflow HashMap for unlimited frames
-/// - Chain cache for repeated lookups
+/// - Topology index (depth and root per frame) for lock-free chain lookups
+///
+/// All of the per-frame tables live in one [`FrameStorage`] block, which is
+/// either private to the process or shared with every process that opens
+/// the same name via [`HFrameCore::open_shared`].
 pub struct HFrameCore {
-    /// Pre-allocated frame slots (lock-free access)
-    slots: Vec<FrameSlot>,
-
-    /// Parent relationships (atomic for lock-free reads)
-    parents: Vec<AtomicU32>,
-
-    /// Children lists (for tree traversal)
-    children: RwLock<Vec<Vec<FrameId>>>,
-
-    /// Frame count tracking
-    static_count: AtomicUsize,
-    dynamic_count: AtomicUsize,
+    /// Slot headers, topology tables, names and history rings
+    storage: FrameStorage,
 
     /// Overflow storage for unlimited frames mode
     #[allow(dead_code)]
     overflow: Option<RwLock<HashMap<FrameId, OverflowFrame>>>,
 
-    /// Transform chain cache
-    chain_cache: RwLock<ChainCache>,
-
     /// Configuration
     config: HFrameConfig,
 }
@@ -54,59 +47,52 @@ struct OverflowFrame {
     timestamp: u64,
 }
 
-/// LRU cache for transform chains
-struct ChainCache {
-    entries: HashMap<(FrameId, FrameId), Vec<FrameId>>,
-    order: Vec<(FrameId, FrameId)>,
-    max_size: usize,
+/// Path between two frames through their lowest common ancestor
+#[derive(Debug, Clone, Copy)]
+struct ChainPlan {
+    src: FrameId,
+    dst: FrameId,
+    /// Number of parent hops from src up to the common ancestor
+    src_hops: u32,
+    /// Number of parent hops from dst up to the common ancestor
+    dst_hops: u32,
 }
 
-impl ChainCache {
-    fn new(max_size: usize) -> Self {
-        Self {
-            entries: HashMap::with_capacity(max_size),
-            order: Vec::with_capacity(max_size),
-            max_size,
-        }
-    }
+/// Per-batch memo of frame transforms so each slot is read once per timestamp
+type FrameMemo = HashMap<(FrameId, u64), Option<Transform>>;
 
-    fn get(&self, src: FrameId, dst: FrameId) -> Option<&Vec<FrameId>> {
-        self.entries.get(&(src, dst))
-    }
-
-    fn insert(&mut self, src: FrameId, dst: FrameId, chain: Vec<FrameId>) {
-        let key = (src, dst);
-
-        // Evict oldest if full
-        if self.entries.len() >= self.max_size && !self.entries.contains_key(&key) {
-            if let Some(old_key) = self.order.first().cloned() {
-                self.entries.remove(&old_key);
-                self.order.remove(0);
-            }
-        }
-
-        self.entries.insert(key, chain);
-        self.order.push(key);
-    }
+/// Holds the topology seqlock odd; releases it on drop
+struct TopologyGuard<'a> {
+    lock: SeqLock<'a>,
+    version: u64,
+}
 
-    fn invalidate(&mut self) {
-        self.entries.clear();
-        self.order.clear();
+impl Drop for TopologyGuard<'_> {
+    fn drop(&mut self) {
+        self.lock.unlock(self.version);
     }
 }
 
 impl HFrameCore {
     /// Create a new HFrame core with the given configuration
     pub fn new(config: &HFrameConfig) -> Self {
-        let mut slots = Vec::with_capacity(config.max_frames);
-        let mut parents = Vec::with_capacity(config.max_frames);
-        let children = vec![Vec::new(); config.max_frames];
+        Self::with_storage(
+            FrameStorage::heap(config.max_frames, config.history_len),
+            config,
+        )
+    }
 
-        for _ in 0..config.max_frames {
-            slots.push(FrameSlot::new(config.history_len));
-            parents.push(AtomicU32::new(NO_PARENT));
-        }
+    /// Create or attach to a core shared between processes under `name`
+    ///
+    /// Every process opening the same name (in the same HORUS session) sees
+    /// one set of frames. All of them must use the same `max_frames` and
+    /// `history_len`.
+    pub fn open_shared(name: &str, config: &HFrameConfig) -> HFrameResult<Self> {
+        let storage = FrameStorage::shared(name, config.max_frames, config.history_len)?;
+        Ok(Self::with_storage(storage, config))
+    }
 
+    fn with_storage(storage: FrameStorage, config: &HFrameConfig) -> Self {
         let overflow = if config.enable_overflow {
             Some(RwLock::new(HashMap::new()))
         } else {
@@ -114,170 +100,218 @@ impl HFrameCore {
         };
 
         Self {
-            slots,
-            parents,
-            children: RwLock::new(children),
-            static_count: AtomicUsize::new(0),
-            dynamic_count: AtomicUsize::new(0),
+            storage,
             overflow,
-            chain_cache: RwLock::new(ChainCache::new(config.chain_cache_size)),
             config: config.clone(),
         }
     }
 
+    /// Whether the frame tables are shared with other processes
+    pub fn is_shared(&self) -> bool {
+        self.storage.is_shared()
+    }
+
+    /// Configuration this core was created with
+    pub fn config(&self) -> &HFrameConfig {
+        &self.config
+    }
+
+    #[inline]
+    fn slot(&self, id: FrameId) -> Option<SlotRef<'_>> {
+        if (id as usize) < self.storage.max_frames() {
+            Some(self.storage.slot(id))
+        } else {
+            None
+        }
+    }
+
     // ========================================================================
     // Slot Management
     // ========================================================================
 
     /// Initialize a slot as a dynamic frame
     pub fn init_dynamic(&self, id: FrameId, parent: FrameId) {
-        let idx = id as usize;
-        if idx < self.slots.len() {
-            self.slots[idx].init_dynamic(parent);
-            self.parents[idx].store(parent, Ordering::Release);
-            self.dynamic_count.fetch_add(1, Ordering::Relaxed);
-
-            // Update children list
-            if parent != NO_PARENT && (parent as usize) < self.slots.len() {
-                let mut children = self.children.write().unwrap();
-                children[parent as usize].push(id);
-            }
-
-            // Invalidate cache
-            self.chain_cache.write().unwrap().invalidate();
-        }
+        let _guard = self.lock_topology();
+        self.init_locked(id, parent, FrameType::Dynamic);
     }
 
     /// Initialize a slot as a static frame
     pub fn init_static(&self, id: FrameId, parent: FrameId) {
-        let idx = id as usize;
-        if idx < self.slots.len() {
-            self.slots[idx].init_static(parent);
-            self.parents[idx].store(parent, Ordering::Release);
-            self.static_count.fetch_add(1, Ordering::Relaxed);
-
-            // Update children list
-            if parent != NO_PARENT && (parent as usize) < self.slots.len() {
-                let mut children = self.children.write().unwrap();
-                children[parent as usize].push(id);
-            }
-
-            // Invalidate cache
-            self.chain_cache.write().unwrap().invalidate();
-        }
+        let _guard = self.lock_topology();
+        self.init_locked(id, parent, FrameType::Static);
     }
 
     /// Reset a slot to unallocated state
     pub fn reset_slot(&self, id: FrameId) {
-        let idx = id as usize;
-        if idx < self.slots.len() {
-            let was_static = self.slots[idx].is_static();
-            let old_parent = self.parents[idx].load(Ordering::Acquire);
-
-            self.slots[idx].reset();
-            self.parents[idx].store(NO_PARENT, Ordering::Release);
-
-            if was_static {
-                self.static_count.fetch_sub(1, Ordering::Relaxed);
-            } else {
-                self.dynamic_count.fetch_sub(1, Ordering::Relaxed);
-            }
-
-            // Remove from parent's children list
-            if old_parent != NO_PARENT && (old_parent as usize) < self.slots.len() {
-                let mut children = self.children.write().unwrap();
-                children[old_parent as usize].retain(|&child| child != id);
-            }
-
-            // Invalidate cache
-            self.chain_cache.write().unwrap().invalidate();
-        }
+        let _guard = self.lock_topology();
+        self.reset_locked(id);
     }
 
     /// Reset all slots
     pub fn reset_all(&self) {
-        for slot in &self.slots {
-            slot.reset();
-        }
-        for parent in &self.parents {
-            parent.store(NO_PARENT, Ordering::Release);
-        }
-        {
-            let mut children = self.children.write().unwrap();
-            for child_list in children.iter_mut() {
-                child_list.clear();
-            }
+        let _guard = self.lock_topology();
+        let storage = &self.storage;
+        for id in 0..storage.max_frames() {
+            let frame = id as FrameId;
+            storage.slot(frame).reset();
+            storage.parents()[id].store(NO_PARENT, Ordering::Relaxed);
+            storage.depth()[id].store(0, Ordering::Relaxed);
+            storage.root()[id].store(frame, Ordering::Relaxed);
+            storage.child_count()[id].store(0, Ordering::Relaxed);
+            unsafe { storage.write_name(frame, "") };
         }
-        self.static_count.store(0, Ordering::Relaxed);
-        self.dynamic_count.store(0, Ordering::Relaxed);
-        self.chain_cache.write().unwrap().invalidate();
+        let header = storage.header();
+        header.static_count.store(0, Ordering::Relaxed);
+        header.dynamic_count.store(0, Ordering::Relaxed);
+        header.next_id.store(0, Ordering::Relaxed);
     }
 
     /// Check if a slot is allocated
     #[inline]
     pub fn is_allocated(&self, id: FrameId) -> bool {
-        let idx = id as usize;
-        idx < self.slots.len() && self.slots[idx].is_allocated()
+        self.slot(id).is_some_and(|slot| slot.is_allocated())
     }
 
     /// Check if a frame is static
     #[inline]
     pub fn is_static(&self, id: FrameId) -> bool {
-        let idx = id as usize;
-        idx < self.slots.len() && self.slots[idx].is_static()
+        self.slot(id).is_some_and(|slot| slot.is_static())
     }
 
     /// Get frame type
     #[inline]
     pub fn frame_type(&self, id: FrameId) -> FrameType {
-        let idx = id as usize;
-        if idx < self.slots.len() {
-            self.slots[idx].frame_type()
-        } else {
-            FrameType::Unallocated
-        }
+        self.slot(id)
+            .map_or(FrameType::Unallocated, |slot| slot.frame_type())
     }
 
     /// Get parent frame ID
     #[inline]
     pub fn parent(&self, id: FrameId) -> Option<FrameId> {
-        let idx = id as usize;
-        if idx < self.parents.len() {
-            let parent = self.parents[idx].load(Ordering::Acquire);
-            if parent != NO_PARENT {
-                Some(parent)
-            } else {
-                None
-            }
-        } else {
-            None
+        match self.load_parent(id) {
+            NO_PARENT => None,
+            parent => Some(parent),
         }
     }
 
     /// Get children of a frame
     pub fn children(&self, id: FrameId) -> Vec<FrameId> {
-        let idx = id as usize;
-        let children = self.children.read().unwrap();
-        if idx < children.len() {
-            children[idx].clone()
-        } else {
-            Vec::new()
+        if (id as usize) >= self.storage.max_frames() || id == NO_PARENT {
+            return Vec::new();
         }
+        self.storage
+            .parents()
+            .iter()
+            .enumerate()
+            .filter(|(_, parent)| parent.load(Ordering::Acquire) == id)
+            .map(|(child, _)| child as FrameId)
+            .collect()
     }
 
     /// Get frame count
     pub fn frame_count(&self) -> usize {
-        self.static_count.load(Ordering::Relaxed) + self.dynamic_count.load(Ordering::Relaxed)
+        self.static_frame_count() + self.dynamic_frame_count()
     }
 
     /// Get static frame count
     pub fn static_frame_count(&self) -> usize {
-        self.static_count.load(Ordering::Relaxed)
+        self.storage.header().static_count.load(Ordering::Relaxed) as usize
     }
 
     /// Get dynamic frame count
     pub fn dynamic_frame_count(&self) -> usize {
-        self.dynamic_count.load(Ordering::Relaxed)
+        self.storage.header().dynamic_count.load(Ordering::Relaxed) as usize
+    }
+
+    // ========================================================================
+    // Named Frames
+    // ========================================================================
+
+    /// Allocate an ID for `name` and initialize its slot, all in one step
+    ///
+    /// Atomic with respect to other registrations in any process sharing
+    /// these tables.
+    pub fn register_named(
+        &self,
+        name: &str,
+        parent: Option<&str>,
+        frame_type: FrameType,
+    ) -> HFrameResult<FrameId> {
+        check_name(name)?;
+
+        let _guard = self.lock_topology();
+        if self.find_locked(name).is_some() {
+            return Err(HFrameError::FrameAlreadyExists(name.to_string()));
+        }
+        let parent_id = match parent {
+            Some(parent) => self
+                .find_locked(parent)
+                .ok_or_else(|| HFrameError::ParentNotFound(parent.to_string()))?,
+            None => NO_PARENT,
+        };
+
+        let id = self.allocate_locked()?;
+        self.init_locked(id, parent_id, frame_type);
+        unsafe { self.storage.write_name(id, name) };
+        Ok(id)
+    }
+
+    /// Remove a named dynamic frame
+    pub fn unregister_named(&self, name: &str) -> HFrameResult<FrameId> {
+        let _guard = self.lock_topology();
+        let id = self
+            .find_locked(name)
+            .ok_or_else(|| HFrameError::FrameNotFound(name.to_string()))?;
+        if self.is_static(id) {
+            return Err(HFrameError::CannotUnregisterStatic(name.to_string()));
+        }
+        self.reset_locked(id);
+        unsafe { self.storage.write_name(id, "") };
+        Ok(id)
+    }
+
+    /// Give a named frame a new name
+    pub fn rename_named(&self, old_name: &str, new_name: &str) -> HFrameResult<FrameId> {
+        check_name(new_name)?;
+
+        let _guard = self.lock_topology();
+        if self.find_locked(new_name).is_some() {
+            return Err(HFrameError::FrameAlreadyExists(new_name.to_string()));
+        }
+        let id = self
+            .find_locked(old_name)
+            .ok_or_else(|| HFrameError::FrameNotFound(old_name.to_string()))?;
+        unsafe { self.storage.write_name(id, new_name) };
+        Ok(id)
+    }
+
+    /// Look up a frame ID by name (lock-free scan of the name table)
+    pub fn find_frame(&self, name: &str) -> Option<FrameId> {
+        self.read_topology(|| self.find_locked(name))
+    }
+
+    /// Whether frame `id` is currently named `name`
+    #[inline]
+    pub fn frame_has_name(&self, id: FrameId, name: &str) -> bool {
+        (id as usize) < self.storage.max_frames()
+            && self.read_topology(|| name_matches(&self.storage.name_bytes(id), name))
+    }
+
+    /// Name of frame `id`, if it has one
+    pub fn frame_name(&self, id: FrameId) -> Option<String> {
+        if (id as usize) >= self.storage.max_frames() {
+            return None;
+        }
+        self.read_topology(|| decode_name(&self.storage.name_bytes(id)))
+    }
+
+    /// Names of all named frames
+    pub fn frame_names(&self) -> Vec<String> {
+        self.read_topology(|| {
+            (0..self.allocated_range())
+                .filter_map(|id| decode_name(&self.storage.name_bytes(id as FrameId)))
+                .collect()
+        })
     }
 
     // ========================================================================
@@ -287,17 +321,15 @@ impl HFrameCore {
     /// Update a frame's transform
     #[inline]
     pub fn update(&self, id: FrameId, transform: &Transform, timestamp_ns: u64) {
-        let idx = id as usize;
-        if idx < self.slots.len() {
-            self.slots[idx].update(transform, timestamp_ns);
+        if let Some(slot) = self.slot(id) {
+            slot.update(transform, timestamp_ns);
         }
     }
 
     /// Set a static transform
     pub fn set_static_transform(&self, id: FrameId, transform: &Transform) {
-        let idx = id as usize;
-        if idx < self.slots.len() {
-            self.slots[idx].set_static_transform(transform);
+        if let Some(slot) = self.slot(id) {
+            slot.set_static_transform(transform);
         }
     }
 
@@ -311,11 +343,8 @@ impl HFrameCore {
             return Some(Transform::identity());
         }
 
-        // Get chain (possibly cached)
-        let chain = self.get_or_compute_chain(src, dst)?;
-
-        // Compose transforms along chain
-        self.compose_chain(&chain, None)
+        let plan = self.plan_chain(src, dst)?;
+        self.compose_plan(&plan, |id| self.read_frame(id, None))
     }
 
     /// Resolve transform from src to dst at specific timestamp
@@ -324,11 +353,65 @@ impl HFrameCore {
             return Some(Transform::identity());
         }
 
-        // Get chain
-        let chain = self.get_or_compute_chain(src, dst)?;
+        let plan = self.plan_chain(src, dst)?;
+        self.compose_plan(&plan, |id| self.read_frame(id, Some(timestamp_ns)))
+    }
+
+    /// Resolve many `(src, dst, timestamp_ns)` queries at once
+    ///
+    /// Each frame along the chains is read from its slot only once per
+    /// distinct timestamp, so batches that share frames (e.g. every detection
+    /// in an image going to `map`) pay for the seqlock reads once.
+    pub fn resolve_batch(&self, queries: &[(FrameId, FrameId, u64)]) -> Vec<Option<Transform>> {
+        let mut out = Vec::with_capacity(queries.len());
+        self.resolve_batch_into(queries, &mut out);
+        out
+    }
+
+    /// Like [`resolve_batch`](Self::resolve_batch), reusing `out`'s allocation
+    pub fn resolve_batch_into(
+        &self,
+        queries: &[(FrameId, FrameId, u64)],
+        out: &mut Vec<Option<Transform>>,
+    ) {
+        out.clear();
+        out.reserve(queries.len());
+
+        let mut memo = FrameMemo::new();
+        for &(src, dst, ts) in queries {
+            let tf = if src == dst {
+                Some(Transform::identity())
+            } else {
+                self.plan_chain(src, dst).and_then(|plan| {
+                    self.compose_plan(&plan, |id| {
+                        *memo
+                            .entry((id, ts))
+                            .or_insert_with(|| self.read_frame(id, Some(ts)))
+                    })
+                })
+            };
+            out.push(tf);
+        }
+    }
 
-        // Compose transforms with timestamp
-        self.compose_chain(&chain, Some(timestamp_ns))
+    /// Transform points from src to dst in place at a timestamp
+    ///
+    /// Resolves the chain once and applies the composed transform to every
+    /// point. Returns false (leaving the points untouched) if there is no path.
+    pub fn transform_points(
+        &self,
+        src: FrameId,
+        dst: FrameId,
+        timestamp_ns: u64,
+        points: &mut [[f64; 3]],
+    ) -> bool {
+        match self.resolve_at(src, dst, timestamp_ns) {
+            Some(tf) => {
+                tf.transform_points(points);
+                true
+            }
+            None => false,
+        }
     }
 
     /// Check if a transform path exists
@@ -336,7 +419,7 @@ impl HFrameCore {
         if src == dst {
             return true;
         }
-        self.get_or_compute_chain(src, dst).is_some()
+        self.plan_chain(src, dst).is_some()
     }
 
     /// Get the frame chain from src to dst
@@ -344,7 +427,26 @@ impl HFrameCore {
         if src == dst {
             return Some(vec![src]);
         }
-        self.get_or_compute_chain(src, dst)
+        let plan = self.plan_chain(src, dst)?;
+
+        // [src, ..., common, ..., dst]
+        let mut chain = Vec::with_capacity((plan.src_hops + plan.dst_hops + 1) as usize);
+        let mut current = plan.src;
+        chain.push(current);
+        for _ in 0..plan.src_hops {
+            current = self.load_parent(current);
+            chain.push(current);
+        }
+
+        let start = chain.len();
+        let mut current = plan.dst;
+        for _ in 0..plan.dst_hops {
+            chain.push(current);
+            current = self.load_parent(current);
+        }
+        chain[start..].reverse();
+
+        Some(chain)
     }
 
     // ========================================================================
@@ -354,7 +456,7 @@ impl HFrameCore {
     /// Validate the frame tree structure
     pub fn validate(&self) -> HFrameResult<()> {
         // Check for cycles
-        for id in 0..self.slots.len() {
+        for id in 0..self.storage.max_frames() {
             if !self.is_allocated(id as FrameId) {
                 continue;
             }
@@ -366,10 +468,7 @@ impl HFrameCore {
                 if !visited.insert(current) {
                     return Err(HFrameError::CycleDetected);
                 }
-                if (current as usize) >= self.parents.len() {
-                    break;
-                }
-                current = self.parents[current as usize].load(Ordering::Acquire);
+                current = self.load_parent(current);
             }
         }
 
@@ -380,166 +479,351 @@ impl HFrameCore {
     // Internal
     // ========================================================================
 
-    /// Get chain from cache or compute it
-    fn get_or_compute_chain(&self, src: FrameId, dst: FrameId) -> Option<Vec<FrameId>> {
-        // Try cache first
-        {
-            let cache = self.chain_cache.read().unwrap();
-            if let Some(chain) = cache.get(src, dst) {
-                return Some(chain.clone());
-            }
-        }
-
-        // Compute chain
-        let chain = self.compute_chain(src, dst)?;
-
-        // Cache it
-        {
-            let mut cache = self.chain_cache.write().unwrap();
-            cache.insert(src, dst, chain.clone());
-        }
-
-        Some(chain)
+    /// Parent of `id`, or NO_PARENT for roots and out-of-range ids
+    #[inline]
+    fn load_parent(&self, id: FrameId) -> FrameId {
+        self.storage
+            .parents()
+            .get(id as usize)
+            .map_or(NO_PARENT, |p| p.load(Ordering::Acquire))
     }
 
-    /// Compute the frame chain from src to dst
-    fn compute_chain(&self, src: FrameId, dst: FrameId) -> Option<Vec<FrameId>> {
-        // Build path from src to root
-        let src_to_root = self.path_to_root(src);
+    /// Take the topology seqlock for writing (waits while another writer,
+    /// possibly in another process, holds it; takes it over if that
+    /// process died)
+    fn lock_topology(&self) -> TopologyGuard<'_> {
+        let lock = self.storage.topology_lock();
+        let version = lock.lock(|| self.repair_topology_locked());
+        TopologyGuard { lock, version }
+    }
 
-        // Build path from dst to root
-        let dst_to_root = self.path_to_root(dst);
+    /// Run a read-only closure over the topology tables and names,
+    /// retrying until it saw a consistent snapshot
+    #[inline]
+    fn read_topology<R>(&self, mut read: impl FnMut() -> R) -> R {
+        let lock = self.storage.topology_lock();
+        let topology = &self.storage.header().topology;
+        loop {
+            let v1 = lock.read_begin(|| self.repair_topology_locked());
 
-        // Find common ancestor
-        let mut common_idx_src = None;
-        let mut common_idx_dst = None;
+            let result = read();
 
-        for (i, &src_frame) in src_to_root.iter().enumerate() {
-            if let Some(j) = dst_to_root.iter().position(|&f| f == src_frame) {
-                common_idx_src = Some(i);
-                common_idx_dst = Some(j);
-                break;
+            fence(Ordering::Acquire);
+            if topology.load(Ordering::Relaxed) == v1 {
+                return result;
             }
         }
+    }
 
-        let (src_idx, dst_idx) = match (common_idx_src, common_idx_dst) {
-            (Some(s), Some(d)) => (s, d),
-            _ => return None, // No common ancestor
-        };
+    /// IDs below this bound may be in use
+    #[inline]
+    fn allocated_range(&self) -> usize {
+        (self.storage.header().next_id.load(Ordering::Acquire) as usize)
+            .min(self.storage.max_frames())
+    }
 
-        // Build chain: src -> common ancestor -> dst
-        // The chain is represented as: [src, ..., common, ..., dst]
-        // Direction markers would complicate this, so we return
-        // the frames and handle direction during composition
-        let mut chain = Vec::with_capacity(src_idx + dst_idx + 1);
+    /// Scan the name table (caller holds the lock or validates via `read_topology`)
+    fn find_locked(&self, name: &str) -> Option<FrameId> {
+        (0..self.allocated_range())
+            .map(|id| id as FrameId)
+            .find(|&id| name_matches(&self.storage.name_bytes(id), name))
+    }
+
+    /// Pick an unused frame ID
+    fn allocate_locked(&self) -> HFrameResult<FrameId> {
+        let header = self.storage.header();
+        let next = header.next_id.load(Ordering::Relaxed) as usize;
+        let max_frames = self.storage.max_frames();
 
-        // src to common (exclusive of common)
-        chain.extend_from_slice(&src_to_root[..src_idx]);
+        if next < max_frames {
+            header.next_id.store(next as u32 + 1, Ordering::Release);
+            return Ok(next as FrameId);
+        }
 
-        // common ancestor
-        chain.push(src_to_root[src_idx]);
+        // Reuse a slot freed by an unregistered frame
+        (0..max_frames)
+            .map(|id| id as FrameId)
+            .find(|&id| {
+                !self.is_allocated(id) && decode_name(&self.storage.name_bytes(id)).is_none()
+            })
+            .ok_or(HFrameError::MaxFramesReached(max_frames))
+    }
 
-        // common to dst (reverse, exclusive of common)
-        for &frame in dst_to_root[..dst_idx].iter().rev() {
-            chain.push(frame);
+    fn init_locked(&self, id: FrameId, parent: FrameId, frame_type: FrameType) {
+        let Some(slot) = self.slot(id) else {
+            return;
+        };
+        let header = self.storage.header();
+        match frame_type {
+            FrameType::Static => {
+                slot.init_static(parent);
+                header.static_count.fetch_add(1, Ordering::Relaxed);
+            }
+            _ => {
+                slot.init_dynamic(parent);
+                header.dynamic_count.fetch_add(1, Ordering::Relaxed);
+            }
         }
+        self.attach_locked(id, parent);
 
-        Some(chain)
+        // Frames handed out directly by ID must not be reallocated
+        let next = header.next_id.load(Ordering::Relaxed);
+        if id >= next {
+            header.next_id.store(id + 1, Ordering::Release);
+        }
     }
 
-    /// Build path from frame to root
-    fn path_to_root(&self, start: FrameId) -> Vec<FrameId> {
-        let mut path = Vec::with_capacity(32);
-        let mut current = start;
+    fn reset_locked(&self, id: FrameId) {
+        let Some(slot) = self.slot(id) else {
+            return;
+        };
+        let was_static = slot.is_static();
+        let was_allocated = slot.is_allocated();
 
-        while current != NO_PARENT && (current as usize) < self.parents.len() {
-            path.push(current);
-            current = self.parents[current as usize].load(Ordering::Acquire);
+        slot.reset();
 
-            // Cycle detection
-            if path.len() > self.config.max_frames {
-                break;
+        if was_allocated {
+            let header = self.storage.header();
+            if was_static {
+                header.static_count.fetch_sub(1, Ordering::Relaxed);
+            } else {
+                header.dynamic_count.fetch_sub(1, Ordering::Relaxed);
             }
         }
 
-        path
+        // Detach from the parent; the frame's own subtree is re-rooted at it
+        self.attach_locked(id, NO_PARENT);
     }
 
-    /// Compose transforms along a chain
-    fn compose_chain(&self, chain: &[FrameId], timestamp: Option<u64>) -> Option<Transform> {
-        if chain.is_empty() {
-            return Some(Transform::identity());
+    /// Re-parent `id` and refresh the topology index (caller holds the lock)
+    fn attach_locked(&self, id: FrameId, parent: FrameId) {
+        let storage = &self.storage;
+        let (parents, depth, root, child_count) = (
+            storage.parents(),
+            storage.depth(),
+            storage.root(),
+            storage.child_count(),
+        );
+        let parent = if (parent as usize) < parents.len() && parent != id {
+            parent
+        } else {
+            NO_PARENT
+        };
+
+        let idx = id as usize;
+        let old_parent = parents[idx].swap(parent, Ordering::Relaxed);
+        if old_parent != NO_PARENT && (old_parent as usize) < parents.len() {
+            child_count[old_parent as usize].fetch_sub(1, Ordering::Relaxed);
+        }
+        if parent != NO_PARENT {
+            child_count[parent as usize].fetch_add(1, Ordering::Relaxed);
         }
 
-        if chain.len() == 1 {
-            return Some(Transform::identity());
+        if child_count[idx].load(Ordering::Relaxed) == 0 {
+            // Leaf (the usual registration case): only this frame changes
+            if parent == NO_PARENT {
+                depth[idx].store(0, Ordering::Relaxed);
+                root[idx].store(id, Ordering::Relaxed);
+            } else {
+                let p = parent as usize;
+                depth[idx].store(depth[p].load(Ordering::Relaxed) + 1, Ordering::Relaxed);
+                root[idx].store(root[p].load(Ordering::Relaxed), Ordering::Relaxed);
+            }
+        } else {
+            self.rebuild_index_locked();
         }
+    }
 
-        // Find the common ancestor (it's in the middle of the chain)
-        // The chain structure is: [src, ..parents_of_src.., common, ..children_to_dst.., dst]
+    /// Rebuild everything derived from the slots and parent links, after
+    /// taking the lock over from a writer that died mid-registration
+    fn repair_topology_locked(&self) {
+        let storage = &self.storage;
+        let (parents, child_count) = (storage.parents(), storage.child_count());
+        let n = storage.max_frames();
+
+        child_count
+            .iter()
+            .for_each(|c| c.store(0, Ordering::Relaxed));
+        let (mut statics, mut dynamics) = (0, 0);
+        for id in 0..n {
+            match storage.slot(id as FrameId).frame_type() {
+                FrameType::Static => statics += 1,
+                FrameType::Dynamic => dynamics += 1,
+                _ => {}
+            }
+            let parent = parents[id].load(Ordering::Relaxed);
+            if (parent as usize) < n {
+                child_count[parent as usize].fetch_add(1, Ordering::Relaxed);
+            }
+        }
 
-        // First, find where the direction changes (common ancestor)
-        // We need to find where frame[i+1] is NOT the parent of frame[i]
+        let header = storage.header();
+        header.static_count.store(statics, Ordering::Relaxed);
+        header.dynamic_count.store(dynamics, Ordering::Relaxed);
+        self.rebuild_index_locked();
+    }
 
-        let mut common_idx = 0;
-        for i in 0..chain.len() - 1 {
-            let parent_of_current = self.parents[chain[i] as usize].load(Ordering::Acquire);
-            if parent_of_current == chain[i + 1] {
-                // Still going up toward root
-                common_idx = i + 1;
-            } else {
-                // Direction changed
-                break;
+    /// Recompute depth and root for every frame in one pass
+    fn rebuild_index_locked(&self) {
+        let storage = &self.storage;
+        let (parents, depth, root) = (storage.parents(), storage.depth(), storage.root());
+        let n = parents.len();
+
+        let mut done = vec![false; n];
+        let mut path = Vec::new();
+        for start in 0..n {
+            // Walk up until reaching a root or an already indexed frame
+            let mut frame = start;
+            while !done[frame] && path.len() <= n {
+                path.push(frame);
+                match parents[frame].load(Ordering::Relaxed) {
+                    NO_PARENT => break,
+                    p => frame = p as usize,
+                }
+            }
+
+            // Then fill in from the top down
+            while let Some(frame) = path.pop() {
+                if done[frame] {
+                    continue; // Cycle: already handled in this walk
+                }
+                match parents[frame].load(Ordering::Relaxed) {
+                    p if p != NO_PARENT && done[p as usize] => {
+                        let p = p as usize;
+                        depth[frame].store(depth[p].load(Ordering::Relaxed) + 1, Ordering::Relaxed);
+                        root[frame].store(root[p].load(Ordering::Relaxed), Ordering::Relaxed);
+                    }
+                    _ => {
+                        depth[frame].store(0, Ordering::Relaxed);
+                        root[frame].store(frame as FrameId, Ordering::Relaxed);
+                    }
+                }
+                done[frame] = true;
             }
         }
+    }
 
-        let mut result = Transform::identity();
+    /// Find the lowest common ancestor of src and dst using the depth index
+    ///
+    /// Lock-free and allocation-free: a seqlock read over the topology
+    /// tables, retried if a registration raced with it.
+    fn plan_chain(&self, src: FrameId, dst: FrameId) -> Option<ChainPlan> {
+        let len = self.storage.max_frames();
+        if (src as usize) >= len || (dst as usize) >= len {
+            return None;
+        }
 
-        // Part 1: src to common (going UP toward root)
-        // Each frame stores transform "from parent to this frame" (parent->child)
-        // When going UP, we compose these transforms to accumulate child->root
-        for &frame_id in chain.iter().take(common_idx) {
-            let slot = &self.slots[frame_id as usize];
+        self.read_topology(|| self.plan_chain_unsynchronized(src, dst))
+    }
 
-            let entry = if let Some(ts) = timestamp {
-                slot.read_interpolated(ts)
-            } else {
-                slot.read_latest().map(|e| e.transform)
-            };
+    #[inline]
+    fn plan_chain_unsynchronized(&self, src: FrameId, dst: FrameId) -> Option<ChainPlan> {
+        let (depth, root) = (self.storage.depth(), self.storage.root());
+        if root[src as usize].load(Ordering::Acquire) != root[dst as usize].load(Ordering::Acquire)
+        {
+            return None; // Different trees
+        }
+
+        let src_depth = depth[src as usize].load(Ordering::Acquire);
+        let dst_depth = depth[dst as usize].load(Ordering::Acquire);
+        let parent = |id: FrameId| self.load_parent(id);
 
-            if let Some(tf) = entry {
-                // The stored transform is parent->child
-                // We compose in order: tf_child first (closest to point), then tf_parent
-                // result = tf.compose(result) -- apply tf after existing result
-                result = tf.compose(&result);
-            } else if !slot.is_static() {
-                // Dynamic frame with no data
-                return None;
+        // Lift the deeper frame, then both together until they meet
+        let (mut a, mut b) = (src, dst);
+        let (mut da, mut db) = (src_depth, dst_depth);
+        while da > db {
+            a = parent(a);
+            da -= 1;
+        }
+        while db > da {
+            b = parent(b);
+            db -= 1;
+        }
+        while a != b {
+            if a == NO_PARENT || b == NO_PARENT || da == 0 {
+                return None; // Torn read; the caller retries
             }
+            a = parent(a);
+            b = parent(b);
+            da -= 1;
+        }
+        if a == NO_PARENT {
+            return None;
         }
 
-        // Part 2: common to dst (going DOWN toward dst)
-        // Need to invert transforms when going down
-        for i in common_idx..chain.len() - 1 {
-            let frame_id = chain[i + 1];
-            let slot = &self.slots[frame_id as usize];
+        Some(ChainPlan {
+            src,
+            dst,
+            src_hops: src_depth - da,
+            dst_hops: dst_depth - da,
+        })
+    }
 
-            let entry = if let Some(ts) = timestamp {
-                slot.read_interpolated(ts)
-            } else {
-                slot.read_latest().map(|e| e.transform)
-            };
+    /// Transform of one frame relative to its parent
+    ///
+    /// Static frames without data act as identity; dynamic frames without
+    /// data break the chain (None).
+    #[inline]
+    fn read_frame(&self, id: FrameId, timestamp: Option<u64>) -> Option<Transform> {
+        let slot = self.slot(id)?;
+        let entry = match timestamp {
+            Some(ts) => slot.read_interpolated(ts),
+            None => slot.read_latest().map(|e| e.transform),
+        };
+        match entry {
+            Some(tf) => Some(tf),
+            None if slot.is_static() => Some(Transform::identity()),
+            None => None,
+        }
+    }
 
-            if let Some(tf) = entry {
-                // Going down: need inverse (stored is parent->child, we want child->parent)
-                result = result.compose(&tf.inverse());
-            } else if !slot.is_static() {
-                return None;
+    /// Compose the transforms along a planned chain
+    ///
+    /// Each stored transform maps points from the frame into its parent, so
+    /// walking up from src gives src->common, walking up from dst gives
+    /// dst->common, and src->dst is (dst->common)^-1 * (src->common).
+    #[inline]
+    fn compose_plan(
+        &self,
+        plan: &ChainPlan,
+        mut read: impl FnMut(FrameId) -> Option<Transform>,
+    ) -> Option<Transform> {
+        let mut up = |start: FrameId, hops: u32| -> Option<Transform> {
+            let mut result = Transform::identity();
+            let mut frame = start;
+            for _ in 0..hops {
+                if (frame as usize) >= self.storage.max_frames() {
+                    return None;
+                }
+                result = read(frame)?.compose(&result);
+                frame = self.load_parent(frame);
             }
+            Some(result)
+        };
+
+        let src_to_common = up(plan.src, plan.src_hops)?;
+        if plan.dst_hops == 0 {
+            return Some(src_to_common);
         }
+        let dst_to_common = up(plan.dst, plan.dst_hops)?;
+        Some(dst_to_common.inverse().compose(&src_to_common))
+    }
+}
 
-        Some(result)
+/// Reject names that cannot be stored in the name table
+fn check_name(name: &str) -> HFrameResult<()> {
+    if name.is_empty() {
+        return Err(HFrameError::ConfigError(
+            "Frame name must not be empty".to_string(),
+        ));
     }
+    if name.len() > MAX_FRAME_NAME_LEN {
+        return Err(HFrameError::NameTooLong(
+            name.to_string(),
+            MAX_FRAME_NAME_LEN,
+        ));
+    }
+    Ok(())
 }
 
 // Thread-safe
@@ -696,4 +980,123 @@ mod tests {
 
         assert!(core.validate().is_ok());
     }
+
+    #[test]
+    fn test_resolve_across_branches_with_rotation() {
+        let core = make_core();
+
+        // world(0) -> base(1) -> {camera(2), lidar(3)}
+        core.init_static(0, NO_PARENT);
+        core.init_dynamic(1, 0);
+        core.init_dynamic(2, 1);
+        core.init_dynamic(3, 1);
+
+        let tf_base = Transform::from_euler([2.0, 1.0, 0.0], [0.0, 0.0, 0.7]);
+        let tf_camera = Transform::from_euler([0.3, 0.0, 0.4], [0.1, 0.2, 0.3]);
+        let tf_lidar = Transform::from_euler([-0.2, 0.1, 0.6], [0.0, -0.4, 1.2]);
+        core.update(1, &tf_base, 1000);
+        core.update(2, &tf_camera, 1000);
+        core.update(3, &tf_lidar, 1000);
+
+        // camera -> lidar goes up to base and back down
+        let expected = tf_lidar.inverse().compose(&tf_camera);
+        let tf = core.resolve(2, 3).unwrap();
+        let p = [1.0, -2.0, 0.5];
+        let a = tf.transform_point(p);
+        let b = expected.transform_point(p);
+        for k in 0..3 {
+            assert!((a[k] - b[k]).abs() < 1e-9);
+        }
+
+        assert_eq!(core.frame_chain(2, 3), Some(vec![2, 1, 3]));
+        assert_eq!(core.frame_chain(0, 2), Some(vec![0, 1, 2]));
+    }
+
+    #[test]
+    fn test_resolve_batch_and_points() {
+        let core = make_core();
+
+        core.init_static(0, NO_PARENT);
+        core.init_dynamic(1, 0);
+        core.init_dynamic(2, 1);
+        core.init_dynamic(3, NO_PARENT); // Separate tree
+
+        core.update(1, &Transform::from_translation([1.0, 0.0, 0.0]), 1000);
+        core.update(1, &Transform::from_translation([3.0, 0.0, 0.0]), 2000);
+        core.update(2, &Transform::from_translation([0.0, 0.0, 0.5]), 1000);
+
+        let queries = [
+            (2, 0, 1000),
+            (2, 0, 1500),
+            (0, 2, 2000),
+            (2, 3, 1000),
+            (1, 1, 0),
+        ];
+        let results = core.resolve_batch(&queries);
+        assert_eq!(results.len(), queries.len());
+        for (i, &(src, dst, ts)) in queries.iter().enumerate() {
+            match (results[i], core.resolve_at(src, dst, ts)) {
+                (Some(a), Some(b)) => {
+                    for k in 0..3 {
+                        assert!((a.translation[k] - b.translation[k]).abs() < 1e-10);
+                    }
+                }
+                (None, None) => {}
+                other => panic!("query {} mismatch: {:?}", i, other),
+            }
+        }
+        assert!(results[3].is_none());
+
+        let mut points = [[0.0, 0.0, 0.0], [1.0, 1.0, 1.0]];
+        assert!(core.transform_points(2, 0, 1000, &mut points));
+        assert!((points[0][0] - 1.0).abs() < 1e-10);
+        assert!((points[1][2] - 1.5).abs() < 1e-10);
+        assert!(!core.transform_points(2, 3, 1000, &mut points));
+    }
+
+    #[test]
+    fn test_topology_updates_after_reset() {
+        let core = make_core();
+
+        core.init_static(0, NO_PARENT);
+        core.init_dynamic(1, 0);
+        core.init_dynamic(2, 1);
+        assert!(core.can_transform(2, 0));
+
+        // Removing the middle frame splits the tree
+        core.reset_slot(1);
+        assert!(!core.can_transform(2, 0));
+        assert_eq!(core.parent(1), None);
+
+        // Re-registering the slot joins it back
+        core.init_dynamic(1, 0);
+        assert!(core.can_transform(2, 0));
+        assert_eq!(core.frame_chain(2, 0), Some(vec![2, 1, 0]));
+    }
+
+    #[test]
+    fn test_shared_topology_survives_dead_writer() {
+        let name = format!("test_hframe_dead_writer_{}", std::process::id());
+        let core = HFrameCore::open_shared(&name, &HFrameConfig::small()).unwrap();
+        core.reset_all();
+        core.init_static(0, NO_PARENT);
+        core.init_dynamic(1, 0);
+
+        // A process died mid-registration: lock held, counts not yet updated
+        let header = core.storage.header();
+        header.topology.fetch_add(1, Ordering::SeqCst);
+        header
+            .topology_owner
+            .store(super::super::seqlock::dead_pid(), Ordering::SeqCst);
+        header.dynamic_count.fetch_add(5, Ordering::SeqCst);
+
+        // Readers take the lock over and repair the derived tables
+        assert!(core.can_transform(1, 0));
+        assert_eq!(core.dynamic_frame_count(), 1);
+
+        // Writers are no longer blocked either
+        core.init_dynamic(2, 1);
+        assert_eq!(core.frame_chain(2, 0), Some(vec![2, 1, 0]));
+        core.reset_all();
+    }
 }
@@ -11,6 +11,7 @@
 //! - **Time-travel queries**: Ring buffer history with SLERP interpolation
 //! - **Dual interface**: Integer IDs for hot path, string names for user API
 //! - **f64 precision**: Full robotics-grade precision (not game engine f32)
+//! - **Shared memory**: Optionally one tree for every process on the host
 //!
 //! ## Architecture
 //!
@@ -20,9 +21,9 @@
 //! ├─────────────────────────────────────────────────────────────┤
 //! │  ┌──────────────────┐   ┌────────────────────────────────┐ │
 //! │  │  FrameRegistry   │   │         HFrameCore             │ │
-//! │  │  (String ↔ ID)   │   │   (Lock-free Transform Store)  │ │
-//! │  │  - name_to_id    │   │   - slots: Vec<FrameSlot>      │ │
-//! │  │  - id_to_name    │   │   - parents: Vec<FrameId>      │ │
+//! │  │  (String → ID    │   │   (Lock-free Transform Store)  │ │
+//! │  │   cache)         │   │   FrameStorage (heap or shm):  │ │
+//! │  │                  │   │   slots, parents, names        │ │
 //! │  └──────────────────┘   └────────────────────────────────┘ │
 //! │                                                              │
 //! │  ┌──────────────────────────────────────────────────────┐  │
@@ -62,8 +63,25 @@
 //!
 //! // Time-travel query with interpolation
 //! let tf_old = hf.tf_at("camera_frame", "world", past_timestamp)?;
+//!
+//! // Bulk queries: resolve once, transform a whole cluster
+//! hf.transform_points_at("lidar", "map", scan_timestamp, &mut points)?;
+//! let tfs = hf.tf_batch(&[(camera, world, ts_a), (camera, world, ts_b)]);
+//!
+//! // One tree shared by every process that opens the same name
+//! let hf = HFrame::shared("robot", HFrameConfig::default())?;
 //! ```
 //!
+//! ## Shared Memory
+//!
+//! `HFrame::shared` places the slot array, parent tables and name table in a
+//! single shared memory region. Writers in any process update transforms in
+//! place and readers in every other process see them through the same seqlock
+//! protocol, with no message re-publishing in between. Registration is
+//! serialized by the topology version word, which doubles as a cross-process
+//! lock. All processes must open the region with the same `max_frames` and
+//! `history_len`, and frame names are limited to 63 bytes.
+//!
 //! ## Performance Comparison
 //!
 //! | Operation | HFrame | ROS2 TF2 |
@@ -79,7 +97,9 @@ mod config;
 mod core;
 mod messages;
 mod registry;
+mod seqlock;
 mod slot;
+mod storage;
 mod transform;
 mod types;
 
@@ -133,6 +153,26 @@ impl HFrame {
         }
     }
 
+    /// Open (or create) a transform tree shared by every process using `name`
+    ///
+    /// The first process creates the region; later ones attach to it and must
+    /// pass the same `max_frames` and `history_len`.
+    pub fn shared(name: &str, config: HFrameConfig) -> HFrameResult<Self> {
+        let core = Arc::new(HFrameCore::open_shared(name, &config)?);
+        let registry = Arc::new(FrameRegistry::new(core.clone(), config.max_frames));
+
+        Ok(Self {
+            core,
+            registry,
+            config,
+        })
+    }
+
+    /// Whether this tree lives in shared memory
+    pub fn is_shared(&self) -> bool {
+        self.core.is_shared()
+    }
+
     /// Create with preset for small robots (256 frames)
     pub fn small() -> Self {
         Self::with_config(HFrameConfig::small())
@@ -325,6 +365,15 @@ impl HFrame {
         self.core.resolve_at(src, dst, timestamp_ns)
     }
 
+    /// Resolve many `(src, dst, timestamp_ns)` queries by ID in one pass
+    ///
+    /// Frames shared between queries are read once per timestamp. Entries
+    /// are None where no path or no data exists.
+    #[inline]
+    pub fn tf_batch(&self, queries: &[(FrameId, FrameId, u64)]) -> Vec<Option<Transform>> {
+        self.core.resolve_batch(queries)
+    }
+
     /// Check if a transform path exists between two frames
     pub fn can_transform(&self, src: &str, dst: &str) -> bool {
         match (self.registry.lookup(src), self.registry.lookup(dst)) {
@@ -343,6 +392,21 @@ impl HFrame {
         Ok(tf.transform_point(point))
     }
 
+    /// Transform many points in place from one frame to another at a timestamp
+    ///
+    /// The chain is resolved once for the whole slice.
+    pub fn transform_points_at(
+        &self,
+        src: &str,
+        dst: &str,
+        timestamp_ns: u64,
+        points: &mut [[f64; 3]],
+    ) -> HFrameResult<()> {
+        let tf = self.tf_at(src, dst, timestamp_ns)?;
+        tf.transform_points(points);
+        Ok(())
+    }
+
     /// Transform a vector from one frame to another (rotation only)
     pub fn transform_vector(
         &self,
@@ -463,6 +527,29 @@ pub fn timestamp_now() -> u64 {
 mod tests {
     use super::*;
 
+    #[test]
+    fn test_shared_tree_across_handles() {
+        let name = format!("test_hframe_shared_{}", std::process::id());
+        let writer = HFrame::shared(&name, HFrameConfig::small()).unwrap();
+        let reader = HFrame::shared(&name, HFrameConfig::small()).unwrap();
+        assert!(writer.is_shared() && reader.is_shared());
+        writer.registry.clear();
+
+        let world = writer.register_frame("world", None).unwrap();
+        let base = writer.register_frame("base_link", Some("world")).unwrap();
+        writer.update_transform_by_id(base, &Transform::from_translation([2.0, 0.0, 0.0]), 1000);
+
+        assert_eq!(reader.frame_id("world"), Some(world));
+        let tf = reader.tf("base_link", "world").unwrap();
+        assert!((tf.translation[0] - 2.0).abs() < 1e-10);
+
+        // Mismatched geometry is rejected instead of misreading the region
+        let mut other = HFrameConfig::small();
+        other.history_len *= 2;
+        assert!(HFrame::shared(&name, other).is_err());
+        writer.registry.clear();
+    }
+
     #[test]
     fn test_basic_usage() {
         let hf = HFrame::new();
@@ -7,26 +7,24 @@ use std::collections::HashMap;
 use std::sync::{Arc, RwLock};
 
 use super::core::HFrameCore;
-use super::types::{FrameId, HFrameError, HFrameResult, NO_PARENT};
+use super::types::{FrameId, FrameType, HFrameError, HFrameResult};
 
 /// Frame name registry
 ///
-/// Provides bidirectional mapping between frame names and IDs.
-/// Uses RwLock for thread-safe access (not on hot path).
+/// The authoritative name table lives in [`HFrameCore`] next to the slots,
+/// so it is shared along with them when the core is. The registry keeps a
+/// process-local name to ID cache in front of it; cached entries are
+/// re-checked against the table on every hit, so frames renamed or removed
+/// by another process are never returned stale.
 pub struct FrameRegistry {
-    /// Name to ID mapping
-    name_to_id: RwLock<HashMap<String, FrameId>>,
-
-    /// ID to name mapping (indexed by frame ID)
-    id_to_name: RwLock<Vec<Option<String>>>,
+    /// Name to ID cache
+    cache: RwLock<HashMap<String, FrameId>>,
 
     /// Reference to core storage
     core: Arc<HFrameCore>,
 
-    /// Next available ID for allocation
-    next_id: RwLock<FrameId>,
-
     /// Maximum frames
+    #[allow(dead_code)]
     max_frames: usize,
 }
 
@@ -34,10 +32,8 @@ impl FrameRegistry {
     /// Create a new frame registry
     pub fn new(core: Arc<HFrameCore>, max_frames: usize) -> Self {
         Self {
-            name_to_id: RwLock::new(HashMap::with_capacity(max_frames)),
-            id_to_name: RwLock::new(vec![None; max_frames]),
+            cache: RwLock::new(HashMap::with_capacity(max_frames)),
             core,
-            next_id: RwLock::new(0),
             max_frames,
         }
     }
@@ -46,149 +42,64 @@ impl FrameRegistry {
     ///
     /// Returns the assigned frame ID.
     pub fn register(&self, name: &str, parent_name: Option<&str>) -> HFrameResult<FrameId> {
-        // Check for existing frame
-        {
-            let name_map = self.name_to_id.read().unwrap();
-            if name_map.contains_key(name) {
-                return Err(HFrameError::FrameAlreadyExists(name.to_string()));
-            }
-        }
-
-        // Resolve parent ID
-        let parent_id = if let Some(parent) = parent_name {
-            let name_map = self.name_to_id.read().unwrap();
-            *name_map
-                .get(parent)
-                .ok_or_else(|| HFrameError::ParentNotFound(parent.to_string()))?
-        } else {
-            NO_PARENT
-        };
-
-        // Allocate new ID
-        let id = self.allocate_id()?;
-
-        // Initialize slot in core
-        self.core.init_dynamic(id, parent_id);
-
-        // Register name mappings
-        {
-            let mut name_map = self.name_to_id.write().unwrap();
-            let mut id_map = self.id_to_name.write().unwrap();
-
-            name_map.insert(name.to_string(), id);
-            if (id as usize) < id_map.len() {
-                id_map[id as usize] = Some(name.to_string());
-            }
-        }
-
+        let id = self
+            .core
+            .register_named(name, parent_name, FrameType::Dynamic)?;
+        self.cache_insert(name, id);
         Ok(id)
     }
 
     /// Register a static frame
     pub fn register_static(&self, name: &str, parent_name: Option<&str>) -> HFrameResult<FrameId> {
-        // Check for existing frame
-        {
-            let name_map = self.name_to_id.read().unwrap();
-            if name_map.contains_key(name) {
-                return Err(HFrameError::FrameAlreadyExists(name.to_string()));
-            }
-        }
-
-        // Resolve parent ID
-        let parent_id = if let Some(parent) = parent_name {
-            let name_map = self.name_to_id.read().unwrap();
-            *name_map
-                .get(parent)
-                .ok_or_else(|| HFrameError::ParentNotFound(parent.to_string()))?
-        } else {
-            NO_PARENT
-        };
-
-        // Allocate new ID
-        let id = self.allocate_id()?;
-
-        // Initialize slot in core as static
-        self.core.init_static(id, parent_id);
-
-        // Register name mappings
-        {
-            let mut name_map = self.name_to_id.write().unwrap();
-            let mut id_map = self.id_to_name.write().unwrap();
-
-            name_map.insert(name.to_string(), id);
-            if (id as usize) < id_map.len() {
-                id_map[id as usize] = Some(name.to_string());
-            }
-        }
-
+        let id = self
+            .core
+            .register_named(name, parent_name, FrameType::Static)?;
+        self.cache_insert(name, id);
         Ok(id)
     }
 
     /// Unregister a frame (only dynamic frames can be unregistered)
     pub fn unregister(&self, name: &str) -> HFrameResult<()> {
-        let id = {
-            let name_map = self.name_to_id.read().unwrap();
-            *name_map
-                .get(name)
-                .ok_or_else(|| HFrameError::FrameNotFound(name.to_string()))?
-        };
-
-        // Check if static
-        if self.core.is_static(id) {
-            return Err(HFrameError::CannotUnregisterStatic(name.to_string()));
-        }
-
-        // Reset the slot
-        self.core.reset_slot(id);
-
-        // Remove from mappings
-        {
-            let mut name_map = self.name_to_id.write().unwrap();
-            let mut id_map = self.id_to_name.write().unwrap();
-
-            name_map.remove(name);
-            if (id as usize) < id_map.len() {
-                id_map[id as usize] = None;
-            }
-        }
-
+        self.core.unregister_named(name)?;
+        self.cache.write().unwrap().remove(name);
         Ok(())
     }
 
     /// Look up frame ID by name
     #[inline]
     pub fn lookup(&self, name: &str) -> Option<FrameId> {
-        let name_map = self.name_to_id.read().unwrap();
-        name_map.get(name).copied()
+        let cached = self.cache.read().unwrap().get(name).copied();
+        if let Some(id) = cached {
+            if self.core.frame_has_name(id, name) {
+                return Some(id);
+            }
+            self.cache.write().unwrap().remove(name);
+        }
+
+        let id = self.core.find_frame(name)?;
+        self.cache_insert(name, id);
+        Some(id)
     }
 
     /// Look up frame name by ID
     #[inline]
     pub fn lookup_name(&self, id: FrameId) -> Option<String> {
-        let id_map = self.id_to_name.read().unwrap();
-        if (id as usize) < id_map.len() {
-            id_map[id as usize].clone()
-        } else {
-            None
-        }
+        self.core.frame_name(id)
     }
 
     /// Check if a frame exists
     pub fn exists(&self, name: &str) -> bool {
-        let name_map = self.name_to_id.read().unwrap();
-        name_map.contains_key(name)
+        self.lookup(name).is_some()
     }
 
     /// Get all registered frame names
     pub fn all_names(&self) -> Vec<String> {
-        let name_map = self.name_to_id.read().unwrap();
-        name_map.keys().cloned().collect()
+        self.core.frame_names()
     }
 
     /// Get number of registered frames
     pub fn count(&self) -> usize {
-        let name_map = self.name_to_id.read().unwrap();
-        name_map.len()
+        self.core.frame_count()
     }
 
     /// Get or create a frame (useful for auto-registration)
@@ -200,90 +111,38 @@ impl FrameRegistry {
             return Ok(id);
         }
 
-        // Slow path: create
-        self.register(name, parent_name)
+        // Slow path: create (another process may have won the race)
+        match self.register(name, parent_name) {
+            Err(HFrameError::FrameAlreadyExists(_)) => self
+                .lookup(name)
+                .ok_or_else(|| HFrameError::FrameNotFound(name.to_string())),
+            result => result,
+        }
     }
 
     /// Rename a frame
     pub fn rename(&self, old_name: &str, new_name: &str) -> HFrameResult<()> {
-        // Check new name doesn't exist
-        {
-            let name_map = self.name_to_id.read().unwrap();
-            if name_map.contains_key(new_name) {
-                return Err(HFrameError::FrameAlreadyExists(new_name.to_string()));
-            }
-        }
-
-        // Get ID for old name
-        let id = {
-            let name_map = self.name_to_id.read().unwrap();
-            *name_map
-                .get(old_name)
-                .ok_or_else(|| HFrameError::FrameNotFound(old_name.to_string()))?
-        };
-
-        // Update mappings
-        {
-            let mut name_map = self.name_to_id.write().unwrap();
-            let mut id_map = self.id_to_name.write().unwrap();
-
-            name_map.remove(old_name);
-            name_map.insert(new_name.to_string(), id);
-
-            if (id as usize) < id_map.len() {
-                id_map[id as usize] = Some(new_name.to_string());
-            }
-        }
+        let id = self.core.rename_named(old_name, new_name)?;
 
+        let mut cache = self.cache.write().unwrap();
+        cache.remove(old_name);
+        cache.insert(new_name.to_string(), id);
         Ok(())
     }
 
     /// Clear all frames
     pub fn clear(&self) {
-        let mut name_map = self.name_to_id.write().unwrap();
-        let mut id_map = self.id_to_name.write().unwrap();
-        let mut next_id = self.next_id.write().unwrap();
-
-        name_map.clear();
-        for slot in id_map.iter_mut() {
-            *slot = None;
-        }
-        *next_id = 0;
-
         // Reset all slots in core
         self.core.reset_all();
+        self.cache.write().unwrap().clear();
     }
 
     // ========================================================================
     // Internal
     // ========================================================================
 
-    /// Allocate a new frame ID
-    fn allocate_id(&self) -> HFrameResult<FrameId> {
-        let mut next_id = self.next_id.write().unwrap();
-
-        if (*next_id as usize) >= self.max_frames {
-            // Try to find a free slot (from unregistered frames)
-            if let Some(free_id) = self.find_free_slot() {
-                return Ok(free_id);
-            }
-            return Err(HFrameError::MaxFramesReached(self.max_frames));
-        }
-
-        let id = *next_id;
-        *next_id += 1;
-        Ok(id)
-    }
-
-    /// Find a free slot (from unregistered frames)
-    fn find_free_slot(&self) -> Option<FrameId> {
-        let id_map = self.id_to_name.read().unwrap();
-        for (idx, slot) in id_map.iter().enumerate() {
-            if slot.is_none() && !self.core.is_allocated(idx as FrameId) {
-                return Some(idx as FrameId);
-            }
-        }
-        None
+    fn cache_insert(&self, name: &str, id: FrameId) {
+        self.cache.write().unwrap().insert(name.to_string(), id);
     }
 }
 
@@ -379,6 +238,43 @@ mod tests {
         assert_eq!(id1, id2);
     }
 
+    #[test]
+    fn test_shared_registry_across_handles() {
+        let config = HFrameConfig::small();
+        let name = format!("test_registry_{}", std::process::id());
+        let core_a = Arc::new(HFrameCore::open_shared(&name, &config).unwrap());
+        let core_b = Arc::new(HFrameCore::open_shared(&name, &config).unwrap());
+        core_a.reset_all();
+
+        let a = FrameRegistry::new(core_a, config.max_frames);
+        let b = FrameRegistry::new(core_b, config.max_frames);
+
+        let world = a.register("world", None).unwrap();
+        assert_eq!(b.lookup("world"), Some(world));
+        assert!(matches!(
+            b.register("world", None),
+            Err(HFrameError::FrameAlreadyExists(_))
+        ));
+
+        // Changes made through one handle invalidate the other's cache
+        let temp = b.register("temp", Some("world")).unwrap();
+        assert_eq!(a.lookup("temp"), Some(temp));
+        b.rename("temp", "renamed").unwrap();
+        assert_eq!(a.lookup("temp"), None);
+        assert_eq!(a.lookup_name(temp), Some("renamed".to_string()));
+        a.clear();
+    }
+
+    #[test]
+    fn test_name_too_long() {
+        let registry = make_registry();
+        let long = "x".repeat(64);
+        assert!(matches!(
+            registry.register(&long, None),
+            Err(HFrameError::NameTooLong(_, 63))
+        ));
+    }
+
     #[test]
     fn test_all_names() {
         let registry = make_registry();
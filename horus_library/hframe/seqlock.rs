@@ -0,0 +1,236 @@
+//! Seqlock word with owner tracking, shared by frame slots and the topology
+//!
+//! A version counter guards each protected region: odd while a write is in
+//! progress, even when stable. In shared memory a writer can die with the
+//! version odd, which would leave every reader and writer in every other
+//! process spinning forever. Shared locks therefore also record the
+//! writer's PID; a waiter that finds the owner gone takes the lock over,
+//! lets the caller repair whatever the dead writer left half-done, and
+//! releases it.
+
+use std::sync::atomic::{fence, AtomicU32, AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+use horus_core::memory::platform::is_process_running;
+
+/// Busy spins before a waiter starts yielding and checking on the owner
+const SPIN_LIMIT: u32 = 1 << 10;
+
+/// How long a shared lock may stay odd with no owner recorded before it is
+/// presumed abandoned (the writer died between taking it and storing its PID)
+const UNOWNED_TIMEOUT: Duration = Duration::from_secs(1);
+
+/// A version counter and its owner PID, wherever both live
+#[derive(Clone, Copy)]
+pub(crate) struct SeqLock<'a> {
+    version: &'a AtomicU64,
+    owner: &'a AtomicU32,
+    /// Track owners and recover from dead ones (only needed across processes)
+    shared: bool,
+}
+
+/// Per-wait state for deciding when a held lock has been abandoned
+#[derive(Default)]
+struct Stall {
+    spins: u32,
+    /// Odd version seen with no owner recorded, and since when
+    unowned: Option<(u64, Instant)>,
+}
+
+impl<'a> SeqLock<'a> {
+    #[inline]
+    pub(crate) fn new(version: &'a AtomicU64, owner: &'a AtomicU32, shared: bool) -> Self {
+        Self {
+            version,
+            owner,
+            shared,
+        }
+    }
+
+    /// Take the lock for writing and return the (odd) version now held
+    ///
+    /// `repair` runs with the lock held if it had to be taken over from a
+    /// writer that died holding it.
+    pub(crate) fn lock(&self, repair: impl FnOnce()) -> u64 {
+        let mut stall = Stall::default();
+        loop {
+            let v = self.version.load(Ordering::Relaxed);
+            if v & 1 == 1 {
+                if self.take_over(v, &mut stall) {
+                    repair();
+                    return v;
+                }
+                continue;
+            }
+            if self
+                .version
+                .compare_exchange_weak(v, v + 1, Ordering::Acquire, Ordering::Relaxed)
+                .is_ok()
+            {
+                if self.shared {
+                    self.owner.store(std::process::id(), Ordering::Relaxed);
+                }
+                // Make the odd version visible before any protected write
+                fence(Ordering::Release);
+                return v + 1;
+            }
+            std::hint::spin_loop();
+        }
+    }
+
+    /// Release a lock taken with [`SeqLock::lock`]
+    #[inline]
+    pub(crate) fn unlock(&self, held: u64) {
+        debug_assert!(held & 1 == 1, "Version should be odd while held");
+        if self.shared {
+            self.owner.store(0, Ordering::Relaxed);
+        }
+        self.version.store(held + 1, Ordering::Release);
+    }
+
+    /// Wait for a stable (even) version to start a read section
+    ///
+    /// `repair` runs, with the lock held, if the writer holding it died.
+    #[inline]
+    pub(crate) fn read_begin(&self, repair: impl FnOnce()) -> u64 {
+        let v = self.version.load(Ordering::Acquire);
+        if v & 1 == 0 {
+            return v;
+        }
+        self.read_begin_slow(repair)
+    }
+
+    #[cold]
+    fn read_begin_slow(&self, repair: impl FnOnce()) -> u64 {
+        let mut stall = Stall::default();
+        loop {
+            let v = self.version.load(Ordering::Acquire);
+            if v & 1 == 0 {
+                return v;
+            }
+            if self.take_over(v, &mut stall) {
+                repair();
+                self.unlock(v);
+                return v + 1;
+            }
+        }
+    }
+
+    /// Back off while `v` is held; true if the caller now owns the lock
+    /// because its previous owner is gone
+    fn take_over(&self, v: u64, stall: &mut Stall) -> bool {
+        if stall.spins < SPIN_LIMIT {
+            stall.spins += 1;
+            std::hint::spin_loop();
+            return false;
+        }
+        std::thread::yield_now();
+        if !self.shared {
+            return false;
+        }
+
+        let owner = self.owner.load(Ordering::Acquire);
+        let abandoned = if owner == 0 {
+            match stall.unowned {
+                Some((seen, since)) if seen == v => since.elapsed() >= UNOWNED_TIMEOUT,
+                _ => {
+                    stall.unowned = Some((v, Instant::now()));
+                    false
+                }
+            }
+        } else {
+            !is_process_running(owner)
+        };
+        if !abandoned {
+            return false;
+        }
+
+        let me = std::process::id();
+        if self
+            .owner
+            .compare_exchange(owner, me, Ordering::AcqRel, Ordering::Relaxed)
+            .is_err()
+        {
+            return false;
+        }
+        if self.version.load(Ordering::Acquire) == v {
+            return true;
+        }
+        // A new write started meanwhile; that lock is not ours to take
+        let _ = self
+            .owner
+            .compare_exchange(me, 0, Ordering::Relaxed, Ordering::Relaxed);
+        false
+    }
+}
+
+/// PID of a process that has already exited
+#[cfg(test)]
+pub(crate) fn dead_pid() -> u32 {
+    let mut child = std::process::Command::new("true")
+        .spawn()
+        .expect("Failed to spawn child process");
+    let pid = child.id();
+    child.wait().unwrap();
+    pid
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_lock_unlock() {
+        let (version, owner) = (AtomicU64::new(0), AtomicU32::new(0));
+        let lock = SeqLock::new(&version, &owner, true);
+
+        let held = lock.lock(|| panic!("Nothing to repair"));
+        assert_eq!(held, 1);
+        assert_eq!(owner.load(Ordering::Relaxed), std::process::id());
+
+        lock.unlock(held);
+        assert_eq!(version.load(Ordering::Relaxed), 2);
+        assert_eq!(owner.load(Ordering::Relaxed), 0);
+        assert_eq!(lock.read_begin(|| panic!("Nothing to repair")), 2);
+    }
+
+    #[test]
+    fn test_reader_recovers_from_dead_writer() {
+        let (version, owner) = (AtomicU64::new(5), AtomicU32::new(dead_pid()));
+        let lock = SeqLock::new(&version, &owner, true);
+
+        let mut repaired = false;
+        assert_eq!(lock.read_begin(|| repaired = true), 6);
+        assert!(repaired);
+        assert_eq!(owner.load(Ordering::Relaxed), 0);
+    }
+
+    #[test]
+    fn test_writer_recovers_from_dead_writer() {
+        let (version, owner) = (AtomicU64::new(7), AtomicU32::new(dead_pid()));
+        let lock = SeqLock::new(&version, &owner, true);
+
+        let mut repaired = false;
+        let held = lock.lock(|| repaired = true);
+        assert!(repaired);
+        assert_eq!(held, 7);
+        assert_eq!(owner.load(Ordering::Relaxed), std::process::id());
+
+        lock.unlock(held);
+        assert_eq!(version.load(Ordering::Relaxed), 8);
+    }
+
+    #[test]
+    fn test_live_owner_is_not_taken_over() {
+        let (version, owner) = (AtomicU64::new(0), AtomicU32::new(0));
+        let lock = SeqLock::new(&version, &owner, true);
+        let held = lock.lock(|| {});
+
+        std::thread::scope(|s| {
+            let reader = s.spawn(|| lock.read_begin(|| panic!("Owner is alive")));
+            std::thread::sleep(Duration::from_millis(20));
+            lock.unlock(held);
+            assert_eq!(reader.join().unwrap(), 2);
+        });
+    }
+}
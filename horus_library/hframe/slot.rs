@@ -4,8 +4,10 @@
 //! per-frame transforms with history.
 
 use std::cell::UnsafeCell;
+use std::marker::PhantomData;
 use std::sync::atomic::{AtomicU32, AtomicU64, AtomicU8, Ordering};
 
+use super::seqlock::SeqLock;
 use super::transform::Transform;
 
 use super::types::{FrameId, FrameType, NO_PARENT};
@@ -38,17 +40,12 @@ impl TransformEntry {
     }
 }
 
-/// Lock-free frame slot with history ring buffer
-///
-/// Uses a seqlock (version-dance) protocol for lock-free reads:
-/// - Writers increment version to odd before writing, even after
-/// - Readers spin-wait if version is odd (write in progress)
-/// - Readers retry if version changed during read
+/// Seqlock word, write counter and topology of one frame slot
 ///
-/// Memory layout is cache-line aligned for optimal performance.
+/// Holds only atomics, so an array of headers can live in shared memory.
+/// A zeroed header must be initialized with [`SlotHeader::clear`].
 #[repr(C, align(64))]
-pub struct FrameSlot {
-    // === First cache line: hot read data ===
+pub(crate) struct SlotHeader {
     /// Version counter for seqlock protocol
     /// Odd = write in progress, Even = stable
     version: AtomicU64,
@@ -59,11 +56,97 @@ pub struct FrameSlot {
     /// Parent frame ID
     parent: AtomicU32,
 
+    /// PID of the process holding `version` odd (shared tables only)
+    writer: AtomicU32,
+
     /// Frame type (Static, Dynamic, Unallocated)
     frame_type: AtomicU8,
 
-    /// Padding to align history to cache line
-    _padding: [u8; 64 - 8 - 8 - 4 - 1],
+    /// Padding to a full cache line
+    _padding: [u8; 64 - 8 - 8 - 4 - 4 - 1],
+}
+
+impl SlotHeader {
+    fn new() -> Self {
+        Self {
+            version: AtomicU64::new(0),
+            sequence: AtomicU64::new(0),
+            parent: AtomicU32::new(NO_PARENT),
+            writer: AtomicU32::new(0),
+            frame_type: AtomicU8::new(FrameType::Unallocated as u8),
+            _padding: [0; 64 - 8 - 8 - 4 - 4 - 1],
+        }
+    }
+
+    /// Put a header into the unallocated state (for freshly mapped memory)
+    pub(crate) fn clear(&self) {
+        self.version.store(0, Ordering::Relaxed);
+        self.sequence.store(0, Ordering::Relaxed);
+        self.parent.store(NO_PARENT, Ordering::Relaxed);
+        self.writer.store(0, Ordering::Relaxed);
+        self.frame_type
+            .store(FrameType::Unallocated as u8, Ordering::Relaxed);
+    }
+}
+
+/// A slot header paired with its history ring, wherever both live
+///
+/// This is where the seqlock protocol is implemented. [`FrameSlot`] owns
+/// its storage on the heap; `HFrameCore` points these at its flat tables,
+/// which may be shared between processes.
+#[derive(Clone, Copy)]
+pub(crate) struct SlotRef<'a> {
+    header: &'a SlotHeader,
+    history: *mut TransformEntry,
+    capacity: usize,
+    /// Header and history are shared with other processes
+    shared: bool,
+    _marker: PhantomData<&'a TransformEntry>,
+}
+
+impl<'a> SlotRef<'a> {
+    /// # Safety
+    /// `history` must point to `capacity` entries that outlive `'a` and are
+    /// only written through slots sharing `header`. `shared` must be set
+    /// when other processes map the same header.
+    #[inline]
+    pub(crate) unsafe fn new(
+        header: &'a SlotHeader,
+        history: *mut TransformEntry,
+        capacity: usize,
+        shared: bool,
+    ) -> Self {
+        Self {
+            header,
+            history,
+            capacity,
+            shared,
+            _marker: PhantomData,
+        }
+    }
+
+    #[inline]
+    fn seqlock(&self) -> SeqLock<'a> {
+        SeqLock::new(&self.header.version, &self.header.writer, self.shared)
+    }
+}
+
+/// Lock-free frame slot with history ring buffer
+///
+/// Uses a seqlock (version-dance) protocol for lock-free reads:
+/// - Writers move the version from even to odd before writing, even after
+/// - Readers spin-wait if version is odd (write in progress)
+/// - Readers retry if version changed during read
+///
+/// In shared tables a writer that died mid-write is detected by its PID and
+/// its lock released; the entry it was writing may be torn until the ring
+/// wraps over it.
+///
+/// Memory layout is cache-line aligned for optimal performance.
+#[repr(C, align(64))]
+pub struct FrameSlot {
+    // === First cache line: hot read data ===
+    header: SlotHeader,
 
     // === History buffer (separate cache lines) ===
     /// Ring buffer of transform history
@@ -75,7 +158,7 @@ pub struct FrameSlot {
 }
 
 // Safety: We guarantee thread-safety via the seqlock protocol
-// Writers serialize via atomic version increment
+// Writers serialize via a CAS on the version
 // Readers retry on version mismatch
 unsafe impl Sync for FrameSlot {}
 unsafe impl Send for FrameSlot {}
@@ -86,83 +169,175 @@ impl FrameSlot {
         let history = vec![TransformEntry::default(); history_capacity];
 
         Self {
-            version: AtomicU64::new(0),
-            sequence: AtomicU64::new(0),
-            parent: AtomicU32::new(NO_PARENT),
-            frame_type: AtomicU8::new(FrameType::Unallocated as u8),
-            _padding: [0; 64 - 8 - 8 - 4 - 1],
+            header: SlotHeader::new(),
             history: UnsafeCell::new(history),
             history_capacity,
         }
     }
 
+    #[inline]
+    fn view(&self) -> SlotRef<'_> {
+        // SAFETY: the Vec is never resized and lives as long as self
+        unsafe {
+            SlotRef::new(
+                &self.header,
+                (*self.history.get()).as_mut_ptr(),
+                self.history_capacity,
+                false,
+            )
+        }
+    }
+
     /// Initialize as a static frame
     pub fn init_static(&self, parent: FrameId) {
-        self.parent.store(parent, Ordering::Release);
-        self.frame_type
+        self.view().init_static(parent)
+    }
+
+    /// Initialize as a dynamic frame
+    pub fn init_dynamic(&self, parent: FrameId) {
+        self.view().init_dynamic(parent)
+    }
+
+    /// Reset slot to unallocated state
+    pub fn reset(&self) {
+        self.view().reset()
+    }
+
+    /// Check if this slot is allocated
+    #[inline]
+    pub fn is_allocated(&self) -> bool {
+        self.view().is_allocated()
+    }
+
+    /// Check if this is a static frame
+    #[inline]
+    pub fn is_static(&self) -> bool {
+        self.view().is_static()
+    }
+
+    /// Get frame type
+    #[inline]
+    pub fn frame_type(&self) -> FrameType {
+        self.view().frame_type()
+    }
+
+    /// Get parent frame ID
+    #[inline]
+    pub fn parent(&self) -> FrameId {
+        self.view().parent()
+    }
+
+    /// Set parent frame ID
+    pub fn set_parent(&self, parent: FrameId) {
+        self.view().set_parent(parent)
+    }
+
+    /// Update the frame's transform (lock-free write)
+    ///
+    /// # Thread Safety
+    /// Multiple writers are safe but will serialize via version counter.
+    /// For best performance, have only one writer per frame.
+    pub fn update(&self, transform: &Transform, timestamp_ns: u64) {
+        self.view().update(transform, timestamp_ns)
+    }
+
+    /// Set a static transform (only index 0 is used)
+    pub fn set_static_transform(&self, transform: &Transform) {
+        self.view().set_static_transform(transform)
+    }
+
+    /// Read the latest transform (lock-free read)
+    ///
+    /// Returns None if no transform has been written yet.
+    pub fn read_latest(&self) -> Option<TransformEntry> {
+        self.view().read_latest()
+    }
+
+    /// Read transform at (or nearest before) target timestamp
+    pub fn read_at(&self, target_ts: u64) -> Option<TransformEntry> {
+        self.view().read_at(target_ts)
+    }
+
+    /// Read transform with interpolation between two timestamps
+    pub fn read_interpolated(&self, target_ts: u64) -> Option<Transform> {
+        self.view().read_interpolated(target_ts)
+    }
+
+    /// Get time range of buffered transforms
+    pub fn time_range(&self) -> Option<(u64, u64)> {
+        self.view().time_range()
+    }
+}
+
+impl SlotRef<'_> {
+    /// Initialize as a static frame
+    pub fn init_static(&self, parent: FrameId) {
+        self.header.parent.store(parent, Ordering::Release);
+        self.header
+            .frame_type
             .store(FrameType::Static as u8, Ordering::Release);
-        self.sequence.store(0, Ordering::Release);
-        self.version.store(0, Ordering::Release);
+        self.header.sequence.store(0, Ordering::Release);
+        self.header.version.store(0, Ordering::Release);
     }
 
     /// Initialize as a dynamic frame
     pub fn init_dynamic(&self, parent: FrameId) {
-        self.parent.store(parent, Ordering::Release);
-        self.frame_type
+        self.header.parent.store(parent, Ordering::Release);
+        self.header
+            .frame_type
             .store(FrameType::Dynamic as u8, Ordering::Release);
-        self.sequence.store(0, Ordering::Release);
-        self.version.store(0, Ordering::Release);
+        self.header.sequence.store(0, Ordering::Release);
+        self.header.version.store(0, Ordering::Release);
     }
 
     /// Reset slot to unallocated state
     pub fn reset(&self) {
         // Mark as writing
-        let v = self.version.fetch_add(1, Ordering::AcqRel) + 1;
+        let lock = self.seqlock();
+        let v = lock.lock(|| {});
 
-        self.parent.store(NO_PARENT, Ordering::Release);
-        self.frame_type
+        self.header.parent.store(NO_PARENT, Ordering::Release);
+        self.header
+            .frame_type
             .store(FrameType::Unallocated as u8, Ordering::Release);
-        self.sequence.store(0, Ordering::Release);
+        self.header.sequence.store(0, Ordering::Release);
 
         // Clear history
-        unsafe {
-            let history = &mut *self.history.get();
-            for entry in history.iter_mut() {
-                *entry = TransformEntry::default();
-            }
+        for idx in 0..self.capacity {
+            unsafe { self.history.add(idx).write(TransformEntry::default()) };
         }
 
         // Mark as stable
-        self.version.store(v + 1, Ordering::Release);
+        lock.unlock(v);
     }
 
     /// Check if this slot is allocated
     #[inline]
     pub fn is_allocated(&self) -> bool {
-        self.frame_type.load(Ordering::Acquire) != FrameType::Unallocated as u8
+        self.header.frame_type.load(Ordering::Acquire) != FrameType::Unallocated as u8
     }
 
     /// Check if this is a static frame
     #[inline]
     pub fn is_static(&self) -> bool {
-        self.frame_type.load(Ordering::Acquire) == FrameType::Static as u8
+        self.header.frame_type.load(Ordering::Acquire) == FrameType::Static as u8
     }
 
     /// Get frame type
     #[inline]
     pub fn frame_type(&self) -> FrameType {
-        FrameType::from(self.frame_type.load(Ordering::Acquire))
+        FrameType::from(self.header.frame_type.load(Ordering::Acquire))
     }
 
     /// Get parent frame ID
     #[inline]
     pub fn parent(&self) -> FrameId {
-        self.parent.load(Ordering::Acquire)
+        self.header.parent.load(Ordering::Acquire)
     }
 
     /// Set parent frame ID
     pub fn set_parent(&self, parent: FrameId) {
-        self.parent.store(parent, Ordering::Release);
+        self.header.parent.store(parent, Ordering::Release);
     }
 
     // ========================================================================
@@ -176,41 +351,40 @@ impl FrameSlot {
     /// For best performance, have only one writer per frame.
     pub fn update(&self, transform: &Transform, timestamp_ns: u64) {
         // Step 1: Mark write in progress (odd version)
-        let v = self.version.fetch_add(1, Ordering::AcqRel) + 1;
-        debug_assert!(v & 1 == 1, "Version should be odd during write");
+        let lock = self.seqlock();
+        let v = lock.lock(|| {});
 
         // Step 2: Determine ring buffer slot
-        let seq = self.sequence.fetch_add(1, Ordering::AcqRel);
-        let idx = (seq as usize) % self.history_capacity;
+        let seq = self.header.sequence.fetch_add(1, Ordering::AcqRel);
+        let idx = (seq as usize) % self.capacity;
 
         // Step 3: Write transform
         unsafe {
-            let history = &mut *self.history.get();
-            history[idx] = TransformEntry {
+            self.history.add(idx).write(TransformEntry {
                 timestamp_ns,
                 transform: *transform,
-            };
+            });
         }
 
         // Step 4: Mark write complete (even version)
-        self.version.store(v + 1, Ordering::Release);
+        lock.unlock(v);
     }
 
     /// Set a static transform (only index 0 is used)
     pub fn set_static_transform(&self, transform: &Transform) {
-        let v = self.version.fetch_add(1, Ordering::AcqRel) + 1;
+        let lock = self.seqlock();
+        let v = lock.lock(|| {});
 
         unsafe {
-            let history = &mut *self.history.get();
-            history[0] = TransformEntry {
+            self.history.write(TransformEntry {
                 timestamp_ns: 0, // Static transforms have no timestamp
                 transform: *transform,
-            };
+            });
         }
 
         // For static frames, sequence stays at 1 to indicate "has data"
-        self.sequence.store(1, Ordering::Release);
-        self.version.store(v + 1, Ordering::Release);
+        self.header.sequence.store(1, Ordering::Release);
+        lock.unlock(v);
     }
 
     // ========================================================================
@@ -222,16 +396,11 @@ impl FrameSlot {
     /// Returns None if no transform has been written yet.
     pub fn read_latest(&self) -> Option<TransformEntry> {
         loop {
-            // Step 1: Read version (must be even = stable)
-            let v1 = self.version.load(Ordering::Acquire);
-            if v1 & 1 == 1 {
-                // Writer in progress, spin
-                std::hint::spin_loop();
-                continue;
-            }
+            // Step 1: Wait for a stable (even) version
+            let v1 = self.seqlock().read_begin(|| {});
 
             // Step 2: Read sequence
-            let seq = self.sequence.load(Ordering::Acquire);
+            let seq = self.header.sequence.load(Ordering::Acquire);
             if seq == 0 {
                 return None; // Never written
             }
@@ -239,14 +408,14 @@ impl FrameSlot {
             // Step 3: Copy transform
             let entry = if self.is_static() {
                 // Static frames always use index 0
-                unsafe { (&*self.history.get())[0] }
+                unsafe { self.history.read() }
             } else {
-                let idx = ((seq - 1) as usize) % self.history_capacity;
-                unsafe { (&*self.history.get())[idx] }
+                let idx = ((seq - 1) as usize) % self.capacity;
+                unsafe { self.history.add(idx).read() }
             };
 
             // Step 4: Verify version unchanged
-            let v2 = self.version.load(Ordering::Acquire);
+            let v2 = self.header.version.load(Ordering::Acquire);
             if v1 == v2 {
                 return Some(entry);
             }
@@ -262,20 +431,16 @@ impl FrameSlot {
         }
 
         loop {
-            let v1 = self.version.load(Ordering::Acquire);
-            if v1 & 1 == 1 {
-                std::hint::spin_loop();
-                continue;
-            }
+            let v1 = self.seqlock().read_begin(|| {});
 
-            let seq = self.sequence.load(Ordering::Acquire);
+            let seq = self.header.sequence.load(Ordering::Acquire);
             if seq == 0 {
                 return None;
             }
 
-            let result = unsafe { self.find_at_timestamp(&*self.history.get(), seq, target_ts) };
+            let result = unsafe { self.find_at_timestamp(self.history_slice(), seq, target_ts) };
 
-            let v2 = self.version.load(Ordering::Acquire);
+            let v2 = self.header.version.load(Ordering::Acquire);
             if v1 == v2 {
                 return result;
             }
@@ -290,21 +455,17 @@ impl FrameSlot {
         }
 
         loop {
-            let v1 = self.version.load(Ordering::Acquire);
-            if v1 & 1 == 1 {
-                std::hint::spin_loop();
-                continue;
-            }
+            let v1 = self.seqlock().read_begin(|| {});
 
-            let seq = self.sequence.load(Ordering::Acquire);
+            let seq = self.header.sequence.load(Ordering::Acquire);
             if seq == 0 {
                 return None;
             }
 
             let result =
-                unsafe { self.interpolate_at_timestamp(&*self.history.get(), seq, target_ts) };
+                unsafe { self.interpolate_at_timestamp(self.history_slice(), seq, target_ts) };
 
-            let v2 = self.version.load(Ordering::Acquire);
+            let v2 = self.header.version.load(Ordering::Acquire);
             if v1 == v2 {
                 return result;
             }
@@ -315,6 +476,12 @@ impl FrameSlot {
     // Internal Helpers
     // ========================================================================
 
+    /// History ring as a slice; only valid inside a seqlock read section
+    #[inline]
+    unsafe fn history_slice(&self) -> &[TransformEntry] {
+        std::slice::from_raw_parts(self.history, self.capacity)
+    }
+
     /// Find entry at or before target timestamp
     unsafe fn find_at_timestamp(
         &self,
@@ -322,11 +489,11 @@ impl FrameSlot {
         seq: u64,
         target_ts: u64,
     ) -> Option<TransformEntry> {
-        let available = seq.min(self.history_capacity as u64) as usize;
+        let available = seq.min(self.capacity as u64) as usize;
 
         // Scan from newest to oldest
         for offset in 0..available {
-            let idx = ((seq - 1 - offset as u64) as usize) % self.history_capacity;
+            let idx = ((seq - 1 - offset as u64) as usize) % self.capacity;
             let entry = &history[idx];
 
             if entry.timestamp_ns <= target_ts {
@@ -336,7 +503,7 @@ impl FrameSlot {
 
         // Return oldest if all are newer than target
         if available > 0 {
-            let oldest_idx = ((seq - available as u64) as usize) % self.history_capacity;
+            let oldest_idx = ((seq - available as u64) as usize) % self.capacity;
             Some(history[oldest_idx])
         } else {
             None
@@ -350,7 +517,7 @@ impl FrameSlot {
         seq: u64,
         target_ts: u64,
     ) -> Option<Transform> {
-        let available = seq.min(self.history_capacity as u64) as usize;
+        let available = seq.min(self.capacity as u64) as usize;
         if available == 0 {
             return None;
         }
@@ -361,7 +528,7 @@ impl FrameSlot {
 
         // Scan from newest to oldest
         for offset in 0..available {
-            let idx = ((seq - 1 - offset as u64) as usize) % self.history_capacity;
+            let idx = ((seq - 1 - offset as u64) as usize) % self.capacity;
             let entry = &history[idx];
 
             if entry.timestamp_ns <= target_ts {
@@ -392,23 +559,19 @@ impl FrameSlot {
         }
 
         loop {
-            let v1 = self.version.load(Ordering::Acquire);
-            if v1 & 1 == 1 {
-                std::hint::spin_loop();
-                continue;
-            }
+            let v1 = self.seqlock().read_begin(|| {});
 
-            let seq = self.sequence.load(Ordering::Acquire);
+            let seq = self.header.sequence.load(Ordering::Acquire);
             if seq == 0 {
                 return None;
             }
 
             let (oldest_ts, newest_ts) = unsafe {
-                let history = &*self.history.get();
-                let available = seq.min(self.history_capacity as u64) as usize;
+                let history = self.history_slice();
+                let available = seq.min(self.capacity as u64) as usize;
 
-                let newest_idx = ((seq - 1) as usize) % self.history_capacity;
-                let oldest_idx = ((seq - available as u64) as usize) % self.history_capacity;
+                let newest_idx = ((seq - 1) as usize) % self.capacity;
+                let oldest_idx = ((seq - available as u64) as usize) % self.capacity;
 
                 (
                     history[oldest_idx].timestamp_ns,
@@ -416,7 +579,7 @@ impl FrameSlot {
                 )
             };
 
-            let v2 = self.version.load(Ordering::Acquire);
+            let v2 = self.header.version.load(Ordering::Acquire);
             if v1 == v2 {
                 return Some((oldest_ts, newest_ts));
             }
@@ -562,4 +725,26 @@ mod tests {
         let entry = slot.read_latest().unwrap();
         assert!((entry.transform.translation[0] - 999.0).abs() < 1e-10);
     }
+
+    #[test]
+    fn test_shared_slot_survives_dead_writer() {
+        let header = SlotHeader::new();
+        let mut history = vec![TransformEntry::default(); 4];
+        let slot = unsafe { SlotRef::new(&header, history.as_mut_ptr(), 4, true) };
+        slot.init_dynamic(NO_PARENT);
+        slot.update(&Transform::from_translation([1.0, 0.0, 0.0]), 100);
+
+        // A writer in another process died between its version bumps
+        header.version.fetch_add(1, Ordering::SeqCst);
+        header
+            .writer
+            .store(super::super::seqlock::dead_pid(), Ordering::SeqCst);
+
+        let entry = slot.read_latest().unwrap();
+        assert_eq!(entry.timestamp_ns, 100);
+        assert_eq!(header.version.load(Ordering::SeqCst) & 1, 0);
+
+        slot.update(&Transform::from_translation([2.0, 0.0, 0.0]), 200);
+        assert_eq!(slot.read_latest().unwrap().timestamp_ns, 200);
+    }
 }
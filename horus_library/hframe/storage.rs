@@ -0,0 +1,436 @@
+//! Flat frame tables backing HFrameCore
+//!
+//! Every piece of per-frame state - slot headers, the topology index, frame
+//! names and the history rings - lives in one contiguous block made only of
+//! atomics and plain-old-data entries, addressed by offset. The block is
+//! either private heap memory or a `ShmRegion`; in the shared case every
+//! process that opens the same name works on one transform tree, writers
+//! update slots in place and readers resolve with the usual seqlock protocol.
+//!
+//! Block layout:
+//!
+//! ```text
+//! StorageHeader                        (2 cache lines)
+//! SlotHeader      [max_frames]         (1 cache line each)
+//! parents         [max_frames] u32
+//! depth           [max_frames] u32
+//! root            [max_frames] u32
+//! child_count     [max_frames] u32
+//! names           [max_frames] [u8; 64]
+//! history         [max_frames * history_len] TransformEntry
+//! ```
+
+use std::cell::UnsafeCell;
+use std::mem::size_of;
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+use horus_core::memory::ShmRegion;
+
+use super::messages::FRAME_ID_SIZE;
+use super::seqlock::SeqLock;
+use super::slot::{SlotHeader, SlotRef, TransformEntry};
+use super::types::{FrameId, HFrameError, HFrameResult, NO_PARENT};
+
+const STORAGE_MAGIC: u64 = 0x484F_5255_5346_524D; // "HORUSFRM"
+const STORAGE_LAYOUT_VERSION: u32 = 2;
+
+/// How long to wait for another process to finish initializing the tables
+const INIT_TIMEOUT: Duration = Duration::from_secs(5);
+
+const CACHE_LINE: usize = 64;
+
+/// Immutable description of the tables, written once by the creator
+#[repr(C, align(64))]
+struct StorageMeta {
+    magic: AtomicU64, // Stored last (Release) once the tables are initialized
+    layout_version: AtomicU32,
+    max_frames: AtomicU32,
+    history_len: AtomicU32,
+    _reserved: AtomicU32,
+    _padding: [u8; 40], // Pad to 64-byte cache line boundary (8 + 4 * 4 + 40 = 64)
+}
+
+/// Process-shared counters
+#[repr(C, align(64))]
+pub(crate) struct StorageHeader {
+    meta: StorageMeta,
+    /// Seqlock version over parents, depth, root and names
+    ///
+    /// Odd while a registration is in progress. Writers acquire it with a
+    /// CAS from even to odd, which also serializes them across processes.
+    pub(crate) topology: AtomicU64,
+    pub(crate) static_count: AtomicU64,
+    pub(crate) dynamic_count: AtomicU64,
+    /// Lowest frame ID never handed out
+    pub(crate) next_id: AtomicU32,
+    /// PID of the process holding `topology` odd
+    pub(crate) topology_owner: AtomicU32,
+    _padding: [u8; 32], // 8 * 3 + 4 * 2 + 32 = 64
+}
+
+/// Frame name slot: NUL-padded UTF-8, written only under the topology lock
+#[repr(C)]
+struct NameSlot(UnsafeCell<[u8; FRAME_ID_SIZE]>);
+
+/// Byte offsets of each table inside the block
+#[derive(Debug, Clone, Copy)]
+struct Layout {
+    slots: usize,
+    parents: usize,
+    depth: usize,
+    root: usize,
+    child_count: usize,
+    names: usize,
+    history: usize,
+    total: usize,
+}
+
+impl Layout {
+    fn new(max_frames: usize, history_len: usize) -> Self {
+        let align = |off: usize| (off + CACHE_LINE - 1) & !(CACHE_LINE - 1);
+        let u32_table = max_frames * size_of::<AtomicU32>();
+
+        let slots = size_of::<StorageHeader>();
+        let parents = align(slots + max_frames * size_of::<SlotHeader>());
+        let depth = parents + u32_table;
+        let root = depth + u32_table;
+        let child_count = root + u32_table;
+        let names = align(child_count + u32_table);
+        let history = align(names + max_frames * size_of::<NameSlot>());
+        let total = align(history + max_frames * history_len * size_of::<TransformEntry>());
+
+        Self {
+            slots,
+            parents,
+            depth,
+            root,
+            child_count,
+            names,
+            history,
+            total,
+        }
+    }
+}
+
+/// One cache line of heap memory, so heap-backed tables get 64-byte alignment
+#[repr(C, align(64))]
+#[derive(Clone, Copy)]
+struct CacheLine([u8; CACHE_LINE]);
+
+enum Backing {
+    Heap(#[allow(dead_code)] Vec<CacheLine>),
+    Shared(#[allow(dead_code)] ShmRegion),
+}
+
+/// Frame tables in heap or shared memory
+pub(crate) struct FrameStorage {
+    base: *mut u8,
+    layout: Layout,
+    max_frames: usize,
+    history_len: usize,
+    backing: Backing,
+}
+
+// Safety: every table is accessed through atomics or the seqlock protocol
+unsafe impl Send for FrameStorage {}
+unsafe impl Sync for FrameStorage {}
+
+impl FrameStorage {
+    /// Private tables for a single process
+    pub(crate) fn heap(max_frames: usize, history_len: usize) -> Self {
+        let layout = Layout::new(max_frames, history_len);
+        let mut lines = vec![CacheLine([0; CACHE_LINE]); layout.total / CACHE_LINE];
+        let base = lines.as_mut_ptr() as *mut u8;
+
+        let storage = Self {
+            base,
+            layout,
+            max_frames,
+            history_len,
+            backing: Backing::Heap(lines),
+        };
+        storage.initialize();
+        storage
+    }
+
+    /// Create or attach to tables shared under `name`
+    ///
+    /// The first process sizes and initializes them; later processes must
+    /// use the same `max_frames` and `history_len`.
+    pub(crate) fn shared(name: &str, max_frames: usize, history_len: usize) -> HFrameResult<Self> {
+        let layout = Layout::new(max_frames, history_len);
+        let region = ShmRegion::new(&format!("hframe_{}", name), layout.total)
+            .map_err(|e| HFrameError::SharedMemory(e.to_string()))?;
+
+        let base = region.as_ptr() as *mut u8;
+        if region.size() < layout.total || (base as usize) % CACHE_LINE != 0 {
+            return Err(HFrameError::SharedMemory(format!(
+                "Region for HFrame '{}' is too small or misaligned",
+                name
+            )));
+        }
+        let is_owner = region.is_owner();
+
+        let storage = Self {
+            base,
+            layout,
+            max_frames,
+            history_len,
+            backing: Backing::Shared(region),
+        };
+
+        if is_owner {
+            storage.initialize();
+        } else {
+            storage.validate(name)?;
+        }
+        Ok(storage)
+    }
+
+    /// Whether these tables are shared with other processes
+    pub(crate) fn is_shared(&self) -> bool {
+        matches!(self.backing, Backing::Shared(_))
+    }
+
+    /// Bring zeroed memory into the "no frames" state and publish it
+    fn initialize(&self) {
+        let header = self.header();
+        header.topology.store(0, Ordering::Relaxed);
+        header.topology_owner.store(0, Ordering::Relaxed);
+        header.static_count.store(0, Ordering::Relaxed);
+        header.dynamic_count.store(0, Ordering::Relaxed);
+        header.next_id.store(0, Ordering::Relaxed);
+
+        for id in 0..self.max_frames {
+            self.slot_header(id).clear();
+            self.parents()[id].store(NO_PARENT, Ordering::Relaxed);
+            self.depth()[id].store(0, Ordering::Relaxed);
+            self.root()[id].store(id as FrameId, Ordering::Relaxed);
+            self.child_count()[id].store(0, Ordering::Relaxed);
+        }
+
+        let meta = &header.meta;
+        meta.layout_version
+            .store(STORAGE_LAYOUT_VERSION, Ordering::Relaxed);
+        meta.max_frames
+            .store(self.max_frames as u32, Ordering::Relaxed);
+        meta.history_len
+            .store(self.history_len as u32, Ordering::Relaxed);
+        meta.magic.store(STORAGE_MAGIC, Ordering::Release);
+    }
+
+    /// Wait for the creator to publish the tables, then check they match ours
+    fn validate(&self, name: &str) -> HFrameResult<()> {
+        let meta = &self.header().meta;
+        let deadline = Instant::now() + INIT_TIMEOUT;
+        while meta.magic.load(Ordering::Acquire) != STORAGE_MAGIC {
+            if Instant::now() >= deadline {
+                return Err(HFrameError::SharedMemory(format!(
+                    "HFrame '{}' has an unrecognized shared memory layout (created by an older \
+                     HORUS version or still initializing)",
+                    name
+                )));
+            }
+            std::thread::yield_now();
+        }
+
+        let version = meta.layout_version.load(Ordering::Relaxed);
+        let max_frames = meta.max_frames.load(Ordering::Relaxed) as usize;
+        let history_len = meta.history_len.load(Ordering::Relaxed) as usize;
+        if version != STORAGE_LAYOUT_VERSION
+            || max_frames != self.max_frames
+            || history_len != self.history_len
+        {
+            return Err(HFrameError::ConfigError(format!(
+                "HFrame '{}' was created with layout v{}, {} frames, {} history entries; \
+                 this process expects v{}, {} frames, {} history entries",
+                name,
+                version,
+                max_frames,
+                history_len,
+                STORAGE_LAYOUT_VERSION,
+                self.max_frames,
+                self.history_len
+            )));
+        }
+        Ok(())
+    }
+
+    // ========================================================================
+    // Table Access
+    // ========================================================================
+
+    #[inline]
+    pub(crate) fn max_frames(&self) -> usize {
+        self.max_frames
+    }
+
+    #[inline]
+    pub(crate) fn header(&self) -> &StorageHeader {
+        unsafe { &*(self.base as *const StorageHeader) }
+    }
+
+    #[inline]
+    fn slot_header(&self, id: usize) -> &SlotHeader {
+        debug_assert!(id < self.max_frames);
+        unsafe { &*(self.base.add(self.layout.slots) as *const SlotHeader).add(id) }
+    }
+
+    /// Seqlocked slot for frame `id` (must be below `max_frames`)
+    #[inline]
+    pub(crate) fn slot(&self, id: FrameId) -> SlotRef<'_> {
+        let idx = id as usize;
+        assert!(idx < self.max_frames, "frame id {} out of range", id);
+        unsafe {
+            let history = (self.base.add(self.layout.history) as *mut TransformEntry)
+                .add(idx * self.history_len);
+            SlotRef::new(
+                self.slot_header(idx),
+                history,
+                self.history_len,
+                self.is_shared(),
+            )
+        }
+    }
+
+    /// Seqlock over the topology tables and names
+    #[inline]
+    pub(crate) fn topology_lock(&self) -> SeqLock<'_> {
+        let header = self.header();
+        SeqLock::new(&header.topology, &header.topology_owner, self.is_shared())
+    }
+
+    #[inline]
+    fn u32_table(&self, offset: usize) -> &[AtomicU32] {
+        unsafe {
+            std::slice::from_raw_parts(self.base.add(offset) as *const AtomicU32, self.max_frames)
+        }
+    }
+
+    /// Parent of each frame (NO_PARENT for roots)
+    #[inline]
+    pub(crate) fn parents(&self) -> &[AtomicU32] {
+        self.u32_table(self.layout.parents)
+    }
+
+    /// Depth of each frame below the root of its tree
+    #[inline]
+    pub(crate) fn depth(&self) -> &[AtomicU32] {
+        self.u32_table(self.layout.depth)
+    }
+
+    /// Root frame of each frame's tree
+    #[inline]
+    pub(crate) fn root(&self) -> &[AtomicU32] {
+        self.u32_table(self.layout.root)
+    }
+
+    /// Number of frames whose parent is each frame
+    #[inline]
+    pub(crate) fn child_count(&self) -> &[AtomicU32] {
+        self.u32_table(self.layout.child_count)
+    }
+
+    #[inline]
+    fn name_slot(&self, id: FrameId) -> *mut [u8; FRAME_ID_SIZE] {
+        let idx = id as usize;
+        assert!(idx < self.max_frames, "frame id {} out of range", id);
+        unsafe {
+            (*(self.base.add(self.layout.names) as *const NameSlot).add(idx))
+                .0
+                .get()
+        }
+    }
+
+    /// Copy of the raw name bytes of `id`
+    ///
+    /// Not synchronized on its own; readers validate against `topology`.
+    #[inline]
+    pub(crate) fn name_bytes(&self, id: FrameId) -> [u8; FRAME_ID_SIZE] {
+        unsafe { std::ptr::read_volatile(self.name_slot(id)) }
+    }
+
+    /// Overwrite the name of `id` (empty clears it)
+    ///
+    /// # Safety
+    /// The caller must hold the topology lock.
+    pub(crate) unsafe fn write_name(&self, id: FrameId, name: &str) {
+        let mut bytes = [0u8; FRAME_ID_SIZE];
+        bytes[..name.len()].copy_from_slice(name.as_bytes());
+        std::ptr::write_volatile(self.name_slot(id), bytes);
+    }
+}
+
+/// Longest frame name that fits a name slot (one byte is kept for the NUL)
+pub(crate) const MAX_FRAME_NAME_LEN: usize = FRAME_ID_SIZE - 1;
+
+/// Whether stored name bytes spell exactly `name`
+#[inline]
+pub(crate) fn name_matches(bytes: &[u8; FRAME_ID_SIZE], name: &str) -> bool {
+    let name = name.as_bytes();
+    name.len() <= MAX_FRAME_NAME_LEN
+        && !name.is_empty()
+        && &bytes[..name.len()] == name
+        && bytes[name.len()] == 0
+}
+
+/// Decode stored name bytes (None for an empty slot)
+#[inline]
+pub(crate) fn decode_name(bytes: &[u8; FRAME_ID_SIZE]) -> Option<String> {
+    let len = bytes.iter().position(|&b| b == 0).unwrap_or(FRAME_ID_SIZE);
+    if len == 0 {
+        None
+    } else {
+        Some(String::from_utf8_lossy(&bytes[..len]).into_owned())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::hframe::transform::Transform;
+
+    #[test]
+    fn test_layout_alignment() {
+        let layout = Layout::new(256, 32);
+        for offset in [layout.slots, layout.parents, layout.names, layout.history] {
+            assert_eq!(offset % CACHE_LINE, 0);
+        }
+        assert_eq!(size_of::<StorageHeader>(), 2 * CACHE_LINE);
+        assert!(layout.total >= layout.history + 256 * 32 * size_of::<TransformEntry>());
+    }
+
+    #[test]
+    fn test_shared_tables_visible_across_handles() {
+        let name = format!("test_storage_{}", std::process::id());
+        let a = FrameStorage::shared(&name, 16, 4).unwrap();
+        let b = FrameStorage::shared(&name, 16, 4).unwrap();
+        assert!(a.is_shared());
+
+        a.slot(3).init_dynamic(NO_PARENT);
+        a.slot(3)
+            .update(&Transform::from_translation([1.0, 2.0, 3.0]), 100);
+        a.parents()[3].store(1, Ordering::Release);
+
+        let entry = b.slot(3).read_latest().unwrap();
+        assert_eq!(entry.timestamp_ns, 100);
+        assert_eq!(entry.transform.translation, [1.0, 2.0, 3.0]);
+        assert_eq!(b.parents()[3].load(Ordering::Acquire), 1);
+
+        // Mismatched configuration is rejected
+        assert!(FrameStorage::shared(&name, 32, 4).is_err());
+    }
+
+    #[test]
+    fn test_names() {
+        let storage = FrameStorage::heap(4, 2);
+        assert_eq!(decode_name(&storage.name_bytes(1)), None);
+
+        unsafe { storage.write_name(1, "base_link") };
+        let bytes = storage.name_bytes(1);
+        assert!(name_matches(&bytes, "base_link"));
+        assert!(!name_matches(&bytes, "base"));
+        assert_eq!(decode_name(&bytes).as_deref(), Some("base_link"));
+    }
+}
@@ -49,6 +49,12 @@ pub enum HFrameError {
 
     #[error("Configuration error: {0}")]
     ConfigError(String),
+
+    #[error("Frame name '{0}' is too long (max {1} bytes)")]
+    NameTooLong(String, usize),
+
+    #[error("Shared memory error: {0}")]
+    SharedMemory(String),
 }
 
 /// Result type for HFrame operations
@@ -58,7 +58,8 @@ pub use diagnostics::{
 
 // Vision
 pub use vision::{
-    CameraInfo, CompressedImage, Detection, DetectionArray, Image, ImageEncoding, RegionOfInterest,
+    CameraInfo, CompressedImage, Detection, DetectionArray, Image, ImageEncoding, ImageHandle,
+    RegionOfInterest,
 };
 
 // Navigation
@@ -74,7 +75,9 @@ pub use io::{
 };
 
 // Perception
-pub use perception::{BoundingBox3D, DepthImage, PlaneDetection, PointCloud};
+pub use perception::{
+    BoundingBox3D, DepthImage, DepthImageHandle, PlaneDetection, PointCloud, PointCloudHandle,
+};
 
 // Coordination
 pub use coordination::{FleetStatus, FormationControl, RobotState, TaskAssignment};
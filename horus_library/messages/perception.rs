@@ -5,8 +5,10 @@
 
 use crate::messages::geometry::{Point3, Quaternion, Vector3};
 use horus_core::core::LogSummary;
+use horus_core::memory::{BlobHandle, BlobMessage, BlobView, ShmBlobPool};
 use serde::{Deserialize, Serialize};
 use serde_arrays;
+use std::sync::Arc;
 
 /// Point field description for flexible point cloud data
 #[derive(Debug, Clone, Copy, Serialize, Deserialize, PartialEq, Eq)]
@@ -277,6 +279,121 @@ impl PointCloud {
     }
 }
 
+/// Fixed-layout point cloud message whose point data lives in a blob pool
+///
+/// Same layout description as `PointCloud`, but `Copy` and heap-free: the
+/// binary point data is written straight into a `ShmBlobPool` slot and only
+/// this header travels through the Hub ring. Resolve the points with
+/// `Hub::recv_blob(&pool, ctx)` or `points(&pool)`.
+#[derive(Debug, Clone, Copy, Serialize, Deserialize, Default)]
+#[repr(C)]
+pub struct PointCloudHandle {
+    /// Point cloud dimensions
+    pub width: u32,
+    pub height: u32,
+    /// Field descriptions
+    pub fields: [PointField; 16],
+    /// Number of valid fields
+    pub field_count: u8,
+    /// Is data organized as image (true) or unorganized (false)
+    pub is_dense: bool,
+    /// Size of each point in bytes
+    pub point_step: u32,
+    /// Size of each row in bytes
+    pub row_step: u32,
+    /// Coordinate frame reference
+    pub frame_id: [u8; 32],
+    /// Timestamp in nanoseconds since epoch
+    pub timestamp: u64,
+    /// Point data (binary blob) in the blob pool
+    pub blob: BlobHandle,
+}
+
+impl PointCloudHandle {
+    /// Describe an XYZ (3 x f32) cloud of `point_count` points stored in `blob`
+    ///
+    /// Producers loan `point_count * 12` bytes and write `[x, y, z]` f32
+    /// triples directly, e.g. via `BlobMut::as_mut_pod::<f32>()`.
+    pub fn xyz(point_count: u32, blob: BlobHandle) -> Self {
+        let mut cloud = Self {
+            width: point_count,
+            height: 1,
+            is_dense: true,
+            point_step: 12,
+            row_step: 12 * point_count,
+            timestamp: std::time::SystemTime::now()
+                .duration_since(std::time::UNIX_EPOCH)
+                .unwrap()
+                .as_nanos() as u64,
+            blob,
+            ..Default::default()
+        };
+        cloud.fields[0] = PointField::new("x", 0, PointFieldType::Float32, 1);
+        cloud.fields[1] = PointField::new("y", 4, PointFieldType::Float32, 1);
+        cloud.fields[2] = PointField::new("z", 8, PointFieldType::Float32, 1);
+        cloud.field_count = 3;
+        cloud
+    }
+
+    /// Take the field layout of an existing cloud, pointing at `blob`
+    pub fn from_layout(cloud: &PointCloud, blob: BlobHandle) -> Self {
+        Self {
+            width: cloud.width,
+            height: cloud.height,
+            fields: cloud.fields,
+            field_count: cloud.field_count,
+            is_dense: cloud.is_dense,
+            point_step: cloud.point_step,
+            row_step: cloud.row_step,
+            frame_id: cloud.frame_id,
+            timestamp: cloud.timestamp,
+            blob,
+        }
+    }
+
+    /// Get total number of points
+    pub fn point_count(&self) -> u32 {
+        self.width * self.height
+    }
+
+    /// Set frame ID
+    pub fn with_frame_id(mut self, frame_id: &str) -> Self {
+        let frame_bytes = frame_id.as_bytes();
+        let len = frame_bytes.len().min(31);
+        self.frame_id[..len].copy_from_slice(&frame_bytes[..len]);
+        self.frame_id[len] = 0;
+        self
+    }
+
+    /// Resolve the point data (None if the slot was already recycled)
+    pub fn points(&self, pool: &Arc<ShmBlobPool>) -> Option<BlobView> {
+        pool.view(&self.blob)
+    }
+
+    /// Copy into an owned `PointCloud` (for code that still needs `Vec` data)
+    pub fn to_point_cloud(&self, pool: &Arc<ShmBlobPool>) -> Option<PointCloud> {
+        let points = self.points(pool)?;
+        Some(PointCloud {
+            width: self.width,
+            height: self.height,
+            fields: self.fields,
+            field_count: self.field_count,
+            is_dense: self.is_dense,
+            point_step: self.point_step,
+            row_step: self.row_step,
+            data: points.to_vec(),
+            frame_id: self.frame_id,
+            timestamp: self.timestamp,
+        })
+    }
+}
+
+impl BlobMessage for PointCloudHandle {
+    fn blob_handle(&self) -> BlobHandle {
+        self.blob
+    }
+}
+
 /// 3D bounding box
 #[derive(Debug, Clone, Copy, Serialize, Deserialize, Default)]
 pub struct BoundingBox3D {
@@ -547,6 +664,94 @@ impl DepthImage {
     }
 }
 
+/// Fixed-layout depth image message whose depths live in a blob pool
+///
+/// Depth values are `u16` millimeters written in place into a `ShmBlobPool`
+/// slot (`BlobMut::as_mut_pod::<u16>()`); read them with `depths(&pool)` and
+/// `BlobView::as_pod::<u16>()`.
+#[derive(Debug, Clone, Copy, Serialize, Deserialize)]
+#[repr(C)]
+pub struct DepthImageHandle {
+    /// Image width in pixels
+    pub width: u32,
+    /// Image height in pixels
+    pub height: u32,
+    /// Minimum reliable depth value
+    pub min_depth: u16,
+    /// Maximum reliable depth value
+    pub max_depth: u16,
+    /// Depth scale (mm per unit)
+    pub depth_scale: f32,
+    /// Frame ID for camera reference
+    pub frame_id: [u8; 32],
+    /// Timestamp in nanoseconds since epoch
+    pub timestamp: u64,
+    /// Depth values (row-major u16) in the blob pool
+    pub blob: BlobHandle,
+}
+
+impl Default for DepthImageHandle {
+    fn default() -> Self {
+        Self {
+            width: 0,
+            height: 0,
+            min_depth: 200,   // 20cm minimum
+            max_depth: 10000, // 10m maximum
+            depth_scale: 1.0, // 1mm per unit
+            frame_id: [0; 32],
+            timestamp: 0,
+            blob: BlobHandle::default(),
+        }
+    }
+}
+
+impl DepthImageHandle {
+    /// Create a handle message for a published depth blob
+    pub fn new(width: u32, height: u32, blob: BlobHandle) -> Self {
+        Self {
+            width,
+            height,
+            timestamp: std::time::SystemTime::now()
+                .duration_since(std::time::UNIX_EPOCH)
+                .unwrap()
+                .as_nanos() as u64,
+            blob,
+            ..Default::default()
+        }
+    }
+
+    /// Size in bytes of the depth payload
+    pub fn expected_size(&self) -> usize {
+        self.width as usize * self.height as usize * std::mem::size_of::<u16>()
+    }
+
+    /// Resolve the depth data (None if the slot was already recycled)
+    pub fn depths(&self, pool: &Arc<ShmBlobPool>) -> Option<BlobView> {
+        pool.view(&self.blob)
+    }
+
+    /// Copy into an owned `DepthImage` (for code that still needs `Vec` data)
+    pub fn to_depth_image(&self, pool: &Arc<ShmBlobPool>) -> Option<DepthImage> {
+        let depths = self.depths(pool)?;
+        Some(DepthImage {
+            width: self.width,
+            height: self.height,
+            depths: depths.as_pod::<u16>().to_vec(),
+            min_depth: self.min_depth,
+            max_depth: self.max_depth,
+            depth_scale: self.depth_scale,
+            frame_id: self.frame_id,
+            timestamp: self.timestamp,
+        })
+    }
+}
+
+impl BlobMessage for DepthImageHandle {
+    fn blob_handle(&self) -> BlobHandle {
+        self.blob
+    }
+}
+
 /// Planar surface detection result
 #[derive(Debug, Clone, Copy, Serialize, Deserialize, Default)]
 pub struct PlaneDetection {
@@ -644,6 +849,18 @@ impl LogSummary for PointCloud {
     }
 }
 
+impl LogSummary for PointCloudHandle {
+    fn log_summary(&self) -> String {
+        format!(
+            "PointCloudHandle({} points, {} fields, {} bytes @slot {})",
+            self.point_count(),
+            self.field_count,
+            self.blob.len,
+            self.blob.slot
+        )
+    }
+}
+
 impl LogSummary for PointField {
     fn log_summary(&self) -> String {
         format!("PointField('{}', {:?})", self.name_str(), self.datatype)
@@ -684,6 +901,15 @@ impl LogSummary for DepthImage {
     }
 }
 
+impl LogSummary for DepthImageHandle {
+    fn log_summary(&self) -> String {
+        format!(
+            "DepthImageHandle({}x{}, {} bytes @slot {})",
+            self.width, self.height, self.blob.len, self.blob.slot
+        )
+    }
+}
+
 impl LogSummary for PlaneDetection {
     fn log_summary(&self) -> String {
         format!(
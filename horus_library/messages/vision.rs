@@ -4,6 +4,7 @@
 // cameras, images, and visual perception systems.
 
 use horus_core::core::LogSummary;
+use horus_core::memory::{BlobHandle, BlobMessage, BlobView, ShmBlobPool};
 use serde::{Deserialize, Serialize};
 use serde_arrays;
 
@@ -183,6 +184,109 @@ impl ImageEncoding {
     }
 }
 
+/// Fixed-layout image message whose pixels live in a shared memory blob pool
+///
+/// Unlike `Image`, this type is `Copy` and carries no heap data, so it goes
+/// through a Hub ring as-is while the pixels stay in a `ShmBlobPool` slot.
+/// Producers loan a slot, write pixels in place and publish:
+///
+/// ```rust,ignore
+/// let mut blob = pool.loan(height as usize * step as usize)?;
+/// camera.read_frame_into(blob.as_mut_slice());
+/// hub.send(ImageHandle::new(width, height, ImageEncoding::Rgb8, blob.publish()), &mut ctx)?;
+/// ```
+///
+/// Subscribers use `Hub::recv_blob(&pool, ctx)` to get the pixels without a copy.
+#[derive(Debug, Clone, Copy, Serialize, Deserialize)]
+#[repr(C)]
+pub struct ImageHandle {
+    /// Image width in pixels
+    pub width: u32,
+    /// Image height in pixels
+    pub height: u32,
+    /// Pixel encoding format
+    pub encoding: ImageEncoding,
+    /// Bytes per row (may include padding)
+    pub step: u32,
+    /// Frame ID (camera identifier)
+    pub frame_id: [u8; 32],
+    /// Timestamp in nanoseconds since epoch
+    pub timestamp: u64,
+    /// Pixel data (row-major order) in the blob pool
+    pub blob: BlobHandle,
+}
+
+impl Default for ImageHandle {
+    fn default() -> Self {
+        Self {
+            width: 0,
+            height: 0,
+            encoding: ImageEncoding::Rgb8,
+            step: 0,
+            frame_id: [0; 32],
+            timestamp: 0,
+            blob: BlobHandle::default(),
+        }
+    }
+}
+
+impl ImageHandle {
+    /// Create a handle message for a published pixel blob
+    pub fn new(width: u32, height: u32, encoding: ImageEncoding, blob: BlobHandle) -> Self {
+        Self {
+            width,
+            height,
+            encoding,
+            step: width * encoding.bytes_per_pixel(),
+            frame_id: [0; 32],
+            timestamp: std::time::SystemTime::now()
+                .duration_since(std::time::UNIX_EPOCH)
+                .unwrap()
+                .as_nanos() as u64,
+            blob,
+        }
+    }
+
+    /// Set the frame ID from string
+    pub fn with_frame_id(mut self, frame_id: &str) -> Self {
+        let frame_bytes = frame_id.as_bytes();
+        let len = frame_bytes.len().min(31);
+        self.frame_id[..len].copy_from_slice(&frame_bytes[..len]);
+        self.frame_id[len] = 0;
+        self
+    }
+
+    /// Get expected data size in bytes
+    pub fn expected_size(&self) -> usize {
+        (self.step * self.height) as usize
+    }
+
+    /// Resolve the pixel data (None if the slot was already recycled)
+    pub fn pixels(&self, pool: &std::sync::Arc<ShmBlobPool>) -> Option<BlobView> {
+        pool.view(&self.blob)
+    }
+
+    /// Copy into an owned `Image` (for code that still needs `Vec` data)
+    pub fn to_image(&self, pool: &std::sync::Arc<ShmBlobPool>) -> Option<Image> {
+        let pixels = self.pixels(pool)?;
+        Some(Image {
+            width: self.width,
+            height: self.height,
+            encoding: self.encoding,
+            step: self.step,
+            data: pixels.to_vec(),
+            frame_id: self.frame_id,
+            timestamp: self.timestamp,
+        })
+    }
+}
+
+impl BlobMessage for ImageHandle {
+    fn blob_handle(&self) -> BlobHandle {
+        self.blob
+    }
+}
+
 /// Compressed image data (JPEG, PNG, etc.)
 #[derive(Debug, Clone, Serialize, Deserialize, Default)]
 pub struct CompressedImage {
@@ -512,6 +616,15 @@ impl LogSummary for Image {
     }
 }
 
+impl LogSummary for ImageHandle {
+    fn log_summary(&self) -> String {
+        format!(
+            "ImageHandle({}x{}, {:?}, {} bytes @slot {})",
+            self.width, self.height, self.encoding, self.blob.len, self.blob.slot
+        )
+    }
+}
+
 impl LogSummary for CompressedImage {
     fn log_summary(&self) -> String {
         format!(
@@ -592,6 +705,29 @@ mod tests {
         assert!(image.is_valid());
     }
 
+    #[test]
+    fn test_image_handle_zero_copy() {
+        let pool = ShmBlobPool::new(
+            &format!("test_image_handle_{}", std::process::id()),
+            4 * 2 * 3,
+            4,
+            2,
+        )
+        .unwrap();
+
+        let mut blob = pool.loan(4 * 2 * 3).unwrap();
+        blob.as_mut_slice().fill(128);
+        let handle = ImageHandle::new(4, 2, ImageEncoding::Rgb8, blob.publish());
+
+        assert_eq!(handle.expected_size(), 24);
+        let pixels = handle.pixels(&pool).unwrap();
+        assert_eq!(pixels.len(), 24);
+        assert!(pixels.iter().all(|&p| p == 128));
+
+        let image = handle.to_image(&pool).unwrap();
+        assert!(image.is_valid());
+    }
+
     #[test]
     fn test_encoding_properties() {
         assert_eq!(ImageEncoding::Rgb8.bytes_per_pixel(), 3);
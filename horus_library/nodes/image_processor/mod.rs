@@ -1,3 +1,5 @@
+use crate::algorithms::image_preprocess::{PixelFormat, PreprocessConfig, Preprocessor};
+use crate::vision::ImageEncoding;
 use crate::Image;
 use horus_core::error::HorusResult;
 
@@ -27,7 +29,8 @@ pub enum ImageBackend {
 ///
 /// Supported backends:
 /// - OpenCV (cv::imgproc for actual image processing)
-/// - Simulation mode for testing
+/// - Simulation mode for testing (resize runs on the native SIMD kernel,
+///   other stages are only logged)
 pub struct ImageProcessorNode {
     subscriber: Hub<Image>,
     publisher: Hub<Image>,
@@ -47,6 +50,9 @@ pub struct ImageProcessorNode {
     #[cfg(feature = "opencv")]
     _opencv_mat: Option<Mat>,
 
+    // Native resize pipeline, rebuilt when the target size changes
+    resizer: Option<Preprocessor>,
+
     // Statistics
     images_processed: u64,
     processing_time_us: u64,
@@ -83,6 +89,7 @@ impl ImageProcessorNode {
             backend,
             #[cfg(feature = "opencv")]
             _opencv_mat: None,
+            resizer: None,
             images_processed: 0,
             processing_time_us: 0,
         })
@@ -194,9 +201,17 @@ impl ImageProcessorNode {
                 image.width, image.height, self.target_width, self.target_height
             ));
 
-            // Simulation: just update dimensions
-            processed.width = self.target_width;
-            processed.height = self.target_height;
+            match self.resize_native(&image) {
+                Some(resized) => processed = resized,
+                None => {
+                    ctx.log_warning(&format!(
+                        "Native resize does not support {:?}; updating dimensions only",
+                        image.encoding
+                    ));
+                    processed.width = self.target_width;
+                    processed.height = self.target_height;
+                }
+            }
         }
 
         // 2. Convert to grayscale if enabled
@@ -233,6 +248,48 @@ impl ImageProcessorNode {
         Some(processed)
     }
 
+    /// Resize with the native kernel, keeping RGB/BGR channel order
+    ///
+    /// Alpha is dropped and Mono8 is expanded to three channels.
+    fn resize_native(&mut self, image: &Image) -> Option<Image> {
+        let format = PixelFormat::from_encoding(image.encoding)?;
+        let bgr = matches!(format, PixelFormat::Bgr8 | PixelFormat::Bgra8);
+        let (w, h) = (self.target_width as usize, self.target_height as usize);
+
+        let stale = self.resizer.as_ref().map_or(true, |r| {
+            let cfg = r.config();
+            cfg.width != w || cfg.height != h || cfg.bgr_output != bgr
+        });
+        if stale {
+            let mut config = PreprocessConfig::unit(w, h);
+            config.bgr_output = bgr;
+            self.resizer = Some(Preprocessor::new(config));
+        }
+        let resizer = self.resizer.as_mut()?;
+
+        let mut data = vec![0u8; w * h * 3];
+        resizer
+            .resize_into(
+                &image.data,
+                image.width as usize,
+                image.height as usize,
+                image.step as usize,
+                format,
+                &mut data,
+            )
+            .ok()?;
+
+        let encoding = if bgr {
+            ImageEncoding::Bgr8
+        } else {
+            ImageEncoding::Rgb8
+        };
+        let mut resized = Image::new(self.target_width, self.target_height, encoding, data);
+        resized.frame_id = image.frame_id;
+        resized.timestamp = image.timestamp;
+        Some(resized)
+    }
+
     #[cfg(feature = "opencv")]
     /// Process image using OpenCV
     fn process_image_opencv(
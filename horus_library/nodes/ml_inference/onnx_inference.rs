@@ -46,6 +46,8 @@ use horus_core::{HorusError, HorusResult, Hub, Node, NodeInfo};
 use std::path::Path;
 use std::time::Instant;
 
+#[cfg(feature = "onnx")]
+use crate::algorithms::image_preprocess::{PixelFormat, PreprocessConfig, Preprocessor};
 #[cfg(feature = "onnx")]
 use ndarray::{Array, ArrayD, IxDyn};
 
@@ -110,6 +112,10 @@ pub struct ONNXInferenceNode {
     config: InferenceConfig,
     /// Model metadata
     model_info: ModelInfo,
+    /// Fused image preprocessing pipeline (created for the target size)
+    preprocessor: Option<Preprocessor>,
+    /// Reused NCHW input tensor the preprocessor writes into
+    input_tensor: Option<OrtTensor<f32>>,
     /// Frame counter
     frame_count: u64,
 }
@@ -135,6 +141,8 @@ impl ONNXInferenceNode {
             session,
             config,
             model_info,
+            preprocessor: None,
+            input_tensor: None,
             frame_count: 0,
         })
     }
@@ -158,6 +166,8 @@ impl ONNXInferenceNode {
             session,
             config,
             model_info,
+            preprocessor: None,
+            input_tensor: None,
             frame_count: 0,
         })
     }
@@ -236,116 +246,92 @@ impl ONNXInferenceNode {
         })
     }
 
-    /// Preprocess image for inference
-    fn preprocess_image(&self, image: &Image) -> HorusResult<ArrayD<f32>> {
-        let width = image.width as usize;
-        let height = image.height as usize;
-
-        // Determine target size
-        let (target_h, target_w) = if let Some([h, w]) = self.config.input_size {
-            (h as usize, w as usize)
-        } else {
-            // Use model input size
-            if let Some(shape) = self.model_info.input_shapes.first() {
-                if shape.len() == 4 {
-                    // NCHW format
-                    (shape[2], shape[3])
-                } else {
-                    return Err(HorusError::Config(
-                        "Unexpected input shape format".to_string(),
-                    ));
-                }
-            } else {
-                return Err(HorusError::Config("No input shape found".to_string()));
-            }
-        };
-
-        // Convert image data to float and resize if needed
-        let mut tensor = if width != target_w || height != target_h {
-            // Need to resize - use basic nearest neighbor for now
-            // In production, use image crate for better quality
-            self.resize_image(&image.data, width, height, target_w, target_h)?
-        } else {
-            // Direct conversion
-            let mut data = Vec::with_capacity(width * height * 3);
-            for &pixel in &image.data {
-                data.push(pixel as f32 / 255.0);
-            }
-            Array::from_shape_vec(IxDyn(&[height, width, 3]), data)
-                .map_err(|e| HorusError::Config(format!("Array reshape failed: {}", e)))?
-        };
-
-        // Normalize if enabled
-        if self.config.enable_preprocessing {
-            let shape = tensor.shape().to_vec();
-            let (mut data, _offset) = tensor.into_raw_vec_and_offset();
-
-            for y in 0..target_h {
-                for x in 0..target_w {
-                    for c in 0..3 {
-                        let idx = y * target_w * 3 + x * 3 + c;
-                        data[idx] =
-                            (data[idx] - self.config.norm_mean[c]) / self.config.norm_std[c];
-                    }
-                }
-            }
-
-            tensor = Array::from_shape_vec(IxDyn(&shape), data)
-                .map_err(|e| HorusError::Config(format!("Array reshape failed: {}", e)))?;
+    /// Target input size [height, width]
+    fn target_size(&self) -> HorusResult<(usize, usize)> {
+        if let Some([h, w]) = self.config.input_size {
+            return Ok((h as usize, w as usize));
         }
+        // Use model input size
+        match self.model_info.input_shapes.first() {
+            // NCHW format
+            Some(shape) if shape.len() == 4 => Ok((shape[2], shape[3])),
+            Some(_) => Err(HorusError::Config(
+                "Unexpected input shape format".to_string(),
+            )),
+            None => Err(HorusError::Config("No input shape found".to_string())),
+        }
+    }
 
-        // Convert HWC to NCHW (batch, channels, height, width)
-        let hwc = tensor
-            .into_shape_with_order(IxDyn(&[target_h, target_w, 3]))
-            .map_err(|e| HorusError::Config(format!("HWC reshape failed: {}", e)))?;
-
-        let mut nchw_data = vec![0.0f32; 1 * 3 * target_h * target_w];
-
-        for c in 0..3 {
-            for y in 0..target_h {
-                for x in 0..target_w {
-                    let src_idx = y * target_w * 3 + x * 3 + c;
-                    let dst_idx = c * target_h * target_w + y * target_w + x;
-                    nchw_data[dst_idx] = hwc.as_slice().unwrap()[src_idx];
-                }
+    /// Preprocess image straight into the reusable NCHW input tensor
+    ///
+    /// Resize, color conversion, normalization and the HWC→NCHW transpose
+    /// run as one fused pass (see `algorithms::image_preprocess`).
+    fn preprocess_image(&mut self, image: &Image) -> HorusResult<()> {
+        let (target_h, target_w) = self.target_size()?;
+        let format = PixelFormat::from_encoding(image.encoding).ok_or_else(|| {
+            HorusError::Config(format!("Unsupported image encoding: {:?}", image.encoding))
+        })?;
+
+        let stale = self
+            .preprocessor
+            .as_ref()
+            .map_or(true, |p| p.output_shape() != [1, 3, target_h, target_w]);
+        if stale {
+            // Without normalization the input is only scaled to 0..1
+            let mut pre_config = PreprocessConfig::unit(target_w, target_h);
+            if self.config.enable_preprocessing {
+                pre_config.mean = self.config.norm_mean;
+                pre_config.std = self.config.norm_std;
             }
+            let preprocessor = Preprocessor::new(pre_config);
+            let tensor = OrtTensor::from_array((
+                preprocessor.output_shape(),
+                vec![0.0f32; preprocessor.output_len()],
+            ))
+            .map_err(|e| HorusError::config(format!("Failed to create input tensor: {}", e)))?;
+            self.preprocessor = Some(preprocessor);
+            self.input_tensor = Some(tensor);
         }
 
-        let nchw = Array::from_shape_vec(IxDyn(&[1, 3, target_h, target_w]), nchw_data)
-            .map_err(|e| HorusError::Config(format!("NCHW reshape failed: {}", e)))?;
-
-        Ok(nchw)
+        let (preprocessor, tensor) = match (self.preprocessor.as_mut(), self.input_tensor.as_mut())
+        {
+            (Some(p), Some(t)) => (p, t),
+            _ => {
+                return Err(HorusError::config(
+                    "Preprocessor not initialized".to_string(),
+                ))
+            }
+        };
+        let mut input = tensor.extract_array_mut();
+        let out = input
+            .as_slice_mut()
+            .ok_or_else(|| HorusError::config("Input tensor is not contiguous".to_string()))?;
+
+        preprocessor
+            .run(
+                &image.data,
+                image.width as usize,
+                image.height as usize,
+                image.step as usize,
+                format,
+                out,
+            )
+            .map_err(|e| HorusError::Config(format!("Preprocessing failed: {}", e)))
     }
 
-    /// Basic image resize (nearest neighbor)
-    fn resize_image(
-        &self,
-        data: &[u8],
-        src_w: usize,
-        src_h: usize,
-        dst_w: usize,
-        dst_h: usize,
-    ) -> HorusResult<ArrayD<f32>> {
-        let mut resized = vec![0.0f32; dst_h * dst_w * 3];
-
-        let x_ratio = src_w as f32 / dst_w as f32;
-        let y_ratio = src_h as f32 / dst_h as f32;
-
-        for y in 0..dst_h {
-            for x in 0..dst_w {
-                let src_x = (x as f32 * x_ratio) as usize;
-                let src_y = (y as f32 * y_ratio) as usize;
-
-                for c in 0..3 {
-                    let src_idx = (src_y * src_w + src_x) * 3 + c;
-                    let dst_idx = (y * dst_w + x) * 3 + c;
-                    resized[dst_idx] = data[src_idx] as f32 / 255.0;
-                }
-            }
-        }
+    /// Run inference on the preprocessed image tensor
+    fn run_image_inference(&mut self) -> HorusResult<Vec<ArrayD<f32>>> {
+        let input = self
+            .input_tensor
+            .as_ref()
+            .ok_or_else(|| HorusError::config("No preprocessed input".to_string()))?;
+
+        let outputs = self
+            .session
+            .run(ort::inputs![input])
+            .map_err(|e| HorusError::config(format!("Inference failed: {}", e)))?;
 
-        Array::from_shape_vec(IxDyn(&[dst_h, dst_w, 3]), resized)
-            .map_err(|e| HorusError::Config(format!("Resize reshape failed: {}", e)))
+        Self::extract_outputs(&outputs)
     }
 
     /// Run inference on preprocessed tensor
@@ -360,7 +346,11 @@ impl ONNXInferenceNode {
             .run(ort::inputs![input_tensor])
             .map_err(|e| HorusError::config(format!("Inference failed: {}", e)))?;
 
-        // Convert outputs to ndarray
+        Self::extract_outputs(&outputs)
+    }
+
+    /// Convert session outputs to ndarray
+    fn extract_outputs(outputs: &ort::session::SessionOutputs) -> HorusResult<Vec<ArrayD<f32>>> {
         let mut result_tensors = Vec::new();
         for i in 0..outputs.len() {
             let array_view: ndarray::ArrayViewD<f32> =
@@ -424,16 +414,13 @@ impl Node for ONNXInferenceNode {
                 let start = Instant::now();
 
                 // Preprocess
-                let input = match self.preprocess_image(&image) {
-                    Ok(t) => t,
-                    Err(e) => {
-                        eprintln!("Preprocessing failed: {}", e);
-                        return;
-                    }
-                };
+                if let Err(e) = self.preprocess_image(&image) {
+                    eprintln!("Preprocessing failed: {}", e);
+                    return;
+                }
 
                 // Run inference
-                let outputs = match self.run_inference(input) {
+                let outputs = match self.run_image_inference() {
                     Ok(o) => o,
                     Err(e) => {
                         eprintln!("Inference failed: {}", e);
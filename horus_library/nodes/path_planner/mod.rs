@@ -140,9 +140,14 @@ impl PathPlannerNode {
         // Clear previous obstacles
         self.occupancy_grid.clear();
 
+        // Whole-scan ray tracing, no per-ray allocation
+        self.occupancy_grid
+            .integrate_scan(self.current_pose, lidar_data);
+
         let (robot_x, robot_y, robot_theta) = self.current_pose;
+        let inflation_cells = (self.robot_radius / self.grid_resolution).ceil() as i32;
 
-        // Process lidar points using ray tracing
+        // Inflate obstacles by robot radius
         for (i, &range) in lidar_data.ranges.iter().enumerate() {
             if range > 0.1 && range < lidar_data.range_max {
                 let angle = lidar_data.angle_min as f64
@@ -151,17 +156,7 @@ impl PathPlannerNode {
 
                 let obstacle_x = robot_x + range as f64 * angle.cos();
                 let obstacle_y = robot_y + range as f64 * angle.sin();
-
-                // Use occupancy grid's ray tracing
-                self.occupancy_grid.ray_trace(
-                    (robot_x, robot_y),
-                    (obstacle_x, obstacle_y),
-                    true, // Mark free cells along ray
-                );
-
-                // Inflate obstacles by robot radius
                 let (grid_x, grid_y) = self.occupancy_grid.world_to_grid(obstacle_x, obstacle_y);
-                let inflation_cells = (self.robot_radius / self.grid_resolution).ceil() as i32;
 
                 for dy in -inflation_cells..=inflation_cells {
                     for dx in -inflation_cells..=inflation_cells {
@@ -182,18 +177,8 @@ impl PathPlannerNode {
         let (start_x, start_y, _) = self.current_pose;
         let (goal_x, goal_y, _) = self.goal_pose;
 
-        // Convert occupancy grid to A* grid format
-        let (width, height) = self.occupancy_grid.get_dimensions();
-        let mut grid = vec![vec![false; width]; height];
-
-        for y in 0..height {
-            for x in 0..width {
-                grid[y][x] = self.occupancy_grid.is_occupied(x, y);
-            }
-        }
-
-        // Set grid in A* planner
-        self.astar.set_grid(grid);
+        // Occupancy cells share A*'s row-major layout; >= 50% is an obstacle
+        self.astar.load_occupancy(self.occupancy_grid.data(), 50);
 
         // Convert world coordinates to grid coordinates
         let (start_grid_x, start_grid_y) = self.occupancy_grid.world_to_grid(start_x, start_y);
@@ -1,7 +1,11 @@
 // Benchmark for Sensor performance
 // Run with: cargo bench --bench sensor_bench
 
-use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+use bevy::math::{Quat, Vec3};
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use rapier3d::prelude::*;
+use sim3d::physics::world::PhysicsWorld;
+use sim3d::sensors::raycast::{cast_rays_cpu, RayPattern, RayTable};
 
 fn benchmark_gps_update(c: &mut Criterion) {
     c.bench_function("gps_sensor_update", |b| {
@@ -45,20 +49,58 @@ fn benchmark_force_torque_update(c: &mut Criterion) {
     });
 }
 
+/// Room of box colliders around the sensor
+fn lidar_world() -> PhysicsWorld {
+    let mut world = PhysicsWorld::default();
+    for i in 0..24 {
+        let angle = i as f32 * std::f32::consts::TAU / 24.0;
+        let collider = ColliderBuilder::cuboid(0.5, 2.0, 0.5)
+            .translation(vector![8.0 * angle.cos(), 0.0, 8.0 * angle.sin()])
+            .build();
+        world.collider_set.insert(collider);
+    }
+    let floor = ColliderBuilder::cuboid(20.0, 0.1, 20.0)
+        .translation(vector![0.0, -1.0, 0.0])
+        .build();
+    world.collider_set.insert(floor);
+    world.query_pipeline.update(&world.collider_set);
+    world
+}
+
 fn benchmark_lidar_raycast(c: &mut Criterion) {
+    let world = lidar_world();
     let mut group = c.benchmark_group("lidar_ray_count");
+    group.sample_size(10);
 
-    for ray_count in [100, 500, 1000, 5000].iter() {
-        group.bench_with_input(
-            BenchmarkId::from_parameter(ray_count),
-            ray_count,
-            |b, &count| {
+    for (vertical, horizontal) in [(16, 720), (32, 1024), (128, 2048)] {
+        let pattern = RayPattern::Spherical {
+            horizontal,
+            vertical,
+            horizontal_fov: std::f32::consts::TAU,
+            vertical_fov: 0.5,
+        };
+        let mut table = RayTable::default();
+        let directions = table.ensure(pattern).to_vec();
+        let mut ranges = Vec::with_capacity(directions.len());
+        let label = format!("{}x{}", vertical, horizontal);
+        group.throughput(Throughput::Elements(directions.len() as u64));
+
+        for (mode, parallel_min) in [("serial", usize::MAX), ("parallel", 0)] {
+            group.bench_with_input(BenchmarkId::new(mode, &label), &directions, |b, dirs| {
                 b.iter(|| {
-                    // Placeholder: would cast N rays for Lidar
-                    black_box(count * 10)
+                    cast_rays_cpu(
+                        &world,
+                        Vec3::ZERO,
+                        Quat::IDENTITY,
+                        dirs,
+                        20.0,
+                        parallel_min,
+                        &mut ranges,
+                    );
+                    black_box(ranges.len())
                 });
-            },
-        );
+            });
+        }
     }
 
     group.finish();
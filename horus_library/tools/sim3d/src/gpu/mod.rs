@@ -11,7 +11,7 @@ pub mod raycasting;
 
 // Re-export pipeline types
 pub use collision::GPUCollisionPipeline;
-pub use raycasting::GPURaycastPipeline;
+pub use raycasting::{GPURaycastPipeline, GPURaycastScene, PendingRaycast};
 
 // Re-export profiling types
 pub use profiling::{
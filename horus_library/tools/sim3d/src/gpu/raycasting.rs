@@ -2,6 +2,8 @@
 
 use super::GPUComputeContext;
 use bevy::prelude::*;
+use std::sync::atomic::{AtomicU8, Ordering};
+use std::sync::Arc;
 use wgpu::util::DeviceExt;
 
 /// Raycast uniforms matching WGSL layout
@@ -119,39 +121,74 @@ impl GPURaycastPipeline {
         }
     }
 
-    /// Perform batch raycasting on GPU
-    pub fn cast_rays(
+    /// Upload scene triangles for subsequent `submit` calls
+    pub fn upload_scene(
         &self,
         context: &GPUComputeContext,
-        rays: &[(Vec3, Vec3)],   // (origin, direction) pairs
-        triangles: &[[Vec3; 3]], // Triangle vertices
-        max_distance: f32,
-    ) -> Vec<f32> {
-        let num_rays = rays.len();
-        let num_triangles = triangles.len();
-
-        // Flatten ray data
-        let mut ray_origins = Vec::with_capacity(num_rays * 3);
-        let mut ray_directions = Vec::with_capacity(num_rays * 3);
-        for (origin, direction) in rays {
-            ray_origins.extend_from_slice(&[origin.x, origin.y, origin.z]);
-            ray_directions.extend_from_slice(&[direction.x, direction.y, direction.z]);
-        }
-
-        // Flatten triangle data
-        let mut triangle_data = Vec::with_capacity(num_triangles * 9);
+        triangles: &[[Vec3; 3]],
+    ) -> GPURaycastScene {
+        // array<vec3<f32>> has a 16-byte stride in storage buffers
+        let mut triangle_data = Vec::with_capacity(triangles.len().max(1) * 3);
         for tri in triangles {
             for vertex in tri {
-                triangle_data.extend_from_slice(&[vertex.x, vertex.y, vertex.z]);
+                triangle_data.push(vertex.extend(0.0).to_array());
             }
         }
+        if triangle_data.is_empty() {
+            // Zero-sized storage bindings are invalid
+            triangle_data.push([0.0; 4]);
+        }
+
+        let buffer = context
+            .device
+            .create_buffer_init(&wgpu::util::BufferInitDescriptor {
+                label: Some("triangles"),
+                contents: bytemuck::cast_slice(&triangle_data),
+                usage: wgpu::BufferUsages::STORAGE,
+            });
+
+        GPURaycastScene {
+            buffer,
+            num_triangles: triangles.len() as u32,
+        }
+    }
+
+    /// Dispatch a batch of rays without waiting for the result
+    ///
+    /// Rays share `origin`; `directions` are in world space. Poll the
+    /// returned handle on later frames to collect the hit distances.
+    pub fn submit(
+        &self,
+        context: &GPUComputeContext,
+        scene: &GPURaycastScene,
+        origin: Vec3,
+        directions: &[Vec3],
+        max_distance: f32,
+    ) -> PendingRaycast {
+        let origins: Vec<[f32; 4]> = vec![origin.extend(0.0).to_array(); directions.len()];
+        let directions: Vec<[f32; 4]> = directions
+            .iter()
+            .map(|d| d.extend(0.0).to_array())
+            .collect();
+        self.submit_padded(context, scene, &origins, &directions, max_distance)
+    }
+
+    fn submit_padded(
+        &self,
+        context: &GPUComputeContext,
+        scene: &GPURaycastScene,
+        ray_origins: &[[f32; 4]],
+        ray_directions: &[[f32; 4]],
+        max_distance: f32,
+    ) -> PendingRaycast {
+        let num_rays = ray_directions.len();
+        let output_size = (num_rays.max(1) * 4) as u64; // f32 per ray
 
-        // Create GPU buffers
         let origin_buffer = context
             .device
             .create_buffer_init(&wgpu::util::BufferInitDescriptor {
                 label: Some("ray_origins"),
-                contents: bytemuck::cast_slice(&ray_origins),
+                contents: bytemuck::cast_slice(ray_origins),
                 usage: wgpu::BufferUsages::STORAGE,
             });
 
@@ -160,22 +197,13 @@ impl GPURaycastPipeline {
                 .device
                 .create_buffer_init(&wgpu::util::BufferInitDescriptor {
                     label: Some("ray_directions"),
-                    contents: bytemuck::cast_slice(&ray_directions),
-                    usage: wgpu::BufferUsages::STORAGE,
-                });
-
-        let triangle_buffer =
-            context
-                .device
-                .create_buffer_init(&wgpu::util::BufferInitDescriptor {
-                    label: Some("triangles"),
-                    contents: bytemuck::cast_slice(&triangle_data),
+                    contents: bytemuck::cast_slice(ray_directions),
                     usage: wgpu::BufferUsages::STORAGE,
                 });
 
         let output_buffer = context.device.create_buffer(&wgpu::BufferDescriptor {
             label: Some("hit_distances"),
-            size: (num_rays * 4) as u64, // f32 per ray
+            size: output_size,
             usage: wgpu::BufferUsages::STORAGE | wgpu::BufferUsages::COPY_SRC,
             mapped_at_creation: false,
         });
@@ -183,7 +211,7 @@ impl GPURaycastPipeline {
         // Uniforms
         let uniforms = RaycastUniforms {
             num_rays: num_rays as u32,
-            num_triangles: num_triangles as u32,
+            num_triangles: scene.num_triangles,
             max_distance,
             padding: 0.0,
         };
@@ -212,7 +240,7 @@ impl GPURaycastPipeline {
                     },
                     wgpu::BindGroupEntry {
                         binding: 2,
-                        resource: triangle_buffer.as_entire_binding(),
+                        resource: scene.buffer.as_entire_binding(),
                     },
                     wgpu::BindGroupEntry {
                         binding: 3,
@@ -249,35 +277,124 @@ impl GPURaycastPipeline {
         // Read results
         let staging_buffer = context.device.create_buffer(&wgpu::BufferDescriptor {
             label: Some("staging_buffer"),
-            size: (num_rays * 4) as u64,
+            size: output_size,
             usage: wgpu::BufferUsages::MAP_READ | wgpu::BufferUsages::COPY_DST,
             mapped_at_creation: false,
         });
 
-        encoder.copy_buffer_to_buffer(&output_buffer, 0, &staging_buffer, 0, (num_rays * 4) as u64);
+        encoder.copy_buffer_to_buffer(&output_buffer, 0, &staging_buffer, 0, output_size);
 
         context.queue.submit(Some(encoder.finish()));
 
-        // Map and read
-        let buffer_slice = staging_buffer.slice(..);
-        let (sender, receiver) = futures::channel::oneshot::channel();
-        buffer_slice.map_async(wgpu::MapMode::Read, move |result| {
-            sender.send(result).unwrap();
-        });
+        // Map asynchronously; the callback fires from a later device poll
+        let state = Arc::new(AtomicU8::new(MAP_PENDING));
+        let callback_state = state.clone();
+        staging_buffer
+            .slice(..)
+            .map_async(wgpu::MapMode::Read, move |result| {
+                let value = if result.is_ok() {
+                    MAP_READY
+                } else {
+                    MAP_FAILED
+                };
+                callback_state.store(value, Ordering::Release);
+            });
 
-        context.device.poll(wgpu::Maintain::Wait);
-        futures::executor::block_on(receiver).unwrap().unwrap();
+        PendingRaycast {
+            staging_buffer,
+            num_rays,
+            state,
+        }
+    }
 
-        let data = buffer_slice.get_mapped_range();
-        let distances: Vec<f32> = bytemuck::cast_slice(&data).to_vec();
+    /// Perform batch raycasting on GPU, blocking until the result is read back
+    pub fn cast_rays(
+        &self,
+        context: &GPUComputeContext,
+        rays: &[(Vec3, Vec3)],   // (origin, direction) pairs
+        triangles: &[[Vec3; 3]], // Triangle vertices
+        max_distance: f32,
+    ) -> Vec<f32> {
+        let scene = self.upload_scene(context, triangles);
+        let origins: Vec<[f32; 4]> = rays.iter().map(|(o, _)| o.extend(0.0).to_array()).collect();
+        let directions: Vec<[f32; 4]> =
+            rays.iter().map(|(_, d)| d.extend(0.0).to_array()).collect();
 
-        drop(data);
-        staging_buffer.unmap();
+        let pending = self.submit_padded(context, &scene, &origins, &directions, max_distance);
+        context.device.poll(wgpu::Maintain::Wait);
 
+        let mut distances = Vec::with_capacity(rays.len());
+        if !pending.read_into(context, &mut distances) {
+            tracing::warn!("GPU raycast readback failed");
+            distances.clear();
+            distances.resize(rays.len(), max_distance);
+        }
         distances
     }
 }
 
+/// Scene triangles resident on the GPU
+pub struct GPURaycastScene {
+    buffer: wgpu::Buffer,
+    num_triangles: u32,
+}
+
+impl GPURaycastScene {
+    pub fn num_triangles(&self) -> u32 {
+        self.num_triangles
+    }
+}
+
+const MAP_PENDING: u8 = 0;
+const MAP_READY: u8 = 1;
+const MAP_FAILED: u8 = 2;
+
+/// In-flight raycast dispatch awaiting readback
+pub struct PendingRaycast {
+    staging_buffer: wgpu::Buffer,
+    num_rays: usize,
+    state: Arc<AtomicU8>,
+}
+
+impl PendingRaycast {
+    /// Number of rays in the batch
+    pub fn len(&self) -> usize {
+        self.num_rays
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.num_rays == 0
+    }
+
+    /// Poll the device without blocking; true once the result can be read
+    pub fn is_ready(&self, context: &GPUComputeContext) -> bool {
+        if self.state.load(Ordering::Acquire) == MAP_PENDING {
+            context.device.poll(wgpu::Maintain::Poll);
+        }
+        self.state.load(Ordering::Acquire) != MAP_PENDING
+    }
+
+    /// Consume the result, copying the hit distances into `out`
+    ///
+    /// Returns false (leaving `out` untouched) if the mapping failed or the
+    /// result is not ready; check `is_ready` before calling.
+    pub fn read_into(self, context: &GPUComputeContext, out: &mut Vec<f32>) -> bool {
+        if !self.is_ready(context) || self.state.load(Ordering::Acquire) == MAP_FAILED {
+            return false;
+        }
+
+        let slice = self.staging_buffer.slice(..);
+        out.clear();
+        {
+            let data = slice.get_mapped_range();
+            let distances: &[f32] = bytemuck::cast_slice(&data);
+            out.extend_from_slice(&distances[..self.num_rays]);
+        }
+        self.staging_buffer.unmap();
+        true
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
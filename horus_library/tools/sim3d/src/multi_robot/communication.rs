@@ -1,8 +1,23 @@
 //! Inter-robot communication simulation
-
+//!
+//! Payloads are reference counted, so a broadcast shares one allocation
+//! between every receiving queue. With `ChannelConfig::broadcast_range` set,
+//! broadcasts only reach robots within radio range: they are queued on send
+//! and delivered in one batch per frame by `broadcast_delivery_system`, which
+//! answers all range queries against a single spatial grid rebuild.
+
+use super::spatial::SpatialGrid;
 use super::RobotId;
 use bevy::prelude::*;
+use rayon::prelude::*;
 use std::collections::{HashMap, VecDeque};
+use std::sync::Arc;
+
+/// Shared, immutable message payload
+pub type Payload = Arc<[u8]>;
+
+/// Distinct broadcasting robots per batch before range queries run in parallel
+const PARALLEL_MIN_SENDERS: usize = 32;
 
 /// Message between robots
 #[derive(Clone, Debug)]
@@ -12,7 +27,7 @@ pub struct RobotMessage {
     /// Receiver robot ID (None for broadcast)
     pub to: Option<RobotId>,
     /// Message payload
-    pub payload: Vec<u8>,
+    pub payload: Payload,
     /// Message timestamp
     pub timestamp: f64,
     /// Message ID
@@ -20,14 +35,19 @@ pub struct RobotMessage {
 }
 
 impl RobotMessage {
-    pub fn new(from: RobotId, to: Option<RobotId>, payload: Vec<u8>, timestamp: f64) -> Self {
+    pub fn new(
+        from: RobotId,
+        to: Option<RobotId>,
+        payload: impl Into<Payload>,
+        timestamp: f64,
+    ) -> Self {
         static NEXT_ID: std::sync::atomic::AtomicU64 = std::sync::atomic::AtomicU64::new(0);
         let id = NEXT_ID.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
 
         Self {
             from,
             to,
-            payload,
+            payload: payload.into(),
             timestamp,
             id,
         }
@@ -51,6 +71,9 @@ pub struct ChannelConfig {
     pub max_message_size: usize,
     /// Bandwidth limit (bytes per second)
     pub bandwidth_limit: Option<usize>,
+    /// Radio range for broadcasts in meters (None = every robot hears every
+    /// broadcast immediately)
+    pub broadcast_range: Option<f32>,
 }
 
 impl Default for ChannelConfig {
@@ -59,21 +82,36 @@ impl Default for ChannelConfig {
             max_queue_size: 1000,
             max_message_size: 1024 * 1024, // 1MB
             bandwidth_limit: None,
+            broadcast_range: None,
         }
     }
 }
 
+/// Per-robot receive queue and last known position
+struct Mailbox {
+    id: RobotId,
+    queue: VecDeque<Arc<RobotMessage>>,
+    position: Option<Vec3>,
+}
+
 /// Communication manager resource
 #[derive(Resource)]
 pub struct CommunicationManager {
-    /// Message queues per robot
-    queues: HashMap<RobotId, VecDeque<RobotMessage>>,
+    /// Mailboxes, indexed through `index`
+    mailboxes: Vec<Mailbox>,
+    index: HashMap<RobotId, usize>,
+    /// Range-limited broadcasts waiting for `deliver_broadcasts`
+    pending_broadcasts: Vec<Arc<RobotMessage>>,
+    /// Robot positions, rebuilt once per broadcast batch
+    grid: SpatialGrid,
     /// Channel configuration
     config: ChannelConfig,
     /// Sent message count
     sent_count: u64,
     /// Received message count
     received_count: u64,
+    /// Range-limited deliveries dropped because the receiver's queue was full
+    dropped_count: u64,
     /// Total bytes transmitted
     bytes_transmitted: usize,
 }
@@ -87,10 +125,14 @@ impl Default for CommunicationManager {
 impl CommunicationManager {
     pub fn new(config: ChannelConfig) -> Self {
         Self {
-            queues: HashMap::new(),
+            mailboxes: Vec::new(),
+            index: HashMap::new(),
+            pending_broadcasts: Vec::new(),
+            grid: SpatialGrid::new(config.broadcast_range.unwrap_or(1.0)),
             config,
             sent_count: 0,
             received_count: 0,
+            dropped_count: 0,
             bytes_transmitted: 0,
         }
     }
@@ -100,9 +142,11 @@ impl CommunicationManager {
         &mut self,
         from: RobotId,
         to: Option<RobotId>,
-        payload: Vec<u8>,
+        payload: impl Into<Payload>,
         timestamp: f64,
     ) -> Result<(), String> {
+        let payload = payload.into();
+
         // Check message size
         if payload.len() > self.config.max_message_size {
             return Err(format!(
@@ -112,17 +156,21 @@ impl CommunicationManager {
             ));
         }
 
-        let message = RobotMessage::new(from, to.clone(), payload, timestamp);
+        let message = Arc::new(RobotMessage::new(from, to, payload, timestamp));
         let message_size = message.size_bytes();
 
-        if let Some(recipient) = to {
+        if let Some(recipient) = &message.to {
             // Unicast message
-            self.deliver_to_robot(&recipient, message)?;
+            let slot = self.mailbox_slot(recipient.clone());
+            self.deliver_to_slot(slot, message.clone())?;
+        } else if self.config.broadcast_range.is_some() {
+            // Range-limited broadcast - delivered with the next batch
+            self.pending_broadcasts.push(message);
         } else {
             // Broadcast message - deliver to all robots except sender
-            for robot_id in self.queues.keys().cloned().collect::<Vec<_>>() {
-                if robot_id != message.from {
-                    self.deliver_to_robot(&robot_id, message.clone())?;
+            for slot in 0..self.mailboxes.len() {
+                if self.mailboxes[slot].id != message.from {
+                    self.deliver_to_slot(slot, message.clone())?;
                 }
             }
         }
@@ -133,56 +181,179 @@ impl CommunicationManager {
         Ok(())
     }
 
-    /// Deliver message to specific robot
-    fn deliver_to_robot(
-        &mut self,
-        robot_id: &RobotId,
-        message: RobotMessage,
-    ) -> Result<(), String> {
-        let queue = self.queues.entry(robot_id.clone()).or_default();
+    /// Deliver message to the mailbox at `slot`
+    fn deliver_to_slot(&mut self, slot: usize, message: Arc<RobotMessage>) -> Result<(), String> {
+        let mailbox = &mut self.mailboxes[slot];
 
-        if queue.len() >= self.config.max_queue_size {
-            return Err(format!("Message queue full for robot {:?}", robot_id));
+        if mailbox.queue.len() >= self.config.max_queue_size {
+            return Err(format!("Message queue full for robot {:?}", mailbox.id));
         }
 
-        queue.push_back(message);
+        mailbox.queue.push_back(message);
         self.received_count += 1;
 
         Ok(())
     }
 
+    /// Mailbox index for a robot, creating the mailbox if needed
+    fn mailbox_slot(&mut self, robot_id: RobotId) -> usize {
+        if let Some(&slot) = self.index.get(&robot_id) {
+            return slot;
+        }
+        let slot = self.mailboxes.len();
+        self.index.insert(robot_id.clone(), slot);
+        self.mailboxes.push(Mailbox {
+            id: robot_id,
+            queue: VecDeque::new(),
+            position: None,
+        });
+        slot
+    }
+
+    fn mailbox(&self, robot_id: &RobotId) -> Option<&Mailbox> {
+        self.index.get(robot_id).map(|&slot| &self.mailboxes[slot])
+    }
+
+    fn mailbox_mut(&mut self, robot_id: &RobotId) -> Option<&mut Mailbox> {
+        self.index
+            .get(robot_id)
+            .map(|&slot| &mut self.mailboxes[slot])
+    }
+
+    /// Deliver every pending range-limited broadcast
+    ///
+    /// Rebuilds the spatial grid once, runs one range query per distinct
+    /// sender (in parallel for large batches) and shares each message with
+    /// every robot in range. Robots without a known position neither send
+    /// nor receive range-limited broadcasts. Full queues drop the delivery
+    /// and count it in `dropped_count`. Returns the number of deliveries.
+    pub fn deliver_broadcasts(&mut self) -> usize {
+        if self.pending_broadcasts.is_empty() {
+            return 0;
+        }
+        let pending = std::mem::take(&mut self.pending_broadcasts);
+
+        let Some(range) = self.config.broadcast_range else {
+            // Range was lifted after these were queued
+            let mut delivered = 0;
+            for message in pending {
+                for slot in 0..self.mailboxes.len() {
+                    if self.mailboxes[slot].id != message.from
+                        && self.deliver_to_slot(slot, message.clone()).is_ok()
+                    {
+                        delivered += 1;
+                    }
+                }
+            }
+            return delivered;
+        };
+
+        self.grid.set_cell_size(range);
+        self.grid.rebuild(
+            self.mailboxes
+                .iter()
+                .enumerate()
+                .filter_map(|(slot, mailbox)| mailbox.position.map(|p| (slot as u32, p))),
+        );
+
+        let mut senders: Vec<usize> = pending
+            .iter()
+            .filter_map(|message| self.index.get(&message.from).copied())
+            .filter(|&slot| self.mailboxes[slot].position.is_some())
+            .collect();
+        senders.sort_unstable();
+        senders.dedup();
+
+        let (grid, mailboxes) = (&self.grid, &self.mailboxes);
+        let neighbors_of = |&slot: &usize| {
+            let mut neighbors = Vec::new();
+            if let Some(position) = mailboxes[slot].position {
+                grid.query_radius(position, range, &mut neighbors);
+            }
+            neighbors
+        };
+        let neighbors: Vec<Vec<u32>> = if senders.len() >= PARALLEL_MIN_SENDERS {
+            senders.par_iter().map(neighbors_of).collect()
+        } else {
+            senders.iter().map(neighbors_of).collect()
+        };
+
+        let mut delivered = 0;
+        for message in pending {
+            let Some(sender) = self.index.get(&message.from).copied() else {
+                continue;
+            };
+            let Ok(k) = senders.binary_search(&sender) else {
+                continue;
+            };
+            for &slot in &neighbors[k] {
+                let slot = slot as usize;
+                if slot == sender {
+                    continue;
+                }
+                let queue = &mut self.mailboxes[slot].queue;
+                if queue.len() >= self.config.max_queue_size {
+                    self.dropped_count += 1;
+                    continue;
+                }
+                queue.push_back(message.clone());
+                delivered += 1;
+            }
+        }
+        self.received_count += delivered as u64;
+        delivered
+    }
+
+    /// Record a robot's position for range-limited broadcasts
+    pub fn set_position(&mut self, robot_id: &RobotId, position: Vec3) {
+        let slot = self.mailbox_slot(robot_id.clone());
+        self.mailboxes[slot].position = Some(position);
+    }
+
+    /// Number of range-limited broadcasts waiting for delivery
+    pub fn pending_broadcasts(&self) -> usize {
+        self.pending_broadcasts.len()
+    }
+
     /// Receive next message for a robot
-    pub fn receive_message(&mut self, robot_id: &RobotId) -> Option<RobotMessage> {
-        self.queues
-            .get_mut(robot_id)
-            .and_then(|queue| queue.pop_front())
+    pub fn receive_message(&mut self, robot_id: &RobotId) -> Option<Arc<RobotMessage>> {
+        self.mailbox_mut(robot_id)
+            .and_then(|mailbox| mailbox.queue.pop_front())
     }
 
     /// Peek at next message without removing it
     pub fn peek_message(&self, robot_id: &RobotId) -> Option<&RobotMessage> {
-        self.queues.get(robot_id).and_then(|queue| queue.front())
+        self.mailbox(robot_id)
+            .and_then(|mailbox| mailbox.queue.front())
+            .map(|message| &**message)
     }
 
     /// Get number of pending messages for a robot
     pub fn pending_count(&self, robot_id: &RobotId) -> usize {
-        self.queues.get(robot_id).map_or(0, |q| q.len())
+        self.mailbox(robot_id).map_or(0, |m| m.queue.len())
     }
 
     /// Clear all messages for a robot
     pub fn clear_queue(&mut self, robot_id: &RobotId) {
-        if let Some(queue) = self.queues.get_mut(robot_id) {
-            queue.clear();
+        if let Some(mailbox) = self.mailbox_mut(robot_id) {
+            mailbox.queue.clear();
         }
     }
 
     /// Register a robot (creates empty queue)
     pub fn register_robot(&mut self, robot_id: RobotId) {
-        self.queues.entry(robot_id).or_default();
+        self.mailbox_slot(robot_id);
     }
 
     /// Unregister a robot
     pub fn unregister_robot(&mut self, robot_id: &RobotId) {
-        self.queues.remove(robot_id);
+        let Some(slot) = self.index.remove(robot_id) else {
+            return;
+        };
+        self.mailboxes.swap_remove(slot);
+        if let Some(moved) = self.mailboxes.get(slot) {
+            self.index.insert(moved.id.clone(), slot);
+        }
     }
 
     /// Get statistics
@@ -190,8 +361,9 @@ impl CommunicationManager {
         CommunicationStats {
             sent_count: self.sent_count,
             received_count: self.received_count,
+            dropped_count: self.dropped_count,
             bytes_transmitted: self.bytes_transmitted,
-            active_robots: self.queues.len(),
+            active_robots: self.mailboxes.len(),
         }
     }
 }
@@ -201,6 +373,7 @@ impl CommunicationManager {
 pub struct CommunicationStats {
     pub sent_count: u64,
     pub received_count: u64,
+    pub dropped_count: u64,
     pub bytes_transmitted: usize,
     pub active_robots: usize,
 }
@@ -212,6 +385,20 @@ pub struct Communicator {
     pub on_message: Option<fn(&RobotMessage)>,
 }
 
+/// System to deliver range-limited broadcasts once per frame
+pub fn broadcast_delivery_system(
+    mut manager: ResMut<CommunicationManager>,
+    robots: Query<(&super::Robot, &GlobalTransform)>,
+) {
+    if manager.config.broadcast_range.is_none() || manager.pending_broadcasts.is_empty() {
+        return;
+    }
+    for (robot, transform) in robots.iter() {
+        manager.set_position(&robot.id, transform.translation());
+    }
+    manager.deliver_broadcasts();
+}
+
 /// System to process communication
 pub fn communication_system(
     mut manager: ResMut<CommunicationManager>,
@@ -242,7 +429,7 @@ mod tests {
 
         assert_eq!(msg.from.as_str(), "robot1");
         assert_eq!(msg.to.as_ref().unwrap().as_str(), "robot2");
-        assert_eq!(msg.payload, vec![1, 2, 3]);
+        assert_eq!(*msg.payload, [1, 2, 3]);
         assert!(!msg.is_broadcast());
         assert_eq!(msg.size_bytes(), 3);
     }
@@ -274,7 +461,7 @@ mod tests {
         assert_eq!(manager.pending_count(&RobotId::new("robot1")), 0);
 
         let msg = manager.receive_message(&RobotId::new("robot2")).unwrap();
-        assert_eq!(msg.payload, vec![1, 2, 3]);
+        assert_eq!(*msg.payload, [1, 2, 3]);
         assert_eq!(manager.pending_count(&RobotId::new("robot2")), 0);
     }
 
@@ -377,4 +564,75 @@ mod tests {
         assert_eq!(stats.bytes_transmitted, 5);
         assert_eq!(stats.active_robots, 2);
     }
+
+    #[test]
+    fn test_range_limited_broadcast() {
+        let mut manager = CommunicationManager::new(ChannelConfig {
+            broadcast_range: Some(10.0),
+            ..Default::default()
+        });
+
+        // Robots every 6m along x
+        for i in 0..5 {
+            let id = RobotId::new(format!("robot{}", i));
+            manager.set_position(&id, Vec3::new(6.0 * i as f32, 0.0, 0.0));
+        }
+
+        manager
+            .send_message(RobotId::new("robot2"), None, vec![7; 64], 1.0)
+            .unwrap();
+
+        // Queued until the batch runs
+        assert_eq!(manager.pending_count(&RobotId::new("robot1")), 0);
+        assert_eq!(manager.pending_broadcasts(), 1);
+        assert_eq!(manager.deliver_broadcasts(), 2);
+        assert_eq!(manager.pending_broadcasts(), 0);
+
+        for (i, expected) in [0, 1, 0, 1, 0].into_iter().enumerate() {
+            let id = RobotId::new(format!("robot{}", i));
+            assert_eq!(manager.pending_count(&id), expected, "robot{}", i);
+        }
+
+        // Both receivers share one payload allocation
+        let a = manager.receive_message(&RobotId::new("robot1")).unwrap();
+        let b = manager.receive_message(&RobotId::new("robot3")).unwrap();
+        assert!(Arc::ptr_eq(&a.payload, &b.payload));
+        assert_eq!(manager.get_stats().received_count, 2);
+    }
+
+    #[test]
+    fn test_batched_broadcast_matches_brute_force() {
+        let range = 5.0;
+        let mut manager = CommunicationManager::new(ChannelConfig {
+            broadcast_range: Some(range),
+            ..Default::default()
+        });
+
+        let positions: Vec<Vec3> = (0..200)
+            .map(|i| {
+                let f = i as f32;
+                Vec3::new((f * 1.7).sin() * 30.0, (f * 2.3).cos() * 30.0, 0.0)
+            })
+            .collect();
+        for (i, &p) in positions.iter().enumerate() {
+            manager.set_position(&RobotId::new(format!("robot{}", i)), p);
+        }
+
+        // Enough senders to take the parallel path
+        for i in (0..positions.len()).step_by(2) {
+            manager
+                .send_message(RobotId::new(format!("robot{}", i)), None, vec![1], 0.0)
+                .unwrap();
+        }
+        manager.deliver_broadcasts();
+
+        for (i, &p) in positions.iter().enumerate() {
+            let expected = (0..positions.len())
+                .step_by(2)
+                .filter(|&s| s != i && positions[s].distance(p) <= range)
+                .count();
+            let id = RobotId::new(format!("robot{}", i));
+            assert_eq!(manager.pending_count(&id), expected, "robot{}", i);
+        }
+    }
 }
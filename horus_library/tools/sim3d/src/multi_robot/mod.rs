@@ -4,6 +4,7 @@ pub mod communication;
 pub mod coordination;
 pub mod network;
 pub mod registry;
+pub mod spatial;
 pub mod sync;
 
 use bevy::prelude::*;
@@ -184,6 +185,9 @@ impl Plugin for MultiRobotPlugin {
                 (
                     register_robots_system,
                     unregister_robots_system,
+                    communication::broadcast_delivery_system
+                        .after(network::network_simulation_system)
+                        .before(communication::communication_system),
                     communication::communication_system,
                     network::network_simulation_system,
                     coordination::swarm_coordination_system,
@@ -0,0 +1,148 @@
+//! Uniform grid spatial hash over robot positions
+
+use bevy::prelude::*;
+use std::collections::HashMap;
+
+/// Uniform grid for radius queries over a set of indexed points
+///
+/// With the cell size equal to the query radius, a query only visits the
+/// 3x3x3 block of cells around the center, so finding the neighbors of every
+/// robot costs O(N * density) instead of O(N²). Cell vectors are kept across
+/// rebuilds to avoid reallocating every step.
+#[derive(Debug, Clone)]
+pub struct SpatialGrid {
+    cell_size: f32,
+    cells: HashMap<IVec3, Vec<u32>>,
+    /// Position of each inserted item, indexed by item
+    positions: Vec<Vec3>,
+    len: usize,
+}
+
+impl SpatialGrid {
+    pub fn new(cell_size: f32) -> Self {
+        Self {
+            cell_size: cell_size.max(f32::EPSILON),
+            cells: HashMap::new(),
+            positions: Vec::new(),
+            len: 0,
+        }
+    }
+
+    pub fn cell_size(&self) -> f32 {
+        self.cell_size
+    }
+
+    /// Change the cell size; takes effect on the next `rebuild`
+    pub fn set_cell_size(&mut self, cell_size: f32) {
+        self.cell_size = cell_size.max(f32::EPSILON);
+    }
+
+    /// Number of items inserted by the last `rebuild`
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// Replace the contents with `(item, position)` pairs
+    pub fn rebuild(&mut self, items: impl IntoIterator<Item = (u32, Vec3)>) {
+        for cell in self.cells.values_mut() {
+            cell.clear();
+        }
+        self.len = 0;
+
+        for (item, position) in items {
+            let slot = item as usize;
+            if slot >= self.positions.len() {
+                self.positions.resize(slot + 1, Vec3::ZERO);
+            }
+            self.positions[slot] = position;
+            self.cells
+                .entry(self.cell_of(position))
+                .or_default()
+                .push(item);
+            self.len += 1;
+        }
+
+        // Robots that wandered off leave empty cells behind; drop them once
+        // they dominate the map
+        if self.cells.len() > 4 * self.len + 64 {
+            self.cells.retain(|_, items| !items.is_empty());
+        }
+    }
+
+    /// Append every item within `radius` of `center` to `out`
+    pub fn query_radius(&self, center: Vec3, radius: f32, out: &mut Vec<u32>) {
+        let reach = (radius / self.cell_size).ceil() as i32;
+        let origin = self.cell_of(center);
+        let radius_sq = radius * radius;
+        for x in -reach..=reach {
+            for y in -reach..=reach {
+                for z in -reach..=reach {
+                    let Some(items) = self.cells.get(&(origin + IVec3::new(x, y, z))) else {
+                        continue;
+                    };
+                    out.extend(items.iter().copied().filter(|&item| {
+                        self.positions[item as usize].distance_squared(center) <= radius_sq
+                    }));
+                }
+            }
+        }
+    }
+
+    fn cell_of(&self, position: Vec3) -> IVec3 {
+        (position / self.cell_size).floor().as_ivec3()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_query_matches_brute_force() {
+        // Deterministic scatter, including negative coordinates
+        let points: Vec<Vec3> = (0..400)
+            .map(|i| {
+                let f = i as f32;
+                Vec3::new(
+                    (f * 7.31).sin() * 50.0,
+                    (f * 3.17).cos() * 50.0,
+                    (f * 1.93).sin() * 5.0,
+                )
+            })
+            .collect();
+
+        let mut grid = SpatialGrid::new(8.0);
+        grid.rebuild(points.iter().enumerate().map(|(i, &p)| (i as u32, p)));
+        assert_eq!(grid.len(), points.len());
+
+        for radius in [8.0, 3.0, 20.0] {
+            for (i, &center) in points.iter().enumerate().step_by(37) {
+                let mut found = Vec::new();
+                grid.query_radius(center, radius, &mut found);
+                found.sort_unstable();
+
+                let expected: Vec<u32> = (0..points.len() as u32)
+                    .filter(|&j| points[j as usize].distance(center) <= radius)
+                    .collect();
+                assert_eq!(found, expected, "point {} radius {}", i, radius);
+            }
+        }
+    }
+
+    #[test]
+    fn test_rebuild_replaces_contents() {
+        let mut grid = SpatialGrid::new(1.0);
+        grid.rebuild([(0, Vec3::ZERO), (1, Vec3::X * 0.5)]);
+        grid.rebuild([(1, Vec3::X * 100.0)]);
+
+        let mut found = Vec::new();
+        grid.query_radius(Vec3::ZERO, 1.0, &mut found);
+        assert!(found.is_empty());
+        grid.query_radius(Vec3::X * 100.0, 1.0, &mut found);
+        assert_eq!(found, vec![1]);
+    }
+}
@@ -9,6 +9,7 @@
 use crate::gpu::{
     GPUAccelerationConfig, GPUCollisionPipeline, GPUComputeContext, GPUMetrics, GPURaycastPipeline,
 };
+use crate::physics::world::PhysicsWorld;
 use bevy::prelude::*;
 
 /// GPU-accelerated physics adapter (with CPU fallback)
@@ -109,6 +110,17 @@ impl GPUPhysicsAdapter {
         cpu_raycast_fallback(rays, triangles, max_distance)
     }
 
+    /// GPU context and raycast pipeline, if raycasting on the GPU is available
+    pub fn raycaster(&self) -> Option<(&GPUComputeContext, &GPURaycastPipeline)> {
+        if self.initialization_failed {
+            return None;
+        }
+        match (&self.context, &self.raycast_pipeline) {
+            (Some(context), Some(pipeline)) => Some((context, pipeline)),
+            _ => None,
+        }
+    }
+
     /// Get GPU info string for debugging
     pub fn get_info(&self) -> String {
         if let Some(ref context) = self.context {
@@ -124,6 +136,43 @@ impl GPUPhysicsAdapter {
     }
 }
 
+/// Triangulate every collider in world space for GPU raycasting
+///
+/// Curved primitives are tessellated coarsely; shapes without a
+/// triangulation (e.g. compounds, half-spaces) are skipped.
+pub fn collect_collider_triangles(world: &PhysicsWorld, out: &mut Vec<[Vec3; 3]>) {
+    out.clear();
+    for (_, collider) in world.collider_set.iter() {
+        let shape = collider.shape();
+        let (vertices, indices) = if let Some(mesh) = shape.as_trimesh() {
+            (mesh.vertices().to_vec(), mesh.indices().to_vec())
+        } else if let Some(cuboid) = shape.as_cuboid() {
+            cuboid.to_trimesh()
+        } else if let Some(ball) = shape.as_ball() {
+            ball.to_trimesh(12, 6)
+        } else if let Some(cylinder) = shape.as_cylinder() {
+            cylinder.to_trimesh(12)
+        } else if let Some(capsule) = shape.as_capsule() {
+            capsule.to_trimesh(12, 6)
+        } else if let Some(heightfield) = shape.as_heightfield() {
+            heightfield.to_trimesh()
+        } else {
+            continue;
+        };
+
+        let pose = collider.position();
+        let world_vertex = |i: u32| {
+            let p = pose * vertices[i as usize];
+            Vec3::new(p.x, p.y, p.z)
+        };
+        out.extend(
+            indices
+                .iter()
+                .map(|&[a, b, c]| [world_vertex(a), world_vertex(b), world_vertex(c)]),
+        );
+    }
+}
+
 /// CPU fallback for raycasting
 fn cpu_raycast_fallback(
     rays: &[(Vec3, Vec3)],
@@ -9,12 +9,39 @@ use pyo3::prelude::*;
 use pyo3::types::{PyDict, PyList};
 
 #[cfg(feature = "python")]
-use numpy::{PyArray1, PyArray2, PyArrayMethods, ToPyArray};
+use numpy::{PyArray1, PyArray2, PyArrayMethods, PyUntypedArrayMethods, ToPyArray};
+
+#[cfg(feature = "python")]
+use rayon::prelude::*;
 
 use bevy::prelude::*;
-use std::sync::{Arc, Mutex};
+use std::sync::{mpsc, Arc, Mutex};
 
-use super::{tasks::*, Action, Observation, RLTask, RLTaskManager, StepResult};
+use super::{tasks::*, Action, EpisodeInfo, Observation, RLTask, RLTaskManager, StepResult};
+
+/// Create a task manager running the named task
+#[cfg(feature = "python")]
+fn build_task_manager(
+    task_type: &str,
+    obs_dim: usize,
+    action_dim: usize,
+) -> PyResult<RLTaskManager> {
+    let task: Box<dyn RLTask> = match task_type {
+        "reaching" => Box::new(ReachingTask::new(obs_dim, action_dim)),
+        "balancing" => Box::new(BalancingTask::new(obs_dim, action_dim)),
+        "locomotion" => Box::new(LocomotionTask::new(obs_dim, action_dim)),
+        "navigation" => Box::new(NavigationTask::new(obs_dim, action_dim)),
+        "manipulation" => Box::new(ManipulationTask::new(obs_dim, action_dim)),
+        "push" => Box::new(PushTask::new(obs_dim, action_dim)),
+        _ => return Err(pyo3::exceptions::PyValueError::new_err(
+            format!("Unknown task type: {}. Available: reaching, balancing, locomotion, navigation, manipulation, push", task_type)
+        )),
+    };
+
+    let mut task_manager = RLTaskManager::new();
+    task_manager.set_task(task);
+    Ok(task_manager)
+}
 
 /// Python-exposed RL environment (Gymnasium compatible)
 #[cfg(feature = "python")]
@@ -32,23 +59,8 @@ pub struct PySim3DEnv {
 impl PySim3DEnv {
     #[new]
     fn new(task_type: &str, obs_dim: usize, action_dim: usize) -> PyResult<Self> {
-        let mut world = World::new();
-
-        // Create task based on type
-        let task: Box<dyn RLTask> = match task_type {
-            "reaching" => Box::new(ReachingTask::new(obs_dim, action_dim)),
-            "balancing" => Box::new(BalancingTask::new(obs_dim, action_dim)),
-            "locomotion" => Box::new(LocomotionTask::new(obs_dim, action_dim)),
-            "navigation" => Box::new(NavigationTask::new(obs_dim, action_dim)),
-            "manipulation" => Box::new(ManipulationTask::new(obs_dim, action_dim)),
-            "push" => Box::new(PushTask::new(obs_dim, action_dim)),
-            _ => return Err(pyo3::exceptions::PyValueError::new_err(
-                format!("Unknown task type: {}. Available: reaching, balancing, locomotion, navigation, manipulation, push", task_type)
-            )),
-        };
-
-        let mut task_manager = RLTaskManager::new();
-        task_manager.set_task(task);
+        let world = World::new();
+        let task_manager = build_task_manager(task_type, obs_dim, action_dim)?;
 
         Ok(Self {
             task_manager: Arc::new(Mutex::new(task_manager)),
@@ -160,101 +172,440 @@ impl PySim3DEnv {
     }
 }
 
-/// Vectorized environment for parallel RL training
+/// One environment stepped by the vectorized env's worker pool
 #[cfg(feature = "python")]
-#[pyclass(name = "VecSim3DEnv")]
-pub struct PyVecSim3DEnv {
-    envs: Vec<PySim3DEnv>,
-    num_envs: usize,
+struct VecEnvSlot {
+    task_manager: RLTaskManager,
+    world: World,
+    /// Reused action so stepping does not allocate
+    action: Action,
+    /// Final observation when the env auto-reset during the last step
+    terminal_obs: Vec<f32>,
+    reward: f32,
+    terminated: bool,
+    truncated: bool,
+    info: EpisodeInfo,
 }
 
+/// Rust-side state of a vectorized env
+///
+/// Everything the workers touch lives here so the whole core can be moved to
+/// the rayon pool (and stepped with the GIL released) while Python runs policy
+/// inference. Results land in flat staging buffers and are published into the
+/// persistent NumPy arrays by `step_wait`.
 #[cfg(feature = "python")]
-#[pymethods]
-impl PyVecSim3DEnv {
-    #[new]
+struct VecEnvCore {
+    envs: Vec<VecEnvSlot>,
+    obs_dim: usize,
+    action_dim: usize,
+    /// Row-major (num_envs, action_dim) actions for the next step
+    actions: Vec<f32>,
+    /// Row-major (num_envs, obs_dim) observations
+    obs: Vec<f32>,
+}
+
+#[cfg(feature = "python")]
+impl VecEnvCore {
     fn new(task_type: &str, obs_dim: usize, action_dim: usize, num_envs: usize) -> PyResult<Self> {
         let mut envs = Vec::with_capacity(num_envs);
         for _ in 0..num_envs {
-            envs.push(PySim3DEnv::new(task_type, obs_dim, action_dim)?);
+            envs.push(VecEnvSlot {
+                task_manager: build_task_manager(task_type, obs_dim, action_dim)?,
+                world: World::new(),
+                action: Action::Continuous(vec![0.0; action_dim]),
+                terminal_obs: vec![0.0; obs_dim],
+                reward: 0.0,
+                terminated: false,
+                truncated: false,
+                info: EpisodeInfo::default(),
+            });
         }
 
-        Ok(Self { envs, num_envs })
+        Ok(Self {
+            envs,
+            obs_dim,
+            action_dim,
+            actions: vec![0.0; num_envs * action_dim],
+            obs: vec![0.0; num_envs * obs_dim],
+        })
     }
 
-    /// Reset all environments
-    fn reset(&mut self, py: Python) -> PyResult<Py<PyArray2<f32>>> {
-        let mut observations = Vec::new();
+    /// Reset every env in parallel, writing the first observations
+    fn reset_all(&mut self) -> Result<(), &'static str> {
+        self.envs
+            .par_iter_mut()
+            .zip(self.obs.par_chunks_mut(self.obs_dim))
+            .try_for_each(|(env, obs_row)| {
+                let obs = env
+                    .task_manager
+                    .reset(&mut env.world)
+                    .ok_or("Failed to reset environment")?;
+                write_row(obs_row, &obs.data);
+                Ok(())
+            })
+    }
+
+    /// Step every env in parallel with the staged actions
+    ///
+    /// Finished envs are reset immediately (as SB3 vector envs do): their row
+    /// in `obs` holds the first observation of the next episode and the
+    /// final observation is kept in `terminal_obs`.
+    fn step_all(&mut self) -> Result<(), &'static str> {
+        self.envs
+            .par_iter_mut()
+            .zip(self.obs.par_chunks_mut(self.obs_dim))
+            .zip(self.actions.par_chunks(self.action_dim))
+            .try_for_each(|((env, obs_row), action_row)| {
+                if let Action::Continuous(action) = &mut env.action {
+                    action.clear();
+                    action.extend_from_slice(action_row);
+                }
+
+                let result = env
+                    .task_manager
+                    .step(&mut env.world, &env.action)
+                    .ok_or("Failed to step environment")?;
+
+                env.reward = result.reward;
+                env.terminated = result.done;
+                env.truncated = result.truncated;
+                env.info = result.info;
+
+                if result.done || result.truncated {
+                    write_row(&mut env.terminal_obs, &result.observation.data);
+                    let obs = env
+                        .task_manager
+                        .reset(&mut env.world)
+                        .ok_or("Failed to reset environment")?;
+                    write_row(obs_row, &obs.data);
+                } else {
+                    write_row(obs_row, &result.observation.data);
+                }
+                Ok(())
+            })
+    }
+}
 
-        for env in &mut self.envs {
-            let obs = env.reset(py)?;
-            let obs_data: Vec<f32> = obs.bind(py).to_vec()?;
-            observations.extend(obs_data);
+/// Copy an observation into its fixed-width row, zero-padding short ones
+#[cfg(feature = "python")]
+fn write_row(row: &mut [f32], data: &[f32]) {
+    let n = row.len().min(data.len());
+    row[..n].copy_from_slice(&data[..n]);
+    row[n..].fill(0.0);
+}
+
+/// Copy a (num_envs, action_dim) NumPy array into the staging buffer
+#[cfg(feature = "python")]
+fn copy_action_array<T: numpy::Element + Copy>(
+    array: &Bound<'_, PyArray2<T>>,
+    dst: &mut [f32],
+    convert: impl Fn(T) -> f32,
+) -> PyResult<()> {
+    let array = array
+        .try_readonly()
+        .map_err(|e| pyo3::exceptions::PyRuntimeError::new_err(e.to_string()))?;
+    match array.as_slice() {
+        Ok(src) => {
+            for (d, s) in dst.iter_mut().zip(src) {
+                *d = convert(*s);
+            }
         }
+        // Strided views are walked in logical order
+        Err(_) => {
+            for (d, s) in dst.iter_mut().zip(array.as_array().iter()) {
+                *d = convert(*s);
+            }
+        }
+    }
+    Ok(())
+}
 
-        // Reshape to (num_envs, obs_dim)
-        let obs_array = PyArray2::from_vec2_bound(
-            py,
-            &observations
-                .chunks(self.envs[0].obs_dim)
-                .map(|chunk| chunk.to_vec())
-                .collect::<Vec<_>>(),
-        )?;
+/// Result of a step running on the worker pool
+#[cfg(feature = "python")]
+type PendingStep = mpsc::Receiver<(Box<VecEnvCore>, Result<(), &'static str>)>;
+
+/// Vectorized environment for parallel RL training
+///
+/// Envs are stepped on the rayon pool with the GIL released. Observations,
+/// rewards and termination flags are written into persistent NumPy arrays
+/// that are returned zero-copy on every step, so callers that need to keep
+/// a step's results must `.copy()` them before the next step.
+///
+/// `step_async` / `step_wait` split a step like SB3's `SubprocVecEnv`, so
+/// policy inference on the previous observations can overlap with physics.
+#[cfg(feature = "python")]
+#[pyclass(name = "VecSim3DEnv")]
+pub struct PyVecSim3DEnv {
+    /// `None` while a step is in flight on the worker pool
+    core: Option<Box<VecEnvCore>>,
+    pending: Option<PendingStep>,
+    num_envs: usize,
+    action_dim: usize,
+    observations: Py<PyArray2<f32>>,
+    rewards: Py<PyArray1<f32>>,
+    terminated: Py<PyArray1<bool>>,
+    truncated: Py<PyArray1<bool>>,
+}
 
-        Ok(obs_array.unbind())
+#[cfg(feature = "python")]
+impl PyVecSim3DEnv {
+    fn core_mut(&mut self) -> PyResult<&mut VecEnvCore> {
+        if self.pending.is_some() {
+            return Err(pyo3::exceptions::PyRuntimeError::new_err(
+                "A step is in flight; call step_wait() first",
+            ));
+        }
+        self.core.as_deref_mut().ok_or_else(|| {
+            pyo3::exceptions::PyRuntimeError::new_err("Environment worker panicked during a step")
+        })
     }
 
-    /// Step all environments with vectorized actions
-    fn step(
-        &mut self,
-        py: Python,
-        actions: Vec<Vec<f32>>,
-    ) -> PyResult<(
-        Py<PyArray2<f32>>,
-        Vec<f32>,
-        Vec<bool>,
-        Vec<bool>,
-        Vec<Py<PyDict>>,
-    )> {
-        if actions.len() != self.num_envs {
+    /// Validate and stage actions from a NumPy array or nested sequence
+    fn load_actions(&mut self, actions: &Bound<'_, PyAny>) -> PyResult<()> {
+        let (num_envs, action_dim) = (self.num_envs, self.action_dim);
+        let shape_error = |shape: &[usize]| {
+            pyo3::exceptions::PyValueError::new_err(format!(
+                "Expected actions of shape ({}, {}), got {:?}",
+                num_envs, action_dim, shape
+            ))
+        };
+        let core = self.core_mut()?;
+
+        if let Ok(array) = actions.downcast::<PyArray2<f32>>() {
+            if array.shape() != [num_envs, action_dim] {
+                return Err(shape_error(array.shape()));
+            }
+            return copy_action_array(array, &mut core.actions, |v| v);
+        }
+        if let Ok(array) = actions.downcast::<PyArray2<f64>>() {
+            if array.shape() != [num_envs, action_dim] {
+                return Err(shape_error(array.shape()));
+            }
+            return copy_action_array(array, &mut core.actions, |v| v as f32);
+        }
+
+        let rows: Vec<Vec<f32>> = actions.extract()?;
+        if rows.len() != num_envs {
             return Err(pyo3::exceptions::PyValueError::new_err(format!(
                 "Expected {} actions, got {}",
-                self.num_envs,
-                actions.len()
+                num_envs,
+                rows.len()
             )));
         }
+        for (dst, row) in core.actions.chunks_mut(action_dim).zip(&rows) {
+            if row.len() != action_dim {
+                return Err(shape_error(&[rows.len(), row.len()]));
+            }
+            dst.copy_from_slice(row);
+        }
+        Ok(())
+    }
+
+    /// Copy the core's results into the persistent NumPy buffers
+    fn publish(&self, py: Python) -> PyResult<()> {
+        let core = self.core.as_deref().expect("core present after step");
+        let borrow_error =
+            |e: numpy::BorrowError| pyo3::exceptions::PyRuntimeError::new_err(e.to_string());
+
+        let mut obs = self
+            .observations
+            .bind(py)
+            .try_readwrite()
+            .map_err(borrow_error)?;
+        obs.as_slice_mut()?.copy_from_slice(&core.obs);
+
+        let mut rewards = self
+            .rewards
+            .bind(py)
+            .try_readwrite()
+            .map_err(borrow_error)?;
+        let mut terminated = self
+            .terminated
+            .bind(py)
+            .try_readwrite()
+            .map_err(borrow_error)?;
+        let mut truncated = self
+            .truncated
+            .bind(py)
+            .try_readwrite()
+            .map_err(borrow_error)?;
+        let (rewards, terminated, truncated) = (
+            rewards.as_slice_mut()?,
+            terminated.as_slice_mut()?,
+            truncated.as_slice_mut()?,
+        );
+        for (i, env) in core.envs.iter().enumerate() {
+            rewards[i] = env.reward;
+            terminated[i] = env.terminated;
+            truncated[i] = env.truncated;
+        }
+        Ok(())
+    }
+
+    /// Publish a finished step and build the `(obs, rewards, terminated, truncated, infos)` tuple
+    fn step_outputs(&self, py: Python) -> PyResult<VecStepOutput> {
+        self.publish(py)?;
 
-        let mut observations = Vec::new();
-        let mut rewards = Vec::new();
-        let mut dones = Vec::new();
-        let mut truncateds = Vec::new();
-        let mut infos = Vec::new();
-
-        for (env, action) in self.envs.iter_mut().zip(actions.iter()) {
-            let (obs, reward, done, truncated, info) = env.step(py, action.clone())?;
-
-            let obs_data: Vec<f32> = obs.bind(py).to_vec()?;
-            observations.extend(obs_data);
-            rewards.push(reward);
-            dones.push(done);
-            truncateds.push(truncated);
-            infos.push(info);
-
-            // Auto-reset if episode is done
-            if done || truncated {
-                let _ = env.reset(py)?;
+        let core = self.core.as_deref().expect("core present after step");
+        let infos = PyList::empty_bound(py);
+        for env in &core.envs {
+            let info = PyDict::new_bound(py);
+            info.set_item("total_reward", env.info.total_reward)?;
+            info.set_item("steps", env.info.steps)?;
+            info.set_item("success", env.info.success)?;
+            info.set_item(
+                "termination_reason",
+                format!("{:?}", env.info.termination_reason),
+            )?;
+            if env.terminated || env.truncated {
+                info.set_item(
+                    "terminal_observation",
+                    env.terminal_obs.to_pyarray_bound(py),
+                )?;
             }
+            infos.append(info)?;
+        }
+
+        Ok((
+            self.observations.clone_ref(py),
+            self.rewards.clone_ref(py),
+            self.terminated.clone_ref(py),
+            self.truncated.clone_ref(py),
+            infos.unbind(),
+        ))
+    }
+
+    /// Block (without the GIL) until the in-flight step finishes
+    fn join_pending(&mut self, py: Python) -> PyResult<bool> {
+        let Some(pending) = self.pending.take() else {
+            return Ok(false);
+        };
+        let (core, result) = py.allow_threads(|| pending.recv()).map_err(|_| {
+            pyo3::exceptions::PyRuntimeError::new_err("Environment worker panicked during a step")
+        })?;
+        self.core = Some(core);
+        result.map_err(pyo3::exceptions::PyRuntimeError::new_err)?;
+        Ok(true)
+    }
+}
+
+#[cfg(feature = "python")]
+type VecStepOutput = (
+    Py<PyArray2<f32>>,
+    Py<PyArray1<f32>>,
+    Py<PyArray1<bool>>,
+    Py<PyArray1<bool>>,
+    Py<PyList>,
+);
+
+#[cfg(feature = "python")]
+#[pymethods]
+impl PyVecSim3DEnv {
+    #[new]
+    fn new(
+        py: Python,
+        task_type: &str,
+        obs_dim: usize,
+        action_dim: usize,
+        num_envs: usize,
+    ) -> PyResult<Self> {
+        if num_envs == 0 {
+            return Err(pyo3::exceptions::PyValueError::new_err(
+                "num_envs must be at least 1",
+            ));
+        }
+        let core = VecEnvCore::new(task_type, obs_dim, action_dim, num_envs)?;
+
+        Ok(Self {
+            core: Some(Box::new(core)),
+            pending: None,
+            num_envs,
+            action_dim,
+            observations: PyArray2::zeros_bound(py, [num_envs, obs_dim], false).unbind(),
+            rewards: PyArray1::zeros_bound(py, num_envs, false).unbind(),
+            terminated: PyArray1::zeros_bound(py, num_envs, false).unbind(),
+            truncated: PyArray1::zeros_bound(py, num_envs, false).unbind(),
+        })
+    }
+
+    /// Reset all environments
+    ///
+    /// Returns the persistent (num_envs, obs_dim) observation buffer.
+    fn reset(&mut self, py: Python) -> PyResult<Py<PyArray2<f32>>> {
+        // A dangling step_async is finished and its results dropped
+        self.join_pending(py)?;
+        let core = self.core_mut()?;
+        py.allow_threads(|| core.reset_all())
+            .map_err(pyo3::exceptions::PyRuntimeError::new_err)?;
+
+        self.publish(py)?;
+        Ok(self.observations.clone_ref(py))
+    }
+
+    /// Step all environments with vectorized actions
+    ///
+    /// `actions` may be a (num_envs, action_dim) float32/float64 array or a
+    /// nested sequence. The returned arrays are the env's persistent buffers.
+    fn step(&mut self, py: Python, actions: &Bound<'_, PyAny>) -> PyResult<VecStepOutput> {
+        self.load_actions(actions)?;
+        let core = self.core_mut()?;
+        py.allow_threads(|| core.step_all())
+            .map_err(pyo3::exceptions::PyRuntimeError::new_err)?;
+
+        self.step_outputs(py)
+    }
+
+    /// Start stepping all environments in the background
+    ///
+    /// Returns immediately; collect the results with `step_wait()`.
+    fn step_async(&mut self, actions: &Bound<'_, PyAny>) -> PyResult<()> {
+        self.load_actions(actions)?;
+        let mut core = self
+            .core
+            .take()
+            .expect("core present without a pending step");
+
+        let (tx, rx) = mpsc::sync_channel(1);
+        rayon::spawn(move || {
+            let result = core.step_all();
+            let _ = tx.send((core, result));
+        });
+        self.pending = Some(rx);
+        Ok(())
+    }
+
+    /// Wait for the step started by `step_async()` and return its results
+    fn step_wait(&mut self, py: Python) -> PyResult<VecStepOutput> {
+        if !self.join_pending(py)? {
+            return Err(pyo3::exceptions::PyRuntimeError::new_err(
+                "step_wait() called without a pending step_async()",
+            ));
         }
+        self.step_outputs(py)
+    }
+
+    /// Persistent (num_envs, obs_dim) observation buffer
+    #[getter]
+    fn observations(&self, py: Python) -> Py<PyArray2<f32>> {
+        self.observations.clone_ref(py)
+    }
+
+    /// Persistent per-env reward buffer from the last step
+    #[getter]
+    fn rewards(&self, py: Python) -> Py<PyArray1<f32>> {
+        self.rewards.clone_ref(py)
+    }
 
-        // Reshape observations to (num_envs, obs_dim)
-        let obs_array = PyArray2::from_vec2_bound(
-            py,
-            &observations
-                .chunks(self.envs[0].obs_dim)
-                .map(|chunk| chunk.to_vec())
-                .collect::<Vec<_>>(),
-        )?;
+    /// Persistent per-env termination flags from the last step
+    #[getter]
+    fn terminated(&self, py: Python) -> Py<PyArray1<bool>> {
+        self.terminated.clone_ref(py)
+    }
 
-        Ok((obs_array.unbind(), rewards, dones, truncateds, infos))
+    /// Persistent per-env truncation flags from the last step
+    #[getter]
+    fn truncated(&self, py: Python) -> Py<PyArray1<bool>> {
+        self.truncated.clone_ref(py)
     }
 
     /// Get number of environments
@@ -264,10 +615,8 @@ impl PyVecSim3DEnv {
     }
 
     /// Close all environments
-    fn close(&mut self) -> PyResult<()> {
-        for env in &mut self.envs {
-            env.close()?;
-        }
+    fn close(&mut self, py: Python) -> PyResult<()> {
+        self.join_pending(py)?;
         Ok(())
     }
 }
@@ -302,6 +651,7 @@ pub fn make_env(
 #[cfg(feature = "python")]
 #[pyfunction]
 pub fn make_vec_env(
+    py: Python,
     task_type: &str,
     num_envs: usize,
     obs_dim: Option<usize>,
@@ -318,6 +668,7 @@ pub fn make_vec_env(
     };
 
     PyVecSim3DEnv::new(
+        py,
         task_type,
         obs_dim.unwrap_or(default_obs),
         action_dim.unwrap_or(default_act),
@@ -349,4 +700,32 @@ mod tests {
         assert_eq!(manipulation_dims, (25, 4));
         assert_eq!(push_dims, (30, 2));
     }
+
+    #[test]
+    fn test_vec_core_parallel_step() {
+        let mut core = VecEnvCore::new("reaching", 10, 6, 4).unwrap();
+        core.reset_all().unwrap();
+
+        core.actions.fill(0.5);
+        for _ in 0..3 {
+            core.step_all().unwrap();
+        }
+
+        assert_eq!(core.obs.len(), 4 * 10);
+        assert!(core.obs.iter().all(|v| v.is_finite()));
+        for env in &core.envs {
+            assert_eq!(env.task_manager.total_steps, 3);
+            assert!(matches!(&env.action, Action::Continuous(a) if a == &vec![0.5; 6]));
+        }
+    }
+
+    #[test]
+    fn test_write_row_pads_and_truncates() {
+        let mut row = [9.0; 4];
+        write_row(&mut row, &[1.0, 2.0]);
+        assert_eq!(row, [1.0, 2.0, 0.0, 0.0]);
+
+        write_row(&mut row, &[1.0, 2.0, 3.0, 4.0, 5.0]);
+        assert_eq!(row, [1.0, 2.0, 3.0, 4.0]);
+    }
 }
@@ -2,6 +2,9 @@ use bevy::prelude::*;
 use rand::thread_rng;
 
 use crate::sensors::noise::{GaussianNoise, NoiseModel};
+use crate::sensors::raycast::{
+    GpuSensorRaycaster, RayPattern, RayTable, SensorRaycastConfig, SensorRays,
+};
 
 /// Depth camera sensor component
 #[derive(Component, Clone)]
@@ -26,6 +29,10 @@ pub struct DepthCamera {
     pub depth_image: Vec<f32>,
     /// Noise model for depth measurements
     pub noise_std_dev: f32,
+    /// Per-pixel ray directions, rebuilt when resolution or FOV change
+    rays: RayTable,
+    /// Range scratch reused across frames
+    ranges: Vec<f32>,
 }
 
 impl DepthCamera {
@@ -42,6 +49,17 @@ impl DepthCamera {
             time_since_update: 0.0,
             depth_image: vec![0.0; (width * height) as usize],
             noise_std_dev: 0.01, // 1cm standard deviation
+            rays: RayTable::default(),
+            ranges: Vec::new(),
+        }
+    }
+
+    pub fn ray_pattern(&self) -> RayPattern {
+        RayPattern::Pinhole {
+            width: self.width,
+            height: self.height,
+            fov_horizontal: self.fov_horizontal,
+            fov_vertical: self.fov_vertical,
         }
     }
 
@@ -155,17 +173,53 @@ impl DepthCamera {
 }
 
 /// System to update depth cameras
+///
+/// Depth is the range along each pixel's ray, cast in one batch per frame.
 pub fn depth_camera_update_system(
-    mut cameras: Query<(&mut DepthCamera, &Transform)>,
+    mut rays: SensorRays,
+    mut cameras: Query<(Entity, &mut DepthCamera, &GlobalTransform)>,
     time: Res<Time>,
 ) {
     let delta_time = time.delta_secs();
+    let now = time.elapsed_secs();
 
-    for (mut camera, _transform) in cameras.iter_mut() {
+    for (entity, mut camera, transform) in cameras.iter_mut() {
         camera.time_since_update += delta_time;
 
-        if camera.should_update(delta_time) {
+        let due = camera.should_update(delta_time);
+        if due {
             camera.time_since_update = 0.0;
+        } else if !rays.in_flight(entity) {
+            continue;
+        }
+
+        let (_, rotation, position) = transform.to_scale_rotation_translation();
+        let camera = &mut *camera;
+        let pattern = camera.ray_pattern();
+        let directions = camera.rays.ensure(pattern);
+        if rays
+            .cast(
+                entity,
+                due,
+                position,
+                rotation,
+                directions,
+                camera.max_range,
+                now,
+                &mut camera.ranges,
+            )
+            .is_some()
+        {
+            let (min_range, max_range) = (camera.min_range, camera.max_range);
+            camera.depth_image.resize(camera.ranges.len(), max_range);
+            for (depth, &range) in camera.depth_image.iter_mut().zip(&camera.ranges) {
+                *depth = if (min_range..=max_range).contains(&range) {
+                    range
+                } else {
+                    max_range
+                };
+            }
+
             // Apply noise after depth measurements are taken
             camera.apply_noise();
         }
@@ -177,7 +231,9 @@ pub struct DepthCameraPlugin;
 
 impl Plugin for DepthCameraPlugin {
     fn build(&self, app: &mut App) {
-        app.add_systems(Update, depth_camera_update_system);
+        app.init_resource::<SensorRaycastConfig>()
+            .init_resource::<GpuSensorRaycaster>()
+            .add_systems(Update, depth_camera_update_system);
     }
 }
 
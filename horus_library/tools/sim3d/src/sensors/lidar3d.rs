@@ -1,9 +1,8 @@
 use bevy::prelude::*;
 use rand::Rng;
-use rapier3d::prelude::*;
 use std::f32::consts::PI;
 
-use crate::physics::world::PhysicsWorld;
+use crate::sensors::raycast::{RayHits, RayPattern, RayTable, SensorRays};
 
 #[derive(Component)]
 pub struct Lidar3D {
@@ -16,6 +15,10 @@ pub struct Lidar3D {
     pub rate_hz: f32,
     pub noise_std: f32,
     pub last_update: f32,
+    /// Beam directions, rebuilt when the ray counts or FOV change
+    rays: RayTable,
+    /// Per-beam range scratch reused across scans
+    ranges: Vec<f32>,
 }
 
 impl Default for Lidar3D {
@@ -30,6 +33,8 @@ impl Default for Lidar3D {
             rate_hz: 10.0,
             noise_std: 0.01,
             last_update: 0.0,
+            rays: RayTable::default(),
+            ranges: Vec::new(),
         }
     }
 }
@@ -72,6 +77,15 @@ impl Lidar3D {
     pub fn should_update(&self, current_time: f32) -> bool {
         current_time - self.last_update >= self.update_time()
     }
+
+    pub fn ray_pattern(&self) -> RayPattern {
+        RayPattern::Spherical {
+            horizontal: self.horizontal_rays,
+            vertical: self.vertical_rays,
+            horizontal_fov: self.horizontal_fov,
+            vertical_fov: self.vertical_fov,
+        }
+    }
 }
 
 #[derive(Component, Clone)]
@@ -125,118 +139,77 @@ impl Default for PointCloud {
 
 pub fn lidar3d_update_system(
     time: Res<Time>,
-    mut physics_world: ResMut<PhysicsWorld>,
-    mut query: Query<(&mut Lidar3D, &mut PointCloud, &GlobalTransform)>,
+    mut rays: SensorRays,
+    mut query: Query<(Entity, &mut Lidar3D, &mut PointCloud, &GlobalTransform)>,
 ) {
     let current_time = time.elapsed_secs();
 
-    for (mut lidar, mut point_cloud, transform) in query.iter_mut() {
-        if !lidar.should_update(current_time) {
+    for (entity, mut lidar, mut point_cloud, transform) in query.iter_mut() {
+        let due = lidar.should_update(current_time);
+        if !due && !rays.in_flight(entity) {
             continue;
         }
-
-        lidar.last_update = current_time;
-
-        // Clear previous point cloud
-        point_cloud.clear();
-        point_cloud.timestamp = current_time;
+        if due {
+            lidar.last_update = current_time;
+        }
 
         // Get sensor pose
-        let sensor_pos = transform.translation();
-        let sensor_rot = transform.to_scale_rotation_translation().1;
+        let (_, sensor_rot, sensor_pos) = transform.to_scale_rotation_translation();
 
         // Perform ray casting
-        cast_lidar_rays(
-            &lidar,
+        let lidar = &mut *lidar;
+        let pattern = lidar.ray_pattern();
+        let directions = lidar.rays.ensure(pattern);
+        if let Some(hits) = rays.cast(
+            entity,
+            due,
             sensor_pos,
             sensor_rot,
-            &mut point_cloud,
-            &mut physics_world,
-        );
+            directions,
+            lidar.max_range,
+            current_time,
+            &mut lidar.ranges,
+        ) {
+            fill_point_cloud(lidar, &hits, &mut point_cloud);
+        }
     }
 }
 
-fn cast_lidar_rays(
-    lidar: &Lidar3D,
-    position: Vec3,
-    rotation: Quat,
-    point_cloud: &mut PointCloud,
-    physics_world: &mut PhysicsWorld,
-) {
+/// Convert a completed scan's ranges into the reused point cloud buffers
+fn fill_point_cloud(lidar: &Lidar3D, hits: &RayHits, point_cloud: &mut PointCloud) {
     let mut rng = rand::thread_rng();
 
-    // Calculate angle increments
-    let horizontal_step = if lidar.horizontal_rays > 1 {
-        lidar.horizontal_fov / (lidar.horizontal_rays - 1) as f32
-    } else {
-        0.0
-    };
-
-    let vertical_step = if lidar.vertical_rays > 1 {
-        lidar.vertical_fov / (lidar.vertical_rays - 1) as f32
-    } else {
-        0.0
-    };
-
-    let horizontal_start = -lidar.horizontal_fov / 2.0;
-    let vertical_start = -lidar.vertical_fov / 2.0;
-
-    // Convert position and rotation to nalgebra
-    let ray_origin = point![position.x, position.y, position.z];
-    let base_rotation = nalgebra::UnitQuaternion::new_normalize(nalgebra::Quaternion::new(
-        rotation.w, rotation.x, rotation.y, rotation.z,
-    ));
-
-    // Cast rays in a spherical pattern
-    for v_idx in 0..lidar.vertical_rays {
-        let vertical_angle = vertical_start + v_idx as f32 * vertical_step;
-
-        for h_idx in 0..lidar.horizontal_rays {
-            let horizontal_angle = horizontal_start + h_idx as f32 * horizontal_step;
-
-            // Compute ray direction in sensor frame
-            let dir_x = horizontal_angle.cos() * vertical_angle.cos();
-            let dir_y = vertical_angle.sin();
-            let dir_z = horizontal_angle.sin() * vertical_angle.cos();
-
-            let local_dir = nalgebra::Vector3::new(dir_x, dir_y, dir_z);
-
-            // Transform to world frame
-            let world_dir = base_rotation * local_dir;
-            let ray_dir = nalgebra::Unit::new_normalize(world_dir);
-
-            // Create ray
-            let ray = Ray::new(ray_origin, ray_dir.into_inner());
-
-            // Cast ray
-            if let Some((_handle, toi)) = physics_world.query_pipeline.cast_ray(
-                &physics_world.rigid_body_set,
-                &physics_world.collider_set,
-                &ray,
-                lidar.max_range,
-                true,
-                QueryFilter::default(),
-            ) {
-                if toi >= lidar.min_range {
-                    // Add noise if configured
-                    let noisy_toi = if lidar.noise_std > 0.0 {
-                        let noise: f32 = rng.gen_range(-lidar.noise_std..lidar.noise_std);
-                        (toi + noise).clamp(lidar.min_range, lidar.max_range)
-                    } else {
-                        toi
-                    };
-
-                    // Compute 3D point in world coordinates
-                    let hit_point = ray.point_at(noisy_toi);
-                    let point = Vec3::new(hit_point.x, hit_point.y, hit_point.z);
-
-                    // Compute intensity based on distance (inverse square law)
-                    let intensity = 1.0 / (1.0 + (noisy_toi / lidar.max_range).powi(2));
-
-                    point_cloud.add_point(point, intensity);
-                }
-            }
+    // Clear previous point cloud (keeps capacity)
+    point_cloud.clear();
+    point_cloud.timestamp = hits.timestamp;
+
+    let directions = lidar.rays.directions();
+    point_cloud.points.reserve(directions.len());
+    point_cloud.intensities.reserve(directions.len());
+
+    for (dir, &toi) in directions.iter().zip(&lidar.ranges) {
+        // Misses are infinite and fail the range check
+        if !(lidar.min_range..=lidar.max_range).contains(&toi) {
+            continue;
         }
+
+        // Add noise if configured
+        let noisy_toi = if lidar.noise_std > 0.0 {
+            let noise: f32 = rng.gen_range(-lidar.noise_std..lidar.noise_std);
+            (toi + noise).clamp(lidar.min_range, lidar.max_range)
+        } else {
+            toi
+        };
+
+        // Compute 3D point in world coordinates
+        point_cloud
+            .points
+            .push(hits.origin + hits.rotation * (*dir * noisy_toi));
+
+        // Compute intensity based on distance (inverse square law)
+        point_cloud
+            .intensities
+            .push(1.0 / (1.0 + (noisy_toi / lidar.max_range).powi(2)));
     }
 }
 
@@ -266,6 +239,10 @@ pub struct Lidar2D {
     pub rate_hz: f32,
     pub noise_std: f32,
     pub last_update: f32,
+    /// Beam directions, rebuilt when the ray count or FOV change
+    rays: RayTable,
+    /// Per-beam range scratch reused across scans
+    ranges: Vec<f32>,
 }
 
 impl Default for Lidar2D {
@@ -278,6 +255,8 @@ impl Default for Lidar2D {
             rate_hz: 10.0,
             noise_std: 0.01,
             last_update: 0.0,
+            rays: RayTable::default(),
+            ranges: Vec::new(),
         }
     }
 }
@@ -295,6 +274,16 @@ impl Lidar2D {
     pub fn should_update(&self, current_time: f32) -> bool {
         current_time - self.last_update >= 1.0 / self.rate_hz
     }
+
+    /// Single ring in the XZ plane, matching `LaserScan` angles
+    pub fn ray_pattern(&self) -> RayPattern {
+        RayPattern::Spherical {
+            horizontal: self.num_rays,
+            vertical: 1,
+            horizontal_fov: self.fov,
+            vertical_fov: 0.0,
+        }
+    }
 }
 
 #[derive(Component, Clone)]
@@ -339,78 +328,61 @@ impl LaserScan {
 
 pub fn lidar2d_update_system(
     time: Res<Time>,
-    mut physics_world: ResMut<PhysicsWorld>,
-    mut query: Query<(&mut Lidar2D, &mut LaserScan, &GlobalTransform)>,
+    mut rays: SensorRays,
+    mut query: Query<(Entity, &mut Lidar2D, &mut LaserScan, &GlobalTransform)>,
 ) {
     let current_time = time.elapsed_secs();
 
-    for (mut lidar, mut scan, transform) in query.iter_mut() {
-        if !lidar.should_update(current_time) {
+    for (entity, mut lidar, mut scan, transform) in query.iter_mut() {
+        let due = lidar.should_update(current_time);
+        if !due && !rays.in_flight(entity) {
             continue;
         }
-
-        lidar.last_update = current_time;
-        scan.clear();
-        scan.timestamp = current_time;
+        if due {
+            lidar.last_update = current_time;
+        }
 
         // Get sensor pose (assume 2D lidar scans in XZ plane, Y-up)
-        let sensor_pos = transform.translation();
-        let sensor_rot = transform.to_scale_rotation_translation().1;
-
-        cast_lidar2d_rays(
-            &lidar,
+        let (_, sensor_rot, sensor_pos) = transform.to_scale_rotation_translation();
+
+        let lidar = &mut *lidar;
+        let pattern = lidar.ray_pattern();
+        let directions = lidar.rays.ensure(pattern);
+        if let Some(hits) = rays.cast(
+            entity,
+            due,
             sensor_pos,
             sensor_rot,
-            &mut scan,
-            &mut physics_world,
-        );
+            directions,
+            lidar.max_range,
+            current_time,
+            &mut lidar.ranges,
+        ) {
+            fill_laser_scan(lidar, &hits, &mut scan);
+        }
     }
 }
 
-fn cast_lidar2d_rays(
-    lidar: &Lidar2D,
-    position: Vec3,
-    rotation: Quat,
-    scan: &mut LaserScan,
-    physics_world: &mut PhysicsWorld,
-) {
+fn fill_laser_scan(lidar: &Lidar2D, hits: &RayHits, scan: &mut LaserScan) {
     let mut rng = rand::thread_rng();
 
-    let ray_origin = point![position.x, position.y, position.z];
-    let base_rotation = nalgebra::UnitQuaternion::new_normalize(nalgebra::Quaternion::new(
-        rotation.w, rotation.x, rotation.y, rotation.z,
-    ));
-
-    for i in 0..lidar.num_rays {
-        let angle = scan.angle_min + i as f32 * scan.angle_increment;
+    scan.clear();
+    scan.timestamp = hits.timestamp;
 
-        // 2D ray in XZ plane
-        let local_dir = nalgebra::Vector3::new(angle.cos(), 0.0, angle.sin());
-        let world_dir = base_rotation * local_dir;
-        let ray_dir = nalgebra::Unit::new_normalize(world_dir);
+    for (i, &toi) in lidar.ranges.iter().enumerate().take(scan.ranges.len()) {
+        if !(lidar.min_range..=lidar.max_range).contains(&toi) {
+            continue;
+        }
 
-        let ray = Ray::new(ray_origin, ray_dir.into_inner());
+        let noisy_toi = if lidar.noise_std > 0.0 {
+            let noise: f32 = rng.gen_range(-lidar.noise_std..lidar.noise_std);
+            (toi + noise).clamp(lidar.min_range, lidar.max_range)
+        } else {
+            toi
+        };
 
-        if let Some((_handle, toi)) = physics_world.query_pipeline.cast_ray(
-            &physics_world.rigid_body_set,
-            &physics_world.collider_set,
-            &ray,
-            lidar.max_range,
-            true,
-            QueryFilter::default(),
-        ) {
-            if toi >= lidar.min_range {
-                let noisy_toi = if lidar.noise_std > 0.0 {
-                    let noise: f32 = rng.gen_range(-lidar.noise_std..lidar.noise_std);
-                    (toi + noise).clamp(lidar.min_range, lidar.max_range)
-                } else {
-                    toi
-                };
-
-                scan.ranges[i] = noisy_toi;
-                scan.intensities[i] = 1.0 / (1.0 + (noisy_toi / lidar.max_range).powi(2));
-            }
-        }
+        scan.ranges[i] = noisy_toi;
+        scan.intensities[i] = 1.0 / (1.0 + (noisy_toi / lidar.max_range).powi(2));
     }
 }
 
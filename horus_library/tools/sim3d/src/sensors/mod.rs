@@ -13,6 +13,7 @@ pub mod imu;
 pub mod lidar3d;
 pub mod noise;
 pub mod radar;
+pub mod raycast;
 pub mod rgbd;
 pub mod segmentation;
 pub mod sonar;
@@ -0,0 +1,421 @@
+//! Batched raycasting shared by range sensors (lidar, depth, sonar)
+//!
+//! Sensors describe their beam layout as a [`RayPattern`]; the sensor-frame
+//! directions are computed once into a [`RayTable`] and reused until the
+//! pattern changes, so no trigonometry runs per ray per scan.
+//!
+//! Each scan is cast as one batch by [`SensorRays`]:
+//! - **CPU**: rays are cast against the rapier query pipeline, split across
+//!   the rayon pool once the batch is large enough.
+//! - **GPU**: rays are dispatched to [`GPURaycastPipeline`] against a
+//!   triangulated copy of the colliders. Readback is asynchronous, so
+//!   results arrive on a later frame, stamped with the pose and time at
+//!   which they were cast.
+//!
+//! The GPU backend needs the `GPUPhysicsAdapter` resource
+//! (see `physics::gpu_integration::setup_gpu_acceleration`); without it the
+//! CPU path is used.
+//!
+//! [`GPURaycastPipeline`]: crate::gpu::GPURaycastPipeline
+
+use bevy::ecs::system::SystemParam;
+use bevy::prelude::*;
+use rapier3d::prelude::*;
+use rayon::prelude::*;
+use std::collections::HashMap;
+
+use crate::gpu::{GPURaycastScene, PendingRaycast};
+use crate::physics::gpu_integration::{collect_collider_triangles, GPUPhysicsAdapter};
+use crate::physics::world::PhysicsWorld;
+
+/// Where sensor rays are cast
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum RaycastBackend {
+    /// Rapier query pipeline on the CPU (rayon-parallel for large batches)
+    #[default]
+    Cpu,
+    /// Compute shader with asynchronous readback
+    Gpu,
+}
+
+/// Sensor raycasting configuration
+#[derive(Resource, Clone, Debug)]
+pub struct SensorRaycastConfig {
+    /// Backend for lidar, depth and sonar sensors
+    pub backend: RaycastBackend,
+    /// Rays per batch above which the CPU path runs in parallel
+    pub parallel_min_rays: usize,
+}
+
+impl Default for SensorRaycastConfig {
+    fn default() -> Self {
+        Self {
+            backend: RaycastBackend::Cpu,
+            parallel_min_rays: 512,
+        }
+    }
+}
+
+impl SensorRaycastConfig {
+    pub fn gpu() -> Self {
+        Self {
+            backend: RaycastBackend::Gpu,
+            ..default()
+        }
+    }
+}
+
+/// Beam layout of a range sensor, in the sensor frame
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub enum RayPattern {
+    /// Rotating lidar: `vertical` rings of `horizontal` beams, X forward,
+    /// Y up, row-major by ring
+    Spherical {
+        horizontal: usize,
+        vertical: usize,
+        horizontal_fov: f32,
+        vertical_fov: f32,
+    },
+    /// Pinhole camera looking down +Z, row-major by pixel
+    Pinhole {
+        width: u32,
+        height: u32,
+        fov_horizontal: f32,
+        fov_vertical: f32,
+    },
+    /// Cone around -Z: a center ray plus `rings` rings of `per_ring` rays
+    Cone {
+        half_angle: f32,
+        rings: usize,
+        per_ring: usize,
+    },
+}
+
+/// Precomputed sensor-frame ray directions
+#[derive(Clone, Debug, Default)]
+pub struct RayTable {
+    pattern: Option<RayPattern>,
+    directions: Vec<Vec3>,
+}
+
+impl RayTable {
+    /// Directions for `pattern`, rebuilding only if it changed
+    pub fn ensure(&mut self, pattern: RayPattern) -> &[Vec3] {
+        if self.pattern != Some(pattern) {
+            self.directions.clear();
+            build_directions(pattern, &mut self.directions);
+            self.pattern = Some(pattern);
+        }
+        &self.directions
+    }
+
+    /// Directions of the current pattern
+    pub fn directions(&self) -> &[Vec3] {
+        &self.directions
+    }
+
+    pub fn len(&self) -> usize {
+        self.directions.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.directions.is_empty()
+    }
+}
+
+fn build_directions(pattern: RayPattern, out: &mut Vec<Vec3>) {
+    match pattern {
+        RayPattern::Spherical {
+            horizontal,
+            vertical,
+            horizontal_fov,
+            vertical_fov,
+        } => {
+            let step = |fov: f32, n: usize| if n > 1 { fov / (n - 1) as f32 } else { 0.0 };
+            let h_step = step(horizontal_fov, horizontal);
+            let v_step = step(vertical_fov, vertical);
+
+            // sin/cos once per column and per ring
+            let columns: Vec<(f32, f32)> = (0..horizontal)
+                .map(|h| (-horizontal_fov / 2.0 + h as f32 * h_step).sin_cos())
+                .collect();
+            out.reserve(horizontal * vertical);
+            for v in 0..vertical {
+                let (v_sin, v_cos) = (-vertical_fov / 2.0 + v as f32 * v_step).sin_cos();
+                out.extend(
+                    columns
+                        .iter()
+                        .map(|&(h_sin, h_cos)| Vec3::new(h_cos * v_cos, v_sin, h_sin * v_cos)),
+                );
+            }
+        }
+        RayPattern::Pinhole {
+            width,
+            height,
+            fov_horizontal,
+            fov_vertical,
+        } => {
+            let tan_h = (fov_horizontal / 2.0).tan();
+            let tan_v = (fov_vertical / 2.0).tan();
+            out.reserve((width * height) as usize);
+            for y in 0..height {
+                let ndc_y = 1.0 - 2.0 * (y as f32 + 0.5) / height as f32;
+                for x in 0..width {
+                    let ndc_x = 2.0 * (x as f32 + 0.5) / width as f32 - 1.0;
+                    out.push(Vec3::new(ndc_x * tan_h, ndc_y * tan_v, 1.0).normalize());
+                }
+            }
+        }
+        RayPattern::Cone {
+            half_angle,
+            rings,
+            per_ring,
+        } => {
+            out.push(Vec3::NEG_Z);
+            for r in 1..=rings {
+                let (t_sin, t_cos) = (half_angle * r as f32 / rings as f32).sin_cos();
+                for k in 0..per_ring {
+                    let (p_sin, p_cos) =
+                        (std::f32::consts::TAU * k as f32 / per_ring as f32).sin_cos();
+                    out.push(Vec3::new(t_sin * p_cos, t_sin * p_sin, -t_cos));
+                }
+            }
+        }
+    }
+}
+
+/// Cast `directions` (sensor frame) from `origin` on the CPU
+///
+/// `ranges` is resized to one entry per ray; misses are `f32::INFINITY`.
+pub fn cast_rays_cpu(
+    world: &PhysicsWorld,
+    origin: Vec3,
+    rotation: Quat,
+    directions: &[Vec3],
+    max_range: f32,
+    parallel_min_rays: usize,
+    ranges: &mut Vec<f32>,
+) {
+    ranges.clear();
+    ranges.resize(directions.len(), f32::INFINITY);
+
+    let ray_origin = point![origin.x, origin.y, origin.z];
+    let cast = |range: &mut f32, dir: &Vec3| {
+        let d = rotation * *dir;
+        let ray = Ray::new(ray_origin, vector![d.x, d.y, d.z]);
+        if let Some((_handle, toi)) = world.query_pipeline.cast_ray(
+            &world.rigid_body_set,
+            &world.collider_set,
+            &ray,
+            max_range,
+            true,
+            QueryFilter::default(),
+        ) {
+            *range = toi;
+        }
+    };
+
+    if directions.len() >= parallel_min_rays {
+        ranges
+            .par_iter_mut()
+            .zip(directions.par_iter())
+            .for_each(|(range, dir)| cast(range, dir));
+    } else {
+        for (range, dir) in ranges.iter_mut().zip(directions) {
+            cast(range, dir);
+        }
+    }
+}
+
+/// Pose and time a completed batch was cast at
+#[derive(Clone, Copy, Debug)]
+pub struct RayHits {
+    pub origin: Vec3,
+    pub rotation: Quat,
+    pub timestamp: f32,
+}
+
+struct InFlight {
+    pending: PendingRaycast,
+    hits: RayHits,
+    max_range: f32,
+}
+
+/// GPU-side state: the triangulated scene and per-sensor in-flight batches
+#[derive(Resource, Default)]
+pub struct GpuSensorRaycaster {
+    scene: Option<GPURaycastScene>,
+    /// Time the scene was last triangulated (once per frame at most)
+    scene_time: Option<f32>,
+    triangles: Vec<[Vec3; 3]>,
+    world_directions: Vec<Vec3>,
+    in_flight: HashMap<Entity, InFlight>,
+    warned_unavailable: bool,
+}
+
+/// System parameter that casts a sensor's rays on the configured backend
+#[derive(SystemParam)]
+pub struct SensorRays<'w> {
+    config: Res<'w, SensorRaycastConfig>,
+    world: Option<Res<'w, PhysicsWorld>>,
+    adapter: Option<Res<'w, GPUPhysicsAdapter>>,
+    gpu: ResMut<'w, GpuSensorRaycaster>,
+}
+
+impl SensorRays<'_> {
+    /// Whether `entity` has a GPU batch awaiting readback
+    pub fn in_flight(&self, entity: Entity) -> bool {
+        self.gpu.in_flight.contains_key(&entity)
+    }
+
+    /// Collect finished results for `entity` and, if `due`, start a new scan
+    ///
+    /// Returns the pose of the scan whose ranges were written to `ranges`,
+    /// or `None` if nothing completed this frame. On the CPU a due scan
+    /// completes immediately; on the GPU it completes on a later frame.
+    #[allow(clippy::too_many_arguments)]
+    pub fn cast(
+        &mut self,
+        entity: Entity,
+        due: bool,
+        origin: Vec3,
+        rotation: Quat,
+        directions: &[Vec3],
+        max_range: f32,
+        now: f32,
+        ranges: &mut Vec<f32>,
+    ) -> Option<RayHits> {
+        let world = self.world.as_deref()?;
+        let hits = RayHits {
+            origin,
+            rotation,
+            timestamp: now,
+        };
+
+        let gpu = match (self.config.backend, self.adapter.as_deref()) {
+            (RaycastBackend::Gpu, Some(adapter)) => adapter.raycaster(),
+            _ => None,
+        };
+        let Some((context, pipeline)) = gpu else {
+            if self.config.backend == RaycastBackend::Gpu && !self.gpu.warned_unavailable {
+                warn!("GPU sensor raycasting unavailable, using the CPU");
+                self.gpu.warned_unavailable = true;
+            }
+            if !due {
+                return None;
+            }
+            cast_rays_cpu(
+                world,
+                origin,
+                rotation,
+                directions,
+                max_range,
+                self.config.parallel_min_rays,
+                ranges,
+            );
+            return Some(hits);
+        };
+
+        let state = &mut *self.gpu;
+        let mut completed = None;
+        if let Some(flight) = state.in_flight.get(&entity) {
+            if flight.pending.is_ready(context) {
+                let flight = state.in_flight.remove(&entity).expect("checked above");
+                if flight.pending.read_into(context, ranges) {
+                    // The shader reports misses as max distance
+                    for range in ranges.iter_mut() {
+                        if *range >= flight.max_range {
+                            *range = f32::INFINITY;
+                        }
+                    }
+                    completed = Some(flight.hits);
+                }
+            }
+        }
+
+        if due && !state.in_flight.contains_key(&entity) {
+            if state.scene.is_none() || state.scene_time != Some(now) {
+                collect_collider_triangles(world, &mut state.triangles);
+                state.scene = Some(pipeline.upload_scene(context, &state.triangles));
+                state.scene_time = Some(now);
+            }
+            state.world_directions.clear();
+            state
+                .world_directions
+                .extend(directions.iter().map(|d| rotation * *d));
+
+            let scene = state.scene.as_ref().expect("uploaded above");
+            let pending =
+                pipeline.submit(context, scene, origin, &state.world_directions, max_range);
+            state.in_flight.insert(
+                entity,
+                InFlight {
+                    pending,
+                    hits,
+                    max_range,
+                },
+            );
+        }
+
+        completed
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_spherical_matches_per_ray_trig() {
+        let mut table = RayTable::default();
+        let dirs = table.ensure(RayPattern::Spherical {
+            horizontal: 8,
+            vertical: 3,
+            horizontal_fov: std::f32::consts::TAU,
+            vertical_fov: 0.5,
+        });
+        assert_eq!(dirs.len(), 24);
+
+        let h_step = std::f32::consts::TAU / 7.0;
+        let v_step = 0.5 / 2.0;
+        for v in 0..3 {
+            let va = -0.25 + v as f32 * v_step;
+            for h in 0..8 {
+                let ha = -std::f32::consts::PI + h as f32 * h_step;
+                let expected = Vec3::new(ha.cos() * va.cos(), va.sin(), ha.sin() * va.cos());
+                assert!((dirs[v * 8 + h] - expected).length() < 1e-5);
+            }
+        }
+    }
+
+    #[test]
+    fn test_table_rebuilds_on_change() {
+        let mut table = RayTable::default();
+        let cone = |rings| RayPattern::Cone {
+            half_angle: 0.3,
+            rings,
+            per_ring: 6,
+        };
+        assert_eq!(table.ensure(cone(2)).len(), 13);
+        assert_eq!(table.ensure(cone(2)).len(), 13);
+        assert_eq!(table.ensure(cone(3)).len(), 19);
+
+        // Every cone ray stays within the half angle of -Z
+        for dir in table.directions() {
+            assert!(dir.angle_between(Vec3::NEG_Z) <= 0.3 + 1e-5);
+        }
+    }
+
+    #[test]
+    fn test_pinhole_center_ray() {
+        let mut table = RayTable::default();
+        let dirs = table.ensure(RayPattern::Pinhole {
+            width: 3,
+            height: 3,
+            fov_horizontal: 1.0,
+            fov_vertical: 1.0,
+        });
+        assert!((dirs[4] - Vec3::Z).length() < 1e-6);
+        assert!(dirs[0].x < 0.0 && dirs[0].y > 0.0);
+    }
+}
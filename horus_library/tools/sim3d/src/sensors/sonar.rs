@@ -3,6 +3,15 @@
 use bevy::prelude::*;
 use rand::Rng;
 
+use crate::sensors::raycast::{RayPattern, RayTable, SensorRays};
+
+/// Rings of rays sampling the sonar cone (plus the center ray)
+const CONE_RINGS: usize = 3;
+/// Rays per cone ring
+const CONE_RAYS_PER_RING: usize = 8;
+/// Minimum separation between reported multipath returns (meters)
+const MULTIPATH_SEPARATION: f32 = 0.1;
+
 /// Sonar sensor type
 #[derive(Clone, Copy, Debug, PartialEq, Eq, Reflect)]
 pub enum SonarType {
@@ -30,6 +39,12 @@ pub struct SonarSensor {
     pub last_update: f32,
     /// Measurement noise standard deviation (meters)
     pub noise_std: f32,
+    /// Cone sample directions for raycast measurement
+    #[reflect(ignore)]
+    rays: RayTable,
+    /// Range scratch reused across measurements
+    #[reflect(ignore)]
+    ranges: Vec<f32>,
 }
 
 impl Default for SonarSensor {
@@ -42,6 +57,8 @@ impl Default for SonarSensor {
             rate_hz: 20.0,
             last_update: 0.0,
             noise_std: 0.01,
+            rays: RayTable::default(),
+            ranges: Vec::new(),
         }
     }
 }
@@ -83,6 +100,14 @@ impl SonarSensor {
         current_time - self.last_update >= 1.0 / self.rate_hz
     }
 
+    pub fn ray_pattern(&self) -> RayPattern {
+        RayPattern::Cone {
+            half_angle: self.cone_angle / 2.0,
+            rings: CONE_RINGS,
+            per_ring: CONE_RAYS_PER_RING,
+        }
+    }
+
     /// Get speed of sound based on sensor type
     pub fn speed_of_sound(&self) -> f32 {
         match self.sonar_type {
@@ -218,6 +243,105 @@ pub fn sonar_sensor_update_system(
     }
 }
 
+/// System to update sonar sensors by casting rays across the beam cone
+///
+/// Unlike `sonar_sensor_update_system`, which measures to obstacle
+/// origins, this measures to the collider surfaces hit by the cone rays.
+pub fn sonar_raycast_update_system(
+    time: Res<Time>,
+    mut rays: SensorRays,
+    mut sonars: Query<(
+        Entity,
+        &mut SonarSensor,
+        &mut SonarMeasurement,
+        &GlobalTransform,
+    )>,
+) {
+    let current_time = time.elapsed_secs();
+    let mut rng = rand::thread_rng();
+
+    for (entity, mut sonar, mut measurement, transform) in sonars.iter_mut() {
+        let due = sonar.should_update(current_time);
+        if !due && !rays.in_flight(entity) {
+            continue;
+        }
+        if due {
+            sonar.last_update = current_time;
+        }
+
+        let (_, rotation, position) = transform.to_scale_rotation_translation();
+        let sonar = &mut *sonar;
+        let pattern = sonar.ray_pattern();
+        let directions = sonar.rays.ensure(pattern);
+        let Some(hits) = rays.cast(
+            entity,
+            due,
+            position,
+            rotation,
+            directions,
+            sonar.max_range,
+            current_time,
+            &mut sonar.ranges,
+        ) else {
+            continue;
+        };
+
+        measurement.timestamp = hits.timestamp;
+        measurement.multipath.clear();
+
+        let half_cone = sonar.cone_angle / 2.0;
+        let mut returns: Vec<(f32, f32)> = sonar
+            .rays
+            .directions()
+            .iter()
+            .zip(&sonar.ranges)
+            .filter(|(_, &d)| d >= sonar.min_range && d <= sonar.max_range)
+            .map(|(dir, &distance)| {
+                // Same confidence model as the obstacle-based system
+                let angle = dir.angle_between(Vec3::NEG_Z);
+                let angle_factor = if half_cone > 0.0 {
+                    1.0 - angle / half_cone
+                } else {
+                    1.0
+                };
+                let distance_factor = 1.0 - distance / sonar.max_range;
+                let confidence = (angle_factor * 0.7 + distance_factor * 0.3).max(0.1);
+                (distance, confidence)
+            })
+            .collect();
+        returns.sort_by(|a, b| a.0.total_cmp(&b.0));
+
+        let Some(&(closest, confidence)) = returns.first() else {
+            // No detection
+            measurement.distance = f32::MAX;
+            measurement.confidence = 0.0;
+            continue;
+        };
+
+        let noise: f32 = if sonar.noise_std > 0.0 {
+            rng.gen_range(-sonar.noise_std..sonar.noise_std)
+        } else {
+            0.0
+        };
+        measurement.distance = (closest + noise).max(sonar.min_range);
+        measurement.confidence = confidence;
+
+        // Later echoes from distinct surfaces
+        let mut last = closest;
+        for &(distance, conf) in &returns[1..] {
+            if distance - last >= MULTIPATH_SEPARATION && conf > 0.3 {
+                let multipath_noise: f32 = if sonar.noise_std > 0.0 {
+                    rng.gen_range(-sonar.noise_std * 2.0..sonar.noise_std * 2.0)
+                } else {
+                    0.0
+                };
+                measurement.add_multipath_reflection(distance + multipath_noise);
+                last = distance;
+            }
+        }
+    }
+}
+
 /// Sonar array for multi-sensor configurations
 #[derive(Component)]
 pub struct SonarArray {
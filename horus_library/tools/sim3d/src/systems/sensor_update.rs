@@ -1,5 +1,6 @@
 use bevy::prelude::*;
 
+use crate::sensors::raycast::{GpuSensorRaycaster, SensorRaycastConfig};
 use crate::sensors::{camera, encoder, force_torque, gps, imu, lidar3d};
 
 /// System set for sensor updates - ensures sensors run after physics
@@ -17,7 +18,9 @@ pub struct SensorUpdatePlugin;
 impl Plugin for SensorUpdatePlugin {
     fn build(&self, app: &mut App) {
         // Initialize resources needed by sensors
-        app.init_resource::<imu::Gravity>();
+        app.init_resource::<imu::Gravity>()
+            .init_resource::<SensorRaycastConfig>()
+            .init_resource::<GpuSensorRaycaster>();
 
         // Configure system sets
         app.configure_sets(
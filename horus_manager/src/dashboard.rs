@@ -1517,112 +1517,60 @@ async fn websocket_handler(ws: WebSocketUpgrade) -> impl IntoResponse {
 }
 
 async fn handle_websocket(socket: WebSocket) {
-    let (mut sender, _receiver) = socket.split();
+    use crate::dashboard_feed::{live_feed, FeedEvent, LogFilter};
+    use tokio::sync::broadcast::error::RecvError;
 
-    // Stream updates every 250ms (4 FPS) for reasonable real-time monitoring
-    // This reduces backend load and network traffic significantly
-    let mut interval = tokio::time::interval(tokio::time::Duration::from_millis(250));
+    // All clients share one reader; this task only forwards and filters
+    let feed = live_feed();
+    let mut events = feed.subscribe();
+    let (mut sender, mut receiver) = socket.split();
 
-    loop {
-        interval.tick().await;
-
-        // Gather all data in parallel
-        let (nodes_result, topics_result, graph_result) = tokio::join!(
-            tokio::task::spawn_blocking(|| {
-                crate::commands::monitor::discover_nodes()
-                    .unwrap_or_default()
-                    .into_iter()
-                    .map(|n| {
-                        serde_json::json!({
-                            "name": n.name,
-                            "pid": n.process_id,
-                            "status": n.status,
-                            "health": n.health.as_str(),
-                            "health_color": n.health.color(),
-                            "cpu": format!("{:.1}%", n.cpu_usage),
-                            "memory": format!("{} MB", n.memory_usage / 1024 / 1024),
-                            "scheduler_name": n.scheduler_name,
-                        })
-                    })
-                    .collect::<Vec<_>>()
-            }),
-            tokio::task::spawn_blocking(|| {
-                crate::commands::monitor::discover_shared_memory()
-                    .unwrap_or_default()
-                    .into_iter()
-                    .map(|t| {
-                        serde_json::json!({
-                            "name": t.topic_name,
-                            "size": format!("{} KB", t.size_bytes / 1024),
-                            "active": t.active,
-                            "processes": t.accessing_processes.len(),
-                        })
-                    })
-                    .collect::<Vec<_>>()
-            }),
-            tokio::task::spawn_blocking(|| {
-                let (nodes, edges) = crate::graph::discover_graph_data();
-                (nodes, edges)
-            })
-        );
-
-        // Unwrap results
-        let nodes = nodes_result.unwrap_or_default();
-        let topics = topics_result.unwrap_or_default();
-        let (graph_nodes, graph_edges) = graph_result.unwrap_or_default();
-
-        // Convert graph data
-        let graph_nodes_json = graph_nodes
-            .into_iter()
-            .map(|n| {
-                serde_json::json!({
-                    "id": n.id,
-                    "label": n.label,
-                    "type": match n.node_type {
-                        crate::graph::NodeType::Process => "process",
-                        crate::graph::NodeType::Topic => "topic",
-                    },
-                    "pid": n.pid,
-                    "active": n.active,
-                })
-            })
-            .collect::<Vec<_>>();
-
-        let graph_edges_json = graph_edges
-            .into_iter()
-            .map(|e| {
-                serde_json::json!({
-                    "from": e.from,
-                    "to": e.to,
-                    "type": match e.edge_type {
-                        crate::graph::EdgeType::Publish => "publish",
-                        crate::graph::EdgeType::Subscribe => "subscribe",
-                    },
-                    "active": e.active,
-                })
-            })
-            .collect::<Vec<_>>();
-
-        // Build update message
-        let update = serde_json::json!({
-            "type": "update",
-            "timestamp": chrono::Utc::now().to_rfc3339(),
-            "data": {
-                "nodes": nodes,
-                "topics": topics,
-                "graph": {
-                    "nodes": graph_nodes_json,
-                    "edges": graph_edges_json
-                }
-            }
-        });
-
-        // Send to client
+    // Show the current state right away instead of after the next snapshot
+    if let Some(snapshot) = feed.latest_snapshot() {
         if sender
-            .send(Message::Text(update.to_string()))
+            .send(Message::Text(snapshot.to_string()))
             .await
             .is_err()
         {
+            return;
+        }
+    }
+
+    let mut filter = LogFilter::None;
+    loop {
+        let text = tokio::select! {
+            incoming = receiver.next() => match incoming {
+                Some(Ok(Message::Text(request))) => match LogFilter::from_request(&request) {
+                    Some(LogFilter::None) => {
+                        filter = LogFilter::None;
+                        continue;
+                    }
+                    // Newly opened log view: recent records, then live deltas
+                    Some(view) => {
+                        filter = view;
+                        feed.backlog_message(&filter)
+                    }
+                    None => continue,
+                },
+                Some(Ok(Message::Close(_))) | Some(Err(_)) | None => break,
+                Some(Ok(_)) => continue,
+            },
+            event = events.recv() => match event {
+                Ok(FeedEvent::Snapshot(snapshot)) => snapshot.to_string(),
+                Ok(FeedEvent::Logs(delta)) => match delta.to_message(&filter) {
+                    Some(message) => message,
+                    None => continue,
+                },
+                // Too slow to keep up: skip ahead and resend the open view
+                Err(RecvError::Lagged(_)) if filter != LogFilter::None => {
+                    feed.backlog_message(&filter)
+                }
+                Err(RecvError::Lagged(_)) => continue,
+                Err(RecvError::Closed) => break,
+            },
+        };
+
+        if sender.send(Message::Text(text)).await.is_err() {
             break; // Client disconnected
         }
     }
@@ -4208,12 +4156,39 @@ fn generate_html(port: u16) -> String {
             }}
 
             // Set new view context BEFORE starting updates
-            currentLogView = {{ type: 'node', name: nodeName, interval: null }};
+            currentLogView = {{ type: 'node', name: nodeName, interval: null, logs: [], to: 0, render: null, poll: null }};
 
             title.textContent = `Logs: ${{nodeName}} (live)`;
             content.innerHTML = '<p style="color: var(--text-secondary);">Loading logs...</p>';
             panel.classList.add('open');
 
+            function render(logs) {{
+                if (logs.length > 0) {{
+                    const wasScrolledToBottom = content.scrollHeight - content.scrollTop <= content.clientHeight + 50;
+
+                    content.innerHTML = logs.slice(-100).map(log => `
+                        <div class="log-entry">
+                            <div class="log-entry-header">
+                                <span class="log-timestamp">${{log.timestamp}}</span>
+                                <span class="log-type log-type-${{log.log_type.toLowerCase()}}">${{log.log_type}}</span>
+                            </div>
+                            ${{log.topic ? `<div style="color: var(--text-tertiary); font-size: 0.75rem;">Topic: ${{log.topic}}</div>` : ''}}
+                            <div class="log-message">${{log.message}}</div>
+                            <div style="color: var(--text-tertiary); font-size: 0.7rem; margin-top: 0.5rem;">
+                                Tick: ${{log.tick_us}}μs | IPC: ${{log.ipc_ns}}ns
+                            </div>
+                        </div>
+                    `).join('');
+
+                    if (wasScrolledToBottom) {{
+                        content.scrollTop = content.scrollHeight;
+                    }}
+                }} else {{
+                    content.innerHTML = '<p style="color: var(--text-secondary);">No logs found for this node</p>';
+                }}
+            }}
+            currentLogView.render = render;
+
             async function updateLogs() {{
                 // Guard: Only update if this is still the active view
                 if (currentLogView.type !== 'node' || currentLogView.name !== nodeName) {{
@@ -4229,37 +4204,20 @@ fn generate_html(port: u16) -> String {
                         return; // View changed during fetch
                     }}
 
-                    if (data.logs && data.logs.length > 0) {{
-                        const wasScrolledToBottom = content.scrollHeight - content.scrollTop <= content.clientHeight + 50;
-
-                        content.innerHTML = data.logs.slice(-100).map(log => `
-                            <div class="log-entry">
-                                <div class="log-entry-header">
-                                    <span class="log-timestamp">${{log.timestamp}}</span>
-                                    <span class="log-type log-type-${{log.log_type.toLowerCase()}}">${{log.log_type}}</span>
-                                </div>
-                                ${{log.topic ? `<div style="color: var(--text-tertiary); font-size: 0.75rem;">Topic: ${{log.topic}}</div>` : ''}}
-                                <div class="log-message">${{log.message}}</div>
-                                <div style="color: var(--text-tertiary); font-size: 0.7rem; margin-top: 0.5rem;">
-                                    Tick: ${{log.tick_us}}μs | IPC: ${{log.ipc_ns}}ns
-                                </div>
-                            </div>
-                        `).join('');
-
-                        if (wasScrolledToBottom) {{
-                            content.scrollTop = content.scrollHeight;
-                        }}
-                    }} else {{
-                        content.innerHTML = '<p style="color: var(--text-secondary);">No logs found for this node</p>';
-                    }}
+                    render(data.logs || []);
                 }} catch (error) {{
                     content.innerHTML = `<p style="color: #ff4444;">Error loading logs: ${{error.message}}</p>`;
                 }}
             }}
 
-            await updateLogs();
-            // Update logs every 200ms (5 times per second) - reasonable balance
-            currentLogView.interval = setInterval(updateLogs, 200);
+            // Live records are pushed over the WebSocket; poll only without it
+            currentLogView.poll = updateLogs;
+            if (wsConnected) {{
+                subscribeLogs();
+            }} else {{
+                await updateLogs();
+                currentLogView.interval = setInterval(updateLogs, 1000);
+            }}
         }}
 
         async function showTopicLogs(topicName) {{
@@ -4276,12 +4234,53 @@ fn generate_html(port: u16) -> String {
             }}
 
             // Set new view context BEFORE starting updates
-            currentLogView = {{ type: 'topic', name: topicName, interval: null }};
+            currentLogView = {{ type: 'topic', name: topicName, interval: null, logs: [], to: 0, render: null, poll: null }};
 
             title.textContent = `Logs: ${{topicName}} (live)`;
             content.innerHTML = '<p style="color: var(--text-secondary);">Loading logs...</p>';
             panel.classList.add('open');
 
+            function render(logs) {{
+                if (logs.length > 0) {{
+                    const wasScrolledToBottom = content.scrollHeight - content.scrollTop <= content.clientHeight + 50;
+
+                    content.innerHTML = logs.slice(-100).map(log => {{
+                        // Convert log type to topic-centric description
+                        let operation = log.log_type;
+                        if (log.log_type === 'Publish') {{
+                            operation = 'Write';
+                        }} else if (log.log_type === 'Subscribe') {{
+                            operation = 'Read';
+                        }} else if (log.log_type === 'TopicMap') {{
+                            operation = 'Map';
+                        }} else if (log.log_type === 'TopicUnmap') {{
+                            operation = 'Unmap';
+                        }}
+
+                        return `
+                        <div class="log-entry">
+                            <div class="log-entry-header">
+                                <span class="log-timestamp">${{log.timestamp}}</span>
+                                <span class="log-type log-type-${{log.log_type.toLowerCase()}}">${{operation}}</span>
+                            </div>
+                            <div style="color: var(--accent); font-size: 0.85rem; font-weight: 500;">by ${{log.node_name}}</div>
+                            <div class="log-message">${{log.message}}</div>
+                            ${{log.ipc_ns > 0 ? `<div style="color: var(--text-tertiary); font-size: 0.7rem; margin-top: 0.5rem;">
+                                Tick: ${{log.tick_us}}μs | IPC: ${{log.ipc_ns}}ns
+                            </div>` : ''}}
+                        </div>
+                    `;
+                    }}).join('');
+
+                    if (wasScrolledToBottom) {{
+                        content.scrollTop = content.scrollHeight;
+                    }}
+                }} else {{
+                    content.innerHTML = '<p style="color: var(--text-secondary);">No logs found for this topic</p>';
+                }}
+            }}
+            currentLogView.render = render;
+
             async function updateLogs() {{
                 // Guard: Only update if this is still the active view
                 if (currentLogView.type !== 'topic' || currentLogView.name !== topicName) {{
@@ -4297,62 +4296,66 @@ fn generate_html(port: u16) -> String {
                         return; // View changed during fetch
                     }}
 
-                    if (data.logs && data.logs.length > 0) {{
-                        const wasScrolledToBottom = content.scrollHeight - content.scrollTop <= content.clientHeight + 50;
-
-                        content.innerHTML = data.logs.slice(-100).map(log => {{
-                            // Convert log type to topic-centric description
-                            let operation = log.log_type;
-                            if (log.log_type === 'Publish') {{
-                                operation = 'Write';
-                            }} else if (log.log_type === 'Subscribe') {{
-                                operation = 'Read';
-                            }} else if (log.log_type === 'TopicMap') {{
-                                operation = 'Map';
-                            }} else if (log.log_type === 'TopicUnmap') {{
-                                operation = 'Unmap';
-                            }}
-
-                            return `
-                            <div class="log-entry">
-                                <div class="log-entry-header">
-                                    <span class="log-timestamp">${{log.timestamp}}</span>
-                                    <span class="log-type log-type-${{log.log_type.toLowerCase()}}">${{operation}}</span>
-                                </div>
-                                <div style="color: var(--accent); font-size: 0.85rem; font-weight: 500;">by ${{log.node_name}}</div>
-                                <div class="log-message">${{log.message}}</div>
-                                ${{log.ipc_ns > 0 ? `<div style="color: var(--text-tertiary); font-size: 0.7rem; margin-top: 0.5rem;">
-                                    Tick: ${{log.tick_us}}μs | IPC: ${{log.ipc_ns}}ns
-                                </div>` : ''}}
-                            </div>
-                        `;
-                        }}).join('');
-
-                        if (wasScrolledToBottom) {{
-                            content.scrollTop = content.scrollHeight;
-                        }}
-                    }} else {{
-                        content.innerHTML = '<p style="color: var(--text-secondary);">No logs found for this topic</p>';
-                    }}
+                    render(data.logs || []);
                 }} catch (error) {{
                     content.innerHTML = `<p style="color: #ff4444;">Error loading logs: ${{error.message}}</p>`;
                 }}
             }}
 
-            await updateLogs();
-            // Update logs every 200ms (5 times per second) - reasonable balance
-            currentLogView.interval = setInterval(updateLogs, 200);
+            // Live records are pushed over the WebSocket; poll only without it
+            currentLogView.poll = updateLogs;
+            if (wsConnected) {{
+                subscribeLogs();
+            }} else {{
+                await updateLogs();
+                currentLogView.interval = setInterval(updateLogs, 1000);
+            }}
         }}
 
         function closeLogPanel() {{
             // Stop auto-updates when panel closes
             if (currentLogView.interval) {{
-                cancelAnimationFrame(currentLogView.interval);
-                currentLogView = {{ type: null, name: null, interval: null }};
+                clearInterval(currentLogView.interval);
+            }}
+            if (ws && ws.readyState === WebSocket.OPEN) {{
+                ws.send(JSON.stringify({{ type: 'unsubscribe_logs' }}));
             }}
+            currentLogView = {{ type: null, name: null, interval: null }};
             document.getElementById('log-panel').classList.remove('open');
         }}
 
+        // Ask the server to push the open view's log records
+        function subscribeLogs() {{
+            if (!ws || ws.readyState !== WebSocket.OPEN || !currentLogView.type) {{
+                return;
+            }}
+            if (currentLogView.interval) {{
+                clearInterval(currentLogView.interval);
+                currentLogView.interval = null;
+            }}
+            ws.send(JSON.stringify({{ type: 'subscribe_logs', [currentLogView.type]: currentLogView.name }}));
+        }}
+
+        // Merge a pushed backlog (reset) or delta into the open log view
+        function applyLogs(update) {{
+            const view = update.view || {{}};
+            const name = currentLogView.type === 'topic'
+                ? String(currentLogView.name).replace(/^horus_/, '')
+                : currentLogView.name;
+            if (!currentLogView.render || view[currentLogView.type] !== name) {{
+                return; // Still in flight for a view that was closed or switched
+            }}
+            if (update.reset) {{
+                currentLogView.logs = update.logs;
+            }} else if (update.to > currentLogView.to) {{
+                currentLogView.logs = currentLogView.logs.concat(update.logs).slice(-100);
+            }} else {{
+                return; // Already part of the backlog
+            }}
+            currentLogView.to = update.to;
+            currentLogView.render(currentLogView.logs);
+        }}
+
         // WebSocket connection for real-time updates
         let ws = null;
         let wsConnected = false;
@@ -4373,6 +4376,9 @@ fn generate_html(port: u16) -> String {
                     clearInterval(pollingInterval);
                     pollingInterval = null;
                 }}
+
+                // Resume pushes for a log view left open across a reconnect
+                subscribeLogs();
             }};
 
             ws.onmessage = (event) => {{
@@ -4485,6 +4491,8 @@ fn generate_html(port: u16) -> String {
                         updateStatus();
                         updateNodesToolTip();
                         updateTopicsToolTip();
+                    }} else if (update.type === 'logs') {{
+                        applyLogs(update);
                     }}
                 }} catch (error) {{
                     console.error('WebSocket message parse error:', error);
@@ -4505,6 +4513,11 @@ fn generate_html(port: u16) -> String {
                     pollingInterval = setInterval(updateAll, 1000);
                 }}
 
+                // Keep an open log view updating by polling
+                if (currentLogView.poll && !currentLogView.interval) {{
+                    currentLogView.interval = setInterval(currentLogView.poll, 1000);
+                }}
+
                 // Try to reconnect after 5 seconds
                 setTimeout(connectWebSocket, 5000);
             }};
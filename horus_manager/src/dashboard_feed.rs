@@ -0,0 +1,456 @@
+//! Shared live feed behind the dashboard WebSocket
+//!
+//! One reader serves every connected browser. It polls the shared log ring
+//! with a cursor, so each push decodes only the records written since the
+//! previous one, and rebuilds the node/topic/graph snapshot on a fixed
+//! interval. Both are serialized once and broadcast; each client task only
+//! filters the log deltas down to the view it has open. When no client is
+//! connected the feed does no work at all.
+//!
+//! Pushes are rate limited (`LOG_PUSH_INTERVAL`), and a topic that logs
+//! faster than `MAX_RECORDS_PER_TOPIC` per push is downsampled to its newest
+//! records, with the rest counted in `suppressed`.
+
+use horus_core::core::log_buffer::{LogCursor, LogEntry, GLOBAL_LOG_BUFFER};
+use std::collections::{HashMap, HashSet, VecDeque};
+use std::sync::{Arc, OnceLock, RwLock};
+use std::time::Duration;
+use tokio::sync::broadcast;
+
+/// How often new log records are pushed to clients
+const LOG_PUSH_INTERVAL: Duration = Duration::from_millis(100);
+
+/// How often the node/topic/graph snapshot is rebuilt
+const SNAPSHOT_INTERVAL: Duration = Duration::from_millis(250);
+
+/// Records decoded per push; a burst larger than this is caught up over
+/// the next pushes
+const MAX_RECORDS_PER_PUSH: usize = 2048;
+
+/// Records of one topic kept per push, newest first
+const MAX_RECORDS_PER_TOPIC: usize = 20;
+
+/// Recent records kept to fill a newly opened log view
+const HISTORY_LEN: usize = 4096;
+
+/// Records sent when a log view is opened
+const BACKLOG_LEN: usize = 100;
+
+/// Events a slow client may fall behind before it has to resync
+const CHANNEL_CAPACITY: usize = 64;
+
+/// Something every connected client receives
+#[derive(Clone)]
+pub enum FeedEvent {
+    /// Pre-serialized `{"type": "update", ...}` message
+    Snapshot(Arc<str>),
+    /// New log records since the previous delta
+    Logs(Arc<LogDelta>),
+}
+
+/// Log records at ring positions `from..to`, after downsampling
+#[derive(Debug, Default)]
+pub struct LogDelta {
+    pub from: u64,
+    pub to: u64,
+    /// Records overwritten in the ring before the feed could read them
+    pub missed: u64,
+    pub entries: Vec<LogEntry>,
+    /// Records dropped per topic by downsampling
+    pub suppressed: HashMap<String, u64>,
+}
+
+impl LogDelta {
+    /// `{"type": "logs", ...}` with the entries `filter` selects, or None if
+    /// this delta has nothing for that view
+    pub fn to_message(&self, filter: &LogFilter) -> Option<String> {
+        let logs: Vec<&LogEntry> = self.entries.iter().filter(|e| filter.matches(e)).collect();
+        let suppressed = match filter {
+            LogFilter::Topic(topic) => self.suppressed.get(topic).copied().unwrap_or(0),
+            LogFilter::Node(_) | LogFilter::None => 0,
+        };
+        if logs.is_empty() && suppressed == 0 {
+            return None;
+        }
+        Some(
+            serde_json::json!({
+                "type": "logs",
+                "view": filter.view(),
+                "from": self.from,
+                "to": self.to,
+                "missed": self.missed,
+                "suppressed": suppressed,
+                "logs": logs,
+            })
+            .to_string(),
+        )
+    }
+}
+
+/// Log view a client has open
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub enum LogFilter {
+    None,
+    Node(String),
+    Topic(String),
+}
+
+impl LogFilter {
+    /// Parse a client request: `{"type": "subscribe_logs", "node": ...}`,
+    /// `{"type": "subscribe_logs", "topic": ...}` or
+    /// `{"type": "unsubscribe_logs"}`
+    pub fn from_request(text: &str) -> Option<Self> {
+        let request: serde_json::Value = serde_json::from_str(text).ok()?;
+        match request.get("type")?.as_str()? {
+            "subscribe_logs" => {
+                if let Some(node) = request.get("node").and_then(|v| v.as_str()) {
+                    Some(LogFilter::Node(node.to_string()))
+                } else {
+                    // Topic names use dot notation - just strip horus_ prefix
+                    let topic = request.get("topic")?.as_str()?;
+                    let topic = topic.strip_prefix("horus_").unwrap_or(topic);
+                    Some(LogFilter::Topic(topic.to_string()))
+                }
+            }
+            "unsubscribe_logs" => Some(LogFilter::None),
+            _ => None,
+        }
+    }
+
+    fn matches(&self, entry: &LogEntry) -> bool {
+        match self {
+            LogFilter::None => false,
+            LogFilter::Node(node) => entry.node_name == *node,
+            LogFilter::Topic(topic) => entry.topic.as_deref() == Some(topic.as_str()),
+        }
+    }
+
+    fn view(&self) -> serde_json::Value {
+        match self {
+            LogFilter::None => serde_json::Value::Null,
+            LogFilter::Node(node) => serde_json::json!({ "node": node }),
+            LogFilter::Topic(topic) => serde_json::json!({ "topic": topic }),
+        }
+    }
+}
+
+/// Latest snapshot and recent records, guarded together with the broadcast
+/// so a backlog and the deltas after it never overlap or leave a gap
+#[derive(Default)]
+struct FeedState {
+    snapshot: Option<Arc<str>>,
+    history: VecDeque<LogEntry>,
+    delivered: u64,
+}
+
+/// Shared reader; see the module docs
+pub struct LiveFeed {
+    events: broadcast::Sender<FeedEvent>,
+    state: RwLock<FeedState>,
+}
+
+/// The process-wide feed, started on first use
+///
+/// Must first be called from within the Tokio runtime.
+pub fn live_feed() -> &'static LiveFeed {
+    static FEED: OnceLock<&'static LiveFeed> = OnceLock::new();
+    FEED.get_or_init(|| {
+        let (events, _) = broadcast::channel(CHANNEL_CAPACITY);
+        let feed: &'static LiveFeed = Box::leak(Box::new(LiveFeed {
+            events,
+            state: RwLock::new(FeedState::default()),
+        }));
+
+        std::thread::Builder::new()
+            .name("dashboard-log-feed".to_string())
+            .spawn(move || feed.run_log_reader())
+            .expect("failed to spawn dashboard log feed");
+        tokio::spawn(feed.run_snapshots());
+
+        feed
+    })
+}
+
+impl LiveFeed {
+    pub fn subscribe(&self) -> broadcast::Receiver<FeedEvent> {
+        self.events.subscribe()
+    }
+
+    /// Most recent snapshot, sent to clients as soon as they connect
+    pub fn latest_snapshot(&self) -> Option<Arc<str>> {
+        self.state.read().ok()?.snapshot.clone()
+    }
+
+    /// `{"type": "logs", "reset": true, ...}` with the newest records for a
+    /// newly opened view
+    ///
+    /// `to` is the end of what has been broadcast so far; the client drops
+    /// deltas that end at or before it.
+    pub fn backlog_message(&self, filter: &LogFilter) -> String {
+        let state = self.state.read().unwrap_or_else(|e| e.into_inner());
+        let mut logs: Vec<&LogEntry> = state
+            .history
+            .iter()
+            .rev()
+            .filter(|e| filter.matches(e))
+            .take(BACKLOG_LEN)
+            .collect();
+        logs.reverse();
+        serde_json::json!({
+            "type": "logs",
+            "reset": true,
+            "view": filter.view(),
+            "to": state.delivered,
+            "logs": logs,
+        })
+        .to_string()
+    }
+
+    fn run_log_reader(&self) {
+        let mut cursor = LogCursor::new();
+        let mut missed = 0;
+        loop {
+            std::thread::sleep(LOG_PUSH_INTERVAL);
+            // Nobody watching: leave the cursor where it is, a returning
+            // client catches up on whatever the ring still holds
+            if self.events.receiver_count() == 0 {
+                continue;
+            }
+
+            let from = cursor.position();
+            let entries = GLOBAL_LOG_BUFFER.read_since(&mut cursor, MAX_RECORDS_PER_PUSH);
+            if entries.is_empty() {
+                continue;
+            }
+
+            let mut state = self.state.write().unwrap_or_else(|e| e.into_inner());
+            state.history.extend(entries.iter().cloned());
+            let excess = state.history.len().saturating_sub(HISTORY_LEN);
+            state.history.drain(..excess);
+            state.delivered = cursor.position();
+
+            let (entries, suppressed) = downsample(entries, MAX_RECORDS_PER_TOPIC);
+            let delta = LogDelta {
+                from,
+                to: cursor.position(),
+                missed: cursor.missed() - missed,
+                entries,
+                suppressed,
+            };
+            missed = cursor.missed();
+            let _ = self.events.send(FeedEvent::Logs(Arc::new(delta)));
+        }
+    }
+
+    async fn run_snapshots(&'static self) {
+        let mut interval = tokio::time::interval(SNAPSHOT_INTERVAL);
+        interval.set_missed_tick_behavior(tokio::time::MissedTickBehavior::Skip);
+        loop {
+            interval.tick().await;
+            if self.events.receiver_count() == 0 {
+                continue;
+            }
+
+            let snapshot: Arc<str> = build_snapshot().await.to_string().into();
+            if let Ok(mut state) = self.state.write() {
+                state.snapshot = Some(snapshot.clone());
+            }
+            let _ = self.events.send(FeedEvent::Snapshot(snapshot));
+        }
+    }
+}
+
+/// Keep at most `per_topic` of the newest records of each topic, counting
+/// the dropped ones; records without a topic are always kept
+fn downsample(entries: Vec<LogEntry>, per_topic: usize) -> (Vec<LogEntry>, HashMap<String, u64>) {
+    let mut kept_per_topic: HashMap<&str, usize> = HashMap::new();
+    let mut dropped = HashSet::new();
+    for (i, entry) in entries.iter().enumerate().rev() {
+        if let Some(topic) = entry.topic.as_deref() {
+            let kept = kept_per_topic.entry(topic).or_default();
+            if *kept == per_topic {
+                dropped.insert(i);
+            } else {
+                *kept += 1;
+            }
+        }
+    }
+    if dropped.is_empty() {
+        return (entries, HashMap::new());
+    }
+
+    let mut suppressed = HashMap::new();
+    let mut kept = Vec::with_capacity(entries.len() - dropped.len());
+    for (i, entry) in entries.into_iter().enumerate() {
+        if dropped.contains(&i) {
+            if let Some(topic) = entry.topic {
+                *suppressed.entry(topic).or_insert(0) += 1;
+            }
+        } else {
+            kept.push(entry);
+        }
+    }
+    (kept, suppressed)
+}
+
+/// Nodes, topics and graph as a `{"type": "update", ...}` message
+async fn build_snapshot() -> serde_json::Value {
+    // Gather all data in parallel
+    let (nodes_result, topics_result, graph_result) = tokio::join!(
+        tokio::task::spawn_blocking(|| {
+            crate::commands::monitor::discover_nodes()
+                .unwrap_or_default()
+                .into_iter()
+                .map(|n| {
+                    serde_json::json!({
+                        "name": n.name,
+                        "pid": n.process_id,
+                        "status": n.status,
+                        "health": n.health.as_str(),
+                        "health_color": n.health.color(),
+                        "cpu": format!("{:.1}%", n.cpu_usage),
+                        "memory": format!("{} MB", n.memory_usage / 1024 / 1024),
+                        "scheduler_name": n.scheduler_name,
+                    })
+                })
+                .collect::<Vec<_>>()
+        }),
+        tokio::task::spawn_blocking(|| {
+            crate::commands::monitor::discover_shared_memory()
+                .unwrap_or_default()
+                .into_iter()
+                .map(|t| {
+                    serde_json::json!({
+                        "name": t.topic_name,
+                        "size": format!("{} KB", t.size_bytes / 1024),
+                        "active": t.active,
+                        "processes": t.accessing_processes.len(),
+                    })
+                })
+                .collect::<Vec<_>>()
+        }),
+        tokio::task::spawn_blocking(crate::graph::discover_graph_data)
+    );
+
+    // Unwrap results
+    let nodes = nodes_result.unwrap_or_default();
+    let topics = topics_result.unwrap_or_default();
+    let (graph_nodes, graph_edges) = graph_result.unwrap_or_default();
+
+    // Convert graph data
+    let graph_nodes_json = graph_nodes
+        .into_iter()
+        .map(|n| {
+            serde_json::json!({
+                "id": n.id,
+                "label": n.label,
+                "type": match n.node_type {
+                    crate::graph::NodeType::Process => "process",
+                    crate::graph::NodeType::Topic => "topic",
+                },
+                "pid": n.pid,
+                "active": n.active,
+            })
+        })
+        .collect::<Vec<_>>();
+
+    let graph_edges_json = graph_edges
+        .into_iter()
+        .map(|e| {
+            serde_json::json!({
+                "from": e.from,
+                "to": e.to,
+                "type": match e.edge_type {
+                    crate::graph::EdgeType::Publish => "publish",
+                    crate::graph::EdgeType::Subscribe => "subscribe",
+                },
+                "active": e.active,
+            })
+        })
+        .collect::<Vec<_>>();
+
+    serde_json::json!({
+        "type": "update",
+        "timestamp": chrono::Utc::now().to_rfc3339(),
+        "data": {
+            "nodes": nodes,
+            "topics": topics,
+            "graph": {
+                "nodes": graph_nodes_json,
+                "edges": graph_edges_json
+            }
+        }
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use horus_core::core::log_buffer::LogType;
+
+    fn entry(node: &str, topic: Option<&str>, tick: u64) -> LogEntry {
+        LogEntry {
+            timestamp: String::new(),
+            tick_number: tick,
+            node_name: node.to_string(),
+            log_type: LogType::Publish,
+            topic: topic.map(str::to_string),
+            message: String::new(),
+            tick_us: 0,
+            ipc_ns: 0,
+        }
+    }
+
+    #[test]
+    fn test_downsample_keeps_newest_per_topic() {
+        let mut entries = Vec::new();
+        for tick in 0..50 {
+            entries.push(entry("imu", Some("imu/raw"), tick));
+        }
+        entries.push(entry("planner", None, 50));
+        entries.push(entry("planner", Some("plan"), 51));
+
+        let (kept, suppressed) = downsample(entries, 20);
+        assert_eq!(kept.len(), 22);
+        assert_eq!(kept[0].tick_number, 30);
+        assert_eq!(kept.last().unwrap().tick_number, 51);
+        assert_eq!(suppressed.get("imu/raw"), Some(&30));
+        assert_eq!(suppressed.get("plan"), None);
+    }
+
+    #[test]
+    fn test_filter_requests_and_delta_messages() {
+        assert_eq!(
+            LogFilter::from_request(r#"{"type":"subscribe_logs","node":"imu"}"#),
+            Some(LogFilter::Node("imu".to_string()))
+        );
+        assert_eq!(
+            LogFilter::from_request(r#"{"type":"subscribe_logs","topic":"horus_imu.raw"}"#),
+            Some(LogFilter::Topic("imu.raw".to_string()))
+        );
+        assert_eq!(
+            LogFilter::from_request(r#"{"type":"unsubscribe_logs"}"#),
+            Some(LogFilter::None)
+        );
+        assert_eq!(LogFilter::from_request("not json"), None);
+
+        let delta = LogDelta {
+            from: 10,
+            to: 13,
+            entries: vec![entry("imu", Some("imu.raw"), 1), entry("planner", None, 2)],
+            ..LogDelta::default()
+        };
+        let message = delta
+            .to_message(&LogFilter::Node("planner".to_string()))
+            .unwrap();
+        let message: serde_json::Value = serde_json::from_str(&message).unwrap();
+        assert_eq!(message["to"], 13);
+        assert_eq!(message["logs"].as_array().unwrap().len(), 1);
+        assert_eq!(message["view"]["node"], "planner");
+
+        assert!(delta
+            .to_message(&LogFilter::Node("lidar".to_string()))
+            .is_none());
+        assert!(delta.to_message(&LogFilter::None).is_none());
+    }
+}
@@ -5,6 +5,7 @@
 pub mod commands;
 pub mod config;
 pub mod dashboard;
+pub mod dashboard_feed;
 pub mod dashboard_tui;
 pub mod dependency_resolver;
 pub mod graph;
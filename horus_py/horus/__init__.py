@@ -22,6 +22,10 @@ try:
         PyNode as _PyNode,
         PyNodeInfo as _NodeInfo,
         Hub,  # Type-based Hub with network support (exported as "Hub" from Rust)
+        ImageFrame,  # Zero-copy frames returned by Hub.image() and friends
+        DepthFrame,
+        PointCloudFrame,
+        BlobLoan,  # Shared-memory slot loaned for in-place writes
         Link,  # Point-to-point SPSC communication with network support
         RouterClient,  # Explicit router connection management
         RouterServer,  # Router server management
@@ -43,6 +47,7 @@ except ImportError:
     _PyNode = None
     _NodeInfo = None
     Hub = None  # Type-based Hub with network support
+    ImageFrame = DepthFrame = PointCloudFrame = BlobLoan = None
     Link = None  # Point-to-point SPSC communication
     RouterClient = None  # Router client management
     RouterServer = None  # Router server management
@@ -1135,6 +1140,10 @@ __all__ = [
     "Scheduler",
     "NodeState",
     "Hub",
+    "ImageFrame",
+    "DepthFrame",
+    "PointCloudFrame",
+    "BlobLoan",
     "Link",  # Point-to-point SPSC communication with network support
     "RouterClient",  # Explicit router connection management
     "RouterServer",  # Router server management
@@ -4,7 +4,9 @@ Type stubs for horus._horus module
 This file provides type hints for IDE autocomplete and static type checking.
 """
 
-from typing import Any, Dict, Optional
+from typing import Any, Dict, List, Optional, Union
+
+import numpy as np
 
 class PyNodeInfo:
     """
@@ -294,15 +296,86 @@ class PyHub:
         """
         ...
 
-    def recv(self) -> Optional[Any]:
+    def recv(self, node: Optional[Any] = None, timeout: Optional[float] = None) -> Optional[Any]:
         """
         Try to receive a message.
 
+        Args:
+            node: Optional Node for automatic logging
+            timeout: Optional seconds to wait for a message (GIL released)
+
         Returns:
-            Received message as bytes, or None if no messages available
+            Received message, or None if no messages available. Blob hubs
+            return ImageFrame, DepthFrame or PointCloudFrame.
+        """
+        ...
+
+    def wait(self, timeout: float) -> bool:
+        """
+        Block until a message is pending or timeout seconds pass.
+
+        The GIL is released while waiting.
+
+        Returns:
+            True if a message is ready for recv()
+        """
+        ...
+
+    @staticmethod
+    def image(
+        topic: str,
+        capacity: Optional[int] = None,
+        slot_size: Optional[int] = None,
+        slots: Optional[int] = None,
+    ) -> "PyHub":
+        """
+        Create a zero-copy image hub.
+
+        Pixels stay in the topic's shared-memory blob pool; only a small
+        handle travels through the topic.
+
+        Args:
+            topic: Topic name
+            capacity: Handles buffered in the topic (default: 4)
+            slot_size: Bytes per pool slot (default: size of the first loan)
+            slots: Pool slots (default: 2 * capacity)
+        """
+        ...
+
+    @staticmethod
+    def depth_image(
+        topic: str,
+        capacity: Optional[int] = None,
+        slot_size: Optional[int] = None,
+        slots: Optional[int] = None,
+    ) -> "PyHub":
+        """Create a zero-copy uint16 depth image hub (see image())."""
+        ...
+
+    @staticmethod
+    def point_cloud(
+        topic: str,
+        capacity: Optional[int] = None,
+        slot_size: Optional[int] = None,
+        slots: Optional[int] = None,
+    ) -> "PyHub":
+        """Create a zero-copy point cloud hub (see image())."""
+        ...
+
+    def loan_image(self, width: int, height: int, encoding: str = "rgb8") -> "BlobLoan":
+        """
+        Loan a pool slot for an image; fill loan.data and pass it to send().
         """
         ...
 
+    def loan_depth_image(self, width: int, height: int) -> "BlobLoan":
+        """Loan a pool slot for a (height, width) uint16 depth image."""
+        ...
+
+    def loan_point_cloud(self, points: int) -> "BlobLoan":
+        """Loan a pool slot for an (N, 3) float32 point cloud."""
+        ...
+
     def recv_with_metadata(self) -> Optional[tuple[Any, str, float]]:
         """
         Try to receive a message with metadata.
@@ -319,6 +392,69 @@ class PyHub:
         ...
 
 
+class ImageFrame:
+    """
+    Image received on a blob hub.
+
+    data is a read-only NumPy view of the publisher's shared-memory slot.
+    Copy it to keep pixels beyond the topic's retention depth.
+    """
+
+    width: int
+    height: int
+    encoding: str
+    step: int
+    frame_id: str
+    timestamp: int
+    data: np.ndarray
+
+
+class DepthFrame:
+    """Depth image received on a blob hub (data is a read-only uint16 view)."""
+
+    width: int
+    height: int
+    min_depth: int
+    max_depth: int
+    depth_scale: float
+    frame_id: str
+    timestamp: int
+    data: np.ndarray
+
+
+class PointCloudFrame:
+    """Point cloud received on a blob hub (data holds the raw point records)."""
+
+    width: int
+    height: int
+    point_step: int
+    is_dense: bool
+    fields: List[str]
+    frame_id: str
+    timestamp: int
+    data: np.ndarray
+
+    def xyz(self) -> np.ndarray:
+        """Coordinates as a read-only (N, 3) float32 view."""
+        ...
+
+    def __len__(self) -> int: ...
+
+
+class BlobLoan:
+    """
+    Blob pool slot loaned for in-place writes.
+
+    Fill data, then pass the loan to Hub.send(). A loan can be sent once;
+    dropping it unsent returns the slot.
+    """
+
+    data: np.ndarray
+    frame_id: str
+    timestamp: int
+    sent: bool
+
+
 class PyScheduler:
     """
     Python wrapper for HORUS Scheduler.
@@ -0,0 +1,779 @@
+// Zero-copy image, depth and point cloud frames for Python
+//
+// Blob hubs (Hub.image / Hub.depth_image / Hub.point_cloud) carry the
+// fixed-layout handle messages; the pixels and points stay in the topic's
+// shared-memory blob pool. Received frames expose that memory directly as
+// read-only NumPy arrays, and loans let Python fill a pool slot in place:
+//
+//   hub = Hub.image("camera/rgb")
+//   loan = hub.loan_image(640, 480, "rgb8")
+//   loan.data[:] = frame            # writes straight into shared memory
+//   hub.send(loan)
+//
+//   frame = hub.recv(timeout=0.1)   # GIL released while waiting
+//   frame.data.shape                # (480, 640, 3), no copy
+
+use horus::memory::{BlobHandle, BlobView, OwnedBlobMut, ShmBlobPool};
+use horus_library::messages::perception::{DepthImageHandle, PointCloudHandle, PointFieldType};
+use horus_library::messages::vision::{ImageEncoding, ImageHandle};
+use numpy::ndarray::{ArrayViewD, IxDyn, ShapeBuilder};
+use numpy::{Element, PyArrayDescrMethods, PyArrayDyn, PyUntypedArray, PyUntypedArrayMethods};
+use pyo3::prelude::*;
+use pyo3::types::IntoPyDict;
+use std::sync::Arc;
+
+/// NumPy element type of a frame's data array
+#[derive(Clone, Copy, PartialEq, Eq)]
+pub(crate) enum Dtype {
+    U8,
+    U16,
+    F32,
+}
+
+impl Dtype {
+    fn size(self) -> usize {
+        match self {
+            Dtype::U8 => 1,
+            Dtype::U16 => 2,
+            Dtype::F32 => 4,
+        }
+    }
+
+    /// Element type of a NumPy array, if it is one a blob hub can carry
+    pub(crate) fn of(array: &Bound<'_, PyUntypedArray>) -> Option<Self> {
+        let py = array.py();
+        let dtype = array.dtype();
+        if dtype.is_equiv_to(&numpy::dtype_bound::<u8>(py)) {
+            Some(Dtype::U8)
+        } else if dtype.is_equiv_to(&numpy::dtype_bound::<u16>(py)) {
+            Some(Dtype::U16)
+        } else if dtype.is_equiv_to(&numpy::dtype_bound::<f32>(py)) {
+            Some(Dtype::F32)
+        } else {
+            None
+        }
+    }
+}
+
+/// Python name of an image encoding (as accepted by `loan_image`)
+pub(crate) fn encoding_name(encoding: ImageEncoding) -> &'static str {
+    match encoding {
+        ImageEncoding::Mono8 => "mono8",
+        ImageEncoding::Mono16 => "mono16",
+        ImageEncoding::Rgb8 => "rgb8",
+        ImageEncoding::Bgr8 => "bgr8",
+        ImageEncoding::Rgba8 => "rgba8",
+        ImageEncoding::Bgra8 => "bgra8",
+        ImageEncoding::Yuv422 => "yuv422",
+        ImageEncoding::Mono32F => "mono32f",
+        ImageEncoding::Rgb32F => "rgb32f",
+        ImageEncoding::BayerRggb8 => "bayer_rggb8",
+        ImageEncoding::Depth16 => "depth16",
+    }
+}
+
+/// Parse an encoding name (case-insensitive)
+pub(crate) fn parse_encoding(name: &str) -> PyResult<ImageEncoding> {
+    let encoding = match name.to_ascii_lowercase().as_str() {
+        "mono8" | "gray" | "grey" => ImageEncoding::Mono8,
+        "mono16" => ImageEncoding::Mono16,
+        "rgb8" | "rgb" => ImageEncoding::Rgb8,
+        "bgr8" | "bgr" => ImageEncoding::Bgr8,
+        "rgba8" | "rgba" => ImageEncoding::Rgba8,
+        "bgra8" | "bgra" => ImageEncoding::Bgra8,
+        "yuv422" => ImageEncoding::Yuv422,
+        "mono32f" => ImageEncoding::Mono32F,
+        "rgb32f" => ImageEncoding::Rgb32F,
+        "bayer_rggb8" => ImageEncoding::BayerRggb8,
+        "depth16" => ImageEncoding::Depth16,
+        _ => {
+            return Err(pyo3::exceptions::PyValueError::new_err(format!(
+                "Unknown image encoding '{}'",
+                name
+            )))
+        }
+    };
+    Ok(encoding)
+}
+
+/// (channels, dtype) of an encoding's NumPy layout
+pub(crate) fn pixel_layout(encoding: ImageEncoding) -> (usize, Dtype) {
+    match encoding {
+        ImageEncoding::Mono8 | ImageEncoding::BayerRggb8 => (1, Dtype::U8),
+        ImageEncoding::Mono16 | ImageEncoding::Depth16 => (1, Dtype::U16),
+        ImageEncoding::Rgb8 | ImageEncoding::Bgr8 => (3, Dtype::U8),
+        ImageEncoding::Rgba8 | ImageEncoding::Bgra8 => (4, Dtype::U8),
+        ImageEncoding::Yuv422 => (2, Dtype::U8),
+        ImageEncoding::Mono32F => (1, Dtype::F32),
+        ImageEncoding::Rgb32F => (3, Dtype::F32),
+    }
+}
+
+/// Encoding implied by an array's shape and dtype (for `Hub.send(ndarray)`)
+pub(crate) fn infer_encoding(shape: &[usize], dtype: Dtype) -> Option<ImageEncoding> {
+    let channels = match shape.len() {
+        2 => 1,
+        3 => shape[2],
+        _ => return None,
+    };
+    match (channels, dtype) {
+        (1, Dtype::U8) => Some(ImageEncoding::Mono8),
+        (3, Dtype::U8) => Some(ImageEncoding::Rgb8),
+        (4, Dtype::U8) => Some(ImageEncoding::Rgba8),
+        (1, Dtype::U16) => Some(ImageEncoding::Mono16),
+        (1, Dtype::F32) => Some(ImageEncoding::Mono32F),
+        (3, Dtype::F32) => Some(ImageEncoding::Rgb32F),
+        _ => None,
+    }
+}
+
+/// Image shape as NumPy sees it: (height, width[, channels])
+fn image_shape(height: u32, width: u32, channels: usize) -> Vec<usize> {
+    let mut shape = vec![height as usize, width as usize];
+    if channels > 1 {
+        shape.push(channels);
+    }
+    shape
+}
+
+/// Contiguous strides (in bytes) for `shape`, with rows `row_bytes` apart
+fn image_strides(shape: &[usize], row_bytes: usize, dtype: Dtype) -> Vec<usize> {
+    let mut strides = vec![row_bytes, shape.get(2).copied().unwrap_or(1) * dtype.size()];
+    if shape.len() > 2 {
+        strides.push(dtype.size());
+    }
+    strides
+}
+
+fn frame_id_str(frame_id: &[u8; 32]) -> String {
+    let end = frame_id.iter().position(|&b| b == 0).unwrap_or(32);
+    String::from_utf8_lossy(&frame_id[..end]).into_owned()
+}
+
+fn set_frame_id(dst: &mut [u8; 32], frame_id: &str) {
+    let bytes = frame_id.as_bytes();
+    let len = bytes.len().min(31);
+    dst[..len].copy_from_slice(&bytes[..len]);
+    dst[len..].fill(0);
+}
+
+/// Wrap shared memory as a NumPy array whose base object is `base`
+///
+/// `strides` are in bytes and must be multiples of the element size.
+///
+/// # Safety
+/// `ptr` must point to memory covering `shape`/`strides` that stays mapped
+/// for as long as `base` is alive.
+unsafe fn borrow_array<'py, T: Element>(
+    py: Python<'py>,
+    ptr: *const u8,
+    shape: &[usize],
+    strides: &[usize],
+    base: Bound<'py, PyAny>,
+    writable: bool,
+) -> PyResult<Bound<'py, PyAny>> {
+    let elem = std::mem::size_of::<T>();
+    if ptr as usize % elem != 0 || strides.iter().any(|s| s % elem != 0) {
+        return Err(pyo3::exceptions::PyValueError::new_err(
+            "Blob layout is not aligned to its element type",
+        ));
+    }
+    let strides: Vec<usize> = strides.iter().map(|s| s / elem).collect();
+    let view = ArrayViewD::from_shape_ptr(IxDyn(shape).strides(IxDyn(&strides)), ptr as *const T);
+    let array = PyArrayDyn::borrow_from_array_bound(&view, base).into_any();
+    if !writable {
+        array.call_method(
+            "setflags",
+            (),
+            Some(&[("write", false)].into_py_dict_bound(py)),
+        )?;
+    }
+    Ok(array)
+}
+
+/// Dispatch `borrow_array` on a runtime dtype
+unsafe fn borrow_array_of<'py>(
+    py: Python<'py>,
+    dtype: Dtype,
+    ptr: *const u8,
+    shape: &[usize],
+    strides: &[usize],
+    base: Bound<'py, PyAny>,
+    writable: bool,
+) -> PyResult<Bound<'py, PyAny>> {
+    match dtype {
+        Dtype::U8 => borrow_array::<u8>(py, ptr, shape, strides, base, writable),
+        Dtype::U16 => borrow_array::<u16>(py, ptr, shape, strides, base, writable),
+        Dtype::F32 => borrow_array::<f32>(py, ptr, shape, strides, base, writable),
+    }
+}
+
+/// Bytes needed for `shape`/`strides` starting at the first element
+fn span(shape: &[usize], strides: &[usize], elem: usize) -> usize {
+    if shape.iter().any(|&d| d == 0) {
+        return 0;
+    }
+    shape
+        .iter()
+        .zip(strides)
+        .map(|(d, s)| (d - 1) * s)
+        .sum::<usize>()
+        + elem
+}
+
+/// Keeps a received blob slot alive while NumPy arrays point into it
+#[pyclass(name = "BlobBuffer", frozen)]
+pub struct BlobBuffer {
+    view: BlobView,
+}
+
+#[pymethods]
+impl BlobBuffer {
+    fn __len__(&self) -> usize {
+        self.view.len()
+    }
+}
+
+/// Read-only array over a received slot; rejects layouts larger than the payload
+fn view_array<'py>(
+    py: Python<'py>,
+    view: BlobView,
+    dtype: Dtype,
+    shape: &[usize],
+    strides: &[usize],
+) -> PyResult<Bound<'py, PyAny>> {
+    if span(shape, strides, dtype.size()) > view.len() {
+        return Err(pyo3::exceptions::PyValueError::new_err(format!(
+            "Blob of {} bytes is smaller than its advertised layout {:?}",
+            view.len(),
+            shape
+        )));
+    }
+    let ptr = view.as_slice().as_ptr();
+    let base = Bound::new(py, BlobBuffer { view })?.into_any();
+    // SAFETY: the BlobBuffer base holds a reference on the slot (and the pool
+    // mapping) for as long as the array exists
+    unsafe { borrow_array_of(py, dtype, ptr, shape, strides, base, false) }
+}
+
+/// A received image: metadata plus pixels in shared memory
+///
+/// `data` is a read-only NumPy array of shape (height, width[, channels])
+/// backed directly by the publisher's blob slot. Call `data.copy()` to keep
+/// the pixels beyond the topic's retention depth.
+#[pyclass(name = "ImageFrame")]
+pub struct ImageFrame {
+    handle: ImageHandle,
+    data: PyObject,
+}
+
+impl ImageFrame {
+    pub(crate) fn new(py: Python, handle: ImageHandle, view: BlobView) -> PyResult<Self> {
+        let (channels, dtype) = pixel_layout(handle.encoding);
+        let shape = image_shape(handle.height, handle.width, channels);
+        let strides = image_strides(&shape, handle.step as usize, dtype);
+        let data = view_array(py, view, dtype, &shape, &strides)?.unbind();
+        Ok(Self { handle, data })
+    }
+}
+
+#[pymethods]
+impl ImageFrame {
+    #[getter]
+    fn width(&self) -> u32 {
+        self.handle.width
+    }
+
+    #[getter]
+    fn height(&self) -> u32 {
+        self.handle.height
+    }
+
+    #[getter]
+    fn encoding(&self) -> &'static str {
+        encoding_name(self.handle.encoding)
+    }
+
+    /// Bytes per row (may include padding)
+    #[getter]
+    fn step(&self) -> u32 {
+        self.handle.step
+    }
+
+    #[getter]
+    fn frame_id(&self) -> String {
+        frame_id_str(&self.handle.frame_id)
+    }
+
+    /// Timestamp in nanoseconds since epoch
+    #[getter]
+    fn timestamp(&self) -> u64 {
+        self.handle.timestamp
+    }
+
+    /// Pixels as a read-only NumPy array (no copy)
+    #[getter]
+    fn data(&self, py: Python) -> PyObject {
+        self.data.clone_ref(py)
+    }
+
+    fn __repr__(&self) -> String {
+        format!(
+            "ImageFrame({}x{}, encoding='{}', frame_id='{}')",
+            self.handle.width,
+            self.handle.height,
+            self.encoding(),
+            self.frame_id()
+        )
+    }
+}
+
+/// A received depth image: metadata plus u16 depths in shared memory
+///
+/// `data` is a read-only (height, width) uint16 array; values are in units of
+/// `depth_scale` millimeters.
+#[pyclass(name = "DepthFrame")]
+pub struct DepthFrame {
+    handle: DepthImageHandle,
+    data: PyObject,
+}
+
+impl DepthFrame {
+    pub(crate) fn new(py: Python, handle: DepthImageHandle, view: BlobView) -> PyResult<Self> {
+        let shape = image_shape(handle.height, handle.width, 1);
+        let strides = image_strides(&shape, handle.width as usize * 2, Dtype::U16);
+        let data = view_array(py, view, Dtype::U16, &shape, &strides)?.unbind();
+        Ok(Self { handle, data })
+    }
+}
+
+#[pymethods]
+impl DepthFrame {
+    #[getter]
+    fn width(&self) -> u32 {
+        self.handle.width
+    }
+
+    #[getter]
+    fn height(&self) -> u32 {
+        self.handle.height
+    }
+
+    /// Minimum reliable depth value
+    #[getter]
+    fn min_depth(&self) -> u16 {
+        self.handle.min_depth
+    }
+
+    /// Maximum reliable depth value
+    #[getter]
+    fn max_depth(&self) -> u16 {
+        self.handle.max_depth
+    }
+
+    /// Millimeters per depth unit
+    #[getter]
+    fn depth_scale(&self) -> f32 {
+        self.handle.depth_scale
+    }
+
+    #[getter]
+    fn frame_id(&self) -> String {
+        frame_id_str(&self.handle.frame_id)
+    }
+
+    /// Timestamp in nanoseconds since epoch
+    #[getter]
+    fn timestamp(&self) -> u64 {
+        self.handle.timestamp
+    }
+
+    /// Depths as a read-only NumPy array (no copy)
+    #[getter]
+    fn data(&self, py: Python) -> PyObject {
+        self.data.clone_ref(py)
+    }
+
+    fn __repr__(&self) -> String {
+        format!(
+            "DepthFrame({}x{}, frame_id='{}')",
+            self.handle.width,
+            self.handle.height,
+            self.frame_id()
+        )
+    }
+}
+
+/// A received point cloud: layout plus point data in shared memory
+///
+/// `data` is a read-only (points, point_step) uint8 array of the raw point
+/// records; `xyz()` views the coordinates as an (N, 3) float32 array without
+/// copying when the cloud has consecutive float32 x/y/z fields.
+#[pyclass(name = "PointCloudFrame")]
+pub struct PointCloudFrame {
+    handle: PointCloudHandle,
+    data: PyObject,
+    view: BlobView,
+}
+
+impl PointCloudFrame {
+    pub(crate) fn new(py: Python, handle: PointCloudHandle, view: BlobView) -> PyResult<Self> {
+        let points = handle.width as usize * handle.height as usize;
+        let step = handle.point_step as usize;
+        let data = view_array(py, view.clone(), Dtype::U8, &[points, step], &[step, 1])?.unbind();
+        Ok(Self { handle, data, view })
+    }
+
+    fn field(&self, name: &str) -> Option<&horus_library::messages::perception::PointField> {
+        self.handle.fields[..self.handle.field_count as usize]
+            .iter()
+            .find(|f| f.name_str() == name)
+    }
+}
+
+#[pymethods]
+impl PointCloudFrame {
+    #[getter]
+    fn width(&self) -> u32 {
+        self.handle.width
+    }
+
+    #[getter]
+    fn height(&self) -> u32 {
+        self.handle.height
+    }
+
+    /// Number of points (width * height)
+    fn __len__(&self) -> usize {
+        self.handle.width as usize * self.handle.height as usize
+    }
+
+    /// Size of each point record in bytes
+    #[getter]
+    fn point_step(&self) -> u32 {
+        self.handle.point_step
+    }
+
+    #[getter]
+    fn is_dense(&self) -> bool {
+        self.handle.is_dense
+    }
+
+    /// Names of the fields in each point record
+    #[getter]
+    fn fields(&self) -> Vec<String> {
+        self.handle.fields[..self.handle.field_count as usize]
+            .iter()
+            .map(|f| f.name_str())
+            .collect()
+    }
+
+    #[getter]
+    fn frame_id(&self) -> String {
+        frame_id_str(&self.handle.frame_id)
+    }
+
+    /// Timestamp in nanoseconds since epoch
+    #[getter]
+    fn timestamp(&self) -> u64 {
+        self.handle.timestamp
+    }
+
+    /// Raw point records as a read-only NumPy array (no copy)
+    #[getter]
+    fn data(&self, py: Python) -> PyObject {
+        self.data.clone_ref(py)
+    }
+
+    /// Coordinates as a read-only (N, 3) float32 array (no copy)
+    ///
+    /// Raises ValueError if the cloud has no consecutive float32 x, y, z fields.
+    fn xyz<'py>(&self, py: Python<'py>) -> PyResult<Bound<'py, PyAny>> {
+        let layout = match (self.field("x"), self.field("y"), self.field("z")) {
+            (Some(x), Some(y), Some(z))
+                if [x, y, z]
+                    .iter()
+                    .all(|f| f.datatype == PointFieldType::Float32)
+                    && y.offset == x.offset + 4
+                    && z.offset == x.offset + 8 =>
+            {
+                Some(x.offset as usize)
+            }
+            _ => None,
+        };
+        let offset = layout.ok_or_else(|| {
+            pyo3::exceptions::PyValueError::new_err(
+                "Point cloud has no consecutive float32 x/y/z fields",
+            )
+        })?;
+
+        let points = self.__len__();
+        let step = self.handle.point_step as usize;
+        let shape = [points, 3];
+        let strides = [step, 4];
+        if offset + span(&shape, &strides, 4) > self.view.len() {
+            return Err(pyo3::exceptions::PyValueError::new_err(
+                "Point cloud blob is smaller than its advertised layout",
+            ));
+        }
+        let ptr = unsafe { self.view.as_slice().as_ptr().add(offset) };
+        let base = Bound::new(
+            py,
+            BlobBuffer {
+                view: self.view.clone(),
+            },
+        )?
+        .into_any();
+        // SAFETY: the base keeps the slot referenced; bounds checked above
+        unsafe { borrow_array::<f32>(py, ptr, &shape, &strides, base, false) }
+    }
+
+    fn __repr__(&self) -> String {
+        format!(
+            "PointCloudFrame({} points, fields={:?}, frame_id='{}')",
+            self.__len__(),
+            self.fields(),
+            self.frame_id()
+        )
+    }
+}
+
+/// Owns a loaned slot while Python writes into it
+///
+/// Base object of a loan's `data` array. Holds the pool so the mapping stays
+/// valid, and once the loan is published a view of the slot, so the slot is
+/// not recycled for another frame while the array is alive.
+#[pyclass(name = "LoanBuffer")]
+pub struct LoanBuffer {
+    blob: Option<OwnedBlobMut>,
+    _published: Option<BlobView>,
+    _pool: Arc<ShmBlobPool>,
+}
+
+/// What a loan will be published as
+#[derive(Clone, Copy)]
+pub(crate) enum LoanKind {
+    Image(ImageHandle),
+    Depth(DepthImageHandle),
+    PointCloud(PointCloudHandle),
+}
+
+/// A blob pool slot loaned to Python for in-place writes
+///
+/// Fill `data` (a writable NumPy array over shared memory) and pass the loan
+/// to `Hub.send()`; nothing is copied on publish. A loan can be sent once.
+/// Dropping it unsent returns the slot to the pool. Sending makes `data`
+/// read-only; it still shows the published frame for as long as it lives.
+/// Views taken from `data` before sending stay writable, so don't write
+/// through them afterwards.
+#[pyclass(name = "BlobLoan")]
+pub struct BlobLoan {
+    buffer: Py<LoanBuffer>,
+    data: PyObject,
+    pub(crate) kind: LoanKind,
+}
+
+impl BlobLoan {
+    /// Wrap an owned slot with a writable array of `shape`/`strides` (bytes)
+    pub(crate) fn new(
+        py: Python,
+        mut blob: OwnedBlobMut,
+        kind: LoanKind,
+        dtype: Dtype,
+        shape: &[usize],
+        strides: &[usize],
+    ) -> PyResult<Self> {
+        if span(shape, strides, dtype.size()) > blob.len() {
+            return Err(pyo3::exceptions::PyValueError::new_err(
+                "Loan is smaller than its layout",
+            ));
+        }
+        let ptr = blob.as_mut_ptr() as *const u8;
+        let pool = Arc::clone(blob.pool());
+        let buffer = Py::new(
+            py,
+            LoanBuffer {
+                blob: Some(blob),
+                _published: None,
+                _pool: pool,
+            },
+        )?;
+        // SAFETY: the LoanBuffer base keeps the pool mapped and the slot
+        // referenced; the array is writable only until the slot is published
+        let data = unsafe {
+            borrow_array_of(
+                py,
+                dtype,
+                ptr,
+                shape,
+                strides,
+                buffer.bind(py).clone().into_any(),
+                true,
+            )?
+        }
+        .unbind();
+        Ok(Self { buffer, data, kind })
+    }
+
+    /// The writable array over the slot
+    pub(crate) fn array<'py>(&self, py: Python<'py>) -> &Bound<'py, PyAny> {
+        self.data.bind(py)
+    }
+
+    /// Publish the slot and return its handle
+    ///
+    /// `data` becomes read-only and keeps the slot referenced from here on.
+    /// Fails if the loan was already sent.
+    pub(crate) fn publish(&self, py: Python) -> PyResult<BlobHandle> {
+        if self.buffer.borrow(py).blob.is_none() {
+            return Err(pyo3::exceptions::PyRuntimeError::new_err(
+                "BlobLoan was already sent",
+            ));
+        }
+        self.data
+            .bind(py)
+            .getattr("flags")?
+            .setattr("writeable", false)?;
+
+        let mut buffer = self.buffer.borrow_mut(py);
+        let blob = buffer.blob.take().expect("checked above");
+        let (handle, view) = blob.publish_with_view();
+        buffer._published = Some(view);
+        Ok(handle)
+    }
+}
+
+#[pymethods]
+impl BlobLoan {
+    /// Writable NumPy array over the loaned slot
+    #[getter]
+    fn data(&self, py: Python) -> PyObject {
+        self.data.clone_ref(py)
+    }
+
+    /// Frame ID carried in the published message
+    #[getter]
+    fn get_frame_id(&self) -> String {
+        match &self.kind {
+            LoanKind::Image(h) => frame_id_str(&h.frame_id),
+            LoanKind::Depth(h) => frame_id_str(&h.frame_id),
+            LoanKind::PointCloud(h) => frame_id_str(&h.frame_id),
+        }
+    }
+
+    #[setter]
+    fn set_frame_id(&mut self, frame_id: &str) {
+        match &mut self.kind {
+            LoanKind::Image(h) => set_frame_id(&mut h.frame_id, frame_id),
+            LoanKind::Depth(h) => set_frame_id(&mut h.frame_id, frame_id),
+            LoanKind::PointCloud(h) => set_frame_id(&mut h.frame_id, frame_id),
+        }
+    }
+
+    /// Timestamp in nanoseconds since epoch (set when the loan was created)
+    #[getter]
+    fn get_timestamp(&self) -> u64 {
+        match &self.kind {
+            LoanKind::Image(h) => h.timestamp,
+            LoanKind::Depth(h) => h.timestamp,
+            LoanKind::PointCloud(h) => h.timestamp,
+        }
+    }
+
+    #[setter]
+    fn set_timestamp(&mut self, timestamp: u64) {
+        match &mut self.kind {
+            LoanKind::Image(h) => h.timestamp = timestamp,
+            LoanKind::Depth(h) => h.timestamp = timestamp,
+            LoanKind::PointCloud(h) => h.timestamp = timestamp,
+        }
+    }
+
+    /// Whether the loan has already been sent
+    #[getter]
+    fn sent(&self, py: Python) -> bool {
+        self.buffer.borrow(py).blob.is_none()
+    }
+
+    fn __repr__(&self, py: Python) -> String {
+        let kind = match &self.kind {
+            LoanKind::Image(h) => format!(
+                "image {}x{} {}",
+                h.width,
+                h.height,
+                encoding_name(h.encoding)
+            ),
+            LoanKind::Depth(h) => format!("depth {}x{}", h.width, h.height),
+            LoanKind::PointCloud(h) => format!("point cloud {} points", h.width),
+        };
+        format!("BlobLoan({}, sent={})", kind, self.sent(py))
+    }
+}
+
+/// Loan an image slot shaped (height, width[, channels])
+pub(crate) fn loan_image(
+    py: Python,
+    pool: &Arc<ShmBlobPool>,
+    width: u32,
+    height: u32,
+    encoding: ImageEncoding,
+) -> PyResult<BlobLoan> {
+    let (channels, dtype) = pixel_layout(encoding);
+    let shape = image_shape(height, width, channels);
+    let step = width as usize * encoding.bytes_per_pixel() as usize;
+    let strides = image_strides(&shape, step, dtype);
+    let blob = loan_slot(pool, step * height as usize)?;
+    let handle = ImageHandle::new(width, height, encoding, Default::default());
+    BlobLoan::new(py, blob, LoanKind::Image(handle), dtype, &shape, &strides)
+}
+
+/// Loan a (height, width) uint16 depth slot
+pub(crate) fn loan_depth(
+    py: Python,
+    pool: &Arc<ShmBlobPool>,
+    width: u32,
+    height: u32,
+) -> PyResult<BlobLoan> {
+    let shape = image_shape(height, width, 1);
+    let strides = image_strides(&shape, width as usize * 2, Dtype::U16);
+    let blob = loan_slot(pool, width as usize * height as usize * 2)?;
+    let handle = DepthImageHandle::new(width, height, Default::default());
+    BlobLoan::new(
+        py,
+        blob,
+        LoanKind::Depth(handle),
+        Dtype::U16,
+        &shape,
+        &strides,
+    )
+}
+
+/// Loan an (N, 3) float32 XYZ point cloud slot
+pub(crate) fn loan_point_cloud(
+    py: Python,
+    pool: &Arc<ShmBlobPool>,
+    points: u32,
+) -> PyResult<BlobLoan> {
+    let blob = loan_slot(pool, points as usize * 12)?;
+    let handle = PointCloudHandle::xyz(points, Default::default());
+    BlobLoan::new(
+        py,
+        blob,
+        LoanKind::PointCloud(handle),
+        Dtype::F32,
+        &[points as usize, 3],
+        &[12, 4],
+    )
+}
+
+fn loan_slot(pool: &Arc<ShmBlobPool>, len: usize) -> PyResult<OwnedBlobMut> {
+    pool.loan_owned(len)
+        .map_err(|e| pyo3::exceptions::PyMemoryError::new_err(e.to_string()))
+}
+
+/// Array dtype as seen by the blob hubs
+pub(crate) fn array_dtype(array: &Bound<'_, PyUntypedArray>) -> PyResult<Dtype> {
+    Dtype::of(array).ok_or_else(|| {
+        pyo3::exceptions::PyTypeError::new_err("Blob hubs carry uint8, uint16 or float32 arrays")
+    })
+}
@@ -9,19 +9,137 @@
 //   hub = Hub(CmdVel, endpoint="cmdvel@localhost")         # Unix socket
 //   hub = Hub(CmdVel, endpoint="cmdvel@router")            # Via router
 //   hub = Hub(CmdVel, endpoint="cmdvel@*")                 # Multicast
+//
+// Zero-copy images, depth and point clouds (see blob.rs):
+//   hub = Hub.image("camera/rgb")                           # Handles + blob pool
+//   frame = hub.recv(timeout=0.1)                           # NumPy view of shm
 
-use horus::communication::hub::Hub;
+use crate::blob::{self, BlobLoan, DepthFrame, Dtype, ImageFrame, LoanKind, PointCloudFrame};
+use horus::communication::hub::{Hub, HubMetrics};
+use horus::memory::{BlobMessage, BlobView, ShmBlobPool};
 use horus_library::messages::cmd_vel::CmdVel;
 use horus_library::messages::geometry::Pose2D;
+use horus_library::messages::perception::{DepthImageHandle, PointCloudHandle};
+use horus_library::messages::vision::ImageHandle;
 use horus_library::messages::GenericMessage;
+use numpy::{PyUntypedArray, PyUntypedArrayMethods};
 use pyo3::prelude::*;
 use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
 
 /// Internal enum tracking which Rust type the Hub wraps
 enum HubType {
     CmdVel(Arc<Mutex<Hub<CmdVel>>>),
     Pose2D(Arc<Mutex<Hub<Pose2D>>>),
     Generic(Arc<Mutex<Hub<GenericMessage>>>),
+    Image(Arc<BlobHub<ImageHandle>>),
+    DepthImage(Arc<BlobHub<DepthImageHandle>>),
+    PointCloud(Arc<BlobHub<PointCloudHandle>>),
+}
+
+/// Handle-message Hub plus the blob pool its payloads live in
+///
+/// Publishers create the pool on their first loan; subscribers open it once
+/// the first handle arrives, taking the layout from the pool's header.
+struct BlobHub<T> {
+    hub: Hub<T>,
+    pool_name: String,
+    pool: Mutex<Option<Arc<ShmBlobPool>>>,
+    /// Slot size for a pool created here (0 = size of the first loan)
+    slot_size: usize,
+    slot_count: usize,
+    retain_depth: usize,
+}
+
+impl<T> BlobHub<T>
+where
+    T: Send
+        + Sync
+        + 'static
+        + Clone
+        + std::fmt::Debug
+        + serde::Serialize
+        + serde::de::DeserializeOwned
+        + horus::core::LogSummary
+        + BlobMessage,
+{
+    fn new(
+        topic: &str,
+        capacity: usize,
+        slot_size: Option<usize>,
+        slots: Option<usize>,
+    ) -> PyResult<Arc<Self>> {
+        let slot_count = slots.unwrap_or(capacity * 2);
+        if slot_count < 2 {
+            return Err(pyo3::exceptions::PyValueError::new_err(
+                "Blob hubs need at least 2 slots",
+            ));
+        }
+        let hub = Hub::<T>::new_with_capacity(topic, capacity).map_err(|e| {
+            pyo3::exceptions::PyRuntimeError::new_err(format!(
+                "Failed to create Hub for '{}': {}",
+                topic, e
+            ))
+        })?;
+        Ok(Arc::new(Self {
+            hub,
+            pool_name: ShmBlobPool::topic_pool_name(topic),
+            pool: Mutex::new(None),
+            slot_size: slot_size.unwrap_or(0),
+            slot_count,
+            retain_depth: capacity.min(slot_count - 1),
+        }))
+    }
+
+    /// Pool to loan from, created with this hub's layout if needed
+    fn writer_pool(&self, len: usize) -> PyResult<Arc<ShmBlobPool>> {
+        let mut pool = self.pool.lock().unwrap();
+        if let Some(pool) = pool.as_ref() {
+            return Ok(Arc::clone(pool));
+        }
+        let slot_size = if self.slot_size == 0 {
+            len
+        } else {
+            self.slot_size
+        };
+        let created = ShmBlobPool::new(
+            &self.pool_name,
+            slot_size,
+            self.slot_count,
+            self.retain_depth,
+        )
+        .map_err(|e| pyo3::exceptions::PyRuntimeError::new_err(e.to_string()))?;
+        *pool = Some(Arc::clone(&created));
+        Ok(created)
+    }
+
+    /// Pool to resolve handles against, opened on first use
+    fn reader_pool(&self) -> Option<Arc<ShmBlobPool>> {
+        let mut pool = self.pool.lock().unwrap();
+        if pool.is_none() {
+            *pool = ShmBlobPool::open(&self.pool_name).ok();
+        }
+        pool.clone()
+    }
+
+    /// Next handle whose payload is still live, with its view
+    fn recv_sample(&self) -> Option<(T, BlobView)> {
+        let pool = match self.pool.lock().unwrap().clone() {
+            Some(pool) => pool,
+            None => {
+                // No pool yet: only open it once a publisher has sent something
+                let msg = self.hub.recv(&mut None)?;
+                let pool = self.reader_pool()?;
+                if let Some(view) = pool.view(&msg.blob_handle()) {
+                    return Some((msg, view));
+                }
+                pool
+            }
+        };
+        self.hub
+            .recv_blob(&pool, &mut None)
+            .map(|sample| sample.into_parts())
+    }
 }
 
 /// Python Hub - type-safe wrapper that creates the right Rust Hub<T>
@@ -148,6 +266,136 @@ impl PyHub {
         })
     }
 
+    /// Create a zero-copy image hub
+    ///
+    /// Images travel as fixed-size handles while the pixels stay in the
+    /// topic's shared-memory blob pool. recv() returns ImageFrame objects
+    /// whose `data` is a NumPy view of that memory; loan_image() lets a
+    /// publisher write pixels in place.
+    ///
+    /// Args:
+    ///     topic: Topic name
+    ///     capacity: Handles buffered in the topic (default: 4)
+    ///     slot_size: Bytes per pool slot (default: size of the first loan)
+    ///     slots: Pool slots (default: 2 * capacity); must exceed capacity
+    ///         plus the frames subscribers hold at once
+    ///
+    /// Examples:
+    ///     hub = Hub.image("camera/rgb")
+    ///     hub = Hub.image("camera/rgb", slot_size=1920 * 1080 * 3)
+    #[staticmethod]
+    #[pyo3(signature = (topic, capacity=None, slot_size=None, slots=None))]
+    fn image(
+        topic: String,
+        capacity: Option<usize>,
+        slot_size: Option<usize>,
+        slots: Option<usize>,
+    ) -> PyResult<Self> {
+        let hub = BlobHub::new(&topic, capacity.unwrap_or(4), slot_size, slots)?;
+        Ok(Self::local(HubType::Image(hub), topic))
+    }
+
+    /// Create a zero-copy depth image hub (uint16 depths, see Hub.image)
+    ///
+    /// Examples:
+    ///     hub = Hub.depth_image("camera/depth")
+    #[staticmethod]
+    #[pyo3(signature = (topic, capacity=None, slot_size=None, slots=None))]
+    fn depth_image(
+        topic: String,
+        capacity: Option<usize>,
+        slot_size: Option<usize>,
+        slots: Option<usize>,
+    ) -> PyResult<Self> {
+        let hub = BlobHub::new(&topic, capacity.unwrap_or(4), slot_size, slots)?;
+        Ok(Self::local(HubType::DepthImage(hub), topic))
+    }
+
+    /// Create a zero-copy point cloud hub (see Hub.image)
+    ///
+    /// Examples:
+    ///     hub = Hub.point_cloud("lidar/points")
+    #[staticmethod]
+    #[pyo3(signature = (topic, capacity=None, slot_size=None, slots=None))]
+    fn point_cloud(
+        topic: String,
+        capacity: Option<usize>,
+        slot_size: Option<usize>,
+        slots: Option<usize>,
+    ) -> PyResult<Self> {
+        let hub = BlobHub::new(&topic, capacity.unwrap_or(4), slot_size, slots)?;
+        Ok(Self::local(HubType::PointCloud(hub), topic))
+    }
+
+    /// Loan a pool slot for an image and fill it in place
+    ///
+    /// Args:
+    ///     width, height: Image size in pixels
+    ///     encoding: "mono8", "mono16", "rgb8", "bgr8", "rgba8", "bgra8",
+    ///         "yuv422", "mono32f", "rgb32f", "bayer_rggb8" (default: "rgb8")
+    ///
+    /// Returns:
+    ///     BlobLoan whose `data` is a writable (height, width[, channels])
+    ///     array over shared memory; pass it to send()
+    ///
+    /// Examples:
+    ///     loan = hub.loan_image(640, 480)
+    ///     cv2.cvtColor(raw, cv2.COLOR_BGR2RGB, dst=loan.data)
+    ///     hub.send(loan, node)
+    #[pyo3(signature = (width, height, encoding="rgb8"))]
+    fn loan_image(
+        &self,
+        py: Python,
+        width: u32,
+        height: u32,
+        encoding: &str,
+    ) -> PyResult<BlobLoan> {
+        let HubType::Image(hub) = &self.hub_type else {
+            return Err(pyo3::exceptions::PyTypeError::new_err(
+                "loan_image() requires a Hub.image() hub",
+            ));
+        };
+        let encoding = blob::parse_encoding(encoding)?;
+        let len = width as usize * height as usize * encoding.bytes_per_pixel() as usize;
+        blob::loan_image(py, &hub.writer_pool(len)?, width, height, encoding)
+    }
+
+    /// Loan a pool slot for a (height, width) uint16 depth image
+    fn loan_depth_image(&self, py: Python, width: u32, height: u32) -> PyResult<BlobLoan> {
+        let HubType::DepthImage(hub) = &self.hub_type else {
+            return Err(pyo3::exceptions::PyTypeError::new_err(
+                "loan_depth_image() requires a Hub.depth_image() hub",
+            ));
+        };
+        let len = width as usize * height as usize * 2;
+        blob::loan_depth(py, &hub.writer_pool(len)?, width, height)
+    }
+
+    /// Loan a pool slot for an (N, 3) float32 XYZ point cloud
+    fn loan_point_cloud(&self, py: Python, points: u32) -> PyResult<BlobLoan> {
+        let HubType::PointCloud(hub) = &self.hub_type else {
+            return Err(pyo3::exceptions::PyTypeError::new_err(
+                "loan_point_cloud() requires a Hub.point_cloud() hub",
+            ));
+        };
+        blob::loan_point_cloud(py, &hub.writer_pool(points as usize * 12)?, points)
+    }
+
+    /// Block until a message is pending or `timeout` seconds pass
+    ///
+    /// Sleeps on the topic's wakeup word with the GIL released, so other
+    /// Python threads keep running while this one waits.
+    ///
+    /// Returns:
+    ///     True if a message is ready for recv()
+    ///
+    /// Examples:
+    ///     while hub.wait(1.0):
+    ///         process(hub.recv())
+    fn wait(&self, py: Python, timeout: f64) -> bool {
+        self.wait_pending(py, timeout)
+    }
+
     /// Send a message (type must match Hub's type)
     ///
     /// Args:
@@ -160,6 +408,9 @@ impl PyHub {
     /// Examples:
     ///     hub.send(CmdVel(1.5, 0.5), node)      # With logging
     ///     hub.send(Pose2D(1.0, 2.0, 0.5))       # Without logging
+    ///
+    /// Blob hubs (Hub.image() etc.) take a BlobLoan, published without a
+    /// copy, or a NumPy array, copied once into a pool slot.
     #[pyo3(signature = (message, node=None))]
     fn send(&self, py: Python, message: PyObject, node: Option<PyObject>) -> PyResult<bool> {
         use std::time::Instant;
@@ -287,6 +538,9 @@ impl PyHub {
 
                 success
             }
+            HubType::Image(_) | HubType::DepthImage(_) | HubType::PointCloud(_) => {
+                self.send_blob(py, &message, node.as_ref())?
+            }
         };
 
         Ok(result)
@@ -296,16 +550,28 @@ impl PyHub {
     ///
     /// Args:
     ///     node: Optional Node for automatic logging with IPC timing
+    ///     timeout: Optional seconds to wait for a message (GIL released)
     ///
     /// Returns:
-    ///     CmdVel/Pose2D object if available, None otherwise
+    ///     CmdVel/Pose2D object if available, None otherwise. Blob hubs return
+    ///     ImageFrame/DepthFrame/PointCloudFrame views of shared memory.
     ///
     /// Examples:
     ///     cmd = hub.recv(node)       # With logging
     ///     pose = hub.recv()          # Without logging
-    #[pyo3(signature = (node=None))]
-    fn recv(&self, py: Python, node: Option<PyObject>) -> PyResult<Option<PyObject>> {
-        use std::time::Instant;
+    ///     frame = hub.recv(timeout=0.1)
+    #[pyo3(signature = (node=None, timeout=None))]
+    fn recv(
+        &self,
+        py: Python,
+        node: Option<PyObject>,
+        timeout: Option<f64>,
+    ) -> PyResult<Option<PyObject>> {
+        if let Some(timeout) = timeout {
+            if !self.wait_pending(py, timeout) {
+                return Ok(None);
+            }
+        }
         let start = Instant::now();
 
         match &self.hub_type {
@@ -428,7 +694,134 @@ impl PyHub {
                     Ok(None)
                 }
             }
+            HubType::Image(_) | HubType::DepthImage(_) | HubType::PointCloud(_) => {
+                let Some((frame, type_name, summary)) = self.recv_frame(py)? else {
+                    return Ok(None);
+                };
+                let ipc_ns = start.elapsed().as_nanos() as u64;
+                log_to_node(
+                    py,
+                    node.as_ref(),
+                    &self.topic,
+                    type_name,
+                    false,
+                    summary,
+                    ipc_ns,
+                );
+                Ok(Some(frame))
+            }
+        }
+    }
+
+    /// Receive every pending message in one call
+    ///
+    /// Drains the topic in a single pass on the Rust side (one lock, one
+    /// metrics update) instead of calling recv() in a loop from Python.
+    /// Useful for high-rate topics where several messages arrive per tick.
+    ///
+    /// Args:
+    ///     node: Optional Node for automatic logging with IPC timing
+    ///
+    /// Returns:
+    ///     List of CmdVel/Pose2D objects (decoded values for generic hubs,
+    ///     frames for blob hubs), oldest first. Empty if nothing was pending.
+    ///
+    /// Examples:
+    ///     for imu in hub.recv_all(node):
+    ///         integrate(imu)
+    #[pyo3(signature = (node=None))]
+    fn recv_all(&self, py: Python, node: Option<PyObject>) -> PyResult<Vec<PyObject>> {
+        use horus::core::LogSummary;
+        use std::time::Instant;
+        let start = Instant::now();
+        let horus_module = py.import_bound("horus")?;
+
+        let (objects, type_name, last_summary): (Vec<PyObject>, &str, Option<String>) =
+            match &self.hub_type {
+                HubType::CmdVel(hub) => {
+                    let mut batch = Vec::new();
+                    hub.lock().unwrap().recv_all_into(&mut batch, &mut None);
+                    let cmdvel_class = horus_module.getattr("CmdVel")?;
+                    let objects = batch
+                        .iter()
+                        .map(|cmd| {
+                            cmdvel_class
+                                .call1((cmd.linear, cmd.angular, cmd.stamp_nanos))
+                                .map(Into::into)
+                        })
+                        .collect::<PyResult<_>>()?;
+                    (objects, "CmdVel", batch.last().map(|m| m.log_summary()))
+                }
+                HubType::Pose2D(hub) => {
+                    let mut batch = Vec::new();
+                    hub.lock().unwrap().recv_all_into(&mut batch, &mut None);
+                    let pose2d_class = horus_module.getattr("Pose2D")?;
+                    let objects = batch
+                        .iter()
+                        .map(|pose| {
+                            pose2d_class
+                                .call1((pose.x, pose.y, pose.theta, pose.timestamp))
+                                .map(Into::into)
+                        })
+                        .collect::<PyResult<_>>()?;
+                    (objects, "Pose2D", batch.last().map(|m| m.log_summary()))
+                }
+                HubType::Generic(hub) => {
+                    let mut batch = Vec::new();
+                    hub.lock().unwrap().recv_all_into(&mut batch, &mut None);
+                    let objects = batch
+                        .iter()
+                        .map(|msg| {
+                            let value: serde_json::Value = rmp_serde::from_slice(&msg.data())
+                                .map_err(|e| {
+                                    pyo3::exceptions::PyRuntimeError::new_err(format!(
+                                        "Failed to deserialize MessagePack: {}",
+                                        e
+                                    ))
+                                })?;
+                            pythonize::pythonize(py, &value)
+                                .map(Into::into)
+                                .map_err(|e| {
+                                    pyo3::exceptions::PyRuntimeError::new_err(format!(
+                                        "Failed to convert to Python: {}",
+                                        e
+                                    ))
+                                })
+                        })
+                        .collect::<PyResult<_>>()?;
+                    (
+                        objects,
+                        "GenericMessage",
+                        batch.last().map(|m| m.log_summary()),
+                    )
+                }
+                HubType::Image(_) | HubType::DepthImage(_) | HubType::PointCloud(_) => {
+                    let mut objects = Vec::new();
+                    let mut last = None;
+                    while let Some((frame, type_name, summary)) = self.recv_frame(py)? {
+                        objects.push(frame);
+                        last = Some((type_name, summary));
+                    }
+                    match last {
+                        Some((type_name, summary)) => (objects, type_name, Some(summary)),
+                        None => (objects, "", None),
+                    }
+                }
+            };
+        let ipc_ns = start.elapsed().as_nanos() as u64;
+
+        // Log once per batch if node provided
+        if let (Some(node_obj), Some(summary)) = (&node, last_summary) {
+            if let Ok(info) = node_obj.getattr(py, "info") {
+                if !info.is_none(py) {
+                    let _ = info.call_method1(py, "register_subscriber", (&self.topic, type_name));
+                    let log_msg = format!("{} (batch of {})", summary, objects.len());
+                    let _ = info.call_method1(py, "log_sub", (&self.topic, log_msg, ipc_ns));
+                }
+            }
         }
+
+        Ok(objects)
     }
 
     /// Get the topic name
@@ -761,6 +1154,9 @@ impl PyHub {
                         m.recv_failures,
                     )
                 }
+                HubType::Image(hub) => metrics_tuple(hub.hub.get_metrics()),
+                HubType::DepthImage(hub) => metrics_tuple(hub.hub.get_metrics()),
+                HubType::PointCloud(hub) => metrics_tuple(hub.hub.get_metrics()),
             };
 
             dict.set_item("messages_sent", sent)?;
@@ -789,3 +1185,208 @@ impl PyHub {
         }
     }
 }
+
+impl PyHub {
+    /// Local shared-memory hub wrapper (blob hubs have no network transport)
+    fn local(hub_type: HubType, topic: String) -> Self {
+        Self {
+            hub_type,
+            topic,
+            endpoint: None,
+            is_network: false,
+        }
+    }
+
+    /// Wait on the topic with the GIL released; true if a message is pending
+    fn wait_pending(&self, py: Python, timeout: f64) -> bool {
+        let timeout = Duration::try_from_secs_f64(timeout.max(0.0))
+            .unwrap_or(Duration::from_secs(u32::MAX as u64));
+        // Typed hubs wait on a clone (it shares the ring and cursor) so the
+        // mutex is not held while sleeping
+        match &self.hub_type {
+            HubType::CmdVel(hub) => {
+                let hub = hub.lock().unwrap().clone();
+                py.allow_threads(|| hub.wait_for_data(timeout))
+            }
+            HubType::Pose2D(hub) => {
+                let hub = hub.lock().unwrap().clone();
+                py.allow_threads(|| hub.wait_for_data(timeout))
+            }
+            HubType::Generic(hub) => {
+                let hub = hub.lock().unwrap().clone();
+                py.allow_threads(|| hub.wait_for_data(timeout))
+            }
+            HubType::Image(hub) => py.allow_threads(|| hub.hub.wait_for_data(timeout)),
+            HubType::DepthImage(hub) => py.allow_threads(|| hub.hub.wait_for_data(timeout)),
+            HubType::PointCloud(hub) => py.allow_threads(|| hub.hub.wait_for_data(timeout)),
+        }
+    }
+
+    /// Receive the next frame on a blob hub as (frame, type name, log summary)
+    fn recv_frame(&self, py: Python) -> PyResult<Option<(PyObject, &'static str, String)>> {
+        use horus::core::LogSummary;
+        let frame = match &self.hub_type {
+            HubType::Image(hub) => match hub.recv_sample() {
+                Some((msg, view)) => Some((
+                    Py::new(py, ImageFrame::new(py, msg, view)?)?.into_any(),
+                    "ImageHandle",
+                    msg.log_summary(),
+                )),
+                None => None,
+            },
+            HubType::DepthImage(hub) => match hub.recv_sample() {
+                Some((msg, view)) => Some((
+                    Py::new(py, DepthFrame::new(py, msg, view)?)?.into_any(),
+                    "DepthImageHandle",
+                    msg.log_summary(),
+                )),
+                None => None,
+            },
+            HubType::PointCloud(hub) => match hub.recv_sample() {
+                Some((msg, view)) => Some((
+                    Py::new(py, PointCloudFrame::new(py, msg, view)?)?.into_any(),
+                    "PointCloudHandle",
+                    msg.log_summary(),
+                )),
+                None => None,
+            },
+            _ => None,
+        };
+        Ok(frame)
+    }
+
+    /// Publish a BlobLoan, or copy a NumPy array into a fresh loan and publish it
+    fn send_blob(&self, py: Python, message: &PyObject, node: Option<&PyObject>) -> PyResult<bool> {
+        use horus::core::LogSummary;
+        let start = Instant::now();
+        let message = message.bind(py);
+        let loan = match message.downcast::<PyUntypedArray>() {
+            Ok(array) => self.loan_for_array(py, array)?,
+            Err(_) => message.downcast::<BlobLoan>().cloned().map_err(|_| {
+                pyo3::exceptions::PyTypeError::new_err(
+                    "send() on a blob hub takes a BlobLoan or a NumPy array",
+                )
+            })?,
+        };
+        let loan = loan.borrow();
+
+        let matches = matches!(
+            (&self.hub_type, &loan.kind),
+            (HubType::Image(_), LoanKind::Image(_))
+                | (HubType::DepthImage(_), LoanKind::Depth(_))
+                | (HubType::PointCloud(_), LoanKind::PointCloud(_))
+        );
+        if !matches {
+            return Err(pyo3::exceptions::PyTypeError::new_err(
+                "BlobLoan was taken from a hub of a different message type",
+            ));
+        }
+        let blob = loan.publish(py)?;
+
+        let (success, type_name, summary) = match (&self.hub_type, loan.kind) {
+            (HubType::Image(hub), LoanKind::Image(mut msg)) => {
+                msg.blob = blob;
+                let success = hub.hub.send(msg, &mut None).is_ok();
+                (success, "ImageHandle", msg.log_summary())
+            }
+            (HubType::DepthImage(hub), LoanKind::Depth(mut msg)) => {
+                msg.blob = blob;
+                let success = hub.hub.send(msg, &mut None).is_ok();
+                (success, "DepthImageHandle", msg.log_summary())
+            }
+            (HubType::PointCloud(hub), LoanKind::PointCloud(mut msg)) => {
+                msg.blob = blob;
+                let success = hub.hub.send(msg, &mut None).is_ok();
+                (success, "PointCloudHandle", msg.log_summary())
+            }
+            _ => unreachable!("loan kind checked above"),
+        };
+
+        let ipc_ns = start.elapsed().as_nanos() as u64;
+        log_to_node(py, node, &self.topic, type_name, true, summary, ipc_ns);
+        Ok(success)
+    }
+
+    /// Loan a slot shaped like `array` and copy the array into it
+    fn loan_for_array<'py>(
+        &self,
+        py: Python<'py>,
+        array: &Bound<'py, PyUntypedArray>,
+    ) -> PyResult<Bound<'py, BlobLoan>> {
+        let shape = array.shape().to_vec();
+        let dtype = blob::array_dtype(array)?;
+        let loan = match &self.hub_type {
+            HubType::Image(hub) => {
+                let encoding = blob::infer_encoding(&shape, dtype).ok_or_else(|| {
+                    pyo3::exceptions::PyValueError::new_err(format!(
+                        "Cannot infer an image encoding for a {:?} array; use loan_image()",
+                        shape
+                    ))
+                })?;
+                let (height, width) = (shape[0] as u32, shape[1] as u32);
+                let len = width as usize * height as usize * encoding.bytes_per_pixel() as usize;
+                blob::loan_image(py, &hub.writer_pool(len)?, width, height, encoding)?
+            }
+            HubType::DepthImage(hub) => {
+                if shape.len() != 2 || dtype != Dtype::U16 {
+                    return Err(pyo3::exceptions::PyValueError::new_err(
+                        "Depth images are (height, width) uint16 arrays",
+                    ));
+                }
+                let (height, width) = (shape[0] as u32, shape[1] as u32);
+                let len = width as usize * height as usize * 2;
+                blob::loan_depth(py, &hub.writer_pool(len)?, width, height)?
+            }
+            HubType::PointCloud(hub) => {
+                if shape.len() != 2 || shape[1] != 3 || dtype != Dtype::F32 {
+                    return Err(pyo3::exceptions::PyValueError::new_err(
+                        "Point clouds are (N, 3) float32 arrays",
+                    ));
+                }
+                let points = shape[0] as u32;
+                blob::loan_point_cloud(py, &hub.writer_pool(points as usize * 12)?, points)?
+            }
+            _ => unreachable!("only called for blob hubs"),
+        };
+        let loan = Bound::new(py, loan)?;
+        // NumPy does the (possibly strided) copy straight into the slot
+        loan.borrow().array(py).set_item(py.Ellipsis(), array)?;
+        Ok(loan)
+    }
+}
+
+/// (sent, received, send failures, recv failures) for `stats()`
+fn metrics_tuple(m: HubMetrics) -> (u64, u64, u64, u64) {
+    (
+        m.messages_sent,
+        m.messages_received,
+        m.send_failures,
+        m.recv_failures,
+    )
+}
+
+/// Register with and log to a Python node's info, if a node was given
+fn log_to_node(
+    py: Python,
+    node: Option<&PyObject>,
+    topic: &str,
+    type_name: &str,
+    publisher: bool,
+    summary: String,
+    ipc_ns: u64,
+) {
+    let Some(node_obj) = node else {
+        return;
+    };
+    if let Ok(info) = node_obj.getattr(py, "info") {
+        if !info.is_none(py) {
+            let (register, log) = if publisher {
+                ("register_publisher", "log_pub")
+            } else {
+                ("register_subscriber", "log_sub")
+            };
+            let _ = info.call_method1(py, register, (topic, type_name));
+            let _ = info.call_method1(py, log, (topic, summary, ipc_ns));
+        }
+    }
+}
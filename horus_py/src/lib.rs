@@ -5,6 +5,7 @@
 
 use pyo3::prelude::*;
 
+mod blob;
 mod config;
 mod hframe;
 mod hub;
@@ -15,6 +16,7 @@ mod scheduler;
 // mod typed_hub;  // Old separate typed hubs - replaced by polymorphic Hub
 mod types;
 
+use blob::{BlobBuffer, BlobLoan, DepthFrame, ImageFrame, LoanBuffer, PointCloudFrame};
 use config::{PyRobotPreset, PySchedulerConfig};
 use hframe::{PyHFrame, PyHFrameConfig, PyTransform};
 use hub::PyHub;
@@ -34,6 +36,12 @@ fn _horus(m: &Bound<'_, PyModule>) -> PyResult<()> {
     m.add_class::<PyNode>()?;
     m.add_class::<PyNodeInfo>()?;
     m.add_class::<PyHub>()?;
+    m.add_class::<ImageFrame>()?; // Zero-copy frames returned by blob hubs
+    m.add_class::<DepthFrame>()?;
+    m.add_class::<PointCloudFrame>()?;
+    m.add_class::<BlobLoan>()?; // Pool slot loaned for in-place writes
+    m.add_class::<BlobBuffer>()?;
+    m.add_class::<LoanBuffer>()?;
     m.add_class::<PyLink>()?; // Point-to-point SPSC communication with network support
     m.add_class::<PyRouterClient>()?; // Explicit router connection management
     m.add_class::<PyRouterServer>()?; // Router server management
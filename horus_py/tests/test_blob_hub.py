@@ -0,0 +1,107 @@
+"""
+Blob Hub Tests - zero-copy images, depth and point clouds
+
+Frames received on Hub.image()/depth_image()/point_cloud() are NumPy views
+of the publisher's shared-memory slots; loans are filled in place.
+"""
+
+import uuid
+
+import numpy as np
+import pytest
+from horus import Hub, ImageFrame, DepthFrame, PointCloudFrame
+
+
+def topic(name):
+    return f"{name}_{uuid.uuid4().hex[:8]}"
+
+
+class TestImageHub:
+    def test_loan_send_recv(self):
+        name = topic("camera")
+        pub = Hub.image(name)
+        sub = Hub.image(name)
+
+        loan = pub.loan_image(4, 3, "rgb8")
+        assert loan.data.shape == (3, 4, 3)
+        loan.data[:] = np.arange(36, dtype=np.uint8).reshape(3, 4, 3)
+        loan.frame_id = "cam0"
+        assert pub.send(loan)
+        assert loan.sent
+
+        frame = sub.recv(timeout=1.0)
+        assert isinstance(frame, ImageFrame)
+        assert (frame.width, frame.height, frame.encoding) == (4, 3, "rgb8")
+        assert frame.frame_id == "cam0"
+        np.testing.assert_array_equal(
+            frame.data, np.arange(36, dtype=np.uint8).reshape(3, 4, 3)
+        )
+        assert not frame.data.flags.writeable
+
+    def test_send_ndarray_copies_once(self):
+        name = topic("mono")
+        pub = Hub.image(name)
+        sub = Hub.image(name)
+        image = np.full((8, 16), 7, dtype=np.uint8)
+        assert pub.send(image)
+
+        frame = sub.recv(timeout=1.0)
+        assert frame.encoding == "mono8"
+        np.testing.assert_array_equal(frame.data, image)
+
+    def test_loan_sent_twice_raises(self):
+        pub = Hub.image(topic("twice"))
+        loan = pub.loan_image(2, 2, "mono8")
+        pub.send(loan)
+        with pytest.raises(RuntimeError):
+            pub.send(loan)
+
+    def test_sent_loan_is_read_only_and_keeps_its_frame(self):
+        name = topic("frozen")
+        pub = Hub.image(name)
+        loan = pub.loan_image(4, 4, "mono8")
+        loan.data[:] = 42
+        assert pub.send(loan)
+
+        assert not loan.data.flags.writeable
+        with pytest.raises(ValueError):
+            loan.data[0, 0] = 1
+
+        # Later frames must not reuse the slot the sent array still shows
+        for i in range(32):
+            pub.send(np.full((4, 4), i, dtype=np.uint8))
+        assert (loan.data == 42).all()
+
+    def test_recv_timeout_returns_none(self):
+        sub = Hub.image(topic("idle"))
+        assert sub.recv(timeout=0.01) is None
+        assert not sub.wait(0.01)
+
+
+class TestDepthAndPointCloud:
+    def test_depth_roundtrip(self):
+        name = topic("depth")
+        pub = Hub.depth_image(name)
+        sub = Hub.depth_image(name)
+        depths = np.arange(12, dtype=np.uint16).reshape(3, 4) * 100
+        assert pub.send(depths)
+
+        frame = sub.recv(timeout=1.0)
+        assert isinstance(frame, DepthFrame)
+        np.testing.assert_array_equal(frame.data, depths)
+
+    def test_point_cloud_xyz_view(self):
+        name = topic("points")
+        pub = Hub.point_cloud(name)
+        sub = Hub.point_cloud(name)
+        loan = pub.loan_point_cloud(5)
+        loan.data[:] = np.arange(15, dtype=np.float32).reshape(5, 3)
+        pub.send(loan)
+
+        cloud = sub.recv(timeout=1.0)
+        assert isinstance(cloud, PointCloudFrame)
+        assert len(cloud) == 5
+        assert cloud.fields == ["x", "y", "z"]
+        np.testing.assert_array_equal(
+            cloud.xyz(), np.arange(15, dtype=np.float32).reshape(5, 3)
+        )
@@ -0,0 +1,377 @@
+//! Built-in load generator
+//!
+//! `horus_router --loadgen` starts a router in-process (or loads a running one
+//! given with `--target`), connects publishers and subscribers on one topic and
+//! reports the delivered message rate, losses and end-to-end latency
+//! percentiles, so router changes can be measured before and after.
+
+use horus_core::communication::network::protocol::{HorusPacket, PacketView};
+use std::net::SocketAddr;
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+use tokio::io::{AsyncReadExt, AsyncWriteExt, BufWriter};
+use tokio::net::TcpStream;
+use tokio::time::MissedTickBehavior;
+
+/// Time allowed for subscriptions to reach the router before publishing
+const SUBSCRIBE_SETTLE: Duration = Duration::from_millis(200);
+/// Time subscribers keep reading after publishers stop
+const DRAIN_GRACE: Duration = Duration::from_secs(1);
+/// Frames buffered per flush when publishing as fast as possible
+const UNPACED_FLUSH_EVERY: u64 = 64;
+/// Payload prefix carrying the send time
+const TIMESTAMP_BYTES: usize = 8;
+
+/// Command-line options for load generator mode
+#[derive(clap::Args, Debug)]
+pub struct LoadGenArgs {
+    /// Run the built-in load generator instead of serving
+    #[arg(long)]
+    pub loadgen: bool,
+
+    /// Router to load (host:port); an in-process router is started if omitted
+    #[arg(long, requires = "loadgen")]
+    pub target: Option<String>,
+
+    /// Number of publisher connections
+    #[arg(long, default_value_t = 1, requires = "loadgen")]
+    pub publishers: usize,
+
+    /// Number of subscriber connections
+    #[arg(long, default_value_t = 30, requires = "loadgen")]
+    pub subscribers: usize,
+
+    /// Messages per second per publisher (0 = as fast as possible)
+    #[arg(long, default_value_t = 1000, requires = "loadgen")]
+    pub rate: u64,
+
+    /// Payload size in bytes (at least 8, for the embedded timestamp)
+    #[arg(long, default_value_t = 64, requires = "loadgen")]
+    pub payload_bytes: usize,
+
+    /// Publishing duration in seconds
+    #[arg(long, default_value_t = 10, requires = "loadgen")]
+    pub duration: u64,
+
+    /// Topic to publish on
+    #[arg(long, default_value = "/tf", requires = "loadgen")]
+    pub topic: String,
+}
+
+/// Run the load generator against `target` and print a report
+pub async fn run(args: &LoadGenArgs, target: SocketAddr) -> std::io::Result<()> {
+    let epoch = Instant::now();
+    let duration = Duration::from_secs(args.duration.max(1));
+    let payload_len = args.payload_bytes.max(TIMESTAMP_BYTES);
+
+    println!(
+        "Load generator: {} publisher(s) -> {} subscriber(s) on '{}' via {}, {} B payload, {} msg/s each, {}s",
+        args.publishers,
+        args.subscribers,
+        args.topic,
+        target,
+        payload_len,
+        if args.rate == 0 {
+            "max".to_string()
+        } else {
+            args.rate.to_string()
+        },
+        duration.as_secs()
+    );
+
+    // Subscribers first, so nothing published is unrouted
+    let mut subscribers = Vec::with_capacity(args.subscribers);
+    for _ in 0..args.subscribers {
+        let stream = subscribe(target, &args.topic).await?;
+        subscribers.push(stream);
+    }
+    tokio::time::sleep(SUBSCRIBE_SETTLE).await;
+
+    let start = Instant::now();
+    let publish_until = start + duration;
+    let read_until = publish_until + DRAIN_GRACE;
+
+    let sub_tasks: Vec<_> = subscribers
+        .into_iter()
+        .map(|stream| tokio::spawn(receive(stream, epoch, read_until)))
+        .collect();
+
+    let template = Arc::new(publish_frame(&args.topic, payload_len));
+    let pub_tasks: Vec<_> = (0..args.publishers)
+        .map(|_| {
+            tokio::spawn(publish(
+                target,
+                template.clone(),
+                epoch,
+                args.rate,
+                publish_until,
+            ))
+        })
+        .collect();
+
+    let mut published = 0u64;
+    for task in pub_tasks {
+        published += task.await.map_err(std::io::Error::other)??;
+    }
+    let publish_secs = start.elapsed().as_secs_f64().max(f64::EPSILON);
+
+    let mut latency = LatencyHistogram::new();
+    for task in sub_tasks {
+        latency.merge(&task.await.map_err(std::io::Error::other)??);
+    }
+
+    let expected = published * args.subscribers as u64;
+    let delivered = latency.count();
+    let lost = expected.saturating_sub(delivered);
+
+    println!(
+        "  published  {:>12} msgs {:>12.0} msg/s",
+        published,
+        published as f64 / publish_secs
+    );
+    println!(
+        "  delivered  {:>12} msgs {:>12.0} msg/s",
+        delivered,
+        delivered as f64 / publish_secs
+    );
+    println!(
+        "  lost       {:>12} msgs {:>11.2}%",
+        lost,
+        if expected > 0 {
+            lost as f64 * 100.0 / expected as f64
+        } else {
+            0.0
+        }
+    );
+    println!(
+        "  latency    p50 {:?}  p99 {:?}  p99.9 {:?}  max {:?}",
+        Duration::from_nanos(latency.percentile(0.50)),
+        Duration::from_nanos(latency.percentile(0.99)),
+        Duration::from_nanos(latency.percentile(0.999)),
+        Duration::from_nanos(latency.max()),
+    );
+
+    Ok(())
+}
+
+/// Length-prefixed publish frame; the timestamp sits at the start of the payload
+struct PublishFrame {
+    bytes: Vec<u8>,
+    timestamp_offset: usize,
+}
+
+fn publish_frame(topic: &str, payload_len: usize) -> PublishFrame {
+    let packet = HorusPacket::new_router_publish(topic.to_string(), vec![0u8; payload_len], 0);
+    let mut encoded = Vec::new();
+    packet.encode(&mut encoded);
+
+    let mut bytes = Vec::with_capacity(4 + encoded.len());
+    bytes.extend_from_slice(&(encoded.len() as u32).to_le_bytes());
+    bytes.extend_from_slice(&encoded);
+
+    PublishFrame {
+        timestamp_offset: bytes.len() - payload_len,
+        bytes,
+    }
+}
+
+/// Connect and subscribe to `topic`
+async fn subscribe(target: SocketAddr, topic: &str) -> std::io::Result<TcpStream> {
+    let mut stream = TcpStream::connect(target).await?;
+    stream.set_nodelay(true)?;
+
+    let mut encoded = Vec::new();
+    HorusPacket::new_router_subscribe(topic.to_string()).encode(&mut encoded);
+    stream
+        .write_all(&(encoded.len() as u32).to_le_bytes())
+        .await?;
+    stream.write_all(&encoded).await?;
+    Ok(stream)
+}
+
+/// Publish until `until`, returning the number of messages sent
+async fn publish(
+    target: SocketAddr,
+    template: Arc<PublishFrame>,
+    epoch: Instant,
+    rate: u64,
+    until: Instant,
+) -> std::io::Result<u64> {
+    let stream = TcpStream::connect(target).await?;
+    stream.set_nodelay(true)?;
+    let mut writer = BufWriter::new(stream);
+
+    let mut frame = template.bytes.clone();
+    let ts = template.timestamp_offset..template.timestamp_offset + TIMESTAMP_BYTES;
+
+    let mut ticker = (rate > 0).then(|| {
+        let mut t = tokio::time::interval(Duration::from_secs_f64(1.0 / rate as f64));
+        t.set_missed_tick_behavior(MissedTickBehavior::Burst);
+        t
+    });
+
+    let mut sent = 0u64;
+    while Instant::now() < until {
+        if let Some(ref mut t) = ticker {
+            t.tick().await;
+        }
+
+        let now_ns = epoch.elapsed().as_nanos() as u64;
+        frame[ts.clone()].copy_from_slice(&now_ns.to_le_bytes());
+        writer.write_all(&frame).await?;
+        sent += 1;
+
+        if ticker.is_some() || sent % UNPACED_FLUSH_EVERY == 0 {
+            writer.flush().await?;
+        }
+    }
+    writer.flush().await?;
+    Ok(sent)
+}
+
+/// Read frames until `until`, recording send-to-receive latency
+async fn receive(
+    mut stream: TcpStream,
+    epoch: Instant,
+    until: Instant,
+) -> std::io::Result<LatencyHistogram> {
+    let mut histogram = LatencyHistogram::new();
+    let mut len_buffer = [0u8; 4];
+    let mut buffer = vec![0u8; 65536];
+
+    loop {
+        let remaining = until.saturating_duration_since(Instant::now());
+        let read = tokio::time::timeout(remaining, stream.read_exact(&mut len_buffer)).await;
+        match read {
+            Ok(Ok(_)) => {}
+            Ok(Err(e)) if e.kind() == std::io::ErrorKind::UnexpectedEof => break,
+            Ok(Err(e)) => return Err(e),
+            Err(_) => break, // Timed out: done
+        }
+
+        let len = u32::from_le_bytes(len_buffer) as usize;
+        if len > buffer.len() {
+            buffer.resize(len, 0);
+        }
+        stream.read_exact(&mut buffer[..len]).await?;
+
+        let received_ns = epoch.elapsed().as_nanos() as u64;
+        if let Ok(packet) = PacketView::parse(&buffer[..len]) {
+            if let Some(ts) = packet.payload.get(..TIMESTAMP_BYTES) {
+                let sent_ns = u64::from_le_bytes(ts.try_into().unwrap());
+                histogram.record(received_ns.saturating_sub(sent_ns));
+            }
+        }
+    }
+
+    Ok(histogram)
+}
+
+/// Sub-buckets per power of two (2^4 = 16, about 6% resolution)
+const SUB_BUCKET_BITS: u32 = 4;
+const SUB_BUCKETS: usize = 1 << SUB_BUCKET_BITS;
+const BUCKETS: usize = (64 - SUB_BUCKET_BITS as usize + 1) * SUB_BUCKETS;
+
+/// Fixed-size log-linear histogram of nanosecond latencies
+struct LatencyHistogram {
+    counts: Vec<u64>,
+    total: u64,
+    max: u64,
+}
+
+impl LatencyHistogram {
+    fn new() -> Self {
+        Self {
+            counts: vec![0; BUCKETS],
+            total: 0,
+            max: 0,
+        }
+    }
+
+    fn index(value: u64) -> usize {
+        if value < SUB_BUCKETS as u64 {
+            return value as usize;
+        }
+        let shift = 63 - value.leading_zeros() - SUB_BUCKET_BITS;
+        ((shift as usize + 1) << SUB_BUCKET_BITS) + ((value >> shift) as usize & (SUB_BUCKETS - 1))
+    }
+
+    /// Largest value that maps to bucket `index`
+    fn upper_bound(index: usize) -> u64 {
+        if index < SUB_BUCKETS {
+            return index as u64;
+        }
+        let shift = (index >> SUB_BUCKET_BITS) - 1;
+        let sub = (index & (SUB_BUCKETS - 1)) as u128;
+        let bound = ((SUB_BUCKETS as u128 + sub + 1) << shift) - 1;
+        bound.min(u64::MAX as u128) as u64
+    }
+
+    fn record(&mut self, value: u64) {
+        self.counts[Self::index(value)] += 1;
+        self.total += 1;
+        self.max = self.max.max(value);
+    }
+
+    fn merge(&mut self, other: &LatencyHistogram) {
+        for (a, b) in self.counts.iter_mut().zip(&other.counts) {
+            *a += b;
+        }
+        self.total += other.total;
+        self.max = self.max.max(other.max);
+    }
+
+    fn count(&self) -> u64 {
+        self.total
+    }
+
+    fn max(&self) -> u64 {
+        self.max
+    }
+
+    /// Value at quantile `q` (0.0..=1.0), rounded up to its bucket bound
+    fn percentile(&self, q: f64) -> u64 {
+        if self.total == 0 {
+            return 0;
+        }
+        let target = ((q * self.total as f64).ceil() as u64).max(1);
+        let mut seen = 0u64;
+        for (index, count) in self.counts.iter().enumerate() {
+            seen += count;
+            if seen >= target {
+                return Self::upper_bound(index).min(self.max);
+            }
+        }
+        self.max
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_histogram_buckets_are_contiguous() {
+        for value in [0u64, 15, 16, 31, 32, 1_000, 123_456, u64::MAX] {
+            let index = LatencyHistogram::index(value);
+            assert!(index < BUCKETS);
+            assert!(LatencyHistogram::upper_bound(index) >= value);
+            if index > 0 {
+                assert!(LatencyHistogram::upper_bound(index - 1) < value);
+            }
+        }
+    }
+
+    #[test]
+    fn test_histogram_percentiles() {
+        let mut h = LatencyHistogram::new();
+        for v in 1..=1000u64 {
+            h.record(v * 1000);
+        }
+        let p50 = h.percentile(0.5);
+        let p99 = h.percentile(0.99);
+        assert!((470_000..=540_000).contains(&p50), "p50 = {}", p50);
+        assert!((960_000..=1_000_000).contains(&p99), "p99 = {}", p99);
+        assert_eq!(h.max(), 1_000_000);
+    }
+}
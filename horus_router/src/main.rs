@@ -3,21 +3,36 @@
 /// Central message broker for many-to-many pub/sub communication.
 /// Clients connect via TCP, subscribe to topics, and publish messages.
 /// The router forwards messages to all subscribers of each topic.
+use bytes::{Bytes, BytesMut};
 use clap::Parser;
-use horus_core::communication::network::protocol::{HorusPacket, MessageType};
+use horus_core::communication::network::protocol::{MessageType, PacketView};
+use std::collections::hash_map::RandomState;
 use std::collections::HashMap;
+use std::hash::BuildHasher;
+use std::io::IoSlice;
 use std::net::SocketAddr;
-use std::sync::Arc;
-use tokio::io::{AsyncReadExt, AsyncWriteExt};
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Arc, Mutex as StdMutex, RwLock as StdRwLock};
+use std::time::Duration;
+use tokio::io::{AsyncRead, AsyncReadExt, AsyncWrite, AsyncWriteExt};
 use tokio::net::{TcpListener, TcpStream};
-use tokio::sync::{mpsc, RwLock};
-use tracing::{error, info, warn};
+use tokio::sync::mpsc;
+use tracing::{debug, error, info, trace, warn};
+
+mod loadgen;
 
 #[cfg(feature = "tls")]
 use horus_core::communication::network::tls::{TlsCertConfig, TlsStream};
 
 const DEFAULT_PORT: u16 = 7777;
 const BUFFER_SIZE: usize = 65536;
+/// Outbound frames buffered per client before new ones are dropped
+const CLIENT_QUEUE_DEPTH: usize = 1024;
+/// Most frames coalesced into one vectored write. A client with a full
+/// batch waiting is behind, and only gets the latest frame per topic of it.
+const MAX_COALESCE: usize = 64;
+/// Number of independently locked subscription table shards
+const SUBSCRIPTION_SHARDS: usize = 16;
 
 #[derive(Parser, Debug)]
 #[command(name = "horus_router")]
@@ -49,123 +64,394 @@ struct Args {
     #[cfg(feature = "tls")]
     #[arg(long)]
     tls_key: Option<String>,
+
+    /// Seconds between throughput/drop summaries (0 disables)
+    #[arg(long, default_value_t = 10)]
+    stats_interval: u64,
+
+    #[command(flatten)]
+    load: loadgen::LoadGenArgs,
+}
+
+/// Length-prefixed packet queued for a client, tagged with its topic
+#[derive(Clone)]
+struct Frame {
+    /// Hash of the topic name, for coalescing per topic
+    topic: u64,
+    bytes: Bytes,
 }
 
 /// A client connection
 struct Client {
     addr: SocketAddr,
-    tx: mpsc::UnboundedSender<Vec<u8>>,
+    /// Bounded outbound queue of frames
+    tx: mpsc::Sender<Frame>,
+    /// Frames handed to this client's writer
+    delivered: AtomicU64,
+    /// Frames dropped because the client's queue was full, or superseded by
+    /// a newer frame on the same topic while the client was behind
+    dropped: AtomicU64,
+}
+
+impl Client {
+    fn new(addr: SocketAddr, tx: mpsc::Sender<Frame>) -> Self {
+        Self {
+            addr,
+            tx,
+            delivered: AtomicU64::new(0),
+            dropped: AtomicU64::new(0),
+        }
+    }
+
+    /// Queue a frame without waiting; a slow client loses the newest frames
+    /// instead of stalling the publisher or growing without bound
+    fn deliver(&self, frame: &Frame) -> bool {
+        match self.tx.try_send(frame.clone()) {
+            Ok(()) => {
+                self.delivered.fetch_add(1, Ordering::Relaxed);
+                true
+            }
+            Err(mpsc::error::TrySendError::Full(_)) => {
+                if self.dropped.fetch_add(1, Ordering::Relaxed) == 0 {
+                    warn!(
+                        "Client {} is not keeping up, dropping messages (queue depth {})",
+                        self.addr, CLIENT_QUEUE_DEPTH
+                    );
+                }
+                false
+            }
+            // Writer already gone; cleanup happens when the read side closes
+            Err(mpsc::error::TrySendError::Closed(_)) => false,
+        }
+    }
+}
+
+/// Subscriber list for one topic, replaced wholesale on (un)subscribe
+type Subscribers = Arc<[Arc<Client>]>;
+
+/// Topic -> subscribers map split into independently locked shards
+///
+/// Publishing only holds a shard's read lock long enough to clone the
+/// subscriber list `Arc`, so publishers on different topics never contend
+/// and fan-out runs without any lock held.
+struct SubscriptionTable {
+    shards: Vec<StdRwLock<HashMap<String, Subscribers>>>,
+    hasher: RandomState,
+}
+
+impl SubscriptionTable {
+    fn new() -> Self {
+        Self {
+            shards: (0..SUBSCRIPTION_SHARDS)
+                .map(|_| StdRwLock::new(HashMap::new()))
+                .collect(),
+            hasher: RandomState::new(),
+        }
+    }
+
+    fn shard(&self, topic: &str) -> &StdRwLock<HashMap<String, Subscribers>> {
+        let idx = self.topic_key(topic) as usize % self.shards.len();
+        &self.shards[idx]
+    }
+
+    fn topic_key(&self, topic: &str) -> u64 {
+        self.hasher.hash_one(topic)
+    }
+
+    fn get(&self, topic: &str) -> Option<Subscribers> {
+        let shard = self.shard(topic).read().unwrap_or_else(|e| e.into_inner());
+        shard.get(topic).cloned()
+    }
+
+    fn add(&self, topic: &str, client: Arc<Client>) {
+        let mut shard = self.shard(topic).write().unwrap_or_else(|e| e.into_inner());
+        let list = match shard.get(topic) {
+            Some(existing) if existing.iter().any(|c| c.addr == client.addr) => return,
+            Some(existing) => existing.iter().cloned().chain([client]).collect(),
+            None => Arc::from([client]),
+        };
+        shard.insert(topic.to_string(), list);
+    }
+
+    fn remove(&self, topic: &str, addr: SocketAddr) -> bool {
+        let mut shard = self.shard(topic).write().unwrap_or_else(|e| e.into_inner());
+        Self::remove_from(&mut shard, topic, addr)
+    }
+
+    fn remove_client(&self, addr: SocketAddr) {
+        for shard in &self.shards {
+            let mut shard = shard.write().unwrap_or_else(|e| e.into_inner());
+            let topics: Vec<String> = shard
+                .iter()
+                .filter(|(_, clients)| clients.iter().any(|c| c.addr == addr))
+                .map(|(topic, _)| topic.clone())
+                .collect();
+            for topic in topics {
+                Self::remove_from(&mut shard, &topic, addr);
+            }
+        }
+    }
+
+    fn remove_from(
+        shard: &mut HashMap<String, Subscribers>,
+        topic: &str,
+        addr: SocketAddr,
+    ) -> bool {
+        let Some(existing) = shard.get(topic) else {
+            return false;
+        };
+        let remaining: Vec<Arc<Client>> = existing
+            .iter()
+            .filter(|c| c.addr != addr)
+            .cloned()
+            .collect();
+        if remaining.is_empty() {
+            shard.remove(topic);
+        } else {
+            shard.insert(topic.to_string(), remaining.into());
+        }
+        true
+    }
+}
+
+/// Router-wide message counters
+#[derive(Default)]
+struct RouterStats {
+    published: AtomicU64,
+    delivered: AtomicU64,
+    dropped: AtomicU64,
+    unrouted: AtomicU64,
 }
 
 /// Router state managing all subscriptions
 struct RouterState {
     /// Map of topic -> list of clients subscribed to that topic
-    subscriptions: RwLock<HashMap<String, Vec<Arc<Client>>>>,
+    subscriptions: SubscriptionTable,
 
     /// Map of client address -> client info (for cleanup on disconnect)
-    clients: RwLock<HashMap<SocketAddr, Arc<Client>>>,
+    clients: StdMutex<HashMap<SocketAddr, Arc<Client>>>,
+
+    /// Message counters, reported periodically
+    stats: RouterStats,
 }
 
 impl RouterState {
     fn new() -> Self {
         Self {
-            subscriptions: RwLock::new(HashMap::new()),
-            clients: RwLock::new(HashMap::new()),
+            subscriptions: SubscriptionTable::new(),
+            clients: StdMutex::new(HashMap::new()),
+            stats: RouterStats::default(),
         }
     }
 
     /// Subscribe a client to a topic
-    async fn subscribe(&self, topic: String, client: Arc<Client>) {
-        let mut subs = self.subscriptions.write().await;
-        subs.entry(topic.clone()).or_default().push(client.clone());
-        info!("Client {} subscribed to topic '{}'", client.addr, topic);
+    fn subscribe(&self, topic: &str, client: Arc<Client>) {
+        let addr = client.addr;
+        self.subscriptions.add(topic, client);
+        info!("Client {} subscribed to topic '{}'", addr, topic);
     }
 
     /// Unsubscribe a client from a topic
-    async fn unsubscribe(&self, topic: &str, client_addr: SocketAddr) {
-        let mut subs = self.subscriptions.write().await;
-        if let Some(clients) = subs.get_mut(topic) {
-            clients.retain(|c| c.addr != client_addr);
-            if clients.is_empty() {
-                subs.remove(topic);
-            }
+    fn unsubscribe(&self, topic: &str, client_addr: SocketAddr) {
+        if self.subscriptions.remove(topic, client_addr) {
             info!("Client {} unsubscribed from topic '{}'", client_addr, topic);
         }
     }
 
     /// Publish a message to all subscribers of a topic
-    async fn publish(&self, topic: &str, packet_data: Vec<u8>) {
-        let subs = self.subscriptions.read().await;
-        if let Some(clients) = subs.get(topic) {
-            let count = clients.len();
-            for client in clients {
-                if let Err(e) = client.tx.send(packet_data.clone()) {
-                    warn!("Failed to send to client {}: {}", client.addr, e);
-                }
+    ///
+    /// `frame` is the length-prefixed packet exactly as it goes on the wire;
+    /// every subscriber gets a refcounted handle to the same bytes.
+    fn publish(&self, topic: &str, frame: Bytes) {
+        self.stats.published.fetch_add(1, Ordering::Relaxed);
+        let frame = Frame {
+            topic: self.subscriptions.topic_key(topic),
+            bytes: frame,
+        };
+
+        let Some(clients) = self.subscriptions.get(topic) else {
+            self.stats.unrouted.fetch_add(1, Ordering::Relaxed);
+            trace!("No subscribers for topic '{}'", topic);
+            return;
+        };
+
+        let mut delivered = 0u64;
+        for client in clients.iter() {
+            if client.deliver(&frame) {
+                delivered += 1;
             }
-            info!(
-                "Published message on topic '{}' to {} subscribers",
-                topic, count
-            );
-        } else {
-            warn!("No subscribers for topic '{}'", topic);
         }
+        let dropped = clients.len() as u64 - delivered;
+
+        self.stats.delivered.fetch_add(delivered, Ordering::Relaxed);
+        if dropped > 0 {
+            self.stats.dropped.fetch_add(dropped, Ordering::Relaxed);
+        }
+        trace!(
+            "Published message on topic '{}' to {} subscribers",
+            topic,
+            delivered
+        );
     }
 
     /// Register a new client
-    async fn register_client(&self, client: Arc<Client>) {
-        let mut clients = self.clients.write().await;
+    fn register_client(&self, client: Arc<Client>) {
+        let mut clients = self.clients.lock().unwrap_or_else(|e| e.into_inner());
         clients.insert(client.addr, client);
     }
 
     /// Remove a client and all its subscriptions
-    async fn remove_client(&self, addr: SocketAddr) {
+    fn remove_client(&self, addr: SocketAddr) {
         // Remove from clients map
-        let mut clients = self.clients.write().await;
-        clients.remove(&addr);
-        drop(clients);
+        let client = self
+            .clients
+            .lock()
+            .unwrap_or_else(|e| e.into_inner())
+            .remove(&addr);
 
         // Remove from all subscriptions
-        let mut subs = self.subscriptions.write().await;
-        for (_topic, clients) in subs.iter_mut() {
-            clients.retain(|c| c.addr != addr);
+        self.subscriptions.remove_client(addr);
+
+        match client {
+            Some(c) => info!(
+                "Removed client {} (delivered {}, dropped {})",
+                addr,
+                c.delivered.load(Ordering::Relaxed),
+                c.dropped.load(Ordering::Relaxed)
+            ),
+            None => info!("Removed client {}", addr),
         }
-        subs.retain(|_, clients| !clients.is_empty());
+    }
+
+    /// Log message rates every `interval`, and warn when clients dropped messages
+    async fn report_stats(self: Arc<Self>, interval: Duration) {
+        let mut ticker = tokio::time::interval(interval);
+        ticker.tick().await;
+        let (mut last_published, mut last_delivered, mut last_dropped) = (0, 0, 0);
+
+        loop {
+            ticker.tick().await;
+            let published = self.stats.published.load(Ordering::Relaxed);
+            let delivered = self.stats.delivered.load(Ordering::Relaxed);
+            let dropped = self.stats.dropped.load(Ordering::Relaxed);
+
+            let secs = interval.as_secs_f64();
+            let rate_in = (published - last_published) as f64 / secs;
+            let rate_out = (delivered - last_delivered) as f64 / secs;
+            if dropped > last_dropped {
+                warn!(
+                    "{:.0} msg/s in, {:.0} msg/s out, {} dropped by slow clients",
+                    rate_in,
+                    rate_out,
+                    dropped - last_dropped
+                );
+            } else if published > last_published {
+                debug!("{:.0} msg/s in, {:.0} msg/s out", rate_in, rate_out);
+            }
 
-        info!("Removed client {}", addr);
+            (last_published, last_delivered, last_dropped) = (published, delivered, dropped);
+        }
     }
 }
 
+/// Write queued frames to a client, coalescing whatever is already waiting
+/// into one vectored write
+///
+/// When a full batch is waiting the client is falling behind; older frames
+/// of a topic that also has a newer one in the batch are then dropped, so a
+/// slow client catches up on the latest state instead of replaying history.
+async fn write_frames<W>(
+    mut writer: W,
+    mut rx: mpsc::Receiver<Frame>,
+    client: Arc<Client>,
+    state: Arc<RouterState>,
+) where
+    W: AsyncWrite + Unpin,
+{
+    let mut batch: Vec<Frame> = Vec::with_capacity(MAX_COALESCE);
+    let mut payloads: Vec<Bytes> = Vec::with_capacity(MAX_COALESCE);
+
+    while let Some(first) = rx.recv().await {
+        batch.push(first);
+        while batch.len() < MAX_COALESCE {
+            match rx.try_recv() {
+                Ok(frame) => batch.push(frame),
+                Err(_) => break,
+            }
+        }
+
+        if batch.len() == MAX_COALESCE {
+            let superseded = keep_latest_per_topic(&mut batch) as u64;
+            if superseded > 0 {
+                client.dropped.fetch_add(superseded, Ordering::Relaxed);
+                state.stats.dropped.fetch_add(superseded, Ordering::Relaxed);
+            }
+        }
+
+        payloads.extend(batch.drain(..).map(|frame| frame.bytes));
+        if write_all_vectored(&mut writer, &payloads).await.is_err()
+            || writer.flush().await.is_err()
+        {
+            break;
+        }
+        payloads.clear();
+    }
+}
+
+/// Drop every frame that has a newer frame on the same topic later in
+/// `batch`, keeping the order of the rest; returns how many were dropped
+fn keep_latest_per_topic(batch: &mut Vec<Frame>) -> usize {
+    let before = batch.len();
+    // Walking from the newest frame, the first one seen per topic is its
+    // latest. Batches are at most MAX_COALESCE long, so a scan beats hashing.
+    let mut seen: Vec<u64> = Vec::with_capacity(before);
+    batch.reverse();
+    batch.retain(|frame| {
+        let latest = !seen.contains(&frame.topic);
+        if latest {
+            seen.push(frame.topic);
+        }
+        latest
+    });
+    batch.reverse();
+    before - batch.len()
+}
+
+/// `write_all` over several buffers, retrying on partial writes
+async fn write_all_vectored<W>(writer: &mut W, frames: &[Bytes]) -> std::io::Result<()>
+where
+    W: AsyncWrite + Unpin,
+{
+    let mut slices: Vec<IoSlice<'_>> = frames.iter().map(|f| IoSlice::new(f)).collect();
+    let mut remaining = &mut slices[..];
+
+    while !remaining.is_empty() {
+        let written = writer.write_vectored(remaining).await?;
+        if written == 0 {
+            return Err(std::io::ErrorKind::WriteZero.into());
+        }
+        IoSlice::advance_slices(&mut remaining, written);
+    }
+    Ok(())
+}
+
 /// Handle a single client connection (generic over stream type)
 async fn handle_client_inner<S>(stream: S, addr: SocketAddr, state: Arc<RouterState>)
 where
-    S: AsyncReadExt + AsyncWriteExt + Unpin + Send + 'static,
+    S: AsyncRead + AsyncWrite + Unpin + Send + 'static,
 {
     info!("New client connected: {}", addr);
 
-    let (mut read_half, mut write_half) = tokio::io::split(stream);
+    let (mut read_half, write_half) = tokio::io::split(stream);
 
-    // Create channel for sending messages to this client
-    let (tx, mut rx) = mpsc::unbounded_channel::<Vec<u8>>();
+    // Create bounded channel for sending messages to this client
+    let (tx, rx) = mpsc::channel::<Frame>(CLIENT_QUEUE_DEPTH);
 
-    let client = Arc::new(Client { addr, tx });
-    state.register_client(client.clone()).await;
+    let client = Arc::new(Client::new(addr, tx));
+    state.register_client(client.clone());
 
     // Spawn task to send messages to client
-    let write_task = tokio::spawn(async move {
-        while let Some(data) = rx.recv().await {
-            // Write length prefix (4 bytes)
-            let len_bytes = (data.len() as u32).to_le_bytes();
-            if write_half.write_all(&len_bytes).await.is_err() {
-                break;
-            }
-
-            // Write data
-            if write_half.write_all(&data).await.is_err() {
-                break;
-            }
-        }
-    });
+    let write_task = tokio::spawn(write_frames(write_half, rx, client.clone(), state.clone()));
 
     // Read messages from client
     let mut len_buffer = [0u8; 4];
@@ -185,21 +471,25 @@ where
                 // Read packet data
                 match read_half.read_exact(&mut buffer[..packet_len]).await {
                     Ok(_) => {
-                        // Decode packet
-                        match HorusPacket::decode(&buffer[..packet_len]) {
+                        let packet_data = &buffer[..packet_len];
+
+                        // Inspect the header without copying the payload
+                        match PacketView::parse(packet_data) {
                             Ok(packet) => {
                                 match packet.msg_type {
                                     MessageType::RouterSubscribe => {
-                                        state.subscribe(packet.topic, client.clone()).await;
+                                        state.subscribe(&packet.topic, client.clone());
                                     }
                                     MessageType::RouterUnsubscribe => {
-                                        state.unsubscribe(&packet.topic, addr).await;
+                                        state.unsubscribe(&packet.topic, addr);
                                     }
                                     MessageType::RouterPublish | MessageType::Fragment => {
-                                        // Forward to all subscribers
-                                        state
-                                            .publish(&packet.topic, buffer[..packet_len].to_vec())
-                                            .await;
+                                        // One copy into a shared frame, then
+                                        // forward to all subscribers
+                                        let mut frame = BytesMut::with_capacity(4 + packet_len);
+                                        frame.extend_from_slice(&len_buffer);
+                                        frame.extend_from_slice(packet_data);
+                                        state.publish(&packet.topic, frame.freeze());
                                     }
                                     _ => {
                                         warn!(
@@ -228,15 +518,24 @@ where
     }
 
     // Cleanup on disconnect
-    state.remove_client(addr).await;
+    state.remove_client(addr);
     write_task.abort();
 }
 
 /// Handle plain TCP client
 async fn handle_tcp_client(stream: TcpStream, addr: SocketAddr, state: Arc<RouterState>) {
+    // Writes are already coalesced per client, Nagle would only add latency
+    let _ = stream.set_nodelay(true);
     handle_client_inner(stream, addr, state).await;
 }
 
+/// Accept plain TCP clients until the listener fails (in-process load generator)
+async fn serve_plain(listener: TcpListener, state: Arc<RouterState>) {
+    while let Ok((stream, addr)) = listener.accept().await {
+        tokio::spawn(handle_tcp_client(stream, addr, state.clone()));
+    }
+}
+
 /// Handle TLS client
 #[cfg(feature = "tls")]
 async fn handle_tls_client(
@@ -260,8 +559,30 @@ async fn main() -> Result<(), Box<dyn std::error::Error>> {
 
     tracing_subscriber::fmt().with_env_filter(filter).init();
 
+    // Load generator mode: drive a router (in-process unless --target) and exit
+    if args.load.loadgen {
+        let target = match args.load.target {
+            Some(ref target) => target.parse()?,
+            None => {
+                let listener = TcpListener::bind("127.0.0.1:0").await?;
+                let addr = listener.local_addr()?;
+                tokio::spawn(serve_plain(listener, Arc::new(RouterState::new())));
+                addr
+            }
+        };
+        loadgen::run(&args.load, target).await?;
+        return Ok(());
+    }
+
     // Create router state
     let state = Arc::new(RouterState::new());
+    if args.stats_interval > 0 {
+        tokio::spawn(
+            state
+                .clone()
+                .report_stats(Duration::from_secs(args.stats_interval)),
+        );
+    }
 
     // Bind to address
     let bind_addr = format!("{}:{}", args.bind, args.port);
@@ -334,3 +655,118 @@ async fn main() -> Result<(), Box<dyn std::error::Error>> {
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn client(port: u16, depth: usize) -> (Arc<Client>, mpsc::Receiver<Frame>) {
+        let (tx, rx) = mpsc::channel(depth);
+        let addr = SocketAddr::from(([127, 0, 0, 1], port));
+        (Arc::new(Client::new(addr, tx)), rx)
+    }
+
+    fn frame(topic: u64, byte: u8) -> Frame {
+        Frame {
+            topic,
+            bytes: Bytes::from(vec![byte]),
+        }
+    }
+
+    #[test]
+    fn test_full_queue_drops_and_counts() {
+        let state = RouterState::new();
+        let (slow, mut rx) = client(1, 2);
+        state.subscribe("/tf", slow.clone());
+
+        for i in 0..5u8 {
+            state.publish("/tf", Bytes::from(vec![i]));
+        }
+
+        // The queue keeps the first frames, the newest ones are dropped
+        assert_eq!(slow.delivered.load(Ordering::Relaxed), 2);
+        assert_eq!(slow.dropped.load(Ordering::Relaxed), 3);
+        assert_eq!(state.stats.published.load(Ordering::Relaxed), 5);
+        assert_eq!(state.stats.delivered.load(Ordering::Relaxed), 2);
+        assert_eq!(state.stats.dropped.load(Ordering::Relaxed), 3);
+        assert_eq!(rx.try_recv().unwrap().bytes[..], [0]);
+        assert_eq!(rx.try_recv().unwrap().bytes[..], [1]);
+
+        // Freed space is used again; other topics are unrouted
+        state.publish("/tf", Bytes::from_static(&[9]));
+        assert_eq!(rx.try_recv().unwrap().bytes[..], [9]);
+        state.publish("/odom", Bytes::from_static(&[0]));
+        assert_eq!(state.stats.unrouted.load(Ordering::Relaxed), 1);
+    }
+
+    #[test]
+    fn test_subscribers_share_one_frame() {
+        let state = RouterState::new();
+        let (a, mut rx_a) = client(1, 4);
+        let (b, mut rx_b) = client(2, 4);
+        state.subscribe("/tf", a);
+        state.subscribe("/tf", b);
+
+        state.publish("/tf", Bytes::from_static(b"pose"));
+        let (fa, fb) = (rx_a.try_recv().unwrap(), rx_b.try_recv().unwrap());
+        assert_eq!(fa.bytes.as_ptr(), fb.bytes.as_ptr());
+        assert_eq!(fa.topic, fb.topic);
+    }
+
+    #[test]
+    fn test_keep_latest_per_topic() {
+        let (tf, odom, scan) = (1, 2, 3);
+        let mut batch = vec![
+            frame(tf, 0),
+            frame(odom, 1),
+            frame(tf, 2),
+            frame(scan, 3),
+            frame(tf, 4),
+            frame(odom, 5),
+        ];
+        assert_eq!(keep_latest_per_topic(&mut batch), 3);
+        let kept: Vec<(u64, u8)> = batch.iter().map(|f| (f.topic, f.bytes[0])).collect();
+        assert_eq!(kept, vec![(scan, 3), (tf, 4), (odom, 5)]);
+
+        let mut distinct = vec![frame(tf, 0), frame(odom, 1)];
+        assert_eq!(keep_latest_per_topic(&mut distinct), 0);
+        assert_eq!(distinct.len(), 2);
+    }
+
+    #[tokio::test]
+    async fn test_writer_coalesces_only_when_behind() {
+        let state = Arc::new(RouterState::new());
+        let (slow, rx) = client(1, CLIENT_QUEUE_DEPTH);
+
+        // Two full batches alternating between two topics, then a short tail
+        for i in 0..2 * MAX_COALESCE {
+            assert!(slow.deliver(&frame(i as u64 % 2, i as u8)));
+        }
+        for i in 0..3u8 {
+            assert!(slow.deliver(&frame(7, 200 + i)));
+        }
+
+        // The client keeps its sender, so the writer idles once drained
+        let mut out = Vec::new();
+        let writer = write_frames(&mut out, rx, slow.clone(), state.clone());
+        let _ = tokio::time::timeout(Duration::from_millis(200), writer).await;
+
+        let last = MAX_COALESCE as u8;
+        assert_eq!(
+            out,
+            vec![
+                last - 2,
+                last - 1,
+                2 * last - 2,
+                2 * last - 1,
+                200,
+                201,
+                202
+            ],
+            "Full batches keep the latest frame per topic, the tail is sent whole"
+        );
+        let superseded = 2 * (MAX_COALESCE as u64 - 2);
+        assert_eq!(slow.dropped.load(Ordering::Relaxed), superseded);
+        assert_eq!(state.stats.dropped.load(Ordering::Relaxed), superseded);
+    }
+}